@@ -331,6 +331,17 @@ typedef void (GL_APIENTRYP GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLen
 #define GL_PACK_REVERSE_ROW_ORDER_ANGLE                         0x93A4
 #endif
 
+/* GL_ANGLE_profile_counters */
+#ifndef GL_ANGLE_profile_counters
+#define GL_PROFILE_VALIDATION_ANGLE                             0x93A8
+#define GL_PROFILE_APPLY_STATE_ANGLE                            0x93A9
+#define GL_PROFILE_VERTEX_DATA_ANGLE                            0x93AA
+#define GL_PROFILE_INDEX_DATA_ANGLE                             0x93AB
+#define GL_PROFILE_APPLY_UNIFORMS_ANGLE                         0x93AC
+#define GL_PROFILE_TEXTURE_LOAD_ANGLE                           0x93AD
+#define GL_PROFILE_REDUNDANT_STATE_ANGLE                        0x93AE
+#endif
+
 /* GL_ANGLE_program_binary */
 #ifndef GL_ANGLE_program_binary
 #define GL_PROGRAM_BINARY_ANGLE                                 0x93A6
@@ -1305,6 +1316,17 @@ typedef void (GL_APIENTRYP PFNGLVERTEXATTRIBDIVISORANGLEPROC) (GLuint index, GLu
 #define GL_ANGLE_pack_reverse_row_order 1
 #endif
 
+/* GL_ANGLE_profile_counters */
+#ifndef GL_ANGLE_profile_counters
+#define GL_ANGLE_profile_counters 1
+#ifdef GL_GLEXT_PROTOTYPES
+GL_APICALL void GL_APIENTRY glGetProfileCountersANGLE (GLenum stage, GLuint64 *counters);
+GL_APICALL void GL_APIENTRY glResetProfileCountersANGLE (void);
+#endif
+typedef void (GL_APIENTRYP PFNGLGETPROFILECOUNTERSANGLEPROC) (GLenum stage, GLuint64 *counters);
+typedef void (GL_APIENTRYP PFNGLRESETPROFILECOUNTERSANGLEPROC) (void);
+#endif
+
 /* GL_ANGLE_program_binary */
 #ifndef GL_ANGLE_program_binary
 #define GL_ANGLE_program_binary 1
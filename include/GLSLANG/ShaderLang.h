@@ -37,7 +37,7 @@ extern "C" {
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 122
+#define ANGLE_SH_VERSION 129
 
 //
 // The names of the following enums have been derived by replacing GL prefix
@@ -157,6 +157,14 @@ typedef enum {
   SH_ACTIVE_OUTPUT_VARIABLES_ARRAY  = 0x6007,
   SH_ACTIVE_ATTRIBUTES_ARRAY        = 0x6008,
   SH_ACTIVE_VARYINGS_ARRAY          = 0x6009,
+  SH_OBJECT_CODE_POINTER            = 0x600A,
+  SH_INFO_LOG_POINTER               = 0x600B,
+  SH_POOL_ALLOCATION_COUNT          = 0x600C,
+  SH_POOL_ALLOCATED_BYTES           = 0x600D,
+  SH_POOL_PAGE_COUNT                = 0x600E,
+  SH_POOL_LARGE_ALLOCATION_COUNT    = 0x600F,
+  SH_POOL_PEAK_BYTES                = 0x6010,
+  SH_REUSED_PERMUTATIONS            = 0x6011,
 } ShShaderInfo;
 
 // Compile options.
@@ -230,6 +238,24 @@ typedef enum {
   // It is intended as a workaround for drivers which incorrectly optimize
   // out such varyings and cause a link failure.
   SH_INIT_VARYINGS_WITHOUT_STATIC_USE = 0x20000,
+
+  // This flag removes the functions main() doesn't call, and the global
+  // variables and structure declarations only those functions use, from the
+  // translated code. Uniforms, attributes and varyings are reported as if
+  // the flag wasn't set.
+  SH_PRUNE_UNUSED_DECLARATIONS = 0x40000,
+
+  // This flag computes the expressions without side effects which a block
+  // evaluates more than once into temporaries, for drivers which don't
+  // eliminate common subexpressions themselves.
+  SH_ELIMINATE_COMMON_SUBEXPRESSIONS = 0x80000,
+
+  // This flag makes the GLSL and ESSL output as small as possible: the
+  // variables, functions and structures which aren't part of the interface
+  // get the shortest free names, and whitespace which doesn't separate
+  // tokens is removed. Uniforms, attributes and varyings keep their names, or
+  // their hashed names reported through the name map.
+  SH_MINIFY_OUTPUT = 0x100000,
 } ShCompileOptions;
 
 // Defines alternate strategies for implementing array index clamping.
@@ -371,6 +397,47 @@ COMPILER_EXPORT int ShCompile(
     int compileOptions
     );
 
+//
+// A macro defined before the source of a shader permutation, as if by
+// "#define name value". A null value defines the macro as empty.
+//
+typedef struct
+{
+    const char* name;
+    const char* value;
+} ShMacroDefinition;
+
+//
+// Sets the source shared by the permutations of a shader, which differ only
+// in the macros defined before it. The strings are copied, and the results
+// of permutations compiled with the previous body are forgotten.
+// If the function succeeds, the return value is nonzero, else zero.
+//
+COMPILER_EXPORT int ShSetPermutationBody(
+    const ShHandle handle,
+    const char* const shaderStrings[],
+    size_t numStrings);
+
+//
+// Compiles the permutation of the body given to ShSetPermutationBody which
+// has the given macros defined, with the same results as ShCompile would.
+// As with #define, the compile fails if a macro is pre-defined, such as GL_ES
+// or an extension macro, or has a reserved name, starting with "GL_" or
+// containing "__".
+// The preprocessor records which macros each permutation looked up, defined
+// or not, and when a permutation agrees with an earlier one compiled with
+// the same options on all of those macros, the earlier results are reused
+// instead of compiling again. Only whole results are reused: a permutation
+// which changes any macro looked up is compiled in full. Results are not
+// reused while an object code callback is set.
+// If the function succeeds, the return value is nonzero, else zero.
+//
+COMPILER_EXPORT int ShCompilePermutation(
+    const ShHandle handle,
+    const ShMacroDefinition* definitions,
+    size_t numDefinitions,
+    int compileOptions);
+
 // Returns a parameter from a compiled shader.
 // Parameters:
 // handle: Specifies the compiler
@@ -399,6 +466,18 @@ COMPILER_EXPORT int ShCompile(
 //                            null termination character.
 // SH_HASHED_NAMES_COUNT: the number of hashed names from the latest compile.
 // SH_SHADER_VERSION: the version of the shader language
+// SH_POOL_ALLOCATION_COUNT: the number of allocations the latest compile
+//                           made from the compiler's memory pool.
+// SH_POOL_ALLOCATED_BYTES: the number of bytes of those allocations.
+// SH_POOL_PAGE_COUNT: the number of pages the pool obtained from the system
+//                     during the latest compile.
+// SH_POOL_LARGE_ALLOCATION_COUNT: the number of allocations of the latest
+//                                 compile too large for a page.
+// SH_POOL_PEAK_BYTES: the most memory the pool held at once during the
+//                     latest compile.
+// SH_REUSED_PERMUTATIONS: the number of ShCompilePermutation calls since the
+//                         latest ShSetPermutationBody which reused the
+//                         results of an earlier permutation.
 //
 // params: Requested parameter
 COMPILER_EXPORT void ShGetInfo(const ShHandle handle,
@@ -425,6 +504,25 @@ COMPILER_EXPORT void ShGetInfoLog(const ShHandle handle, char* infoLog);
 //          ShGetInfo with SH_OBJECT_CODE_LENGTH.
 COMPILER_EXPORT void ShGetObjectCode(const ShHandle handle, char* objCode);
 
+// Receives a piece of the object code of a compile, see ShSetObjectCodeCallback.
+// objCode is not null-terminated and is only valid during the call.
+typedef void (*ShObjectCodeCallback)(const char* objCode,
+                                     size_t length,
+                                     void* userData);
+
+// Streams the object code of subsequent compiles to a callback as it is
+// generated, so it can be written directly into caller-provided storage or a
+// file without being retained by the compiler. The pieces arrive in order
+// before ShCompile returns. While a callback is set, ShGetObjectCode returns
+// an empty string. Pass NULL to go back to retaining the object code.
+// Parameters:
+// handle: Specifies the compiler
+// callback: Receives the object code, or NULL.
+// userData: Passed unchanged to the callback.
+COMPILER_EXPORT void ShSetObjectCodeCallback(const ShHandle handle,
+                                             ShObjectCodeCallback callback,
+                                             void* userData);
+
 // Returns information about a shader variable.
 // Parameters:
 // handle: Specifies the compiler
@@ -481,13 +579,23 @@ COMPILER_EXPORT void ShGetNameHashingEntry(const ShHandle handle,
                                            char* name,
                                            char* hashedName);
 
-// Returns a parameter from a compiled shader.
+// Returns a pointer to a result of the latest compile, without copying it.
+// The pointer is owned by the compiler and remains valid until the next call
+// to ShCompile or ShDestruct on the same handle.
 // Parameters:
 // handle: Specifies the compiler
 // pname: Specifies the parameter to query.
 // The following parameters are defined:
+// SH_OBJECT_CODE_POINTER: the null-terminated object code, as a const char*.
+//                         Its length is SH_OBJECT_CODE_LENGTH - 1.
+// SH_INFO_LOG_POINTER: the null-terminated information log, as a
+//                      const char*. Its length is SH_INFO_LOG_LENGTH - 1.
 // SH_ACTIVE_UNIFORMS_ARRAY: an STL vector of active uniforms. Valid only for
 //                           HLSL output.
+// SH_ACTIVE_INTERFACE_BLOCKS_ARRAY, SH_ACTIVE_OUTPUT_VARIABLES_ARRAY,
+// SH_ACTIVE_ATTRIBUTES_ARRAY, SH_ACTIVE_VARYINGS_ARRAY: STL vectors of the
+//                           corresponding variables. Valid only for HLSL
+//                           output.
 // params: Requested parameter
 COMPILER_EXPORT void ShGetInfoPointer(const ShHandle handle,
                                       ShShaderInfo pname,
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// main.cpp: Replays a GL call stream recorded by setting ANGLE_CAPTURE_FILE, and reports the
+// CPU time spent in the calls. Every iteration replays the stream into a new context on an
+// offscreen surface, so object names come out of the allocators as they did when recording.
+
+#include <windows.h>
+
+#define GL_GLEXT_PROTOTYPES
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "libGLESv2/CaptureDecoder.h"
+
+namespace
+{
+
+typedef bool (*ReplayFunction)(gl::CaptureDecoder *decoder);
+
+#define REPLAY_FUNCTION(function) \
+    bool Replay_ ## function(gl::CaptureDecoder *decoder) { return gl::ReplayCall(function, decoder); }
+ANGLE_CAPTURE_ENTRY_POINTS(REPLAY_FUNCTION)
+#undef REPLAY_FUNCTION
+
+bool ReplayClientVertexArray(gl::CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 7)
+    {
+        return false;
+    }
+
+    // The pointer is client memory whichever array buffer the application had bound
+    GLint arrayBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &arrayBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLuint index = decoder->argument<GLuint>(0);
+    GLint size = decoder->argument<GLint>(1);
+    GLenum type = decoder->argument<GLenum>(2);
+    GLboolean normalized = decoder->argument<GLboolean>(3);
+    GLboolean pureInteger = decoder->argument<GLboolean>(4);
+    GLsizei stride = decoder->argument<GLsizei>(5);
+    const GLvoid *pointer = decoder->argument<const GLvoid*>(6);
+
+    if (pureInteger)
+    {
+        glVertexAttribIPointer(index, size, type, stride, pointer);
+    }
+    else
+    {
+        glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, arrayBuffer);
+    return true;
+}
+
+const ReplayFunction ReplayFunctions[] =
+{
+#define REPLAY_TABLE_ENTRY(function) Replay_ ## function,
+    ANGLE_CAPTURE_ENTRY_POINTS(REPLAY_TABLE_ENTRY)
+#undef REPLAY_TABLE_ENTRY
+    ReplayClientVertexArray,
+};
+
+bool ReadFile(const char *path, std::vector<char> *data)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    char block[65536];
+    size_t read = 0;
+    while ((read = fread(block, 1, sizeof(block), file)) > 0)
+    {
+        data->insert(data->end(), block, block + read);
+    }
+    fclose(file);
+
+    return true;
+}
+
+double Seconds()
+{
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart);
+}
+
+void usage(const char *programName)
+{
+    printf("usage: %s [--iterations N] [--width W] [--height H] CAPTURE_FILE\n", programName);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    const char *programName = argv[0];
+    int iterations = 1;
+    EGLint width = 1280;
+    EGLint height = 720;
+
+    argc--;
+    argv++;
+    while (argc >= 2 && strncmp(argv[0], "--", 2) == 0)
+    {
+        if (strcmp(argv[0], "--iterations") == 0)
+        {
+            iterations = atoi(argv[1]);
+        }
+        else if (strcmp(argv[0], "--width") == 0)
+        {
+            width = atoi(argv[1]);
+        }
+        else if (strcmp(argv[0], "--height") == 0)
+        {
+            height = atoi(argv[1]);
+        }
+        else
+        {
+            usage(programName);
+            return -1;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc != 1 || iterations < 1)
+    {
+        usage(programName);
+        return -1;
+    }
+
+    std::vector<char> stream;
+    gl::CaptureDecoder decoder;
+    if (!ReadFile(argv[0], &stream) || stream.empty() || !decoder.open(&stream[0], stream.size()))
+    {
+        printf("%s is not a capture file\n", argv[0]);
+        return -1;
+    }
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (!eglInitialize(display, NULL, NULL))
+    {
+        printf("Could not initialize EGL\n");
+        return -1;
+    }
+
+    const EGLint configAttributes[] =
+    {
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_STENCIL_SIZE, 8,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE
+    };
+
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+    {
+        printf("No suitable EGL config\n");
+        return -1;
+    }
+
+    const EGLint surfaceAttributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE)
+    {
+        printf("Could not create a %dx%d pbuffer\n", width, height);
+        return -1;
+    }
+
+    const EGLint contextAttributes[] = { EGL_CONTEXT_CLIENT_VERSION, static_cast<EGLint>(decoder.getHeader().clientVersion), EGL_NONE };
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context))
+        {
+            printf("Could not create an OpenGL ES %u context\n", decoder.getHeader().clientVersion);
+            return -1;
+        }
+
+        decoder.open(&stream[0], stream.size());
+
+        unsigned int calls = 0;
+        unsigned int failures = 0;
+        double start = Seconds();
+
+        while (decoder.next())
+        {
+            if (!ReplayFunctions[decoder.getCallId()](&decoder))
+            {
+                failures++;
+            }
+            calls++;
+        }
+
+        // Queued work is part of what the calls cost
+        glFinish();
+        double elapsed = Seconds() - start;
+
+        printf("Iteration %d: %u calls in %.3f ms, %.0f calls/s\n", iteration, calls, elapsed * 1000.0, calls / elapsed);
+        if (failures > 0)
+        {
+            printf("  %u calls did not match their entry point\n", failures);
+        }
+        if (decoder.isMalformed())
+        {
+            printf("  The stream is truncated or malformed\n");
+        }
+
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+
+    eglDestroySurface(display, surface);
+    eglTerminate(display);
+
+    return 0;
+}
@@ -16,6 +16,19 @@
             'include_dirs': [ '../include', ],
             'sources': [ '<!@(python <(angle_build_scripts_path)/enumerate_files.py translator -types *.cpp *.h)' ],
         },
+
+        {
+            'target_name': 'trace_decoder',
+            'type': 'executable',
+            'include_dirs': [ '../src', ],
+            'sources':
+            [
+                'trace_decoder/main.cpp',
+                '../src/common/BinaryTraceReader.cpp',
+                '../src/common/BinaryTraceReader.h',
+                '../src/common/BinaryTraceFormat.h',
+            ],
+        },
     ],
     'conditions':
     [
@@ -47,6 +60,25 @@
                     ],
                 },
 
+                {
+                    'target_name': 'gl_replay',
+                    'type': 'executable',
+                    'dependencies':
+                    [
+                        '../src/angle.gyp:libEGL',
+                        '../src/angle.gyp:libGLESv2',
+                    ],
+                    'include_dirs':
+                    [
+                        '../include',
+                        '../src',
+                    ],
+                    'sources':
+                    [
+                        '<!@(python <(angle_build_scripts_path)/enumerate_files.py gl_replay -types *.cpp *.h)',
+                    ],
+                },
+
                 {
                     'target_name': 'es_util',
                     'type': 'static_library',
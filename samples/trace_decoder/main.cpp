@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// main.cpp: Decodes the binary .angletrace files written by ANGLE_ENABLE_TRACE builds into
+// indented text, or into JSON which chrome://tracing can load.
+
+#include "common/BinaryTraceReader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static void usage(const char *programName)
+{
+    printf("usage: %s [--json] INPUT_FILE [OUTPUT_FILE]\n", programName);
+}
+
+int main(int argc, char **argv)
+{
+    const char *programName = argv[0];
+    bool json = false;
+
+    argc--;
+    argv++;
+    if (argc >= 1 && strcmp(argv[0], "--json") == 0)
+    {
+        json = true;
+        argc--;
+        argv++;
+    }
+
+    if (argc < 1 || argc > 2)
+    {
+        usage(programName);
+        return -1;
+    }
+
+    FILE *input = fopen(argv[0], "rb");
+    if (!input)
+    {
+        printf("Could not open %s\n", argv[0]);
+        return -1;
+    }
+
+    std::vector<char> data;
+    char block[65536];
+    size_t read = 0;
+    while ((read = fread(block, 1, sizeof(block), input)) > 0)
+    {
+        data.insert(data.end(), block, block + read);
+    }
+    fclose(input);
+
+    gl::BinaryTraceReader reader;
+    if (!reader.read(data.empty() ? NULL : &data[0], data.size()))
+    {
+        // A trace cut short by a crash is still worth decoding
+        printf("Warning: %s is truncated or malformed\n", argv[0]);
+    }
+
+    std::string output = json ? reader.toChromeJSON() : reader.toText();
+
+    FILE *outputFile = (argc == 2) ? fopen(argv[1], "wb") : stdout;
+    if (!outputFile)
+    {
+        printf("Could not open %s\n", argv[1]);
+        return -1;
+    }
+
+    fwrite(output.c_str(), 1, output.size(), outputFile);
+
+    if (outputFile != stdout)
+    {
+        fclose(outputFile);
+    }
+
+    return 0;
+}
@@ -88,6 +88,9 @@ int main(int argc, char* argv[])
             case 'e': compileOptions |= SH_EMULATE_BUILT_IN_FUNCTIONS; break;
             case 'd': compileOptions |= SH_DEPENDENCY_GRAPH; break;
             case 't': compileOptions |= SH_TIMING_RESTRICTIONS; break;
+            case 'p': compileOptions |= SH_PRUNE_UNUSED_DECLARATIONS; break;
+            case 'c': compileOptions |= SH_ELIMINATE_COMMON_SUBEXPRESSIONS; break;
+            case 'z': compileOptions |= SH_MINIFY_OUTPUT; break;
             case 's':
                 if (argv[0][2] == '=') {
                     switch (argv[0][3]) {
@@ -213,7 +216,7 @@ int main(int argc, char* argv[])
 //
 void usage()
 {
-    printf("Usage: translate [-i -m -o -u -l -e -b=e -b=g -b=h -x=i -x=d] file1 file2 ...\n"
+    printf("Usage: translate [-i -m -o -u -l -e -p -c -z -b=e -b=g -b=h -x=i -x=d] file1 file2 ...\n"
         "Where: filename : filename ending in .frag or .vert\n"
         "       -i       : print intermediate tree\n"
         "       -m       : map long variable names\n"
@@ -223,6 +226,9 @@ void usage()
         "       -e       : emulate certain built-in functions (workaround for driver bugs)\n"
         "       -t       : enforce experimental timing restrictions\n"
         "       -d       : print dependency graph used to enforce timing restrictions\n"
+        "       -p       : remove functions and globals main() doesn't use\n"
+        "       -c       : compute repeated expressions into temporaries\n"
+        "       -z       : minify names and whitespace in GLSL/ESSL output\n"
         "       -s=e     : use GLES2 spec (this is by default)\n"
         "       -s=w     : use WebGL spec\n"
         "       -s=c     : use CSS Shaders spec\n"
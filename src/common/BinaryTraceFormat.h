@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BinaryTraceFormat.h: Defines the layout of the binary trace files written by
+// gl::RingBufferTracer and read back by gl::BinaryTraceReader.
+//
+// A trace file is a sequence of chunks, one per flush. Every chunk starts with a
+// BinaryTraceChunkHeader and holds whole records, which are runs of 64-bit words starting
+// with a BinaryTraceRecordHeader. Events refer to their printf-style format string by its
+// address. A thread defines the text of an address in a string record before its first use.
+
+#ifndef COMMON_BINARYTRACEFORMAT_H_
+#define COMMON_BINARYTRACEFORMAT_H_
+
+#include <cstddef>
+#include <cstring>
+
+namespace gl
+{
+
+const unsigned int BinaryTraceMagic = 0x43525441;   // "ATRC"
+const unsigned int BinaryTraceVersion = 1;
+
+struct BinaryTraceChunkHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long ticksPerSecond;
+    unsigned long long wordCount;   // Record words following the header
+};
+
+enum BinaryTraceRecordType
+{
+    BINARY_TRACE_STRING,    // The payload is the NUL terminated text of the format string at id
+    BINARY_TRACE_BEGIN,     // An EVENT scope was entered, the payload holds the raw arguments
+    BINARY_TRACE_END,       // The innermost EVENT scope of the thread was left
+    BINARY_TRACE_MESSAGE,   // A TRACE, FIXME or ERR message, the payload is the formatted text
+    BINARY_TRACE_DROPPED    // The ring buffer of the thread was full, id is the number of records lost
+};
+
+struct BinaryTraceRecordHeader
+{
+    unsigned char type;
+    unsigned char reserved;
+    unsigned short wordCount;   // Including the header
+    unsigned int threadIndex;
+    unsigned long long timestamp;
+    unsigned long long id;
+};
+
+const size_t BinaryTraceHeaderWords = sizeof(BinaryTraceRecordHeader) / sizeof(unsigned long long);
+
+// How a printf conversion is stored in the payload of a begin record. Strings are copied,
+// as a word holding their length followed by the truncated text.
+enum BinaryTraceArgumentKind
+{
+    BINARY_TRACE_ARGUMENT_INT,
+    BINARY_TRACE_ARGUMENT_LONG,
+    BINARY_TRACE_ARGUMENT_LONG_LONG,
+    BINARY_TRACE_ARGUMENT_POINTER,
+    BINARY_TRACE_ARGUMENT_DOUBLE,
+    BINARY_TRACE_ARGUMENT_STRING
+};
+
+const size_t BinaryTraceMaxArguments = 16;
+const size_t BinaryTraceMaxStringLength = 63;
+
+// Finds the conversions of a printf format string. Returns the number of arguments, and
+// optionally where each conversion specification starts and ends.
+inline size_t ParseBinaryTraceFormat(const char *format, BinaryTraceArgumentKind kinds[BinaryTraceMaxArguments],
+                                     const char *starts[] = NULL, const char *ends[] = NULL)
+{
+    size_t count = 0;
+
+    for (const char *character = format; *character != '\0' && count < BinaryTraceMaxArguments; character++)
+    {
+        if (*character != '%')
+        {
+            continue;
+        }
+
+        const char *start = character++;
+        if (*character == '%')
+        {
+            continue;
+        }
+
+        while (*character != '\0' && strchr("-+ #0123456789.", *character))
+        {
+            character++;
+        }
+
+        int longCount = 0;
+        while (*character == 'l' || *character == 'h')
+        {
+            longCount += (*character == 'l') ? 1 : 0;
+            character++;
+        }
+
+        if (*character == '\0')
+        {
+            break;
+        }
+
+        switch (*character)
+        {
+          case 'p':
+            kinds[count] = BINARY_TRACE_ARGUMENT_POINTER;
+            break;
+          case 's':
+            kinds[count] = BINARY_TRACE_ARGUMENT_STRING;
+            break;
+          case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            kinds[count] = BINARY_TRACE_ARGUMENT_DOUBLE;
+            break;
+          default:
+            kinds[count] = (longCount >= 2) ? BINARY_TRACE_ARGUMENT_LONG_LONG :
+                           (longCount == 1) ? BINARY_TRACE_ARGUMENT_LONG : BINARY_TRACE_ARGUMENT_INT;
+            break;
+        }
+
+        if (starts)
+        {
+            starts[count] = start;
+        }
+        if (ends)
+        {
+            ends[count] = character + 1;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+}
+
+#endif   // COMMON_BINARYTRACEFORMAT_H_
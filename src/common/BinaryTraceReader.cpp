@@ -0,0 +1,377 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BinaryTraceReader.cpp: Implements gl::BinaryTraceReader, which decodes the binary trace
+// files written by gl::RingBufferTracer.
+
+#include "common/BinaryTraceReader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+namespace
+{
+
+bool EarlierEvent(const BinaryTraceEvent &a, const BinaryTraceEvent &b)
+{
+    return a.microseconds < b.microseconds;
+}
+
+std::string ReadText(const unsigned long long *words, size_t wordCount)
+{
+    const char *text = reinterpret_cast<const char*>(words);
+    size_t maxLength = wordCount * sizeof(unsigned long long);
+
+    size_t length = 0;
+    while (length < maxLength && text[length] != '\0')
+    {
+        length++;
+    }
+
+    return std::string(text, length);
+}
+
+std::string EscapeJSON(const std::string &text)
+{
+    std::string escaped;
+    for (size_t index = 0; index < text.size(); index++)
+    {
+        char character = text[index];
+        switch (character)
+        {
+          case '"':  escaped += "\\\""; break;
+          case '\\': escaped += "\\\\"; break;
+          case '\n': escaped += "\\n";  break;
+          case '\t': escaped += "\\t";  break;
+          default:
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", character);
+                escaped += code;
+            }
+            else
+            {
+                escaped += character;
+            }
+            break;
+        }
+    }
+    return escaped;
+}
+
+std::string TrimNewline(const std::string &text)
+{
+    size_t end = text.find_last_not_of("\r\n");
+    return (end == std::string::npos) ? std::string() : text.substr(0, end + 1);
+}
+
+}
+
+BinaryTraceReader::BinaryTraceReader()
+    : mSorted(true)
+{
+}
+
+bool BinaryTraceReader::read(const void *data, size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    size_t offset = 0;
+
+    while (offset < size)
+    {
+        BinaryTraceChunkHeader header;
+        if (size - offset < sizeof(header))
+        {
+            return false;
+        }
+        memcpy(&header, bytes + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (header.magic != BinaryTraceMagic || header.version != BinaryTraceVersion || header.ticksPerSecond == 0 ||
+            header.wordCount > (size - offset) / sizeof(unsigned long long))
+        {
+            return false;
+        }
+
+        std::vector<unsigned long long> words(static_cast<size_t>(header.wordCount));
+        if (!words.empty())
+        {
+            memcpy(&words[0], bytes + offset, words.size() * sizeof(unsigned long long));
+        }
+        offset += words.size() * sizeof(unsigned long long);
+
+        size_t position = 0;
+        while (position < words.size())
+        {
+            BinaryTraceRecordHeader record;
+            if (words.size() - position < BinaryTraceHeaderWords)
+            {
+                return false;
+            }
+            memcpy(&record, &words[position], sizeof(record));
+
+            if (record.wordCount < BinaryTraceHeaderWords || record.wordCount > words.size() - position)
+            {
+                return false;
+            }
+
+            if (!readRecord(&words[position], record.wordCount, header.ticksPerSecond))
+            {
+                return false;
+            }
+            position += record.wordCount;
+        }
+    }
+
+    return true;
+}
+
+const std::vector<BinaryTraceEvent> &BinaryTraceReader::getEvents()
+{
+    if (!mSorted)
+    {
+        // Every chunk holds the records of one thread after those of the previous thread
+        std::stable_sort(mEvents.begin(), mEvents.end(), EarlierEvent);
+        mSorted = true;
+    }
+
+    return mEvents;
+}
+
+std::string BinaryTraceReader::toText()
+{
+    const std::vector<BinaryTraceEvent> &events = getEvents();
+    double start = events.empty() ? 0.0 : events[0].microseconds;
+
+    std::map<unsigned int, int> depths;
+    std::string text;
+
+    for (size_t index = 0; index < events.size(); index++)
+    {
+        const BinaryTraceEvent &event = events[index];
+        int &depth = depths[event.threadIndex];
+
+        if (event.type == BINARY_TRACE_END)
+        {
+            depth = std::max(depth - 1, 0);
+            continue;
+        }
+
+        char prefix[64];
+        snprintf(prefix, sizeof(prefix), "%14.3f us [thread %u] ", event.microseconds - start, event.threadIndex);
+
+        text += prefix;
+        text += std::string(depth * 2, ' ');
+        text += TrimNewline(event.text);
+        text += "\n";
+
+        if (event.type == BINARY_TRACE_BEGIN)
+        {
+            depth++;
+        }
+    }
+
+    return text;
+}
+
+std::string BinaryTraceReader::toChromeJSON()
+{
+    const std::vector<BinaryTraceEvent> &events = getEvents();
+    double start = events.empty() ? 0.0 : events[0].microseconds;
+
+    std::string json = "{\"traceEvents\":[\n";
+
+    for (size_t index = 0; index < events.size(); index++)
+    {
+        const BinaryTraceEvent &event = events[index];
+
+        char common[96];
+        snprintf(common, sizeof(common), "\"pid\":0,\"tid\":%u,\"ts\":%.3f", event.threadIndex, event.microseconds - start);
+
+        json += (index > 0) ? ",\n" : "";
+        json += "{";
+        json += common;
+
+        switch (event.type)
+        {
+          case BINARY_TRACE_BEGIN:
+            json += ",\"ph\":\"B\",\"name\":\"" + EscapeJSON(event.name.empty() ? std::string("EVENT") : event.name) + "\"";
+            json += ",\"args\":{\"call\":\"" + EscapeJSON(TrimNewline(event.text)) + "\"}";
+            break;
+          case BINARY_TRACE_END:
+            json += ",\"ph\":\"E\"";
+            break;
+          default:
+            json += ",\"ph\":\"i\",\"s\":\"t\",\"name\":\"" + EscapeJSON(TrimNewline(event.text)) + "\"";
+            break;
+        }
+
+        json += "}";
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+
+bool BinaryTraceReader::readRecord(const unsigned long long *words, size_t wordCount, unsigned long long ticksPerSecond)
+{
+    BinaryTraceRecordHeader header;
+    memcpy(&header, words, sizeof(header));
+
+    const unsigned long long *payload = words + BinaryTraceHeaderWords;
+    size_t payloadWords = wordCount - BinaryTraceHeaderWords;
+
+    if (header.type == BINARY_TRACE_STRING)
+    {
+        mStrings[header.id] = ReadText(payload, payloadWords);
+        return true;
+    }
+
+    BinaryTraceEvent event;
+    event.type = static_cast<BinaryTraceRecordType>(header.type);
+    event.threadIndex = header.threadIndex;
+    event.microseconds = static_cast<double>(header.timestamp) * 1000000.0 / static_cast<double>(ticksPerSecond);
+
+    switch (header.type)
+    {
+      case BINARY_TRACE_BEGIN:
+        {
+            // The definition is missing if it was dropped from a full ring buffer
+            std::map<unsigned long long, std::string>::const_iterator format = mStrings.find(header.id);
+            if (format != mStrings.end())
+            {
+                event.name = format->second.substr(0, format->second.find('('));
+                event.text = formatArguments(format->second, payload, payloadWords);
+            }
+            else
+            {
+                event.text = "<unknown event>";
+            }
+        }
+        break;
+      case BINARY_TRACE_END:
+        break;
+      case BINARY_TRACE_MESSAGE:
+        event.text = ReadText(payload, payloadWords);
+        break;
+      case BINARY_TRACE_DROPPED:
+        {
+            char text[64];
+            snprintf(text, sizeof(text), "%llu records dropped", header.id);
+            event.text = text;
+        }
+        break;
+      default:
+        return false;
+    }
+
+    if (!mEvents.empty() && event.microseconds < mEvents.back().microseconds)
+    {
+        mSorted = false;
+    }
+    mEvents.push_back(event);
+
+    return true;
+}
+
+std::string BinaryTraceReader::formatArguments(const std::string &format, const unsigned long long *payload, size_t payloadWords) const
+{
+    BinaryTraceArgumentKind kinds[BinaryTraceMaxArguments];
+    const char *starts[BinaryTraceMaxArguments];
+    const char *ends[BinaryTraceMaxArguments];
+    size_t argumentCount = ParseBinaryTraceFormat(format.c_str(), kinds, starts, ends);
+
+    std::string text;
+    const char *literal = format.c_str();
+    size_t word = 0;
+
+    for (size_t argument = 0; argument < argumentCount; argument++)
+    {
+        text.append(literal, starts[argument]);
+        literal = ends[argument];
+
+        std::string specification(starts[argument], ends[argument]);
+        char value[BinaryTraceMaxStringLength + 64];
+
+        if (word >= payloadWords)
+        {
+            text += "<missing>";
+            continue;
+        }
+
+        switch (kinds[argument])
+        {
+          case BINARY_TRACE_ARGUMENT_INT:
+            snprintf(value, sizeof(value), specification.c_str(), static_cast<int>(payload[word++]));
+            break;
+          case BINARY_TRACE_ARGUMENT_LONG:
+          case BINARY_TRACE_ARGUMENT_LONG_LONG:
+            {
+                // The recording platform's long may be narrower than the decoding one's
+                std::string wide = specification;
+                size_t conversion = wide.size() - 1;
+                while (conversion > 0 && wide[conversion - 1] == 'l')
+                {
+                    conversion--;
+                }
+                wide = wide.substr(0, conversion) + "ll" + wide.substr(wide.size() - 1);
+                snprintf(value, sizeof(value), wide.c_str(), payload[word++]);
+            }
+            break;
+          case BINARY_TRACE_ARGUMENT_POINTER:
+            // Printed like MSVC prints pointers, whatever platform decodes the trace
+            snprintf(value, sizeof(value), "%08llX", payload[word++]);
+            break;
+          case BINARY_TRACE_ARGUMENT_DOUBLE:
+            {
+                double number;
+                memcpy(&number, &payload[word++], sizeof(number));
+                snprintf(value, sizeof(value), specification.c_str(), number);
+            }
+            break;
+          case BINARY_TRACE_ARGUMENT_STRING:
+            {
+                unsigned long long length = payload[word++];
+                if (length == ~0ULL)
+                {
+                    snprintf(value, sizeof(value), "(null)");
+                }
+                else
+                {
+                    size_t textWords = static_cast<size_t>(length) / sizeof(unsigned long long) + 1;
+                    if (length > BinaryTraceMaxStringLength || word + textWords > payloadWords)
+                    {
+                        text += "<malformed>";
+                        word = payloadWords;
+                        continue;
+                    }
+
+                    std::string string = ReadText(&payload[word], textWords);
+                    snprintf(value, sizeof(value), specification.c_str(), string.c_str());
+                    word += textWords;
+                }
+            }
+            break;
+          default:
+            value[0] = '\0';
+            break;
+        }
+
+        text += value;
+    }
+
+    text += literal;
+    return text;
+}
+
+}
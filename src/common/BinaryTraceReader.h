@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BinaryTraceReader.h: Defines gl::BinaryTraceReader, which decodes the binary trace files
+// written by gl::RingBufferTracer into text or the Chrome trace event JSON format.
+
+#ifndef COMMON_BINARYTRACEREADER_H_
+#define COMMON_BINARYTRACEREADER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/BinaryTraceFormat.h"
+
+namespace gl
+{
+
+struct BinaryTraceEvent
+{
+    BinaryTraceRecordType type;
+    unsigned int threadIndex;
+    double microseconds;
+
+    // For begin records the text of the format string before its arguments, which is the
+    // entry point name in MSVC builds
+    std::string name;
+    std::string text;
+};
+
+class BinaryTraceReader
+{
+  public:
+    BinaryTraceReader();
+
+    // Decodes the contents of a trace file. Returns false if it is malformed, the events
+    // decoded before the error are kept.
+    bool read(const void *data, size_t size);
+
+    // Events ordered by time, the order of events with the same time is kept
+    const std::vector<BinaryTraceEvent> &getEvents();
+
+    std::string toText();
+    std::string toChromeJSON();
+
+  private:
+    bool readRecord(const unsigned long long *words, size_t wordCount, unsigned long long ticksPerSecond);
+    std::string formatArguments(const std::string &format, const unsigned long long *payload, size_t payloadWords) const;
+
+    std::map<unsigned long long, std::string> mStrings;
+    std::vector<BinaryTraceEvent> mEvents;
+    bool mSorted;
+};
+
+}
+
+#endif   // COMMON_BINARYTRACEREADER_H_
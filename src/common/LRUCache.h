@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// LRUCache.h: Defines gl::LRUCache, a bounded map which evicts its least recently used entry
+// to make room for new ones. Lookups, insertions and evictions take constant time: every entry
+// is linked into a recency list through pointers stored alongside its value.
+
+#ifndef COMMON_LRUCACHE_H_
+#define COMMON_LRUCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+
+namespace gl
+{
+
+struct LRUCacheStatistics
+{
+    LRUCacheStatistics() : hits(0), misses(0), insertions(0), evictions(0) {}
+
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long insertions;
+    unsigned long long evictions;
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key> >
+class LRUCache
+{
+  public:
+    // Called with the value of every entry leaving the cache, whether it is evicted, erased,
+    // replaced or cleared. Caches of Direct3D objects pass SafeRelease.
+    typedef void (*ReleaseFunction)(Value &value);
+
+    LRUCache(size_t maxEntries, ReleaseFunction release, const Hash &hash = Hash(), const KeyEqual &keyEqual = KeyEqual())
+        : mEntries(maxEntries, hash, keyEqual),
+          mMaxEntries(maxEntries),
+          mRelease(release),
+          mNewest(NULL),
+          mOldest(NULL)
+    {
+        ASSERT(maxEntries > 0);
+    }
+
+    ~LRUCache()
+    {
+        clear();
+    }
+
+    // Returns the cached value and marks it as the most recently used, or NULL on a miss
+    Value *get(const Key &key)
+    {
+        typename EntryMap::iterator entry = mEntries.find(key);
+        if (entry == mEntries.end())
+        {
+            mStatistics.misses++;
+            return NULL;
+        }
+
+        mStatistics.hits++;
+        unlink(&entry->second);
+        linkNewest(&entry->second);
+        return &entry->second.value;
+    }
+
+    // Inserts or replaces the value for key as the most recently used entry, evicting the least
+    // recently used entry first if the cache is full
+    Value *put(const Key &key, const Value &value)
+    {
+        typename EntryMap::iterator existing = mEntries.find(key);
+        if (existing != mEntries.end())
+        {
+            Entry *entry = &existing->second;
+            releaseValue(entry);
+            entry->value = value;
+            unlink(entry);
+            linkNewest(entry);
+            return &entry->value;
+        }
+
+        evictIfFull();
+
+        std::pair<typename EntryMap::iterator, bool> inserted = mEntries.insert(std::make_pair(key, Entry(value)));
+        ASSERT(inserted.second);
+
+        // Elements of an unordered_map are never moved, so the key can be referenced directly
+        Entry *entry = &inserted.first->second;
+        entry->key = &inserted.first->first;
+        linkNewest(entry);
+
+        mStatistics.insertions++;
+        return &entry->value;
+    }
+
+    // Evicts the least recently used entry if the cache is full. Callers which must free an
+    // entry's resources before creating its replacement call this ahead of put.
+    void evictIfFull()
+    {
+        if (mEntries.size() >= mMaxEntries)
+        {
+            mStatistics.evictions++;
+            removeEntry(mOldest);
+        }
+    }
+
+    bool erase(const Key &key)
+    {
+        typename EntryMap::iterator entry = mEntries.find(key);
+        if (entry == mEntries.end())
+        {
+            return false;
+        }
+
+        removeEntry(&entry->second);
+        return true;
+    }
+
+    void clear()
+    {
+        for (typename EntryMap::iterator entry = mEntries.begin(); entry != mEntries.end(); entry++)
+        {
+            releaseValue(&entry->second);
+        }
+
+        mEntries.clear();
+        mNewest = NULL;
+        mOldest = NULL;
+    }
+
+    size_t size() const { return mEntries.size(); }
+    size_t maxSize() const { return mMaxEntries; }
+    bool empty() const { return mEntries.empty(); }
+
+    const LRUCacheStatistics &getStatistics() const { return mStatistics; }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(LRUCache);
+
+    struct Entry
+    {
+        explicit Entry(const Value &value) : value(value), key(NULL), newer(NULL), older(NULL) {}
+
+        Value value;
+        const Key *key;
+        Entry *newer;
+        Entry *older;
+    };
+
+    typedef std::unordered_map<Key, Entry, Hash, KeyEqual> EntryMap;
+
+    void linkNewest(Entry *entry)
+    {
+        entry->newer = NULL;
+        entry->older = mNewest;
+        if (mNewest)
+        {
+            mNewest->newer = entry;
+        }
+        mNewest = entry;
+
+        if (!mOldest)
+        {
+            mOldest = entry;
+        }
+    }
+
+    void unlink(Entry *entry)
+    {
+        if (entry->newer)
+        {
+            entry->newer->older = entry->older;
+        }
+        else
+        {
+            mNewest = entry->older;
+        }
+
+        if (entry->older)
+        {
+            entry->older->newer = entry->newer;
+        }
+        else
+        {
+            mOldest = entry->newer;
+        }
+    }
+
+    void releaseValue(Entry *entry)
+    {
+        if (mRelease)
+        {
+            mRelease(entry->value);
+        }
+    }
+
+    void removeEntry(Entry *entry)
+    {
+        unlink(entry);
+        releaseValue(entry);
+        // Erase through an iterator, the key is destroyed along with the element
+        mEntries.erase(mEntries.find(*entry->key));
+    }
+
+    EntryMap mEntries;
+    const size_t mMaxEntries;
+    ReleaseFunction mRelease;
+
+    // The recency list runs from the most recently used entry to the least recently used one
+    Entry *mNewest;
+    Entry *mOldest;
+
+    LRUCacheStatistics mStatistics;
+};
+
+}
+
+#endif   // COMMON_LRUCACHE_H_
@@ -0,0 +1,666 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// RingBufferTracer.cpp: Implements gl::RingBufferTracer, which records trace events in a
+// lock-free ring buffer per thread.
+
+#include "common/RingBufferTracer.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "common/BinaryTraceFormat.h"
+#include "common/debug.h"
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+#if defined(_WIN32)
+#define TRACE_MEMORY_BARRIER() MemoryBarrier()
+#else
+#define TRACE_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+namespace gl
+{
+
+namespace
+{
+
+const size_t DefaultBufferSize = 1024 * 1024;
+const unsigned int DefaultFlushIntervalMilliseconds = 50;
+
+// Longer messages and format strings are truncated
+const size_t MaxTextLength = 1023;
+
+// Format strings the thread has defined in the trace, found by their address
+const size_t DefinedStringSlots = 1024;
+
+size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t TextWords(size_t length)
+{
+    // Includes the terminating NUL
+    return (length + sizeof(unsigned long long)) / sizeof(unsigned long long);
+}
+
+}
+
+struct RingBufferTracer::ThreadBuffer
+{
+    ThreadBuffer(unsigned int threadIndex, size_t words)
+        : threadIndex(threadIndex),
+          words(words),
+          mask(words - 1),
+          head(0),
+          tail(0),
+          recorded(0),
+          dropped(0),
+          totalDropped(0)
+    {
+        memset(definedStrings, 0, sizeof(definedStrings));
+    }
+
+    // Only changed while no thread owns the buffer
+    unsigned int threadIndex;
+    std::vector<unsigned long long> words;
+    const size_t mask;
+
+    // Word positions which only ever grow. The recording thread alone advances the head, and the
+    // flush alone advances the tail.
+    volatile size_t head;
+    volatile size_t tail;
+
+    // Only written by the recording thread
+    unsigned long long recorded;
+    unsigned long long dropped;        // Since the last dropped record
+    unsigned long long totalDropped;
+    const char *definedStrings[DefinedStringSlots];
+};
+
+RingBufferTracerStatistics::RingBufferTracerStatistics()
+    : recordsWritten(0),
+      recordsDropped(0),
+      bytesFlushed(0),
+      threads(0),
+      buffers(0)
+{
+}
+
+RingBufferTracer *RingBufferTracer::mInstance = NULL;
+
+RingBufferTracer::RingBufferTracer(const char *path, size_t bufferSize, unsigned int flushIntervalMilliseconds)
+    : mFile(NULL),
+      mBufferWords(RoundUpToPowerOfTwo(std::max<size_t>(bufferSize / sizeof(unsigned long long), 256))),
+      mFlushIntervalMilliseconds(flushIntervalMilliseconds),
+      mThreadCount(0),
+      mBytesFlushed(0),
+      mExiting(false),
+      mFlusherUsers(0)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    mTicksPerSecond = frequency.QuadPart;
+
+    mThreadBufferIndex = TlsAlloc();
+    InitializeCriticalSection(&mLock);
+    InitializeCriticalSection(&mFlusherLock);
+    mFlusherWake = CreateEvent(NULL, FALSE, FALSE, NULL);
+    mFlusher = NULL;
+
+    if (mThreadBufferIndex == TLS_OUT_OF_INDEXES)
+    {
+        return;
+    }
+#else
+    mTicksPerSecond = 1000000000ULL;
+
+    pthread_key_create(&mThreadBufferKey, NULL);
+    pthread_mutex_init(&mLock, NULL);
+    pthread_mutex_init(&mFlusherLock, NULL);
+    pthread_cond_init(&mFlusherWake, NULL);
+    mFlusherStarted = false;
+#endif
+
+    mFile = fopen(path, "wb");
+}
+
+RingBufferTracer::~RingBufferTracer()
+{
+    joinFlusher();
+    close();
+
+    for (size_t index = 0; index < mBuffers.size(); index++)
+    {
+        delete mBuffers[index];
+    }
+
+#if defined(_WIN32)
+    if (mThreadBufferIndex != TLS_OUT_OF_INDEXES)
+    {
+        TlsFree(mThreadBufferIndex);
+    }
+    CloseHandle(mFlusherWake);
+    DeleteCriticalSection(&mFlusherLock);
+    DeleteCriticalSection(&mLock);
+#else
+    pthread_key_delete(mThreadBufferKey);
+    pthread_cond_destroy(&mFlusherWake);
+    pthread_mutex_destroy(&mFlusherLock);
+    pthread_mutex_destroy(&mLock);
+#endif
+}
+
+void RingBufferTracer::initializeInstance(const char *path)
+{
+    if (!mInstance)
+    {
+        mInstance = new RingBufferTracer(path, DefaultBufferSize, DefaultFlushIntervalMilliseconds);
+        if (!mInstance->isOpen())
+        {
+            SafeDelete(mInstance);
+        }
+    }
+}
+
+void RingBufferTracer::releaseInstance()
+{
+    // This runs under the loader lock while other threads may still be recording, so the tracer
+    // is not deleted under them. Without a file, what they record is never flushed.
+    RingBufferTracer *instance = mInstance;
+    mInstance = NULL;
+    if (instance)
+    {
+        instance->close();
+    }
+}
+
+void RingBufferTracer::startFlusher()
+{
+#if defined(_WIN32)
+    EnterCriticalSection(&mFlusherLock);
+#else
+    pthread_mutex_lock(&mFlusherLock);
+#endif
+
+    if (mFlusherUsers++ == 0 && mFile && mFlushIntervalMilliseconds > 0)
+    {
+        mExiting = false;
+#if defined(_WIN32)
+        mFlusher = CreateThread(NULL, 0, flusherMain, this, 0, NULL);
+#else
+        mFlusherStarted = (pthread_create(&mFlusher, NULL, flusherMain, this) == 0);
+#endif
+    }
+
+#if defined(_WIN32)
+    LeaveCriticalSection(&mFlusherLock);
+#else
+    pthread_mutex_unlock(&mFlusherLock);
+#endif
+}
+
+void RingBufferTracer::stopFlusher()
+{
+#if defined(_WIN32)
+    EnterCriticalSection(&mFlusherLock);
+#else
+    pthread_mutex_lock(&mFlusherLock);
+#endif
+
+    if (mFlusherUsers > 0 && --mFlusherUsers == 0)
+    {
+        joinFlusher();
+        flush();
+    }
+
+#if defined(_WIN32)
+    LeaveCriticalSection(&mFlusherLock);
+#else
+    pthread_mutex_unlock(&mFlusherLock);
+#endif
+}
+
+void RingBufferTracer::releaseThreadBuffer()
+{
+#if defined(_WIN32)
+    if (mThreadBufferIndex == TLS_OUT_OF_INDEXES)
+    {
+        return;
+    }
+    ThreadBuffer *buffer = static_cast<ThreadBuffer*>(TlsGetValue(mThreadBufferIndex));
+    TlsSetValue(mThreadBufferIndex, NULL);
+#else
+    ThreadBuffer *buffer = static_cast<ThreadBuffer*>(pthread_getspecific(mThreadBufferKey));
+    pthread_setspecific(mThreadBufferKey, NULL);
+#endif
+
+    if (buffer)
+    {
+        lock();
+        mFreeBuffers.push_back(buffer);
+        unlock();
+    }
+}
+
+void RingBufferTracer::beginEvent(const char *format, va_list arguments)
+{
+    ThreadBuffer *buffer = getThreadBuffer();
+    if (!buffer)
+    {
+        return;
+    }
+
+    defineString(buffer, format);
+
+    BinaryTraceArgumentKind kinds[BinaryTraceMaxArguments];
+    size_t argumentCount = ParseBinaryTraceFormat(format, kinds);
+
+    unsigned long long payload[BinaryTraceMaxArguments * (1 + (BinaryTraceMaxStringLength + 1) / sizeof(unsigned long long))];
+    size_t payloadWords = 0;
+
+    for (size_t argument = 0; argument < argumentCount; argument++)
+    {
+        switch (kinds[argument])
+        {
+          case BINARY_TRACE_ARGUMENT_INT:
+            payload[payloadWords++] = static_cast<unsigned int>(va_arg(arguments, int));
+            break;
+          case BINARY_TRACE_ARGUMENT_LONG:
+            payload[payloadWords++] = static_cast<unsigned long long>(va_arg(arguments, long));
+            break;
+          case BINARY_TRACE_ARGUMENT_LONG_LONG:
+            payload[payloadWords++] = static_cast<unsigned long long>(va_arg(arguments, long long));
+            break;
+          case BINARY_TRACE_ARGUMENT_POINTER:
+            payload[payloadWords++] = reinterpret_cast<size_t>(va_arg(arguments, const void*));
+            break;
+          case BINARY_TRACE_ARGUMENT_DOUBLE:
+            {
+                double value = va_arg(arguments, double);
+                memcpy(&payload[payloadWords++], &value, sizeof(value));
+            }
+            break;
+          case BINARY_TRACE_ARGUMENT_STRING:
+            {
+                const char *string = va_arg(arguments, const char*);
+                size_t length = string ? std::min(strlen(string), BinaryTraceMaxStringLength) : 0;
+
+                // A length of all ones marks a NULL string
+                payload[payloadWords++] = string ? length : ~0ULL;
+
+                size_t textWords = TextWords(length);
+                memset(&payload[payloadWords], 0, textWords * sizeof(unsigned long long));
+                if (string)
+                {
+                    memcpy(&payload[payloadWords], string, length);
+                }
+                payloadWords += textWords;
+            }
+            break;
+          default:
+            UNREACHABLE();
+        }
+    }
+
+    write(buffer, BINARY_TRACE_BEGIN, format, payload, payloadWords);
+}
+
+void RingBufferTracer::endEvent()
+{
+    ThreadBuffer *buffer = getThreadBuffer();
+    if (buffer)
+    {
+        write(buffer, BINARY_TRACE_END, NULL, NULL, 0);
+    }
+}
+
+void RingBufferTracer::message(const char *format, va_list arguments)
+{
+    ThreadBuffer *buffer = getThreadBuffer();
+    if (!buffer)
+    {
+        return;
+    }
+
+    unsigned long long payload[(MaxTextLength + 1) / sizeof(unsigned long long)];
+    char *text = reinterpret_cast<char*>(payload);
+
+    // Some C runtimes return -1 for truncated messages and do not terminate them
+    int length = vsnprintf(text, MaxTextLength + 1, format, arguments);
+    size_t storedLength = (length < 0) ? MaxTextLength : std::min(static_cast<size_t>(length), MaxTextLength);
+    size_t textWords = TextWords(storedLength);
+    memset(text + storedLength, 0, textWords * sizeof(unsigned long long) - storedLength);
+
+    write(buffer, BINARY_TRACE_MESSAGE, format, payload, textWords);
+}
+
+void RingBufferTracer::flush()
+{
+    lock();
+
+    mFlushWords.clear();
+    for (size_t index = 0; index < mBuffers.size(); index++)
+    {
+        ThreadBuffer *buffer = mBuffers[index];
+
+        size_t head = buffer->head;
+        TRACE_MEMORY_BARRIER();
+
+        for (size_t position = buffer->tail; position != head; position++)
+        {
+            mFlushWords.push_back(buffer->words[position & buffer->mask]);
+        }
+
+        // The words must be read before the thread may overwrite them
+        TRACE_MEMORY_BARRIER();
+        buffer->tail = head;
+    }
+
+    if (mFile && !mFlushWords.empty())
+    {
+        BinaryTraceChunkHeader header;
+        header.magic = BinaryTraceMagic;
+        header.version = BinaryTraceVersion;
+        header.ticksPerSecond = mTicksPerSecond;
+        header.wordCount = mFlushWords.size();
+
+        fwrite(&header, sizeof(header), 1, mFile);
+        fwrite(&mFlushWords[0], sizeof(unsigned long long), mFlushWords.size(), mFile);
+        fflush(mFile);
+
+        mBytesFlushed += sizeof(header) + mFlushWords.size() * sizeof(unsigned long long);
+    }
+
+    unlock();
+}
+
+RingBufferTracerStatistics RingBufferTracer::getStatistics()
+{
+    RingBufferTracerStatistics statistics;
+
+    lock();
+
+    // The counters of threads which are still recording may be slightly behind
+    for (size_t index = 0; index < mBuffers.size(); index++)
+    {
+        statistics.recordsWritten += mBuffers[index]->recorded;
+        statistics.recordsDropped += mBuffers[index]->totalDropped;
+    }
+    statistics.bytesFlushed = mBytesFlushed;
+    statistics.threads = mThreadCount;
+    statistics.buffers = mBuffers.size();
+
+    unlock();
+
+    return statistics;
+}
+
+RingBufferTracer::ThreadBuffer *RingBufferTracer::getThreadBuffer()
+{
+#if defined(_WIN32)
+    if (mThreadBufferIndex == TLS_OUT_OF_INDEXES)
+    {
+        return NULL;
+    }
+    ThreadBuffer *buffer = static_cast<ThreadBuffer*>(TlsGetValue(mThreadBufferIndex));
+#else
+    ThreadBuffer *buffer = static_cast<ThreadBuffer*>(pthread_getspecific(mThreadBufferKey));
+#endif
+
+    if (!buffer)
+    {
+        lock();
+        if (!mFreeBuffers.empty())
+        {
+            // Records of the previous owner still waiting to be flushed keep its thread index
+            buffer = mFreeBuffers.back();
+            mFreeBuffers.pop_back();
+            buffer->threadIndex = mThreadCount;
+            memset(buffer->definedStrings, 0, sizeof(buffer->definedStrings));
+        }
+        else
+        {
+            buffer = new ThreadBuffer(mThreadCount, mBufferWords);
+            mBuffers.push_back(buffer);
+        }
+        mThreadCount++;
+        unlock();
+
+#if defined(_WIN32)
+        TlsSetValue(mThreadBufferIndex, buffer);
+#else
+        pthread_setspecific(mThreadBufferKey, buffer);
+#endif
+    }
+
+    return buffer;
+}
+
+void RingBufferTracer::write(ThreadBuffer *buffer, unsigned char type, const void *id, const unsigned long long *payload, size_t payloadWords)
+{
+    size_t recordWords = BinaryTraceHeaderWords + payloadWords;
+    size_t droppedWords = (buffer->dropped > 0) ? BinaryTraceHeaderWords : 0;
+
+    size_t head = buffer->head;
+    size_t tail = buffer->tail;
+    TRACE_MEMORY_BARRIER();
+
+    if (head - tail + recordWords + droppedWords > buffer->words.size())
+    {
+        buffer->dropped++;
+        buffer->totalDropped++;
+        return;
+    }
+
+    BinaryTraceRecordHeader header;
+    header.reserved = 0;
+    header.threadIndex = buffer->threadIndex;
+    header.timestamp = timestamp();
+
+    const unsigned long long *headerWords = reinterpret_cast<const unsigned long long*>(&header);
+
+    if (droppedWords > 0)
+    {
+        header.type = BINARY_TRACE_DROPPED;
+        header.wordCount = BinaryTraceHeaderWords;
+        header.id = buffer->dropped;
+
+        for (size_t word = 0; word < BinaryTraceHeaderWords; word++)
+        {
+            buffer->words[head++ & buffer->mask] = headerWords[word];
+        }
+        buffer->dropped = 0;
+    }
+
+    header.type = type;
+    header.wordCount = static_cast<unsigned short>(recordWords);
+    header.id = reinterpret_cast<size_t>(id);
+
+    for (size_t word = 0; word < BinaryTraceHeaderWords; word++)
+    {
+        buffer->words[head++ & buffer->mask] = headerWords[word];
+    }
+    for (size_t word = 0; word < payloadWords; word++)
+    {
+        buffer->words[head++ & buffer->mask] = payload[word];
+    }
+
+    // Publish the head only once the record is complete
+    TRACE_MEMORY_BARRIER();
+    buffer->head = head;
+    buffer->recorded++;
+}
+
+bool RingBufferTracer::defineString(ThreadBuffer *buffer, const char *format)
+{
+    // With every slot taken, the string is defined before each use
+    const char **freeSlot = NULL;
+
+    size_t slot = (reinterpret_cast<size_t>(format) >> 2) % DefinedStringSlots;
+    for (size_t probe = 0; probe < DefinedStringSlots; probe++)
+    {
+        const char **defined = &buffer->definedStrings[(slot + probe) % DefinedStringSlots];
+        if (*defined == format)
+        {
+            return true;
+        }
+
+        if (*defined == NULL)
+        {
+            freeSlot = defined;
+            break;
+        }
+    }
+
+    size_t length = std::min(strlen(format), MaxTextLength);
+    unsigned long long payload[(MaxTextLength + 1) / sizeof(unsigned long long)];
+    size_t textWords = TextWords(length);
+    memset(payload, 0, textWords * sizeof(unsigned long long));
+    memcpy(payload, format, length);
+
+    size_t head = buffer->head;
+    write(buffer, BINARY_TRACE_STRING, format, payload, textWords);
+
+    // The string is defined again next time if it did not fit
+    bool written = (buffer->head != head);
+    if (written && freeSlot)
+    {
+        *freeSlot = format;
+    }
+
+    return written;
+}
+
+unsigned long long RingBufferTracer::timestamp() const
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<unsigned long long>(time.tv_sec) * 1000000000ULL + time.tv_nsec;
+#endif
+}
+
+void RingBufferTracer::lock()
+{
+#if defined(_WIN32)
+    EnterCriticalSection(&mLock);
+#else
+    pthread_mutex_lock(&mLock);
+#endif
+}
+
+void RingBufferTracer::unlock()
+{
+#if defined(_WIN32)
+    LeaveCriticalSection(&mLock);
+#else
+    pthread_mutex_unlock(&mLock);
+#endif
+}
+
+#if defined(_WIN32)
+DWORD WINAPI RingBufferTracer::flusherMain(LPVOID parameter)
+{
+    static_cast<RingBufferTracer*>(parameter)->runFlusher();
+    return 0;
+}
+#else
+void *RingBufferTracer::flusherMain(void *parameter)
+{
+    static_cast<RingBufferTracer*>(parameter)->runFlusher();
+    return NULL;
+}
+#endif
+
+void RingBufferTracer::runFlusher()
+{
+    while (!mExiting)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(mFlusherWake, mFlushIntervalMilliseconds);
+#else
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        unsigned long long nanoseconds = deadline.tv_nsec + mFlushIntervalMilliseconds * 1000000ULL;
+        deadline.tv_sec += nanoseconds / 1000000000ULL;
+        deadline.tv_nsec = nanoseconds % 1000000000ULL;
+
+        pthread_mutex_lock(&mLock);
+        if (!mExiting)
+        {
+            pthread_cond_timedwait(&mFlusherWake, &mLock, &deadline);
+        }
+        pthread_mutex_unlock(&mLock);
+#endif
+
+        if (!mExiting)
+        {
+            flush();
+        }
+    }
+}
+
+void RingBufferTracer::joinFlusher()
+{
+#if defined(_WIN32)
+    if (mFlusher)
+    {
+        mExiting = true;
+        SetEvent(mFlusherWake);
+
+        WaitForSingleObject(mFlusher, INFINITE);
+        CloseHandle(mFlusher);
+        mFlusher = NULL;
+    }
+#else
+    if (mFlusherStarted)
+    {
+        pthread_mutex_lock(&mLock);
+        mExiting = true;
+        pthread_cond_signal(&mFlusherWake);
+        pthread_mutex_unlock(&mLock);
+
+        pthread_join(mFlusher, NULL);
+        mFlusherStarted = false;
+    }
+#endif
+}
+
+void RingBufferTracer::close()
+{
+    // A flusher which is still running stops at its next wake up
+    mExiting = true;
+#if defined(_WIN32)
+    SetEvent(mFlusherWake);
+#endif
+
+    flush();
+
+    lock();
+    if (mFile)
+    {
+        fclose(mFile);
+        mFile = NULL;
+    }
+    unlock();
+}
+
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// RingBufferTracer.h: Defines gl::RingBufferTracer, which records trace events as compact
+// binary records in a lock-free ring buffer per thread. A background thread drains the buffers
+// into a file laid out as described in BinaryTraceFormat.h.
+
+#ifndef COMMON_RINGBUFFERTRACER_H_
+#define COMMON_RINGBUFFERTRACER_H_
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <vector>
+
+#include "common/angleutils.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace gl
+{
+
+struct RingBufferTracerStatistics
+{
+    RingBufferTracerStatistics();
+
+    unsigned long long recordsWritten;
+    unsigned long long recordsDropped;
+    unsigned long long bytesFlushed;
+    unsigned int threads;
+    unsigned int buffers;
+};
+
+class RingBufferTracer
+{
+  public:
+    // The buffer size is per thread, in bytes. Records which do not fit are dropped and counted
+    // rather than blocking the thread. A flush interval of 0 disables the background thread.
+    RingBufferTracer(const char *path, size_t bufferSize, unsigned int flushIntervalMilliseconds);
+    ~RingBufferTracer();
+
+    // The process-wide tracer used by the EVENT, TRACE, FIXME and ERR macros. Releasing it closes
+    // the file but leaves the tracer to the process, since other threads may still be recording.
+    static void initializeInstance(const char *path);
+    static void releaseInstance();
+    static RingBufferTracer *getInstance() { return mInstance; }
+
+    // The background thread runs between matching start and stop calls. Stopping waits for the
+    // thread to exit, so it must not be called from DllMain.
+    void startFlusher();
+    void stopFlusher();
+
+    // Called by exiting threads, so a thread started later reuses the buffer
+    void releaseThreadBuffer();
+
+    bool isOpen() const { return mFile != NULL; }
+
+    // Records the format string address and the raw argument words of an EVENT scope
+    void beginEvent(const char *format, va_list arguments);
+    void endEvent();
+
+    // Messages are rare and formatted on the calling thread
+    void message(const char *format, va_list arguments);
+
+    // Writes out everything the threads have recorded so far
+    void flush();
+
+    RingBufferTracerStatistics getStatistics();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(RingBufferTracer);
+
+    struct ThreadBuffer;
+
+    ThreadBuffer *getThreadBuffer();
+    void write(ThreadBuffer *buffer, unsigned char type, const void *id, const unsigned long long *payload, size_t payloadWords);
+    bool defineString(ThreadBuffer *buffer, const char *format);
+    unsigned long long timestamp() const;
+
+    void lock();
+    void unlock();
+
+#if defined(_WIN32)
+    static DWORD WINAPI flusherMain(LPVOID parameter);
+#else
+    static void *flusherMain(void *parameter);
+#endif
+    void runFlusher();
+    void joinFlusher();
+    void close();
+
+    FILE *mFile;
+    const size_t mBufferWords;
+    const unsigned int mFlushIntervalMilliseconds;
+    unsigned long long mTicksPerSecond;
+
+    // Buffers are kept until the tracer is destroyed. Those released by exited threads are handed
+    // to new threads, and the records they still hold are flushed as usual.
+    std::vector<ThreadBuffer*> mBuffers;
+    std::vector<ThreadBuffer*> mFreeBuffers;
+    unsigned int mThreadCount;
+    std::vector<unsigned long long> mFlushWords;
+    unsigned long long mBytesFlushed;
+
+    volatile bool mExiting;
+    unsigned int mFlusherUsers;
+
+#if defined(_WIN32)
+    DWORD mThreadBufferIndex;
+    CRITICAL_SECTION mLock;
+    CRITICAL_SECTION mFlusherLock;
+    HANDLE mFlusherWake;
+    HANDLE mFlusher;
+#else
+    pthread_key_t mThreadBufferKey;
+    pthread_mutex_t mLock;
+    pthread_mutex_t mFlusherLock;
+    pthread_cond_t mFlusherWake;
+    pthread_t mFlusher;
+    bool mFlusherStarted;
+#endif
+
+    static RingBufferTracer *mInstance;
+};
+
+}
+
+#endif   // COMMON_RINGBUFFERTRACER_H_
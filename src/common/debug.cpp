@@ -9,6 +9,10 @@
 #include "common/debug.h"
 #include <stdarg.h>
 
+#if defined(ANGLE_ENABLE_TRACE)
+#include "common/RingBufferTracer.h"
+#endif
+
 #if defined(ANGLE_ENABLE_PERF)
 #include <d3d9.h>
 #endif
@@ -21,7 +25,7 @@ typedef void (WINAPI *PerfOutputFunction)(D3DCOLOR, LPCWSTR);
 typedef void (*PerfOutputFunction)(unsigned int, const wchar_t*);
 #endif
 
-static void output(bool traceFileDebugOnly, PerfOutputFunction perfFunc, const char *format, va_list vararg)
+static void outputPerf(PerfOutputFunction perfFunc, const char *format, va_list vararg)
 {
 #if defined(ANGLE_ENABLE_PERF)
     if (perfActive())
@@ -44,7 +48,10 @@ static void output(bool traceFileDebugOnly, PerfOutputFunction perfFunc, const c
         perfFunc(0, wideMessage);
     }
 #endif // ANGLE_ENABLE_PERF
+}
 
+static void outputTrace(bool traceFileDebugOnly, const char *format, va_list vararg)
+{
 #if defined(ANGLE_ENABLE_TRACE)
 #if defined(NDEBUG)
     if (traceFileDebugOnly)
@@ -53,6 +60,14 @@ static void output(bool traceFileDebugOnly, PerfOutputFunction perfFunc, const c
     }
 #endif // NDEBUG
 
+    RingBufferTracer *tracer = RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        tracer->message(format, vararg);
+        return;
+    }
+
+    // Modules which do not set up a tracer append to the text log
     FILE* file = fopen(TRACE_OUTPUT_FILE, "a");
     if (file)
     {
@@ -62,6 +77,12 @@ static void output(bool traceFileDebugOnly, PerfOutputFunction perfFunc, const c
 #endif // ANGLE_ENABLE_TRACE
 }
 
+static void output(bool traceFileDebugOnly, PerfOutputFunction perfFunc, const char *format, va_list vararg)
+{
+    outputPerf(perfFunc, format, vararg);
+    outputTrace(traceFileDebugOnly, format, vararg);
+}
+
 void trace(bool traceFileDebugOnly, const char *format, ...)
 {
     va_list vararg;
@@ -86,22 +107,56 @@ bool perfActive()
 
 ScopedPerfEventHelper::ScopedPerfEventHelper(const char* format, ...)
 {
+#if defined(ANGLE_ENABLE_TRACE)
+    // Events are cheap enough to record in binary form in release builds too
+    RingBufferTracer *tracer = RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        va_list vararg;
+        va_start(vararg, format);
+        tracer->beginEvent(format, vararg);
+        va_end(vararg);
+    }
+#endif // ANGLE_ENABLE_TRACE
+
 #if defined(ANGLE_ENABLE_PERF)
-#if !defined(ANGLE_ENABLE_TRACE)
+#if defined(ANGLE_ENABLE_TRACE)
+    if (!perfActive() && tracer)
+    {
+        return;
+    }
+#else
     if (!perfActive())
     {
         return;
     }
-#endif // !ANGLE_ENABLE_TRACE
+#endif // ANGLE_ENABLE_TRACE
     va_list vararg;
     va_start(vararg, format);
-    output(true, reinterpret_cast<PerfOutputFunction>(D3DPERF_BeginEvent), format, vararg);
+    outputPerf(reinterpret_cast<PerfOutputFunction>(D3DPERF_BeginEvent), format, vararg);
     va_end(vararg);
+
+#if defined(ANGLE_ENABLE_TRACE)
+    if (!tracer)
+    {
+        va_start(vararg, format);
+        outputTrace(true, format, vararg);
+        va_end(vararg);
+    }
+#endif // ANGLE_ENABLE_TRACE
 #endif // ANGLE_ENABLE_PERF
 }
 
 ScopedPerfEventHelper::~ScopedPerfEventHelper()
 {
+#if defined(ANGLE_ENABLE_TRACE)
+    RingBufferTracer *tracer = RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        tracer->endEvent();
+    }
+#endif // ANGLE_ENABLE_TRACE
+
 #if defined(ANGLE_ENABLE_PERF)
     if (perfActive())
     {
@@ -13,6 +13,7 @@
 #include "DiagnosticsBase.h"
 #include "DirectiveHandlerBase.h"
 #include "ExpressionParser.h"
+#include "Macro.h"
 #include "MacroExpander.h"
 #include "Token.h"
 #include "Tokenizer.h"
@@ -116,26 +117,6 @@ static void skipUntilEOD(pp::Lexer* lexer, pp::Token* token)
     }
 }
 
-static bool isMacroNameReserved(const std::string& name)
-{
-    // Names prefixed with "GL_" are reserved.
-    if (name.substr(0, 3) == "GL_")
-        return true;
-
-    // Names containing two consecutive underscores are reserved.
-    if (name.find("__") != std::string::npos)
-        return true;
-
-    return false;
-}
-
-static bool isMacroPredefined(const std::string& name,
-                              const pp::MacroSet& macroSet)
-{
-    pp::MacroSet::const_iterator iter = macroSet.find(name);
-    return iter != macroSet.end() ? iter->second.predefined : false;
-}
-
 namespace pp
 {
 
@@ -177,8 +158,7 @@ class DefinedParser : public Lexer
             skipUntilEOD(mLexer, token);
             return;
         }
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        std::string expression = iter != mMacroSet->end() ? "1" : "0";
+        std::string expression = mMacroSet->find(token->text) ? "1" : "0";
 
         if (paren)
         {
@@ -393,15 +373,18 @@ void DirectiveParser::parseDefine(Token* token)
     }
 
     // Check for macro redefinition.
-    MacroSet::const_iterator iter = mMacroSet->find(macro.name);
-    if (iter != mMacroSet->end() && !macro.equals(iter->second))
+    const Macro* existing = mMacroSet->find(macro.name);
+    if (existing)
     {
-        mDiagnostics->report(Diagnostics::PP_MACRO_REDEFINED,
-                             token->location,
-                             macro.name);
+        if (!macro.equals(*existing))
+        {
+            mDiagnostics->report(Diagnostics::PP_MACRO_REDEFINED,
+                                 token->location,
+                                 macro.name);
+        }
         return;
     }
-    mMacroSet->insert(std::make_pair(macro.name, macro));
+    mMacroSet->insert(macro);
 }
 
 void DirectiveParser::parseUndef(Token* token)
@@ -416,17 +399,17 @@ void DirectiveParser::parseUndef(Token* token)
         return;
     }
 
-    MacroSet::iterator iter = mMacroSet->find(token->text);
-    if (iter != mMacroSet->end())
+    const Macro* macro = mMacroSet->find(token->text);
+    if (macro)
     {
-        if (iter->second.predefined)
+        if (macro->predefined)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_UNDEFINED,
                                  token->location, token->text);
         }
         else
         {
-            mMacroSet->erase(iter);
+            mMacroSet->erase(token->text);
         }
     }
 
@@ -932,8 +915,7 @@ int DirectiveParser::parseExpressionIfdef(Token* token)
         return 0;
     }
 
-    MacroSet::const_iterator iter = mMacroSet->find(token->text);
-    int expression = iter != mMacroSet->end() ? 1 : 0;
+    int expression = mMacroSet->find(token->text) ? 1 : 0;
 
     // Warn if there are tokens after #ifdef expression.
     mTokenizer->lex(token);
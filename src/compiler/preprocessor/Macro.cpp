@@ -19,5 +19,121 @@ bool Macro::equals(const Macro& other) const
            (replacements == other.replacements);
 }
 
-}  // namespace pp
+const Macro* MacroSet::find(const std::string& name) const
+{
+    if (mLookups)
+        mLookups->insert(name);
+
+    std::map<std::string, Macro>::const_iterator iter = mMacros.find(name);
+    if (iter != mMacros.end())
+        return &iter->second;
+
+    if (mSnapshot && (mErased.empty() || mErased.count(name) == 0))
+        return mSnapshot->find(name);
+    return NULL;
+}
+
+void MacroSet::insert(const Macro& macro)
+{
+    mMacros[macro.name] = macro;
+    if (!mErased.empty())
+        mErased.erase(macro.name);
+}
+
+void MacroSet::erase(const std::string& name)
+{
+    mMacros.erase(name);
+    if (mSnapshot && mSnapshot->find(name))
+        mErased.insert(name);
+}
+
+MacroSnapshot::MacroSnapshot(const MacroSet& macros)
+{
+    // The macros of the set replace those of its own snapshot.
+    std::map<std::string, const Macro*> byName;
+    if (macros.mSnapshot)
+    {
+        const MacroSnapshot& snapshot = *macros.mSnapshot;
+        for (size_t i = 0; i < snapshot.mMacros.size(); ++i)
+        {
+            const std::string& name = snapshot.mMacros[i].name;
+            if (macros.mErased.count(name) == 0)
+                byName[name] = &snapshot.mMacros[i];
+        }
+    }
+    for (std::map<std::string, Macro>::const_iterator iter = macros.mMacros.begin();
+         iter != macros.mMacros.end(); ++iter)
+    {
+        byName[iter->first] = &iter->second;
+    }
+
+    // Keep at least half of the slots free.
+    size_t slotCount = 8;
+    while (slotCount < byName.size() * 2)
+        slotCount *= 2;
+    mSlots.resize(slotCount, 0);
 
+    for (std::map<std::string, const Macro*>::const_iterator iter = byName.begin();
+         iter != byName.end(); ++iter)
+    {
+        size_t hash = Hash(iter->first);
+        size_t slot = hash & (slotCount - 1);
+        while (mSlots[slot] != 0)
+            slot = (slot + 1) & (slotCount - 1);
+
+        mMacros.push_back(*iter->second);
+        mMacros.back().disabled = false;
+        mHashes.push_back(hash);
+        mSlots[slot] = static_cast<unsigned int>(mMacros.size());
+    }
+}
+
+MacroSnapshot::~MacroSnapshot()
+{
+}
+
+const Macro* MacroSnapshot::find(const std::string& name) const
+{
+    size_t hash = Hash(name);
+    size_t mask = mSlots.size() - 1;
+    for (size_t slot = hash & mask; mSlots[slot] != 0; slot = (slot + 1) & mask)
+    {
+        size_t index = mSlots[slot] - 1;
+        if (mHashes[index] == hash && mMacros[index].name == name)
+            return &mMacros[index];
+    }
+    return NULL;
+}
+
+size_t MacroSnapshot::Hash(const std::string& name)
+{
+    // 32-bit FNV-1a.
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool isMacroNameReserved(const std::string& name)
+{
+    // Names prefixed with "GL_" are reserved.
+    if (name.substr(0, 3) == "GL_")
+        return true;
+
+    // Names containing two consecutive underscores are reserved.
+    if (name.find("__") != std::string::npos)
+        return true;
+
+    return false;
+}
+
+bool isMacroPredefined(const std::string& name, const MacroSet& macroSet)
+{
+    const Macro* macro = macroSet.find(name);
+    return macro ? macro->predefined : false;
+}
+
+}  // namespace pp
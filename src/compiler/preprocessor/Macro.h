@@ -8,9 +8,12 @@
 #define COMPILER_PREPROCESSOR_MACRO_H_
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "pp_utils.h"
+
 namespace pp
 {
 
@@ -38,7 +41,68 @@ struct Macro
     Replacements replacements;
 };
 
-typedef std::map<std::string, Macro> MacroSet;
+class MacroSnapshot;
+
+// The macros by name. A set can start from the macros of a snapshot, which it
+// shares with other sets and never changes; macros defined or undefined later
+// only change the set itself. The names looked up can be recorded, to know
+// which definitions the preprocessed source depends on.
+class MacroSet
+{
+  public:
+    MacroSet() : mSnapshot(NULL), mLookups(NULL) { }
+
+    // Starts from the macros of a snapshot, which must outlive the set.
+    void setSnapshot(const MacroSnapshot* snapshot) { mSnapshot = snapshot; }
+
+    // Returns NULL if there is no macro with the name.
+    const Macro* find(const std::string& name) const;
+    // Defines the macro, replacing one with the same name.
+    void insert(const Macro& macro);
+    void erase(const std::string& name);
+
+    // Adds the names looked up from now on to lookups, or stops recording
+    // them if lookups is NULL.
+    void recordLookups(std::set<std::string>* lookups) { mLookups = lookups; }
+
+  private:
+    friend class MacroSnapshot;
+
+    const MacroSnapshot* mSnapshot;
+    std::map<std::string, Macro> mMacros;
+    // Macros of the snapshot undefined since.
+    std::set<std::string> mErased;
+    std::set<std::string>* mLookups;
+};
+
+// An immutable copy of the macros of a set, hashed by name.
+class MacroSnapshot
+{
+  public:
+    explicit MacroSnapshot(const MacroSet& macros);
+    ~MacroSnapshot();
+
+    // Returns NULL if there is no macro with the name.
+    const Macro* find(const std::string& name) const;
+    size_t size() const { return mMacros.size(); }
+
+  private:
+    PP_DISALLOW_COPY_AND_ASSIGN(MacroSnapshot);
+
+    static size_t Hash(const std::string& name);
+
+    std::vector<Macro> mMacros;
+    std::vector<size_t> mHashes;
+    // One more than the index of the macro in each slot, or 0 for empty
+    // slots. A macro whose slot is taken goes in the next free one.
+    std::vector<unsigned int> mSlots;
+};
+
+// Returns true if the name is reserved for the implementation, so that
+// shaders can't define a macro with it.
+bool isMacroNameReserved(const std::string& name);
+// Returns true if the name is the name of a pre-defined macro of the set.
+bool isMacroPredefined(const std::string& name, const MacroSet& macroSet);
 
 }  // namespace pp
 #endif  // COMPILER_PREPROCESSOR_MACRO_H_
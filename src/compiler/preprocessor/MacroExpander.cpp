@@ -57,8 +57,11 @@ MacroExpander::MacroExpander(Lexer* lexer,
 
 MacroExpander::~MacroExpander()
 {
+    // Macros may come from a snapshot other preprocessors share, so leave
+    // the ones still being expanded enabled.
     for (std::size_t i = 0; i < mContextStack.size(); ++i)
     {
+        mContextStack[i]->macro->disabled = false;
         delete mContextStack[i];
     }
 }
@@ -75,11 +78,11 @@ void MacroExpander::lex(Token* token)
         if (token->expansionDisabled())
             break;
 
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        if (iter == mMacroSet->end())
+        const Macro* found = mMacroSet->find(token->text);
+        if (!found)
             break;
 
-        const Macro& macro = iter->second;
+        const Macro& macro = *found;
         if (macro.disabled)
         {
             // If a particular token is not expanded, it is never expanded.
@@ -23,6 +23,7 @@ struct PreprocessorImpl
 {
     Diagnostics* diagnostics;
     MacroSet macroSet;
+    bool hasSnapshot;
     Tokenizer tokenizer;
     DirectiveParser directiveParser;
     MacroExpander macroExpander;
@@ -30,6 +31,7 @@ struct PreprocessorImpl
     PreprocessorImpl(Diagnostics* diag,
                      DirectiveHandler* directiveHandler) :
         diagnostics(diag),
+        hasSnapshot(false),
         tokenizer(diag),
         directiveParser(&tokenizer, &macroSet, diag, directiveHandler),
         macroExpander(&directiveParser, &macroSet, diag)
@@ -54,15 +56,29 @@ bool Preprocessor::init(size_t count,
 {
     static const int kGLSLVersion = 100;
 
-    // Add standard pre-defined macros.
-    predefineMacro("__LINE__", 0);
-    predefineMacro("__FILE__", 0);
-    predefineMacro("__VERSION__", kGLSLVersion);
-    predefineMacro("GL_ES", 1);
+    // Add standard pre-defined macros, unless they come from a snapshot.
+    if (!mImpl->hasSnapshot)
+    {
+        predefineMacro("__LINE__", 0);
+        predefineMacro("__FILE__", 0);
+        predefineMacro("__VERSION__", kGLSLVersion);
+        predefineMacro("GL_ES", 1);
+    }
 
     return mImpl->tokenizer.init(count, string, length);
 }
 
+void Preprocessor::startFromMacros(const MacroSnapshot* macros)
+{
+    mImpl->macroSet.setSnapshot(macros);
+    mImpl->hasSnapshot = macros != NULL;
+}
+
+MacroSnapshot* Preprocessor::snapshotMacros() const
+{
+    return new MacroSnapshot(mImpl->macroSet);
+}
+
 void Preprocessor::predefineMacro(const char* name, int value)
 {
     std::ostringstream stream;
@@ -78,7 +94,48 @@ void Preprocessor::predefineMacro(const char* name, int value)
     macro.name = name;
     macro.replacements.push_back(token);
 
-    mImpl->macroSet[name] = macro;
+    mImpl->macroSet.insert(macro);
+}
+
+bool Preprocessor::defineMacro(const char* name, const char* value)
+{
+    // The same names are rejected as by #define.
+    if (isMacroPredefined(name, mImpl->macroSet))
+    {
+        mImpl->diagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_REDEFINED,
+                                   SourceLocation(), name);
+        return false;
+    }
+    if (isMacroNameReserved(name))
+    {
+        mImpl->diagnostics->report(Diagnostics::PP_MACRO_NAME_RESERVED,
+                                   SourceLocation(), name);
+        return false;
+    }
+
+    Macro macro;
+    macro.type = Macro::kTypeObj;
+    macro.name = name;
+
+    Tokenizer tokenizer(mImpl->diagnostics);
+    if (tokenizer.init(1, &value, NULL))
+    {
+        Token token;
+        tokenizer.lex(&token);
+        while (token.type != Token::LAST && token.type != '\n')
+        {
+            macro.replacements.push_back(token);
+            tokenizer.lex(&token);
+        }
+    }
+
+    mImpl->macroSet.insert(macro);
+    return true;
+}
+
+void Preprocessor::recordMacroLookups(std::set<std::string>* names)
+{
+    mImpl->macroSet.recordLookups(names);
 }
 
 void Preprocessor::lex(Token* token)
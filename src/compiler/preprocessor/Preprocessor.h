@@ -8,6 +8,8 @@
 #define COMPILER_PREPROCESSOR_PREPROCESSOR_H_
 
 #include <stddef.h>
+#include <set>
+#include <string>
 
 #include "pp_utils.h"
 
@@ -16,6 +18,7 @@ namespace pp
 
 class Diagnostics;
 class DirectiveHandler;
+class MacroSnapshot;
 struct PreprocessorImpl;
 struct Token;
 
@@ -37,6 +40,21 @@ class Preprocessor
     bool init(size_t count, const char* const string[], const int length[]);
     // Adds a pre-defined macro.
     void predefineMacro(const char* name, int value);
+    // Starts from the macros of a snapshot, which must outlive the
+    // preprocessor, instead of adding the standard pre-defined macros in
+    // init(). Call before init().
+    void startFromMacros(const MacroSnapshot* macros);
+    // Returns a copy of the macros defined so far, for other preprocessors
+    // to start from. The caller owns the snapshot.
+    MacroSnapshot* snapshotMacros() const;
+    // Defines a macro as "#define name value" before the first string would,
+    // but without moving the source or its #version directive. Returns false
+    // and reports an error, as #define would, if the name is reserved or is
+    // the name of a pre-defined macro.
+    bool defineMacro(const char* name, const char* value);
+    // Adds the name of every macro looked up from now on to names, so that
+    // a later compile can tell whether other definitions change its result.
+    void recordMacroLookups(std::set<std::string>* names);
 
     void lex(Token* token);
 
@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ASTMetadataHLSL.cpp: Implements sh::ASTMetadataHLSL.
+//
+
+#include "compiler/translator/ASTMetadataHLSL.h"
+
+#include <vector>
+
+#include "compiler/translator/DetectDiscontinuity.h"
+#include "compiler/translator/NodeSearch.h"
+
+namespace sh
+{
+
+namespace
+{
+
+// Computes the flags of each node from its own operation and the flags of its children.
+// Symbols and constants have no flags and aren't recorded.
+class PropagateNodeFlags : public TIntermTraverser
+{
+  public:
+    explicit PropagateNodeFlags(ASTMetadataHLSL::NodeFlagsMap *nodeFlags)
+        : TIntermTraverser(true, false, true),
+          mNodeFlags(nodeFlags)
+    {
+    }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        unsigned int flags = node->isAssignment() ? ASTMetadataHLSL::NODE_SIDE_EFFECTS : 0;
+
+        switch (node->getOp())
+        {
+          case EOpLogicalOr:
+          case EOpLogicalAnd:
+            if (getFlags(node->getRight()) & ASTMetadataHLSL::NODE_SIDE_EFFECTS)
+            {
+                flags |= ASTMetadataHLSL::NODE_SIDE_EFFECT_REWRITING;
+            }
+            break;
+          default: break;
+        }
+
+        record(node, flags);
+        return true;
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        record(node, node->isAssignment() ? ASTMetadataHLSL::NODE_SIDE_EFFECTS : 0);
+        return true;
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        record(node, ASTMetadataHLSL::NODE_SIDE_EFFECTS);
+        return true;
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        record(node, ASTMetadataHLSL::NODE_SIDE_EFFECTS);
+        return true;
+    }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        unsigned int flags = 0;
+        if (mChildFlags.back() & ASTMetadataHLSL::NODE_JUMP)
+        {
+            flags |= ASTMetadataHLSL::NODE_LOOP_DISCONTINUITY;
+        }
+
+        record(node, flags);
+        return true;
+    }
+
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        if (visit == PreVisit)
+        {
+            mChildFlags.push_back(0);
+            return true;
+        }
+
+        unsigned int flags = 0;
+
+        switch (node->getFlowOp())
+        {
+          case EOpKill:
+            flags |= ASTMetadataHLSL::NODE_DISCARD;
+            break;
+          case EOpBreak:
+          case EOpContinue:
+          case EOpReturn:
+            flags |= ASTMetadataHLSL::NODE_JUMP;
+            break;
+          default: UNREACHABLE();
+        }
+
+        record(node, flags);
+        return true;
+    }
+
+  private:
+    unsigned int getFlags(TIntermNode *node) const
+    {
+        ASTMetadataHLSL::NodeFlagsMap::const_iterator entry = mNodeFlags->find(node);
+        return (entry != mNodeFlags->end()) ? entry->second : 0;
+    }
+
+    void record(TIntermNode *node, unsigned int flags)
+    {
+        flags |= mChildFlags.back();
+        mChildFlags.pop_back();
+
+        (*mNodeFlags)[node] = flags;
+
+        if (!mChildFlags.empty())
+        {
+            mChildFlags.back() |= flags;
+        }
+    }
+
+    ASTMetadataHLSL::NodeFlagsMap *mNodeFlags;
+    std::vector<unsigned int> mChildFlags;
+};
+
+}
+
+void ASTMetadataHLSL::analyze(TIntermNode *root)
+{
+    mNodeFlags.clear();
+
+    PropagateNodeFlags propagateNodeFlags(&mNodeFlags);
+    root->traverse(&propagateNodeFlags);
+}
+
+bool ASTMetadataHLSL::getFlags(TIntermNode *node, unsigned int *flags) const
+{
+    NodeFlagsMap::const_iterator entry = mNodeFlags.find(node);
+    if (entry == mNodeFlags.end())
+    {
+        return false;
+    }
+
+    *flags = entry->second;
+    return true;
+}
+
+bool ASTMetadataHLSL::hasSideEffects(TIntermTyped *node) const
+{
+    unsigned int flags = 0;
+    return getFlags(node, &flags) ? (flags & NODE_SIDE_EFFECTS) != 0 : node->hasSideEffects();
+}
+
+bool ASTMetadataHLSL::hasLoopDiscontinuity(TIntermNode *node) const
+{
+    unsigned int flags = 0;
+    return getFlags(node, &flags) ? (flags & NODE_LOOP_DISCONTINUITY) != 0 : containsLoopDiscontinuity(node);
+}
+
+bool ASTMetadataHLSL::hasDiscard(TIntermNode *node) const
+{
+    unsigned int flags = 0;
+    return getFlags(node, &flags) ? (flags & NODE_DISCARD) != 0 : FindDiscard::search(node);
+}
+
+bool ASTMetadataHLSL::hasSideEffectRewriting(TIntermNode *node) const
+{
+    unsigned int flags = 0;
+    return getFlags(node, &flags) ? (flags & NODE_SIDE_EFFECT_REWRITING) != 0 : FindSideEffectRewriting::search(node);
+}
+
+}
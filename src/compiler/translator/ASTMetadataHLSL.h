@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ASTMetadataHLSL.h: Defines sh::ASTMetadataHLSL, which analyzes a tree bottom-up in a
+// single traversal and remembers the properties of each node the HLSL output asks about
+// repeatedly, so that nested loops and selections don't each search their subtree again.
+//
+
+#ifndef COMPILER_ASTMETADATAHLSL_H_
+#define COMPILER_ASTMETADATAHLSL_H_
+
+#include "compiler/translator/intermediate.h"
+
+namespace sh
+{
+
+class ASTMetadataHLSL
+{
+  public:
+    // The tree must not change after it has been analyzed. Nodes which weren't part of it
+    // are searched on every query.
+    void analyze(TIntermNode *root);
+
+    // Allocated from the pool of the compilation, like the tree it describes
+    typedef TMap<const TIntermNode*, unsigned int> NodeFlagsMap;
+
+    // Same as TIntermTyped::hasSideEffects
+    bool hasSideEffects(TIntermTyped *node) const;
+
+    // Whether the node contains a break, continue or return inside a loop, which may make the
+    // loop run for a variable number of iterations. Same as containsLoopDiscontinuity.
+    bool hasLoopDiscontinuity(TIntermNode *node) const;
+
+    // Same as FindDiscard::search and FindSideEffectRewriting::search
+    bool hasDiscard(TIntermNode *node) const;
+    bool hasSideEffectRewriting(TIntermNode *node) const;
+
+    enum
+    {
+        NODE_SIDE_EFFECTS           = 0x01,
+        NODE_LOOP_DISCONTINUITY     = 0x02,
+        NODE_DISCARD                = 0x04,
+        NODE_SIDE_EFFECT_REWRITING  = 0x08,
+        NODE_JUMP                   = 0x10    // break, continue or return
+    };
+
+  private:
+    bool getFlags(TIntermNode *node, unsigned int *flags) const;
+
+    NodeFlagsMap mNodeFlags;
+};
+
+}
+
+#endif   // COMPILER_ASTMETADATAHLSL_H_
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactTree.cpp: Implements TCompactTree.
+//
+
+#include "compiler/translator/CompactTree.h"
+
+#include <cstring>
+#include <vector>
+
+//
+// Copies the nodes in the order of a left to right traversal, which is the
+// order the children of every node are stored in.
+//
+class TCompactTree::Builder : public TIntermTraverser
+{
+  public:
+    explicit Builder(TCompactTree *tree)
+        : TIntermTraverser(true, false, true),
+          mTree(tree)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        add(node, EcnSymbol, EOpNull, &node->getType());
+    }
+
+    virtual void visitConstantUnion(TIntermConstantUnion *node)
+    {
+        add(node, EcnConstantUnion, EOpNull, &node->getType());
+    }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        return visitParent(visit, node, EcnBinary, node->getOp(), &node->getType());
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        return visitParent(visit, node, EcnUnary, node->getOp(), &node->getType());
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        bool visitChildren = visitParent(visit, node, EcnAggregate, node->getOp(), &node->getType());
+        if (visit == PreVisit && !node->getName().empty())
+            mTree->mNodes.back().name = internName(node->getName());
+        return visitChildren;
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        return visitParent(visit, node, EcnSelection, EOpNull, &node->getType());
+    }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        return visitParent(visit, node, EcnLoop, node->getType(), NULL);
+    }
+
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        return visitParent(visit, node, EcnBranch, node->getFlowOp(), NULL);
+    }
+
+  private:
+    bool visitParent(Visit visit, TIntermNode *node, TCompactNodeKind kind, int op, const TType *type)
+    {
+        if (visit == PreVisit)
+        {
+            mParents.push_back(add(node, kind, op, type));
+        }
+        else
+        {
+            mTree->mNodes[mParents.back()].subtreeEnd = static_cast<unsigned int>(mTree->mNodes.size());
+            mParents.pop_back();
+        }
+
+        return true;
+    }
+
+    size_t add(TIntermNode *node, TCompactNodeKind kind, int op, const TType *type)
+    {
+        TCompactNode compactNode;
+        compactNode.node = node;
+        compactNode.type = type ? internType(*type) : kNoType;
+        compactNode.subtreeEnd = static_cast<unsigned int>(mTree->mNodes.size() + 1);
+        compactNode.name = kNoName;
+        compactNode.op = static_cast<unsigned short>(op);
+        compactNode.kind = static_cast<unsigned char>(kind);
+
+        mTree->mNodes.push_back(compactNode);
+        return mTree->mNodes.size() - 1;
+    }
+
+    unsigned int internType(const TType &type)
+    {
+        TypeKey key(type);
+        TypeIndices::iterator index = mTypeIndices.find(key);
+        if (index == mTypeIndices.end())
+        {
+            index = mTypeIndices.insert(std::make_pair(key, static_cast<unsigned int>(mTree->mTypes.size()))).first;
+            mTree->mTypes.push_back(type);
+        }
+
+        return index->second;
+    }
+
+    unsigned int internName(const TString &name)
+    {
+        NameIndices::iterator index = mNameIndices.find(name);
+        if (index == mNameIndices.end())
+        {
+            index = mNameIndices.insert(std::make_pair(name, static_cast<unsigned int>(mTree->mNames.size()))).first;
+            mTree->mNames.push_back(name);
+        }
+
+        return index->second;
+    }
+
+    // The fields which make two types different. Structures and interface
+    // blocks are shared between the types which use them, and two of them can
+    // have the same name in different scopes, so they are told apart by
+    // address.
+    struct TypeKey
+    {
+        explicit TypeKey(const TType &type)
+        {
+            TLayoutQualifier layoutQualifier = type.getLayoutQualifier();
+            fields[0] = type.getBasicType();
+            fields[1] = type.getNominalSize();
+            fields[2] = type.getSecondarySize();
+            fields[3] = type.isArray() ? type.getArraySize() : -1;
+            fields[4] = type.getQualifier();
+            fields[5] = type.getPrecision();
+            fields[6] = layoutQualifier.location;
+            fields[7] = layoutQualifier.matrixPacking;
+            fields[8] = layoutQualifier.blockStorage;
+            structure = type.getStruct();
+            interfaceBlock = type.getInterfaceBlock();
+        }
+
+        bool operator<(const TypeKey &other) const
+        {
+            int difference = memcmp(fields, other.fields, sizeof(fields));
+            if (difference != 0)
+                return difference < 0;
+            if (structure != other.structure)
+                return structure < other.structure;
+            return interfaceBlock < other.interfaceBlock;
+        }
+
+        int fields[9];
+        const TStructure *structure;
+        const TInterfaceBlock *interfaceBlock;
+    };
+    typedef TMap<TypeKey, unsigned int> TypeIndices;
+    typedef TMap<TString, unsigned int> NameIndices;
+
+    TCompactTree *mTree;
+    TVector<size_t> mParents;
+    TypeIndices mTypeIndices;
+    NameIndices mNameIndices;
+};
+
+const unsigned int TCompactTree::kNoType;
+const unsigned int TCompactTree::kNoName;
+
+TCompactTree::TCompactTree(TIntermNode *root)
+{
+    Builder builder(this);
+    root->traverse(&builder);
+}
+
+void TCompactTree::traverse(TIntermTraverser *traverser) const
+{
+    if (!mNodes.empty())
+    {
+        traverseNode(0, traverser);
+    }
+}
+
+//
+// Mirrors the traverse() functions in IntermTraverse.cpp. Binary and
+// aggregate nodes are visited in between their children, and only binary
+// nodes stop traversing their children when that visit returns false.
+//
+void TCompactTree::traverseNode(size_t index, TIntermTraverser *traverser) const
+{
+    const TCompactNode &node = mNodes[index];
+
+    switch (node.kind)
+    {
+      case EcnSymbol:
+        traverser->visitSymbol(static_cast<TIntermSymbol*>(node.node));
+        return;
+      case EcnConstantUnion:
+        traverser->visitConstantUnion(static_cast<TIntermConstantUnion*>(node.node));
+        return;
+      default:
+        break;
+    }
+
+    bool visit = true;
+    if (traverser->preVisit)
+        visit = visitNode(PreVisit, node, traverser);
+
+    if (visit)
+    {
+        bool visitInBetween = traverser->inVisit && (node.kind == EcnBinary || node.kind == EcnAggregate);
+        // Branches only go deeper to visit their expression.
+        bool deeper = node.kind != EcnBranch || node.subtreeEnd > index + 1;
+        if (deeper)
+            traverser->incrementDepth(node.node);
+
+        if (traverser->rightToLeft)
+        {
+            std::vector<size_t> children;
+            for (size_t child = index + 1; child < node.subtreeEnd; child = mNodes[child].subtreeEnd)
+                children.push_back(child);
+
+            for (size_t i = children.size(); i > 0; i--)
+            {
+                traverseNode(children[i - 1], traverser);
+                if (visit && visitInBetween && i > 1)
+                    visit = visitNode(InVisit, node, traverser);
+                if (!visit && node.kind == EcnBinary)
+                    break;
+            }
+        }
+        else
+        {
+            for (size_t child = index + 1; child < node.subtreeEnd; child = mNodes[child].subtreeEnd)
+            {
+                traverseNode(child, traverser);
+                if (visit && visitInBetween && mNodes[child].subtreeEnd < node.subtreeEnd)
+                    visit = visitNode(InVisit, node, traverser);
+                if (!visit && node.kind == EcnBinary)
+                    break;
+            }
+        }
+
+        if (deeper)
+            traverser->decrementDepth();
+    }
+
+    if (visit && traverser->postVisit)
+        visitNode(PostVisit, node, traverser);
+}
+
+bool TCompactTree::visitNode(Visit visit, const TCompactNode &node, TIntermTraverser *traverser) const
+{
+    switch (node.kind)
+    {
+      case EcnBinary:
+        return traverser->visitBinary(visit, static_cast<TIntermBinary*>(node.node));
+      case EcnUnary:
+        return traverser->visitUnary(visit, static_cast<TIntermUnary*>(node.node));
+      case EcnAggregate:
+        return traverser->visitAggregate(visit, static_cast<TIntermAggregate*>(node.node));
+      case EcnSelection:
+        return traverser->visitSelection(visit, static_cast<TIntermSelection*>(node.node));
+      case EcnLoop:
+        return traverser->visitLoop(visit, static_cast<TIntermLoop*>(node.node));
+      case EcnBranch:
+        return traverser->visitBranch(visit, static_cast<TIntermBranch*>(node.node));
+      default:
+        UNREACHABLE();
+        return false;
+    }
+}
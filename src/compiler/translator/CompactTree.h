@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactTree.h: A read-only copy of an intermediate tree for passes which
+// only look at it. The nodes are stored contiguously in pre-order and the
+// types of the typed nodes are interned, so walking the tree reads one array
+// instead of following pointers across pool pages.
+//
+
+#ifndef COMPILER_COMPACT_TREE_H_
+#define COMPILER_COMPACT_TREE_H_
+
+#include "compiler/translator/intermediate.h"
+
+enum TCompactNodeKind
+{
+    EcnSymbol,
+    EcnConstantUnion,
+    EcnBinary,
+    EcnUnary,
+    EcnAggregate,
+    EcnSelection,
+    EcnLoop,
+    EcnBranch
+};
+
+struct TCompactNode
+{
+    // The node this one was copied from.
+    TIntermNode *node;
+    // Index in the tree's type table, or TCompactTree::kNoType for the
+    // nodes which aren't typed.
+    unsigned int type;
+    // Index of the first node after this node's subtree.
+    unsigned int subtreeEnd;
+    // Index in the tree's name table of the name of an aggregate, or
+    // TCompactTree::kNoName for the other nodes and unnamed aggregates.
+    unsigned int name;
+    // TOperator for the operator nodes, TOperator of the flow for branches
+    // and TLoopType for loops.
+    unsigned short op;
+    unsigned char kind;
+};
+
+//
+// The children of a node are the nodes following it, each one starting
+// where the subtree of the previous one ends. Null children aren't stored.
+//
+class TCompactTree
+{
+  public:
+    static const unsigned int kNoType = ~0u;
+    static const unsigned int kNoName = ~0u;
+
+    explicit TCompactTree(TIntermNode *root);
+
+    size_t size() const { return mNodes.size(); }
+    const TCompactNode &getNode(size_t index) const { return mNodes[index]; }
+
+    size_t getFirstChild(size_t index) const { return index + 1; }
+    size_t getNextSibling(size_t index) const { return mNodes[index].subtreeEnd; }
+    bool hasChildren(size_t index) const { return mNodes[index].subtreeEnd > index + 1; }
+
+    bool hasType(size_t index) const { return mNodes[index].type != kNoType; }
+    const TType &getType(size_t index) const { return mTypes[mNodes[index].type]; }
+    size_t getTypeCount() const { return mTypes.size(); }
+
+    // Aggregates with the same name share its index, so passes can look
+    // functions up by index instead of comparing strings.
+    bool hasName(size_t index) const { return mNodes[index].name != kNoName; }
+    const TString &getName(size_t index) const { return mNames[mNodes[index].name]; }
+    size_t getNameCount() const { return mNames.size(); }
+
+    // Visits the nodes as traversing the original tree would, so existing
+    // traversers work on the compact tree. The traverser must not change the
+    // tree, and neither must anything else while the compact tree is used.
+    void traverse(TIntermTraverser *traverser) const;
+
+  private:
+    class Builder;
+
+    void traverseNode(size_t index, TIntermTraverser *traverser) const;
+    bool visitNode(Visit visit, const TCompactNode &node, TIntermTraverser *traverser) const;
+
+    TVector<TCompactNode> mNodes;
+    TVector<TType> mTypes;
+    TVector<TString> mNames;
+};
+
+#endif // COMPILER_COMPACT_TREE_H_
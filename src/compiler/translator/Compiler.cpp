@@ -4,16 +4,22 @@
 // found in the LICENSE file.
 //
 
+#include "compiler/preprocessor/Macro.h"
+#include "compiler/preprocessor/Token.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
 #include "compiler/translator/DetectCallDepth.h"
+#include "compiler/translator/EliminateCommonSubexpressions.h"
+#include "compiler/translator/FoldConstants.h"
 #include "compiler/translator/ForLoopUnroll.h"
 #include "compiler/translator/Initialize.h"
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/InitializeVariables.h"
 #include "compiler/translator/MapLongVariableNames.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/PruneUnusedDeclarations.h"
 #include "compiler/translator/RenameFunction.h"
 #include "compiler/translator/ShHandle.h"
+#include "compiler/translator/ShaderPermutations.h"
 #include "compiler/translator/UnfoldShortCircuitAST.h"
 #include "compiler/translator/ValidateLimitations.h"
 #include "compiler/translator/ValidateOutputs.h"
@@ -87,7 +93,9 @@ TCompiler::TCompiler(ShShaderType type, ShShaderSpec spec)
       maxCallStackDepth(0),
       fragmentPrecisionHigh(false),
       clampingStrategy(SH_CLAMP_WITH_CLAMP_INTRINSIC),
-      builtInFunctionEmulator(type)
+      builtInFunctionEmulator(type),
+      permutations(NULL),
+      predefinedMacros(NULL)
 {
     longNameMap = LongNameMap::GetInstance();
 }
@@ -96,6 +104,8 @@ TCompiler::~TCompiler()
 {
     ASSERT(longNameMap);
     longNameMap->Release();
+    delete permutations;
+    delete predefinedMacros;
 }
 
 bool TCompiler::Init(const ShBuiltInResources& resources)
@@ -125,9 +135,11 @@ bool TCompiler::Init(const ShBuiltInResources& resources)
 
 bool TCompiler::compile(const char* const shaderStrings[],
                         size_t numStrings,
-                        int compileOptions)
+                        int compileOptions,
+                        TMacroPrelude* macroPrelude)
 {
     TScopedPoolAllocator scopedAlloc(&allocator);
+    allocator.resetStatistics();
     clearResults();
 
     if (numStrings == 0)
@@ -151,6 +163,8 @@ bool TCompiler::compile(const char* const shaderStrings[],
                                shaderType, shaderSpec, compileOptions, true,
                                sourcePath, infoSink);
     parseContext.fragmentPrecisionHigh = fragmentPrecisionHigh;
+    parseContext.macroPrelude = macroPrelude;
+    parseContext.predefinedMacros = &predefinedMacros;
     SetGlobalParseContext(&parseContext);
 
     // We preserve symbols at the built-in level from compile-to-compile.
@@ -170,7 +184,19 @@ bool TCompiler::compile(const char* const shaderStrings[],
         success = intermediate.postProcess(root);
 
         if (success)
-            success = detectCallDepth(root, infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0);
+        {
+            FoldConstants foldConstants(intermediate, infoSink);
+            root->traverse(&foldConstants);
+        }
+
+        // Remember the call graph if unused declarations get pruned after the variables
+        // are collected.
+        std::set<TString> usedFunctions;
+        bool pruneUnusedDeclarations = (compileOptions & SH_PRUNE_UNUSED_DECLARATIONS) != 0;
+
+        if (success)
+            success = detectCallDepth(root, infoSink, (compileOptions & SH_LIMIT_CALL_STACK_DEPTH) != 0,
+                                      pruneUnusedDeclarations ? &usedFunctions : NULL);
 
         if (success && shaderVersion == 300 && shaderType == SH_FRAGMENT_SHADER)
             success = validateOutputs(root);
@@ -182,7 +208,12 @@ bool TCompiler::compile(const char* const shaderStrings[],
             success = enforceTimingRestrictions(root, (compileOptions & SH_DEPENDENCY_GRAPH) != 0);
 
         if (success && shaderSpec == SH_CSS_SHADERS_SPEC)
+        {
             rewriteCSSShader(root);
+            // The call graph was built before main() was renamed.
+            if (usedFunctions.erase("main(") > 0)
+                usedFunctions.insert("css_main(");
+        }
 
         // Unroll for-loop markup needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX))
@@ -234,11 +265,20 @@ bool TCompiler::compile(const char* const shaderStrings[],
                 initializeVaryingsWithoutStaticUse(root);
         }
 
+        if (success && pruneUnusedDeclarations)
+            PruneUnusedDeclarations(root, usedFunctions);
+
+        if (success && (compileOptions & SH_ELIMINATE_COMMON_SUBEXPRESSIONS))
+            EliminateCommonSubexpressions(root);
+
         if (success && (compileOptions & SH_INTERMEDIATE_TREE))
             intermediate.outputTree(root);
 
         if (success && (compileOptions & SH_OBJECT_CODE))
-            translate(root);
+        {
+            translate(root, compileOptions);
+            infoSink.obj.flush();
+        }
     }
 
     // Cleanup memory.
@@ -301,6 +341,48 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     return true;
 }
 
+TCompileResults* TCompiler::saveResults(bool success) const
+{
+    TCompileResults* results = new TCompileResults;
+    saveCompilerResults(success, results);
+    return results;
+}
+
+void TCompiler::restoreResults(const TCompileResults& results)
+{
+    clearResults();
+    allocator.resetStatistics();
+
+    infoSink.info << results.infoLog;
+    infoSink.obj << results.objectCode;
+    infoSink.obj.flush();
+
+    shaderVersion = results.shaderVersion;
+    attribs = results.attribs;
+    uniforms = results.uniforms;
+    varyings = results.varyings;
+    nameMap = results.nameMap;
+}
+
+TShaderPermutations& TCompiler::getPermutations()
+{
+    if (!permutations)
+        permutations = new TShaderPermutations(this);
+    return *permutations;
+}
+
+void TCompiler::saveCompilerResults(bool success, TCompileResults* results) const
+{
+    results->success = success;
+    results->shaderVersion = shaderVersion;
+    results->infoLog = infoSink.info.str();
+    results->objectCode = infoSink.obj.str();
+    results->attribs = attribs;
+    results->uniforms = uniforms;
+    results->varyings = varyings;
+    results->nameMap = nameMap;
+}
+
 void TCompiler::clearResults()
 {
     arrayBoundsClamper.Cleanup();
@@ -317,10 +399,13 @@ void TCompiler::clearResults()
     nameMap.clear();
 }
 
-bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth)
+bool TCompiler::detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth,
+                                std::set<TString>* usedFunctions)
 {
     DetectCallDepth detect(infoSink, limitCallStackDepth, maxCallStackDepth);
     root->traverse(&detect);
+    if (usedFunctions)
+        detect.getFunctionsCalledFromMain(usedFunctions);
     switch (detect.detectCallDepth())
     {
       case DetectCallDepth::kErrorNone:
@@ -28,6 +28,11 @@ void DetectCallDepth::FunctionNode::addCallee(
     callees.push_back(callee);
 }
 
+const TVector<DetectCallDepth::FunctionNode*>& DetectCallDepth::FunctionNode::getCallees() const
+{
+    return callees;
+}
+
 int DetectCallDepth::FunctionNode::detectCallDepth(DetectCallDepth* detectCallDepth, int depth)
 {
     ASSERT(visit == PreVisit);
@@ -173,6 +178,25 @@ DetectCallDepth::ErrorCode DetectCallDepth::detectCallDepth()
     return kErrorNone;
 }
 
+bool DetectCallDepth::getFunctionsCalledFromMain(std::set<TString>* usedFunctions)
+{
+    FunctionNode* main = findFunctionByName("main(");
+    if (main == NULL)
+        return false;
+
+    TVector<FunctionNode*> pending;
+    pending.push_back(main);
+    while (!pending.empty()) {
+        FunctionNode* func = pending.back();
+        pending.pop_back();
+        if (!usedFunctions->insert(func->getName()).second)
+            continue;
+        const TVector<FunctionNode*>& callees = func->getCallees();
+        pending.insert(pending.end(), callees.begin(), callees.end());
+    }
+    return true;
+}
+
 DetectCallDepth::FunctionNode* DetectCallDepth::findFunctionByName(
     const TString& name)
 {
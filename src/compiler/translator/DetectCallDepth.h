@@ -10,6 +10,7 @@
 #include "GLSLANG/ShaderLang.h"
 
 #include <limits.h>
+#include <set>
 #include "compiler/translator/intermediate.h"
 #include "compiler/translator/VariableInfo.h"
 
@@ -34,6 +35,10 @@ public:
 
     ErrorCode detectCallDepth();
 
+    // Adds the mangled names of main() and of the functions it calls, directly or not,
+    // to usedFunctions. Returns false if main() isn't defined.
+    bool getFunctionsCalledFromMain(std::set<TString>* usedFunctions);
+
 private:
     class FunctionNode {
     public:
@@ -46,6 +51,8 @@ private:
         // If a function is already in the callee list, this becomes a no-op.
         void addCallee(FunctionNode* callee);
 
+        const TVector<FunctionNode*>& getCallees() const;
+
         // Returns kInifinityCallDepth if recursive function calls are detected.
         int detectCallDepth(DetectCallDepth* detectCallDepth, int depth);
 
@@ -0,0 +1,525 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EliminateCommonSubexpressions.cpp: Implements EliminateCommonSubexpressions.
+//
+
+#include "compiler/translator/EliminateCommonSubexpressions.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace
+{
+
+bool IsPure(TIntermNode *node)
+{
+    if (node->getAsSymbolNode() || node->getAsConstantUnion())
+    {
+        return true;
+    }
+
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary)
+    {
+        return !binary->isAssignment() && IsPure(binary->getLeft()) && IsPure(binary->getRight());
+    }
+
+    TIntermUnary *unary = node->getAsUnaryNode();
+    if (unary)
+    {
+        return !unary->isAssignment() && IsPure(unary->getOperand());
+    }
+
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate)
+    {
+        if (aggregate->getOp() == EOpFunctionCall && aggregate->isUserDefined())
+        {
+            return false;
+        }
+
+        TIntermSequence &sequence = aggregate->getSequence();
+        for (size_t i = 0; i < sequence.size(); i++)
+        {
+            if (!IsPure(sequence[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TIntermSelection *selection = node->getAsSelectionNode();
+    if (selection)
+    {
+        return selection->usesTernaryOperator() && IsPure(selection->getCondition()) &&
+               IsPure(selection->getTrueBlock()) && IsPure(selection->getFalseBlock());
+    }
+
+    return false;
+}
+
+// Whether an expression is worth keeping in a temporary, and can be declared as one
+bool IsCandidate(TIntermTyped *node)
+{
+    const TType &type = node->getType();
+    if (type.isArray() || type.getStruct() || IsSampler(type.getBasicType()) || type.getBasicType() == EbtVoid)
+    {
+        return false;
+    }
+
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary)
+    {
+        switch (binary->getOp())
+        {
+          case EOpIndexDirect:
+          case EOpIndexIndirect:
+          case EOpIndexDirectStruct:
+          case EOpIndexDirectInterfaceBlock:
+          case EOpVectorSwizzle:
+          case EOpComma:
+            return false;
+          default:
+            return true;
+        }
+    }
+
+    return node->getAsUnaryNode() || node->getAsAggregate() || node->getAsSelectionNode();
+}
+
+// The precision to declare a temporary holding the expression with. Results whose
+// precision isn't defined take the precision of the sampler for texture lookups, and the
+// highest precision of their operands otherwise. Returns EbpUndefined if none of the
+// operands has one either.
+TPrecision GetTemporaryPrecision(TIntermTyped *node)
+{
+    if (node->getPrecision() != EbpUndefined)
+    {
+        return node->getPrecision();
+    }
+
+    TIntermSequence operands;
+    if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        operands.push_back(binary->getLeft());
+        operands.push_back(binary->getRight());
+    }
+    else if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        operands.push_back(unary->getOperand());
+    }
+    else if (TIntermAggregate *aggregate = node->getAsAggregate())
+    {
+        operands = aggregate->getSequence();
+    }
+    else if (TIntermSelection *selection = node->getAsSelectionNode())
+    {
+        operands.push_back(selection->getTrueBlock());
+        operands.push_back(selection->getFalseBlock());
+    }
+
+    TPrecision precision = EbpUndefined;
+    for (size_t i = 0; i < operands.size(); i++)
+    {
+        TIntermTyped *operand = operands[i] ? operands[i]->getAsTyped() : NULL;
+        if (!operand)
+        {
+            continue;
+        }
+
+        if (IsSampler(operand->getBasicType()))
+        {
+            return operand->getPrecision();
+        }
+
+        precision = std::max(precision, GetTemporaryPrecision(operand));
+    }
+
+    return precision;
+}
+
+TIntermSymbol *GetBaseSymbol(TIntermTyped *lvalue)
+{
+    while (lvalue->getAsBinaryNode())
+    {
+        lvalue = lvalue->getAsBinaryNode()->getLeft();
+    }
+
+    return lvalue->getAsSymbolNode();
+}
+
+// Numbers the expressions of a block so that equal expressions which see the same values
+// of the variables they read get the same number.
+class BlockEliminator
+{
+  public:
+    explicit BlockEliminator(int *temporaryIndex)
+        : mTemporaryIndex(temporaryIndex),
+          mNextNumber(0),
+          mNextVersion(1),
+          mBaseVersion(0)
+    {
+    }
+
+    void eliminate(TIntermAggregate *block);
+
+  private:
+    struct Occurrence
+    {
+        TIntermTyped *node;
+        TIntermNode *parent;
+        size_t statement;
+    };
+
+    // Finds the outermost expressions numbered more than once
+    class SelectOccurrences : public TIntermTraverser
+    {
+      public:
+        SelectOccurrences(BlockEliminator *eliminator, size_t statement)
+            : mEliminator(eliminator),
+              mStatement(statement)
+        {
+        }
+
+        virtual bool visitBinary(Visit, TIntermBinary *node) { return visitExpression(node); }
+        virtual bool visitUnary(Visit, TIntermUnary *node) { return visitExpression(node); }
+        virtual bool visitAggregate(Visit, TIntermAggregate *node) { return visitExpression(node); }
+        virtual bool visitSelection(Visit, TIntermSelection *node) { return visitExpression(node); }
+
+      private:
+        bool visitExpression(TIntermTyped *node);
+
+        BlockEliminator *mEliminator;
+        size_t mStatement;
+    };
+
+    bool numberStatement(TIntermNode *statement);
+    int number(TIntermTyped *node, bool conditional);
+    int numberSignature(const TString &signature);
+    int getVersion(int id) const;
+    void write(TIntermSymbol *symbol);
+    void invalidate();
+
+    int *mTemporaryIndex;
+
+    std::map<TString, int> mSignatures;
+    std::map<TIntermTyped*, int> mNumbers;
+    std::map<int, int> mCounts;
+    std::map<int, std::vector<Occurrence> > mOccurrences;
+    int mNextNumber;
+
+    // Variables take a new version when written, and all of them when a statement may
+    // write variables it doesn't name.
+    std::map<int, int> mVersions;
+    int mNextVersion;
+    int mBaseVersion;
+
+    // Variables declared by the current statement, which can't be read by a temporary
+    // declared before it
+    std::map<int, bool> mDeclaring;
+};
+
+bool BlockEliminator::SelectOccurrences::visitExpression(TIntermTyped *node)
+{
+    std::map<TIntermTyped*, int>::const_iterator number = mEliminator->mNumbers.find(node);
+    if (number == mEliminator->mNumbers.end() || mEliminator->mCounts[number->second] < 2 || !getParentNode())
+    {
+        return true;
+    }
+
+    Occurrence occurrence = { node, getParentNode(), mStatement };
+    mEliminator->mOccurrences[number->second].push_back(occurrence);
+    return false;
+}
+
+void BlockEliminator::eliminate(TIntermAggregate *block)
+{
+    TIntermSequence &statements = block->getSequence();
+    std::vector<bool> numbered(statements.size());
+
+    for (size_t i = 0; i < statements.size(); i++)
+    {
+        numbered[i] = numberStatement(statements[i]);
+        if (!numbered[i])
+        {
+            invalidate();
+        }
+    }
+
+    for (size_t i = 0; i < statements.size(); i++)
+    {
+        if (numbered[i])
+        {
+            SelectOccurrences selectOccurrences(this, i);
+            statements[i]->traverse(&selectOccurrences);
+        }
+    }
+
+    // Declare a temporary before the first statement using each expression
+    std::vector<TIntermSequence> declarations(statements.size());
+
+    for (std::map<int, std::vector<Occurrence> >::iterator entry = mOccurrences.begin(); entry != mOccurrences.end(); entry++)
+    {
+        const std::vector<Occurrence> &occurrences = entry->second;
+        if (occurrences.size() < 2)
+        {
+            continue;
+        }
+
+        TType type = occurrences[0].node->getType();
+        type.setQualifier(EvqTemporary);
+
+        // ESSL output needs a precision for every float and integer temporary
+        TBasicType basicType = type.getBasicType();
+        if (type.getPrecision() == EbpUndefined && (basicType == EbtFloat || basicType == EbtInt || basicType == EbtUInt))
+        {
+            type.setPrecision(GetTemporaryPrecision(occurrences[0].node));
+            if (type.getPrecision() == EbpUndefined)
+            {
+                continue;
+            }
+        }
+
+        TStringStream name;
+        name << "webgl_cse" << (*mTemporaryIndex)++;
+
+        TIntermBinary *initialization = new TIntermBinary(EOpInitialize);
+        initialization->setLeft(new TIntermSymbol(0, name.str(), type));
+        initialization->setRight(occurrences[0].node);
+        initialization->setType(type);
+        initialization->setLine(occurrences[0].node->getLine());
+
+        TIntermAggregate *declaration = new TIntermAggregate(EOpDeclaration);
+        declaration->getSequence().push_back(initialization);
+        declaration->setType(type);
+        declaration->setLine(occurrences[0].node->getLine());
+        declarations[occurrences[0].statement].push_back(declaration);
+
+        for (size_t i = 0; i < occurrences.size(); i++)
+        {
+            TIntermSymbol *temporary = new TIntermSymbol(0, name.str(), type);
+            temporary->setLine(occurrences[i].node->getLine());
+            bool replaced = occurrences[i].parent->replaceChildNode(occurrences[i].node, temporary);
+            ASSERT(replaced);
+        }
+    }
+
+    TIntermSequence eliminated;
+    for (size_t i = 0; i < statements.size(); i++)
+    {
+        eliminated.insert(eliminated.end(), declarations[i].begin(), declarations[i].end());
+        eliminated.push_back(statements[i]);
+    }
+    statements.swap(eliminated);
+}
+
+// Returns false if the statement can't be numbered, because it does more than evaluating
+// expressions without side effects and assigning or declaring a variable.
+bool BlockEliminator::numberStatement(TIntermNode *statement)
+{
+    mDeclaring.clear();
+
+    TIntermBinary *binary = statement->getAsBinaryNode();
+    if (binary && binary->isAssignment())
+    {
+        TIntermSymbol *symbol = GetBaseSymbol(binary->getLeft());
+        if (!symbol || !IsPure(binary->getLeft()) || !IsPure(binary->getRight()))
+        {
+            return false;
+        }
+
+        number(binary->getRight(), false);
+        write(symbol);
+        return true;
+    }
+
+    TIntermAggregate *aggregate = statement->getAsAggregate();
+    if (aggregate && aggregate->getOp() == EOpDeclaration)
+    {
+        TIntermSequence &declarators = aggregate->getSequence();
+        for (size_t i = 0; i < declarators.size(); i++)
+        {
+            TIntermBinary *initialization = declarators[i]->getAsBinaryNode();
+            if (initialization && !IsPure(initialization->getRight()))
+            {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < declarators.size(); i++)
+        {
+            TIntermBinary *initialization = declarators[i]->getAsBinaryNode();
+            TIntermSymbol *symbol = initialization ? initialization->getLeft()->getAsSymbolNode() : declarators[i]->getAsSymbolNode();
+
+            if (initialization)
+            {
+                number(initialization->getRight(), false);
+            }
+            if (symbol)
+            {
+                write(symbol);
+                mDeclaring[symbol->getId()] = true;
+            }
+        }
+        return true;
+    }
+
+    TIntermBranch *branch = statement->getAsBranchNode();
+    if (branch && branch->getExpression() && IsPure(branch->getExpression()))
+    {
+        number(branch->getExpression(), false);
+        return true;
+    }
+
+    TIntermTyped *expression = statement->getAsTyped();
+    if (expression && IsPure(expression))
+    {
+        number(expression, false);
+        return true;
+    }
+
+    return false;
+}
+
+int BlockEliminator::number(TIntermTyped *node, bool conditional)
+{
+    TType type = node->getType();
+    TStringStream signature;
+    signature << type.getMangledName() << "/" << type.getPrecision() << "/";
+
+    if (TIntermSymbol *symbol = node->getAsSymbolNode())
+    {
+        if (symbol->getId() == 0 || mDeclaring.count(symbol->getId()) > 0)
+        {
+            return mNextNumber++;
+        }
+        signature << "s" << symbol->getId() << "@" << getVersion(symbol->getId());
+    }
+    else if (TIntermConstantUnion *constant = node->getAsConstantUnion())
+    {
+        signature.precision(9);
+        signature << "c";
+        for (size_t i = 0; i < type.getObjectSize(); i++)
+        {
+            const ConstantUnion &value = constant->getUnionArrayPointer()[i];
+            switch (value.getType())
+            {
+              case EbtFloat: signature << "," << value.getFConst(); break;
+              case EbtInt:   signature << "," << value.getIConst(); break;
+              case EbtUInt:  signature << "," << value.getUConst(); break;
+              case EbtBool:  signature << "," << value.getBConst(); break;
+              default:       return mNextNumber++;
+            }
+        }
+    }
+    else if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        bool conditionalRight = conditional || binary->getOp() == EOpLogicalAnd || binary->getOp() == EOpLogicalOr;
+        signature << "b" << binary->getOp() << "(" << number(binary->getLeft(), conditional)
+                  << "," << number(binary->getRight(), conditionalRight) << ")";
+    }
+    else if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        signature << "u" << unary->getOp() << "(" << number(unary->getOperand(), conditional) << ")";
+    }
+    else if (TIntermAggregate *aggregate = node->getAsAggregate())
+    {
+        signature << "a" << aggregate->getOp() << aggregate->getName() << "(";
+        TIntermSequence &sequence = aggregate->getSequence();
+        for (size_t i = 0; i < sequence.size(); i++)
+        {
+            signature << number(sequence[i]->getAsTyped(), conditional) << ",";
+        }
+        signature << ")";
+    }
+    else if (TIntermSelection *selection = node->getAsSelectionNode())
+    {
+        // Only one of the branches is evaluated
+        signature << "t(" << number(selection->getCondition()->getAsTyped(), conditional)
+                  << "," << number(selection->getTrueBlock()->getAsTyped(), true)
+                  << "," << number(selection->getFalseBlock()->getAsTyped(), true) << ")";
+    }
+    else
+    {
+        return mNextNumber++;
+    }
+
+    int value = numberSignature(signature.str());
+
+    // Expressions which are only evaluated conditionally could be undefined otherwise, like
+    // an array indexed out of its bounds
+    if (!conditional && IsCandidate(node))
+    {
+        mNumbers[node] = value;
+        mCounts[value]++;
+    }
+
+    return value;
+}
+
+int BlockEliminator::numberSignature(const TString &signature)
+{
+    std::map<TString, int>::const_iterator entry = mSignatures.find(signature);
+    if (entry != mSignatures.end())
+    {
+        return entry->second;
+    }
+
+    int value = mNextNumber++;
+    mSignatures[signature] = value;
+    return value;
+}
+
+int BlockEliminator::getVersion(int id) const
+{
+    std::map<int, int>::const_iterator version = mVersions.find(id);
+    return (version != mVersions.end()) ? version->second : mBaseVersion;
+}
+
+void BlockEliminator::write(TIntermSymbol *symbol)
+{
+    mVersions[symbol->getId()] = mNextVersion++;
+}
+
+void BlockEliminator::invalidate()
+{
+    mVersions.clear();
+    mBaseVersion = mNextVersion++;
+}
+
+class FindBlocks : public TIntermTraverser
+{
+  public:
+    FindBlocks()
+        : mTemporaryIndex(0)
+    {
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        // Statements at global scope only declare variables and functions
+        if (node->getOp() == EOpSequence && getParentNode())
+        {
+            BlockEliminator eliminator(&mTemporaryIndex);
+            eliminator.eliminate(node);
+        }
+
+        return true;
+    }
+
+  private:
+    int mTemporaryIndex;
+};
+
+}
+
+void EliminateCommonSubexpressions(TIntermNode *root)
+{
+    FindBlocks findBlocks;
+    root->traverse(&findBlocks);
+}
@@ -0,0 +1,21 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EliminateCommonSubexpressions.h: Computes the expressions which a block of statements
+// evaluates more than once into temporaries, so that drivers with weak optimizers don't
+// repeat texture lookups or arithmetic.
+//
+
+#ifndef COMPILER_ELIMINATE_COMMON_SUBEXPRESSIONS_H_
+#define COMPILER_ELIMINATE_COMMON_SUBEXPRESSIONS_H_
+
+#include "compiler/translator/intermediate.h"
+
+// Only expressions without side effects are shared, between statements of the same block
+// which don't write the variables they read in the meantime. Expressions are only equal if
+// their precisions are too, and the temporaries keep them.
+void EliminateCommonSubexpressions(TIntermNode *root);
+
+#endif // COMPILER_ELIMINATE_COMMON_SUBEXPRESSIONS_H_
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FoldConstants.cpp: Implements FoldConstants.
+//
+
+#include "compiler/translator/FoldConstants.h"
+
+FoldConstants::FoldConstants(TIntermediate &intermediate, TInfoSink &infoSink)
+    : TIntermTraverser(false, false, true),
+      mIntermediate(intermediate),
+      mInfoSink(infoSink),
+      mFoldedRoot(NULL)
+{
+}
+
+bool FoldConstants::visitUnary(Visit visit, TIntermUnary *node)
+{
+    TIntermConstantUnion *operand = node->getOperand()->getAsConstantUnion();
+    if (operand)
+    {
+        replace(node, operand->fold(node->getOp(), NULL, mInfoSink));
+    }
+
+    return true;
+}
+
+bool FoldConstants::visitBinary(Visit visit, TIntermBinary *node)
+{
+    TIntermConstantUnion *left = node->getLeft()->getAsConstantUnion();
+    TIntermConstantUnion *right = node->getRight()->getAsConstantUnion();
+    if (!left || !right)
+    {
+        return true;
+    }
+
+    switch (node->getOp())
+    {
+      case EOpAdd:
+      case EOpSub:
+      case EOpMul:
+      case EOpDiv:
+      case EOpVectorTimesScalar:
+      case EOpMatrixTimesScalar:
+      case EOpMatrixTimesMatrix:
+      case EOpMatrixTimesVector:
+      case EOpVectorTimesMatrix:
+      case EOpLogicalAnd:
+      case EOpLogicalOr:
+      case EOpLogicalXor:
+      case EOpLessThan:
+      case EOpGreaterThan:
+      case EOpLessThanEqual:
+      case EOpGreaterThanEqual:
+      case EOpEqual:
+      case EOpNotEqual:
+        replace(node, left->fold(node->getOp(), right, mInfoSink));
+        break;
+      default:
+        break;
+    }
+
+    return true;
+}
+
+bool FoldConstants::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    if (!node->isConstructor())
+    {
+        replace(node, TIntermConstantUnion::foldAggregateBuiltIn(node));
+        return true;
+    }
+
+    TIntermSequence &sequence = node->getSequence();
+    for (size_t i = 0; i < sequence.size(); i++)
+    {
+        if (!sequence[i]->getAsConstantUnion())
+        {
+            return true;
+        }
+    }
+
+    const TType &type = node->getType();
+    ConstantUnion *unionArray = new ConstantUnion[type.getObjectSize()];
+    if (!mIntermediate.parseConstTree(node->getLine(), node, unionArray, node->getOp(), type, sequence.size() == 1))
+    {
+        replace(node, mIntermediate.addConstantUnion(unionArray, type, node->getLine()));
+    }
+
+    return true;
+}
+
+void FoldConstants::replace(TIntermTyped *node, TIntermTyped *folded)
+{
+    if (!folded)
+    {
+        return;
+    }
+
+    // Keep the precision and type the operation was given
+    TType type = node->getType();
+    type.setQualifier(EvqConst);
+    TIntermConstantUnion *constant = new TIntermConstantUnion(folded->getAsConstantUnion()->getUnionArrayPointer(), type);
+    constant->setLine(node->getLine());
+
+    TIntermNode *parent = getParentNode();
+    if (parent)
+    {
+        bool replaced = parent->replaceChildNode(node, constant);
+        ASSERT(replaced);
+    }
+    else
+    {
+        mFoldedRoot = constant;
+    }
+}
+
+TIntermTyped *FoldConstants::foldExpression(TIntermTyped *expression, TIntermediate &intermediate, TInfoSink &infoSink)
+{
+    FoldConstants foldConstants(intermediate, infoSink);
+    expression->traverse(&foldConstants);
+
+    TIntermTyped *folded = foldConstants.mFoldedRoot ? foldConstants.mFoldedRoot : expression;
+    if (folded->getAsConstantUnion())
+    {
+        // The parser gives calls to built-in functions the qualifier of their return type,
+        // even when it folds them
+        folded->getTypePointer()->setQualifier(EvqConst);
+    }
+
+    return folded;
+}
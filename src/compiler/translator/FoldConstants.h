@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FoldConstants.h: The parser folds operators on constants as it builds the tree, but not
+// calls to built-in functions taking several arguments, since their type is only known
+// afterwards. FoldConstants folds those, and the operators and constructors whose operands
+// become constant as a result.
+//
+
+#ifndef COMPILER_FOLD_CONSTANTS_H_
+#define COMPILER_FOLD_CONSTANTS_H_
+
+#include "compiler/translator/localintermediate.h"
+
+class FoldConstants : public TIntermTraverser
+{
+  public:
+    FoldConstants(TIntermediate &intermediate, TInfoSink &infoSink);
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node);
+    virtual bool visitBinary(Visit visit, TIntermBinary *node);
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node);
+
+    // Folds an expression which isn't part of a tree, like the initializer of a const
+    // variable. Returns the expression, or the constant it folds to.
+    static TIntermTyped *foldExpression(TIntermTyped *expression, TIntermediate &intermediate, TInfoSink &infoSink);
+
+  private:
+    void replace(TIntermTyped *node, TIntermTyped *folded);
+
+    TIntermediate &mIntermediate;
+    TInfoSink &mInfoSink;
+    TIntermTyped *mFoldedRoot;
+};
+
+#endif // COMPILER_FOLD_CONSTANTS_H_
@@ -6,40 +6,137 @@
 
 #include "compiler/translator/InfoSink.h"
 
+namespace {
+
+// Small outputs such as most info logs and shaders stay in a single chunk,
+// which can be handed out without joining anything.
+const size_t kChunkSize = 64 * 1024;
+
+}
+
+TInfoSinkBase::TInfoSinkBase()
+    : chunks(1),
+      callback(NULL),
+      callbackUserData(NULL)
+{
+}
+
+void TInfoSinkBase::append(const char* data, size_t length) {
+    while (length > 0) {
+        if (chunks.back().size() >= kChunkSize)
+            startChunk();
+
+        TPersistString& chunk = chunks.back();
+        size_t count = std::min(length, kChunkSize - chunk.size());
+        chunk.append(data, count);
+
+        data += count;
+        length -= count;
+    }
+}
+
+void TInfoSinkBase::startChunk() {
+    if (callback) {
+        // Hand the full chunk over and reuse its storage
+        flush();
+    } else {
+        chunks.push_back(TPersistString());
+        chunks.back().reserve(kChunkSize);
+    }
+}
+
+void TInfoSinkBase::erase() {
+    chunks.resize(1);
+    chunks.front().clear();
+}
+
+int TInfoSinkBase::size() const {
+    size_t total = 0;
+    for (std::deque<TPersistString>::const_iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk)
+        total += chunk->size();
+    return static_cast<int>(total);
+}
+
+const TPersistString& TInfoSinkBase::str() const {
+    if (chunks.size() > 1) {
+        TPersistString joined;
+        joined.reserve(size());
+        for (std::deque<TPersistString>::const_iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk)
+            joined.append(*chunk);
+
+        chunks.front().swap(joined);
+        chunks.erase(chunks.begin() + 1, chunks.end());
+    }
+    return chunks.front();
+}
+
+void TInfoSinkBase::splice(TInfoSinkBase* other) {
+    if (callback) {
+        flush();
+        for (std::deque<TPersistString>::const_iterator chunk = other->chunks.begin(); chunk != other->chunks.end(); ++chunk) {
+            if (!chunk->empty())
+                callback(chunk->c_str(), chunk->size(), callbackUserData);
+        }
+    } else {
+        for (std::deque<TPersistString>::iterator chunk = other->chunks.begin(); chunk != other->chunks.end(); ++chunk) {
+            if (chunk->empty())
+                continue;
+            if (!chunks.back().empty())
+                chunks.push_back(TPersistString());
+            chunks.back().swap(*chunk);
+        }
+    }
+    other->erase();
+}
+
+void TInfoSinkBase::setCallback(TSinkCallback newCallback, void* userData) {
+    flush();
+    callback = newCallback;
+    callbackUserData = userData;
+}
+
+void TInfoSinkBase::flush() {
+    if (callback) {
+        for (std::deque<TPersistString>::const_iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk) {
+            if (!chunk->empty())
+                callback(chunk->c_str(), chunk->size(), callbackUserData);
+        }
+        erase();
+    }
+}
+
 void TInfoSinkBase::prefix(TPrefixType p) {
     switch(p) {
         case EPrefixNone:
             break;
         case EPrefixWarning:
-            sink.append("WARNING: ");
+            *this << "WARNING: ";
             break;
         case EPrefixError:
-            sink.append("ERROR: ");
+            *this << "ERROR: ";
             break;
         case EPrefixInternalError:
-            sink.append("INTERNAL ERROR: ");
+            *this << "INTERNAL ERROR: ";
             break;
         case EPrefixUnimplemented:
-            sink.append("UNIMPLEMENTED: ");
+            *this << "UNIMPLEMENTED: ";
             break;
         case EPrefixNote:
-            sink.append("NOTE: ");
+            *this << "NOTE: ";
             break;
         default:
-            sink.append("UNKOWN ERROR: ");
+            *this << "UNKOWN ERROR: ";
             break;
     }
 }
 
 void TInfoSinkBase::location(int file, int line) {
-    TPersistStringStream stream;
+    *this << file;
     if (line)
-        stream << file << ":" << line;
+        *this << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        *this << ":? ";
+    *this << ": ";
 }
 
 void TInfoSinkBase::location(const TSourceLoc& loc) {
@@ -49,6 +146,5 @@ void TInfoSinkBase::location(const TSourceLoc& loc) {
 void TInfoSinkBase::message(TPrefixType p, const TSourceLoc& loc, const char* m) {
     prefix(p);
     location(loc);
-    sink.append(m);
-    sink.append("\n");
+    *this << m << "\n";
 }
@@ -7,6 +7,8 @@
 #ifndef _INFOSINK_INCLUDED_
 #define _INFOSINK_INCLUDED_
 
+#include <algorithm>
+#include <deque>
 #include <math.h>
 #include <stdlib.h>
 #include "compiler/translator/Common.h"
@@ -30,39 +32,57 @@ enum TPrefixType {
     EPrefixNote
 };
 
+// Receives the output of a streaming sink, one chunk at a time.
+typedef void (*TSinkCallback)(const char* data, size_t length, void* userData);
+
 //
 // Encapsulate info logs for all objects that have them.
 //
 // The methods are a general set of tools for getting a variety of
 // messages and types inserted into the log.
 //
+// The text is kept in a list of bounded chunks, so a growing sink never
+// reallocates and copies what it already holds. When a callback is set, full
+// chunks are handed to it instead of being retained.
+//
 class TInfoSinkBase {
 public:
-    TInfoSinkBase() {}
+    TInfoSinkBase();
 
     template <typename T>
     TInfoSinkBase& operator<<(const T& t) {
         TPersistStringStream stream;
         stream << t;
-        sink.append(stream.str());
+        const TPersistString& str = stream.str();
+        append(str.c_str(), str.length());
         return *this;
     }
     // Override << operator for specific types. It is faster to append strings
     // and characters directly to the sink.
     TInfoSinkBase& operator<<(char c) {
-        sink.append(1, c);
+        append(&c, 1);
         return *this;
     }
     TInfoSinkBase& operator<<(const char* str) {
-        sink.append(str);
+        append(str, strlen(str));
         return *this;
     }
     TInfoSinkBase& operator<<(const TPersistString& str) {
-        sink.append(str);
+        append(str.c_str(), str.length());
         return *this;
     }
     TInfoSinkBase& operator<<(const TString& str) {
-        sink.append(str.c_str());
+        append(str.c_str(), str.length());
+        return *this;
+    }
+    // Numbers are formatted straight into the sink, without a temporary
+    // string stream per value.
+    TInfoSinkBase& operator<<(int i) {
+        appendFormatted("%d", i);
+        return *this;
+    }
+    TInfoSinkBase& operator<<(unsigned int i) {
+        appendFormatted("%u", i);
         return *this;
     }
     // Make sure floats are written with correct precision.
@@ -71,31 +91,37 @@ public:
         // does not have a fractional part, the default precision format does
         // not write the decimal portion which gets interpreted as integer by
         // the compiler.
-        TPersistStringStream stream;
         if (fractionalPart(f) == 0.0f) {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
+            appendFormatted("%.1f", f);
         } else {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
+            appendFormatted("%.8g", f);
         }
-        sink.append(stream.str());
         return *this;
     }
     // Write boolean values as their names instead of integral value.
     TInfoSinkBase& operator<<(bool b) {
         const char* str = b ? "true" : "false";
-        sink.append(str);
+        append(str, strlen(str));
         return *this;
     }
 
-    void erase() { sink.clear(); }
-    int size() { return static_cast<int>(sink.size()); }
+    void erase();
+    int size() const;
 
-    const TPersistString& str() const { return sink; }
-    const char* c_str() const { return sink.c_str(); }
+    // Joins the chunks into one string the first time they are accessed
+    // as a whole.
+    const TPersistString& str() const;
+    const char* c_str() const { return str().c_str(); }
+
+    // Moves the contents of another sink to the end of this one, without
+    // copying the text.
+    void splice(TInfoSinkBase* other);
+
+    // Streams everything appended from now on to the callback, retaining at
+    // most one chunk. flush() hands over the incomplete last chunk.
+    void setCallback(TSinkCallback callback, void* userData);
+    bool hasCallback() const { return callback != NULL; }
+    void flush();
 
     void prefix(TPrefixType p);
     void location(int file, int line);
@@ -103,7 +129,23 @@ public:
     void message(TPrefixType p, const TSourceLoc& loc, const char* m);
 
 private:
-    TPersistString sink;
+    void append(const char* data, size_t length);
+    void startChunk();
+
+    template <typename T>
+    void appendFormatted(const char* format, T value) {
+        // Large enough for any int or for "%.1f" of the largest float
+        char buffer[64];
+        int length = snprintf(buffer, sizeof(buffer), format, value);
+        if (length > 0)
+            append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+    }
+
+    // Never empty; text is only ever appended to the last chunk.
+    mutable std::deque<TPersistString> chunks;
+
+    TSinkCallback callback;
+    void* callbackUserData;
 };
 
 class TInfoSink {
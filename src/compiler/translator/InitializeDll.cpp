@@ -8,6 +8,7 @@
 
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/InitializeParseContext.h"
+#include "compiler/translator/Types.h"
 #include "compiler/translator/osinclude.h"
 
 bool InitProcess()
@@ -17,6 +18,8 @@ bool InitProcess()
         return false;
     }
 
+    TType::InitializeDescriptors();
+
     if (!InitializeParseContextIndex()) {
         assert(0 && "InitProcess(): Failed to initalize parse context");
         return false;
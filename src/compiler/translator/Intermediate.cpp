@@ -10,6 +10,7 @@
 
 #include <float.h>
 #include <limits.h>
+#include <math.h>
 #include <algorithm>
 
 #include "compiler/translator/HashNames.h"
@@ -1241,6 +1242,238 @@ bool CompareStructure(const TType& leftNodeType, ConstantUnion* rightUnionArray,
     return true;
 }
 
+//
+// Built-in functions are only folded where the GLSL ES specification defines their result.
+// Constants are evaluated in single precision, which is at least the precision of any
+// qualifier, and results which aren't finite are left for the driver to compute.
+//
+
+static bool IsFinite(float f)
+{
+    return fabsf(f) <= FLT_MAX;
+}
+
+static bool FoldUnaryBuiltIn(TOperator op, float x, float *result)
+{
+    const float pi = 3.14159265358979323846f;
+
+    switch (op)
+    {
+      case EOpRadians:     *result = x * (pi / 180.0f); break;
+      case EOpDegrees:     *result = x * (180.0f / pi); break;
+      case EOpSin:         *result = sinf(x); break;
+      case EOpCos:         *result = cosf(x); break;
+      case EOpTan:         *result = tanf(x); break;
+      case EOpAtan:        *result = atanf(x); break;
+      case EOpExp:         *result = expf(x); break;
+      case EOpExp2:        *result = powf(2.0f, x); break;
+      case EOpAbs:         *result = fabsf(x); break;
+      case EOpSign:        *result = (x > 0.0f) ? 1.0f : ((x < 0.0f) ? -1.0f : 0.0f); break;
+      case EOpFloor:       *result = floorf(x); break;
+      case EOpCeil:        *result = ceilf(x); break;
+      case EOpFract:       *result = x - floorf(x); break;
+
+      case EOpAsin:
+      case EOpAcos:
+        if (fabsf(x) > 1.0f)
+            return false;
+        *result = (op == EOpAsin) ? asinf(x) : acosf(x);
+        break;
+
+      case EOpLog:
+      case EOpLog2:
+        if (x <= 0.0f)
+            return false;
+        *result = (op == EOpLog) ? logf(x) : logf(x) / logf(2.0f);
+        break;
+
+      case EOpSqrt:
+        if (x < 0.0f)
+            return false;
+        *result = sqrtf(x);
+        break;
+
+      case EOpInverseSqrt:
+        if (x <= 0.0f)
+            return false;
+        *result = 1.0f / sqrtf(x);
+        break;
+
+      default:
+        return false;
+    }
+
+    return IsFinite(*result);
+}
+
+static bool FoldComponentWiseBuiltIn(TOperator op, float x, float y, float a, float *result)
+{
+    switch (op)
+    {
+      case EOpAtan:
+        if (x == 0.0f && y == 0.0f)
+            return false;
+        *result = atan2f(x, y);
+        break;
+
+      case EOpPow:
+        if (x < 0.0f || (x == 0.0f && y <= 0.0f))
+            return false;
+        *result = powf(x, y);
+        break;
+
+      case EOpMod:
+        if (y == 0.0f)
+            return false;
+        *result = x - y * floorf(x / y);
+        break;
+
+      case EOpMix:
+        *result = x * (1.0f - a) + y * a;
+        break;
+
+      case EOpStep:
+        *result = (y < x) ? 0.0f : 1.0f;
+        break;
+
+      case EOpSmoothStep:
+        if (x >= y)
+            return false;
+        {
+            float t = std::min(std::max((a - x) / (y - x), 0.0f), 1.0f);
+            *result = t * t * (3.0f - 2.0f * t);
+        }
+        break;
+
+      case EOpMul:   // matrixCompMult
+        *result = x * y;
+        break;
+
+      default:
+        return false;
+    }
+
+    return IsFinite(*result);
+}
+
+static float Dot(const ConstantUnion *x, const ConstantUnion *y, size_t size)
+{
+    float dot = 0.0f;
+    for (size_t i = 0; i < size; i++)
+        dot += x[i].getFConst() * y[i].getFConst();
+    return dot;
+}
+
+// Returns the component of an argument which may be a scalar used with vectors.
+static const ConstantUnion &GetComponent(TIntermConstantUnion *argument, size_t component)
+{
+    return argument->getUnionArrayPointer()[argument->getType().getObjectSize() == 1 ? 0 : component];
+}
+
+static bool FoldVectorBuiltIn(TOperator op, TIntermConstantUnion **arguments, size_t argumentCount, ConstantUnion *result)
+{
+    const ConstantUnion *x = arguments[0]->getUnionArrayPointer();
+    const ConstantUnion *y = argumentCount > 1 ? arguments[1]->getUnionArrayPointer() : NULL;
+    const ConstantUnion *z = argumentCount > 2 ? arguments[2]->getUnionArrayPointer() : NULL;
+    size_t size = arguments[0]->getType().getObjectSize();
+
+    switch (op)
+    {
+      case EOpLength:
+        result[0].setFConst(sqrtf(Dot(x, x, size)));
+        return IsFinite(result[0].getFConst());
+
+      case EOpNormalize:
+        {
+            float length = sqrtf(Dot(x, x, size));
+            if (length == 0.0f || !IsFinite(length))
+                return false;
+            for (size_t i = 0; i < size; i++)
+                result[i].setFConst(x[i].getFConst() / length);
+        }
+        return true;
+
+      case EOpAny:
+      case EOpAll:
+        {
+            bool any = false;
+            bool all = true;
+            for (size_t i = 0; i < size; i++)
+            {
+                any = any || x[i].getBConst();
+                all = all && x[i].getBConst();
+            }
+            result[0].setBConst(op == EOpAny ? any : all);
+        }
+        return true;
+
+      case EOpDot:
+        result[0].setFConst(Dot(x, y, size));
+        return IsFinite(result[0].getFConst());
+
+      case EOpDistance:
+        {
+            float distance = 0.0f;
+            for (size_t i = 0; i < size; i++)
+            {
+                float difference = x[i].getFConst() - y[i].getFConst();
+                distance += difference * difference;
+            }
+            result[0].setFConst(sqrtf(distance));
+        }
+        return IsFinite(result[0].getFConst());
+
+      case EOpCross:
+        result[0].setFConst(x[1].getFConst() * y[2].getFConst() - y[1].getFConst() * x[2].getFConst());
+        result[1].setFConst(x[2].getFConst() * y[0].getFConst() - y[2].getFConst() * x[0].getFConst());
+        result[2].setFConst(x[0].getFConst() * y[1].getFConst() - y[0].getFConst() * x[1].getFConst());
+        break;
+
+      case EOpFaceForward:
+        {
+            // faceforward(N, I, Nref)
+            float sign = (Dot(z, y, size) < 0.0f) ? 1.0f : -1.0f;
+            for (size_t i = 0; i < size; i++)
+                result[i].setFConst(sign * x[i].getFConst());
+        }
+        break;
+
+      case EOpReflect:
+        {
+            // reflect(I, N)
+            float dot = Dot(y, x, size);
+            for (size_t i = 0; i < size; i++)
+                result[i].setFConst(x[i].getFConst() - 2.0f * dot * y[i].getFConst());
+        }
+        break;
+
+      case EOpRefract:
+        {
+            // refract(I, N, eta)
+            float eta = z[0].getFConst();
+            float dot = Dot(y, x, size);
+            float k = 1.0f - eta * eta * (1.0f - dot * dot);
+            for (size_t i = 0; i < size; i++)
+            {
+                float refracted = (k < 0.0f) ? 0.0f : eta * x[i].getFConst() - (eta * dot + sqrtf(k)) * y[i].getFConst();
+                result[i].setFConst(refracted);
+            }
+        }
+        break;
+
+      default:
+        return false;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!IsFinite(result[i].getFConst()))
+            return false;
+    }
+
+    return true;
+}
+
 //
 // The fold functions see if an operation on a constant can be done in place,
 // without generating run-time code.
@@ -1609,6 +1842,33 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, TIntermTyped* constantNod
         // Do unary operations
         //
         TIntermConstantUnion *newNode = 0;
+
+        switch (op)
+        {
+          case EOpLength:
+          case EOpNormalize:
+          case EOpAny:
+          case EOpAll:
+            {
+                TIntermConstantUnion *operand = this;
+                TType returnType = getType();
+                if (op != EOpNormalize)
+                {
+                    returnType = TType(op == EOpLength ? EbtFloat : EbtBool, getType().getPrecision(), EvqConst);
+                }
+
+                ConstantUnion *tempConstArray = new ConstantUnion[returnType.getObjectSize()];
+                if (!FoldVectorBuiltIn(op, &operand, 1, tempConstArray))
+                    return 0;
+
+                newNode = new TIntermConstantUnion(tempConstArray, returnType);
+                newNode->setLine(getLine());
+                return newNode;
+            }
+          default:
+            break;
+        }
+
         ConstantUnion* tempConstArray = new ConstantUnion[objectSize];
         for (size_t i = 0; i < objectSize; i++)
         {
@@ -1627,6 +1887,7 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, TIntermTyped* constantNod
                 break;
 
               case EOpLogicalNot: // this code is written for possible future use, will not get executed currently
+              case EOpVectorLogicalNot:
                 switch (getType().getBasicType())
                 {
                   case EbtBool:  tempConstArray[i].setBConst(!unionArray[i].getBConst()); break;
@@ -1637,7 +1898,13 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, TIntermTyped* constantNod
                 break;
 
               default:
-                return 0;
+                {
+                    float result = 0.0f;
+                    if (getType().getBasicType() != EbtFloat || !FoldUnaryBuiltIn(op, unionArray[i].getFConst(), &result))
+                        return 0;
+                    tempConstArray[i].setFConst(result);
+                }
+                break;
             }
         }
         newNode = new TIntermConstantUnion(tempConstArray, getType());
@@ -1646,6 +1913,122 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, TIntermTyped* constantNod
     }
 }
 
+//
+// Folds a call to a built-in function taking several arguments, if they are all constant.
+//
+// Returns the constant result, or 0 if the call can't be folded.
+//
+TIntermTyped* TIntermConstantUnion::foldAggregateBuiltIn(TIntermAggregate* aggregate)
+{
+    TIntermSequence &sequence = aggregate->getSequence();
+    TIntermConstantUnion *arguments[3] = { 0, 0, 0 };
+
+    if (sequence.size() < 2 || sequence.size() > 3)
+        return 0;
+
+    for (size_t i = 0; i < sequence.size(); i++)
+    {
+        arguments[i] = sequence[i]->getAsConstantUnion();
+        if (!arguments[i] || arguments[i]->getUnionArrayPointer() == 0)
+            return 0;
+    }
+
+    TType returnType = aggregate->getType();
+    returnType.setQualifier(EvqConst);
+    size_t objectSize = returnType.getObjectSize();
+    ConstantUnion *tempConstArray = new ConstantUnion[objectSize];
+    TOperator op = aggregate->getOp();
+
+    switch (op)
+    {
+      case EOpVectorEqual:
+      case EOpVectorNotEqual:
+      case EOpLessThan:
+      case EOpGreaterThan:
+      case EOpLessThanEqual:
+      case EOpGreaterThanEqual:
+        for (size_t i = 0; i < objectSize; i++)
+        {
+            const ConstantUnion &x = arguments[0]->getUnionArrayPointer()[i];
+            const ConstantUnion &y = arguments[1]->getUnionArrayPointer()[i];
+            bool result = false;
+            switch (op)
+            {
+              case EOpVectorEqual:       result = (x == y); break;
+              case EOpVectorNotEqual:    result = (x != y); break;
+              case EOpLessThan:          result = (x < y);  break;
+              case EOpGreaterThan:       result = (x > y);  break;
+              case EOpLessThanEqual:     result = !(x > y); break;
+              case EOpGreaterThanEqual:  result = !(x < y); break;
+              default: UNREACHABLE();
+            }
+            tempConstArray[i].setBConst(result);
+        }
+        break;
+
+      case EOpMin:
+      case EOpMax:
+      case EOpClamp:
+        for (size_t i = 0; i < objectSize; i++)
+        {
+            ConstantUnion value = GetComponent(arguments[0], i);
+            const ConstantUnion &y = GetComponent(arguments[1], i);
+
+            if (op == EOpClamp)
+            {
+                const ConstantUnion &z = GetComponent(arguments[2], i);
+                if (y > z)
+                    return 0;
+                value = (value < y) ? y : ((value > z) ? z : value);
+            }
+            else if (op == EOpMin ? y < value : y > value)
+            {
+                value = y;
+            }
+            tempConstArray[i] = value;
+        }
+        break;
+
+      case EOpDot:
+      case EOpDistance:
+      case EOpCross:
+      case EOpFaceForward:
+      case EOpReflect:
+      case EOpRefract:
+        if (!FoldVectorBuiltIn(op, arguments, sequence.size(), tempConstArray))
+            return 0;
+        break;
+
+      case EOpAtan:
+      case EOpPow:
+      case EOpMod:
+      case EOpMix:
+      case EOpStep:
+      case EOpSmoothStep:
+      case EOpMul:
+        if (returnType.getBasicType() != EbtFloat)
+            return 0;
+        for (size_t i = 0; i < objectSize; i++)
+        {
+            float x = GetComponent(arguments[0], i).getFConst();
+            float y = GetComponent(arguments[1], i).getFConst();
+            float a = arguments[2] ? GetComponent(arguments[2], i).getFConst() : 0.0f;
+            float result = 0.0f;
+            if (!FoldComponentWiseBuiltIn(op, x, y, a, &result))
+                return 0;
+            tempConstArray[i].setFConst(result);
+        }
+        break;
+
+      default:
+        return 0;
+    }
+
+    TIntermConstantUnion *newNode = new TIntermConstantUnion(tempConstArray, returnType);
+    newNode->setLine(aggregate->getLine());
+    return newNode;
+}
+
 TIntermTyped* TIntermediate::promoteConstantUnion(TBasicType promoteTo, TIntermConstantUnion* node)
 {
     size_t size = node->getType().getObjectSize();
@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput.cpp: Implements ShortNames and MinifyWhitespace.
+//
+
+#include "compiler/translator/MinifyOutput.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "common/angleutils.h"
+#include "compiler/translator/SymbolTable.h"
+
+namespace
+{
+
+const char kFirstCharacters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char kCharacters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+// Keywords, reserved words and built-in functions short enough to be generated. Generated
+// names never contain underscores, so they can't start with "gl_" or "webgl_".
+const char *const kReservedNames[] =
+{
+    "asm", "bool", "case", "cast", "char", "do", "else", "enum", "flat", "for", "goto",
+    "half", "if", "in", "int", "long", "lowp", "main", "mat2", "mat3", "mat4", "out",
+    "true", "uint", "vec2", "vec3", "vec4", "void",
+
+    "abs", "acos", "all", "any", "asin", "atan", "ceil", "cos", "cosh", "dFdx", "dFdy",
+    "dot", "exp", "exp2", "log", "log2", "max", "min", "mix", "mod", "modf", "not", "pow",
+    "sign", "sin", "sinh", "sqrt", "step", "tan", "tanh",
+};
+
+class ReserveNames : public TIntermTraverser
+{
+  public:
+    ReserveNames(std::set<TString> *names, std::set<TString> *keptNames)
+        : mNames(names),
+          mKeptNames(keptNames)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        if (!ShortNames::IsRenamed(node->getQualifier()))
+        {
+            mNames->insert(node->getSymbol());
+            keepStructure(node->getType().getStruct());
+        }
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        if (node->getOp() == EOpFunctionCall && !node->isUserDefined())
+        {
+            mNames->insert(TFunction::unmangleName(node->getName()));
+        }
+
+        return true;
+    }
+
+  private:
+    // Keeps the names of the structure and of the structures of its fields.
+    void keepStructure(const TStructure *structure)
+    {
+        if (structure == NULL || !mKeptNames->insert(structure->name()).second)
+        {
+            return;
+        }
+
+        mNames->insert(structure->name());
+        const TFieldList &fields = structure->fields();
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+            keepStructure(fields[i]->type()->getStruct());
+        }
+    }
+
+    std::set<TString> *mNames;
+    std::set<TString> *mKeptNames;
+};
+
+bool IsIdentifierCharacter(char c)
+{
+    return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+}
+
+// Whether two characters separated by whitespace would read as another token without it
+bool NeedsSpace(char previous, char next)
+{
+    if (IsIdentifierCharacter(previous) && IsIdentifierCharacter(next))
+    {
+        return true;
+    }
+
+    return (previous == next && strchr("+-&|^<>=/", previous) != NULL) || (previous == '/' && next == '*');
+}
+
+}
+
+ShortNames::ShortNames()
+    : mNextName(0)
+{
+    mReservedNames.insert(kReservedNames, kReservedNames + ArraySize(kReservedNames));
+}
+
+void ShortNames::reserveNames(TIntermNode *root)
+{
+    ReserveNames reserveNames(&mReservedNames, &mKeptNames);
+    root->traverse(&reserveNames);
+}
+
+bool ShortNames::IsRenamed(TQualifier qualifier)
+{
+    switch (qualifier)
+    {
+      case EvqTemporary:
+      case EvqGlobal:
+      case EvqConst:
+      case EvqIn:
+      case EvqOut:
+      case EvqInOut:
+      case EvqConstReadOnly:
+        return true;
+      default:
+        return false;
+    }
+}
+
+const TString &ShortNames::get(const TString &name)
+{
+    std::map<TString, TString>::iterator shortName = mNames.find(name);
+    if (shortName == mNames.end())
+    {
+        shortName = mNames.insert(std::make_pair(name, generateName())).first;
+    }
+
+    return shortName->second;
+}
+
+TString ShortNames::generateName()
+{
+    const size_t firstCount = ArraySize(kFirstCharacters) - 1;
+    const size_t count = ArraySize(kCharacters) - 1;
+
+    TString name;
+    do
+    {
+        unsigned int index = mNextName++;
+        name = kFirstCharacters[index % firstCount];
+        index /= firstCount;
+
+        while (index > 0)
+        {
+            index--;
+            name += kCharacters[index % count];
+            index /= count;
+        }
+    }
+    while (mReservedNames.count(name) > 0);
+
+    return name;
+}
+
+TPersistString MinifyWhitespace(const TPersistString &source)
+{
+    TPersistString minified;
+    minified.reserve(source.size());
+
+    bool lineStart = true;
+    bool skipped = false;
+
+    size_t i = 0;
+    while (i < source.size())
+    {
+        char c = source[i];
+
+        if (c == '\n')
+        {
+            lineStart = true;
+            skipped = true;
+            i++;
+        }
+        else if (isspace(static_cast<unsigned char>(c)))
+        {
+            skipped = true;
+            i++;
+        }
+        else if (c == '/' && i + 1 < source.size() && source[i + 1] == '/')
+        {
+            skipped = true;
+            i = source.find('\n', i);
+            if (i == TPersistString::npos)
+            {
+                break;
+            }
+        }
+        else if (c == '#' && lineStart)
+        {
+            if (!minified.empty() && minified[minified.size() - 1] != '\n')
+            {
+                minified += '\n';
+            }
+
+            size_t end = source.find('\n', i);
+            if (end == TPersistString::npos)
+            {
+                end = source.size();
+            }
+            minified.append(source, i, end - i);
+            minified += '\n';
+
+            skipped = false;
+            i = end;
+        }
+        else
+        {
+            if (skipped && !minified.empty() && NeedsSpace(minified[minified.size() - 1], c))
+            {
+                minified += ' ';
+            }
+            minified += c;
+
+            lineStart = false;
+            skipped = false;
+            i++;
+        }
+    }
+
+    return minified;
+}
@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput.h: Makes the GLSL and ESSL output as small as possible, for
+// SH_MINIFY_OUTPUT.
+//
+
+#ifndef COMPILER_MINIFY_OUTPUT_H_
+#define COMPILER_MINIFY_OUTPUT_H_
+
+#include <map>
+#include <set>
+
+#include "compiler/translator/intermediate.h"
+
+// Gives the identifiers which aren't part of a shader's interface the
+// shortest names which no other identifier of the shader, keyword or
+// built-in function uses. The same identifier always gets the same name, so
+// that scoping and overloading work as before. Structures which type an
+// interface variable keep their names, since the stages of a program must
+// agree on them.
+class ShortNames
+{
+  public:
+    ShortNames();
+
+    // Reserves the names of the tree's interface variables and built-ins,
+    // and of the structures the interface variables use.
+    void reserveNames(TIntermNode *root);
+
+    // Whether the name is the name of a structure which keeps it.
+    bool isKept(const TString &name) const { return mKeptNames.count(name) > 0; }
+
+    // Variables with other qualifiers are written with their own names, or
+    // their hashed names.
+    static bool IsRenamed(TQualifier qualifier);
+
+    const TString &get(const TString &name);
+
+  private:
+    TString generateName();
+
+    std::set<TString> mReservedNames;
+    std::set<TString> mKeptNames;
+    std::map<TString, TString> mNames;
+    unsigned int mNextName;
+};
+
+// Removes the comments and the whitespace which doesn't separate tokens.
+// Preprocessor directives are kept on lines of their own.
+TPersistString MinifyWhitespace(const TPersistString &source);
+
+#endif // COMPILER_MINIFY_OUTPUT_H_
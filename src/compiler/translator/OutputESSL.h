@@ -16,6 +16,7 @@ public:
                 ShArrayIndexClampingStrategy clampingStrategy,
                 ShHashFunction64 hashFunction,
                 NameMap& nameMap,
+                ShortNames* shortNames,
                 TSymbolTable& symbolTable,
                 int shaderVersion);
 
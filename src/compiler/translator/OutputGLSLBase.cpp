@@ -43,6 +43,7 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase& objSink,
                                  ShArrayIndexClampingStrategy clampingStrategy,
                                  ShHashFunction64 hashFunction,
                                  NameMap& nameMap,
+                                 ShortNames* shortNames,
                                  TSymbolTable& symbolTable,
                                  int shaderVersion)
     : TIntermTraverser(true, true, true),
@@ -51,6 +52,7 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase& objSink,
       mClampingStrategy(clampingStrategy),
       mHashFunction(hashFunction),
       mNameMap(nameMap),
+      mShortNames(shortNames),
       mSymbolTable(symbolTable),
       mShaderVersion(shaderVersion)
 {
@@ -107,7 +109,7 @@ void TOutputGLSLBase::writeFunctionParameters(const TIntermSequence& args)
 
         const TString& name = arg->getSymbol();
         if (!name.empty())
-            out << " " << hashName(name);
+            out << " " << hashInternalName(name);
         if (type.isArray())
             out << arrayBrackets(type);
 
@@ -125,7 +127,7 @@ const ConstantUnion* TOutputGLSLBase::writeConstantUnion(const TType& type,
     if (type.getBasicType() == EbtStruct)
     {
         const TStructure* structure = type.getStruct();
-        out << hashName(structure->name()) << "(";
+        out << hashInternalName(structure->name()) << "(";
 
         const TFieldList& fields = structure->fields();
         for (size_t i = 0; i < fields.size(); ++i)
@@ -164,7 +166,7 @@ void TOutputGLSLBase::visitSymbol(TIntermSymbol* node)
     if (mLoopUnroll.NeedsToReplaceSymbolWithValue(node))
         out << mLoopUnroll.GetLoopIndexValue(node);
     else
-        out << hashVariableName(node->getSymbol());
+        out << hashVariableName(node->getSymbol(), node->getQualifier());
 
     if (mDeclaringVariables && node->getType().isArray())
         out << arrayBrackets(node->getType());
@@ -485,7 +487,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate* node)
             // Function declaration.
             ASSERT(visit == PreVisit);
             writeVariableType(node->getType());
-            out << " " << hashName(node->getName());
+            out << " " << hashInternalName(node->getName());
 
             out << "(";
             writeFunctionParameters(node->getSequence());
@@ -589,7 +591,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate* node)
             {
                 const TType& type = node->getType();
                 ASSERT(type.getBasicType() == EbtStruct);
-                out << hashName(type.getStruct()->name()) << "(";
+                out << hashInternalName(type.getStruct()->name()) << "(";
             }
             else if (visit == InVisit)
             {
@@ -758,7 +760,7 @@ TString TOutputGLSLBase::getTypeName(const TType& type)
     else
     {
         if (type.getBasicType() == EbtStruct)
-            out << hashName(type.getStruct()->name());
+            out << hashInternalName(type.getStruct()->name());
         else
             out << type.getBasicString();
     }
@@ -777,10 +779,21 @@ TString TOutputGLSLBase::hashName(const TString& name)
     return hashedName;
 }
 
-TString TOutputGLSLBase::hashVariableName(const TString& name)
+TString TOutputGLSLBase::hashInternalName(const TString& name)
+{
+    // Built-in structures, like the type of gl_DepthRange, keep their names,
+    // and so do the structures of interface variables.
+    if (mShortNames == NULL || name.empty() || name.compare(0, 3, "gl_") == 0 || mShortNames->isKept(name))
+        return hashName(name);
+    return mShortNames->get(name);
+}
+
+TString TOutputGLSLBase::hashVariableName(const TString& name, TQualifier qualifier)
 {
     if (mSymbolTable.findBuiltIn(name, mShaderVersion) != NULL)
         return name;
+    if (ShortNames::IsRenamed(qualifier))
+        return hashInternalName(name);
     return hashName(name);
 }
 
@@ -789,7 +802,7 @@ TString TOutputGLSLBase::hashFunctionName(const TString& mangled_name)
     TString name = TFunction::unmangleName(mangled_name);
     if (mSymbolTable.findBuiltIn(mangled_name, mShaderVersion) != NULL || name == "main")
         return name;
-    return hashName(name);
+    return hashInternalName(name);
 }
 
 bool TOutputGLSLBase::structDeclared(const TStructure* structure) const
@@ -801,7 +814,7 @@ void TOutputGLSLBase::declareStruct(const TStructure* structure)
 {
     TInfoSinkBase& out = objSink();
 
-    out << "struct " << hashName(structure->name()) << "{\n";
+    out << "struct " << hashInternalName(structure->name()) << "{\n";
     const TFieldList& fields = structure->fields();
     for (size_t i = 0; i < fields.size(); ++i)
     {
@@ -10,6 +10,7 @@
 #include <set>
 
 #include "compiler/translator/ForLoopUnroll.h"
+#include "compiler/translator/MinifyOutput.h"
 #include "compiler/translator/intermediate.h"
 #include "compiler/translator/ParseContext.h"
 
@@ -20,6 +21,7 @@ public:
                     ShArrayIndexClampingStrategy clampingStrategy,
                     ShHashFunction64 hashFunction,
                     NameMap& nameMap,
+                    ShortNames* shortNames,
                     TSymbolTable& symbolTable,
                     int shaderVersion);
 
@@ -47,9 +49,13 @@ protected:
     // Return the original name if hash function pointer is NULL;
     // otherwise return the hashed name.
     TString hashName(const TString& name);
-    // Same as hashName(), but without hashing built-in variables.
-    TString hashVariableName(const TString& name);
-    // Same as hashName(), but without hashing built-in functions.
+    // Same as hashName(), but identifiers which aren't part of the interface
+    // get short names if the output is minified.
+    TString hashInternalName(const TString& name);
+    // Same as hashInternalName() for variables with the given qualifier, but
+    // without hashing built-in variables.
+    TString hashVariableName(const TString& name, TQualifier qualifier);
+    // Same as hashInternalName(), but without hashing built-in functions.
     TString hashFunctionName(const TString& mangled_name);
 
 private:
@@ -74,6 +80,9 @@ private:
 
     NameMap& mNameMap;
 
+    // NULL unless the output is minified.
+    ShortNames* mShortNames;
+
     TSymbolTable& mSymbolTable;
 
     const int mShaderVersion;
@@ -10,12 +10,10 @@
 #include "common/utilities.h"
 #include "compiler/translator/compilerdebug.h"
 #include "compiler/translator/InfoSink.h"
-#include "compiler/translator/DetectDiscontinuity.h"
 #include "compiler/translator/SearchSymbol.h"
 #include "compiler/translator/UnfoldShortCircuit.h"
 #include "compiler/translator/HLSLLayoutEncoder.h"
 #include "compiler/translator/FlagStd140Structs.h"
-#include "compiler/translator/NodeSearch.h"
 #include "compiler/translator/RewriteElseBlocks.h"
 
 #include <algorithm>
@@ -160,7 +158,6 @@ OutputHLSL::~OutputHLSL()
 
 void OutputHLSL::output()
 {
-    mContainsLoopDiscontinuity = mContext.shaderType == SH_FRAGMENT_SHADER && containsLoopDiscontinuity(mContext.treeRoot);
     const std::vector<TIntermTyped*> &flaggedStructs = FlagStd140ValueStructs(mContext.treeRoot);
     makeFlaggedStructMaps(flaggedStructs);
 
@@ -171,11 +168,14 @@ void OutputHLSL::output()
         RewriteElseBlocks(mContext.treeRoot);
     }
 
+    mMetadata.analyze(mContext.treeRoot);
+    mContainsLoopDiscontinuity = mContext.shaderType == SH_FRAGMENT_SHADER && mMetadata.hasLoopDiscontinuity(mContext.treeRoot);
+
     mContext.treeRoot->traverse(this);   // Output the body first to determine what has to go in the header
     header();
 
-    mContext.infoSink().obj << mHeader.c_str();
-    mContext.infoSink().obj << mBody.c_str();
+    mContext.infoSink().obj.splice(&mHeader);
+    mContext.infoSink().obj.splice(&mBody);
 }
 
 void OutputHLSL::makeFlaggedStructMaps(const std::vector<TIntermTyped *> &flaggedStructs)
@@ -205,6 +205,11 @@ TInfoSinkBase &OutputHLSL::getBodyStream()
     return mBody;
 }
 
+const ASTMetadataHLSL &OutputHLSL::getMetadata() const
+{
+    return mMetadata;
+}
+
 const std::vector<Uniform> &OutputHLSL::getUniforms()
 {
     return mActiveUniforms;
@@ -1927,7 +1932,7 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
       case EOpMatrixTimesVector: outputTriplet(visit, "mul(transpose(", "), ", ")"); break;
       case EOpMatrixTimesMatrix: outputTriplet(visit, "transpose(mul(transpose(", "), transpose(", ")))"); break;
       case EOpLogicalOr:
-        if (node->getRight()->hasSideEffects())
+        if (mMetadata.hasSideEffects(node->getRight()))
         {
             out << "s" << mUnfoldShortCircuit->getNextTemporaryIndex();
             return false;
@@ -1942,7 +1947,7 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
         outputTriplet(visit, "xor(", ", ", ")");
         break;
       case EOpLogicalAnd:
-        if (node->getRight()->hasSideEffects())
+        if (mMetadata.hasSideEffects(node->getRight()))
         {
             out << "s" << mUnfoldShortCircuit->getNextTemporaryIndex();
             return false;
@@ -2574,7 +2579,7 @@ bool OutputHLSL::visitSelection(Visit visit, TIntermSelection *node)
             traverseStatements(node->getTrueBlock());
 
             // Detect true discard
-            discard = (discard || FindDiscard::search(node->getTrueBlock()));
+            discard = (discard || mMetadata.hasDiscard(node->getTrueBlock()));
         }
 
         outputLineDirective(node->getLine().first_line);
@@ -2594,11 +2599,11 @@ bool OutputHLSL::visitSelection(Visit visit, TIntermSelection *node)
             out << ";\n}\n";
 
             // Detect false discard
-            discard = (discard || FindDiscard::search(node->getFalseBlock()));
+            discard = (discard || mMetadata.hasDiscard(node->getFalseBlock()));
         }
 
         // ANGLE issue 486: Detect problematic conditional discard
-        if (discard && FindSideEffectRewriting::search(node))
+        if (discard && mMetadata.hasSideEffectRewriting(node))
         {
             mUsesDiscardRewriting = true;
         }
@@ -2618,7 +2623,7 @@ bool OutputHLSL::visitLoop(Visit visit, TIntermLoop *node)
 
     if (mContainsLoopDiscontinuity && !mInsideDiscontinuousLoop)
     {
-        mInsideDiscontinuousLoop = containsLoopDiscontinuity(node);
+        mInsideDiscontinuousLoop = mMetadata.hasLoopDiscontinuity(node);
     }
 
     if (mOutputType == SH_HLSL9_OUTPUT)
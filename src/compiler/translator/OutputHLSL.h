@@ -15,6 +15,7 @@
 #include <GLES3/gl3.h>
 #include <GLES2/gl2.h>
 
+#include "compiler/translator/ASTMetadataHLSL.h"
 #include "compiler/translator/intermediate.h"
 #include "compiler/translator/ParseContext.h"
 #include "compiler/translator/ShaderVariable.h"
@@ -32,6 +33,7 @@ class OutputHLSL : public TIntermTraverser
     void output();
 
     TInfoSinkBase &getBodyStream();
+    const ASTMetadataHLSL &getMetadata() const;
     const std::vector<Uniform> &getUniforms();
     const ActiveInterfaceBlocks &getInterfaceBlocks() const;
     const std::vector<Attribute> &getOutputVariables() const;
@@ -165,6 +167,8 @@ class OutputHLSL : public TIntermTraverser
 
     int mUniqueIndex;   // For creating unique names
 
+    ASTMetadataHLSL mMetadata;
+
     bool mContainsLoopDiscontinuity;
     bool mOutputLod0Function;
     bool mInsideDiscontinuousLoop;
@@ -9,6 +9,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "compiler/translator/FoldConstants.h"
 #include "compiler/translator/glslang.h"
 #include "compiler/preprocessor/SourceLocation.h"
 
@@ -1012,7 +1013,7 @@ const TFunction* TParseContext::findFunction(const TSourceLoc& line, TFunction*
     // If a function is found, check for one with a matching argument list.
     const TSymbol* symbol = symbolTable.find(call->getName(), shaderVersion, builtIn);
     if (symbol == 0 || symbol->isFunction()) {
-        symbol = symbolTable.find(call->getMangledName(), shaderVersion, builtIn);
+        symbol = symbolTable.findFunction(*call, shaderVersion, builtIn);
     }
 
     if (symbol == 0) {
@@ -1069,6 +1070,9 @@ bool TParseContext::executeInitializer(const TSourceLoc& line, const TString& id
     //
 
     if (qualifier == EvqConst) {
+        // Calls to built-in functions on constant arguments are constant expressions too
+        initializer = FoldConstants::foldExpression(initializer, intermediate, infoSink());
+
         if (qualifier != initializer->getType().getQualifier()) {
             std::stringstream extraInfoStream;
             extraInfoStream << "'" << variable->getType().getCompleteString() << "'";
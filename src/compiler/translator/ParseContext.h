@@ -44,6 +44,8 @@ struct TParseContext {
             shaderVersion(100),
             directiveHandler(ext, diagnostics, shaderVersion),
             preprocessor(&diagnostics, &directiveHandler),
+            macroPrelude(NULL),
+            predefinedMacros(NULL),
             scanner(NULL) {  }
     TIntermediate& intermediate; // to hold and build a parse tree
     TSymbolTable& symbolTable;   // symbol table that goes with the language currently being parsed
@@ -65,6 +67,8 @@ struct TParseContext {
     TDiagnostics diagnostics;
     TDirectiveHandler directiveHandler;
     pp::Preprocessor preprocessor;
+    TMacroPrelude* macroPrelude;  // Macros to define before the source, or NULL.
+    pp::MacroSnapshot** predefinedMacros;  // Where the compiler keeps the macros every compile starts from, or NULL.
     void* scanner;
 
     int getShaderVersion() const { return shaderVersion; }
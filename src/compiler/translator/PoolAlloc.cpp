@@ -52,10 +52,14 @@ void SetGlobalPoolAllocator(TPoolAllocator* poolAllocator)
 TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) : 
     pageSize(growthIncrement),
     alignment(allocationAlignment),
+    currentPageOffset(0),
+    currentPageSize(0),
     freeList(0),
     inUseList(0),
-    numCalls(0),
-    totalBytes(0)
+    largeList(0),
+    freeBytes(0),
+    retainedBytesLimit(4*1024*1024),
+    inUseBytes(0)
 {
     //
     // Don't allow page sizes we know are smaller than all common
@@ -65,10 +69,10 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
         pageSize = 4*1024;
 
     //
-    // A large currentPageOffset indicates a new page needs to
-    // be obtained to allocate memory.
+    // Pages grow geometrically, up to 64 times the initial size.
     //
-    currentPageOffset = pageSize;
+    nextPageSize = pageSize;
+    maxPageSize = 64 * pageSize;
 
     //
     // Adjust alignment to be at least pointer aligned and
@@ -91,6 +95,8 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
     if (headerSkip < sizeof(tHeader)) {
         headerSkip = (sizeof(tHeader) + alignmentMask) & ~alignmentMask;
     }
+
+    resetStatistics();
 }
 
 TPoolAllocator::~TPoolAllocator()
@@ -102,6 +108,12 @@ TPoolAllocator::~TPoolAllocator()
         inUseList = next;
     }
 
+    while (largeList) {
+        tHeader* next = largeList->nextPage;
+        delete [] reinterpret_cast<char*>(largeList);
+        largeList = next;
+    }
+
     // We should not check the guard blocks
     // here, because we did it already when the block was
     // placed into the free list.
@@ -151,14 +163,15 @@ void TAllocation::checkGuardBlock(unsigned char* blockMem, unsigned char val, co
 
 void TPoolAllocator::push()
 {
-    tAllocState state = { currentPageOffset, inUseList };
+    tAllocState state = { currentPageOffset, currentPageSize, inUseList, largeList };
 
     stack.push_back(state);
         
     //
     // Indicate there is no current page to allocate from.
     //
-    currentPageOffset = pageSize;
+    currentPageOffset = 0;
+    currentPageSize = 0;
 }
 
 //
@@ -175,22 +188,31 @@ void TPoolAllocator::pop()
 
     tHeader* page = stack.back().page;
     currentPageOffset = stack.back().offset;
+    currentPageSize = stack.back().pageSize;
 
     while (inUseList != page) {
         // invoke destructor to free allocation list
         inUseList->~tHeader();
         
         tHeader* nextInUse = inUseList->nextPage;
-        if (inUseList->pageCount > 1)
-            delete [] reinterpret_cast<char*>(inUseList);
-        else {
-            inUseList->nextPage = freeList;
-            freeList = inUseList;
-        }
+        inUseBytes -= inUseList->pageSize;
+        freeBytes += inUseList->pageSize;
+        inUseList->nextPage = freeList;
+        freeList = inUseList;
         inUseList = nextInUse;
     }
 
+    tHeader* largeAllocation = stack.back().largeAllocation;
+    while (largeList != largeAllocation) {
+        tHeader* next = largeList->nextPage;
+        inUseBytes -= largeList->pageSize;
+        delete [] reinterpret_cast<char*>(largeList);
+        largeList = next;
+    }
+
     stack.pop_back();
+
+    trimFreeList();
 }
 
 //
@@ -203,84 +225,131 @@ void TPoolAllocator::popAll()
         pop();
 }
 
-void* TPoolAllocator::allocate(size_t numBytes)
+void TPoolAllocator::setRetainedBytesLimit(size_t limit)
+{
+    retainedBytesLimit = limit;
+    trimFreeList();
+}
+
+void TPoolAllocator::resetStatistics()
+{
+    statistics.allocationCount = 0;
+    statistics.allocatedBytes = 0;
+    statistics.pageCount = 0;
+    statistics.largeAllocationCount = 0;
+    statistics.peakBytes = inUseBytes;
+}
+
+void* TPoolAllocator::allocateFromNewPage(size_t numBytes, size_t allocationSize)
 {
-    //
-    // Just keep some interesting statistics.
-    //
-    ++numCalls;
-    totalBytes += numBytes;
-
-    // If we are using guard blocks, all allocations are bracketed by
-    // them: [guardblock][allocation][guardblock].  numBytes is how
-    // much memory the caller asked for.  allocationSize is the total
-    // size including guard blocks.  In release build,
-    // guardBlockSize=0 and this all gets optimized away.
-    size_t allocationSize = TAllocation::allocationSize(numBytes);
     // Detect integer overflow.
     if (allocationSize < numBytes)
         return 0;
 
+    if (allocationSize > pageSize - headerSkip)
+        return allocateLarge(allocationSize);
+
     //
-    // Do the allocation, most likely case first, for efficiency.
-    // This step could be moved to be inline sometime.
+    // Need a simple page to allocate from.
     //
-    if (allocationSize <= pageSize - currentPageOffset) {
-        //
-        // Safe to allocate from currentPageOffset.
-        //
-        unsigned char* memory = reinterpret_cast<unsigned char *>(inUseList) + currentPageOffset;
-        currentPageOffset += allocationSize;
-        currentPageOffset = (currentPageOffset + alignmentMask) & ~alignmentMask;
-
-        return initializeAllocation(inUseList, memory, numBytes);
-    }
+    tHeader* memory = obtainPage();
+    if (memory == 0)
+        return 0;
 
-    if (allocationSize > pageSize - headerSkip) {
-        //
-        // Do a multi-page allocation.  Don't mix these with the others.
-        // The OS is efficient and allocating and free-ing multiple pages.
-        //
-        size_t numBytesToAlloc = allocationSize + headerSkip;
-        // Detect integer overflow.
-        if (numBytesToAlloc < allocationSize)
-            return 0;
+    inUseList = memory;
+    currentPageSize = memory->pageSize;
+    
+    unsigned char* ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
+    currentPageOffset = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
 
-        tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
-        if (memory == 0)
-            return 0;
+    return initializeAllocation(inUseList, ret, numBytes);
+}
 
-        // Use placement-new to initialize header
-        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
-        inUseList = memory;
+void* TPoolAllocator::allocateLarge(size_t allocationSize)
+{
+    size_t numBytesToAlloc = allocationSize + headerSkip;
+    // Detect integer overflow.
+    if (numBytesToAlloc < allocationSize)
+        return 0;
 
-        currentPageOffset = pageSize;  // make next allocation come from a new page
+    tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
+    if (memory == 0)
+        return 0;
 
-        // No guard blocks for multi-page allocations (yet)
-        return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(memory) + headerSkip);
-    }
+    // Use placement-new to initialize header
+    new(memory) tHeader(largeList, numBytesToAlloc);
+    largeList = memory;
 
-    //
-    // Need a simple page to allocate from.
-    //
+    ++statistics.largeAllocationCount;
+    inUseBytes += numBytesToAlloc;
+    updatePeakBytes();
+
+    // No guard blocks for large allocations (yet)
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(memory) + headerSkip);
+}
+
+TPoolAllocator::tHeader* TPoolAllocator::obtainPage()
+{
     tHeader* memory;
+    size_t size;
     if (freeList) {
         memory = freeList;
+        size = freeList->pageSize;
         freeList = freeList->nextPage;
+        freeBytes -= size;
     } else {
-        memory = reinterpret_cast<tHeader*>(::new char[pageSize]);
+        size = nextPageSize;
+        memory = reinterpret_cast<tHeader*>(::new char[size]);
         if (memory == 0)
             return 0;
+
+        ++statistics.pageCount;
+        if (nextPageSize < maxPageSize)
+            nextPageSize *= 2;
     }
 
     // Use placement-new to initialize header
-    new(memory) tHeader(inUseList, 1);
-    inUseList = memory;
-    
-    unsigned char* ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
-    currentPageOffset = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
+    new(memory) tHeader(inUseList, size);
 
-    return initializeAllocation(inUseList, ret, numBytes);
+    inUseBytes += size;
+    updatePeakBytes();
+
+    return memory;
+}
+
+//
+// Returns the free pages which exceed the retained bytes limit to the OS.
+// The pages which were popped last are the ones kept.
+//
+void TPoolAllocator::trimFreeList()
+{
+    if (freeBytes <= retainedBytesLimit)
+        return;
+
+    size_t retainedBytes = 0;
+    tHeader** link = &freeList;
+    while (*link) {
+        tHeader* page = *link;
+        if (retainedBytes + page->pageSize <= retainedBytesLimit) {
+            retainedBytes += page->pageSize;
+            link = &page->nextPage;
+        } else {
+            *link = page->nextPage;
+            delete [] reinterpret_cast<char*>(page);
+        }
+    }
+    freeBytes = retainedBytes;
+
+    //
+    // Pages obtained from now on start growing from the initial size again.
+    //
+    nextPageSize = pageSize;
+}
+
+void TPoolAllocator::updatePeakBytes()
+{
+    if (inUseBytes > statistics.peakBytes)
+        statistics.peakBytes = inUseBytes;
 }
 
 
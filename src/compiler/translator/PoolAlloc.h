@@ -105,9 +105,15 @@ private:
 // repositories of free pages or used pages.
 //
 // Page stacks are linked together with a simple header at the beginning
-// of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// of each allocation obtained from the underlying OS.  Each page obtained
+// from the OS is twice as large as the previous one, up to a limit, so that
+// large shaders don't need tens of thousands of pages.  Pages are kept for
+// future re-use when they are popped, as long as the free pages don't add
+// up to more than the retained bytes limit.
+//
+// Allocations which don't fit in a page of the initial size are large
+// allocations.  They get memory of their own, which is returned to the OS
+// when they are popped, and don't end the page being allocated from.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of 
@@ -143,7 +149,34 @@ public:
     // Call allocate() to actually acquire memory.  Returns 0 if no memory
     // available, otherwise a properly aligned pointer to 'numBytes' of memory.
     //
-    void* allocate(size_t numBytes);
+    void* allocate(size_t numBytes) {
+        ++statistics.allocationCount;
+        statistics.allocatedBytes += numBytes;
+
+        // If we are using guard blocks, all allocations are bracketed by
+        // them: [guardblock][allocation][guardblock].  numBytes is how
+        // much memory the caller asked for.  allocationSize is the total
+        // size including guard blocks.  In release build,
+        // guardBlockSize=0 and this all gets optimized away.
+        size_t allocationSize = TAllocation::allocationSize(numBytes);
+
+        //
+        // Do the allocation, most likely case first, for efficiency.
+        // The integer overflow check is left to allocateFromNewPage().
+        //
+        if (allocationSize >= numBytes && allocationSize <= currentPageSize - currentPageOffset) {
+            //
+            // Safe to allocate from currentPageOffset.
+            //
+            unsigned char* memory = reinterpret_cast<unsigned char *>(inUseList) + currentPageOffset;
+            currentPageOffset += allocationSize;
+            currentPageOffset = (currentPageOffset + alignmentMask) & ~alignmentMask;
+
+            return initializeAllocation(inUseList, memory, numBytes);
+        }
+
+        return allocateFromNewPage(numBytes, allocationSize);
+    }
 
     //
     // There is no deallocate.  The point of this class is that
@@ -152,13 +185,34 @@ public:
     // by calling pop(), and to not have to solve memory leak problems.
     //
 
+    //
+    // Pages freed by pop() beyond this many bytes are returned to the OS.
+    //
+    void setRetainedBytesLimit(size_t limit);
+
+    struct Statistics {
+        size_t allocationCount;
+        size_t allocatedBytes;        // bytes requested by allocate()
+        size_t pageCount;             // pages obtained from the OS
+        size_t largeAllocationCount;  // allocations which didn't fit in a page
+        size_t peakBytes;             // most memory held at once in pages
+                                      //      and large allocations
+    };
+
+    //
+    // Statistics are kept from the creation of the allocator, or from
+    // the last call to resetStatistics().
+    //
+    void resetStatistics();
+    const Statistics& getStatistics() const { return statistics; }
+
 protected:
     friend struct tHeader;
     
     struct tHeader {
-        tHeader(tHeader* nextPage, size_t pageCount) :
+        tHeader(tHeader* nextPage, size_t pageSize) :
             nextPage(nextPage),
-            pageCount(pageCount)
+            pageSize(pageSize)
 #ifdef GUARD_BLOCKS
           , lastAllocation(0)
 #endif
@@ -172,7 +226,7 @@ protected:
         }
 
         tHeader* nextPage;
-        size_t pageCount;
+        size_t pageSize;    // bytes obtained from the OS, header included
 #ifdef GUARD_BLOCKS
         TAllocation* lastAllocation;
 #endif
@@ -180,7 +234,9 @@ protected:
 
     struct tAllocState {
         size_t offset;
+        size_t pageSize;
         tHeader* page;
+        tHeader* largeAllocation;
     };
     typedef std::vector<tAllocState> tAllocStack;
 
@@ -194,7 +250,15 @@ protected:
         return TAllocation::offsetAllocation(memory);
     }
 
+    void* allocateFromNewPage(size_t numBytes, size_t allocationSize);
+    void* allocateLarge(size_t allocationSize);
+    tHeader* obtainPage();
+    void trimFreeList();
+    void updatePeakBytes();
+
     size_t pageSize;        // granularity of allocation from the OS
+    size_t maxPageSize;     // pages stop growing at this size
+    size_t nextPageSize;    // size of the next page obtained from the OS
     size_t alignment;       // all returned allocations will be aligned at 
                             // this granularity, which will be a power of 2
     size_t alignmentMask;
@@ -202,12 +266,17 @@ protected:
                             //      header (basically, size of header, rounded
                             //      up to make it aligned
     size_t currentPageOffset;  // next offset in top of inUseList to allocate from
+    size_t currentPageSize;    // size of the top of inUseList, or 0 if there is
+                               //      no page to allocate from
     tHeader* freeList;      // list of popped memory
     tHeader* inUseList;     // list of all memory currently being used
+    tHeader* largeList;     // list of large allocations currently being used
     tAllocStack stack;      // stack of where to allocate from, to partition pool
 
-    int numCalls;           // just an interesting statistic
-    size_t totalBytes;      // just an interesting statistic
+    size_t freeBytes;       // memory in freeList
+    size_t retainedBytesLimit;
+    size_t inUseBytes;      // memory in inUseList and largeList
+    Statistics statistics;
 private:
     TPoolAllocator& operator=(const TPoolAllocator&);  // dont allow assignment operator
     TPoolAllocator(const TPoolAllocator&);  // dont allow default copy constructor
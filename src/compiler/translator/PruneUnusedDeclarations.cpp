@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PruneUnusedDeclarations.cpp: Implements PruneUnusedDeclarations.
+//
+
+#include "compiler/translator/PruneUnusedDeclarations.h"
+
+#include "compiler/translator/SymbolTable.h"
+
+namespace
+{
+
+// Records the variables and structures a subtree refers to.
+class CollectReferences : public TIntermTraverser
+{
+  public:
+    CollectReferences(std::set<int> *variables, std::set<const TStructure*> *structures)
+        : mVariables(variables),
+          mStructures(structures)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node)
+    {
+        mVariables->insert(node->getId());
+        addStructure(node->getType());
+    }
+
+    virtual void visitConstantUnion(TIntermConstantUnion *node)
+    {
+        addStructure(node->getType());
+    }
+
+    virtual bool visitBinary(Visit, TIntermBinary *node)
+    {
+        addStructure(node->getType());
+        return true;
+    }
+
+    virtual bool visitUnary(Visit, TIntermUnary *node)
+    {
+        addStructure(node->getType());
+        return true;
+    }
+
+    virtual bool visitSelection(Visit, TIntermSelection *node)
+    {
+        addStructure(node->getType());
+        return true;
+    }
+
+    virtual bool visitAggregate(Visit, TIntermAggregate *node)
+    {
+        addStructure(node->getType());
+        return true;
+    }
+
+    bool usesStructure(const TType &type) const
+    {
+        return type.getStruct() && mStructures->count(type.getStruct()) > 0;
+    }
+
+  private:
+    void addStructure(const TType &type)
+    {
+        const TStructure *structure = type.getStruct();
+        if (!structure || !mStructures->insert(structure).second)
+        {
+            return;
+        }
+
+        const TFieldList &fields = structure->fields();
+        for (size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++)
+        {
+            addStructure(*fields[fieldIndex]->type());
+        }
+    }
+
+    std::set<int> *mVariables;
+    std::set<const TStructure*> *mStructures;
+};
+
+TString GetPrototypeMangledName(TIntermAggregate *prototype)
+{
+    TString mangledName = TFunction::mangleName(prototype->getName());
+
+    TIntermSequence &parameters = prototype->getSequence();
+    for (size_t parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+    {
+        TType type = parameters[parameterIndex]->getAsTyped()->getType();
+        mangledName += type.getMangledName();
+    }
+
+    return mangledName;
+}
+
+TIntermSymbol *GetDeclaredSymbol(TIntermNode *declarator)
+{
+    TIntermBinary *initialization = declarator->getAsBinaryNode();
+    if (initialization)
+    {
+        ASSERT(initialization->getOp() == EOpInitialize);
+        return initialization->getLeft()->getAsSymbolNode();
+    }
+
+    return declarator->getAsSymbolNode();
+}
+
+bool IsPrunableDeclarator(TIntermNode *declarator, const std::set<int> &usedVariables,
+                          const CollectReferences &references)
+{
+    TIntermSymbol *symbol = GetDeclaredSymbol(declarator);
+    if (!symbol)
+    {
+        return false;
+    }
+
+    // The first declaration of a structure type also defines it
+    if (references.usesStructure(symbol->getType()))
+    {
+        return false;
+    }
+
+    // Structure definitions without a variable
+    if (symbol->getSymbol() == "")
+    {
+        return symbol->getBasicType() == EbtStruct;
+    }
+
+    switch (symbol->getQualifier())
+    {
+      case EvqGlobal:
+      case EvqConst:
+        return usedVariables.count(symbol->getId()) == 0;
+      default:
+        return false;
+    }
+}
+
+}
+
+void PruneUnusedDeclarations(TIntermNode *root, const std::set<TString> &usedFunctions)
+{
+    TIntermAggregate *rootAggregate = root->getAsAggregate();
+    if (!rootAggregate || usedFunctions.empty())
+    {
+        return;
+    }
+
+    std::set<int> usedVariables;
+    std::set<const TStructure*> usedStructures;
+    CollectReferences references(&usedVariables, &usedStructures);
+
+    // Declarations only refer to what was declared before them, so walking the global scope
+    // backwards finds every use of a declaration before reaching it.
+    TIntermSequence &globals = rootAggregate->getSequence();
+    TIntermSequence kept;
+
+    for (size_t globalIndex = globals.size(); globalIndex-- > 0;)
+    {
+        TIntermNode *global = globals[globalIndex];
+        TIntermAggregate *aggregate = global->getAsAggregate();
+
+        if (aggregate && aggregate->getOp() == EOpFunction)
+        {
+            if (usedFunctions.count(aggregate->getName()) == 0)
+            {
+                continue;
+            }
+        }
+        else if (aggregate && aggregate->getOp() == EOpPrototype)
+        {
+            if (usedFunctions.count(GetPrototypeMangledName(aggregate)) == 0)
+            {
+                continue;
+            }
+        }
+        else if (aggregate && aggregate->getOp() == EOpDeclaration)
+        {
+            // Later declarators may be initialized from earlier ones
+            TIntermSequence &declarators = aggregate->getSequence();
+            TIntermSequence keptDeclarators;
+
+            for (size_t declaratorIndex = declarators.size(); declaratorIndex-- > 0;)
+            {
+                TIntermNode *declarator = declarators[declaratorIndex];
+                if (!IsPrunableDeclarator(declarator, usedVariables, references))
+                {
+                    declarator->traverse(&references);
+                    keptDeclarators.push_back(declarator);
+                }
+            }
+
+            if (keptDeclarators.empty())
+            {
+                continue;
+            }
+
+            declarators.assign(keptDeclarators.rbegin(), keptDeclarators.rend());
+            kept.push_back(global);
+            continue;
+        }
+
+        global->traverse(&references);
+        kept.push_back(global);
+    }
+
+    globals.assign(kept.rbegin(), kept.rend());
+}
@@ -0,0 +1,23 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PruneUnusedDeclarations.h: Removes the functions main() doesn't call, and the global
+// variables and structure declarations which only those functions used.
+//
+
+#ifndef COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
+#define COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
+
+#include <set>
+
+#include "compiler/translator/intermediate.h"
+
+// usedFunctions holds the mangled names of the entry point and of every function it calls,
+// directly or not, as found by DetectCallDepth. The entry point is css_main() once a CSS
+// shader has been rewritten. Nothing is removed if usedFunctions is empty.
+// Uniforms, attributes, varyings and other interface variables are always kept.
+void PruneUnusedDeclarations(TIntermNode *root, const std::set<TString> &usedFunctions);
+
+#endif // COMPILER_PRUNE_UNUSED_DECLARATIONS_H_
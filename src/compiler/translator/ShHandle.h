@@ -16,6 +16,9 @@
 
 #include "GLSLANG/ShaderLang.h"
 
+#include <set>
+#include <string>
+
 #include "compiler/translator/BuiltInFunctionEmulator.h"
 #include "compiler/translator/ExtensionBehavior.h"
 #include "compiler/translator/HashNames.h"
@@ -24,9 +27,15 @@
 #include "compiler/translator/VariableInfo.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+namespace pp
+{
+class MacroSnapshot;
+}
+
 class LongNameMap;
 class TCompiler;
 class TDependencyGraph;
+class TShaderPermutations;
 class TranslatorHLSL;
 
 //
@@ -51,6 +60,35 @@ protected:
     TPoolAllocator allocator;
 };
 
+//
+// Macros to define before the source of a compile, and the names of the
+// macros its preprocessing looked up.
+//
+struct TMacroPrelude
+{
+    const ShMacroDefinition* definitions;
+    size_t definitionCount;
+    std::set<std::string> lookups;
+};
+
+//
+// The results of a compile, kept to restore them when another compile would
+// give the same results. Translators with results of their own extend it.
+//
+struct TCompileResults
+{
+    virtual ~TCompileResults() { }
+
+    bool success;
+    int shaderVersion;
+    TPersistString infoLog;
+    TPersistString objectCode;
+    TVariableInfoList attribs;
+    TVariableInfoList uniforms;
+    TVariableInfoList varyings;
+    NameMap nameMap;
+};
+
 //
 // The base class for the machine dependent compiler to derive from
 // for managing object code from the compile.
@@ -64,7 +102,16 @@ public:
     bool Init(const ShBuiltInResources& resources);
     bool compile(const char* const shaderStrings[],
                  size_t numStrings,
-                 int compileOptions);
+                 int compileOptions,
+                 TMacroPrelude* macroPrelude = NULL);
+
+    // Saves the results of the latest compile, or restores saved results
+    // as if the compile which gave them had just happened.
+    virtual TCompileResults* saveResults(bool success) const;
+    virtual void restoreResults(const TCompileResults& results);
+
+    // Compiles the permutations of a shader body for ShCompilePermutation.
+    TShaderPermutations& getPermutations();
 
     // Get results of the last compilation.
     int getShaderVersion() const { return shaderVersion; }
@@ -76,6 +123,7 @@ public:
 
     ShHashFunction64 getHashFunction() const { return hashFunction; }
     NameMap& getNameMap() { return nameMap; }
+    const TPoolAllocator::Statistics& getPoolStatistics() const { return allocator.getStatistics(); }
     TSymbolTable& getSymbolTable() { return symbolTable; }
 
 protected:
@@ -85,8 +133,12 @@ protected:
     bool InitBuiltInSymbolTable(const ShBuiltInResources& resources);
     // Clears the results from the previous compilation.
     void clearResults();
+    // Saves the results every compiler has, for saveResults().
+    void saveCompilerResults(bool success, TCompileResults* results) const;
     // Return true if function recursion is detected or call depth exceeded.
-    bool detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth);
+    // If usedFunctions isn't NULL, the functions main() calls are added to it.
+    bool detectCallDepth(TIntermNode* root, TInfoSink& infoSink, bool limitCallStackDepth,
+                         std::set<TString>* usedFunctions);
     // Returns true if a program has no conflicting or missing fragment outputs
     bool validateOutputs(TIntermNode* root);
     // Rewrites a shader's intermediate tree according to the CSS Shaders spec.
@@ -99,7 +151,7 @@ protected:
     // Map long variable names into shorter ones.
     void mapLongVariableNames(TIntermNode* root);
     // Translate to object code.
-    virtual void translate(TIntermNode* root) = 0;
+    virtual void translate(TIntermNode* root, int compileOptions) = 0;
     // Returns true if, after applying the packing rules in the GLSL 1.017 spec
     // Appendix A, section 7, the shader does not use too many uniforms.
     bool enforcePackingRestrictions();
@@ -165,6 +217,13 @@ private:
     // name hashing.
     ShHashFunction64 hashFunction;
     NameMap nameMap;
+
+    // Created by the first permutation compile.
+    TShaderPermutations* permutations;
+
+    // The macros predefined for this compiler, which don't change between
+    // compiles. Taken by the first compile, and shared by the later ones.
+    pp::MacroSnapshot* predefinedMacros;
 };
 
 //
@@ -14,6 +14,7 @@
 #include "compiler/translator/InitializeDll.h"
 #include "compiler/preprocessor/length_limits.h"
 #include "compiler/translator/ShHandle.h"
+#include "compiler/translator/ShaderPermutations.h"
 #include "compiler/translator/TranslatorHLSL.h"
 #include "compiler/translator/VariablePacker.h"
 
@@ -159,6 +160,41 @@ int ShCompile(
     return success ? 1 : 0;
 }
 
+int ShSetPermutationBody(
+    const ShHandle handle,
+    const char* const shaderStrings[],
+    size_t numStrings)
+{
+    if (handle == 0 || (numStrings > 0 && shaderStrings == 0))
+        return 0;
+
+    TShHandleBase* base = reinterpret_cast<TShHandleBase*>(handle);
+    TCompiler* compiler = base->getAsCompiler();
+    if (compiler == 0)
+        return 0;
+
+    compiler->getPermutations().setBody(shaderStrings, numStrings);
+    return 1;
+}
+
+int ShCompilePermutation(
+    const ShHandle handle,
+    const ShMacroDefinition* definitions,
+    size_t numDefinitions,
+    int compileOptions)
+{
+    if (handle == 0 || (numDefinitions > 0 && definitions == 0))
+        return 0;
+
+    TShHandleBase* base = reinterpret_cast<TShHandleBase*>(handle);
+    TCompiler* compiler = base->getAsCompiler();
+    if (compiler == 0)
+        return 0;
+
+    bool success = compiler->getPermutations().compile(definitions, numDefinitions, compileOptions);
+    return success ? 1 : 0;
+}
+
 void ShGetInfo(const ShHandle handle, ShShaderInfo pname, size_t* params)
 {
     if (!handle || !params)
@@ -218,6 +254,24 @@ void ShGetInfo(const ShHandle handle, ShShaderInfo pname, size_t* params)
     case SH_SHADER_VERSION:
         *params = compiler->getShaderVersion();
         break;
+    case SH_POOL_ALLOCATION_COUNT:
+        *params = compiler->getPoolStatistics().allocationCount;
+        break;
+    case SH_POOL_ALLOCATED_BYTES:
+        *params = compiler->getPoolStatistics().allocatedBytes;
+        break;
+    case SH_POOL_PAGE_COUNT:
+        *params = compiler->getPoolStatistics().pageCount;
+        break;
+    case SH_POOL_LARGE_ALLOCATION_COUNT:
+        *params = compiler->getPoolStatistics().largeAllocationCount;
+        break;
+    case SH_POOL_PEAK_BYTES:
+        *params = compiler->getPoolStatistics().peakBytes;
+        break;
+    case SH_REUSED_PERMUTATIONS:
+        *params = compiler->getPermutations().getReuseCount();
+        break;
     default: UNREACHABLE();
     }
 }
@@ -254,6 +308,20 @@ void ShGetObjectCode(const ShHandle handle, char* objCode)
     strcpy(objCode, infoSink.obj.c_str());
 }
 
+void ShSetObjectCodeCallback(const ShHandle handle,
+                             ShObjectCodeCallback callback,
+                             void* userData)
+{
+    if (!handle)
+        return;
+
+    TShHandleBase* base = static_cast<TShHandleBase*>(handle);
+    TCompiler* compiler = base->getAsCompiler();
+    if (!compiler) return;
+
+    compiler->getInfoSink().obj.setCallback(callback, userData);
+}
+
 void ShGetVariableInfo(const ShHandle handle,
                        ShShaderInfo varType,
                        int index,
@@ -370,6 +438,18 @@ void ShGetInfoPointer(const ShHandle handle, ShShaderInfo pname, void** params)
         return;
 
     TShHandleBase* base = static_cast<TShHandleBase*>(handle);
+
+    if (pname == SH_OBJECT_CODE_POINTER || pname == SH_INFO_LOG_POINTER)
+    {
+        TCompiler* compiler = base->getAsCompiler();
+        if (!compiler) return;
+
+        TInfoSink& infoSink = compiler->getInfoSink();
+        const TInfoSinkBase& sink = (pname == SH_OBJECT_CODE_POINTER) ? infoSink.obj : infoSink.info;
+        *params = (void*)sink.c_str();
+        return;
+    }
+
     TranslatorHLSL* translator = base->getAsTranslatorHLSL();
     if (!translator) return;
 
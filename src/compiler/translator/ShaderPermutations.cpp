@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderPermutations.cpp: Implements TShaderPermutations.
+//
+
+#include "compiler/translator/ShaderPermutations.h"
+
+namespace
+{
+
+// Keeps the results of this many permutations of a body at most.
+const size_t kMaxPermutations = 256;
+
+}
+
+TShaderPermutations::TShaderPermutations(TCompiler *compiler)
+    : mCompiler(compiler),
+      mReuseCount(0)
+{
+}
+
+TShaderPermutations::~TShaderPermutations()
+{
+    clear();
+}
+
+void TShaderPermutations::setBody(const char *const shaderStrings[], size_t numStrings)
+{
+    clear();
+    mBody.assign(shaderStrings, shaderStrings + numStrings);
+}
+
+bool TShaderPermutations::compile(const ShMacroDefinition *definitions, size_t numDefinitions, int compileOptions)
+{
+    // A later definition of a name replaces an earlier one, as a redefinition
+    // would if it weren't an error.
+    Definitions definedValues;
+    for (size_t i = 0; i < numDefinitions; i++)
+    {
+        definedValues[definitions[i].name] = definitions[i].value ? definitions[i].value : "";
+    }
+
+    // Results streamed to a callback aren't kept, so they can't be reused.
+    bool reusable = !mCompiler->getInfoSink().obj.hasCallback();
+    if (reusable)
+    {
+        const Permutation *permutation = findPermutation(definedValues, compileOptions);
+        if (permutation)
+        {
+            mCompiler->restoreResults(*permutation->results);
+            mReuseCount++;
+            return permutation->results->success;
+        }
+    }
+
+    std::vector<ShMacroDefinition> uniqueDefinitions;
+    for (Definitions::const_iterator iter = definedValues.begin(); iter != definedValues.end(); ++iter)
+    {
+        ShMacroDefinition definition = { iter->first.c_str(), iter->second.c_str() };
+        uniqueDefinitions.push_back(definition);
+    }
+
+    TMacroPrelude prelude;
+    prelude.definitions = uniqueDefinitions.empty() ? NULL : &uniqueDefinitions[0];
+    prelude.definitionCount = uniqueDefinitions.size();
+
+    std::vector<const char*> body;
+    for (size_t i = 0; i < mBody.size(); i++)
+        body.push_back(mBody[i].c_str());
+
+    bool success = mCompiler->compile(body.empty() ? NULL : &body[0], body.size(), compileOptions, &prelude);
+
+    if (reusable && mPermutations.size() < kMaxPermutations)
+    {
+        Permutation permutation;
+        permutation.compileOptions = compileOptions;
+        for (std::set<std::string>::const_iterator name = prelude.lookups.begin(); name != prelude.lookups.end(); ++name)
+        {
+            Definitions::const_iterator definition = definedValues.find(*name);
+            MacroState &state = permutation.lookups[*name];
+            state.defined = definition != definedValues.end();
+            if (state.defined)
+                state.value = definition->second;
+        }
+        permutation.results = mCompiler->saveResults(success);
+        mPermutations.push_back(permutation);
+    }
+
+    return success;
+}
+
+const TShaderPermutations::Permutation *TShaderPermutations::findPermutation(const Definitions &definitions,
+                                                                             int compileOptions) const
+{
+    for (size_t i = 0; i < mPermutations.size(); i++)
+    {
+        const Permutation &permutation = mPermutations[i];
+        if (permutation.compileOptions != compileOptions)
+            continue;
+
+        bool same = true;
+        for (MacroStates::const_iterator lookup = permutation.lookups.begin();
+             same && lookup != permutation.lookups.end(); ++lookup)
+        {
+            Definitions::const_iterator definition = definitions.find(lookup->first);
+            if (definition == definitions.end())
+                same = !lookup->second.defined;
+            else
+                same = lookup->second.defined && lookup->second.value == definition->second;
+        }
+
+        if (same)
+            return &permutation;
+    }
+
+    return NULL;
+}
+
+void TShaderPermutations::clear()
+{
+    for (size_t i = 0; i < mPermutations.size(); i++)
+        delete mPermutations[i].results;
+
+    mPermutations.clear();
+    mBody.clear();
+    mReuseCount = 0;
+}
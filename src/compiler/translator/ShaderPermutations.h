@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderPermutations.h: Compiles the permutations of a shader body, which
+// differ in the macros defined before it, and reuses the results of an
+// earlier permutation when the body can't tell the two apart.
+//
+// This memoises whole results: nothing is shared between permutations that
+// differ in a macro the body looks up. Such a permutation is preprocessed,
+// parsed and translated in full, at a small cost over ShCompile for keeping
+// track of the lookups and saving the results.
+//
+
+#ifndef COMPILER_SHADER_PERMUTATIONS_H_
+#define COMPILER_SHADER_PERMUTATIONS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "compiler/translator/ShHandle.h"
+
+class TShaderPermutations
+{
+  public:
+    explicit TShaderPermutations(TCompiler *compiler);
+    ~TShaderPermutations();
+
+    void setBody(const char *const shaderStrings[], size_t numStrings);
+    bool compile(const ShMacroDefinition *definitions, size_t numDefinitions, int compileOptions);
+
+    size_t getReuseCount() const { return mReuseCount; }
+
+  private:
+    // The value of each defined macro of a permutation.
+    typedef std::map<std::string, std::string> Definitions;
+
+    // What a permutation's macros were for each name its preprocessing
+    // looked up. Only these can change the results, because the contents of
+    // skipped groups are never looked at.
+    struct MacroState
+    {
+        bool defined;
+        std::string value;
+    };
+    typedef std::map<std::string, MacroState> MacroStates;
+
+    struct Permutation
+    {
+        int compileOptions;
+        MacroStates lookups;
+        TCompileResults *results;
+    };
+
+    const Permutation *findPermutation(const Definitions &definitions, int compileOptions) const;
+    void clear();
+
+    TCompiler *mCompiler;
+    std::vector<std::string> mBody;
+    std::vector<Permutation> mPermutations;
+    size_t mReuseCount;
+};
+
+#endif // COMPILER_SHADER_PERMUTATIONS_H_
@@ -16,6 +16,7 @@
 #include "compiler/translator/SymbolTable.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <algorithm>
 #include <climits>
 
@@ -88,6 +89,57 @@ TString TType::buildMangledName() const
     return mangledName;
 }
 
+TTypeDescriptor TType::descriptors[EbtGuardSamplerEnd][5][5];
+
+void TType::InitializeDescriptors()
+{
+    // The mangled names are built as TStrings, which need a pool.
+    TPoolAllocator *previousAllocator = GetGlobalPoolAllocator();
+    TPoolAllocator allocator;
+    SetGlobalPoolAllocator(&allocator);
+    allocator.push();
+
+    for (int basicType = EbtFloat; basicType < EbtGuardSamplerEnd; basicType++)
+    {
+        if (basicType == EbtGuardSamplerBegin || basicType == EbtSamplerExternalOES || basicType == EbtSampler2DRect)
+            continue;
+
+        int maxSize = IsSampler(static_cast<TBasicType>(basicType)) ? 1 : 4;
+        for (int primarySize = 1; primarySize <= maxSize; primarySize++)
+        {
+            for (int secondarySize = 1; secondarySize <= maxSize; secondarySize++)
+            {
+                if (primarySize == 1 && secondarySize > 1)
+                    continue;
+
+                TType type(static_cast<TBasicType>(basicType), EbpUndefined, EvqTemporary, primarySize, secondarySize);
+                TString mangledName = type.buildMangledName() + ';';
+
+                TTypeDescriptor &descriptor = descriptors[basicType][primarySize][secondarySize];
+                ASSERT(mangledName.size() < sizeof(descriptor.mangledName));
+                memcpy(descriptor.mangledName, mangledName.c_str(), mangledName.size() + 1);
+                descriptor.length = mangledName.size();
+                descriptor.hash = HashMangledName(descriptor.mangledName, descriptor.length);
+            }
+        }
+    }
+
+    allocator.pop();
+    SetGlobalPoolAllocator(previousAllocator);
+}
+
+size_t TType::HashMangledName(const char *mangledName, size_t length)
+{
+    // FNV-1a
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<unsigned char>(mangledName[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 size_t TType::getObjectSize() const
 {
     size_t totalSize;
@@ -160,6 +212,32 @@ TFunction::~TFunction()
         delete (*i).type;
 }
 
+const TString &TFunction::getMangledName() const
+{
+    if (mangledName.empty())
+    {
+        mangledName = mangleName(getName());
+        for (TParamList::const_iterator i = parameters.begin(); i != parameters.end(); ++i)
+            mangledName += i->type->getMangledName();
+    }
+
+    return mangledName;
+}
+
+bool TFunction::hasSameSignature(const TFunction &function) const
+{
+    if (parameters.size() != function.parameters.size() || getName() != function.getName())
+        return false;
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (!parameters[i].type->sameMangledName(*function.parameters[i].type))
+            return false;
+    }
+
+    return true;
+}
+
 //
 // Symbol table levels are a map of pointers to symbols that have to be deleted.
 //
@@ -231,6 +309,30 @@ TSymbol *TSymbolTable::find(const TString &name, int shaderVersion, bool *builtI
     return symbol;
 }
 
+//
+// Finds the function a call resolves to, like find(call.getMangledName()) but
+// without building the mangled name of the call.
+//
+const TFunction *TSymbolTable::findFunction(const TFunction &call, int shaderVersion, bool *builtIn)
+{
+    int level = currentLevel();
+    const TFunction *function;
+
+    do
+    {
+        if (level == ESSL3_BUILTINS && shaderVersion != 300) level--;
+        if (level == ESSL1_BUILTINS && shaderVersion != 100) level--;
+
+        function = table[level]->findFunction(call);
+    }
+    while (function == 0 && --level >= 0);
+
+    if (builtIn)
+        *builtIn = (level <= LAST_BUILTIN_LEVEL);
+
+    return function;
+}
+
 TSymbol *TSymbolTable::findBuiltIn(const TString &name, int shaderVersion)
 {
     for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
@@ -128,12 +128,13 @@ public:
     TFunction(TOperator o) :
         TSymbol(0),
         returnType(TType(EbtVoid, EbpUndefined)),
+        mangledNameHash(0),
         op(o),
         defined(false) { }
     TFunction(const TString *name, TType& retType, TOperator tOp = EOpNull) : 
         TSymbol(name), 
         returnType(retType),
-        mangledName(TFunction::mangleName(*name)),
+        mangledNameHash(TType::HashMangledName(name->c_str(), name->size())),
         op(tOp),
         defined(false) { }
     virtual ~TFunction();
@@ -148,10 +149,15 @@ public:
     void addParameter(TParameter& p) 
     { 
         parameters.push_back(p);
-        mangledName = mangledName + p.type->getMangledName();
+        mangledName.clear();
+        mangledNameHash = (mangledNameHash ^ p.type->getMangledNameHash()) * 16777619u;
     }
 
-    const TString& getMangledName() const { return mangledName; }
+    // The mangled name is only built when it's asked for. Calls are resolved
+    // by the hash of the name and the parameter types instead.
+    virtual const TString& getMangledName() const;
+    size_t getMangledNameHash() const { return mangledNameHash; }
+    bool hasSameSignature(const TFunction &function) const;
     const TType& getReturnType() const { return returnType; }
 
     void relateToOperator(TOperator o) { op = o; }
@@ -169,7 +175,8 @@ private:
     typedef TVector<TParameter> TParamList;
     TParamList parameters;
     TType returnType;
-    TString mangledName;
+    mutable TString mangledName;
+    size_t mangledNameHash;
     TOperator op;
     bool defined;
 };
@@ -211,7 +218,16 @@ public:
 
     bool insert(TSymbol &symbol)
     {
-        return insert(symbol.getMangledName(), symbol);
+        if (!insert(symbol.getMangledName(), symbol))
+            return false;
+
+        if (symbol.isFunction())
+        {
+            TFunction *function = static_cast<TFunction*>(&symbol);
+            functions.insert(tFunctionLevel::value_type(function->getMangledNameHash(), function));
+        }
+
+        return true;
     }
 
     TSymbol* find(const TString& name) const
@@ -223,11 +239,28 @@ public:
             return (*it).second;
     }
 
+    const TFunction* findFunction(const TFunction& call) const
+    {
+        std::pair<tFunctionLevel::const_iterator, tFunctionLevel::const_iterator> range =
+            functions.equal_range(call.getMangledNameHash());
+        for (tFunctionLevel::const_iterator it = range.first; it != range.second; ++it)
+        {
+            if (it->second->hasSameSignature(call))
+                return it->second;
+        }
+        return 0;
+    }
+
     void relateToOperator(const char* name, TOperator op);
     void relateToExtension(const char* name, const TString& ext);
 
 protected:
+    // The functions of the level by the hash of their mangled names.
+    typedef std::multimap<size_t, TFunction*, std::less<size_t>,
+                          pool_allocator<std::pair<const size_t, TFunction*> > > tFunctionLevel;
+
     tLevel level;
+    tFunctionLevel functions;
     static int uniqueId;     // for unique identification in code generation
 };
 
@@ -323,6 +356,7 @@ public:
 
     TSymbol *find(const TString &name, int shaderVersion, bool *builtIn = false, bool *sameScope = false);
     TSymbol *findBuiltIn(const TString &name, int shaderVersion);
+    const TFunction *findFunction(const TFunction &call, int shaderVersion, bool *builtIn = 0);
     
     TSymbolTableLevel *getOuterLevel() {
         assert(currentLevel() >= 1);
@@ -12,11 +12,19 @@ TranslatorESSL::TranslatorESSL(ShShaderType type, ShShaderSpec spec)
     : TCompiler(type, spec) {
 }
 
-void TranslatorESSL::translate(TIntermNode* root) {
-    TInfoSinkBase& sink = getInfoSink().obj;
+void TranslatorESSL::translate(TIntermNode* root, int compileOptions) {
+    // Minified output is only added to the object code once its whitespace
+    // is removed.
+    bool minify = (compileOptions & SH_MINIFY_OUTPUT) != 0;
+    TInfoSinkBase unminifiedSink;
+    TInfoSinkBase& sink = minify ? unminifiedSink : getInfoSink().obj;
+
+    ShortNames shortNames;
+    if (minify)
+        shortNames.reserveNames(root);
 
     // Write built-in extension behaviors.
-    writeExtensionBehavior();
+    writeExtensionBehavior(sink);
 
     // Write emulated built-in functions if needed.
     getBuiltInFunctionEmulator().OutputEmulatedFunctionDefinition(
@@ -26,12 +34,15 @@ void TranslatorESSL::translate(TIntermNode* root) {
     getArrayBoundsClamper().OutputClampingFunctionDefinition(sink);
 
     // Write translated shader.
-    TOutputESSL outputESSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion());
+    TOutputESSL outputESSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(),
+                           minify ? &shortNames : NULL, getSymbolTable(), getShaderVersion());
     root->traverse(&outputESSL);
+
+    if (minify)
+        getInfoSink().obj << MinifyWhitespace(unminifiedSink.str());
 }
 
-void TranslatorESSL::writeExtensionBehavior() {
-    TInfoSinkBase& sink = getInfoSink().obj;
+void TranslatorESSL::writeExtensionBehavior(TInfoSinkBase& sink) {
     const TExtensionBehavior& extensionBehavior = getExtensionBehavior();
     for (TExtensionBehavior::const_iterator iter = extensionBehavior.begin();
          iter != extensionBehavior.end(); ++iter) {
@@ -14,10 +14,10 @@ public:
     TranslatorESSL(ShShaderType type, ShShaderSpec spec);
 
 protected:
-    virtual void translate(TIntermNode* root);
+    virtual void translate(TIntermNode* root, int compileOptions);
 
 private:
-    void writeExtensionBehavior();
+    void writeExtensionBehavior(TInfoSinkBase& sink);
 };
 
 #endif  // COMPILER_TRANSLATORESSL_H_
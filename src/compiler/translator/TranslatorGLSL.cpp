@@ -25,8 +25,16 @@ TranslatorGLSL::TranslatorGLSL(ShShaderType type, ShShaderSpec spec)
     : TCompiler(type, spec) {
 }
 
-void TranslatorGLSL::translate(TIntermNode* root) {
-    TInfoSinkBase& sink = getInfoSink().obj;
+void TranslatorGLSL::translate(TIntermNode* root, int compileOptions) {
+    // Minified output is only added to the object code once its whitespace
+    // is removed.
+    bool minify = (compileOptions & SH_MINIFY_OUTPUT) != 0;
+    TInfoSinkBase unminifiedSink;
+    TInfoSinkBase& sink = minify ? unminifiedSink : getInfoSink().obj;
+
+    ShortNames shortNames;
+    if (minify)
+        shortNames.reserveNames(root);
 
     // Write GLSL version.
     writeVersion(getShaderType(), root, sink);
@@ -39,6 +47,10 @@ void TranslatorGLSL::translate(TIntermNode* root) {
     getArrayBoundsClamper().OutputClampingFunctionDefinition(sink);
 
     // Write translated shader.
-    TOutputGLSL outputGLSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(), getSymbolTable(), getShaderVersion());
+    TOutputGLSL outputGLSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(),
+                           minify ? &shortNames : NULL, getSymbolTable(), getShaderVersion());
     root->traverse(&outputGLSL);
+
+    if (minify)
+        getInfoSink().obj << MinifyWhitespace(unminifiedSink.str());
 }
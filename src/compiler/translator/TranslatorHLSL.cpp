@@ -9,12 +9,26 @@
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/OutputHLSL.h"
 
+namespace
+{
+
+struct TCompileResultsHLSL : public TCompileResults
+{
+    std::vector<sh::Uniform> activeUniforms;
+    sh::ActiveInterfaceBlocks activeInterfaceBlocks;
+    std::vector<sh::Attribute> activeOutputVariables;
+    std::vector<sh::Attribute> activeAttributes;
+    std::vector<sh::Varying> activeVaryings;
+};
+
+}
+
 TranslatorHLSL::TranslatorHLSL(ShShaderType type, ShShaderSpec spec, ShShaderOutput output)
     : TCompiler(type, spec), mOutputType(output)
 {
 }
 
-void TranslatorHLSL::translate(TIntermNode *root)
+void TranslatorHLSL::translate(TIntermNode *root, int compileOptions)
 {
     TParseContext& parseContext = *GetGlobalParseContext();
     sh::OutputHLSL outputHLSL(parseContext, getResources(), mOutputType);
@@ -27,3 +41,28 @@ void TranslatorHLSL::translate(TIntermNode *root)
     mActiveAttributes       = outputHLSL.getAttributes();
     mActiveVaryings         = outputHLSL.getVaryings();
 }
+
+TCompileResults *TranslatorHLSL::saveResults(bool success) const
+{
+    TCompileResultsHLSL *results = new TCompileResultsHLSL;
+    saveCompilerResults(success, results);
+
+    results->activeUniforms         = mActiveUniforms;
+    results->activeInterfaceBlocks  = mActiveInterfaceBlocks;
+    results->activeOutputVariables  = mActiveOutputVariables;
+    results->activeAttributes       = mActiveAttributes;
+    results->activeVaryings         = mActiveVaryings;
+    return results;
+}
+
+void TranslatorHLSL::restoreResults(const TCompileResults &results)
+{
+    TCompiler::restoreResults(results);
+
+    const TCompileResultsHLSL &resultsHLSL = static_cast<const TCompileResultsHLSL&>(results);
+    mActiveUniforms         = resultsHLSL.activeUniforms;
+    mActiveInterfaceBlocks  = resultsHLSL.activeInterfaceBlocks;
+    mActiveOutputVariables  = resultsHLSL.activeOutputVariables;
+    mActiveAttributes       = resultsHLSL.activeAttributes;
+    mActiveVaryings         = resultsHLSL.activeVaryings;
+}
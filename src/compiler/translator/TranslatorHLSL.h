@@ -21,8 +21,11 @@ public:
     const std::vector<sh::Attribute> &getAttributes() { return mActiveAttributes; }
     const std::vector<sh::Varying> &getVaryings() { return mActiveVaryings; }
 
+    virtual TCompileResults *saveResults(bool success) const;
+    virtual void restoreResults(const TCompileResults &results);
+
 protected:
-    virtual void translate(TIntermNode* root);
+    virtual void translate(TIntermNode* root, int compileOptions);
 
     std::vector<sh::Uniform> mActiveUniforms;
     sh::ActiveInterfaceBlocks mActiveInterfaceBlocks;
@@ -132,6 +132,18 @@ private:
     TLayoutMatrixPacking mMatrixPacking;
 };
 
+//
+// The mangled name of the types which aren't arrays, structures or interface
+// blocks, and its hash. Identical types share one descriptor, which is created
+// once per process.
+//
+struct TTypeDescriptor
+{
+    char mangledName[8];
+    size_t length;
+    size_t hash;
+};
+
 //
 // Base class for things that have a type.
 //
@@ -196,15 +208,54 @@ public:
     TStructure* getStruct() const { return structure; }
     void setStruct(TStructure* s) { structure = s; }
 
-    const TString& getMangledName() {
+    const TString& getMangledName() const {
         if (mangled.empty()) {
-            mangled = buildMangledName();
-            mangled += ';';
+            const TTypeDescriptor *descriptor = getDescriptor();
+            if (descriptor) {
+                mangled.assign(descriptor->mangledName, descriptor->length);
+            } else {
+                mangled = buildMangledName();
+                mangled += ';';
+            }
         }
 
         return mangled;
     }
 
+    size_t getMangledNameHash() const {
+        const TTypeDescriptor *descriptor = getDescriptor();
+        if (descriptor)
+            return descriptor->hash;
+
+        const TString &mangledName = getMangledName();
+        return HashMangledName(mangledName.c_str(), mangledName.size());
+    }
+
+    // Whether the types have the same mangled name, without building it when
+    // both have descriptors.
+    bool sameMangledName(const TType& right) const {
+        const TTypeDescriptor *descriptor = getDescriptor();
+        const TTypeDescriptor *rightDescriptor = right.getDescriptor();
+        if (descriptor || rightDescriptor)
+            return descriptor == rightDescriptor;
+
+        return getMangledName() == right.getMangledName();
+    }
+
+    // NULL for the types which aren't described by a shared descriptor.
+    const TTypeDescriptor *getDescriptor() const {
+        if (array || type >= EbtGuardSamplerEnd || primarySize > 4 || secondarySize > 4)
+            return NULL;
+
+        const TTypeDescriptor *descriptor = &descriptors[type][primarySize][secondarySize];
+        return descriptor->length > 0 ? descriptor : NULL;
+    }
+
+    // Creates the shared descriptors. Called once, when the process is
+    // initialized.
+    static void InitializeDescriptors();
+    static size_t HashMangledName(const char *mangledName, size_t length);
+
     bool sameElementType(const TType& right) const {
         return      type == right.type          &&
              primarySize == right.primarySize   &&
@@ -279,6 +330,8 @@ protected:
     TStructure* structure;
 
     mutable TString mangled;
+
+    static TTypeDescriptor descriptors[EbtGuardSamplerEnd][5][5];
 };
 
 //
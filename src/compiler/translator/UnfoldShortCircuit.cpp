@@ -34,7 +34,7 @@ bool UnfoldShortCircuit::visitBinary(Visit visit, TIntermBinary *node)
     // If our right node doesn't have side effects, we know we don't need to unfold this
     // expression: there will be no short-circuiting side effects to avoid
     // (note: unfolding doesn't depend on the left node -- it will always be evaluated)
-    if (!node->getRight()->hasSideEffects())
+    if (!mOutputHLSL->getMetadata().hasSideEffects(node->getRight()))
     {
         return true;
     }
@@ -3339,18 +3339,41 @@ int glslang_scan(size_t count, const char* const string[], const int length[],
     yyset_column(0,context->scanner);
     yyset_lineno(1,context->scanner);
 
+    // Start from the macros predefined by an earlier compile, if any.
+    pp::MacroSnapshot** predefinedMacros = context->predefinedMacros;
+    bool predefined = predefinedMacros && *predefinedMacros;
+    if (predefined)
+        context->preprocessor.startFromMacros(*predefinedMacros);
+
     // Initialize preprocessor.
     if (!context->preprocessor.init(count, string, length))
         return 1;
 
-    // Define extension macros.
-    const TExtensionBehavior& extBehavior = context->extensionBehavior();
-    for (TExtensionBehavior::const_iterator iter = extBehavior.begin();
-         iter != extBehavior.end(); ++iter) {
-        context->preprocessor.predefineMacro(iter->first.c_str(), 1);
+    if (!predefined) {
+        // Define extension macros.
+        const TExtensionBehavior& extBehavior = context->extensionBehavior();
+        for (TExtensionBehavior::const_iterator iter = extBehavior.begin();
+             iter != extBehavior.end(); ++iter) {
+            context->preprocessor.predefineMacro(iter->first.c_str(), 1);
+        }
+        if (context->fragmentPrecisionHigh)
+            context->preprocessor.predefineMacro("GL_FRAGMENT_PRECISION_HIGH", 1);
+
+        // The macros are the same for every compile of the compiler.
+        if (predefinedMacros)
+            *predefinedMacros = context->preprocessor.snapshotMacros();
+    }
+
+    // Define the macros of a permutation, and record what the source depends on.
+    if (context->macroPrelude) {
+        const TMacroPrelude* prelude = context->macroPrelude;
+        for (size_t i = 0; i < prelude->definitionCount; ++i) {
+            const ShMacroDefinition& definition = prelude->definitions[i];
+            if (!context->preprocessor.defineMacro(definition.name, definition.value ? definition.value : ""))
+                return 1;
+        }
+        context->preprocessor.recordMacroLookups(&context->macroPrelude->lookups);
     }
-    if (context->fragmentPrecisionHigh)
-        context->preprocessor.predefineMacro("GL_FRAGMENT_PRECISION_HIGH", 1);
 
     return 0;
 }
@@ -209,6 +209,7 @@ class TIntermSelection;
 class TIntermTyped;
 class TIntermSymbol;
 class TIntermLoop;
+class TIntermBranch;
 class TInfoSink;
 
 //
@@ -237,6 +238,7 @@ public:
     virtual TIntermSelection* getAsSelectionNode() { return 0; }
     virtual TIntermSymbol* getAsSymbolNode() { return 0; }
     virtual TIntermLoop* getAsLoopNode() { return 0; }
+    virtual TIntermBranch* getAsBranchNode() { return 0; }
 
     // Replace a child node. Return true if |original| is a child
     // node and it is replaced; otherwise, return false.
@@ -347,6 +349,7 @@ public:
             flowOp(op),
             expression(e) { }
 
+    virtual TIntermBranch* getAsBranchNode() { return this; }
     virtual void traverse(TIntermTraverser*);
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
@@ -408,6 +411,7 @@ public:
     virtual bool replaceChildNode(TIntermNode *, TIntermNode *) { return false; }
 
     TIntermTyped* fold(TOperator, TIntermTyped*, TInfoSink&);
+    static TIntermTyped* foldAggregateBuiltIn(TIntermAggregate*);
 
 protected:
     ConstantUnion *unionArrayPointer;
@@ -501,8 +505,10 @@ typedef TVector<int> TQualifierList;
 //
 class TIntermAggregate : public TIntermOperator {
 public:
-    TIntermAggregate() : TIntermOperator(EOpNull), userDefined(false), useEmulatedFunction(false) { }
-    TIntermAggregate(TOperator o) : TIntermOperator(o), useEmulatedFunction(false) { }
+    // The name shares the allocator of the sequence, rather than looking up the global
+    // allocator again.
+    TIntermAggregate() : TIntermOperator(EOpNull), name(sequence.get_allocator()), userDefined(false), useEmulatedFunction(false) { }
+    TIntermAggregate(TOperator o) : TIntermOperator(o), name(sequence.get_allocator()), useEmulatedFunction(false) { }
     ~TIntermAggregate() { }
 
     virtual TIntermAggregate* getAsAggregate() { return this; }
@@ -16,6 +16,7 @@
 
 #include "common/debug.h"
 #include "common/mathutil.h"
+#include "common/RingBufferTracer.h"
 #include "libGLESv2/main.h"
 #include "libGLESv2/Context.h"
 #include "libGLESv2/renderer/SwapChain.h"
@@ -79,6 +80,13 @@ bool Display::initialize()
         return error(EGL_NOT_INITIALIZED, false);
     }
 
+    // This module's trace records are written out in the background while the display is initialized
+    gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        tracer->startFlusher();
+    }
+
     EGLint minSwapInterval = mRenderer->getMinSwapInterval();
     EGLint maxSwapInterval = mRenderer->getMaxSwapInterval();
     EGLint maxTextureWidth = mRenderer->getMaxTextureWidth();
@@ -130,6 +138,15 @@ void Display::terminate()
         destroyContext(*mContextSet.begin());
     }
 
+    if (mRenderer)
+    {
+        gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+        if (tracer)
+        {
+            tracer->stopFlusher();
+        }
+    }
+
     glDestroyRenderer(mRenderer);
     mRenderer = NULL;
 }
@@ -237,6 +237,7 @@ static LRESULT CALLBACK SurfaceWindowProc(HWND hwnd, UINT message, WPARAM wparam
       Surface* surf = reinterpret_cast<Surface*>(GetProp(hwnd, kSurfaceProperty));
       if(surf)
       {
+          gl::DeferredContextLock deferredContextLock;
           surf->checkForOutOfDateSwapChain();
       }
   }
@@ -299,6 +299,8 @@ EGLSurface __stdcall eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config, EG
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLConfig config = 0x%0.8p, EGLNativeWindowType win = 0x%0.8p, "
           "const EGLint *attrib_list = 0x%0.8p)", dpy, config, win, attrib_list);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -328,6 +330,8 @@ EGLSurface __stdcall eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, c
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLConfig config = 0x%0.8p, const EGLint *attrib_list = 0x%0.8p)",
           dpy, config, attrib_list);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -373,6 +377,8 @@ EGLBoolean __stdcall eglDestroySurface(EGLDisplay dpy, EGLSurface surface)
 {
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLSurface surface = 0x%0.8p)", dpy, surface);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -604,6 +610,8 @@ EGLSurface __stdcall eglCreatePbufferFromClientBuffer(EGLDisplay dpy, EGLenum bu
           "EGLConfig config = 0x%0.8p, const EGLint *attrib_list = 0x%0.8p)",
           dpy, buftype, buffer, config, attrib_list);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -655,6 +663,8 @@ EGLBoolean __stdcall eglBindTexImage(EGLDisplay dpy, EGLSurface surface, EGLint
 {
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLSurface surface = 0x%0.8p, EGLint buffer = %d)", dpy, surface, buffer);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -702,6 +712,8 @@ EGLBoolean __stdcall eglReleaseTexImage(EGLDisplay dpy, EGLSurface surface, EGLi
 {
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLSurface surface = 0x%0.8p, EGLint buffer = %d)", dpy, surface, buffer);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -1058,6 +1070,8 @@ EGLBoolean __stdcall eglSwapBuffers(EGLDisplay dpy, EGLSurface surface)
 {
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLSurface surface = 0x%0.8p)", dpy, surface);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         egl::Display *display = static_cast<egl::Display*>(dpy);
@@ -1124,6 +1138,8 @@ EGLBoolean __stdcall eglPostSubBufferNV(EGLDisplay dpy, EGLSurface surface, EGLi
 {
     EVENT("(EGLDisplay dpy = 0x%0.8p, EGLSurface surface = 0x%0.8p, EGLint x = %d, EGLint y = %d, EGLint width = %d, EGLint height = %d)", dpy, surface, x, y, width, height);
 
+    gl::DeferredContextLock deferredContextLock;
+
     try
     {
         if (x < 0 || y < 0 || width < 0 || height < 0)
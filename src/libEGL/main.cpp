@@ -9,6 +9,9 @@
 #include "libEGL/main.h"
 
 #include "common/debug.h"
+#if defined(ANGLE_ENABLE_TRACE)
+#include "common/RingBufferTracer.h"
+#endif
 
 static DWORD currentTLS = TLS_OUT_OF_INDEXES;
 
@@ -68,6 +71,9 @@ extern "C" BOOL WINAPI DllMain(HINSTANCE instance, DWORD reason, LPVOID reserved
                     fclose(debug);
                 }
             }
+
+            // Every module has its own tracer since each links its own copy of common
+            gl::RingBufferTracer::initializeInstance("libEGL.angletrace");
 #endif
 
             currentTLS = TlsAlloc();
@@ -86,12 +92,22 @@ extern "C" BOOL WINAPI DllMain(HINSTANCE instance, DWORD reason, LPVOID reserved
       case DLL_THREAD_DETACH:
         {
             egl::DeallocateCurrent();
+#if defined(ANGLE_ENABLE_TRACE)
+            gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+            if (tracer)
+            {
+                tracer->releaseThreadBuffer();
+            }
+#endif
         }
         break;
       case DLL_PROCESS_DETACH:
         {
             egl::DeallocateCurrent();
             TlsFree(currentTLS);
+#if defined(ANGLE_ENABLE_TRACE)
+            gl::RingBufferTracer::releaseInstance();
+#endif
         }
         break;
       default:
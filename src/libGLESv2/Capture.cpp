@@ -0,0 +1,337 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Capture.cpp: Implements gl::Capture, an opt-in recorder of the calls made to the libGLESv2
+// entry points.
+
+#include "libGLESv2/Capture.h"
+
+#include "common/debug.h"
+#include "libGLESv2/main.h"
+#include "libGLESv2/Buffer.h"
+#include "libGLESv2/Context.h"
+#include "libGLESv2/formatutils.h"
+#include "libGLESv2/renderer/BufferStorage.h"
+
+namespace gl
+{
+
+namespace
+{
+
+// Calls are buffered and written out in blocks of about this size
+const size_t FlushSize = 4 * 1024 * 1024;
+
+GLuint IndexBytes(GLenum type)
+{
+    switch (type)
+    {
+      case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+      case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+      case GL_UNSIGNED_INT:   return sizeof(GLuint);
+      default:                return 0;
+    }
+}
+
+template <typename IndexType>
+GLuint MaxIndex(const IndexType *indices, GLsizei count)
+{
+    GLuint maxIndex = 0;
+    for (GLsizei index = 0; index < count; index++)
+    {
+        maxIndex = std::max<GLuint>(maxIndex, indices[index]);
+    }
+    return maxIndex;
+}
+
+bool HasClientVertexArrays(const Context *context)
+{
+    for (unsigned int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    {
+        const VertexAttribute &attribute = context->getVertexAttribState(attributeIndex);
+        if (attribute.mArrayEnabled && !attribute.mBoundBuffer.get())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+CapturePointer CaptureUnpackMemory(Context *context, const GLvoid *data, size_t size)
+{
+    if (!context || context->getPixelUnpackBuffer())
+    {
+        return CaptureOffset(data);
+    }
+
+    return CaptureMemory(data, size);
+}
+
+}
+
+Capture *Capture::mInstance = NULL;
+
+Capture::Capture(FILE *file)
+    : mFile(file),
+      mDepth(0),
+      mHeaderWritten(false),
+      mCallRecorded(false),
+      mCallStart(0),
+      mCallErrorCount(0),
+      mCalls(0),
+      mBytesWritten(0)
+{
+    InitializeCriticalSection(&mLock);
+    mEncoder.setDeferClientMemory(true);
+}
+
+Capture::~Capture()
+{
+    flush();
+    fclose(mFile);
+    DeleteCriticalSection(&mLock);
+
+    TRACE("Capture: %u calls, %llu bytes written", mCalls, mBytesWritten);
+}
+
+void Capture::initializeInstance()
+{
+    ASSERT(!mInstance);
+
+    char path[MAX_PATH];
+    DWORD pathLength = GetEnvironmentVariableA("ANGLE_CAPTURE_FILE", path, ArraySize(path));
+    if (pathLength > 0 && pathLength < ArraySize(path))
+    {
+        FILE *file = fopen(path, "wb");
+        if (file)
+        {
+            mInstance = new Capture(file);
+        }
+        else
+        {
+            ERR("Could not open the capture file %s", path);
+        }
+    }
+}
+
+void Capture::releaseInstance()
+{
+    SafeDelete(mInstance);
+}
+
+CaptureEncoder *Capture::beginCall()
+{
+    EnterCriticalSection(&mLock);
+
+    if (++mDepth > 1)
+    {
+        return NULL;
+    }
+
+    mCallRecorded = false;
+
+    if (!mHeaderWritten)
+    {
+        // The replay needs a context of the same version as the first one made current
+        Context *context = getContext();
+        if (!context)
+        {
+            return NULL;
+        }
+
+        CaptureFileHeader header = { CaptureMagic, CaptureVersion, context->getClientVersion(), 0 };
+        fwrite(&header, sizeof(header), 1, mFile);
+        mBytesWritten += sizeof(header);
+        mHeaderWritten = true;
+    }
+
+    mCallRecorded = true;
+    mCallStart = mEncoder.getData().size();
+    mCallErrorCount = getErrorCount();
+    mCalls++;
+    return &mEncoder;
+}
+
+void Capture::endCall(const CaptureDraw *draw)
+{
+    if (--mDepth == 0 && mCallRecorded)
+    {
+        if (getErrorCount() != mCallErrorCount)
+        {
+            // Calls which raised an error had no effect, and their arguments may not be valid
+            mEncoder.rollback(mCallStart);
+            mCalls--;
+        }
+        else
+        {
+            mEncoder.commit();
+
+            // The vertices the draw read are replayed before it
+            if (draw)
+            {
+                if (draw->type == GL_NONE)
+                {
+                    CaptureClientVertexArrays(&mDrawEncoder, draw->first, draw->count, draw->instanceCount);
+                }
+                else
+                {
+                    CaptureClientVertexArrays(&mDrawEncoder, draw->count, draw->type, draw->indices, draw->instanceCount);
+                }
+
+                mEncoder.insertCalls(mCallStart, mDrawEncoder);
+                mDrawEncoder.clear();
+            }
+
+            if (mEncoder.getData().size() >= FlushSize)
+            {
+                flush();
+            }
+        }
+    }
+
+    LeaveCriticalSection(&mLock);
+}
+
+void Capture::flush()
+{
+    const std::vector<unsigned char> &data = mEncoder.getData();
+    if (!data.empty())
+    {
+        fwrite(&data[0], 1, data.size(), mFile);
+        fflush(mFile);
+        mBytesWritten += data.size();
+        mEncoder.clear();
+    }
+}
+
+CapturePointer CaptureUnpackPixels(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid *pixels)
+{
+    Context *context = getContext();
+    if (!context || !pixels || width <= 0 || height <= 0 || depth <= 0)
+    {
+        return CaptureUnpackMemory(context, pixels, 0);
+    }
+
+    GLuint clientVersion = context->getClientVersion();
+    GLenum sizedFormat = GetSizedInternalFormat(format, type, clientVersion);
+    if (sizedFormat == GL_NONE)
+    {
+        return CaptureUnpackMemory(context, pixels, 0);
+    }
+
+    GLuint depthPitch = GetDepthPitch(sizedFormat, type, clientVersion, width, height, context->getUnpackAlignment());
+    return CaptureUnpackMemory(context, pixels, depthPitch * depth);
+}
+
+CapturePointer CaptureCompressedPixels(GLsizei imageSize, const GLvoid *data)
+{
+    return CaptureUnpackMemory(getContext(), data, std::max(imageSize, 0));
+}
+
+CapturePointer CapturePackPixels(GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels)
+{
+    Context *context = getContext();
+    if (!context || context->getPixelPackBuffer())
+    {
+        return CaptureOffset(pixels);
+    }
+
+    GLuint clientVersion = context->getClientVersion();
+    GLenum sizedFormat = GetSizedInternalFormat(format, type, clientVersion);
+    if (sizedFormat == GL_NONE || width <= 0 || height <= 0)
+    {
+        return CaptureOutput(pixels, 0);
+    }
+
+    GLuint rowPitch = GetRowPitch(sizedFormat, type, clientVersion, width, context->getPackAlignment());
+    return CaptureOutput(pixels, rowPitch * height);
+}
+
+CapturePointer CaptureIndices(GLsizei count, GLenum type, const GLvoid *indices)
+{
+    // The binding of a deferred context is as of the last call queued
+    Context *context = getContext();
+    DeferredContext *deferredContext = getDeferredContext();
+    bool elementArrayBuffer = (deferredContext && !deferredContext->isInline()) ? deferredContext->hasElementArrayBuffer()
+                                                                              : (context && context->getElementArrayBuffer());
+    if (!context || elementArrayBuffer)
+    {
+        return CaptureOffset(indices);
+    }
+
+    return CaptureMemory(indices, std::max(count, 0) * IndexBytes(type));
+}
+
+void CaptureClientVertexArrays(CaptureEncoder *encoder, GLint firstVertex, GLsizei vertexCount, GLsizei instanceCount)
+{
+    Context *context = getContext();
+    if (!context || firstVertex < 0 || vertexCount <= 0)
+    {
+        return;
+    }
+
+    for (unsigned int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    {
+        const VertexAttribute &attribute = context->getVertexAttribState(attributeIndex);
+        if (!attribute.mArrayEnabled || attribute.mBoundBuffer.get() || !attribute.mPointer)
+        {
+            continue;
+        }
+
+        // Instanced attributes advance once per divisor instances instead of per vertex
+        GLsizei elementCount = (attribute.mDivisor > 0) ? (std::max(instanceCount, 1) - 1) / attribute.mDivisor + 1
+                                                        : firstVertex + vertexCount;
+        size_t size = attribute.stride() * (elementCount - 1) + attribute.typeSize();
+
+        encoder->call(CAPTURE_CALL_CLIENT_VERTEX_ARRAY, attributeIndex, attribute.mSize, attribute.mType,
+                      static_cast<GLboolean>(attribute.mNormalized ? GL_TRUE : GL_FALSE),
+                      static_cast<GLboolean>(attribute.mPureInteger ? GL_TRUE : GL_FALSE),
+                      attribute.mStride, CaptureMemory(attribute.mPointer, size));
+    }
+}
+
+void CaptureClientVertexArrays(CaptureEncoder *encoder, GLsizei count, GLenum type, const GLvoid *indices, GLsizei instanceCount)
+{
+    Context *context = getContext();
+    if (!context || count <= 0 || IndexBytes(type) == 0 || !HasClientVertexArrays(context))
+    {
+        return;
+    }
+
+    const unsigned char *indexData = static_cast<const unsigned char*>(indices);
+
+    Buffer *elementArrayBuffer = context->getElementArrayBuffer();
+    if (elementArrayBuffer)
+    {
+        uintptr_t offset = reinterpret_cast<uintptr_t>(indices);
+        if (offset + count * IndexBytes(type) > static_cast<uintptr_t>(elementArrayBuffer->size()))
+        {
+            return;
+        }
+
+        indexData = static_cast<const unsigned char*>(elementArrayBuffer->getStorage()->getData()) + offset;
+    }
+
+    if (!indexData)
+    {
+        return;
+    }
+
+    GLuint maxIndex = 0;
+    switch (type)
+    {
+      case GL_UNSIGNED_BYTE:  maxIndex = MaxIndex(reinterpret_cast<const GLubyte*>(indexData), count);  break;
+      case GL_UNSIGNED_SHORT: maxIndex = MaxIndex(reinterpret_cast<const GLushort*>(indexData), count); break;
+      case GL_UNSIGNED_INT:   maxIndex = MaxIndex(reinterpret_cast<const GLuint*>(indexData), count);   break;
+      default: UNREACHABLE();
+    }
+
+    CaptureClientVertexArrays(encoder, 0, maxIndex + 1, instanceCount);
+}
+
+}
@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// Capture.h: Defines gl::Capture, an opt-in recorder of the calls made to the libGLESv2 entry
+// points, and the CAPTURE macros the entry points use. The stream can be replayed with the
+// gl_replay sample to benchmark the CPU cost of the calls independently of the application.
+
+#ifndef LIBGLESV2_CAPTURE_H_
+#define LIBGLESV2_CAPTURE_H_
+
+#include <stdio.h>
+
+#include "common/angleutils.h"
+#include "libGLESv2/CaptureEncoder.h"
+#include "libGLESv2/DeferredContext.h"
+
+namespace gl
+{
+
+// The client vertex arrays a draw reads, which are only known once the draw is validated
+struct CaptureDraw
+{
+    CaptureDraw(GLint first, GLsizei count, GLsizei instanceCount)
+        : first(first), count(count), type(GL_NONE), indices(NULL), instanceCount(instanceCount) {}
+    CaptureDraw(GLsizei count, GLenum type, const GLvoid *indices, GLsizei instanceCount)
+        : first(0), count(count), type(type), indices(indices), instanceCount(instanceCount) {}
+
+    GLint first;
+    GLsizei count;
+    GLenum type;
+    const GLvoid *indices;
+    GLsizei instanceCount;
+};
+
+class Capture
+{
+  public:
+    explicit Capture(FILE *file);
+    ~Capture();
+
+    // Enables the process-wide recorder if the ANGLE_CAPTURE_FILE environment variable is set
+    // to the path of the stream to write. Called when the library is loaded, before any thread
+    // can make calls.
+    static void initializeInstance();
+    static void releaseInstance();
+
+    // Returns the process-wide recorder, or NULL unless it was enabled
+    static Capture *getInstance() { return mInstance; }
+
+    // Calls are recorded one at a time, in the order they are made. Returns NULL for calls
+    // made by another entry point, only the outermost call is recorded. The memory a call
+    // reads is only copied once it returns without raising an error, and calls which raised
+    // one are dropped.
+    CaptureEncoder *beginCall();
+    void endCall(const CaptureDraw *draw);
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Capture);
+
+    void flush();
+
+    FILE *mFile;
+    CaptureEncoder mEncoder;
+    CaptureEncoder mDrawEncoder;
+    CRITICAL_SECTION mLock;
+    unsigned int mDepth;
+    bool mHeaderWritten;
+
+    bool mCallRecorded;
+    size_t mCallStart;
+    unsigned int mCallErrorCount;
+
+    unsigned int mCalls;
+    unsigned long long mBytesWritten;
+
+    static Capture *mInstance;
+};
+
+class CaptureScope
+{
+  public:
+    explicit CaptureScope(const CaptureDraw *draw = NULL)
+        : mCapture(Capture::getInstance()),
+          mEncoder(mCapture ? mCapture->beginCall() : NULL),
+          mDraw(draw)
+    {
+    }
+
+    ~CaptureScope()
+    {
+        if (mCapture)
+        {
+            mCapture->endCall(mDraw);
+        }
+    }
+
+    CaptureEncoder *getEncoder() const { return mEncoder; }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CaptureScope);
+
+    Capture *mCapture;
+    CaptureEncoder *mEncoder;
+    const CaptureDraw *mDraw;
+};
+
+// Pixels read by texture uploads, or an offset into the pixel unpack buffer
+CapturePointer CaptureUnpackPixels(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid *pixels);
+
+// Compressed texture data, or an offset into the pixel unpack buffer
+CapturePointer CaptureCompressedPixels(GLsizei imageSize, const GLvoid *data);
+
+// Pixels written by glReadPixels, or an offset into the pixel pack buffer
+CapturePointer CapturePackPixels(GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels);
+
+// Client indices, or an offset into the element array buffer
+CapturePointer CaptureIndices(GLsizei count, GLenum type, const GLvoid *indices);
+
+// Records the vertices which a draw reads from the enabled client vertex arrays
+void CaptureClientVertexArrays(CaptureEncoder *encoder, GLint firstVertex, GLsizei vertexCount, GLsizei instanceCount);
+void CaptureClientVertexArrays(CaptureEncoder *encoder, GLsizei count, GLenum type, const GLvoid *indices, GLsizei instanceCount);
+
+}
+
+// Queues the call to the current deferred context and returns, unless it has to execute
+// inline. Calls queued are recorded when the submission thread executes them.
+#define DEFER_CALL(function, ...) \
+    gl::DeferredScope deferredScope(gl::IsDeferrableCall(function)); \
+    if (gl::CaptureEncoder *deferredEncoder = deferredScope.getEncoder()) \
+    { \
+        deferredEncoder->call(gl::CAPTURE_CALL_ ## function, ##__VA_ARGS__); \
+        if (deferredScope.queue()) \
+        { \
+            return gl::DeferredReturnValue(function); \
+        } \
+    }
+
+// Records the call to the entry point with its arguments. The scope lasts until the entry
+// point returns, which keeps calls made on other threads from interleaving with it.
+#define CAPTURE(function, ...) \
+    DEFER_CALL(function, ##__VA_ARGS__) \
+    gl::CaptureScope captureScope; \
+    if (gl::CaptureEncoder *captureEncoder = captureScope.getEncoder()) \
+        captureEncoder->call(gl::CAPTURE_CALL_ ## function, ##__VA_ARGS__)
+
+// Draws reading client vertex arrays execute inline, so only recorded draws copy vertices
+#define CAPTURE_DRAW_ARRAYS(function, first, count, instanceCount, ...) \
+    DEFER_CALL(function, __VA_ARGS__) \
+    gl::CaptureDraw captureDraw(first, count, instanceCount); \
+    gl::CaptureScope captureScope(&captureDraw); \
+    if (gl::CaptureEncoder *captureEncoder = captureScope.getEncoder()) \
+        captureEncoder->call(gl::CAPTURE_CALL_ ## function, __VA_ARGS__)
+
+#define CAPTURE_DRAW_ELEMENTS(function, count, type, indices, instanceCount, ...) \
+    DEFER_CALL(function, __VA_ARGS__) \
+    gl::CaptureDraw captureDraw(count, type, indices, instanceCount); \
+    gl::CaptureScope captureScope(&captureDraw); \
+    if (gl::CaptureEncoder *captureEncoder = captureScope.getEncoder()) \
+        captureEncoder->call(gl::CAPTURE_CALL_ ## function, __VA_ARGS__)
+
+#endif   // LIBGLESV2_CAPTURE_H_
@@ -0,0 +1,463 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CaptureDecoder.h: Defines gl::CaptureDecoder, which walks the calls of a stream written
+// by gl::CaptureEncoder, and ReplayCall, which invokes an entry point with the arguments of
+// the current call converted back to the entry point's parameter types.
+
+#ifndef LIBGLESV2_CAPTUREDECODER_H_
+#define LIBGLESV2_CAPTUREDECODER_H_
+
+#include <GLES3/gl3.h>
+#include <GLES2/gl2.h>
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "libGLESv2/CaptureFormat.h"
+
+namespace gl
+{
+
+struct CaptureDecodedArgument
+{
+    CaptureArgumentTag tag;
+    unsigned long long value;
+    const unsigned char *data;
+};
+
+class CaptureDecoder;
+
+template <typename T>
+struct CaptureArgumentTraits
+{
+    static T get(CaptureDecoder *decoder, size_t index);
+};
+
+template <typename T>
+struct CaptureArgumentTraits<T*>
+{
+    static T *get(CaptureDecoder *decoder, size_t index);
+};
+
+template <>
+struct CaptureArgumentTraits<GLfloat>
+{
+    static GLfloat get(CaptureDecoder *decoder, size_t index);
+};
+
+template <>
+struct CaptureArgumentTraits<GLsync>
+{
+    static GLsync get(CaptureDecoder *decoder, size_t index);
+};
+
+class CaptureDecoder
+{
+  public:
+    CaptureDecoder() : mData(NULL), mSize(0), mOffset(0), mMalformed(false) {}
+
+    // The stream must outlive the decoder, memory arguments point into it
+    bool open(const void *data, size_t size)
+    {
+        mData = static_cast<const unsigned char*>(data);
+        mSize = size;
+        mOffset = sizeof(mHeader);
+        mMalformed = false;
+
+        if (size < sizeof(mHeader))
+        {
+            return false;
+        }
+
+        memcpy(&mHeader, data, sizeof(mHeader));
+        return mHeader.magic == CaptureMagic && mHeader.version == CaptureVersion;
+    }
+
+    // Opens calls written by a CaptureEncoder, without the header of a capture file
+    void openCalls(const void *data, size_t size)
+    {
+        mData = static_cast<const unsigned char*>(data);
+        mSize = size;
+        mOffset = 0;
+        mMalformed = false;
+    }
+
+    const CaptureFileHeader &getHeader() const { return mHeader; }
+
+    // Moves to the next call. Returns false at the end of the stream or if it is malformed.
+    bool next()
+    {
+        mArguments.clear();
+
+        if (mOffset == mSize || mMalformed)
+        {
+            return false;
+        }
+
+        CaptureCallHeader header;
+        if (mSize - mOffset < sizeof(header))
+        {
+            return fail();
+        }
+        memcpy(&header, mData + mOffset, sizeof(header));
+        mOffset += sizeof(header);
+
+        if (header.id >= CAPTURE_CALL_COUNT || header.byteCount > mSize - mOffset)
+        {
+            return fail();
+        }
+        mCallId = static_cast<CaptureCallId>(header.id);
+
+        size_t end = mOffset + static_cast<size_t>(header.byteCount);
+        for (unsigned int argument = 0; argument < header.argumentCount; argument++)
+        {
+            if (!readArgument(end))
+            {
+                return fail();
+            }
+        }
+
+        if (mOffset != end)
+        {
+            return fail();
+        }
+
+        return true;
+    }
+
+    bool isMalformed() const { return mMalformed; }
+
+    CaptureCallId getCallId() const { return mCallId; }
+    size_t getArgumentCount() const { return mArguments.size(); }
+    const CaptureDecodedArgument &getArgument(size_t index) const { return mArguments[index]; }
+
+    template <typename T>
+    T argument(size_t index) { return CaptureArgumentTraits<T>::get(this, index); }
+
+    // Memory handed to the entry point for an argument it writes to
+    void *getOutput(size_t index, unsigned long long size)
+    {
+        // Outputs of unknown size are bounded by the largest GL state query
+        const size_t minimumSize = 4096;
+
+        if (mOutputs.size() <= index)
+        {
+            mOutputs.resize(index + 1);
+        }
+
+        std::vector<unsigned char> &output = mOutputs[index];
+        output.resize(std::max(output.size(), std::max(static_cast<size_t>(size), minimumSize)));
+        return &output[0];
+    }
+
+    // The array of pointers to the strings of an argument, each null-terminated
+    const GLchar *const *getStrings(size_t index)
+    {
+        const CaptureDecodedArgument &argument = mArguments[index];
+
+        if (mStrings.size() <= index)
+        {
+            mStrings.resize(index + 1);
+            mStringPointers.resize(index + 1);
+        }
+
+        std::vector<char> &storage = mStrings[index];
+        std::vector<const GLchar*> &pointers = mStringPointers[index];
+        storage.clear();
+        pointers.clear();
+
+        std::vector<size_t> starts;
+        const unsigned char *data = argument.data;
+        for (unsigned long long string = 0; string < argument.value; string++)
+        {
+            unsigned long long length;
+            memcpy(&length, data, sizeof(length));
+            data += sizeof(length);
+
+            starts.push_back(storage.size());
+            storage.insert(storage.end(), data, data + length);
+            storage.push_back('\0');
+            data += CapturePaddedSize(length);
+        }
+
+        for (size_t string = 0; string < starts.size(); string++)
+        {
+            pointers.push_back(&storage[starts[string]]);
+        }
+        pointers.push_back(NULL);
+
+        return &pointers[0];
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CaptureDecoder);
+
+    bool fail()
+    {
+        mMalformed = true;
+        mArguments.clear();
+        return false;
+    }
+
+    bool readArgument(size_t end)
+    {
+        CaptureArgumentHeader header;
+        if (end - mOffset < sizeof(header))
+        {
+            return false;
+        }
+        memcpy(&header, mData + mOffset, sizeof(header));
+        mOffset += sizeof(header);
+
+        CaptureDecodedArgument argument;
+        argument.tag = static_cast<CaptureArgumentTag>(header.tag);
+        argument.value = header.value;
+        argument.data = mData + mOffset;
+
+        switch (header.tag)
+        {
+          case CAPTURE_ARGUMENT_VALUE:
+          case CAPTURE_ARGUMENT_NULL:
+          case CAPTURE_ARGUMENT_OUTPUT:
+            break;
+          case CAPTURE_ARGUMENT_MEMORY:
+            if (CapturePaddedSize(header.value) > end - mOffset)
+            {
+                return false;
+            }
+            mOffset += static_cast<size_t>(CapturePaddedSize(header.value));
+            break;
+          case CAPTURE_ARGUMENT_STRINGS:
+            for (unsigned long long string = 0; string < header.value; string++)
+            {
+                unsigned long long length;
+                if (end - mOffset < sizeof(length))
+                {
+                    return false;
+                }
+                memcpy(&length, mData + mOffset, sizeof(length));
+                mOffset += sizeof(length);
+
+                if (CapturePaddedSize(length) > end - mOffset)
+                {
+                    return false;
+                }
+                mOffset += static_cast<size_t>(CapturePaddedSize(length));
+            }
+            break;
+          default:
+            return false;
+        }
+
+        mArguments.push_back(argument);
+        return true;
+    }
+
+    const unsigned char *mData;
+    size_t mSize;
+    size_t mOffset;
+    bool mMalformed;
+
+    CaptureFileHeader mHeader;
+    CaptureCallId mCallId;
+    std::vector<CaptureDecodedArgument> mArguments;
+
+    std::vector<std::vector<unsigned char> > mOutputs;
+    std::vector<std::vector<char> > mStrings;
+    std::vector<std::vector<const GLchar*> > mStringPointers;
+};
+
+template <typename T>
+T CaptureArgumentTraits<T>::get(CaptureDecoder *decoder, size_t index)
+{
+    return static_cast<T>(decoder->getArgument(index).value);
+}
+
+template <typename T>
+T *CaptureArgumentTraits<T*>::get(CaptureDecoder *decoder, size_t index)
+{
+    const CaptureDecodedArgument &argument = decoder->getArgument(index);
+
+    switch (argument.tag)
+    {
+      case CAPTURE_ARGUMENT_VALUE:
+        return reinterpret_cast<T*>(static_cast<size_t>(argument.value));
+      case CAPTURE_ARGUMENT_MEMORY:
+        return (T*)(argument.data);
+      case CAPTURE_ARGUMENT_STRINGS:
+        return (T*)(decoder->getStrings(index));
+      case CAPTURE_ARGUMENT_OUTPUT:
+        return (T*)(decoder->getOutput(index, argument.value));
+      default:
+        return NULL;
+    }
+}
+
+inline GLfloat CaptureArgumentTraits<GLfloat>::get(CaptureDecoder *decoder, size_t index)
+{
+    unsigned int bits = static_cast<unsigned int>(decoder->getArgument(index).value);
+    GLfloat value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline GLsync CaptureArgumentTraits<GLsync>::get(CaptureDecoder *decoder, size_t index)
+{
+    return reinterpret_cast<GLsync>(static_cast<size_t>(decoder->getArgument(index).value));
+}
+
+// Invokes the entry point with the arguments of the current call. Returns false if their
+// number does not match the entry point.
+template <typename R>
+bool ReplayCall(R (GL_APIENTRY *function)(), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 0)
+    {
+        return false;
+    }
+
+    function();
+    return true;
+}
+
+template <typename R, typename A1>
+bool ReplayCall(R (GL_APIENTRY *function)(A1), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 1)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0));
+    return true;
+}
+
+template <typename R, typename A1, typename A2>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 2)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 3)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 4)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 5)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 6)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6, A7), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 7)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5), decoder->argument<A7>(6));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6, A7, A8), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 8)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5), decoder->argument<A7>(6), decoder->argument<A8>(7));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6, A7, A8, A9), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 9)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5), decoder->argument<A7>(6), decoder->argument<A8>(7), decoder->argument<A9>(8));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 10)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5), decoder->argument<A7>(6), decoder->argument<A8>(7), decoder->argument<A9>(8), decoder->argument<A10>(9));
+    return true;
+}
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+bool ReplayCall(R (GL_APIENTRY *function)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11), CaptureDecoder *decoder)
+{
+    if (decoder->getArgumentCount() != 11)
+    {
+        return false;
+    }
+
+    function(decoder->argument<A1>(0), decoder->argument<A2>(1), decoder->argument<A3>(2), decoder->argument<A4>(3), decoder->argument<A5>(4), decoder->argument<A6>(5), decoder->argument<A7>(6), decoder->argument<A8>(7), decoder->argument<A9>(8), decoder->argument<A10>(9), decoder->argument<A11>(10));
+    return true;
+}
+
+}
+
+#endif   // LIBGLESV2_CAPTUREDECODER_H_
@@ -0,0 +1,443 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CaptureEncoder.h: Defines gl::CaptureEncoder, which serializes GL calls into the stream
+// format of CaptureFormat.h. Arguments are encoded by their type: integers, enums and floats
+// by value, const pointers as buffer offsets and other pointers as outputs. Client memory read
+// by a call has to be wrapped by the caller, since only the entry point knows its size.
+// The sizes are worked out from arguments which are not validated yet, so the encoder can be
+// made to only read client memory and strings once the call is known to be valid, see commit.
+
+#ifndef LIBGLESV2_CAPTUREENCODER_H_
+#define LIBGLESV2_CAPTUREENCODER_H_
+
+#include <GLES3/gl3.h>
+#include <GLES2/gl2.h>
+
+#include <string.h>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+#include "libGLESv2/CaptureFormat.h"
+
+namespace gl
+{
+
+// Client memory, an output or a buffer offset, see CaptureMemory, CaptureOutput and CaptureOffset
+struct CapturePointer
+{
+    CapturePointer(CaptureArgumentTag tag, const void *data, size_t size) : tag(tag), data(data), size(size) {}
+
+    CaptureArgumentTag tag;
+    const void *data;
+    size_t size;
+};
+
+inline CapturePointer CaptureMemory(const void *data, size_t size)
+{
+    return CapturePointer(CAPTURE_ARGUMENT_MEMORY, data, size);
+}
+
+// Outputs without a size get enough memory on replay for any state query
+inline CapturePointer CaptureOutput(void *pointer, size_t size)
+{
+    return CapturePointer(CAPTURE_ARGUMENT_OUTPUT, pointer, size);
+}
+
+// Pointers into the buffer bound to the target the call reads or writes
+inline CapturePointer CaptureOffset(const void *offset)
+{
+    return CapturePointer(CAPTURE_ARGUMENT_VALUE, offset, 0);
+}
+
+struct CaptureStrings
+{
+    // Lengths may be NULL, and negative lengths mean the string is null-terminated
+    CaptureStrings(GLsizei count, const GLchar *const *strings, const GLint *lengths)
+        : count(count), strings(strings), lengths(lengths) {}
+
+    GLsizei count;
+    const GLchar *const *strings;
+    const GLint *lengths;
+};
+
+template <typename T>
+CapturePointer CaptureArray(const T *values, GLsizei count)
+{
+    return CaptureMemory(values, (values && count > 0) ? count * sizeof(T) : 0);
+}
+
+// The size of memory holding a null-terminated string, which is measured when it is read
+const size_t CaptureStringSize = static_cast<size_t>(-1);
+
+inline CapturePointer CaptureString(const GLchar *string)
+{
+    return CaptureMemory(string, CaptureStringSize);
+}
+
+class CaptureEncoder;
+
+template <typename T>
+struct CaptureValueTraits
+{
+    static void add(CaptureEncoder *encoder, const T &value);
+};
+
+template <typename T>
+struct CaptureValueTraits<const T*>
+{
+    static void add(CaptureEncoder *encoder, const T *pointer);
+};
+
+template <typename T>
+struct CaptureValueTraits<T*>
+{
+    static void add(CaptureEncoder *encoder, T *pointer);
+};
+
+template <>
+struct CaptureValueTraits<GLsync>
+{
+    static void add(CaptureEncoder *encoder, GLsync sync);
+};
+
+class CaptureEncoder
+{
+  public:
+    CaptureEncoder() : mCallStart(0), mDeferClientMemory(false) {}
+
+    void call(CaptureCallId id)
+    {
+        begin(id, 0);
+        end();
+    }
+
+    template <typename A1>
+    void call(CaptureCallId id, const A1 &a1)
+    {
+        begin(id, 1); add(a1);
+        end();
+    }
+
+    template <typename A1, typename A2>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2)
+    {
+        begin(id, 2); add(a1); add(a2);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3)
+    {
+        begin(id, 3); add(a1); add(a2); add(a3);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
+    {
+        begin(id, 4); add(a1); add(a2); add(a3); add(a4);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5)
+    {
+        begin(id, 5); add(a1); add(a2); add(a3); add(a4); add(a5);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6)
+    {
+        begin(id, 6); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7)
+    {
+        begin(id, 7); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6); add(a7);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8)
+    {
+        begin(id, 8); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6); add(a7); add(a8);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8, const A9 &a9)
+    {
+        begin(id, 9); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6); add(a7); add(a8); add(a9);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8, const A9 &a9, const A10 &a10)
+    {
+        begin(id, 10); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6); add(a7); add(a8); add(a9); add(a10);
+        end();
+    }
+
+    template <typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+    void call(CaptureCallId id, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4, const A5 &a5, const A6 &a6, const A7 &a7, const A8 &a8, const A9 &a9, const A10 &a10, const A11 &a11)
+    {
+        begin(id, 11); add(a1); add(a2); add(a3); add(a4); add(a5); add(a6); add(a7); add(a8); add(a9); add(a10); add(a11);
+        end();
+    }
+
+    // Appends one argument to the current call
+    void addValue(unsigned long long value)
+    {
+        addHeader(CAPTURE_ARGUMENT_VALUE, value);
+    }
+
+    void addNull()
+    {
+        addHeader(CAPTURE_ARGUMENT_NULL, 0);
+    }
+
+    void addMemory(const void *data, size_t size)
+    {
+        if (!data)
+        {
+            return addNull();
+        }
+
+        if (mDeferClientMemory)
+        {
+            PendingArgument argument = { mCallStart, mData.size(), CAPTURE_ARGUMENT_MEMORY, data, size, NULL };
+            return mPendingArguments.push_back(argument);
+        }
+
+        if (size == CaptureStringSize)
+        {
+            size = strlen(static_cast<const char*>(data)) + 1;
+        }
+
+        addHeader(CAPTURE_ARGUMENT_MEMORY, size);
+        addBytes(data, size);
+    }
+
+    void addStrings(GLsizei count, const GLchar *const *strings, const GLint *lengths)
+    {
+        if (!strings || count < 0)
+        {
+            return addNull();
+        }
+
+        if (mDeferClientMemory)
+        {
+            PendingArgument argument = { mCallStart, mData.size(), CAPTURE_ARGUMENT_STRINGS, strings, static_cast<size_t>(count), lengths };
+            return mPendingArguments.push_back(argument);
+        }
+
+        addHeader(CAPTURE_ARGUMENT_STRINGS, count);
+        for (GLsizei index = 0; index < count; index++)
+        {
+            const GLchar *string = strings[index] ? strings[index] : "";
+            unsigned long long length = (lengths && lengths[index] >= 0) ? lengths[index] : strlen(string);
+            addWord(length);
+            addBytes(string, static_cast<size_t>(length));
+        }
+    }
+
+    void addOutput(const void *pointer, size_t size)
+    {
+        if (!pointer)
+        {
+            return addNull();
+        }
+
+        addHeader(CAPTURE_ARGUMENT_OUTPUT, size);
+    }
+
+    // While deferred, memory and string arguments are left out of the calls until committed
+    void setDeferClientMemory(bool defer) { mDeferClientMemory = defer; }
+
+    // Reads the memory and strings of the calls encoded since the last commit into them
+    void commit()
+    {
+        if (mPendingArguments.empty())
+        {
+            return;
+        }
+
+        size_t first = mPendingArguments[0].position;
+        std::vector<unsigned char> tail(mData.begin() + first, mData.end());
+        mData.resize(first);
+
+        bool defer = mDeferClientMemory;
+        mDeferClientMemory = false;
+
+        size_t copied = first;
+        for (size_t index = 0; index < mPendingArguments.size(); index++)
+        {
+            const PendingArgument &argument = mPendingArguments[index];
+            mData.insert(mData.end(), tail.begin() + (copied - first), tail.begin() + (argument.position - first));
+            copied = argument.position;
+
+            size_t argumentStart = mData.size();
+            if (argument.tag == CAPTURE_ARGUMENT_MEMORY)
+            {
+                addMemory(argument.data, argument.size);
+            }
+            else
+            {
+                addStrings(static_cast<GLsizei>(argument.size), static_cast<const GLchar *const *>(argument.data), argument.lengths);
+            }
+
+            // Arguments inserted before the call header moved it
+            size_t callStart = argument.callStart;
+            for (size_t previous = 0; previous < index && mPendingArguments[previous].position <= argument.callStart; previous++)
+            {
+                callStart += mPendingArguments[previous].encodedSize;
+            }
+            mPendingArguments[index].encodedSize = mData.size() - argumentStart;
+
+            CaptureCallHeader header;
+            memcpy(&header, &mData[callStart], sizeof(header));
+            header.byteCount += mPendingArguments[index].encodedSize;
+            memcpy(&mData[callStart], &header, sizeof(header));
+        }
+        mData.insert(mData.end(), tail.begin() + (copied - first), tail.end());
+
+        mPendingArguments.clear();
+        mDeferClientMemory = defer;
+    }
+
+    // Inserts the committed calls of another encoder before the given size of the data
+    void insertCalls(size_t position, const CaptureEncoder &calls)
+    {
+        ASSERT(mPendingArguments.empty() && calls.mPendingArguments.empty());
+        mData.insert(mData.begin() + position, calls.mData.begin(), calls.mData.end());
+    }
+
+    // Drops the calls encoded from the given size of the data on, which are not committed yet
+    void rollback(size_t size)
+    {
+        ASSERT(mPendingArguments.empty() || mPendingArguments[0].position >= size);
+        mData.resize(size);
+        mPendingArguments.clear();
+    }
+
+    const std::vector<unsigned char> &getData() const { return mData; }
+    void clear() { mData.clear(); }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CaptureEncoder);
+
+    template <typename T>
+    void add(const T &value) { CaptureValueTraits<T>::add(this, value); }
+
+    void add(GLfloat value)
+    {
+        unsigned int bits;
+        memcpy(&bits, &value, sizeof(bits));
+        addValue(bits);
+    }
+
+    void add(const CapturePointer &pointer)
+    {
+        switch (pointer.tag)
+        {
+          case CAPTURE_ARGUMENT_MEMORY: addMemory(pointer.data, pointer.size);                  break;
+          case CAPTURE_ARGUMENT_OUTPUT: addOutput(pointer.data, pointer.size);                  break;
+          default:                      addValue(reinterpret_cast<size_t>(pointer.data));       break;
+        }
+    }
+
+    void add(const CaptureStrings &strings) { addStrings(strings.count, strings.strings, strings.lengths); }
+
+    void begin(CaptureCallId id, unsigned int argumentCount)
+    {
+        mCallStart = mData.size();
+
+        CaptureCallHeader header = { id, argumentCount, 0 };
+        addBytes(&header, sizeof(header));
+    }
+
+    void end()
+    {
+        CaptureCallHeader header;
+        memcpy(&header, &mData[mCallStart], sizeof(header));
+        header.byteCount = mData.size() - mCallStart - sizeof(header);
+        memcpy(&mData[mCallStart], &header, sizeof(header));
+    }
+
+    void addHeader(CaptureArgumentTag tag, unsigned long long value)
+    {
+        CaptureArgumentHeader header = { tag, 0, value };
+        addBytes(&header, sizeof(header));
+    }
+
+    void addWord(unsigned long long word)
+    {
+        addBytes(&word, sizeof(word));
+    }
+
+    // Pads to a multiple of 8 bytes
+    void addBytes(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char*>(data);
+        mData.insert(mData.end(), bytes, bytes + size);
+        mData.resize(mData.size() + static_cast<size_t>(CapturePaddedSize(size) - size), 0);
+    }
+
+    struct PendingArgument
+    {
+        size_t callStart;
+        size_t position;
+        CaptureArgumentTag tag;
+        const void *data;
+        size_t size;
+        const GLint *lengths;
+        size_t encodedSize;
+    };
+
+    std::vector<unsigned char> mData;
+    size_t mCallStart;
+    bool mDeferClientMemory;
+    std::vector<PendingArgument> mPendingArguments;
+};
+
+template <typename T>
+void CaptureValueTraits<T>::add(CaptureEncoder *encoder, const T &value)
+{
+    encoder->addValue(static_cast<unsigned long long>(value));
+}
+
+template <typename T>
+void CaptureValueTraits<const T*>::add(CaptureEncoder *encoder, const T *pointer)
+{
+    if (pointer)
+    {
+        encoder->addValue(reinterpret_cast<size_t>(pointer));
+    }
+    else
+    {
+        encoder->addNull();
+    }
+}
+
+template <typename T>
+void CaptureValueTraits<T*>::add(CaptureEncoder *encoder, T *pointer)
+{
+    encoder->addOutput(pointer, 0);
+}
+
+inline void CaptureValueTraits<GLsync>::add(CaptureEncoder *encoder, GLsync sync)
+{
+    encoder->addValue(reinterpret_cast<size_t>(sync));
+}
+
+}
+
+#endif   // LIBGLESV2_CAPTUREENCODER_H_
@@ -0,0 +1,363 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CaptureFormat.h: Defines the layout of the GL call streams written by gl::Capture and
+// replayed by the gl_replay sample. A stream is a CaptureFileHeader followed by calls. Each
+// call is a CaptureCallHeader followed by its arguments, in the order of the entry point's
+// parameters. All fields are little-endian and every record is a multiple of 8 bytes long.
+
+#ifndef LIBGLESV2_CAPTUREFORMAT_H_
+#define LIBGLESV2_CAPTUREFORMAT_H_
+
+namespace gl
+{
+
+const unsigned int CaptureMagic = 0x43474C41;   // "ALGC"
+const unsigned int CaptureVersion = 1;
+
+struct CaptureFileHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int clientVersion;
+    unsigned int reserved;
+};
+
+struct CaptureCallHeader
+{
+    unsigned int id;
+    unsigned int argumentCount;
+    unsigned long long byteCount;   // Of the arguments which follow
+};
+
+enum CaptureArgumentTag
+{
+    // Integers, enums, floats stored as their bits, and pointers which are buffer offsets
+    CAPTURE_ARGUMENT_VALUE,
+    CAPTURE_ARGUMENT_NULL,
+
+    // Client memory read by the call. The value is the byte count, the bytes follow.
+    CAPTURE_ARGUMENT_MEMORY,
+
+    // An array of strings. The value is the string count, each string follows as its length
+    // and its characters without a terminator.
+    CAPTURE_ARGUMENT_STRINGS,
+
+    // Client memory written by the call. The value is the byte count it may write, at least.
+    CAPTURE_ARGUMENT_OUTPUT,
+};
+
+struct CaptureArgumentHeader
+{
+    unsigned int tag;
+    unsigned int reserved;
+    unsigned long long value;
+};
+
+inline unsigned long long CapturePaddedSize(unsigned long long size)
+{
+    return (size + 7) & ~7ULL;
+}
+
+// Every exported GL entry point, in the order of libGLESv2.cpp. Call ids index this list, so
+// new entry points are appended and CaptureVersion bumped when it is reordered.
+#define ANGLE_CAPTURE_ENTRY_POINTS(OP) \
+    OP(glActiveTexture)                        \
+    OP(glAttachShader)                         \
+    OP(glBeginQueryEXT)                        \
+    OP(glBindAttribLocation)                   \
+    OP(glBindBuffer)                           \
+    OP(glBindFramebuffer)                      \
+    OP(glBindRenderbuffer)                     \
+    OP(glBindTexture)                          \
+    OP(glBlendColor)                           \
+    OP(glBlendEquation)                        \
+    OP(glBlendEquationSeparate)                \
+    OP(glBlendFunc)                            \
+    OP(glBlendFuncSeparate)                    \
+    OP(glBufferData)                           \
+    OP(glBufferSubData)                        \
+    OP(glCheckFramebufferStatus)               \
+    OP(glClear)                                \
+    OP(glClearColor)                           \
+    OP(glClearDepthf)                          \
+    OP(glClearStencil)                         \
+    OP(glColorMask)                            \
+    OP(glCompileShader)                        \
+    OP(glCompressedTexImage2D)                 \
+    OP(glCompressedTexSubImage2D)              \
+    OP(glCopyTexImage2D)                       \
+    OP(glCopyTexSubImage2D)                    \
+    OP(glCreateProgram)                        \
+    OP(glCreateShader)                         \
+    OP(glCullFace)                             \
+    OP(glDeleteBuffers)                        \
+    OP(glDeleteFencesNV)                       \
+    OP(glDeleteFramebuffers)                   \
+    OP(glDeleteProgram)                        \
+    OP(glDeleteQueriesEXT)                     \
+    OP(glDeleteRenderbuffers)                  \
+    OP(glDeleteShader)                         \
+    OP(glDeleteTextures)                       \
+    OP(glDepthFunc)                            \
+    OP(glDepthMask)                            \
+    OP(glDepthRangef)                          \
+    OP(glDetachShader)                         \
+    OP(glDisable)                              \
+    OP(glDisableVertexAttribArray)             \
+    OP(glDrawArrays)                           \
+    OP(glDrawArraysInstancedANGLE)             \
+    OP(glDrawElements)                         \
+    OP(glDrawElementsInstancedANGLE)           \
+    OP(glEnable)                               \
+    OP(glEnableVertexAttribArray)              \
+    OP(glEndQueryEXT)                          \
+    OP(glFinishFenceNV)                        \
+    OP(glFinish)                               \
+    OP(glFlush)                                \
+    OP(glFramebufferRenderbuffer)              \
+    OP(glFramebufferTexture2D)                 \
+    OP(glFrontFace)                            \
+    OP(glGenBuffers)                           \
+    OP(glGenerateMipmap)                       \
+    OP(glGenFencesNV)                          \
+    OP(glGenFramebuffers)                      \
+    OP(glGenQueriesEXT)                        \
+    OP(glGenRenderbuffers)                     \
+    OP(glGenTextures)                          \
+    OP(glGetActiveAttrib)                      \
+    OP(glGetActiveUniform)                     \
+    OP(glGetAttachedShaders)                   \
+    OP(glGetAttribLocation)                    \
+    OP(glGetBooleanv)                          \
+    OP(glGetBufferParameteriv)                 \
+    OP(glGetError)                             \
+    OP(glGetFenceivNV)                         \
+    OP(glGetFloatv)                            \
+    OP(glGetFramebufferAttachmentParameteriv)  \
+    OP(glGetGraphicsResetStatusEXT)            \
+    OP(glGetIntegerv)                          \
+    OP(glGetProgramiv)                         \
+    OP(glGetProgramInfoLog)                    \
+    OP(glGetQueryivEXT)                        \
+    OP(glGetQueryObjectuivEXT)                 \
+    OP(glGetRenderbufferParameteriv)           \
+    OP(glGetShaderiv)                          \
+    OP(glGetShaderInfoLog)                     \
+    OP(glGetShaderPrecisionFormat)             \
+    OP(glGetShaderSource)                      \
+    OP(glGetTranslatedShaderSourceANGLE)       \
+    OP(glGetString)                            \
+    OP(glGetTexParameterfv)                    \
+    OP(glGetTexParameteriv)                    \
+    OP(glGetnUniformfvEXT)                     \
+    OP(glGetUniformfv)                         \
+    OP(glGetnUniformivEXT)                     \
+    OP(glGetUniformiv)                         \
+    OP(glGetUniformLocation)                   \
+    OP(glGetVertexAttribfv)                    \
+    OP(glGetVertexAttribiv)                    \
+    OP(glGetVertexAttribPointerv)              \
+    OP(glHint)                                 \
+    OP(glIsBuffer)                             \
+    OP(glIsEnabled)                            \
+    OP(glIsFenceNV)                            \
+    OP(glIsFramebuffer)                        \
+    OP(glIsProgram)                            \
+    OP(glIsQueryEXT)                           \
+    OP(glIsRenderbuffer)                       \
+    OP(glIsShader)                             \
+    OP(glIsTexture)                            \
+    OP(glLineWidth)                            \
+    OP(glLinkProgram)                          \
+    OP(glPixelStorei)                          \
+    OP(glPolygonOffset)                        \
+    OP(glReadnPixelsEXT)                       \
+    OP(glReadPixels)                           \
+    OP(glReleaseShaderCompiler)                \
+    OP(glRenderbufferStorageMultisampleANGLE)  \
+    OP(glRenderbufferStorage)                  \
+    OP(glSampleCoverage)                       \
+    OP(glSetFenceNV)                           \
+    OP(glScissor)                              \
+    OP(glShaderBinary)                         \
+    OP(glShaderSource)                         \
+    OP(glStencilFunc)                          \
+    OP(glStencilFuncSeparate)                  \
+    OP(glStencilMask)                          \
+    OP(glStencilMaskSeparate)                  \
+    OP(glStencilOp)                            \
+    OP(glStencilOpSeparate)                    \
+    OP(glTestFenceNV)                          \
+    OP(glTexImage2D)                           \
+    OP(glTexParameterf)                        \
+    OP(glTexParameterfv)                       \
+    OP(glTexParameteri)                        \
+    OP(glTexParameteriv)                       \
+    OP(glTexStorage2DEXT)                      \
+    OP(glTexSubImage2D)                        \
+    OP(glUniform1f)                            \
+    OP(glUniform1fv)                           \
+    OP(glUniform1i)                            \
+    OP(glUniform1iv)                           \
+    OP(glUniform2f)                            \
+    OP(glUniform2fv)                           \
+    OP(glUniform2i)                            \
+    OP(glUniform2iv)                           \
+    OP(glUniform3f)                            \
+    OP(glUniform3fv)                           \
+    OP(glUniform3i)                            \
+    OP(glUniform3iv)                           \
+    OP(glUniform4f)                            \
+    OP(glUniform4fv)                           \
+    OP(glUniform4i)                            \
+    OP(glUniform4iv)                           \
+    OP(glUniformMatrix2fv)                     \
+    OP(glUniformMatrix3fv)                     \
+    OP(glUniformMatrix4fv)                     \
+    OP(glUseProgram)                           \
+    OP(glValidateProgram)                      \
+    OP(glVertexAttrib1f)                       \
+    OP(glVertexAttrib1fv)                      \
+    OP(glVertexAttrib2f)                       \
+    OP(glVertexAttrib2fv)                      \
+    OP(glVertexAttrib3f)                       \
+    OP(glVertexAttrib3fv)                      \
+    OP(glVertexAttrib4f)                       \
+    OP(glVertexAttrib4fv)                      \
+    OP(glVertexAttribDivisorANGLE)             \
+    OP(glVertexAttribPointer)                  \
+    OP(glViewport)                             \
+    OP(glReadBuffer)                           \
+    OP(glDrawRangeElements)                    \
+    OP(glTexImage3D)                           \
+    OP(glTexSubImage3D)                        \
+    OP(glCopyTexSubImage3D)                    \
+    OP(glCompressedTexImage3D)                 \
+    OP(glCompressedTexSubImage3D)              \
+    OP(glGenQueries)                           \
+    OP(glDeleteQueries)                        \
+    OP(glIsQuery)                              \
+    OP(glBeginQuery)                           \
+    OP(glEndQuery)                             \
+    OP(glGetQueryiv)                           \
+    OP(glGetQueryObjectuiv)                    \
+    OP(glUnmapBuffer)                          \
+    OP(glGetBufferPointerv)                    \
+    OP(glDrawBuffers)                          \
+    OP(glUniformMatrix2x3fv)                   \
+    OP(glUniformMatrix3x2fv)                   \
+    OP(glUniformMatrix2x4fv)                   \
+    OP(glUniformMatrix4x2fv)                   \
+    OP(glUniformMatrix3x4fv)                   \
+    OP(glUniformMatrix4x3fv)                   \
+    OP(glBlitFramebuffer)                      \
+    OP(glRenderbufferStorageMultisample)       \
+    OP(glFramebufferTextureLayer)              \
+    OP(glMapBufferRange)                       \
+    OP(glFlushMappedBufferRange)               \
+    OP(glBindVertexArray)                      \
+    OP(glDeleteVertexArrays)                   \
+    OP(glGenVertexArrays)                      \
+    OP(glIsVertexArray)                        \
+    OP(glGetIntegeri_v)                        \
+    OP(glBeginTransformFeedback)               \
+    OP(glEndTransformFeedback)                 \
+    OP(glBindBufferRange)                      \
+    OP(glBindBufferBase)                       \
+    OP(glTransformFeedbackVaryings)            \
+    OP(glGetTransformFeedbackVarying)          \
+    OP(glVertexAttribIPointer)                 \
+    OP(glGetVertexAttribIiv)                   \
+    OP(glGetVertexAttribIuiv)                  \
+    OP(glVertexAttribI4i)                      \
+    OP(glVertexAttribI4ui)                     \
+    OP(glVertexAttribI4iv)                     \
+    OP(glVertexAttribI4uiv)                    \
+    OP(glGetUniformuiv)                        \
+    OP(glGetFragDataLocation)                  \
+    OP(glUniform1ui)                           \
+    OP(glUniform2ui)                           \
+    OP(glUniform3ui)                           \
+    OP(glUniform4ui)                           \
+    OP(glUniform1uiv)                          \
+    OP(glUniform2uiv)                          \
+    OP(glUniform3uiv)                          \
+    OP(glUniform4uiv)                          \
+    OP(glClearBufferiv)                        \
+    OP(glClearBufferuiv)                       \
+    OP(glClearBufferfv)                        \
+    OP(glClearBufferfi)                        \
+    OP(glGetStringi)                           \
+    OP(glCopyBufferSubData)                    \
+    OP(glGetUniformIndices)                    \
+    OP(glGetActiveUniformsiv)                  \
+    OP(glGetUniformBlockIndex)                 \
+    OP(glGetActiveUniformBlockiv)              \
+    OP(glGetActiveUniformBlockName)            \
+    OP(glUniformBlockBinding)                  \
+    OP(glDrawArraysInstanced)                  \
+    OP(glDrawElementsInstanced)                \
+    OP(glFenceSync)                            \
+    OP(glIsSync)                               \
+    OP(glDeleteSync)                           \
+    OP(glClientWaitSync)                       \
+    OP(glWaitSync)                             \
+    OP(glGetInteger64v)                        \
+    OP(glGetSynciv)                            \
+    OP(glGetInteger64i_v)                      \
+    OP(glGetBufferParameteri64v)               \
+    OP(glGenSamplers)                          \
+    OP(glDeleteSamplers)                       \
+    OP(glIsSampler)                            \
+    OP(glBindSampler)                          \
+    OP(glSamplerParameteri)                    \
+    OP(glSamplerParameteriv)                   \
+    OP(glSamplerParameterf)                    \
+    OP(glSamplerParameterfv)                   \
+    OP(glGetSamplerParameteriv)                \
+    OP(glGetSamplerParameterfv)                \
+    OP(glVertexAttribDivisor)                  \
+    OP(glBindTransformFeedback)                \
+    OP(glDeleteTransformFeedbacks)             \
+    OP(glGenTransformFeedbacks)                \
+    OP(glIsTransformFeedback)                  \
+    OP(glPauseTransformFeedback)               \
+    OP(glResumeTransformFeedback)              \
+    OP(glGetProgramBinary)                     \
+    OP(glProgramBinary)                        \
+    OP(glProgramParameteri)                    \
+    OP(glInvalidateFramebuffer)                \
+    OP(glInvalidateSubFramebuffer)             \
+    OP(glTexStorage2D)                         \
+    OP(glTexStorage3D)                         \
+    OP(glGetInternalformativ)                  \
+    OP(glBlitFramebufferANGLE)                 \
+    OP(glTexImage3DOES)                        \
+    OP(glGetProgramBinaryOES)                  \
+    OP(glProgramBinaryOES)                     \
+    OP(glDrawBuffersEXT)                       \
+    OP(glGetProfileCountersANGLE)              \
+    OP(glResetProfileCountersANGLE)
+
+enum CaptureCallId
+{
+#define ANGLE_CAPTURE_CALL_ID(function) CAPTURE_CALL_ ## function,
+    ANGLE_CAPTURE_ENTRY_POINTS(ANGLE_CAPTURE_CALL_ID)
+#undef ANGLE_CAPTURE_CALL_ID
+
+    // Client vertex arrays are read at draw time rather than by glVertexAttribPointer. Draw
+    // calls are preceded by one of these per client array with the vertices they read:
+    // (GLuint index, GLint size, GLenum type, GLboolean normalized, GLboolean pureInteger,
+    //  GLsizei stride, memory)
+    CAPTURE_CALL_CLIENT_VERTEX_ARRAY,
+
+    CAPTURE_CALL_COUNT
+};
+
+}
+
+#endif   // LIBGLESV2_CAPTUREFORMAT_H_
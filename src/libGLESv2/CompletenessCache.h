@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CompletenessCache.h: Defines gl::CompletenessCache, which remembers whether a texture was
+// complete for the sampler state it was last sampled with. Textures invalidate it when
+// their images or sampling parameters change, and sampler objects take a new state serial
+// when their state changes, so draws only recompute completeness after a change.
+
+#ifndef LIBGLESV2_COMPLETENESSCACHE_H_
+#define LIBGLESV2_COMPLETENESSCACHE_H_
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+class CompletenessCache
+{
+  public:
+    CompletenessCache()
+        : mValid(false),
+          mSamplerSerial(0),
+          mClientVersion(0),
+          mComplete(false)
+    {
+    }
+
+    void invalidate()
+    {
+        mValid = false;
+    }
+
+    // Returns true if the result for the sampler state is cached, setting complete to it. A
+    // sampler serial of zero stands for the texture's own sampling parameters. Contexts of
+    // different client versions share textures and disagree on depth texture filtering.
+    bool get(unsigned int samplerSerial, int clientVersion, bool *complete) const
+    {
+        if (!mValid || mSamplerSerial != samplerSerial || mClientVersion != clientVersion)
+        {
+            return false;
+        }
+
+        *complete = mComplete;
+        return true;
+    }
+
+    void set(unsigned int samplerSerial, int clientVersion, bool complete)
+    {
+        mValid = true;
+        mSamplerSerial = samplerSerial;
+        mClientVersion = clientVersion;
+        mComplete = complete;
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CompletenessCache);
+
+    bool mValid;
+    unsigned int mSamplerSerial;
+    int mClientVersion;
+    bool mComplete;
+};
+
+}
+
+#endif   // LIBGLESV2_COMPLETENESSCACHE_H_
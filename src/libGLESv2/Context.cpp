@@ -14,6 +14,7 @@
 #include "common/utilities.h"
 #include "libGLESv2/formatutils.h"
 #include "libGLESv2/Buffer.h"
+#include "libGLESv2/DeferredContext.h"
 #include "libGLESv2/Fence.h"
 #include "libGLESv2/Framebuffer.h"
 #include "libGLESv2/Renderbuffer.h"
@@ -217,10 +218,25 @@ Context::Context(int clientVersion, const gl::Context *shareContext, rx::Rendere
     mSupportsEventQueries = false;
     mSupportsOcclusionQueries = false;
     mNumCompressedTextureFormats = 0;
+
+    mDirtyBits = DIRTY_BITS_ALL;
+    mAppliedStateSerial = 0;
+    mAppliedSamples = -1;
+
+    mDeferredContext = DeferredContext::isEnabled() ? new DeferredContext(this) : NULL;
 }
 
 Context::~Context()
 {
+    SafeDelete(mDeferredContext);
+
+    // Contexts can be destroyed on threads whose thread local data could not be allocated
+    ProfileCounters *profileCounters = getProfileCounters();
+    if (ProfileCountersEnabled() && profileCounters)
+    {
+        TraceProfileCounters(*profileCounters);
+    }
+
     if (mState.currentProgram != 0)
     {
         Program *programObject = mResourceManager->getProgram(mState.currentProgram);
@@ -232,24 +248,33 @@ Context::~Context()
     }
     mCurrentProgramBinary.set(NULL);
 
-    while (!mFramebufferMap.empty())
+    std::vector<GLuint> handles;
+
+    mFramebufferMap.getHandles(&handles);
+    for (size_t i = 0; i < handles.size(); i++)
     {
-        deleteFramebuffer(mFramebufferMap.begin()->first);
+        deleteFramebuffer(handles[i]);
     }
+    handles.clear();
 
-    while (!mFenceNVMap.empty())
+    mFenceNVMap.getHandles(&handles);
+    for (size_t i = 0; i < handles.size(); i++)
     {
-        deleteFenceNV(mFenceNVMap.begin()->first);
+        deleteFenceNV(handles[i]);
     }
+    handles.clear();
 
-    while (!mQueryMap.empty())
+    mQueryMap.getHandles(&handles);
+    for (size_t i = 0; i < handles.size(); i++)
     {
-        deleteQuery(mQueryMap.begin()->first);
+        deleteQuery(handles[i]);
     }
+    handles.clear();
 
-    while (!mVertexArrayMap.empty())
+    mVertexArrayMap.getHandles(&handles);
+    for (size_t i = 0; i < handles.size(); i++)
     {
-        deleteVertexArray(mVertexArrayMap.begin()->first);
+        deleteVertexArray(handles[i]);
     }
 
     for (int type = 0; type < TEXTURE_TYPE_COUNT; type++)
@@ -410,6 +435,17 @@ bool Context::isContextLost()
     return mContextLost;
 }
 
+// Counts and drops the state changes which set the current value
+static bool IsRedundantStateChange(bool unchanged)
+{
+    if (unchanged)
+    {
+        ProfileScope::count(PROFILE_STAGE_REDUNDANT_STATE);
+    }
+
+    return unchanged;
+}
+
 void Context::setCap(GLenum cap, bool enabled)
 {
     switch (cap)
@@ -468,7 +504,13 @@ void Context::setClearStencil(int stencil)
 
 void Context::setRasterizerDiscard(bool enabled)
 {
+    if (IsRedundantStateChange(mState.rasterizer.rasterizerDiscard == enabled))
+    {
+        return;
+    }
+
     mState.rasterizer.rasterizerDiscard = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool Context::isRasterizerDiscardEnabled() const
@@ -478,7 +520,13 @@ bool Context::isRasterizerDiscardEnabled() const
 
 void Context::setCullFace(bool enabled)
 {
+    if (IsRedundantStateChange(mState.rasterizer.cullFace == enabled))
+    {
+        return;
+    }
+
     mState.rasterizer.cullFace = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool Context::isCullFaceEnabled() const
@@ -488,17 +536,35 @@ bool Context::isCullFaceEnabled() const
 
 void Context::setCullMode(GLenum mode)
 {
+    if (IsRedundantStateChange(mState.rasterizer.cullMode == mode))
+    {
+        return;
+    }
+
     mState.rasterizer.cullMode = mode;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 void Context::setFrontFace(GLenum front)
 {
+    if (IsRedundantStateChange(mState.rasterizer.frontFace == front))
+    {
+        return;
+    }
+
     mState.rasterizer.frontFace = front;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE | DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setDepthTest(bool enabled)
 {
+    if (IsRedundantStateChange(mState.depthStencil.depthTest == enabled))
+    {
+        return;
+    }
+
     mState.depthStencil.depthTest = enabled;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 bool Context::isDepthTestEnabled() const
@@ -508,7 +574,13 @@ bool Context::isDepthTestEnabled() const
 
 void Context::setDepthFunc(GLenum depthFunc)
 {
-     mState.depthStencil.depthFunc = depthFunc;
+    if (IsRedundantStateChange(mState.depthStencil.depthFunc == depthFunc))
+    {
+        return;
+    }
+
+    mState.depthStencil.depthFunc = depthFunc;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setDepthRange(float zNear, float zFar)
@@ -519,7 +591,13 @@ void Context::setDepthRange(float zNear, float zFar)
 
 void Context::setBlend(bool enabled)
 {
+    if (IsRedundantStateChange(mState.blend.blend == enabled))
+    {
+        return;
+    }
+
     mState.blend.blend = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 bool Context::isBlendEnabled() const
@@ -529,29 +607,55 @@ bool Context::isBlendEnabled() const
 
 void Context::setBlendFactors(GLenum sourceRGB, GLenum destRGB, GLenum sourceAlpha, GLenum destAlpha)
 {
+    if (IsRedundantStateChange(mState.blend.sourceBlendRGB == sourceRGB && mState.blend.destBlendRGB == destRGB &&
+                               mState.blend.sourceBlendAlpha == sourceAlpha && mState.blend.destBlendAlpha == destAlpha))
+    {
+        return;
+    }
+
     mState.blend.sourceBlendRGB = sourceRGB;
     mState.blend.destBlendRGB = destRGB;
     mState.blend.sourceBlendAlpha = sourceAlpha;
     mState.blend.destBlendAlpha = destAlpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void Context::setBlendColor(float red, float green, float blue, float alpha)
 {
+    if (IsRedundantStateChange(mState.blendColor.red == red && mState.blendColor.green == green &&
+                               mState.blendColor.blue == blue && mState.blendColor.alpha == alpha))
+    {
+        return;
+    }
+
     mState.blendColor.red = red;
     mState.blendColor.green = green;
     mState.blendColor.blue = blue;
     mState.blendColor.alpha = alpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void Context::setBlendEquation(GLenum rgbEquation, GLenum alphaEquation)
 {
+    if (IsRedundantStateChange(mState.blend.blendEquationRGB == rgbEquation && mState.blend.blendEquationAlpha == alphaEquation))
+    {
+        return;
+    }
+
     mState.blend.blendEquationRGB = rgbEquation;
     mState.blend.blendEquationAlpha = alphaEquation;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void Context::setStencilTest(bool enabled)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilTest == enabled))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilTest = enabled;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 bool Context::isStencilTestEnabled() const
@@ -561,45 +665,91 @@ bool Context::isStencilTestEnabled() const
 
 void Context::setStencilParams(GLenum stencilFunc, GLint stencilRef, GLuint stencilMask)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilFunc == stencilFunc && mState.stencilRef == std::max(stencilRef, 0) &&
+                               mState.depthStencil.stencilMask == stencilMask))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilFunc = stencilFunc;
     mState.stencilRef = (stencilRef > 0) ? stencilRef : 0;
     mState.depthStencil.stencilMask = stencilMask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setStencilBackParams(GLenum stencilBackFunc, GLint stencilBackRef, GLuint stencilBackMask)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilBackFunc == stencilBackFunc && mState.stencilBackRef == std::max(stencilBackRef, 0) &&
+                               mState.depthStencil.stencilBackMask == stencilBackMask))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilBackFunc = stencilBackFunc;
     mState.stencilBackRef = (stencilBackRef > 0) ? stencilBackRef : 0;
     mState.depthStencil.stencilBackMask = stencilBackMask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setStencilWritemask(GLuint stencilWritemask)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilWritemask == stencilWritemask))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilWritemask = stencilWritemask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setStencilBackWritemask(GLuint stencilBackWritemask)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilBackWritemask == stencilBackWritemask))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilBackWritemask = stencilBackWritemask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setStencilOperations(GLenum stencilFail, GLenum stencilPassDepthFail, GLenum stencilPassDepthPass)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilFail == stencilFail && mState.depthStencil.stencilPassDepthFail == stencilPassDepthFail &&
+                               mState.depthStencil.stencilPassDepthPass == stencilPassDepthPass))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilFail = stencilFail;
     mState.depthStencil.stencilPassDepthFail = stencilPassDepthFail;
     mState.depthStencil.stencilPassDepthPass = stencilPassDepthPass;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setStencilBackOperations(GLenum stencilBackFail, GLenum stencilBackPassDepthFail, GLenum stencilBackPassDepthPass)
 {
+    if (IsRedundantStateChange(mState.depthStencil.stencilBackFail == stencilBackFail && mState.depthStencil.stencilBackPassDepthFail == stencilBackPassDepthFail &&
+                               mState.depthStencil.stencilBackPassDepthPass == stencilBackPassDepthPass))
+    {
+        return;
+    }
+
     mState.depthStencil.stencilBackFail = stencilBackFail;
     mState.depthStencil.stencilBackPassDepthFail = stencilBackPassDepthFail;
     mState.depthStencil.stencilBackPassDepthPass = stencilBackPassDepthPass;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setPolygonOffsetFill(bool enabled)
 {
-     mState.rasterizer.polygonOffsetFill = enabled;
+    if (IsRedundantStateChange(mState.rasterizer.polygonOffsetFill == enabled))
+    {
+        return;
+    }
+
+    mState.rasterizer.polygonOffsetFill = enabled;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 bool Context::isPolygonOffsetFillEnabled() const
@@ -610,13 +760,28 @@ bool Context::isPolygonOffsetFillEnabled() const
 void Context::setPolygonOffsetParams(GLfloat factor, GLfloat units)
 {
     // An application can pass NaN values here, so handle this gracefully
-    mState.rasterizer.polygonOffsetFactor = factor != factor ? 0.0f : factor;
-    mState.rasterizer.polygonOffsetUnits = units != units ? 0.0f : units;
+    factor = factor != factor ? 0.0f : factor;
+    units = units != units ? 0.0f : units;
+
+    if (IsRedundantStateChange(mState.rasterizer.polygonOffsetFactor == factor && mState.rasterizer.polygonOffsetUnits == units))
+    {
+        return;
+    }
+
+    mState.rasterizer.polygonOffsetFactor = factor;
+    mState.rasterizer.polygonOffsetUnits = units;
+    mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE;
 }
 
 void Context::setSampleAlphaToCoverage(bool enabled)
 {
+    if (IsRedundantStateChange(mState.blend.sampleAlphaToCoverage == enabled))
+    {
+        return;
+    }
+
     mState.blend.sampleAlphaToCoverage = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 bool Context::isSampleAlphaToCoverageEnabled() const
@@ -626,7 +791,13 @@ bool Context::isSampleAlphaToCoverageEnabled() const
 
 void Context::setSampleCoverage(bool enabled)
 {
+    if (IsRedundantStateChange(mState.sampleCoverage == enabled))
+    {
+        return;
+    }
+
     mState.sampleCoverage = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 bool Context::isSampleCoverageEnabled() const
@@ -636,8 +807,14 @@ bool Context::isSampleCoverageEnabled() const
 
 void Context::setSampleCoverageParams(GLclampf value, bool invert)
 {
+    if (IsRedundantStateChange(mState.sampleCoverageValue == value && mState.sampleCoverageInvert == invert))
+    {
+        return;
+    }
+
     mState.sampleCoverageValue = value;
     mState.sampleCoverageInvert = invert;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void Context::setScissorTest(bool enabled)
@@ -652,7 +829,13 @@ bool Context::isScissorTestEnabled() const
 
 void Context::setDither(bool enabled)
 {
+    if (IsRedundantStateChange(mState.blend.dither == enabled))
+    {
+        return;
+    }
+
     mState.blend.dither = enabled;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 bool Context::isDitherEnabled() const
@@ -704,15 +887,28 @@ void Context::getScissorParams(GLint *x, GLint *y, GLsizei *width, GLsizei *heig
 
 void Context::setColorMask(bool red, bool green, bool blue, bool alpha)
 {
+    if (IsRedundantStateChange(mState.blend.colorMaskRed == red && mState.blend.colorMaskGreen == green &&
+                               mState.blend.colorMaskBlue == blue && mState.blend.colorMaskAlpha == alpha))
+    {
+        return;
+    }
+
     mState.blend.colorMaskRed = red;
     mState.blend.colorMaskGreen = green;
     mState.blend.colorMaskBlue = blue;
     mState.blend.colorMaskAlpha = alpha;
+    mDirtyBits |= DIRTY_BIT_BLEND_STATE;
 }
 
 void Context::setDepthMask(bool mask)
 {
+    if (IsRedundantStateChange(mState.depthStencil.depthMask == mask))
+    {
+        return;
+    }
+
     mState.depthStencil.depthMask = mask;
+    mDirtyBits |= DIRTY_BIT_DEPTH_STENCIL_STATE;
 }
 
 void Context::setActiveSampler(unsigned int active)
@@ -871,7 +1067,7 @@ GLuint Context::createVertexArray()
     // Although the spec states VAO state is not initialized until the object is bound,
     // we create it immediately. The resulting behaviour is transparent to the application,
     // since it's not currently possible to access the state until the object is bound.
-    mVertexArrayMap[handle] = new VertexArray(mRenderer, handle);
+    mVertexArrayMap.assign(handle, new VertexArray(mRenderer, handle));
 
     return handle;
 }
@@ -886,7 +1082,7 @@ GLuint Context::createFramebuffer()
 {
     GLuint handle = mFramebufferHandleAllocator.allocate();
 
-    mFramebufferMap[handle] = NULL;
+    mFramebufferMap.assign(handle, NULL);
 
     return handle;
 }
@@ -895,7 +1091,7 @@ GLuint Context::createFenceNV()
 {
     GLuint handle = mFenceNVHandleAllocator.allocate();
 
-    mFenceNVMap[handle] = new FenceNV(mRenderer);
+    mFenceNVMap.assign(handle, new FenceNV(mRenderer));
 
     return handle;
 }
@@ -905,7 +1101,7 @@ GLuint Context::createQuery()
 {
     GLuint handle = mQueryHandleAllocator.allocate();
 
-    mQueryMap[handle] = NULL;
+    mQueryMap.assign(handle, NULL);
 
     return handle;
 }
@@ -961,15 +1157,14 @@ void Context::deleteFenceSync(GLsync fenceSync)
 
 void Context::deleteVertexArray(GLuint vertexArray)
 {
-    auto vertexArrayObject = mVertexArrayMap.find(vertexArray);
-
-    if (vertexArrayObject != mVertexArrayMap.end())
+    if (mVertexArrayMap.contains(vertexArray))
     {
         detachVertexArray(vertexArray);
 
-        mVertexArrayHandleAllocator.release(vertexArrayObject->first);
-        delete vertexArrayObject->second;
-        mVertexArrayMap.erase(vertexArrayObject);
+        VertexArray *vertexArrayObject = NULL;
+        mVertexArrayMap.erase(vertexArray, &vertexArrayObject);
+        mVertexArrayHandleAllocator.release(vertexArray);
+        delete vertexArrayObject;
     }
 }
 
@@ -985,41 +1180,38 @@ void Context::deleteSampler(GLuint sampler)
 
 void Context::deleteFramebuffer(GLuint framebuffer)
 {
-    FramebufferMap::iterator framebufferObject = mFramebufferMap.find(framebuffer);
-
-    if (framebufferObject != mFramebufferMap.end())
+    if (mFramebufferMap.contains(framebuffer))
     {
         detachFramebuffer(framebuffer);
 
-        mFramebufferHandleAllocator.release(framebufferObject->first);
-        delete framebufferObject->second;
-        mFramebufferMap.erase(framebufferObject);
+        Framebuffer *framebufferObject = NULL;
+        mFramebufferMap.erase(framebuffer, &framebufferObject);
+        mFramebufferHandleAllocator.release(framebuffer);
+        delete framebufferObject;
     }
 }
 
 void Context::deleteFenceNV(GLuint fence)
 {
-    FenceNVMap::iterator fenceObject = mFenceNVMap.find(fence);
+    FenceNV *fenceObject = NULL;
 
-    if (fenceObject != mFenceNVMap.end())
+    if (mFenceNVMap.erase(fence, &fenceObject))
     {
-        mFenceNVHandleAllocator.release(fenceObject->first);
-        delete fenceObject->second;
-        mFenceNVMap.erase(fenceObject);
+        mFenceNVHandleAllocator.release(fence);
+        delete fenceObject;
     }
 }
 
 void Context::deleteQuery(GLuint query)
 {
-    QueryMap::iterator queryObject = mQueryMap.find(query);
-    if (queryObject != mQueryMap.end())
+    Query *queryObject = NULL;
+    if (mQueryMap.erase(query, &queryObject))
     {
-        mQueryHandleAllocator.release(queryObject->first);
-        if (queryObject->second)
+        mQueryHandleAllocator.release(query);
+        if (queryObject)
         {
-            queryObject->second->release();
+            queryObject->release();
         }
-        mQueryMap.erase(queryObject);
     }
 }
 
@@ -1055,16 +1247,7 @@ FenceSync *Context::getFenceSync(GLsync handle) const
 
 VertexArray *Context::getVertexArray(GLuint handle) const
 {
-    auto vertexArray = mVertexArrayMap.find(handle);
-
-    if (vertexArray == mVertexArrayMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return vertexArray->second;
-    }
+    return mVertexArrayMap.query(handle);
 }
 
 Sampler *Context::getSampler(GLuint handle) const
@@ -1112,35 +1295,63 @@ void Context::bindTexture2D(GLuint texture)
 {
     mResourceManager->checkTextureAllocation(texture, TEXTURE_2D);
 
-    mState.samplerTexture[TEXTURE_2D][mState.activeSampler].set(getTexture(texture));
+    // A deleted texture stays bound to other contexts, and its name can be reused by a new one
+    Texture *textureObject = getTexture(texture);
+    if (IsRedundantStateChange(mState.samplerTexture[TEXTURE_2D][mState.activeSampler].get() == textureObject))
+    {
+        return;
+    }
+
+    mState.samplerTexture[TEXTURE_2D][mState.activeSampler].set(textureObject);
 }
 
 void Context::bindTextureCubeMap(GLuint texture)
 {
     mResourceManager->checkTextureAllocation(texture, TEXTURE_CUBE);
 
-    mState.samplerTexture[TEXTURE_CUBE][mState.activeSampler].set(getTexture(texture));
+    // A deleted texture stays bound to other contexts, and its name can be reused by a new one
+    Texture *textureObject = getTexture(texture);
+    if (IsRedundantStateChange(mState.samplerTexture[TEXTURE_CUBE][mState.activeSampler].get() == textureObject))
+    {
+        return;
+    }
+
+    mState.samplerTexture[TEXTURE_CUBE][mState.activeSampler].set(textureObject);
 }
 
 void Context::bindTexture3D(GLuint texture)
 {
     mResourceManager->checkTextureAllocation(texture, TEXTURE_3D);
 
-    mState.samplerTexture[TEXTURE_3D][mState.activeSampler].set(getTexture(texture));
+    // A deleted texture stays bound to other contexts, and its name can be reused by a new one
+    Texture *textureObject = getTexture(texture);
+    if (IsRedundantStateChange(mState.samplerTexture[TEXTURE_3D][mState.activeSampler].get() == textureObject))
+    {
+        return;
+    }
+
+    mState.samplerTexture[TEXTURE_3D][mState.activeSampler].set(textureObject);
 }
 
 void Context::bindTexture2DArray(GLuint texture)
 {
     mResourceManager->checkTextureAllocation(texture, TEXTURE_2D_ARRAY);
 
-    mState.samplerTexture[TEXTURE_2D_ARRAY][mState.activeSampler].set(getTexture(texture));
+    // A deleted texture stays bound to other contexts, and its name can be reused by a new one
+    Texture *textureObject = getTexture(texture);
+    if (IsRedundantStateChange(mState.samplerTexture[TEXTURE_2D_ARRAY][mState.activeSampler].get() == textureObject))
+    {
+        return;
+    }
+
+    mState.samplerTexture[TEXTURE_2D_ARRAY][mState.activeSampler].set(textureObject);
 }
 
 void Context::bindReadFramebuffer(GLuint framebuffer)
 {
     if (!getFramebuffer(framebuffer))
     {
-        mFramebufferMap[framebuffer] = new Framebuffer(mRenderer);
+        mFramebufferMap.assign(framebuffer, new Framebuffer(mRenderer));
     }
 
     mState.readFramebuffer = framebuffer;
@@ -1150,7 +1361,7 @@ void Context::bindDrawFramebuffer(GLuint framebuffer)
 {
     if (!getFramebuffer(framebuffer))
     {
-        mFramebufferMap[framebuffer] = new Framebuffer(mRenderer);
+        mFramebufferMap.assign(framebuffer, new Framebuffer(mRenderer));
     }
 
     mState.drawFramebuffer = framebuffer;
@@ -1169,7 +1380,7 @@ void Context::bindVertexArray(GLuint vertexArray)
 {
     if (!getVertexArray(vertexArray))
     {
-        mVertexArrayMap[vertexArray] = new VertexArray(mRenderer, vertexArray);
+        mVertexArrayMap.assign(vertexArray, new VertexArray(mRenderer, vertexArray));
     }
 
     mState.vertexArray = vertexArray;
@@ -1241,6 +1452,11 @@ void Context::bindPixelUnpackBuffer(GLuint buffer)
 
 void Context::useProgram(GLuint program)
 {
+    if (IsRedundantStateChange(mState.currentProgram == program))
+    {
+        return;
+    }
+
     GLuint priorProgram = mState.currentProgram;
     mState.currentProgram = program;               // Must switch before trying to delete, otherwise it only gets flagged.
 
@@ -1354,8 +1570,8 @@ void Context::endQuery(GLenum target)
 
 void Context::setFramebufferZero(Framebuffer *buffer)
 {
-    delete mFramebufferMap[0];
-    mFramebufferMap[0] = buffer;
+    delete mFramebufferMap.query(0);
+    mFramebufferMap.assign(0, buffer);
     if (mState.drawFramebuffer == 0)
     {
         mBoundDrawFramebuffer = buffer;
@@ -1398,49 +1614,29 @@ void Context::setRenderbufferStorage(GLsizei width, GLsizei height, GLenum inter
 
 Framebuffer *Context::getFramebuffer(unsigned int handle) const
 {
-    FramebufferMap::const_iterator framebuffer = mFramebufferMap.find(handle);
-
-    if (framebuffer == mFramebufferMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return framebuffer->second;
-    }
+    return mFramebufferMap.query(handle);
 }
 
 FenceNV *Context::getFenceNV(unsigned int handle)
 {
-    FenceNVMap::iterator fence = mFenceNVMap.find(handle);
-
-    if (fence == mFenceNVMap.end())
-    {
-        return NULL;
-    }
-    else
-    {
-        return fence->second;
-    }
+    return mFenceNVMap.query(handle);
 }
 
 Query *Context::getQuery(unsigned int handle, bool create, GLenum type)
 {
-    QueryMap::iterator query = mQueryMap.find(handle);
-
-    if (query == mQueryMap.end())
+    if (!mQueryMap.contains(handle))
     {
         return NULL;
     }
-    else
+
+    Query *query = mQueryMap.query(handle);
+    if (!query && create)
     {
-        if (!query->second && create)
-        {
-            query->second = new Query(mRenderer, type, handle);
-            query->second->addRef();
-        }
-        return query->second;
+        query = new Query(mRenderer, type, handle);
+        query->addRef();
+        mQueryMap.assign(handle, query);
     }
+    return query;
 }
 
 Buffer *Context::getTargetBuffer(GLenum target) const
@@ -2380,13 +2576,53 @@ bool Context::applyRenderTarget(GLenum drawMode, bool ignoreViewport)
 // Applies the fixed-function state (culling, depth test, alpha blending, stenciling, etc) to the Direct3D 9 device
 void Context::applyState(GLenum drawMode)
 {
+    ProfileScope profile(PROFILE_STAGE_APPLY_STATE);
+
     Framebuffer *framebufferObject = getDrawFramebuffer();
     int samples = framebufferObject->getSamples();
 
-    mState.rasterizer.pointDrawMode = (drawMode == GL_POINTS);
-    mState.rasterizer.multiSample = (samples != 0);
-    mRenderer->setRasterizerState(mState.rasterizer);
+    // The renderer may hold the state of another context, or have to set its own again
+    if (mRenderer->getFixedFunctionStateSerial() != mAppliedStateSerial)
+    {
+        mDirtyBits |= DIRTY_BITS_ALL;
+    }
+
+    bool pointDrawMode = (drawMode == GL_POINTS);
+    if (mState.rasterizer.pointDrawMode != pointDrawMode || samples != mAppliedSamples)
+    {
+        mState.rasterizer.pointDrawMode = pointDrawMode;
+        mState.rasterizer.multiSample = (samples != 0);
+        mDirtyBits |= DIRTY_BIT_RASTERIZER_STATE | DIRTY_BIT_BLEND_STATE;
+        mAppliedSamples = samples;
+    }
+
+    if (!mDirtyBits)
+    {
+        return;
+    }
+
+    if (mDirtyBits & DIRTY_BIT_RASTERIZER_STATE)
+    {
+        mRenderer->setRasterizerState(mState.rasterizer);
+    }
+
+    if (mDirtyBits & DIRTY_BIT_BLEND_STATE)
+    {
+        applyBlendState(framebufferObject, samples);
+    }
+
+    if (mDirtyBits & DIRTY_BIT_DEPTH_STENCIL_STATE)
+    {
+        mRenderer->setDepthStencilState(mState.depthStencil, mState.stencilRef, mState.stencilBackRef,
+                                        mState.rasterizer.frontFace == GL_CCW);
+    }
+
+    mAppliedStateSerial = mRenderer->claimFixedFunctionState();
+    mDirtyBits = 0;
+}
 
+void Context::applyBlendState(Framebuffer *framebufferObject, int samples)
+{
     unsigned int mask = 0;
     if (mState.sampleCoverage)
     {
@@ -2417,9 +2653,6 @@ void Context::applyState(GLenum drawMode)
         mask = 0xFFFFFFFF;
     }
     mRenderer->setBlendState(framebufferObject, mState.blend, mState.blendColor, mask);
-
-    mRenderer->setDepthStencilState(mState.depthStencil, mState.stencilRef, mState.stencilBackRef,
-                                    mState.rasterizer.frontFace == GL_CCW);
 }
 
 // Applies the shaders and shader constants to the Direct3D 9 device
@@ -2436,7 +2669,7 @@ void Context::applyShaders(ProgramBinary *programBinary)
 }
 
 bool Context::getCurrentTextureAndSamplerState(ProgramBinary *programBinary, SamplerType type, int index, Texture **outTexture,
-                                               TextureType *outTextureType, SamplerState *outSampler)
+                                               TextureType *outTextureType, SamplerState *outSampler, unsigned int *outSamplerSerial)
 {
     int textureUnit = programBinary->getSamplerMapping(type, index);   // OpenGL texture image unit index
 
@@ -2447,16 +2680,19 @@ bool Context::getCurrentTextureAndSamplerState(ProgramBinary *programBinary, Sam
 
         SamplerState samplerState;
         texture->getSamplerState(&samplerState);
+        unsigned int samplerSerial = 0;
 
         if (mState.samplers[textureUnit] != 0)
         {
             Sampler *samplerObject = getSampler(mState.samplers[textureUnit]);
             samplerObject->getState(&samplerState);
+            samplerSerial = samplerObject->getStateSerial();
         }
 
         *outTexture = texture;
         *outTextureType = textureType;
         *outSampler = samplerState;
+        *outSamplerSerial = samplerSerial;
 
         return true;
     }
@@ -2487,7 +2723,9 @@ void Context::generateSwizzles(ProgramBinary *programBinary, SamplerType type)
         Texture *texture = NULL;
         TextureType textureType;
         SamplerState samplerState;
-        if (getCurrentTextureAndSamplerState(programBinary, type, samplerIndex, &texture, &textureType, &samplerState) && texture->isSwizzled())
+        unsigned int samplerSerial;
+        if (getCurrentTextureAndSamplerState(programBinary, type, samplerIndex, &texture, &textureType, &samplerState, &samplerSerial) &&
+            texture->isSwizzled())
         {
             mRenderer->generateSwizzle(texture);
         }
@@ -2521,9 +2759,10 @@ void Context::applyTextures(ProgramBinary *programBinary, SamplerType type)
         Texture *texture = NULL;
         TextureType textureType;
         SamplerState samplerState;
-        if (getCurrentTextureAndSamplerState(programBinary, type, samplerIndex, &texture, &textureType, &samplerState))
+        unsigned int samplerSerial;
+        if (getCurrentTextureAndSamplerState(programBinary, type, samplerIndex, &texture, &textureType, &samplerState, &samplerSerial))
         {
-            if (texture->isSamplerComplete(samplerState) &&
+            if (texture->isSamplerComplete(samplerState, samplerSerial) &&
                 boundFramebufferTextures.find(texture->getTextureSerial()) == boundFramebufferTextures.end())
             {
                 mRenderer->setSamplerState(type, samplerIndex, samplerState);
@@ -3309,9 +3548,11 @@ void Context::detachBuffer(GLuint buffer)
     }
 
     // mark as freed among the vertex array objects
-    for (auto vaoIt = mVertexArrayMap.begin(); vaoIt != mVertexArrayMap.end(); vaoIt++)
+    std::vector<GLuint> vertexArrays;
+    mVertexArrayMap.getHandles(&vertexArrays);
+    for (size_t i = 0; i < vertexArrays.size(); i++)
     {
-        vaoIt->second->detachBuffer(buffer);
+        mVertexArrayMap.query(vertexArrays[i])->detachBuffer(buffer);
     }
 }
 
@@ -3725,6 +3966,7 @@ void Context::initExtensionString()
         }
 
         mExtensionStringList.push_back("GL_ANGLE_pack_reverse_row_order");
+        mExtensionStringList.push_back("GL_ANGLE_profile_counters");
 
         if (supportsDXT3Textures())
         {
@@ -3959,22 +4201,41 @@ extern "C"
 {
 gl::Context *glCreateContext(int clientVersion, const gl::Context *shareContext, rx::Renderer *renderer, bool notifyResets, bool robustAccess)
 {
+    gl::DeferredContextLock lock;
+
     return new gl::Context(clientVersion, shareContext, renderer, notifyResets, robustAccess);
 }
 
 void glDestroyContext(gl::Context *context)
 {
+    // The submission thread needs the lock to execute the calls left in the queue
+    gl::DeferredContext *deferredContext = context->getDeferredContext();
+    if (deferredContext)
+    {
+        deferredContext->stop();
+    }
+
+    gl::DeferredContextLock lock;
+
     delete context;
 
     if (context == gl::getContext())
     {
         gl::makeCurrent(NULL, NULL, NULL);
     }
+
+    if (deferredContext == gl::getDeferredContext())
+    {
+        gl::setDeferredContext(NULL);
+    }
 }
 
 void glMakeCurrent(gl::Context *context, egl::Display *display, egl::Surface *surface)
 {
+    gl::DeferredContextLock lock;
+
     gl::makeCurrent(context, display, surface);
+    gl::setDeferredContext(context ? context->getDeferredContext() : NULL);
 }
 
 gl::Context *glGetCurrentContext()
@@ -23,11 +23,11 @@
 #include <string>
 #include <set>
 #include <map>
-#include <unordered_map>
 
 #include "common/angleutils.h"
 #include "common/RefCountObject.h"
 #include "libGLESv2/HandleAllocator.h"
+#include "libGLESv2/ResourceMap.h"
 #include "libGLESv2/angletypes.h"
 #include "libGLESv2/Constants.h"
 #include "libGLESv2/VertexAttribute.h"
@@ -67,6 +67,7 @@ class Buffer;
 class VertexAttribute;
 class VertexArray;
 class Sampler;
+class DeferredContext;
 
 // Helper structure to store all raw state
 struct State
@@ -451,11 +452,15 @@ class Context
 
     rx::Renderer *getRenderer() { return mRenderer; }
 
+    // The queue of the context when contexts are deferred, otherwise NULL
+    DeferredContext *getDeferredContext() { return mDeferredContext; }
+
   private:
     DISALLOW_COPY_AND_ASSIGN(Context);
 
     bool applyRenderTarget(GLenum drawMode, bool ignoreViewport);
     void applyState(GLenum drawMode);
+    void applyBlendState(Framebuffer *framebufferObject, int samples);
     void applyShaders(ProgramBinary *programBinary);
     void applyTextures(ProgramBinary *programBinary);
     void applyTextures(ProgramBinary *programBinary, SamplerType type);
@@ -471,7 +476,7 @@ class Context
     void generateSwizzles(ProgramBinary *programBinary);
     void generateSwizzles(ProgramBinary *programBinary, SamplerType type);
     bool getCurrentTextureAndSamplerState(ProgramBinary *programBinary, SamplerType type, int index, Texture **outTexture,
-                                   TextureType *outTextureType, SamplerState *outSampler);
+                                   TextureType *outTextureType, SamplerState *outSampler, unsigned int *outSamplerSerial);
     Texture *getIncompleteTexture(TextureType type);
 
     bool skipDraw(GLenum drawMode);
@@ -493,19 +498,19 @@ class Context
     BindingPointer<Texture3D> mTexture3DZero;
     BindingPointer<Texture2DArray> mTexture2DArrayZero;
 
-    typedef std::unordered_map<GLuint, Framebuffer*> FramebufferMap;
+    typedef ResourceMap<Framebuffer> FramebufferMap;
     FramebufferMap mFramebufferMap;
     HandleAllocator mFramebufferHandleAllocator;
 
-    typedef std::unordered_map<GLuint, FenceNV*> FenceNVMap;
+    typedef ResourceMap<FenceNV> FenceNVMap;
     FenceNVMap mFenceNVMap;
     HandleAllocator mFenceNVHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Query*> QueryMap;
+    typedef ResourceMap<Query> QueryMap;
     QueryMap mQueryMap;
     HandleAllocator mQueryHandleAllocator;
 
-    typedef std::unordered_map<GLuint, VertexArray*> VertexArrayMap;
+    typedef ResourceMap<VertexArray> VertexArrayMap;
     VertexArrayMap mVertexArrayMap;
     HandleAllocator mVertexArrayHandleAllocator;
 
@@ -569,6 +574,21 @@ class Context
     int mNumCompressedTextureFormats;
 
     ResourceManager *mResourceManager;
+
+    DeferredContext *mDeferredContext;
+
+    // The groups of fixed-function state changed since applyState last set them
+    enum
+    {
+        DIRTY_BIT_RASTERIZER_STATE    = 0x1,
+        DIRTY_BIT_BLEND_STATE         = 0x2,
+        DIRTY_BIT_DEPTH_STENCIL_STATE = 0x4,
+
+        DIRTY_BITS_ALL                = 0x7
+    };
+    unsigned int mDirtyBits;
+    unsigned int mAppliedStateSerial;
+    int mAppliedSamples;
 };
 }
 
@@ -0,0 +1,531 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DeferredContext.cpp: Implements gl::DeferredContext, which queues the calls made to the
+// entry points of a context into a ring buffer executed by a submission thread.
+
+#include "libGLESv2/DeferredContext.h"
+
+#include "common/mathutil.h"
+#include "libGLESv2/main.h"
+#include "libGLESv2/Context.h"
+
+namespace gl
+{
+
+bool DeferredContext::mEnabled = false;
+CRITICAL_SECTION DeferredContext::mExecutionLock;
+
+namespace
+{
+
+// Calls larger than half the ring execute inline
+const unsigned int RingSize = 8 * 1024 * 1024;
+
+struct DeferredRecordHeader
+{
+    unsigned int size;
+    unsigned int skip;   // The rest of the ring is unused, the next record is at its start
+};
+
+typedef bool (*DeferredReplayFunction)(CaptureDecoder *decoder);
+
+#define DEFERRED_REPLAY_FUNCTION(function) \
+    bool Replay_ ## function(CaptureDecoder *decoder) { return ReplayCall(function, decoder); }
+ANGLE_CAPTURE_ENTRY_POINTS(DEFERRED_REPLAY_FUNCTION)
+#undef DEFERRED_REPLAY_FUNCTION
+
+const DeferredReplayFunction DeferredReplayFunctions[] =
+{
+#define DEFERRED_REPLAY_TABLE_ENTRY(function) Replay_ ## function,
+    ANGLE_CAPTURE_ENTRY_POINTS(DEFERRED_REPLAY_TABLE_ENTRY)
+#undef DEFERRED_REPLAY_TABLE_ENTRY
+};
+
+unsigned int RecordSize(size_t callSize)
+{
+    return sizeof(DeferredRecordHeader) + rx::roundUp(static_cast<unsigned int>(callSize), static_cast<unsigned int>(sizeof(DeferredRecordHeader)));
+}
+
+}
+
+DeferredContext::DeferredContext(Context *context)
+    : mContext(context),
+      mInlineDepth(0),
+      mArrayBuffer(0),
+      mVertexArray(0),
+      mRing(RingSize),
+      mWritePosition(0),
+      mReadPosition(0),
+      mProducerWaiting(0),
+      mSubmissionWaiting(0),
+      mExiting(0),
+      mThread(NULL)
+{
+    DeferredVertexArrayState defaultVertexArray = { 0, ~0u, false };
+    mVertexArrays[0] = defaultVertexArray;
+
+    mSpaceAvailable = CreateEvent(NULL, FALSE, FALSE, NULL);
+    mWorkAvailable = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+    if (mSpaceAvailable && mWorkAvailable)
+    {
+        mThread = CreateThread(NULL, 0, submissionMain, this, 0, NULL);
+    }
+
+    if (!mThread)
+    {
+        ERR("Could not start the submission thread of a deferred context, its calls execute inline.");
+    }
+}
+
+DeferredContext::~DeferredContext()
+{
+    stop();
+
+    if (mSpaceAvailable)
+    {
+        CloseHandle(mSpaceAvailable);
+    }
+
+    if (mWorkAvailable)
+    {
+        CloseHandle(mWorkAvailable);
+    }
+}
+
+void DeferredContext::initialize()
+{
+    char value[8];
+    DWORD length = GetEnvironmentVariableA("ANGLE_DEFERRED_CONTEXT", value, ArraySize(value));
+    if (length > 0 && length < ArraySize(value) && strcmp(value, "0") != 0)
+    {
+        InitializeCriticalSection(&mExecutionLock);
+        mEnabled = true;
+    }
+}
+
+void DeferredContext::terminate()
+{
+    if (mEnabled)
+    {
+        mEnabled = false;
+        DeleteCriticalSection(&mExecutionLock);
+    }
+}
+
+void DeferredContext::lockExecution()
+{
+    if (mEnabled)
+    {
+        EnterCriticalSection(&mExecutionLock);
+    }
+}
+
+void DeferredContext::unlockExecution()
+{
+    if (mEnabled)
+    {
+        LeaveCriticalSection(&mExecutionLock);
+    }
+}
+
+CaptureEncoder *DeferredContext::beginQueue()
+{
+    if (!mThread)
+    {
+        return NULL;
+    }
+
+    mEncoder.clear();
+    return &mEncoder;
+}
+
+bool DeferredContext::endQueue()
+{
+    const std::vector<unsigned char> &call = mEncoder.getData();
+
+    mDecoder.openCalls(&call[0], call.size());
+    if (!mDecoder.next() || !prepare(&mDecoder))
+    {
+        return false;
+    }
+
+    return push(call);
+}
+
+void DeferredContext::synchronize()
+{
+    if (mThread)
+    {
+        waitForSpace(RingSize);
+    }
+}
+
+void DeferredContext::beginInline()
+{
+    if (mInlineDepth++ == 0)
+    {
+        synchronize();
+        lockExecution();
+    }
+}
+
+void DeferredContext::endInline()
+{
+    ASSERT(mInlineDepth > 0);
+
+    if (--mInlineDepth == 0)
+    {
+        updateState();
+        unlockExecution();
+    }
+}
+
+void DeferredContext::stop()
+{
+    if (!mThread)
+    {
+        return;
+    }
+
+    synchronize();
+
+    InterlockedExchange(&mExiting, 1);
+    SetEvent(mWorkAvailable);
+    WaitForSingleObject(mThread, INFINITE);
+
+    CloseHandle(mThread);
+    mThread = NULL;
+}
+
+bool DeferredContext::hasElementArrayBuffer()
+{
+    return getVertexArrayState().elementArrayBuffer;
+}
+
+// Calls execute inline when they write to application memory, when the application thread
+// reads state they change, or when they read client memory which the queue doesn't copy.
+// Otherwise the shadowed vertex array state is updated as the call would change it.
+bool DeferredContext::prepare(CaptureDecoder *call)
+{
+    for (size_t argument = 0; argument < call->getArgumentCount(); argument++)
+    {
+        if (call->getArgument(argument).tag == CAPTURE_ARGUMENT_OUTPUT)
+        {
+            return false;
+        }
+    }
+
+    switch (call->getCallId())
+    {
+      case CAPTURE_CALL_glFinish:
+      case CAPTURE_CALL_glFlush:
+      case CAPTURE_CALL_glFinishFenceNV:
+      case CAPTURE_CALL_glPixelStorei:
+      case CAPTURE_CALL_glDeleteBuffers:
+      case CAPTURE_CALL_glDeleteVertexArrays:
+        return false;
+
+      case CAPTURE_CALL_glBindBuffer:
+        switch (call->argument<GLenum>(0))
+        {
+          case GL_PIXEL_PACK_BUFFER:
+          case GL_PIXEL_UNPACK_BUFFER:
+            return false;
+          case GL_ARRAY_BUFFER:
+            mArrayBuffer = call->argument<GLuint>(1);
+            break;
+          case GL_ELEMENT_ARRAY_BUFFER:
+            getVertexArrayState().elementArrayBuffer = (call->argument<GLuint>(1) != 0);
+            break;
+        }
+        return true;
+
+      case CAPTURE_CALL_glBindVertexArray:
+        {
+            GLuint vertexArray = call->argument<GLuint>(0);
+            if (mContext->getClientVersion() < 3 || mVertexArrays.find(vertexArray) == mVertexArrays.end())
+            {
+                return false;
+            }
+            mVertexArray = vertexArray;
+        }
+        return true;
+
+      case CAPTURE_CALL_glVertexAttribPointer:
+      case CAPTURE_CALL_glVertexAttribIPointer:
+        {
+            GLuint index = call->argument<GLuint>(0);
+            GLint size = call->argument<GLint>(1);
+            GLsizei stride = call->argument<GLsizei>(call->getCallId() == CAPTURE_CALL_glVertexAttribPointer ? 4 : 3);
+            if (index >= MAX_VERTEX_ATTRIBS || size < 1 || size > 4 || stride < 0)
+            {
+                return false;
+            }
+
+            // Attributes which may be client arrays stay marked until the state is read back
+            DeferredVertexArrayState &state = getVertexArrayState();
+            if (mArrayBuffer == 0)
+            {
+                state.clientMask |= (1u << index);
+            }
+            else if (state.clientMask & (1u << index))
+            {
+                return false;
+            }
+        }
+        return true;
+
+      case CAPTURE_CALL_glEnableVertexAttribArray:
+      case CAPTURE_CALL_glDisableVertexAttribArray:
+        {
+            GLuint index = call->argument<GLuint>(0);
+            if (index < MAX_VERTEX_ATTRIBS)
+            {
+                DeferredVertexArrayState &state = getVertexArrayState();
+                if (call->getCallId() == CAPTURE_CALL_glEnableVertexAttribArray)
+                {
+                    state.enabledMask |= (1u << index);
+                }
+                else
+                {
+                    state.enabledMask &= ~(1u << index);
+                }
+            }
+        }
+        return true;
+
+      case CAPTURE_CALL_glDrawArrays:
+      case CAPTURE_CALL_glDrawArraysInstancedANGLE:
+      case CAPTURE_CALL_glDrawArraysInstanced:
+      case CAPTURE_CALL_glDrawElements:
+      case CAPTURE_CALL_glDrawElementsInstancedANGLE:
+      case CAPTURE_CALL_glDrawRangeElements:
+      case CAPTURE_CALL_glDrawElementsInstanced:
+        {
+            // Client indices are copied into the call, client vertices are not
+            const DeferredVertexArrayState &state = getVertexArrayState();
+            return (state.enabledMask & state.clientMask) == 0;
+        }
+
+      default:
+        return true;
+    }
+}
+
+bool DeferredContext::push(const std::vector<unsigned char> &call)
+{
+    unsigned int recordSize = RecordSize(call.size());
+    if (recordSize > RingSize / 2)
+    {
+        return false;
+    }
+
+    unsigned int writePosition = static_cast<unsigned int>(mWritePosition);
+    unsigned int offset = writePosition & (RingSize - 1);
+    unsigned int tail = RingSize - offset;
+
+    waitForSpace(recordSize <= tail ? recordSize : tail + recordSize);
+
+    DeferredRecordHeader header = { 0, 0 };
+    if (recordSize > tail)
+    {
+        header.skip = 1;
+        memcpy(&mRing[offset], &header, sizeof(header));
+
+        writePosition += tail;
+        offset = 0;
+    }
+
+    header.size = static_cast<unsigned int>(call.size());
+    header.skip = 0;
+    memcpy(&mRing[offset], &header, sizeof(header));
+    memcpy(&mRing[offset + sizeof(header)], &call[0], call.size());
+
+    // Publishing the position is a full barrier, the record is visible first
+    InterlockedExchange(&mWritePosition, static_cast<LONG>(writePosition + recordSize));
+    if (mSubmissionWaiting)
+    {
+        SetEvent(mWorkAvailable);
+    }
+
+    return true;
+}
+
+void DeferredContext::waitForSpace(unsigned int size)
+{
+    for (;;)
+    {
+        unsigned int used = static_cast<unsigned int>(mWritePosition) - static_cast<unsigned int>(mReadPosition);
+        if (RingSize - used >= size)
+        {
+            break;
+        }
+
+        // The submission thread checks the flag after releasing space, so either it sees the
+        // flag or the space is seen here before waiting
+        InterlockedExchange(&mProducerWaiting, 1);
+        used = static_cast<unsigned int>(mWritePosition) - static_cast<unsigned int>(mReadPosition);
+        if (RingSize - used < size)
+        {
+            WaitForSingleObject(mSpaceAvailable, INFINITE);
+        }
+        InterlockedExchange(&mProducerWaiting, 0);
+    }
+
+    MemoryBarrier();
+}
+
+DeferredVertexArrayState &DeferredContext::getVertexArrayState()
+{
+    return mVertexArrays[mVertexArray];
+}
+
+// Inline calls may change any state, read it back once the queue is empty
+void DeferredContext::updateState()
+{
+    if (!mThread)
+    {
+        return;
+    }
+
+    mArrayBuffer = mContext->getArrayBufferHandle();
+    mVertexArray = mContext->getVertexArrayHandle();
+
+    // Vertex arrays deleted by the call are unbound, and fail to bind afterwards
+    for (std::map<GLuint, DeferredVertexArrayState>::iterator vertexArray = mVertexArrays.begin(); vertexArray != mVertexArrays.end();)
+    {
+        if (vertexArray->first != 0 && !mContext->getVertexArray(vertexArray->first))
+        {
+            mVertexArrays.erase(vertexArray++);
+        }
+        else
+        {
+            ++vertexArray;
+        }
+    }
+
+    DeferredVertexArrayState &state = getVertexArrayState();
+    state.enabledMask = 0;
+    state.clientMask = 0;
+    state.elementArrayBuffer = (mContext->getElementArrayBuffer() != NULL);
+
+    for (unsigned int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    {
+        const VertexAttribute &attribute = mContext->getVertexAttribState(attributeIndex);
+        if (attribute.mArrayEnabled)
+        {
+            state.enabledMask |= (1u << attributeIndex);
+        }
+        if (!attribute.mBoundBuffer.get())
+        {
+            state.clientMask |= (1u << attributeIndex);
+        }
+    }
+}
+
+DWORD WINAPI DeferredContext::submissionMain(LPVOID parameter)
+{
+    static_cast<DeferredContext*>(parameter)->runSubmission();
+    return 0;
+}
+
+void DeferredContext::runSubmission()
+{
+    // Errors are recorded on the context current on the submission thread
+    makeCurrent(mContext, NULL, NULL);
+
+    CaptureDecoder decoder;
+
+    for (;;)
+    {
+        unsigned int readPosition = static_cast<unsigned int>(mReadPosition);
+
+        if (static_cast<unsigned int>(mWritePosition) == readPosition)
+        {
+            if (mExiting)
+            {
+                break;
+            }
+
+            InterlockedExchange(&mSubmissionWaiting, 1);
+            if (static_cast<unsigned int>(mWritePosition) == readPosition && !mExiting)
+            {
+                WaitForSingleObject(mWorkAvailable, INFINITE);
+            }
+            InterlockedExchange(&mSubmissionWaiting, 0);
+            continue;
+        }
+
+        MemoryBarrier();
+
+        unsigned int offset = readPosition & (RingSize - 1);
+        DeferredRecordHeader header;
+        memcpy(&header, &mRing[offset], sizeof(header));
+
+        unsigned int recordSize;
+        if (header.skip)
+        {
+            recordSize = RingSize - offset;
+        }
+        else
+        {
+            recordSize = RecordSize(header.size);
+
+            decoder.openCalls(&mRing[offset + sizeof(header)], header.size);
+            if (decoder.next() && decoder.getCallId() < ArraySize(DeferredReplayFunctions))
+            {
+                lockExecution();
+                DeferredReplayFunctions[decoder.getCallId()](&decoder);
+                unlockExecution();
+            }
+            else UNREACHABLE();
+        }
+
+        InterlockedExchange(&mReadPosition, static_cast<LONG>(readPosition + recordSize));
+        if (mProducerWaiting)
+        {
+            SetEvent(mSpaceAvailable);
+        }
+    }
+
+    makeCurrent(NULL, NULL, NULL);
+}
+
+bool DeferredScope::queue()
+{
+    if (mContext->endQueue())
+    {
+        return true;
+    }
+
+    mEncoder = NULL;
+    mContext->beginInline();
+    mInline = true;
+    return false;
+}
+
+void DeferredScope::begin(bool deferrable)
+{
+    DeferredContext *context = getDeferredContext();
+    if (!context || context->isInline())
+    {
+        return;
+    }
+
+    mContext = context;
+    mEncoder = deferrable ? context->beginQueue() : NULL;
+
+    if (!mEncoder)
+    {
+        mContext->beginInline();
+        mInline = true;
+    }
+}
+
+}
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DeferredContext.h: Defines gl::DeferredContext, which queues the calls made to the entry
+// points of a context into a ring buffer executed by a submission thread, and
+// gl::DeferredScope, which the CAPTURE macros use to queue a call or to execute it inline
+// once the queued calls have executed.
+
+#ifndef LIBGLESV2_DEFERREDCONTEXT_H_
+#define LIBGLESV2_DEFERREDCONTEXT_H_
+
+#include <map>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "libGLESv2/CaptureDecoder.h"
+#include "libGLESv2/CaptureEncoder.h"
+
+namespace gl
+{
+class Context;
+
+// The vertex array state the application thread needs to tell whether a draw reads client
+// memory, as of the last queued call
+struct DeferredVertexArrayState
+{
+    unsigned int enabledMask;
+    unsigned int clientMask;   // Attributes which may point to client memory
+    bool elementArrayBuffer;
+};
+
+class DeferredContext
+{
+  public:
+    explicit DeferredContext(Context *context);
+    ~DeferredContext();
+
+    // Contexts are deferred when the ANGLE_DEFERRED_CONTEXT environment variable is set
+    static void initialize();
+    static void terminate();
+    static bool isEnabled() { return mEnabled; }
+
+    // The contexts of a display share its renderer, so the submission threads and the calls
+    // executing inline take turns using it
+    static void lockExecution();
+    static void unlockExecution();
+
+    // A call is queued by encoding it with the returned encoder, then calling endQueue. It
+    // returns false if the call has to execute inline instead.
+    CaptureEncoder *beginQueue();
+    bool endQueue();
+
+    // Waits until the submission thread has executed every queued call
+    void synchronize();
+
+    // Executes the calls ahead and keeps the submission threads waiting until endInline.
+    // Calls made by an inline call are not queued.
+    void beginInline();
+    void endInline();
+    bool isInline() const { return mInlineDepth > 0; }
+
+    // Executes the queued calls and stops the submission thread, the context can't queue
+    // calls anymore
+    void stop();
+
+    bool hasElementArrayBuffer();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(DeferredContext);
+
+    bool prepare(CaptureDecoder *call);
+    bool push(const std::vector<unsigned char> &call);
+    void waitForSpace(unsigned int size);
+    DeferredVertexArrayState &getVertexArrayState();
+    void updateState();
+
+    static DWORD WINAPI submissionMain(LPVOID parameter);
+    void runSubmission();
+
+    Context *const mContext;
+
+    CaptureEncoder mEncoder;
+    CaptureDecoder mDecoder;
+    unsigned int mInlineDepth;
+
+    GLuint mArrayBuffer;
+    GLuint mVertexArray;
+    std::map<GLuint, DeferredVertexArrayState> mVertexArrays;
+
+    // Written by the application thread only, records are published by advancing
+    // mWritePosition and released by the submission thread advancing mReadPosition
+    std::vector<unsigned char> mRing;
+    volatile LONG mWritePosition;
+    volatile LONG mReadPosition;
+
+    volatile LONG mProducerWaiting;
+    volatile LONG mSubmissionWaiting;
+    volatile LONG mExiting;
+    HANDLE mSpaceAvailable;
+    HANDLE mWorkAvailable;
+    HANDLE mThread;
+
+    static bool mEnabled;
+    static CRITICAL_SECTION mExecutionLock;
+};
+
+// The return type of an entry point. Calls returning a value always execute inline.
+template <typename F>
+struct DeferredCallTraits;
+
+template <typename R>
+struct DeferredCallTraits<R (GL_APIENTRY *)()> { typedef R Return; };
+
+template <typename R, typename A1>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6, A7)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6, A7, A8)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6, A7, A8, A9)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10)> { typedef R Return; };
+
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+struct DeferredCallTraits<R (GL_APIENTRY *)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11)> { typedef R Return; };
+
+template <typename R>
+struct DeferredReturnsVoid { enum { value = false }; };
+
+template <>
+struct DeferredReturnsVoid<void> { enum { value = true }; };
+
+template <typename F>
+bool IsDeferrableCall(F)
+{
+    return DeferredReturnsVoid<typename DeferredCallTraits<F>::Return>::value;
+}
+
+// What a queued call returns, only ever void
+template <typename F>
+typename DeferredCallTraits<F>::Return DeferredReturnValue(F)
+{
+    return typename DeferredCallTraits<F>::Return();
+}
+
+class DeferredScope
+{
+  public:
+    explicit DeferredScope(bool deferrable)
+        : mContext(NULL),
+          mEncoder(NULL),
+          mInline(false)
+    {
+        if (DeferredContext::isEnabled())
+        {
+            begin(deferrable);
+        }
+    }
+
+    ~DeferredScope()
+    {
+        if (mInline)
+        {
+            mContext->endInline();
+        }
+    }
+
+    // The encoder for the call if it may be queued, or NULL if it executes inline
+    CaptureEncoder *getEncoder() const { return mEncoder; }
+
+    // Returns true if the encoded call was queued, otherwise it executes inline
+    bool queue();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(DeferredScope);
+
+    void begin(bool deferrable);
+
+    DeferredContext *mContext;
+    CaptureEncoder *mEncoder;
+    bool mInline;
+};
+
+}
+
+#endif   // LIBGLESV2_DEFERREDCONTEXT_H_
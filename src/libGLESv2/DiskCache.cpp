@@ -0,0 +1,388 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DiskCache.cpp: Implements gl::DiskCache, an opt-in persistent cache of translated shaders
+// and linked program binaries.
+
+#include "libGLESv2/DiskCache.h"
+
+#include "common/debug.h"
+#include "third_party/murmurhash/MurmurHash3.h"
+
+namespace gl
+{
+
+namespace
+{
+
+const size_t DefaultMaxSizeMegabytes = 64;
+
+const char EntryExtension[] = ".bin";
+const char TemporaryExtension[] = ".tmp";
+
+// Every entry file starts with this header so truncated or corrupted files are rejected
+struct EntryHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int payloadLength;
+    unsigned int checksum;
+};
+
+const unsigned int EntryMagic = 0x43444E41;   // "ANDC"
+const unsigned int EntryVersion = 1;
+const uint32_t ChecksumSeed = 0xD15C;
+
+unsigned int ComputeChecksum(const void *data, size_t length)
+{
+    uint32_t checksum = 0;
+    MurmurHash3_x86_32(data, static_cast<int>(length), ChecksumSeed, &checksum);
+    return checksum;
+}
+
+struct ScannedEntry
+{
+    ULONGLONG lastAccess;
+    std::string key;
+    size_t size;
+
+    // Orders the most recently used entries first
+    bool operator<(const ScannedEntry &other) const { return lastAccess > other.lastAccess; }
+};
+
+bool WriteAll(HANDLE file, const void *data, size_t length)
+{
+    DWORD written = 0;
+    return (WriteFile(file, data, static_cast<DWORD>(length), &written, NULL) && written == length);
+}
+
+bool ReadAll(HANDLE file, void *data, size_t length)
+{
+    DWORD read = 0;
+    return (ReadFile(file, data, static_cast<DWORD>(length), &read, NULL) && read == length);
+}
+
+}
+
+DiskCacheStatistics::DiskCacheStatistics()
+    : hits(0),
+      misses(0),
+      stores(0),
+      evictions(0),
+      failures(0),
+      bytesRead(0),
+      bytesWritten(0),
+      totalSize(0)
+{
+}
+
+CRITICAL_SECTION DiskCache::mInstanceLock;
+DiskCache *DiskCache::mInstance = NULL;
+bool DiskCache::mInstanceInitialized = false;
+
+DiskCache::DiskCache(const std::string &directory, size_t maxSize)
+    : mDirectory(directory),
+      mMaxSize(maxSize)
+{
+    InitializeCriticalSection(&mLock);
+
+    CreateDirectoryA(mDirectory.c_str(), NULL);
+    scanDirectory();
+}
+
+DiskCache::~DiskCache()
+{
+    TRACE("Disk cache: %u hits, %u misses, %u stores, %u evictions, %u failures, %lu bytes in use",
+          mStatistics.hits, mStatistics.misses, mStatistics.stores, mStatistics.evictions,
+          mStatistics.failures, static_cast<unsigned long>(mStatistics.totalSize));
+
+    DeleteCriticalSection(&mLock);
+}
+
+void DiskCache::initialize()
+{
+    InitializeCriticalSection(&mInstanceLock);
+}
+
+DiskCache *DiskCache::getInstance()
+{
+    EnterCriticalSection(&mInstanceLock);
+
+    if (!mInstanceInitialized)
+    {
+        mInstanceInitialized = true;
+
+        char directory[MAX_PATH];
+        DWORD directoryLength = GetEnvironmentVariableA("ANGLE_DISK_CACHE_DIR", directory, ArraySize(directory));
+        if (directoryLength > 0 && directoryLength < ArraySize(directory))
+        {
+            size_t maxSizeMegabytes = DefaultMaxSizeMegabytes;
+
+            char maxSizeString[32];
+            DWORD maxSizeLength = GetEnvironmentVariableA("ANGLE_DISK_CACHE_SIZE", maxSizeString, ArraySize(maxSizeString));
+            if (maxSizeLength > 0 && maxSizeLength < ArraySize(maxSizeString))
+            {
+                maxSizeMegabytes = strtoul(maxSizeString, NULL, 10);
+            }
+
+            mInstance = new DiskCache(directory, maxSizeMegabytes * 1024 * 1024);
+        }
+    }
+
+    DiskCache *instance = mInstance;
+    LeaveCriticalSection(&mInstanceLock);
+
+    return instance;
+}
+
+void DiskCache::releaseInstance()
+{
+    SafeDelete(mInstance);
+    mInstanceInitialized = false;
+
+    DeleteCriticalSection(&mInstanceLock);
+}
+
+DiskCacheStatistics DiskCache::getStatistics()
+{
+    EnterCriticalSection(&mLock);
+    DiskCacheStatistics statistics = mStatistics;
+    LeaveCriticalSection(&mLock);
+
+    return statistics;
+}
+
+std::string DiskCache::computeKey(const void *data, size_t length)
+{
+    uint32_t hash[4];
+    MurmurHash3_x86_128(data, static_cast<int>(length), 0, hash);
+
+    char key[33];
+    snprintf(key, ArraySize(key), "%08x%08x%08x%08x", hash[0], hash[1], hash[2], hash[3]);
+    return key;
+}
+
+bool DiskCache::get(const std::string &key, std::vector<char> *value)
+{
+    EnterCriticalSection(&mLock);
+    bool found = getLocked(key, value);
+    LeaveCriticalSection(&mLock);
+
+    return found;
+}
+
+void DiskCache::put(const std::string &key, const void *data, size_t length)
+{
+    EnterCriticalSection(&mLock);
+    putLocked(key, data, length);
+    LeaveCriticalSection(&mLock);
+}
+
+bool DiskCache::getLocked(const std::string &key, std::vector<char> *value)
+{
+    EntryMap::iterator entry = mEntries.find(key);
+    if (entry == mEntries.end())
+    {
+        mStatistics.misses++;
+        return false;
+    }
+
+    std::string path = getEntryPath(key);
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+    bool valid = (file != INVALID_HANDLE_VALUE);
+
+    EntryHeader header;
+    if (valid)
+    {
+        valid = ReadAll(file, &header, sizeof(header)) && header.magic == EntryMagic &&
+                header.version == EntryVersion && sizeof(header) + header.payloadLength == entry->second.size;
+    }
+
+    if (valid)
+    {
+        value->resize(header.payloadLength);
+        valid = (header.payloadLength == 0 || ReadAll(file, &(*value)[0], header.payloadLength)) &&
+                ComputeChecksum(value->empty() ? NULL : &(*value)[0], value->size()) == header.checksum;
+    }
+
+    if (valid)
+    {
+        // Record the access on disk so recency survives across runs
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+        SetFileTime(file, NULL, &now, &now);
+    }
+
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file);
+    }
+
+    if (!valid)
+    {
+        mStatistics.failures++;
+        mStatistics.misses++;
+
+        DeleteFileA(path.c_str());
+        removeEntry(entry);
+        value->clear();
+        return false;
+    }
+
+    mRecency.splice(mRecency.begin(), mRecency, entry->second.recency);
+
+    mStatistics.hits++;
+    mStatistics.bytesRead += entry->second.size;
+    return true;
+}
+
+void DiskCache::putLocked(const std::string &key, const void *data, size_t length)
+{
+    const size_t entrySize = sizeof(EntryHeader) + length;
+    if (entrySize > mMaxSize)
+    {
+        return;
+    }
+
+    EntryHeader header;
+    header.magic = EntryMagic;
+    header.version = EntryVersion;
+    header.payloadLength = static_cast<unsigned int>(length);
+    header.checksum = ComputeChecksum(data, length);
+
+    // Write to a file private to this process, then move it into place so that a crash or a
+    // concurrent reader never observes a partially written entry
+    char temporarySuffix[32];
+    snprintf(temporarySuffix, ArraySize(temporarySuffix), ".%u%s", GetCurrentProcessId(), TemporaryExtension);
+
+    std::string path = getEntryPath(key);
+    std::string temporaryPath = mDirectory + "\\" + key + temporarySuffix;
+
+    HANDLE file = CreateFileA(temporaryPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        mStatistics.failures++;
+        return;
+    }
+
+    bool written = WriteAll(file, &header, sizeof(header)) && WriteAll(file, data, length) && FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (!written || !MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        mStatistics.failures++;
+        DeleteFileA(temporaryPath.c_str());
+        return;
+    }
+
+    EntryMap::iterator existing = mEntries.find(key);
+    if (existing != mEntries.end())
+    {
+        removeEntry(existing);
+    }
+
+    evict(entrySize);
+    insertEntry(key, entrySize);
+
+    mStatistics.stores++;
+    mStatistics.bytesWritten += entrySize;
+}
+
+void DiskCache::scanDirectory()
+{
+    std::vector<ScannedEntry> scannedEntries;
+
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA((mDirectory + "\\*").c_str(), &findData);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    do
+    {
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            continue;
+        }
+
+        std::string fileName = findData.cFileName;
+        size_t extension = fileName.rfind('.');
+        if (extension == std::string::npos)
+        {
+            continue;
+        }
+
+        if (fileName.compare(extension, std::string::npos, TemporaryExtension) == 0)
+        {
+            // Left behind by a process that terminated while writing
+            DeleteFileA((mDirectory + "\\" + fileName).c_str());
+        }
+        else if (fileName.compare(extension, std::string::npos, EntryExtension) == 0)
+        {
+            ScannedEntry scanned;
+            scanned.lastAccess = (static_cast<ULONGLONG>(findData.ftLastWriteTime.dwHighDateTime) << 32) |
+                                 findData.ftLastWriteTime.dwLowDateTime;
+            scanned.key = fileName.substr(0, extension);
+            scanned.size = findData.nFileSizeLow;
+            scannedEntries.push_back(scanned);
+        }
+    }
+    while (FindNextFileA(find, &findData));
+
+    FindClose(find);
+
+    // Insert from least to most recently used so the recency list matches the previous runs
+    std::sort(scannedEntries.begin(), scannedEntries.end());
+    for (size_t entryIndex = scannedEntries.size(); entryIndex > 0; entryIndex--)
+    {
+        const ScannedEntry &scanned = scannedEntries[entryIndex - 1];
+        insertEntry(scanned.key, scanned.size);
+    }
+
+    evict(0);
+}
+
+void DiskCache::insertEntry(const std::string &key, size_t size)
+{
+    mRecency.push_front(key);
+
+    Entry entry;
+    entry.size = size;
+    entry.recency = mRecency.begin();
+    mEntries[key] = entry;
+
+    mStatistics.totalSize += size;
+}
+
+void DiskCache::removeEntry(EntryMap::iterator entry)
+{
+    mStatistics.totalSize -= entry->second.size;
+    mRecency.erase(entry->second.recency);
+    mEntries.erase(entry);
+}
+
+void DiskCache::evict(size_t incomingSize)
+{
+    while (!mRecency.empty() && mStatistics.totalSize + incomingSize > mMaxSize)
+    {
+        const std::string &key = mRecency.back();
+        DeleteFileA(getEntryPath(key).c_str());
+
+        removeEntry(mEntries.find(key));
+        mStatistics.evictions++;
+    }
+}
+
+std::string DiskCache::getEntryPath(const std::string &key) const
+{
+    return mDirectory + "\\" + key + EntryExtension;
+}
+
+}
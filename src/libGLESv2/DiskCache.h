@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DiskCache.h: Defines gl::DiskCache, an opt-in persistent cache of translated shaders and
+// linked program binaries. Entries are stored one per file, bounded in total size with
+// least-recently-used eviction.
+
+#ifndef LIBGLESV2_DISKCACHE_H_
+#define LIBGLESV2_DISKCACHE_H_
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+struct DiskCacheStatistics
+{
+    DiskCacheStatistics();
+
+    unsigned int hits;
+    unsigned int misses;
+    unsigned int stores;
+    unsigned int evictions;
+    unsigned int failures;   // Corrupt entries and I/O errors
+
+    size_t bytesRead;
+    size_t bytesWritten;
+    size_t totalSize;
+};
+
+class DiskCache
+{
+  public:
+    DiskCache(const std::string &directory, size_t maxSize);
+    ~DiskCache();
+
+    // Returns the process-wide cache, or NULL unless it was enabled by setting the
+    // ANGLE_DISK_CACHE_DIR environment variable. ANGLE_DISK_CACHE_SIZE optionally sets
+    // the size bound in megabytes. The cache can be used from any thread.
+    static DiskCache *getInstance();
+
+    // Called when the library is loaded and unloaded
+    static void initialize();
+    static void releaseInstance();
+
+    // Keys are printable 128-bit hashes of everything that affects the cached result
+    static std::string computeKey(const void *data, size_t length);
+
+    bool get(const std::string &key, std::vector<char> *value);
+    void put(const std::string &key, const void *data, size_t length);
+
+    DiskCacheStatistics getStatistics();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(DiskCache);
+
+    struct Entry
+    {
+        size_t size;
+        std::list<std::string>::iterator recency;
+    };
+
+    typedef std::map<std::string, Entry> EntryMap;
+
+    // Called with mLock held
+    bool getLocked(const std::string &key, std::vector<char> *value);
+    void putLocked(const std::string &key, const void *data, size_t length);
+
+    void scanDirectory();
+    void insertEntry(const std::string &key, size_t size);
+    void removeEntry(EntryMap::iterator entry);
+    void evict(size_t incomingSize);
+    std::string getEntryPath(const std::string &key) const;
+
+    const std::string mDirectory;
+    const size_t mMaxSize;
+
+    // The most recently used key is at the front of the list
+    std::list<std::string> mRecency;
+    EntryMap mEntries;
+
+    DiskCacheStatistics mStatistics;
+
+    // Guards the entries and the statistics
+    CRITICAL_SECTION mLock;
+
+    // Guards the creation of the instance
+    static CRITICAL_SECTION mInstanceLock;
+    static DiskCache *mInstance;
+    static bool mInstanceInitialized;
+};
+
+}
+
+#endif   // LIBGLESV2_DISKCACHE_H_
@@ -9,6 +9,7 @@
 #include "precompiled.h"
 
 #include "libGLESv2/DynamicHLSL.h"
+#include "libGLESv2/HLSLCache.h"
 #include "libGLESv2/Shader.h"
 #include "libGLESv2/Program.h"
 #include "libGLESv2/renderer/Renderer.h"
@@ -78,6 +79,23 @@ std::string HLSLTypeString(GLenum type)
 namespace gl
 {
 
+namespace
+{
+
+// The vertex and pixel shader text which generateShaderLinkHLSL appends after the translated HLSL
+struct LinkHLSL
+{
+    std::string vertexHLSL;
+    std::string pixelHLSL;
+};
+
+HLSLCache<std::string> g_varyingHLSLCache;
+HLSLCache<std::string> g_inputLayoutHLSLCache;
+HLSLCache<std::string> g_pointSpriteHLSLCache;
+HLSLCache<LinkHLSL> g_linkHLSLCache;
+
+}
+
 std::string ArrayString(unsigned int i)
 {
     return (i == GL_INVALID_INDEX ? "" : "[" + Str(i) + "]");
@@ -247,6 +265,25 @@ int DynamicHLSL::packVaryings(InfoLog &infoLog, const sh::ShaderVariable *packin
 
 std::string DynamicHLSL::generateVaryingHLSL(FragmentShader *fragmentShader, const std::string &varyingSemantic) const
 {
+    HLSLSignature signature;
+    signature.addString(varyingSemantic);
+
+    for (unsigned int varyingIndex = 0; varyingIndex < fragmentShader->mVaryings.size(); varyingIndex++)
+    {
+        const sh::Varying &varying = fragmentShader->mVaryings[varyingIndex];
+        signature.addInt(varying.type);
+        signature.addInt(varying.interpolation);
+        signature.addInt(varying.elementCount());
+        signature.addInt(varying.registerIndex);
+        signature.addString(varying.isStruct() ? varying.structName : "");
+    }
+
+    std::string cachedHLSL;
+    if (g_varyingHLSLCache.find(signature.key(), &cachedHLSL))
+    {
+        return cachedHLSL;
+    }
+
     std::string varyingHLSL;
 
     for (unsigned int varyingIndex = 0; varyingIndex < fragmentShader->mVaryings.size(); varyingIndex++)
@@ -282,11 +319,36 @@ std::string DynamicHLSL::generateVaryingHLSL(FragmentShader *fragmentShader, con
         else UNREACHABLE();
     }
 
+    g_varyingHLSLCache.insert(signature.key(), varyingHLSL);
+
     return varyingHLSL;
 }
 
 std::string DynamicHLSL::generateInputLayoutHLSL(const VertexFormat inputLayout[], const sh::Attribute shaderAttributes[]) const
 {
+    HLSLSignature signature;
+
+    for (unsigned int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
+    {
+        const VertexFormat &vertexFormat = inputLayout[attributeIndex];
+        const sh::Attribute &shaderAttribute = shaderAttributes[attributeIndex];
+
+        if (!shaderAttribute.name.empty())
+        {
+            signature.addString(shaderAttribute.name);
+            signature.addInt(shaderAttribute.type);
+            signature.addInt(mRenderer->getVertexComponentType(vertexFormat));
+            signature.addInt((mRenderer->getVertexConversionType(vertexFormat) & rx::VERTEX_CONVERT_GPU) != 0);
+            signature.addInt(vertexFormat.mType);
+        }
+    }
+
+    std::string cachedHLSL;
+    if (g_inputLayoutHLSLCache.find(signature.key(), &cachedHLSL))
+    {
+        return cachedHLSL;
+    }
+
     std::string vertexHLSL;
 
     vertexHLSL += "struct VS_INPUT\n"
@@ -348,6 +410,8 @@ std::string DynamicHLSL::generateInputLayoutHLSL(const VertexFormat inputLayout[
 
     vertexHLSL += "}\n";
 
+    g_inputLayoutHLSLCache.insert(signature.key(), vertexHLSL);
+
     return vertexHLSL;
 }
 
@@ -422,71 +486,150 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
         }
     }
 
+    if (shaderVersion >= 300)
+    {
+        defineOutputVariables(fragmentShader, programOutputVars);
+    }
+
+    HLSLSignature signature;
+    signature.addInt(shaderModel);
+    signature.addInt(shaderVersion);
+    signature.addInt(broadcast);
+    signature.addInt(numRenderTargets);
+    signature.addInt(registers);
+    signature.addInt(fragmentShader->mUsesFragCoord);
+    signature.addInt(fragmentShader->mUsesPointCoord);
+    signature.addInt(fragmentShader->mUsesFrontFacing);
+    signature.addInt(fragmentShader->mUsesFragDepth);
+    signature.addInt(vertexShader->mUsesPointSize);
+    signature.addString(varyingHLSL);
+
+    signature.addInt(static_cast<int>(fragmentShader->mVaryings.size()));
+    for (unsigned int varyingIndex = 0; varyingIndex < fragmentShader->mVaryings.size(); varyingIndex++)
+    {
+        const sh::Varying &varying = fragmentShader->mVaryings[varyingIndex];
+        signature.addString(varying.name);
+        signature.addInt(varying.type);
+        signature.addInt(varying.arraySize);
+        signature.addInt(varying.isStruct());
+        signature.addInt(varying.registerIndex);
+    }
+
+    // Vertex outputs also depend on which registers are shared between several varyings
+    signature.addInt(static_cast<int>(vertexShader->mVaryings.size()));
+    for (unsigned int varyingIndex = 0; varyingIndex < vertexShader->mVaryings.size(); varyingIndex++)
+    {
+        const sh::Varying &varying = vertexShader->mVaryings[varyingIndex];
+        if (varying.registerAssigned())
+        {
+            signature.addString(varying.name);
+            signature.addInt(varying.type);
+            signature.addInt(varying.arraySize);
+            signature.addInt(varying.isStruct());
+            signature.addInt(varying.registerIndex);
+
+            int variableRows = (varying.isStruct() ? 1 : VariableRowCount(TransposeMatrixType(varying.type)));
+            int registerCount = variableRows * varying.elementCount();
+            for (int r = varying.registerIndex; r < static_cast<int>(varying.registerIndex) + registerCount; r++)
+            {
+                int packingMask = 0;
+                for (int x = 0; x < 4; x++)
+                {
+                    packingMask |= (packing[r][x] && packing[r][x] != packing[r][0]) ? (1 << x) : 0;
+                    packingMask |= (packing[r][x] == &varying) ? (1 << (x + 4)) : 0;
+                }
+                signature.addInt(packingMask);
+            }
+        }
+    }
+
+    if (shaderVersion >= 300)
+    {
+        const std::vector<sh::Attribute> &shaderOutputVars = fragmentShader->getOutputVariables();
+        for (auto locationIt = programOutputVars->begin(); locationIt != programOutputVars->end(); locationIt++)
+        {
+            signature.addInt(locationIt->first);
+            signature.addString(locationIt->second.name);
+            signature.addInt(locationIt->second.element);
+            signature.addInt(shaderOutputVars[locationIt->second.index].type);
+        }
+    }
+
+    LinkHLSL cachedLink;
+    if (g_linkHLSLCache.find(signature.key(), &cachedLink))
+    {
+        vertexHLSL += cachedLink.vertexHLSL;
+        pixelHLSL += cachedLink.pixelHLSL;
+        return true;
+    }
+
+    LinkHLSL link;
+
     // Add stub string to be replaced when shader is dynamically defined by its layout
-    vertexHLSL += "\n" + VERTEX_ATTRIBUTE_STUB_STRING + "\n";
+    link.vertexHLSL += "\n" + VERTEX_ATTRIBUTE_STUB_STRING + "\n";
 
-    vertexHLSL += "struct VS_OUTPUT\n"
-                  "{\n";
+    link.vertexHLSL += "struct VS_OUTPUT\n"
+                       "{\n";
 
     if (shaderModel < 4)
     {
-        vertexHLSL += "    float4 gl_Position : " + positionSemantic + ";\n";
+        link.vertexHLSL += "    float4 gl_Position : " + positionSemantic + ";\n";
     }
 
-    vertexHLSL += varyingHLSL;
+    link.vertexHLSL += varyingHLSL;
 
     if (fragmentShader->mUsesFragCoord)
     {
-        vertexHLSL += "    float4 gl_FragCoord : " + fragCoordSemantic + ";\n";
+        link.vertexHLSL += "    float4 gl_FragCoord : " + fragCoordSemantic + ";\n";
     }
 
     if (vertexShader->mUsesPointSize && shaderModel >= 3)
     {
-        vertexHLSL += "    float gl_PointSize : PSIZE;\n";
+        link.vertexHLSL += "    float gl_PointSize : PSIZE;\n";
     }
 
     if (shaderModel >= 4)
     {
-        vertexHLSL += "    float4 gl_Position : " + positionSemantic + ";\n";
+        link.vertexHLSL += "    float4 gl_Position : " + positionSemantic + ";\n";
     }
 
-    vertexHLSL += "};\n"
-                  "\n"
-                  "VS_OUTPUT main(VS_INPUT input)\n"
-                  "{\n"
-                  "    initAttributes(input);\n";
+    link.vertexHLSL += "};\n"
+                       "\n"
+                       "VS_OUTPUT main(VS_INPUT input)\n"
+                       "{\n"
+                       "    initAttributes(input);\n";
 
     if (shaderModel >= 4)
     {
-        vertexHLSL += "\n"
-                      "    gl_main();\n"
-                      "\n"
-                      "    VS_OUTPUT output;\n"
-                      "    output.gl_Position.x = gl_Position.x;\n"
-                      "    output.gl_Position.y = -gl_Position.y;\n"
-                      "    output.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;\n"
-                      "    output.gl_Position.w = gl_Position.w;\n";
+        link.vertexHLSL += "\n"
+                           "    gl_main();\n"
+                           "\n"
+                           "    VS_OUTPUT output;\n"
+                           "    output.gl_Position.x = gl_Position.x;\n"
+                           "    output.gl_Position.y = -gl_Position.y;\n"
+                           "    output.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;\n"
+                           "    output.gl_Position.w = gl_Position.w;\n";
     }
     else
     {
-        vertexHLSL += "\n"
-                      "    gl_main();\n"
-                      "\n"
-                      "    VS_OUTPUT output;\n"
-                      "    output.gl_Position.x = gl_Position.x * dx_ViewAdjust.z + dx_ViewAdjust.x * gl_Position.w;\n"
-                      "    output.gl_Position.y = -(gl_Position.y * dx_ViewAdjust.w + dx_ViewAdjust.y * gl_Position.w);\n"
-                      "    output.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;\n"
-                      "    output.gl_Position.w = gl_Position.w;\n";
+        link.vertexHLSL += "\n"
+                           "    gl_main();\n"
+                           "\n"
+                           "    VS_OUTPUT output;\n"
+                           "    output.gl_Position.x = gl_Position.x * dx_ViewAdjust.z + dx_ViewAdjust.x * gl_Position.w;\n"
+                           "    output.gl_Position.y = -(gl_Position.y * dx_ViewAdjust.w + dx_ViewAdjust.y * gl_Position.w);\n"
+                           "    output.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;\n"
+                           "    output.gl_Position.w = gl_Position.w;\n";
     }
 
     if (vertexShader->mUsesPointSize && shaderModel >= 3)
     {
-        vertexHLSL += "    output.gl_PointSize = gl_PointSize;\n";
+        link.vertexHLSL += "    output.gl_PointSize = gl_PointSize;\n";
     }
 
     if (fragmentShader->mUsesFragCoord)
     {
-        vertexHLSL += "    output.gl_FragCoord = gl_Position;\n";
+        link.vertexHLSL += "    output.gl_FragCoord = gl_Position;\n";
     }
 
     for (unsigned int vertVaryingIndex = 0; vertVaryingIndex < vertexShader->mVaryings.size(); vertVaryingIndex++)
@@ -501,7 +644,7 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
                 for (int row = 0; row < variableRows; row++)
                 {
                     int r = varying->registerIndex + elementIndex * variableRows + row;
-                    vertexHLSL += "    output.v" + Str(r);
+                    link.vertexHLSL += "    output.v" + Str(r);
 
                     bool sharedRegister = false;   // Register used by multiple varyings
 
@@ -516,7 +659,7 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
 
                     if(sharedRegister)
                     {
-                        vertexHLSL += ".";
+                        link.vertexHLSL += ".";
 
                         for (int x = 0; x < 4; x++)
                         {
@@ -524,92 +667,90 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
                             {
                                 switch(x)
                                 {
-                                  case 0: vertexHLSL += "x"; break;
-                                  case 1: vertexHLSL += "y"; break;
-                                  case 2: vertexHLSL += "z"; break;
-                                  case 3: vertexHLSL += "w"; break;
+                                  case 0: link.vertexHLSL += "x"; break;
+                                  case 1: link.vertexHLSL += "y"; break;
+                                  case 2: link.vertexHLSL += "z"; break;
+                                  case 3: link.vertexHLSL += "w"; break;
                                 }
                             }
                         }
                     }
 
-                    vertexHLSL += " = _" + varying->name;
+                    link.vertexHLSL += " = _" + varying->name;
 
                     if (varying->isArray())
                     {
-                        vertexHLSL += ArrayString(elementIndex);
+                        link.vertexHLSL += ArrayString(elementIndex);
                     }
 
                     if (variableRows > 1)
                     {
-                        vertexHLSL += ArrayString(row);
+                        link.vertexHLSL += ArrayString(row);
                     }
 
-                    vertexHLSL += ";\n";
+                    link.vertexHLSL += ";\n";
                 }
             }
         }
     }
 
-    vertexHLSL += "\n"
-                  "    return output;\n"
-                  "}\n";
+    link.vertexHLSL += "\n"
+                       "    return output;\n"
+                       "}\n";
 
-    pixelHLSL += "struct PS_INPUT\n"
-                 "{\n";
+    link.pixelHLSL += "struct PS_INPUT\n"
+                      "{\n";
 
-    pixelHLSL += varyingHLSL;
+    link.pixelHLSL += varyingHLSL;
 
     if (fragmentShader->mUsesFragCoord)
     {
-        pixelHLSL += "    float4 gl_FragCoord : " + fragCoordSemantic + ";\n";
+        link.pixelHLSL += "    float4 gl_FragCoord : " + fragCoordSemantic + ";\n";
     }
 
     if (fragmentShader->mUsesPointCoord && shaderModel >= 3)
     {
-        pixelHLSL += "    float2 gl_PointCoord : " + pointCoordSemantic + ";\n";
+        link.pixelHLSL += "    float2 gl_PointCoord : " + pointCoordSemantic + ";\n";
     }
 
     // Must consume the PSIZE element if the geometry shader is not active
     // We won't know if we use a GS until we draw
     if (vertexShader->mUsesPointSize && shaderModel >= 4)
     {
-        pixelHLSL += "    float gl_PointSize : PSIZE;\n";
+        link.pixelHLSL += "    float gl_PointSize : PSIZE;\n";
     }
 
     if (fragmentShader->mUsesFragCoord)
     {
         if (shaderModel >= 4)
         {
-            pixelHLSL += "    float4 dx_VPos : SV_Position;\n";
+            link.pixelHLSL += "    float4 dx_VPos : SV_Position;\n";
         }
         else if (shaderModel >= 3)
         {
-            pixelHLSL += "    float2 dx_VPos : VPOS;\n";
+            link.pixelHLSL += "    float2 dx_VPos : VPOS;\n";
         }
     }
 
-    pixelHLSL += "};\n"
-                 "\n"
-                 "struct PS_OUTPUT\n"
-                 "{\n";
+    link.pixelHLSL += "};\n"
+                      "\n"
+                      "struct PS_OUTPUT\n"
+                      "{\n";
 
     if (shaderVersion < 300)
     {
         for (unsigned int renderTargetIndex = 0; renderTargetIndex < numRenderTargets; renderTargetIndex++)
         {
-            pixelHLSL += "    float4 gl_Color" + Str(renderTargetIndex) + " : " + targetSemantic + Str(renderTargetIndex) + ";\n";
+            link.pixelHLSL += "    float4 gl_Color" + Str(renderTargetIndex) + " : " + targetSemantic + Str(renderTargetIndex) + ";\n";
         }
 
         if (fragmentShader->mUsesFragDepth)
         {
-            pixelHLSL += "    float gl_Depth : " + depthSemantic + ";\n";
+            link.pixelHLSL += "    float gl_Depth : " + depthSemantic + ";\n";
         }
     }
     else
     {
-        defineOutputVariables(fragmentShader, programOutputVars);
-
         const std::vector<sh::Attribute> &shaderOutputVars = fragmentShader->getOutputVariables();
         for (auto locationIt = programOutputVars->begin(); locationIt != programOutputVars->end(); locationIt++)
         {
@@ -617,74 +758,74 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
             const sh::ShaderVariable &outputVariable = shaderOutputVars[outputLocation.index];
             const std::string &elementString = (outputLocation.element == GL_INVALID_INDEX ? "" : Str(outputLocation.element));
 
-            pixelHLSL += "    " + gl_d3d::HLSLTypeString(outputVariable.type) +
-                         " out_" + outputLocation.name + elementString +
-                         " : " + targetSemantic + Str(locationIt->first) + ";\n";
+            link.pixelHLSL += "    " + gl_d3d::HLSLTypeString(outputVariable.type) +
+                              " out_" + outputLocation.name + elementString +
+                              " : " + targetSemantic + Str(locationIt->first) + ";\n";
         }
     }
 
-    pixelHLSL += "};\n"
-                 "\n";
+    link.pixelHLSL += "};\n"
+                      "\n";
 
     if (fragmentShader->mUsesFrontFacing)
     {
         if (shaderModel >= 4)
         {
-            pixelHLSL += "PS_OUTPUT main(PS_INPUT input, bool isFrontFace : SV_IsFrontFace)\n"
-                         "{\n";
+            link.pixelHLSL += "PS_OUTPUT main(PS_INPUT input, bool isFrontFace : SV_IsFrontFace)\n"
+                              "{\n";
         }
         else
         {
-            pixelHLSL += "PS_OUTPUT main(PS_INPUT input, float vFace : VFACE)\n"
-                         "{\n";
+            link.pixelHLSL += "PS_OUTPUT main(PS_INPUT input, float vFace : VFACE)\n"
+                              "{\n";
         }
     }
     else
     {
-        pixelHLSL += "PS_OUTPUT main(PS_INPUT input)\n"
-                     "{\n";
+        link.pixelHLSL += "PS_OUTPUT main(PS_INPUT input)\n"
+                          "{\n";
     }
 
     if (fragmentShader->mUsesFragCoord)
     {
-        pixelHLSL += "    float rhw = 1.0 / input.gl_FragCoord.w;\n";
+        link.pixelHLSL += "    float rhw = 1.0 / input.gl_FragCoord.w;\n";
 
         if (shaderModel >= 4)
         {
-            pixelHLSL += "    gl_FragCoord.x = input.dx_VPos.x;\n"
-                         "    gl_FragCoord.y = input.dx_VPos.y;\n";
+            link.pixelHLSL += "    gl_FragCoord.x = input.dx_VPos.x;\n"
+                              "    gl_FragCoord.y = input.dx_VPos.y;\n";
         }
         else if (shaderModel >= 3)
         {
-            pixelHLSL += "    gl_FragCoord.x = input.dx_VPos.x + 0.5;\n"
-                         "    gl_FragCoord.y = input.dx_VPos.y + 0.5;\n";
+            link.pixelHLSL += "    gl_FragCoord.x = input.dx_VPos.x + 0.5;\n"
+                              "    gl_FragCoord.y = input.dx_VPos.y + 0.5;\n";
         }
         else
         {
             // dx_ViewCoords contains the viewport width/2, height/2, center.x and center.y. See Renderer::setViewport()
-            pixelHLSL += "    gl_FragCoord.x = (input.gl_FragCoord.x * rhw) * dx_ViewCoords.x + dx_ViewCoords.z;\n"
-                         "    gl_FragCoord.y = (input.gl_FragCoord.y * rhw) * dx_ViewCoords.y + dx_ViewCoords.w;\n";
+            link.pixelHLSL += "    gl_FragCoord.x = (input.gl_FragCoord.x * rhw) * dx_ViewCoords.x + dx_ViewCoords.z;\n"
+                              "    gl_FragCoord.y = (input.gl_FragCoord.y * rhw) * dx_ViewCoords.y + dx_ViewCoords.w;\n";
         }
 
-        pixelHLSL += "    gl_FragCoord.z = (input.gl_FragCoord.z * rhw) * dx_DepthFront.x + dx_DepthFront.y;\n"
-                     "    gl_FragCoord.w = rhw;\n";
+        link.pixelHLSL += "    gl_FragCoord.z = (input.gl_FragCoord.z * rhw) * dx_DepthFront.x + dx_DepthFront.y;\n"
+                          "    gl_FragCoord.w = rhw;\n";
     }
 
     if (fragmentShader->mUsesPointCoord && shaderModel >= 3)
     {
-        pixelHLSL += "    gl_PointCoord.x = input.gl_PointCoord.x;\n";
-        pixelHLSL += "    gl_PointCoord.y = 1.0 - input.gl_PointCoord.y;\n";
+        link.pixelHLSL += "    gl_PointCoord.x = input.gl_PointCoord.x;\n";
+        link.pixelHLSL += "    gl_PointCoord.y = 1.0 - input.gl_PointCoord.y;\n";
     }
 
     if (fragmentShader->mUsesFrontFacing)
     {
         if (shaderModel <= 3)
         {
-            pixelHLSL += "    gl_FrontFacing = (vFace * dx_DepthFront.z >= 0.0);\n";
+            link.pixelHLSL += "    gl_FrontFacing = (vFace * dx_DepthFront.z >= 0.0);\n";
         }
         else
         {
-            pixelHLSL += "    gl_FrontFacing = isFrontFace;\n";
+            link.pixelHLSL += "    gl_FrontFacing = isFrontFace;\n";
         }
     }
 
@@ -700,30 +841,30 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
                 for (int row = 0; row < variableRows; row++)
                 {
                     std::string n = Str(varying->registerIndex + elementIndex * variableRows + row);
-                    pixelHLSL += "    _" + varying->name;
+                    link.pixelHLSL += "    _" + varying->name;
 
                     if (varying->isArray())
                     {
-                        pixelHLSL += ArrayString(elementIndex);
+                        link.pixelHLSL += ArrayString(elementIndex);
                     }
 
                     if (variableRows > 1)
                     {
-                        pixelHLSL += ArrayString(row);
+                        link.pixelHLSL += ArrayString(row);
                     }
 
                     if (varying->isStruct())
                     {
-                        pixelHLSL += " = input.v" + n + ";\n";   break;
+                        link.pixelHLSL += " = input.v" + n + ";\n";   break;
                     }
                     else
                     {
                         switch (VariableColumnCount(transposedType))
                         {
-                          case 1: pixelHLSL += " = input.v" + n + ".x;\n";   break;
-                          case 2: pixelHLSL += " = input.v" + n + ".xy;\n";  break;
-                          case 3: pixelHLSL += " = input.v" + n + ".xyz;\n"; break;
-                          case 4: pixelHLSL += " = input.v" + n + ";\n";     break;
+                          case 1: link.pixelHLSL += " = input.v" + n + ".x;\n";   break;
+                          case 2: link.pixelHLSL += " = input.v" + n + ".xy;\n";  break;
+                          case 3: link.pixelHLSL += " = input.v" + n + ".xyz;\n"; break;
+                          case 4: link.pixelHLSL += " = input.v" + n + ";\n";     break;
                           default: UNREACHABLE();
                         }
                     }
@@ -733,10 +874,10 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
         else UNREACHABLE();
     }
 
-    pixelHLSL += "\n"
-                 "    gl_main();\n"
-                 "\n"
-                 "    PS_OUTPUT output;\n";
+    link.pixelHLSL += "\n"
+                      "    gl_main();\n"
+                      "\n"
+                      "    PS_OUTPUT output;\n";
 
     if (shaderVersion < 300)
     {
@@ -744,12 +885,12 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
         {
             unsigned int sourceColorIndex = broadcast ? 0 : renderTargetIndex;
 
-            pixelHLSL += "    output.gl_Color" + Str(renderTargetIndex) + " = gl_Color[" + Str(sourceColorIndex) + "];\n";
+            link.pixelHLSL += "    output.gl_Color" + Str(renderTargetIndex) + " = gl_Color[" + Str(sourceColorIndex) + "];\n";
         }
 
         if (fragmentShader->mUsesFragDepth)
         {
-            pixelHLSL += "    output.gl_Depth = gl_Depth;\n";
+            link.pixelHLSL += "    output.gl_Depth = gl_Depth;\n";
         }
     }
     else
@@ -761,13 +902,18 @@ bool DynamicHLSL::generateShaderLinkHLSL(InfoLog &infoLog, int registers, const
             const std::string &outVariableName = variableName + (outputLocation.element == GL_INVALID_INDEX ? "" : Str(outputLocation.element));
             const std::string &staticVariableName = variableName + ArrayString(outputLocation.element);
 
-            pixelHLSL += "    output." + outVariableName + " = " + staticVariableName + ";\n";
+            link.pixelHLSL += "    output." + outVariableName + " = " + staticVariableName + ";\n";
         }
     }
 
-    pixelHLSL += "\n"
-                 "    return output;\n"
-                 "}\n";
+    link.pixelHLSL += "\n"
+                      "    return output;\n"
+                      "}\n";
+
+    g_linkHLSLCache.insert(signature.key(), link);
+
+    vertexHLSL += link.vertexHLSL;
+    pixelHLSL += link.pixelHLSL;
 
     return true;
 }
@@ -811,9 +957,23 @@ std::string DynamicHLSL::generatePointSpriteHLSL(int registers, const sh::Shader
     ASSERT(vertexShader->mUsesPointSize);
     ASSERT(mRenderer->getMajorShaderModel() >= 4);
 
-    std::string geomHLSL;
-
     std::string varyingSemantic = "TEXCOORD";
+    std::string varyingHLSL = generateVaryingHLSL(fragmentShader, varyingSemantic);
+
+    HLSLSignature signature;
+    signature.addInt(registers);
+    signature.addInt(fragmentShader->mUsesFragCoord);
+    signature.addInt(fragmentShader->mUsesPointCoord);
+    signature.addFloat(mRenderer->getMaxPointSize());
+    signature.addString(varyingHLSL);
+
+    std::string cachedHLSL;
+    if (g_pointSpriteHLSLCache.find(signature.key(), &cachedHLSL))
+    {
+        return cachedHLSL;
+    }
+
+    std::string geomHLSL;
 
     std::string fragCoordSemantic;
     std::string pointCoordSemantic;
@@ -835,8 +995,6 @@ std::string DynamicHLSL::generatePointSpriteHLSL(int registers, const sh::Shader
                 "struct GS_INPUT\n"
                 "{\n";
 
-    std::string varyingHLSL = generateVaryingHLSL(fragmentShader, varyingSemantic);
-
     geomHLSL += varyingHLSL;
 
     if (fragmentShader->mUsesFragCoord)
@@ -924,6 +1082,8 @@ std::string DynamicHLSL::generatePointSpriteHLSL(int registers, const sh::Shader
                 "    outStream.RestartStrip();\n"
                 "}\n";
 
+    g_pointSpriteHLSLCache.insert(signature.key(), geomHLSL);
+
     return geomHLSL;
 }
 
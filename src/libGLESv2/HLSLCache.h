@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// HLSLCache.h: Defines gl::HLSLSignature, a compact binary key of every input which affects a
+// piece of generated HLSL, and gl::HLSLCache, a bounded map of such keys to generated text
+// which DynamicHLSL shares between every program in the process.
+
+#ifndef LIBGLESV2_HLSLCACHE_H_
+#define LIBGLESV2_HLSLCACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "common/angleutils.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace gl
+{
+
+class HLSLSignature
+{
+  public:
+    void addInt(int value)
+    {
+        mKey.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void addFloat(float value)
+    {
+        mKey.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void addString(const std::string &value)
+    {
+        addInt(static_cast<int>(value.length()));
+        mKey.append(value);
+    }
+
+    const std::string &key() const { return mKey; }
+
+  private:
+    std::string mKey;
+};
+
+// Contexts on different threads can link at the same time, so the entries are guarded by a
+// lock and found values are copied out while it is held. The cache is emptied when it fills up.
+template <typename T>
+class HLSLCache
+{
+  public:
+    static const size_t kMaxEntries = 512;
+
+    HLSLCache()
+    {
+#if defined(_WIN32)
+        InitializeCriticalSection(&mLock);
+#else
+        pthread_mutex_init(&mLock, NULL);
+#endif
+    }
+
+    ~HLSLCache()
+    {
+#if defined(_WIN32)
+        DeleteCriticalSection(&mLock);
+#else
+        pthread_mutex_destroy(&mLock);
+#endif
+    }
+
+    bool find(const std::string &key, T *value)
+    {
+        lock();
+
+        typename EntryMap::const_iterator entry = mEntries.find(key);
+        bool found = (entry != mEntries.end());
+        if (found)
+        {
+            *value = entry->second;
+        }
+
+        unlock();
+        return found;
+    }
+
+    void insert(const std::string &key, const T &value)
+    {
+        lock();
+
+        if (mEntries.size() >= kMaxEntries)
+        {
+            mEntries.clear();
+        }
+
+        mEntries[key] = value;
+
+        unlock();
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(HLSLCache);
+
+    void lock()
+    {
+#if defined(_WIN32)
+        EnterCriticalSection(&mLock);
+#else
+        pthread_mutex_lock(&mLock);
+#endif
+    }
+
+    void unlock()
+    {
+#if defined(_WIN32)
+        LeaveCriticalSection(&mLock);
+#else
+        pthread_mutex_unlock(&mLock);
+#endif
+    }
+
+    typedef std::unordered_map<std::string, T> EntryMap;
+
+#if defined(_WIN32)
+    CRITICAL_SECTION mLock;
+#else
+    pthread_mutex_t mLock;
+#endif
+    EntryMap mEntries;
+};
+
+template <typename T>
+const size_t HLSLCache<T>::kMaxEntries;
+
+}
+
+#endif   // LIBGLESV2_HLSLCACHE_H_
@@ -0,0 +1,156 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProfileCounters.cpp: Implements gl::ProfileScope and the per-thread profiling counters.
+
+#include "libGLESv2/ProfileCounters.h"
+
+#include "libGLESv2/main.h"
+
+namespace gl
+{
+
+volatile bool ProfileScope::mEnabled = false;
+
+namespace
+{
+
+unsigned long long TicksPerSecond()
+{
+    static unsigned long long ticksPerSecond = 0;
+
+    if (ticksPerSecond == 0)
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        ticksPerSecond = frequency.QuadPart;
+    }
+
+    return ticksPerSecond;
+}
+
+}
+
+void InitializeProfileCounters()
+{
+    char value[8];
+    DWORD length = GetEnvironmentVariableA("ANGLE_PROFILE_COUNTERS", value, ArraySize(value));
+    if (length > 0 && length < ArraySize(value) && strcmp(value, "0") != 0)
+    {
+        EnableProfileCounters();
+    }
+}
+
+void EnableProfileCounters()
+{
+    TicksPerSecond();
+    ProfileScope::mEnabled = true;
+}
+
+bool ProfileCountersEnabled()
+{
+    return ProfileScope::mEnabled;
+}
+
+void ResetProfileCounters(ProfileCounters *counters)
+{
+    // Scopes open on this thread keep their depth so they still close correctly
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+    {
+        ProfileCounter &counter = counters->stages[stage];
+        counter.calls = 0;
+        counter.ticks = 0;
+        counter.bytes = 0;
+    }
+}
+
+unsigned long long ProfileTicksToNanoseconds(unsigned long long ticks)
+{
+    unsigned long long ticksPerSecond = TicksPerSecond();
+
+    // Split to avoid overflowing for long runs
+    unsigned long long seconds = ticks / ticksPerSecond;
+    unsigned long long remainder = ticks % ticksPerSecond;
+    return seconds * 1000000000ULL + remainder * 1000000000ULL / ticksPerSecond;
+}
+
+bool GetProfileStage(GLenum name, ProfileStage *stage)
+{
+    switch (name)
+    {
+      case GL_PROFILE_VALIDATION_ANGLE:      *stage = PROFILE_STAGE_VALIDATION;      return true;
+      case GL_PROFILE_APPLY_STATE_ANGLE:     *stage = PROFILE_STAGE_APPLY_STATE;     return true;
+      case GL_PROFILE_VERTEX_DATA_ANGLE:     *stage = PROFILE_STAGE_VERTEX_DATA;     return true;
+      case GL_PROFILE_INDEX_DATA_ANGLE:      *stage = PROFILE_STAGE_INDEX_DATA;      return true;
+      case GL_PROFILE_APPLY_UNIFORMS_ANGLE:  *stage = PROFILE_STAGE_APPLY_UNIFORMS;  return true;
+      case GL_PROFILE_TEXTURE_LOAD_ANGLE:    *stage = PROFILE_STAGE_TEXTURE_LOAD;    return true;
+      case GL_PROFILE_REDUNDANT_STATE_ANGLE: *stage = PROFILE_STAGE_REDUNDANT_STATE; return true;
+      default:                               return false;
+    }
+}
+
+const char *GetProfileStageName(ProfileStage stage)
+{
+    switch (stage)
+    {
+      case PROFILE_STAGE_VALIDATION:      return "validation";
+      case PROFILE_STAGE_APPLY_STATE:     return "apply state";
+      case PROFILE_STAGE_VERTEX_DATA:     return "vertex data";
+      case PROFILE_STAGE_INDEX_DATA:      return "index data";
+      case PROFILE_STAGE_APPLY_UNIFORMS:  return "apply uniforms";
+      case PROFILE_STAGE_TEXTURE_LOAD:    return "texture load";
+      case PROFILE_STAGE_REDUNDANT_STATE: return "redundant state";
+      default: UNREACHABLE();             return "";
+    }
+}
+
+void TraceProfileCounters(const ProfileCounters &counters)
+{
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++)
+    {
+        TRACE("Profile counters for %s: %llu calls, %llu ns, %llu bytes", GetProfileStageName(static_cast<ProfileStage>(stage)),
+              counters.stages[stage].calls, ProfileTicksToNanoseconds(counters.stages[stage].ticks), counters.stages[stage].bytes);
+    }
+}
+
+void ProfileScope::begin(ProfileStage stage)
+{
+    ProfileCounters *counters = getProfileCounters();
+    if (!counters)
+    {
+        return;
+    }
+
+    mCounter = &counters->stages[stage];
+    if (mCounter->depth++ == 0)
+    {
+        QueryPerformanceCounter(&mStart);
+    }
+}
+
+void ProfileScope::addCall(ProfileStage stage)
+{
+    ProfileCounters *counters = getProfileCounters();
+    if (counters)
+    {
+        counters->stages[stage].calls++;
+    }
+}
+
+void ProfileScope::end()
+{
+    if (--mCounter->depth == 0)
+    {
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+
+        mCounter->calls++;
+        mCounter->ticks += now.QuadPart - mStart.QuadPart;
+    }
+}
+
+}
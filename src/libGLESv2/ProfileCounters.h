@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProfileCounters.h: Defines gl::ProfileScope and the per-thread counters it accumulates
+// the CPU time, call count and bytes processed of the stages of a draw call into. The
+// counters are read and reset through the GL_ANGLE_profile_counters extension.
+
+#ifndef LIBGLESV2_PROFILECOUNTERS_H_
+#define LIBGLESV2_PROFILECOUNTERS_H_
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+enum ProfileStage
+{
+    PROFILE_STAGE_VALIDATION,
+    PROFILE_STAGE_APPLY_STATE,
+    PROFILE_STAGE_VERTEX_DATA,
+    PROFILE_STAGE_INDEX_DATA,
+    PROFILE_STAGE_APPLY_UNIFORMS,
+    PROFILE_STAGE_TEXTURE_LOAD,
+
+    // State changes the context dropped because they set the current value, which take no
+    // measured time. Read and reset once per frame, they count the redundant calls of a frame.
+    PROFILE_STAGE_REDUNDANT_STATE,
+
+    PROFILE_STAGE_COUNT
+};
+
+struct ProfileCounter
+{
+    unsigned long long calls;
+    unsigned long long ticks;
+    unsigned long long bytes;
+
+    // Nested scopes of the same stage are counted once, by the outermost scope
+    unsigned int depth;
+};
+
+// Zero-initialized as part of the thread's gl::Current
+struct ProfileCounters
+{
+    ProfileCounter stages[PROFILE_STAGE_COUNT];
+};
+
+// Counting is off unless the ANGLE_PROFILE_COUNTERS environment variable is set, or until
+// the application first resets the counters through the extension.
+void InitializeProfileCounters();
+void EnableProfileCounters();
+bool ProfileCountersEnabled();
+
+void ResetProfileCounters(ProfileCounters *counters);
+unsigned long long ProfileTicksToNanoseconds(unsigned long long ticks);
+
+bool GetProfileStage(GLenum name, ProfileStage *stage);
+const char *GetProfileStageName(ProfileStage stage);
+
+void TraceProfileCounters(const ProfileCounters &counters);
+
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(ProfileStage stage)
+        : mCounter(NULL)
+    {
+        if (mEnabled)
+        {
+            begin(stage);
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (mCounter)
+        {
+            end();
+        }
+    }
+
+    void addBytes(unsigned long long bytes)
+    {
+        if (mCounter)
+        {
+            mCounter->bytes += bytes;
+        }
+    }
+
+    // Counts a call of the stage without timing it
+    static void count(ProfileStage stage)
+    {
+        if (mEnabled)
+        {
+            addCall(stage);
+        }
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ProfileScope);
+
+    friend void EnableProfileCounters();
+    friend bool ProfileCountersEnabled();
+
+    void begin(ProfileStage stage);
+    void end();
+    static void addCall(ProfileStage stage);
+
+    ProfileCounter *mCounter;
+    LARGE_INTEGER mStart;
+
+    static volatile bool mEnabled;
+};
+
+}
+
+#endif   // LIBGLESV2_PROFILECOUNTERS_H_
@@ -9,6 +9,8 @@
 // and related functionality. [OpenGL ES 2.0.24] section 2.10.3 page 28.
 
 #include "libGLESv2/Program.h"
+#include "libGLESv2/BinaryStream.h"
+#include "libGLESv2/DiskCache.h"
 #include "libGLESv2/ProgramBinary.h"
 #include "libGLESv2/ResourceManager.h"
 
@@ -247,12 +249,62 @@ bool Program::link()
     mInfoLog.reset();
     resetUniformBlockBindings();
 
+    DiskCache *diskCache = DiskCache::getInstance();
+    std::string cacheKey;
+
+    if (diskCache && mFragmentShader && mVertexShader && mFragmentShader->isCompiled() && mVertexShader->isCompiled() &&
+        !mFragmentShader->getCacheKey().empty() && !mVertexShader->getCacheKey().empty())
+    {
+        cacheKey = computeLinkCacheKey();
+
+        std::vector<char> binary;
+        if (diskCache->get(cacheKey, &binary) && !binary.empty())
+        {
+            mProgramBinary.set(new ProgramBinary(mRenderer));
+            mLinked = mProgramBinary->load(mInfoLog, &binary[0], binary.size());
+
+            if (mLinked)
+            {
+                return true;
+            }
+
+            // The cached binary is unusable, fall back to a full link
+            mInfoLog.reset();
+        }
+    }
+
     mProgramBinary.set(new ProgramBinary(mRenderer));
     mLinked = mProgramBinary->link(mInfoLog, mAttributeBindings, mFragmentShader, mVertexShader);
 
+    if (mLinked && !cacheKey.empty())
+    {
+        GLint binaryLength = mProgramBinary->getLength();
+        if (binaryLength > 0)
+        {
+            std::vector<char> binary(binaryLength);
+            if (mProgramBinary->save(&binary[0], binaryLength, NULL))
+            {
+                diskCache->put(cacheKey, &binary[0], binary.size());
+            }
+        }
+    }
+
     return mLinked;
 }
 
+// The translation keys of both shaders already cover their sources, the compile options,
+// the renderer and the ANGLE revision
+std::string Program::computeLinkCacheKey() const
+{
+    BinaryOutputStream stream;
+
+    stream.write(mVertexShader->getCacheKey());
+    stream.write(mFragmentShader->getCacheKey());
+    mAttributeBindings.serialize(&stream);
+
+    return DiskCache::computeKey(stream.data(), stream.length());
+}
+
 int AttributeBindings::getAttributeBinding(const std::string &name) const
 {
     for (int location = 0; location < MAX_VERTEX_ATTRIBS; location++)
@@ -266,6 +318,20 @@ int AttributeBindings::getAttributeBinding(const std::string &name) const
     return -1;
 }
 
+void AttributeBindings::serialize(BinaryOutputStream *stream) const
+{
+    for (int location = 0; location < MAX_VERTEX_ATTRIBS; location++)
+    {
+        const std::set<std::string> &names = mAttributeBinding[location];
+
+        stream->write(names.size());
+        for (std::set<std::string>::const_iterator name = names.begin(); name != names.end(); name++)
+        {
+            stream->write(*name);
+        }
+    }
+}
+
 // Returns the program object to an unlinked state, before re-linking, or at destruction
 void Program::unlink(bool destroy)
 {
@@ -29,6 +29,7 @@ class FragmentShader;
 class VertexShader;
 class ProgramBinary;
 class Shader;
+class BinaryOutputStream;
 
 extern const char * const g_fakepath;
 
@@ -40,6 +41,7 @@ class AttributeBindings
 
     void bindAttributeLocation(GLuint index, const char *name);
     int getAttributeBinding(const std::string &name) const;
+    void serialize(BinaryOutputStream *stream) const;
 
   private:
     std::set<std::string> mAttributeBinding[MAX_VERTEX_ATTRIBS];
@@ -114,6 +116,7 @@ class Program
 
     void unlink(bool destroy = false);
     void resetUniformBlockBindings();
+    std::string computeLinkCacheKey() const;
 
     FragmentShader *mFragmentShader;
     VertexShader *mVertexShader;
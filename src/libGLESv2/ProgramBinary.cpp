@@ -10,6 +10,7 @@
 
 #include "libGLESv2/BinaryStream.h"
 #include "libGLESv2/ProgramBinary.h"
+#include "libGLESv2/ProgramBinaryFormat.h"
 #include "libGLESv2/renderer/ShaderExecutable.h"
 
 #include "common/debug.h"
@@ -863,6 +864,8 @@ void ProgramBinary::dirtyAllUniforms()
 // Applies all the uniforms set for this program object to the renderer
 void ProgramBinary::applyUniforms()
 {
+    ProfileScope profile(PROFILE_STAGE_APPLY_UNIFORMS);
+
     // Retrieve sampler uniform values
     for (size_t uniformIndex = 0; uniformIndex < mUniforms.size(); uniformIndex++)
     {
@@ -1004,6 +1007,274 @@ bool ProgramBinary::linkVaryings(InfoLog &infoLog, FragmentShader *fragmentShade
 }
 
 bool ProgramBinary::load(InfoLog &infoLog, const void *binary, GLsizei length)
+{
+    if (ProgramBinaryReader::IsCompactFormat(binary, length))
+    {
+        // The reader accesses records in place, which requires the binary to be 4-byte aligned
+        if (reinterpret_cast<uintptr_t>(binary) % sizeof(GLuint) != 0)
+        {
+            std::vector<GLuint> alignedBinary((length + sizeof(GLuint) - 1) / sizeof(GLuint));
+            memcpy(&alignedBinary[0], binary, length);
+            return loadCompact(infoLog, &alignedBinary[0], length);
+        }
+
+        return loadCompact(infoLog, binary, length);
+    }
+
+    return loadLegacy(infoLog, binary, length);
+}
+
+bool ProgramBinary::loadCompact(InfoLog &infoLog, const void *binary, GLsizei length)
+{
+    ProgramBinaryReader reader(binary, length);
+
+    if (!reader.validate())
+    {
+        infoLog.append("Invalid program binary.");
+        return false;
+    }
+
+    const ProgramBinaryHeader &header = reader.header();
+
+    if (header.majorVersion != ANGLE_MAJOR_VERSION || header.minorVersion != ANGLE_MINOR_VERSION ||
+        memcmp(header.commitHash, ANGLE_COMMIT_HASH, sizeof(unsigned char) * ANGLE_COMMIT_HASH_SIZE) != 0)
+    {
+        infoLog.append("Invalid program binary version.");
+        return false;
+    }
+
+    if (header.compileFlags != ANGLE_COMPILE_OPTIMIZATION_LEVEL)
+    {
+        infoLog.append("Mismatched compilation flags.");
+        return false;
+    }
+
+    GUID identifier = mRenderer->getAdapterIdentifier();
+    if (memcmp(&identifier, header.adapterIdentifier, sizeof(GUID)) != 0)
+    {
+        infoLog.append("Invalid program binary.");
+        return false;
+    }
+
+    GLuint attributeCount = 0;
+    const ProgramBinaryAttribute *attributes = reader.getRecords<ProgramBinaryAttribute>(PROGRAM_BINARY_SECTION_ATTRIBUTES, &attributeCount);
+    for (GLuint recordIndex = 0; recordIndex < attributeCount; recordIndex++)
+    {
+        const ProgramBinaryAttribute &record = attributes[recordIndex];
+        const char *linkedName = reader.getString(record.linkedName);
+        const char *shaderName = reader.getString(record.shaderName);
+
+        if (record.attributeIndex >= MAX_VERTEX_ATTRIBS || !linkedName || !shaderName)
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        const GLuint attributeIndex = record.attributeIndex;
+        mLinkedAttribute[attributeIndex].type = record.linkedType;
+        mLinkedAttribute[attributeIndex].name.assign(linkedName, record.linkedName.length);
+        mShaderAttributes[attributeIndex].type = record.shaderType;
+        mShaderAttributes[attributeIndex].name.assign(shaderName, record.shaderName.length);
+        mSemanticIndex[attributeIndex] = record.semanticIndex;
+    }
+
+    initAttributesByLayout();
+
+    GLuint samplerCount = 0;
+    const ProgramBinarySampler *samplers = reader.getRecords<ProgramBinarySampler>(PROGRAM_BINARY_SECTION_SAMPLERS, &samplerCount);
+    for (GLuint recordIndex = 0; recordIndex < samplerCount; recordIndex++)
+    {
+        const ProgramBinarySampler &record = samplers[recordIndex];
+        Sampler *sampler = NULL;
+
+        if (record.shaderType == GL_FRAGMENT_SHADER && record.samplerIndex < ArraySize(mSamplersPS))
+        {
+            sampler = &mSamplersPS[record.samplerIndex];
+        }
+        else if (record.shaderType == GL_VERTEX_SHADER && record.samplerIndex < ArraySize(mSamplersVS))
+        {
+            sampler = &mSamplersVS[record.samplerIndex];
+        }
+        else
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        sampler->active = true;
+        sampler->logicalTextureUnit = record.logicalTextureUnit;
+        sampler->textureType = static_cast<TextureType>(record.textureType);
+    }
+
+    mUsedVertexSamplerRange = header.usedVertexSamplerRange;
+    mUsedPixelSamplerRange = header.usedPixelSamplerRange;
+    mUsesPointSize = (header.usesPointSize != 0);
+    mShaderVersion = header.shaderVersion;
+
+    GLuint uniformCount = 0;
+    const ProgramBinaryUniform *uniforms = reader.getRecords<ProgramBinaryUniform>(PROGRAM_BINARY_SECTION_UNIFORMS, &uniformCount);
+    mUniforms.reserve(uniformCount);
+    for (GLuint uniformIndex = 0; uniformIndex < uniformCount; uniformIndex++)
+    {
+        const ProgramBinaryUniform &record = uniforms[uniformIndex];
+        const char *name = reader.getString(record.name);
+
+        if (!name)
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        const sh::BlockMemberInfo blockInfo(record.offset, record.arrayStride, record.matrixStride, record.isRowMajorMatrix != 0);
+        Uniform *uniform = new Uniform(record.type, record.precision, std::string(name, record.name.length),
+                                       record.arraySize, record.blockIndex, blockInfo);
+
+        uniform->psRegisterIndex = record.psRegisterIndex;
+        uniform->vsRegisterIndex = record.vsRegisterIndex;
+        uniform->registerCount = record.registerCount;
+        uniform->registerElement = record.registerElement;
+
+        mUniforms.push_back(uniform);
+    }
+
+    GLuint blockMemberCount = 0;
+    const GLuint *blockMembers = reader.getRecords<GLuint>(PROGRAM_BINARY_SECTION_BLOCK_MEMBERS, &blockMemberCount);
+
+    GLuint uniformBlockCount = 0;
+    const ProgramBinaryUniformBlock *uniformBlocks = reader.getRecords<ProgramBinaryUniformBlock>(PROGRAM_BINARY_SECTION_UNIFORM_BLOCKS, &uniformBlockCount);
+    mUniformBlocks.reserve(uniformBlockCount);
+    for (GLuint uniformBlockIndex = 0; uniformBlockIndex < uniformBlockCount; uniformBlockIndex++)
+    {
+        const ProgramBinaryUniformBlock &record = uniformBlocks[uniformBlockIndex];
+        const char *name = reader.getString(record.name);
+
+        if (!name || record.firstMember > blockMemberCount || record.memberCount > blockMemberCount - record.firstMember)
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        UniformBlock *uniformBlock = new UniformBlock(std::string(name, record.name.length), record.elementIndex, record.dataSize);
+        uniformBlock->psRegisterIndex = record.psRegisterIndex;
+        uniformBlock->vsRegisterIndex = record.vsRegisterIndex;
+        uniformBlock->memberUniformIndexes.assign(blockMembers + record.firstMember,
+                                                  blockMembers + record.firstMember + record.memberCount);
+
+        mUniformBlocks.push_back(uniformBlock);
+    }
+
+    GLuint uniformIndexCount = 0;
+    const ProgramBinaryUniformIndex *uniformIndex = reader.getRecords<ProgramBinaryUniformIndex>(PROGRAM_BINARY_SECTION_UNIFORM_INDEX, &uniformIndexCount);
+    mUniformIndex.resize(uniformIndexCount);
+    for (GLuint locationIndex = 0; locationIndex < uniformIndexCount; locationIndex++)
+    {
+        const ProgramBinaryUniformIndex &record = uniformIndex[locationIndex];
+        const char *name = reader.getString(record.name);
+
+        if (!name)
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        mUniformIndex[locationIndex].name.assign(name, record.name.length);
+        mUniformIndex[locationIndex].element = record.element;
+        mUniformIndex[locationIndex].index = record.index;
+    }
+
+    GLuint outputVariableCount = 0;
+    const ProgramBinaryOutputVariable *outputVariables = reader.getRecords<ProgramBinaryOutputVariable>(PROGRAM_BINARY_SECTION_OUTPUT_VARIABLES, &outputVariableCount);
+    for (GLuint outputVariableIndex = 0; outputVariableIndex < outputVariableCount; outputVariableIndex++)
+    {
+        const ProgramBinaryOutputVariable &record = outputVariables[outputVariableIndex];
+        const char *name = reader.getString(record.name);
+
+        if (!name)
+        {
+            infoLog.append("Invalid program binary.");
+            return false;
+        }
+
+        mOutputVariables[record.location] = VariableLocation(std::string(name, record.name.length), record.element, record.index);
+    }
+
+    const char *vertexHLSL = reader.getString(header.vertexHLSL);
+    if (!vertexHLSL)
+    {
+        infoLog.append("Invalid program binary.");
+        return false;
+    }
+
+    mVertexHLSL.assign(vertexHLSL, header.vertexHLSL.length);
+    mVertexWorkarounds = static_cast<rx::D3DWorkaroundType>(header.vertexWorkarounds);
+
+    GLuint vertexExecutableCount = 0;
+    const ProgramBinaryVertexExecutable *vertexExecutables = reader.getRecords<ProgramBinaryVertexExecutable>(PROGRAM_BINARY_SECTION_VERTEX_EXECUTABLES, &vertexExecutableCount);
+    for (GLuint vertexExecutableIndex = 0; vertexExecutableIndex < vertexExecutableCount; vertexExecutableIndex++)
+    {
+        const ProgramBinaryVertexExecutable &record = vertexExecutables[vertexExecutableIndex];
+
+        VertexFormat vertexInputs[gl::MAX_VERTEX_ATTRIBS];
+        for (size_t inputIndex = 0; inputIndex < gl::MAX_VERTEX_ATTRIBS; inputIndex++)
+        {
+            const ProgramBinaryVertexInput &input = record.inputs[inputIndex];
+            vertexInputs[inputIndex] = VertexFormat(input.type, static_cast<GLboolean>(input.normalized), input.components, input.pureInteger != 0);
+        }
+
+        const void *vertexShaderFunction = reader.getBlob(record.executable);
+        rx::ShaderExecutable *shaderExecutable = NULL;
+        if (vertexShaderFunction)
+        {
+            shaderExecutable = mRenderer->loadExecutable(static_cast<const DWORD*>(vertexShaderFunction),
+                                                         record.executable.length, rx::SHADER_VERTEX);
+        }
+
+        if (!shaderExecutable)
+        {
+            infoLog.append("Could not create vertex shader.");
+            return false;
+        }
+
+        mVertexExecutables.push_back(new VertexExecutable(mRenderer, vertexInputs, shaderExecutable));
+    }
+
+    const void *pixelShaderFunction = reader.getBlob(header.pixelExecutable);
+    if (pixelShaderFunction)
+    {
+        mPixelExecutable = mRenderer->loadExecutable(static_cast<const DWORD*>(pixelShaderFunction),
+                                                     header.pixelExecutable.length, rx::SHADER_PIXEL);
+    }
+
+    if (!mPixelExecutable)
+    {
+        infoLog.append("Could not create pixel shader.");
+        return false;
+    }
+
+    if (header.geometryExecutable.length > 0)
+    {
+        const void *geometryShaderFunction = reader.getBlob(header.geometryExecutable);
+        if (geometryShaderFunction)
+        {
+            mGeometryExecutable = mRenderer->loadExecutable(static_cast<const DWORD*>(geometryShaderFunction),
+                                                            header.geometryExecutable.length, rx::SHADER_GEOMETRY);
+        }
+
+        if (!mGeometryExecutable)
+        {
+            infoLog.append("Could not create geometry shader.");
+            SafeDelete(mPixelExecutable);
+            return false;
+        }
+    }
+
+    initializeUniformStorage();
+
+    return true;
+}
+
+// Loads binaries saved in the field-by-field stream format used before the compact layout
+bool ProgramBinary::loadLegacy(InfoLog &infoLog, const void *binary, GLsizei length)
 {
     BinaryInputStream stream(binary, length);
 
@@ -1256,138 +1527,163 @@ bool ProgramBinary::load(InfoLog &infoLog, const void *binary, GLsizei length)
 
 bool ProgramBinary::save(void* binary, GLsizei bufSize, GLsizei *length)
 {
-    BinaryOutputStream stream;
+    ProgramBinaryWriter writer;
+    ProgramBinaryHeader *header = writer.header();
+
+    header->majorVersion = ANGLE_MAJOR_VERSION;
+    header->minorVersion = ANGLE_MINOR_VERSION;
+    header->compileFlags = ANGLE_COMPILE_OPTIMIZATION_LEVEL;
+    memcpy(header->commitHash, ANGLE_COMMIT_HASH, sizeof(unsigned char) * ANGLE_COMMIT_HASH_SIZE);
+
+    GUID identifier = mRenderer->getAdapterIdentifier();
+    memcpy(header->adapterIdentifier, &identifier, sizeof(GUID));
 
-    stream.write(GL_PROGRAM_BINARY_ANGLE);
-    stream.write(ANGLE_MAJOR_VERSION);
-    stream.write(ANGLE_MINOR_VERSION);
-    stream.write(ANGLE_COMMIT_HASH, ANGLE_COMMIT_HASH_SIZE);
-    stream.write(ANGLE_COMPILE_OPTIMIZATION_LEVEL);
+    header->shaderVersion = mShaderVersion;
+    header->usedVertexSamplerRange = mUsedVertexSamplerRange;
+    header->usedPixelSamplerRange = mUsedPixelSamplerRange;
+    header->usesPointSize = mUsesPointSize ? 1 : 0;
+    header->vertexWorkarounds = mVertexWorkarounds;
+    header->vertexHLSL = writer.addString(mVertexHLSL);
 
-    for (unsigned int i = 0; i < MAX_VERTEX_ATTRIBS; ++i)
+    // Only attribute slots that carry information are stored; the others keep their defaults on load
+    for (unsigned int attributeIndex = 0; attributeIndex < MAX_VERTEX_ATTRIBS; attributeIndex++)
     {
-        stream.write(mLinkedAttribute[i].type);
-        stream.write(mLinkedAttribute[i].name);
-        stream.write(mShaderAttributes[i].type);
-        stream.write(mShaderAttributes[i].name);
-        stream.write(mSemanticIndex[i]);
+        const sh::Attribute &linkedAttribute = mLinkedAttribute[attributeIndex];
+        const sh::Attribute &shaderAttribute = mShaderAttributes[attributeIndex];
+
+        if (linkedAttribute.type == GL_NONE && shaderAttribute.type == GL_NONE && mSemanticIndex[attributeIndex] == -1)
+        {
+            continue;
+        }
+
+        ProgramBinaryAttribute record;
+        record.attributeIndex = attributeIndex;
+        record.linkedType = linkedAttribute.type;
+        record.linkedName = writer.addString(linkedAttribute.name);
+        record.shaderType = shaderAttribute.type;
+        record.shaderName = writer.addString(shaderAttribute.name);
+        record.semanticIndex = mSemanticIndex[attributeIndex];
+        writer.addRecord(PROGRAM_BINARY_SECTION_ATTRIBUTES, record);
     }
 
-    for (unsigned int i = 0; i < MAX_TEXTURE_IMAGE_UNITS; ++i)
+    for (unsigned int samplerIndex = 0; samplerIndex < MAX_TEXTURE_IMAGE_UNITS; samplerIndex++)
     {
-        stream.write(mSamplersPS[i].active);
-        stream.write(mSamplersPS[i].logicalTextureUnit);
-        stream.write((int) mSamplersPS[i].textureType);
+        if (mSamplersPS[samplerIndex].active)
+        {
+            ProgramBinarySampler record;
+            record.shaderType = GL_FRAGMENT_SHADER;
+            record.samplerIndex = samplerIndex;
+            record.logicalTextureUnit = mSamplersPS[samplerIndex].logicalTextureUnit;
+            record.textureType = mSamplersPS[samplerIndex].textureType;
+            writer.addRecord(PROGRAM_BINARY_SECTION_SAMPLERS, record);
+        }
     }
 
-    for (unsigned int i = 0; i < IMPLEMENTATION_MAX_VERTEX_TEXTURE_IMAGE_UNITS; ++i)
+    for (unsigned int samplerIndex = 0; samplerIndex < IMPLEMENTATION_MAX_VERTEX_TEXTURE_IMAGE_UNITS; samplerIndex++)
     {
-        stream.write(mSamplersVS[i].active);
-        stream.write(mSamplersVS[i].logicalTextureUnit);
-        stream.write((int) mSamplersVS[i].textureType);
+        if (mSamplersVS[samplerIndex].active)
+        {
+            ProgramBinarySampler record;
+            record.shaderType = GL_VERTEX_SHADER;
+            record.samplerIndex = samplerIndex;
+            record.logicalTextureUnit = mSamplersVS[samplerIndex].logicalTextureUnit;
+            record.textureType = mSamplersVS[samplerIndex].textureType;
+            writer.addRecord(PROGRAM_BINARY_SECTION_SAMPLERS, record);
+        }
     }
 
-    stream.write(mUsedVertexSamplerRange);
-    stream.write(mUsedPixelSamplerRange);
-    stream.write(mUsesPointSize);
-    stream.write(mShaderVersion);
-
-    stream.write(mUniforms.size());
     for (size_t uniformIndex = 0; uniformIndex < mUniforms.size(); ++uniformIndex)
     {
         const Uniform &uniform = *mUniforms[uniformIndex];
 
-        stream.write(uniform.type);
-        stream.write(uniform.precision);
-        stream.write(uniform.name);
-        stream.write(uniform.arraySize);
-        stream.write(uniform.blockIndex);
-
-        stream.write(uniform.blockInfo.offset);
-        stream.write(uniform.blockInfo.arrayStride);
-        stream.write(uniform.blockInfo.matrixStride);
-        stream.write(uniform.blockInfo.isRowMajorMatrix);
-
-        stream.write(uniform.psRegisterIndex);
-        stream.write(uniform.vsRegisterIndex);
-        stream.write(uniform.registerCount);
-        stream.write(uniform.registerElement);
-    }
-
-    stream.write(mUniformBlocks.size());
+        ProgramBinaryUniform record;
+        record.type = uniform.type;
+        record.precision = uniform.precision;
+        record.name = writer.addString(uniform.name);
+        record.arraySize = uniform.arraySize;
+        record.blockIndex = uniform.blockIndex;
+        record.offset = uniform.blockInfo.offset;
+        record.arrayStride = uniform.blockInfo.arrayStride;
+        record.matrixStride = uniform.blockInfo.matrixStride;
+        record.isRowMajorMatrix = uniform.blockInfo.isRowMajorMatrix ? 1 : 0;
+        record.psRegisterIndex = uniform.psRegisterIndex;
+        record.vsRegisterIndex = uniform.vsRegisterIndex;
+        record.registerCount = uniform.registerCount;
+        record.registerElement = uniform.registerElement;
+        writer.addRecord(PROGRAM_BINARY_SECTION_UNIFORMS, record);
+    }
+
+    GLuint blockMemberCount = 0;
     for (size_t uniformBlockIndex = 0; uniformBlockIndex < mUniformBlocks.size(); ++uniformBlockIndex)
     {
-        const UniformBlock& uniformBlock = *mUniformBlocks[uniformBlockIndex];
+        const UniformBlock &uniformBlock = *mUniformBlocks[uniformBlockIndex];
 
-        stream.write(uniformBlock.name);
-        stream.write(uniformBlock.elementIndex);
-        stream.write(uniformBlock.dataSize);
+        ProgramBinaryUniformBlock record;
+        record.name = writer.addString(uniformBlock.name);
+        record.elementIndex = uniformBlock.elementIndex;
+        record.dataSize = uniformBlock.dataSize;
+        record.psRegisterIndex = uniformBlock.psRegisterIndex;
+        record.vsRegisterIndex = uniformBlock.vsRegisterIndex;
+        record.firstMember = blockMemberCount;
+        record.memberCount = static_cast<GLuint>(uniformBlock.memberUniformIndexes.size());
+        writer.addRecord(PROGRAM_BINARY_SECTION_UNIFORM_BLOCKS, record);
 
-        stream.write(uniformBlock.memberUniformIndexes.size());
-        for (unsigned int blockMemberIndex = 0; blockMemberIndex < uniformBlock.memberUniformIndexes.size(); blockMemberIndex++)
+        for (size_t blockMemberIndex = 0; blockMemberIndex < uniformBlock.memberUniformIndexes.size(); blockMemberIndex++)
         {
-            stream.write(uniformBlock.memberUniformIndexes[blockMemberIndex]);
+            GLuint memberUniformIndex = uniformBlock.memberUniformIndexes[blockMemberIndex];
+            writer.addRecord(PROGRAM_BINARY_SECTION_BLOCK_MEMBERS, memberUniformIndex);
         }
-
-        stream.write(uniformBlock.psRegisterIndex);
-        stream.write(uniformBlock.vsRegisterIndex);
+        blockMemberCount += record.memberCount;
     }
 
-    stream.write(mUniformIndex.size());
-    for (size_t i = 0; i < mUniformIndex.size(); ++i)
+    for (size_t locationIndex = 0; locationIndex < mUniformIndex.size(); ++locationIndex)
     {
-        stream.write(mUniformIndex[i].name);
-        stream.write(mUniformIndex[i].element);
-        stream.write(mUniformIndex[i].index);
+        ProgramBinaryUniformIndex record;
+        record.name = writer.addString(mUniformIndex[locationIndex].name);
+        record.element = mUniformIndex[locationIndex].element;
+        record.index = mUniformIndex[locationIndex].index;
+        writer.addRecord(PROGRAM_BINARY_SECTION_UNIFORM_INDEX, record);
     }
 
-    stream.write(mVertexHLSL);
-    stream.write(mVertexWorkarounds);
-
-    UINT vertexShadersTotalSize = 0;
+    for (auto locationIt = mOutputVariables.begin(); locationIt != mOutputVariables.end(); locationIt++)
+    {
+        ProgramBinaryOutputVariable record;
+        record.location = locationIt->first;
+        record.name = writer.addString(locationIt->second.name);
+        record.element = locationIt->second.element;
+        record.index = locationIt->second.index;
+        writer.addRecord(PROGRAM_BINARY_SECTION_OUTPUT_VARIABLES, record);
+    }
 
-    stream.write(mVertexExecutables.size());
     for (size_t vertexExecutableIndex = 0; vertexExecutableIndex < mVertexExecutables.size(); vertexExecutableIndex++)
     {
         VertexExecutable *vertexExecutable = mVertexExecutables[vertexExecutableIndex];
 
+        ProgramBinaryVertexExecutable record;
         for (size_t inputIndex = 0; inputIndex < gl::MAX_VERTEX_ATTRIBS; inputIndex++)
         {
             const VertexFormat &vertexInput = vertexExecutable->inputs()[inputIndex];
-            stream.write(vertexInput.mType);
-            stream.write(vertexInput.mNormalized);
-            stream.write(vertexInput.mComponents);
-            stream.write(vertexInput.mPureInteger);
+            record.inputs[inputIndex].type = vertexInput.mType;
+            record.inputs[inputIndex].components = vertexInput.mComponents;
+            record.inputs[inputIndex].normalized = vertexInput.mNormalized;
+            record.inputs[inputIndex].pureInteger = vertexInput.mPureInteger ? 1 : 0;
         }
 
-        UINT vertexShaderSize = vertexExecutable->shaderExecutable()->getLength();
-        stream.write(vertexShaderSize);
-
-        unsigned char *vertexBlob = static_cast<unsigned char *>(vertexExecutable->shaderExecutable()->getFunction());
-        stream.write(vertexBlob, vertexShaderSize);
+        rx::ShaderExecutable *shaderExecutable = vertexExecutable->shaderExecutable();
+        record.executable = writer.addBlob(shaderExecutable->getFunction(), shaderExecutable->getLength());
+        writer.addRecord(PROGRAM_BINARY_SECTION_VERTEX_EXECUTABLES, record);
     }
 
-    UINT pixelShaderSize = mPixelExecutable->getLength();
-    stream.write(pixelShaderSize);
+    header->pixelExecutable = writer.addBlob(mPixelExecutable->getFunction(), mPixelExecutable->getLength());
 
-    unsigned char *pixelBlob = static_cast<unsigned char *>(mPixelExecutable->getFunction());
-    stream.write(pixelBlob, pixelShaderSize);
-
-    UINT geometryShaderSize = (mGeometryExecutable != NULL) ? mGeometryExecutable->getLength() : 0;
-    stream.write(geometryShaderSize);
-
-    if (mGeometryExecutable != NULL && geometryShaderSize > 0)
+    if (mGeometryExecutable != NULL && mGeometryExecutable->getLength() > 0)
     {
-        unsigned char *geometryBlob = static_cast<unsigned char *>(mGeometryExecutable->getFunction());
-        stream.write(geometryBlob, geometryShaderSize);
+        header->geometryExecutable = writer.addBlob(mGeometryExecutable->getFunction(), mGeometryExecutable->getLength());
     }
 
-    GUID identifier = mRenderer->getAdapterIdentifier();
+    writer.finalize();
 
-    GLsizei streamLength = stream.length();
-    const void *streamData = stream.data();
-
-    GLsizei totalLength = streamLength + sizeof(GUID);
+    GLsizei totalLength = static_cast<GLsizei>(writer.length());
     if (totalLength > bufSize)
     {
         if (length)
@@ -1400,15 +1696,7 @@ bool ProgramBinary::save(void* binary, GLsizei bufSize, GLsizei *length)
 
     if (binary)
     {
-        char *ptr = (char*) binary;
-
-        memcpy(ptr, streamData, streamLength);
-        ptr += streamLength;
-
-        memcpy(ptr, &identifier, sizeof(GUID));
-        ptr += sizeof(GUID);
-
-        ASSERT(ptr - totalLength == binary);
+        memcpy(binary, writer.data(), totalLength);
     }
 
     if (length)
@@ -2431,6 +2719,8 @@ void ProgramBinary::validate(InfoLog &infoLog)
 
 bool ProgramBinary::validateSamplers(InfoLog *infoLog)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     // if any two active samplers in a program are of different types, but refer to the same
     // texture image unit, and this is the current program, then ValidateProgram will fail, and
     // DrawArrays and DrawElements will issue the INVALID_OPERATION error.
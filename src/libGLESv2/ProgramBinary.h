@@ -153,6 +153,9 @@ class ProgramBinary : public RefCountObject
   private:
     DISALLOW_COPY_AND_ASSIGN(ProgramBinary);
 
+    bool loadCompact(InfoLog &infoLog, const void *binary, GLsizei length);
+    bool loadLegacy(InfoLog &infoLog, const void *binary, GLsizei length);
+
     bool linkVaryings(InfoLog &infoLog, FragmentShader *fragmentShader, VertexShader *vertexShader);
     bool linkAttributes(InfoLog &infoLog, const AttributeBindings &attributeBindings, FragmentShader *fragmentShader, VertexShader *vertexShader);
 
@@ -0,0 +1,211 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProgramBinaryFormat.cpp: Implements the writer and the in-place reader for the compact
+// gl::ProgramBinary layout.
+
+#include "libGLESv2/ProgramBinaryFormat.h"
+
+#include "common/mathutil.h"
+#include "third_party/murmurhash/MurmurHash3.h"
+
+namespace gl
+{
+
+namespace
+{
+
+const uint32_t ChecksumSeed = 0x93A6;
+
+// Sections and pool entries are kept 4-byte aligned so records can be read in place
+const size_t SectionAlignment = 4;
+
+GLuint ComputeChecksum(const char *data, size_t length)
+{
+    uint32_t checksum = 0;
+    MurmurHash3_x86_32(data, static_cast<int>(length), ChecksumSeed, &checksum);
+    return checksum;
+}
+
+void AppendPadding(std::vector<char> *data)
+{
+    data->resize(rx::roundUp(data->size(), SectionAlignment), 0);
+}
+
+}
+
+ProgramBinaryWriter::ProgramBinaryWriter()
+{
+    StructZero(&mHeader);
+
+    for (unsigned int section = 0; section < PROGRAM_BINARY_SECTION_COUNT; section++)
+    {
+        mCounts[section] = 0;
+        mStrides[section] = 0;
+    }
+
+    mStrides[PROGRAM_BINARY_SECTION_STRINGS] = 1;
+    mStrides[PROGRAM_BINARY_SECTION_BLOBS] = 1;
+}
+
+ProgramBinaryRange ProgramBinaryWriter::addString(const std::string &str)
+{
+    std::vector<char> &pool = mSections[PROGRAM_BINARY_SECTION_STRINGS];
+
+    ProgramBinaryRange range;
+    range.offset = static_cast<GLuint>(pool.size());
+    range.length = static_cast<GLuint>(str.length());
+
+    pool.insert(pool.end(), str.begin(), str.end());
+    pool.push_back('\0');
+
+    return range;
+}
+
+ProgramBinaryRange ProgramBinaryWriter::addBlob(const void *data, size_t length)
+{
+    std::vector<char> &pool = mSections[PROGRAM_BINARY_SECTION_BLOBS];
+
+    ProgramBinaryRange range;
+    range.offset = static_cast<GLuint>(pool.size());
+    range.length = static_cast<GLuint>(length);
+
+    const char *bytes = static_cast<const char*>(data);
+    pool.insert(pool.end(), bytes, bytes + length);
+    AppendPadding(&pool);
+
+    return range;
+}
+
+void ProgramBinaryWriter::finalize()
+{
+    mCounts[PROGRAM_BINARY_SECTION_STRINGS] = static_cast<GLuint>(mSections[PROGRAM_BINARY_SECTION_STRINGS].size());
+    mCounts[PROGRAM_BINARY_SECTION_BLOBS] = static_cast<GLuint>(mSections[PROGRAM_BINARY_SECTION_BLOBS].size());
+
+    size_t totalLength = sizeof(ProgramBinaryHeader);
+    for (unsigned int section = 0; section < PROGRAM_BINARY_SECTION_COUNT; section++)
+    {
+        totalLength += rx::roundUp(mSections[section].size(), SectionAlignment);
+    }
+
+    mData.clear();
+    mData.reserve(totalLength);
+    mData.resize(sizeof(ProgramBinaryHeader));
+
+    for (unsigned int section = 0; section < PROGRAM_BINARY_SECTION_COUNT; section++)
+    {
+        ProgramBinarySectionEntry &entry = mHeader.sections[section];
+        entry.offset = static_cast<GLuint>(mData.size());
+        entry.count = mCounts[section];
+        entry.stride = mStrides[section];
+
+        mData.insert(mData.end(), mSections[section].begin(), mSections[section].end());
+        AppendPadding(&mData);
+    }
+
+    ASSERT(mData.size() == totalLength);
+
+    mHeader.format = GL_PROGRAM_BINARY_ANGLE;
+    mHeader.magic = PROGRAM_BINARY_MAGIC;
+    mHeader.layoutVersion = PROGRAM_BINARY_LAYOUT_VERSION;
+    mHeader.totalLength = static_cast<GLuint>(totalLength);
+    mHeader.checksum = ComputeChecksum(&mData[sizeof(ProgramBinaryHeader)], totalLength - sizeof(ProgramBinaryHeader));
+
+    memcpy(&mData[0], &mHeader, sizeof(ProgramBinaryHeader));
+}
+
+const void *ProgramBinaryWriter::data() const
+{
+    return mData.empty() ? NULL : &mData[0];
+}
+
+size_t ProgramBinaryWriter::length() const
+{
+    return mData.size();
+}
+
+ProgramBinaryReader::ProgramBinaryReader(const void *data, size_t length)
+    : mData(static_cast<const char*>(data)),
+      mLength(length),
+      mHeader(static_cast<const ProgramBinaryHeader*>(data))
+{
+    ASSERT(reinterpret_cast<uintptr_t>(data) % SectionAlignment == 0);
+}
+
+bool ProgramBinaryReader::IsCompactFormat(const void *data, size_t length)
+{
+    if (!data || length < 2 * sizeof(GLuint))
+    {
+        return false;
+    }
+
+    GLuint prefix[2];
+    memcpy(prefix, data, sizeof(prefix));
+
+    return (prefix[0] == GL_PROGRAM_BINARY_ANGLE && prefix[1] == PROGRAM_BINARY_MAGIC);
+}
+
+bool ProgramBinaryReader::validate() const
+{
+    if (mLength < sizeof(ProgramBinaryHeader) || mHeader->totalLength != mLength)
+    {
+        return false;
+    }
+
+    if (mHeader->format != GL_PROGRAM_BINARY_ANGLE || mHeader->magic != PROGRAM_BINARY_MAGIC ||
+        mHeader->layoutVersion != PROGRAM_BINARY_LAYOUT_VERSION)
+    {
+        return false;
+    }
+
+    for (unsigned int section = 0; section < PROGRAM_BINARY_SECTION_COUNT; section++)
+    {
+        const ProgramBinarySectionEntry &entry = mHeader->sections[section];
+
+        if (entry.offset < sizeof(ProgramBinaryHeader) || entry.offset % SectionAlignment != 0 ||
+            entry.offset > mLength)
+        {
+            return false;
+        }
+
+        // Guard the multiplication below against overflow
+        if (entry.stride != 0 && entry.count > (mLength - entry.offset) / entry.stride)
+        {
+            return false;
+        }
+    }
+
+    const size_t payloadLength = mLength - sizeof(ProgramBinaryHeader);
+    return (ComputeChecksum(mData + sizeof(ProgramBinaryHeader), payloadLength) == mHeader->checksum);
+}
+
+const char *ProgramBinaryReader::getString(const ProgramBinaryRange &range) const
+{
+    const ProgramBinarySectionEntry &pool = mHeader->sections[PROGRAM_BINARY_SECTION_STRINGS];
+
+    if (range.offset >= pool.count || range.length >= pool.count - range.offset)
+    {
+        return NULL;
+    }
+
+    const char *str = mData + pool.offset + range.offset;
+    return (str[range.length] == '\0') ? str : NULL;
+}
+
+const void *ProgramBinaryReader::getBlob(const ProgramBinaryRange &range) const
+{
+    const ProgramBinarySectionEntry &pool = mHeader->sections[PROGRAM_BINARY_SECTION_BLOBS];
+
+    if (range.offset > pool.count || range.length > pool.count - range.offset)
+    {
+        return NULL;
+    }
+
+    return mData + pool.offset + range.offset;
+}
+
+}
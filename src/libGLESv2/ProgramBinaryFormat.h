@@ -0,0 +1,257 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ProgramBinaryFormat.h: Defines the compact layout used to serialize gl::ProgramBinary
+// objects, along with a writer that builds it and a reader that parses it in place.
+//
+// A compact binary is a fixed-size header followed by an offset table of record sections,
+// a pool of NUL-terminated strings and a pool of shader executable blobs. Every section is
+// an array of plain structs, so a binary that stays mapped (for example from a disk cache)
+// can be walked without any per-field decoding, and names are referenced directly inside
+// the string pool.
+
+#ifndef LIBGLESV2_PROGRAMBINARYFORMAT_H_
+#define LIBGLESV2_PROGRAMBINARYFORMAT_H_
+
+#define GL_APICALL
+#include <GLES3/gl3.h>
+#include <GLES2/gl2.h>
+
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+#include "libGLESv2/constants.h"
+
+namespace gl
+{
+
+// Compact binaries start with GL_PROGRAM_BINARY_ANGLE followed by this magic word. Legacy binaries
+// store ANGLE_MAJOR_VERSION in the same slot, which is how the two formats are told apart.
+const GLuint PROGRAM_BINARY_MAGIC = 0x42474E41;   // "ANGB"
+const GLuint PROGRAM_BINARY_LAYOUT_VERSION = 2;
+
+const size_t PROGRAM_BINARY_COMMIT_HASH_SIZE = 16;
+const size_t PROGRAM_BINARY_ADAPTER_IDENTIFIER_SIZE = 16;
+
+enum ProgramBinarySection
+{
+    PROGRAM_BINARY_SECTION_ATTRIBUTES,
+    PROGRAM_BINARY_SECTION_SAMPLERS,
+    PROGRAM_BINARY_SECTION_UNIFORMS,
+    PROGRAM_BINARY_SECTION_UNIFORM_BLOCKS,
+    PROGRAM_BINARY_SECTION_BLOCK_MEMBERS,
+    PROGRAM_BINARY_SECTION_UNIFORM_INDEX,
+    PROGRAM_BINARY_SECTION_VERTEX_EXECUTABLES,
+    PROGRAM_BINARY_SECTION_OUTPUT_VARIABLES,
+    PROGRAM_BINARY_SECTION_STRINGS,
+    PROGRAM_BINARY_SECTION_BLOBS,
+
+    PROGRAM_BINARY_SECTION_COUNT
+};
+
+// A range inside the string pool or the blob pool. String lengths exclude the NUL terminator.
+struct ProgramBinaryRange
+{
+    GLuint offset;
+    GLuint length;
+};
+
+struct ProgramBinarySectionEntry
+{
+    GLuint offset;
+    GLuint count;
+    GLuint stride;
+};
+
+struct ProgramBinaryHeader
+{
+    GLenum format;
+    GLuint magic;
+    GLuint layoutVersion;
+    GLint majorVersion;
+    GLint minorVersion;
+    GLint compileFlags;
+    unsigned char commitHash[PROGRAM_BINARY_COMMIT_HASH_SIZE];
+    unsigned char adapterIdentifier[PROGRAM_BINARY_ADAPTER_IDENTIFIER_SIZE];
+
+    GLuint totalLength;
+    GLuint checksum;   // MurmurHash3 of everything following the header
+
+    GLint shaderVersion;
+    GLuint usedVertexSamplerRange;
+    GLuint usedPixelSamplerRange;
+    GLuint usesPointSize;
+    GLuint vertexWorkarounds;
+
+    ProgramBinaryRange vertexHLSL;
+    ProgramBinaryRange pixelExecutable;
+    ProgramBinaryRange geometryExecutable;
+
+    ProgramBinarySectionEntry sections[PROGRAM_BINARY_SECTION_COUNT];
+};
+
+struct ProgramBinaryAttribute
+{
+    GLuint attributeIndex;
+    GLenum linkedType;
+    ProgramBinaryRange linkedName;
+    GLenum shaderType;
+    ProgramBinaryRange shaderName;
+    GLint semanticIndex;
+};
+
+struct ProgramBinarySampler
+{
+    GLenum shaderType;   // GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+    GLuint samplerIndex;
+    GLint logicalTextureUnit;
+    GLint textureType;
+};
+
+struct ProgramBinaryUniform
+{
+    GLenum type;
+    GLenum precision;
+    ProgramBinaryRange name;
+    GLuint arraySize;
+    GLint blockIndex;
+
+    GLint offset;
+    GLint arrayStride;
+    GLint matrixStride;
+    GLuint isRowMajorMatrix;
+
+    GLuint psRegisterIndex;
+    GLuint vsRegisterIndex;
+    GLuint registerCount;
+    GLuint registerElement;
+};
+
+struct ProgramBinaryUniformBlock
+{
+    ProgramBinaryRange name;
+    GLuint elementIndex;
+    GLuint dataSize;
+    GLuint psRegisterIndex;
+    GLuint vsRegisterIndex;
+
+    // Range of entries in PROGRAM_BINARY_SECTION_BLOCK_MEMBERS
+    GLuint firstMember;
+    GLuint memberCount;
+};
+
+struct ProgramBinaryUniformIndex
+{
+    ProgramBinaryRange name;
+    GLuint element;
+    GLuint index;
+};
+
+struct ProgramBinaryOutputVariable
+{
+    GLint location;
+    ProgramBinaryRange name;
+    GLuint element;
+    GLuint index;
+};
+
+struct ProgramBinaryVertexInput
+{
+    GLenum type;
+    GLuint components;
+    GLuint normalized;
+    GLuint pureInteger;
+};
+
+struct ProgramBinaryVertexExecutable
+{
+    ProgramBinaryVertexInput inputs[MAX_VERTEX_ATTRIBS];
+    ProgramBinaryRange executable;
+};
+
+class ProgramBinaryWriter
+{
+  public:
+    ProgramBinaryWriter();
+
+    // Fixed header fields are filled in by the caller; offsets, lengths and the checksum are
+    // computed by finalize().
+    ProgramBinaryHeader *header() { return &mHeader; }
+
+    ProgramBinaryRange addString(const std::string &str);
+    ProgramBinaryRange addBlob(const void *data, size_t length);
+
+    template <typename T>
+    void addRecord(ProgramBinarySection section, const T &record)
+    {
+        ASSERT(mStrides[section] == 0 || mStrides[section] == sizeof(T));
+        mStrides[section] = sizeof(T);
+        mCounts[section]++;
+
+        const char *bytes = reinterpret_cast<const char*>(&record);
+        mSections[section].insert(mSections[section].end(), bytes, bytes + sizeof(T));
+    }
+
+    void finalize();
+
+    const void *data() const;
+    size_t length() const;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ProgramBinaryWriter);
+
+    ProgramBinaryHeader mHeader;
+    std::vector<char> mSections[PROGRAM_BINARY_SECTION_COUNT];
+    GLuint mCounts[PROGRAM_BINARY_SECTION_COUNT];
+    GLuint mStrides[PROGRAM_BINARY_SECTION_COUNT];
+    std::vector<char> mData;
+};
+
+// Parses a compact binary without copying it. The data must be 4-byte aligned and must outlive
+// the reader, since every pointer it returns refers directly into the binary.
+class ProgramBinaryReader
+{
+  public:
+    ProgramBinaryReader(const void *data, size_t length);
+
+    static bool IsCompactFormat(const void *data, size_t length);
+
+    // Checks the layout version, the section table and the checksum.
+    bool validate() const;
+
+    const ProgramBinaryHeader &header() const { return *mHeader; }
+
+    template <typename T>
+    const T *getRecords(ProgramBinarySection section, GLuint *count) const
+    {
+        const ProgramBinarySectionEntry &entry = mHeader->sections[section];
+        if (entry.count > 0 && entry.stride != sizeof(T))
+        {
+            *count = 0;
+            return NULL;
+        }
+
+        *count = entry.count;
+        return reinterpret_cast<const T*>(mData + entry.offset);
+    }
+
+    // Returns NULL if the range does not reference a NUL-terminated string in the pool.
+    const char *getString(const ProgramBinaryRange &range) const;
+    const void *getBlob(const ProgramBinaryRange &range) const;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ProgramBinaryReader);
+
+    const char *mData;
+    size_t mLength;
+    const ProgramBinaryHeader *mHeader;
+};
+
+}
+
+#endif   // LIBGLESV2_PROGRAMBINARYFORMAT_H_
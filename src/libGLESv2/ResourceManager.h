@@ -14,11 +14,10 @@
 #include <GLES3/gl3.h>
 #include <GLES2/gl2.h>
 
-#include <unordered_map>
-
 #include "common/angleutils.h"
 #include "libGLESv2/angletypes.h"
 #include "libGLESv2/HandleAllocator.h"
+#include "libGLESv2/ResourceMap.h"
 
 namespace rx
 {
@@ -83,30 +82,30 @@ class ResourceManager
     std::size_t mRefCount;
     rx::Renderer *mRenderer;
 
-    typedef std::unordered_map<GLuint, Buffer*> BufferMap;
+    typedef ResourceMap<Buffer> BufferMap;
     BufferMap mBufferMap;
     HandleAllocator mBufferHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Shader*> ShaderMap;
+    typedef ResourceMap<Shader> ShaderMap;
     ShaderMap mShaderMap;
 
-    typedef std::unordered_map<GLuint, Program*> ProgramMap;
+    typedef ResourceMap<Program> ProgramMap;
     ProgramMap mProgramMap;
     HandleAllocator mProgramShaderHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Texture*> TextureMap;
+    typedef ResourceMap<Texture> TextureMap;
     TextureMap mTextureMap;
     HandleAllocator mTextureHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Renderbuffer*> RenderbufferMap;
+    typedef ResourceMap<Renderbuffer> RenderbufferMap;
     RenderbufferMap mRenderbufferMap;
     HandleAllocator mRenderbufferHandleAllocator;
 
-    typedef std::unordered_map<GLuint, Sampler*> SamplerMap;
+    typedef ResourceMap<Sampler> SamplerMap;
     SamplerMap mSamplerMap;
     HandleAllocator mSamplerHandleAllocator;
 
-    typedef std::unordered_map<GLuint, FenceSync*> FenceMap;
+    typedef ResourceMap<FenceSync> FenceMap;
     FenceMap mFenceSyncMap;
     HandleAllocator mFenceSyncHandleAllocator;
 };
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ResourceMap.h: Defines the gl::ResourceMap class template, which maps the GL names of a
+// type of object to the objects. Names handed out by a gl::HandleAllocator are small and
+// compact, so they index a dense slot array directly. Names chosen by the application
+// beyond the slot array are kept in a hash map.
+
+#ifndef LIBGLESV2_RESOURCEMAP_H_
+#define LIBGLESV2_RESOURCEMAP_H_
+
+#define GL_APICALL
+#include <GLES3/gl3.h>
+#include <GLES2/gl2.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+template <typename T>
+class ResourceMap
+{
+  public:
+    ResourceMap()
+        : mCount(0)
+    {
+    }
+
+    bool empty() const
+    {
+        return mCount == 0;
+    }
+
+    // A name is known once it has been generated or bound, even before it has an object
+    bool contains(GLuint handle) const
+    {
+        if (handle < mSlots.size())
+        {
+            return mSlots[handle].used;
+        }
+
+        return mHashed.find(handle) != mHashed.end();
+    }
+
+    // Returns the object of a name, or NULL if the name is unknown or has no object yet
+    T *query(GLuint handle) const
+    {
+        if (handle < mSlots.size())
+        {
+            return mSlots[handle].object;
+        }
+
+        if (mHashed.empty())
+        {
+            return NULL;
+        }
+
+        typename HashedMap::const_iterator entry = mHashed.find(handle);
+        return (entry != mHashed.end()) ? entry->second : NULL;
+    }
+
+    // Makes the name known and sets its object, which may be NULL to only reserve the name
+    void assign(GLuint handle, T *object)
+    {
+        if (handle >= mSlots.size() && handle < MAX_SLOTS)
+        {
+            grow(handle);
+        }
+
+        if (handle < mSlots.size())
+        {
+            Slot &slot = mSlots[handle];
+            if (!slot.used)
+            {
+                slot.used = true;
+                mCount++;
+            }
+            slot.object = object;
+        }
+        else
+        {
+            std::pair<typename HashedMap::iterator, bool> entry = mHashed.insert(std::make_pair(handle, object));
+            if (entry.second)
+            {
+                mCount++;
+            }
+            else
+            {
+                entry.first->second = object;
+            }
+        }
+    }
+
+    // Forgets the name, returning false if it was unknown. The object is returned through
+    // object, the map does not own it.
+    bool erase(GLuint handle, T **object)
+    {
+        if (handle < mSlots.size())
+        {
+            Slot &slot = mSlots[handle];
+            if (!slot.used)
+            {
+                return false;
+            }
+
+            *object = slot.object;
+            slot.object = NULL;
+            slot.used = false;
+        }
+        else
+        {
+            typename HashedMap::iterator entry = mHashed.find(handle);
+            if (entry == mHashed.end())
+            {
+                return false;
+            }
+
+            *object = entry->second;
+            mHashed.erase(entry);
+        }
+
+        mCount--;
+        return true;
+    }
+
+    // Appends the known names, in increasing order within the slot array
+    void getHandles(std::vector<GLuint> *handles) const
+    {
+        handles->reserve(handles->size() + mCount);
+
+        for (size_t handle = 0; handle < mSlots.size(); handle++)
+        {
+            if (mSlots[handle].used)
+            {
+                handles->push_back(static_cast<GLuint>(handle));
+            }
+        }
+
+        for (typename HashedMap::const_iterator entry = mHashed.begin(); entry != mHashed.end(); entry++)
+        {
+            handles->push_back(entry->first);
+        }
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ResourceMap);
+
+    // Names past this many slots are hashed, so an application binding a large name of its
+    // own choosing doesn't make the slot array huge. The slot array grows to cover any
+    // smaller name, so the hash map only ever holds names past it.
+    enum { MAX_SLOTS = 1 << 16 };
+
+    struct Slot
+    {
+        Slot() : object(NULL), used(false) {}
+
+        T *object;
+        bool used;
+    };
+
+    void grow(GLuint handle)
+    {
+        size_t size = std::max<size_t>(mSlots.size(), 64);
+        while (size <= handle)
+        {
+            size *= 2;
+        }
+        size = std::min<size_t>(size, MAX_SLOTS);
+
+        mSlots.resize(size);
+    }
+
+    typedef std::unordered_map<GLuint, T*> HashedMap;
+
+    std::vector<Slot> mSlots;
+    HashedMap mHashed;
+    size_t mCount;
+};
+
+}
+
+#endif   // LIBGLESV2_RESOURCEMAP_H_
@@ -14,6 +14,8 @@
 namespace gl
 {
 
+unsigned int Sampler::mCurrentStateSerial = 1;
+
 Sampler::Sampler(GLuint id)
     : RefCountObject(id),
       mMinFilter(GL_NEAREST_MIPMAP_LINEAR),
@@ -26,6 +28,12 @@ Sampler::Sampler(GLuint id)
       mComparisonMode(GL_NONE),
       mComparisonFunc(GL_LEQUAL)
 {
+    updateStateSerial();
+}
+
+void Sampler::updateStateSerial()
+{
+    mStateSerial = mCurrentStateSerial++;
 }
 
 void Sampler::getState(SamplerState *samplerState) const
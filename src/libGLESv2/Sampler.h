@@ -21,15 +21,15 @@ class Sampler : public RefCountObject
   public:
     Sampler(GLuint id);
 
-    void setMinFilter(GLenum minFilter) { mMinFilter = minFilter; }
-    void setMagFilter(GLenum magFilter) { mMagFilter = magFilter; }
-    void setWrapS(GLenum wrapS) { mWrapS = wrapS; }
-    void setWrapT(GLenum wrapT) { mWrapT = wrapT; }
-    void setWrapR(GLenum wrapR) { mWrapR = wrapR; }
-    void setMinLod(GLfloat minLod) { mMinLod = minLod; }
-    void setMaxLod(GLfloat maxLod) { mMaxLod = maxLod; }
-    void setComparisonMode(GLenum comparisonMode) { mComparisonMode = comparisonMode; }
-    void setComparisonFunc(GLenum comparisonFunc) { mComparisonFunc = comparisonFunc; }
+    void setMinFilter(GLenum minFilter) { mMinFilter = minFilter; updateStateSerial(); }
+    void setMagFilter(GLenum magFilter) { mMagFilter = magFilter; updateStateSerial(); }
+    void setWrapS(GLenum wrapS) { mWrapS = wrapS; updateStateSerial(); }
+    void setWrapT(GLenum wrapT) { mWrapT = wrapT; updateStateSerial(); }
+    void setWrapR(GLenum wrapR) { mWrapR = wrapR; updateStateSerial(); }
+    void setMinLod(GLfloat minLod) { mMinLod = minLod; updateStateSerial(); }
+    void setMaxLod(GLfloat maxLod) { mMaxLod = maxLod; updateStateSerial(); }
+    void setComparisonMode(GLenum comparisonMode) { mComparisonMode = comparisonMode; updateStateSerial(); }
+    void setComparisonFunc(GLenum comparisonFunc) { mComparisonFunc = comparisonFunc; updateStateSerial(); }
 
     GLenum getMinFilter() const { return mMinFilter; }
     GLenum getMagFilter() const { return mMagFilter; }
@@ -43,7 +43,12 @@ class Sampler : public RefCountObject
 
     void getState(SamplerState *samplerState) const;
 
+    // Changes whenever the state changes, and is unique among all sampler objects and never zero
+    unsigned int getStateSerial() const { return mStateSerial; }
+
   private:
+    void updateStateSerial();
+
     GLenum mMinFilter;
     GLenum mMagFilter;
     GLenum mWrapS;
@@ -53,6 +58,9 @@ class Sampler : public RefCountObject
     GLfloat mMaxLod;
     GLenum mComparisonMode;
     GLenum mComparisonFunc;
+
+    unsigned int mStateSerial;
+    static unsigned int mCurrentStateSerial;
 };
 
 }
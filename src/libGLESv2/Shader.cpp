@@ -13,12 +13,225 @@
 
 #include "GLSLANG/ShaderLang.h"
 #include "common/utilities.h"
+#include "common/version.h"
 #include "libGLESv2/renderer/Renderer.h"
+#include "libGLESv2/BinaryStream.h"
 #include "libGLESv2/Constants.h"
+#include "libGLESv2/DiskCache.h"
 #include "libGLESv2/ResourceManager.h"
 
 namespace gl
 {
+
+namespace
+{
+
+void AppendObjectCode(const char *objectCode, size_t length, void *userData)
+{
+    static_cast<std::string*>(userData)->append(objectCode, length);
+}
+
+// Serialization of the interface reported by the translator, used by the disk cache
+
+template <typename VarT>
+void WriteVariables(BinaryOutputStream *stream, const std::vector<VarT> &variables);
+
+template <typename VarT>
+void ReadVariables(BinaryInputStream *stream, std::vector<VarT> *variables);
+
+void WriteShaderVariable(BinaryOutputStream *stream, const sh::ShaderVariable &variable)
+{
+    stream->write(variable.type);
+    stream->write(variable.precision);
+    stream->write(variable.name);
+    stream->write(variable.arraySize);
+}
+
+void ReadShaderVariable(BinaryInputStream *stream, GLenum *type, GLenum *precision, std::string *name, unsigned int *arraySize)
+{
+    stream->read(type);
+    stream->read(precision);
+    stream->read(name);
+    stream->read(arraySize);
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::Uniform &uniform)
+{
+    WriteShaderVariable(stream, uniform);
+    stream->write(uniform.registerIndex);
+    stream->write(uniform.elementIndex);
+    WriteVariables(stream, uniform.fields);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::Uniform> *uniforms)
+{
+    GLenum type = GL_NONE;
+    GLenum precision = GL_NONE;
+    std::string name;
+    unsigned int arraySize = 0;
+    unsigned int registerIndex = 0;
+    unsigned int elementIndex = 0;
+
+    ReadShaderVariable(stream, &type, &precision, &name, &arraySize);
+    stream->read(&registerIndex);
+    stream->read(&elementIndex);
+
+    uniforms->push_back(sh::Uniform(type, precision, name.c_str(), arraySize, registerIndex, elementIndex));
+    ReadVariables(stream, &uniforms->back().fields);
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::Attribute &attribute)
+{
+    WriteShaderVariable(stream, attribute);
+    stream->write(attribute.location);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::Attribute> *attributes)
+{
+    GLenum type = GL_NONE;
+    GLenum precision = GL_NONE;
+    std::string name;
+    unsigned int arraySize = 0;
+    int location = -1;
+
+    ReadShaderVariable(stream, &type, &precision, &name, &arraySize);
+    stream->read(&location);
+
+    attributes->push_back(sh::Attribute(type, precision, name.c_str(), arraySize, location));
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::InterfaceBlockField &field)
+{
+    WriteShaderVariable(stream, field);
+    stream->write(field.isRowMajorMatrix);
+    WriteVariables(stream, field.fields);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::InterfaceBlockField> *fields)
+{
+    GLenum type = GL_NONE;
+    GLenum precision = GL_NONE;
+    std::string name;
+    unsigned int arraySize = 0;
+    bool isRowMajorMatrix = false;
+
+    ReadShaderVariable(stream, &type, &precision, &name, &arraySize);
+    stream->read(&isRowMajorMatrix);
+
+    fields->push_back(sh::InterfaceBlockField(type, precision, name.c_str(), arraySize, isRowMajorMatrix));
+    ReadVariables(stream, &fields->back().fields);
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::Varying &varying)
+{
+    WriteShaderVariable(stream, varying);
+    stream->write(varying.interpolation);
+    stream->write(varying.registerIndex);
+    stream->write(varying.elementIndex);
+    stream->write(varying.structName);
+    WriteVariables(stream, varying.fields);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::Varying> *varyings)
+{
+    GLenum type = GL_NONE;
+    GLenum precision = GL_NONE;
+    std::string name;
+    unsigned int arraySize = 0;
+    sh::InterpolationType interpolation = sh::INTERPOLATION_SMOOTH;
+
+    ReadShaderVariable(stream, &type, &precision, &name, &arraySize);
+    stream->read(&interpolation);
+
+    varyings->push_back(sh::Varying(type, precision, name.c_str(), arraySize, interpolation));
+
+    sh::Varying &varying = varyings->back();
+    stream->read(&varying.registerIndex);
+    stream->read(&varying.elementIndex);
+    stream->read(&varying.structName);
+    ReadVariables(stream, &varying.fields);
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::BlockMemberInfo &blockInfo)
+{
+    stream->write(blockInfo.offset);
+    stream->write(blockInfo.arrayStride);
+    stream->write(blockInfo.matrixStride);
+    stream->write(blockInfo.isRowMajorMatrix);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::BlockMemberInfo> *blockInfos)
+{
+    int offset = 0;
+    int arrayStride = 0;
+    int matrixStride = 0;
+    bool isRowMajorMatrix = false;
+
+    stream->read(&offset);
+    stream->read(&arrayStride);
+    stream->read(&matrixStride);
+    stream->read(&isRowMajorMatrix);
+
+    blockInfos->push_back(sh::BlockMemberInfo(offset, arrayStride, matrixStride, isRowMajorMatrix));
+}
+
+void WriteVariable(BinaryOutputStream *stream, const sh::InterfaceBlock &interfaceBlock)
+{
+    stream->write(interfaceBlock.name);
+    stream->write(interfaceBlock.arraySize);
+    stream->write(interfaceBlock.registerIndex);
+    stream->write(interfaceBlock.dataSize);
+    stream->write(interfaceBlock.layout);
+    stream->write(interfaceBlock.isRowMajorLayout);
+    WriteVariables(stream, interfaceBlock.fields);
+    WriteVariables(stream, interfaceBlock.blockInfo);
+}
+
+void ReadVariable(BinaryInputStream *stream, std::vector<sh::InterfaceBlock> *interfaceBlocks)
+{
+    std::string name;
+    unsigned int arraySize = 0;
+    unsigned int registerIndex = 0;
+
+    stream->read(&name);
+    stream->read(&arraySize);
+    stream->read(&registerIndex);
+
+    interfaceBlocks->push_back(sh::InterfaceBlock(name.c_str(), arraySize, registerIndex));
+
+    sh::InterfaceBlock &interfaceBlock = interfaceBlocks->back();
+    stream->read(&interfaceBlock.dataSize);
+    stream->read(&interfaceBlock.layout);
+    stream->read(&interfaceBlock.isRowMajorLayout);
+    ReadVariables(stream, &interfaceBlock.fields);
+    ReadVariables(stream, &interfaceBlock.blockInfo);
+}
+
+template <typename VarT>
+void WriteVariables(BinaryOutputStream *stream, const std::vector<VarT> &variables)
+{
+    stream->write(variables.size());
+    for (size_t variableIndex = 0; variableIndex < variables.size(); variableIndex++)
+    {
+        WriteVariable(stream, variables[variableIndex]);
+    }
+}
+
+template <typename VarT>
+void ReadVariables(BinaryInputStream *stream, std::vector<VarT> *variables)
+{
+    size_t count = 0;
+    stream->read(&count);
+
+    variables->clear();
+    for (size_t variableIndex = 0; variableIndex < count && !stream->error(); variableIndex++)
+    {
+        ReadVariable(stream, variables);
+    }
+}
+
+}
+
 void *Shader::mFragmentCompiler = NULL;
 void *Shader::mVertexCompiler = NULL;
 
@@ -228,6 +441,15 @@ void Shader::parseVaryings(void *compiler)
         ShGetInfoPointer(compiler, SH_ACTIVE_VARYINGS_ARRAY, reinterpret_cast<void**>(&activeVaryings));
         mVaryings = *activeVaryings;
 
+        parseHLSLUsage();
+    }
+}
+
+// Derives the built-in usage flags from the markers the translator leaves in the HLSL
+void Shader::parseHLSLUsage()
+{
+    if (!mHlsl.empty())
+    {
         mUsesMultipleRenderTargets = mHlsl.find("GL_USES_MRT")          != std::string::npos;
         mUsesFragColor             = mHlsl.find("GL_USES_FRAG_COLOR")   != std::string::npos;
         mUsesFragData              = mHlsl.find("GL_USES_FRAG_DATA")    != std::string::npos;
@@ -241,6 +463,80 @@ void Shader::parseVaryings(void *compiler)
     }
 }
 
+std::string Shader::computeTranslationCacheKey()
+{
+    BinaryOutputStream stream;
+
+    stream.write(ANGLE_COMMIT_HASH, ANGLE_COMMIT_HASH_SIZE);
+    stream.write(getType());
+    stream.write(mRenderer->getAdapterIdentifier());
+    stream.write(mRenderer->getMajorShaderModel());
+    stream.write(mRenderer->getCurrentClientVersion());
+    stream.write(static_cast<int>(SH_OBJECT_CODE));
+    stream.write(mSource);
+
+    return DiskCache::computeKey(stream.data(), stream.length());
+}
+
+// Restores the result of a previous successful translation of the same source, if the disk cache has it
+bool Shader::loadCachedTranslation()
+{
+    mCacheKey.clear();
+
+    DiskCache *diskCache = DiskCache::getInstance();
+    if (!diskCache || perfActive())
+    {
+        return false;
+    }
+
+    mCacheKey = computeTranslationCacheKey();
+
+    std::vector<char> translation;
+    if (!diskCache->get(mCacheKey, &translation) || translation.empty())
+    {
+        return false;
+    }
+
+    BinaryInputStream stream(&translation[0], translation.size());
+    stream.read(&mShaderVersion);
+    stream.read(&mHlsl);
+    stream.read(&mInfoLog);
+    ReadVariables(&stream, &mActiveUniforms);
+    ReadVariables(&stream, &mActiveInterfaceBlocks);
+    ReadVariables(&stream, &mVaryings);
+    loadTranslatedInterface(&stream);
+
+    if (stream.error() || !stream.endOfStream() || mHlsl.empty())
+    {
+        uncompile();
+        return false;
+    }
+
+    parseHLSLUsage();
+
+    return true;
+}
+
+void Shader::cacheTranslation()
+{
+    DiskCache *diskCache = DiskCache::getInstance();
+    if (!diskCache || mCacheKey.empty() || mHlsl.empty())
+    {
+        return;
+    }
+
+    BinaryOutputStream stream;
+    stream.write(mShaderVersion);
+    stream.write(mHlsl);
+    stream.write(mInfoLog);
+    WriteVariables(&stream, mActiveUniforms);
+    WriteVariables(&stream, mActiveInterfaceBlocks);
+    WriteVariables(&stream, mVaryings);
+    saveTranslatedInterface(&stream);
+
+    diskCache->put(mCacheKey, stream.data(), stream.length());
+}
+
 void Shader::resetVaryingsRegisterAssignment()
 {
     for (unsigned int varyingIndex = 0; varyingIndex < mVaryings.size(); varyingIndex++)
@@ -289,6 +585,10 @@ void Shader::compileToHLSL(void *compiler)
         compileOptions |= SH_LINE_DIRECTIVES;
     }
 
+    // The translator streams the HLSL straight into this string rather than retaining its own copy
+    std::string outputHLSL;
+    ShSetObjectCodeCallback(compiler, AppendObjectCode, &outputHLSL);
+
     int result;
     if (sourcePath.empty())
     {
@@ -310,6 +610,8 @@ void Shader::compileToHLSL(void *compiler)
         result = ShCompile(compiler, sourceStrings, ArraySize(sourceStrings), compileOptions | SH_SOURCE_PATH);
     }
 
+    ShSetObjectCodeCallback(compiler, NULL, NULL);
+
     size_t shaderVersion = 100;
     ShGetInfo(compiler, SH_SHADER_VERSION, &shaderVersion);
 
@@ -322,12 +624,6 @@ void Shader::compileToHLSL(void *compiler)
     }
     else if (result)
     {
-        size_t objCodeLen = 0;
-        ShGetInfo(compiler, SH_OBJECT_CODE_LENGTH, &objCodeLen);
-
-        char* outputHLSL = new char[objCodeLen];
-        ShGetObjectCode(compiler, outputHLSL);
-
 #ifdef _DEBUG
         std::ostringstream hlslStream;
         hlslStream << "// GLSL\n";
@@ -347,11 +643,9 @@ void Shader::compileToHLSL(void *compiler)
         hlslStream << outputHLSL;
         mHlsl = hlslStream.str();
 #else
-        mHlsl = outputHLSL;
+        mHlsl.swap(outputHLSL);
 #endif
 
-        delete[] outputHLSL;
-
         void *activeUniforms;
         ShGetInfoPointer(compiler, SH_ACTIVE_UNIFORMS_ARRAY, &activeUniforms);
         mActiveUniforms = *(std::vector<sh::Uniform>*)activeUniforms;
@@ -359,15 +653,17 @@ void Shader::compileToHLSL(void *compiler)
         void *activeInterfaceBlocks;
         ShGetInfoPointer(compiler, SH_ACTIVE_INTERFACE_BLOCKS_ARRAY, &activeInterfaceBlocks);
         mActiveInterfaceBlocks = *(sh::ActiveInterfaceBlocks*)activeInterfaceBlocks;
+
+        // Keep the warnings, so a cached translation can report them too
+        void *infoLog;
+        ShGetInfoPointer(compiler, SH_INFO_LOG_POINTER, &infoLog);
+        mInfoLog = static_cast<const char*>(infoLog);
     }
     else
     {
-        size_t infoLogLen = 0;
-        ShGetInfo(compiler, SH_INFO_LOG_LENGTH, &infoLogLen);
-
-        char* infoLog = new char[infoLogLen];
-        ShGetInfoLog(compiler, infoLog);
-        mInfoLog = infoLog;
+        void *infoLog;
+        ShGetInfoPointer(compiler, SH_INFO_LOG_POINTER, &infoLog);
+        mInfoLog = static_cast<const char*>(infoLog);
 
         TRACE("\n%s", mInfoLog.c_str());
     }
@@ -486,9 +782,16 @@ void VertexShader::compile()
 {
     uncompile();
 
+    if (loadCachedTranslation())
+    {
+        return;
+    }
+
     compileToHLSL(mVertexCompiler);
     parseAttributes();
     parseVaryings(mVertexCompiler);
+
+    cacheTranslation();
 }
 
 int VertexShader::getSemanticIndex(const std::string &attributeName)
@@ -523,6 +826,16 @@ void VertexShader::parseAttributes()
     }
 }
 
+void VertexShader::loadTranslatedInterface(BinaryInputStream *stream)
+{
+    ReadVariables(stream, &mActiveAttributes);
+}
+
+void VertexShader::saveTranslatedInterface(BinaryOutputStream *stream) const
+{
+    WriteVariables(stream, mActiveAttributes);
+}
+
 FragmentShader::FragmentShader(ResourceManager *manager, const rx::Renderer *renderer, GLuint handle)
     : Shader(manager, renderer, handle)
 {
@@ -541,6 +854,11 @@ void FragmentShader::compile()
 {
     uncompile();
 
+    if (loadCachedTranslation())
+    {
+        return;
+    }
+
     compileToHLSL(mFragmentCompiler);
     parseVaryings(mFragmentCompiler);
     std::sort(mVaryings.begin(), mVaryings.end(), compareVarying);
@@ -552,6 +870,8 @@ void FragmentShader::compile()
         ShGetInfoPointer(mFragmentCompiler, SH_ACTIVE_OUTPUT_VARIABLES_ARRAY, &activeOutputVariables);
         mActiveOutputVariables = *(std::vector<sh::Attribute>*)activeOutputVariables;
     }
+
+    cacheTranslation();
 }
 
 void FragmentShader::uncompile()
@@ -561,6 +881,16 @@ void FragmentShader::uncompile()
     mActiveOutputVariables.clear();
 }
 
+void FragmentShader::loadTranslatedInterface(BinaryInputStream *stream)
+{
+    ReadVariables(stream, &mActiveOutputVariables);
+}
+
+void FragmentShader::saveTranslatedInterface(BinaryOutputStream *stream) const
+{
+    WriteVariables(stream, mActiveOutputVariables);
+}
+
 const std::vector<sh::Attribute> &FragmentShader::getOutputVariables() const
 {
     return mActiveOutputVariables;
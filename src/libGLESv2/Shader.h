@@ -31,6 +31,8 @@ class Renderer;
 namespace gl
 {
 class ResourceManager;
+class BinaryInputStream;
+class BinaryOutputStream;
 
 class Shader
 {
@@ -71,12 +73,21 @@ class Shader
 
     static void releaseCompiler();
 
+    // Identifies the translation in the disk cache, empty when the cache is disabled
+    const std::string &getCacheKey() const { return mCacheKey; }
+
     bool usesDepthRange() const { return mUsesDepthRange; }
     bool usesPointSize() const { return mUsesPointSize; }
     rx::D3DWorkaroundType getD3DWorkarounds() const;
 
   protected:
     void parseVaryings(void *compiler);
+    void parseHLSLUsage();
+
+    bool loadCachedTranslation();
+    void cacheTranslation();
+    virtual void loadTranslatedInterface(BinaryInputStream *stream) {}
+    virtual void saveTranslatedInterface(BinaryOutputStream *stream) const {}
 
     void compileToHLSL(void *compiler);
 
@@ -107,6 +118,7 @@ class Shader
     DISALLOW_COPY_AND_ASSIGN(Shader);
 
     void initializeCompiler();
+    std::string computeTranslationCacheKey();
 
     const GLuint mHandle;
     unsigned int mRefCount;     // Number of program objects this shader is attached to
@@ -115,6 +127,7 @@ class Shader
     std::string mSource;
     std::string mHlsl;
     std::string mInfoLog;
+    std::string mCacheKey;
     std::vector<sh::Uniform> mActiveUniforms;
     sh::ActiveInterfaceBlocks mActiveInterfaceBlocks;
 
@@ -142,6 +155,9 @@ class VertexShader : public Shader
 
     void parseAttributes();
 
+    virtual void loadTranslatedInterface(BinaryInputStream *stream);
+    virtual void saveTranslatedInterface(BinaryOutputStream *stream) const;
+
     std::vector<sh::Attribute> mActiveAttributes;
 };
 
@@ -160,6 +176,9 @@ class FragmentShader : public Shader
   private:
     DISALLOW_COPY_AND_ASSIGN(FragmentShader);
 
+    virtual void loadTranslatedInterface(BinaryInputStream *stream);
+    virtual void saveTranslatedInterface(BinaryOutputStream *stream) const;
+
     std::vector<sh::Attribute> mActiveOutputVariables;
 };
 }
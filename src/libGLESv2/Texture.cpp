@@ -97,26 +97,31 @@ void Texture::releaseProxy(const Renderbuffer *proxy)
 void Texture::setMinFilter(GLenum filter)
 {
     mSamplerState.minFilter = filter;
+    invalidateCompleteness();
 }
 
 void Texture::setMagFilter(GLenum filter)
 {
     mSamplerState.magFilter = filter;
+    invalidateCompleteness();
 }
 
 void Texture::setWrapS(GLenum wrap)
 {
     mSamplerState.wrapS = wrap;
+    invalidateCompleteness();
 }
 
 void Texture::setWrapT(GLenum wrap)
 {
     mSamplerState.wrapT = wrap;
+    invalidateCompleteness();
 }
 
 void Texture::setWrapR(GLenum wrap)
 {
     mSamplerState.wrapR = wrap;
+    invalidateCompleteness();
 }
 
 void Texture::setMaxAnisotropy(float textureMaxAnisotropy, float contextMaxAnisotropy)
@@ -127,6 +132,7 @@ void Texture::setMaxAnisotropy(float textureMaxAnisotropy, float contextMaxAniso
 void Texture::setCompareMode(GLenum mode)
 {
     mSamplerState.compareMode = mode;
+    invalidateCompleteness();
 }
 
 void Texture::setCompareFunc(GLenum func)
@@ -369,6 +375,25 @@ rx::TextureStorageInterface *Texture::getNativeTexture()
     return storage;
 }
 
+bool Texture::isSamplerComplete(const SamplerState &samplerState, unsigned int samplerSerial)
+{
+    int clientVersion = mRenderer->getCurrentClientVersion();
+
+    bool complete = false;
+    if (!mCompletenessCache.get(samplerSerial, clientVersion, &complete))
+    {
+        complete = computeSamplerComplete(samplerState);
+        mCompletenessCache.set(samplerSerial, clientVersion, complete);
+    }
+
+    return complete;
+}
+
+void Texture::invalidateCompleteness()
+{
+    mCompletenessCache.invalidate();
+}
+
 bool Texture::hasDirtyImages() const
 {
     return mDirtyImages;
@@ -476,6 +501,8 @@ GLenum Texture2D::getActualFormat(GLint level) const
 
 void Texture2D::redefineImage(GLint level, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    invalidateCompleteness();
+
     releaseTexImage();
 
     // If there currently is a corresponding storage texture image, it has these parameters
@@ -539,6 +566,8 @@ void Texture2D::setImage(GLint level, GLsizei width, GLsizei height, GLenum inte
 
 void Texture2D::bindTexImage(egl::Surface *surface)
 {
+    invalidateCompleteness();
+
     releaseTexImage();
 
     GLenum internalformat = surface->getFormat();
@@ -555,6 +584,8 @@ void Texture2D::bindTexImage(egl::Surface *surface)
 
 void Texture2D::releaseTexImage()
 {
+    invalidateCompleteness();
+
     if (mSurface)
     {
         mSurface->setBoundTexture(NULL);
@@ -588,7 +619,7 @@ void Texture2D::commitRect(GLint level, GLint xoffset, GLint yoffset, GLsizei wi
         rx::Image *image = mImageArray[level];
         if (image->copyToStorage(mTexStorage, level, xoffset, yoffset, width, height))
         {
-            image->markClean();
+            image->markClean(Box(xoffset, yoffset, 0, width, height, 1));
         }
     }
 }
@@ -611,7 +642,9 @@ void Texture2D::subImage(GLint level, GLint xoffset, GLint yoffset, GLsizei widt
         }
     }
 
-    if (!fastUnpacked && Texture::subImage(xoffset, yoffset, 0, width, height, 1, format, type, unpack, pixels, mImageArray[level]))
+    // Queued conversions stay dirty, and are copied to storage when the texture is next used
+    if (!fastUnpacked && Texture::subImage(xoffset, yoffset, 0, width, height, 1, format, type, unpack, pixels, mImageArray[level]) &&
+        !mImageArray[level]->hasPendingUpload())
     {
         commitRect(level, xoffset, yoffset, width, height);
     }
@@ -696,6 +729,8 @@ void Texture2D::copySubImage(GLenum target, GLint level, GLint xoffset, GLint yo
 
 void Texture2D::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    invalidateCompleteness();
+
     for (int level = 0; level < levels; level++)
     {
         GLsizei levelWidth = std::max(1, width >> level);
@@ -730,7 +765,7 @@ void Texture2D::setCompleteTexStorage(rx::TextureStorageInterface2D *newComplete
 }
 
 // Tests for 2D texture sampling completeness. [OpenGL ES 2.0.24] section 3.8.2 page 85.
-bool Texture2D::isSamplerComplete(const SamplerState &samplerState) const
+bool Texture2D::computeSamplerComplete(const SamplerState &samplerState) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -922,7 +957,13 @@ void Texture2D::updateStorageLevel(int level)
 
     if (mImageArray[level]->isDirty())
     {
-        commitRect(level, 0, 0, getWidth(level), getHeight(level));
+        // Copy only the modified areas, committing removes them from the image's dirty boxes
+        std::vector<Box> dirtyBoxes = mImageArray[level]->getDirtyBoxes();
+        for (size_t boxIndex = 0; boxIndex < dirtyBoxes.size(); boxIndex++)
+        {
+            const Box &box = dirtyBoxes[boxIndex];
+            commitRect(level, box.x, box.y, box.width, box.height);
+        }
     }
 }
 
@@ -963,6 +1004,9 @@ void Texture2D::generateMipmaps()
 
     if (mTexStorage && mTexStorage->isRenderTarget())
     {
+        // The mipmaps are generated from the base level in storage
+        updateStorageLevel(0);
+
         for (int level = 1; level <= q; level++)
         {
             mTexStorage->generateMipmap(level);
@@ -1152,14 +1196,16 @@ void TextureCubeMap::commitRect(int faceIndex, GLint level, GLint xoffset, GLint
     {
         rx::Image *image = mImageArray[faceIndex][level];
         if (image->copyToStorage(mTexStorage, faceIndex, level, xoffset, yoffset, width, height))
-            image->markClean();
+            image->markClean(Box(xoffset, yoffset, 0, width, height, 1));
     }
 }
 
 void TextureCubeMap::subImage(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const PixelUnpackState &unpack, const void *pixels)
 {
     int faceIndex = targetToIndex(target);
-    if (Texture::subImage(xoffset, yoffset, 0, width, height, 1, format, type, unpack, pixels, mImageArray[faceIndex][level]))
+    // Queued conversions stay dirty, and are copied to storage when the texture is next used
+    if (Texture::subImage(xoffset, yoffset, 0, width, height, 1, format, type, unpack, pixels, mImageArray[faceIndex][level]) &&
+        !mImageArray[faceIndex][level]->hasPendingUpload())
     {
         commitRect(faceIndex, level, xoffset, yoffset, width, height);
     }
@@ -1175,7 +1221,7 @@ void TextureCubeMap::subImageCompressed(GLenum target, GLint level, GLint xoffse
 }
 
 // Tests for cube map sampling completeness. [OpenGL ES 2.0.24] section 3.8.2 page 86.
-bool TextureCubeMap::isSamplerComplete(const SamplerState &samplerState) const
+bool TextureCubeMap::computeSamplerComplete(const SamplerState &samplerState) const
 {
     int size = getBaseLevelWidth();
 
@@ -1398,7 +1444,12 @@ void TextureCubeMap::updateStorageFaceLevel(int faceIndex, int level)
 
     if (image->isDirty())
     {
-        commitRect(faceIndex, level, 0, 0, image->getWidth(), image->getHeight());
+        std::vector<Box> dirtyBoxes = image->getDirtyBoxes();
+        for (size_t boxIndex = 0; boxIndex < dirtyBoxes.size(); boxIndex++)
+        {
+            const Box &box = dirtyBoxes[boxIndex];
+            commitRect(faceIndex, level, box.x, box.y, box.width, box.height);
+        }
     }
 }
 
@@ -1450,6 +1501,8 @@ int TextureCubeMap::targetToIndex(GLenum target)
 
 void TextureCubeMap::redefineImage(int faceIndex, GLint level, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    invalidateCompleteness();
+
     // If there currently is a corresponding storage texture image, it has these parameters
     const int storageWidth = std::max(1, getBaseLevelWidth() >> level);
     const int storageHeight = std::max(1, getBaseLevelHeight() >> level);
@@ -1560,6 +1613,8 @@ void TextureCubeMap::copySubImage(GLenum target, GLint level, GLint xoffset, GLi
 
 void TextureCubeMap::storage(GLsizei levels, GLenum internalformat, GLsizei size)
 {
+    invalidateCompleteness();
+
     for (int level = 0; level < levels; level++)
     {
         GLsizei mipSize = std::max(1, size >> level);
@@ -1599,6 +1654,9 @@ void TextureCubeMap::generateMipmaps()
     {
         for (int faceIndex = 0; faceIndex < 6; faceIndex++)
         {
+            // The mipmaps are generated from the base level in storage
+            updateStorageFaceLevel(faceIndex, 0);
+
             for (int level = 1; level <= q; level++)
             {
                 mTexStorage->generateMipmap(faceIndex, level);
@@ -1816,7 +1874,9 @@ void Texture3D::subImage(GLint level, GLint xoffset, GLint yoffset, GLint zoffse
         }
     }
 
-    if (!fastUnpacked && Texture::subImage(xoffset, yoffset, zoffset, width, height, depth, format, type, unpack, pixels, mImageArray[level]))
+    // Queued conversions stay dirty, and are copied to storage when the texture is next used
+    if (!fastUnpacked && Texture::subImage(xoffset, yoffset, zoffset, width, height, depth, format, type, unpack, pixels, mImageArray[level]) &&
+        !mImageArray[level]->hasPendingUpload())
     {
         commitRect(level, xoffset, yoffset, zoffset, width, height, depth);
     }
@@ -1832,6 +1892,8 @@ void Texture3D::subImageCompressed(GLint level, GLint xoffset, GLint yoffset, GL
 
 void Texture3D::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    invalidateCompleteness();
+
     for (int level = 0; level < levels; level++)
     {
         GLsizei levelWidth = std::max(1, width >> level);
@@ -1864,6 +1926,9 @@ void Texture3D::generateMipmaps()
 
     if (mTexStorage && mTexStorage->isRenderTarget())
     {
+        // The mipmaps are generated from the base level in storage
+        updateStorageLevel(0);
+
         for (int level = 1; level <= q; level++)
         {
             mTexStorage->generateMipmap(level);
@@ -1929,7 +1994,7 @@ void Texture3D::copySubImage(GLenum target, GLint level, GLint xoffset, GLint yo
     }
 }
 
-bool Texture3D::isSamplerComplete(const SamplerState &samplerState) const
+bool Texture3D::computeSamplerComplete(const SamplerState &samplerState) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -2107,7 +2172,12 @@ void Texture3D::updateStorageLevel(int level)
 
     if (mImageArray[level]->isDirty())
     {
-        commitRect(level, 0, 0, 0, getWidth(level), getHeight(level), getDepth(level));
+        std::vector<Box> dirtyBoxes = mImageArray[level]->getDirtyBoxes();
+        for (size_t boxIndex = 0; boxIndex < dirtyBoxes.size(); boxIndex++)
+        {
+            const Box &box = dirtyBoxes[boxIndex];
+            commitRect(level, box.x, box.y, box.z, box.width, box.height, box.depth);
+        }
     }
 }
 
@@ -2194,6 +2264,8 @@ rx::RenderTarget *Texture3D::getDepthStencil(GLint level, GLint layer)
 
 void Texture3D::redefineImage(GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    invalidateCompleteness();
+
     // If there currently is a corresponding storage texture image, it has these parameters
     const int storageWidth = std::max(1, getBaseLevelWidth() >> level);
     const int storageHeight = std::max(1, getBaseLevelHeight() >> level);
@@ -2231,7 +2303,7 @@ void Texture3D::commitRect(GLint level, GLint xoffset, GLint yoffset, GLint zoff
         rx::Image *image = mImageArray[level];
         if (image->copyToStorage(mTexStorage, level, xoffset, yoffset, zoffset, width, height, depth))
         {
-            image->markClean();
+            image->markClean(Box(xoffset, yoffset, zoffset, width, height, depth));
         }
     }
 }
@@ -2257,6 +2329,8 @@ Texture2DArray::~Texture2DArray()
 
 void Texture2DArray::deleteImages()
 {
+    invalidateCompleteness();
+
     for (int level = 0; level < IMPLEMENTATION_MAX_TEXTURE_LEVELS; ++level)
     {
         for (int layer = 0; layer < mLayerCounts[level]; ++layer)
@@ -2346,7 +2420,10 @@ void Texture2DArray::subImage(GLint level, GLint xoffset, GLint yoffset, GLint z
         int layer = zoffset + i;
         const void *layerPixels = pixels ? (reinterpret_cast<const unsigned char*>(pixels) + (inputDepthPitch * i)) : NULL;
 
-        if (Texture::subImage(xoffset, yoffset, zoffset, width, height, 1, format, type, unpack, layerPixels, mImageArray[level][layer]))
+        // Every layer has its own single layer image. Queued conversions stay dirty, and are
+        // copied to storage when the texture is next used.
+        if (Texture::subImage(xoffset, yoffset, 0, width, height, 1, format, type, unpack, layerPixels, mImageArray[level][layer]) &&
+            !mImageArray[level][layer]->hasPendingUpload())
         {
             commitRect(level, xoffset, yoffset, layer, width, height);
         }
@@ -2363,7 +2440,7 @@ void Texture2DArray::subImageCompressed(GLint level, GLint xoffset, GLint yoffse
         int layer = zoffset + i;
         const void *layerPixels = pixels ? (reinterpret_cast<const unsigned char*>(pixels) + (inputDepthPitch * i)) : NULL;
 
-        if (Texture::subImageCompressed(xoffset, yoffset, zoffset, width, height, 1, format, imageSize, layerPixels, mImageArray[level][layer]))
+        if (Texture::subImageCompressed(xoffset, yoffset, 0, width, height, 1, format, imageSize, layerPixels, mImageArray[level][layer]))
         {
             commitRect(level, xoffset, yoffset, layer, width, height);
         }
@@ -2372,6 +2449,8 @@ void Texture2DArray::subImageCompressed(GLint level, GLint xoffset, GLint yoffse
 
 void Texture2DArray::storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    invalidateCompleteness();
+
     deleteImages();
 
     for (int level = 0; level < IMPLEMENTATION_MAX_TEXTURE_LEVELS; level++)
@@ -2415,6 +2494,9 @@ void Texture2DArray::generateMipmaps()
 
     if (mTexStorage && mTexStorage->isRenderTarget())
     {
+        // The mipmaps are generated from the base level in storage
+        updateStorageLevel(0);
+
         for (int level = 1; level <= q; level++)
         {
             mTexStorage->generateMipmap(level);
@@ -2485,7 +2567,7 @@ void Texture2DArray::copySubImage(GLenum target, GLint level, GLint xoffset, GLi
     }
 }
 
-bool Texture2DArray::isSamplerComplete(const SamplerState &samplerState) const
+bool Texture2DArray::computeSamplerComplete(const SamplerState &samplerState) const
 {
     GLsizei width = getBaseLevelWidth();
     GLsizei height = getBaseLevelHeight();
@@ -2664,7 +2746,12 @@ void Texture2DArray::updateStorageLevel(int level)
         ASSERT(mImageArray[level] != NULL && mImageArray[level][layer] != NULL);
         if (mImageArray[level][layer]->isDirty())
         {
-            commitRect(level, 0, 0, layer, getWidth(level), getHeight(level));
+            std::vector<Box> dirtyBoxes = mImageArray[level][layer]->getDirtyBoxes();
+            for (size_t boxIndex = 0; boxIndex < dirtyBoxes.size(); boxIndex++)
+            {
+                const Box &box = dirtyBoxes[boxIndex];
+                commitRect(level, box.x, box.y, layer, box.width, box.height);
+            }
         }
     }
 }
@@ -2733,6 +2820,8 @@ rx::RenderTarget *Texture2DArray::getDepthStencil(GLint level, GLint layer)
 
 void Texture2DArray::redefineImage(GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    invalidateCompleteness();
+
     // If there currently is a corresponding storage texture image, it has these parameters
     const int storageWidth = std::max(1, getBaseLevelWidth() >> level);
     const int storageHeight = std::max(1, getBaseLevelHeight() >> level);
@@ -2790,7 +2879,7 @@ void Texture2DArray::commitRect(GLint level, GLint xoffset, GLint yoffset, GLint
         rx::Image *image = mImageArray[level][layerTarget];
         if (image->copyToStorage(mTexStorage, level, xoffset, yoffset, layerTarget, width, height))
         {
-            image->markClean();
+            image->markClean(Box(xoffset, yoffset, 0, width, height, 1));
         }
     }
 }
@@ -20,6 +20,7 @@
 #include "common/debug.h"
 #include "common/RefCountObject.h"
 #include "libGLESv2/angletypes.h"
+#include "libGLESv2/CompletenessCache.h"
 #include "libGLESv2/RenderbufferProxySet.h"
 
 namespace egl
@@ -103,7 +104,9 @@ class Texture : public RefCountObject
     GLint getBaseLevelDepth() const;
     GLenum getBaseLevelInternalFormat() const;
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState) const = 0;
+    // The sampler serial identifies the state of the sampler object the texture is sampled
+    // with, or is zero when it is sampled with its own parameters
+    bool isSamplerComplete(const SamplerState &samplerState, unsigned int samplerSerial);
 
     rx::TextureStorageInterface *getNativeTexture();
 
@@ -138,6 +141,8 @@ class Texture : public RefCountObject
     virtual void updateStorage() = 0;
     virtual bool ensureRenderTarget() = 0;
 
+    void invalidateCompleteness();
+
     rx::Renderer *mRenderer;
 
     SamplerState mSamplerState;
@@ -161,6 +166,9 @@ class Texture : public RefCountObject
 
     virtual rx::TextureStorageInterface *getBaseLevelStorage() = 0;
     virtual const rx::Image *getBaseLevelImage() const = 0;
+    virtual bool computeSamplerComplete(const SamplerState &samplerState) const = 0;
+
+    CompletenessCache mCompletenessCache;
 };
 
 class Texture2D : public Texture
@@ -185,7 +193,6 @@ class Texture2D : public Texture
     virtual void copySubImage(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
     void storage(GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState) const;
     virtual void bindTexImage(egl::Surface *surface);
     virtual void releaseTexImage();
 
@@ -210,6 +217,7 @@ class Texture2D : public Texture
     virtual bool ensureRenderTarget();
     virtual rx::TextureStorageInterface *getBaseLevelStorage();
     virtual const rx::Image *getBaseLevelImage() const;
+    virtual bool computeSamplerComplete(const SamplerState &samplerState) const;
 
     bool isMipmapComplete() const;
     bool isValidLevel(int level) const;
@@ -254,7 +262,6 @@ class TextureCubeMap : public Texture
     virtual void copySubImage(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
     void storage(GLsizei levels, GLenum internalformat, GLsizei size);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState) const;
     bool isCubeComplete() const;
 
     virtual void generateMipmaps();
@@ -280,6 +287,7 @@ class TextureCubeMap : public Texture
     virtual bool ensureRenderTarget();
     virtual rx::TextureStorageInterface *getBaseLevelStorage();
     virtual const rx::Image *getBaseLevelImage() const;
+    virtual bool computeSamplerComplete(const SamplerState &samplerState) const;
 
     bool isMipmapCubeComplete() const;
     bool isValidFaceLevel(int faceIndex, int level) const;
@@ -319,7 +327,6 @@ class Texture3D : public Texture
     virtual void generateMipmaps();
     virtual void copySubImage(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState) const;
     virtual bool isMipmapComplete() const;
 
     Renderbuffer *getRenderbuffer(GLint level, GLint layer);
@@ -343,6 +350,7 @@ class Texture3D : public Texture
 
     virtual rx::TextureStorageInterface *getBaseLevelStorage();
     virtual const rx::Image *getBaseLevelImage() const;
+    virtual bool computeSamplerComplete(const SamplerState &samplerState) const;
 
     void redefineImage(GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
     void commitRect(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth);
@@ -380,7 +388,6 @@ class Texture2DArray : public Texture
     virtual void generateMipmaps();
     virtual void copySubImage(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, Framebuffer *source);
 
-    virtual bool isSamplerComplete(const SamplerState &samplerState) const;
     virtual bool isMipmapComplete() const;
 
     Renderbuffer *getRenderbuffer(GLint level, GLint layer);
@@ -403,6 +410,7 @@ class Texture2DArray : public Texture
 
     virtual rx::TextureStorageInterface *getBaseLevelStorage();
     virtual const rx::Image *getBaseLevelImage() const;
+    virtual bool computeSamplerComplete(const SamplerState &samplerState) const;
 
     void deleteImages();
     void redefineImage(GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
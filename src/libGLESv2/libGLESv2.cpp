@@ -22,6 +22,7 @@
 #include "libGLESv2/Query.h"
 #include "libGLESv2/Context.h"
 #include "libGLESv2/VertexArray.h"
+#include "libGLESv2/Capture.h"
 
 #include "libGLESv2/validationES.h"
 #include "libGLESv2/validationES2.h"
@@ -36,6 +37,7 @@ extern "C"
 void __stdcall glActiveTexture(GLenum texture)
 {
     EVENT("(GLenum texture = 0x%X)", texture);
+    CAPTURE(glActiveTexture, texture);
 
     try
     {
@@ -60,6 +62,7 @@ void __stdcall glActiveTexture(GLenum texture)
 void __stdcall glAttachShader(GLuint program, GLuint shader)
 {
     EVENT("(GLuint program = %d, GLuint shader = %d)", program, shader);
+    CAPTURE(glAttachShader, program, shader);
 
     try
     {
@@ -109,6 +112,7 @@ void __stdcall glAttachShader(GLuint program, GLuint shader)
 void __stdcall glBeginQueryEXT(GLenum target, GLuint id)
 {
     EVENT("(GLenum target = 0x%X, GLuint %d)", target, id);
+    CAPTURE(glBeginQueryEXT, target, id);
 
     try
     {
@@ -138,6 +142,7 @@ void __stdcall glBeginQueryEXT(GLenum target, GLuint id)
 void __stdcall glBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
 {
     EVENT("(GLuint program = %d, GLuint index = %d, const GLchar* name = 0x%0.8p)", program, index, name);
+    CAPTURE(glBindAttribLocation, program, index, gl::CaptureString(name));
 
     try
     {
@@ -181,6 +186,7 @@ void __stdcall glBindAttribLocation(GLuint program, GLuint index, const GLchar*
 void __stdcall glBindBuffer(GLenum target, GLuint buffer)
 {
     EVENT("(GLenum target = 0x%X, GLuint buffer = %d)", target, buffer);
+    CAPTURE(glBindBuffer, target, buffer);
 
     try
     {
@@ -233,6 +239,7 @@ void __stdcall glBindBuffer(GLenum target, GLuint buffer)
 void __stdcall glBindFramebuffer(GLenum target, GLuint framebuffer)
 {
     EVENT("(GLenum target = 0x%X, GLuint framebuffer = %d)", target, framebuffer);
+    CAPTURE(glBindFramebuffer, target, framebuffer);
 
     try
     {
@@ -265,6 +272,7 @@ void __stdcall glBindFramebuffer(GLenum target, GLuint framebuffer)
 void __stdcall glBindRenderbuffer(GLenum target, GLuint renderbuffer)
 {
     EVENT("(GLenum target = 0x%X, GLuint renderbuffer = %d)", target, renderbuffer);
+    CAPTURE(glBindRenderbuffer, target, renderbuffer);
 
     try
     {
@@ -289,6 +297,7 @@ void __stdcall glBindRenderbuffer(GLenum target, GLuint renderbuffer)
 void __stdcall glBindTexture(GLenum target, GLuint texture)
 {
     EVENT("(GLenum target = 0x%X, GLuint texture = %d)", target, texture);
+    CAPTURE(glBindTexture, target, texture);
 
     try
     {
@@ -340,6 +349,7 @@ void __stdcall glBlendColor(GLclampf red, GLclampf green, GLclampf blue, GLclamp
 {
     EVENT("(GLclampf red = %f, GLclampf green = %f, GLclampf blue = %f, GLclampf alpha = %f)",
           red, green, blue, alpha);
+    CAPTURE(glBlendColor, red, green, blue, alpha);
 
     try
     {
@@ -358,12 +368,15 @@ void __stdcall glBlendColor(GLclampf red, GLclampf green, GLclampf blue, GLclamp
 
 void __stdcall glBlendEquation(GLenum mode)
 {
+    CAPTURE(glBlendEquation, mode);
+
     glBlendEquationSeparate(mode, mode);
 }
 
 void __stdcall glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
 {
     EVENT("(GLenum modeRGB = 0x%X, GLenum modeAlpha = 0x%X)", modeRGB, modeAlpha);
+    CAPTURE(glBlendEquationSeparate, modeRGB, modeAlpha);
 
     try
     {
@@ -420,6 +433,8 @@ void __stdcall glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
 
 void __stdcall glBlendFunc(GLenum sfactor, GLenum dfactor)
 {
+    CAPTURE(glBlendFunc, sfactor, dfactor);
+
     glBlendFuncSeparate(sfactor, dfactor, sfactor, dfactor);
 }
 
@@ -427,6 +442,7 @@ void __stdcall glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha
 {
     EVENT("(GLenum srcRGB = 0x%X, GLenum dstRGB = 0x%X, GLenum srcAlpha = 0x%X, GLenum dstAlpha = 0x%X)",
           srcRGB, dstRGB, srcAlpha, dstAlpha);
+    CAPTURE(glBlendFuncSeparate, srcRGB, dstRGB, srcAlpha, dstAlpha);
 
     try
     {
@@ -561,6 +577,7 @@ void __stdcall glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data,
 {
     EVENT("(GLenum target = 0x%X, GLsizeiptr size = %d, const GLvoid* data = 0x%0.8p, GLenum usage = %d)",
           target, size, data, usage);
+    CAPTURE(glBufferData, target, size, gl::CaptureMemory(data, size > 0 ? size : 0), usage);
 
     try
     {
@@ -621,6 +638,7 @@ void __stdcall glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size,
 {
     EVENT("(GLenum target = 0x%X, GLintptr offset = %d, GLsizeiptr size = %d, const GLvoid* data = 0x%0.8p)",
           target, offset, size, data);
+    CAPTURE(glBufferSubData, target, offset, size, gl::CaptureMemory(data, size > 0 ? size : 0));
 
     try
     {
@@ -672,6 +690,7 @@ void __stdcall glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size,
 GLenum __stdcall glCheckFramebufferStatus(GLenum target)
 {
     EVENT("(GLenum target = 0x%X)", target);
+    CAPTURE(glCheckFramebufferStatus, target);
 
     try
     {
@@ -700,6 +719,7 @@ GLenum __stdcall glCheckFramebufferStatus(GLenum target)
 void __stdcall glClear(GLbitfield mask)
 {
     EVENT("(GLbitfield mask = 0x%X)", mask);
+    CAPTURE(glClear, mask);
 
     try
     {
@@ -732,6 +752,7 @@ void __stdcall glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclamp
 {
     EVENT("(GLclampf red = %f, GLclampf green = %f, GLclampf blue = %f, GLclampf alpha = %f)",
           red, green, blue, alpha);
+    CAPTURE(glClearColor, red, green, blue, alpha);
 
     try
     {
@@ -751,6 +772,7 @@ void __stdcall glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclamp
 void __stdcall glClearDepthf(GLclampf depth)
 {
     EVENT("(GLclampf depth = %f)", depth);
+    CAPTURE(glClearDepthf, depth);
 
     try
     {
@@ -770,6 +792,7 @@ void __stdcall glClearDepthf(GLclampf depth)
 void __stdcall glClearStencil(GLint s)
 {
     EVENT("(GLint s = %d)", s);
+    CAPTURE(glClearStencil, s);
 
     try
     {
@@ -790,6 +813,7 @@ void __stdcall glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboo
 {
     EVENT("(GLboolean red = %d, GLboolean green = %u, GLboolean blue = %u, GLboolean alpha = %u)",
           red, green, blue, alpha);
+    CAPTURE(glColorMask, red, green, blue, alpha);
 
     try
     {
@@ -809,6 +833,7 @@ void __stdcall glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboo
 void __stdcall glCompileShader(GLuint shader)
 {
     EVENT("(GLuint shader = %d)", shader);
+    CAPTURE(glCompileShader, shader);
 
     try
     {
@@ -845,6 +870,7 @@ void __stdcall glCompressedTexImage2D(GLenum target, GLint level, GLenum interna
     EVENT("(GLenum target = 0x%X, GLint level = %d, GLenum internalformat = 0x%X, GLsizei width = %d, " 
           "GLsizei height = %d, GLint border = %d, GLsizei imageSize = %d, const GLvoid* data = 0x%0.8p)",
           target, level, internalformat, width, height, border, imageSize, data);
+    CAPTURE(glCompressedTexImage2D, target, level, internalformat, width, height, border, imageSize, gl::CaptureCompressedPixels(imageSize, data));
 
     try
     {
@@ -910,6 +936,7 @@ void __stdcall glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffs
           "GLsizei width = %d, GLsizei height = %d, GLenum format = 0x%X, "
           "GLsizei imageSize = %d, const GLvoid* data = 0x%0.8p)",
           target, level, xoffset, yoffset, width, height, format, imageSize, data);
+    CAPTURE(glCompressedTexSubImage2D, target, level, xoffset, yoffset, width, height, format, imageSize, gl::CaptureCompressedPixels(imageSize, data));
 
     try
     {
@@ -973,6 +1000,7 @@ void __stdcall glCopyTexImage2D(GLenum target, GLint level, GLenum internalforma
     EVENT("(GLenum target = 0x%X, GLint level = %d, GLenum internalformat = 0x%X, "
           "GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d, GLint border = %d)",
           target, level, internalformat, x, y, width, height, border);
+    CAPTURE(glCopyTexImage2D, target, level, internalformat, x, y, width, height, border);
 
     try
     {
@@ -1033,6 +1061,7 @@ void __stdcall glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GL
     EVENT("(GLenum target = 0x%X, GLint level = %d, GLint xoffset = %d, GLint yoffset = %d, "
           "GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d)",
           target, level, xoffset, yoffset, x, y, width, height);
+    CAPTURE(glCopyTexSubImage2D, target, level, xoffset, yoffset, x, y, width, height);
 
     try
     {
@@ -1092,6 +1121,7 @@ void __stdcall glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GL
 GLuint __stdcall glCreateProgram(void)
 {
     EVENT("()");
+    CAPTURE(glCreateProgram);
 
     try
     {
@@ -1113,6 +1143,7 @@ GLuint __stdcall glCreateProgram(void)
 GLuint __stdcall glCreateShader(GLenum type)
 {
     EVENT("(GLenum type = 0x%X)", type);
+    CAPTURE(glCreateShader, type);
 
     try
     {
@@ -1141,6 +1172,7 @@ GLuint __stdcall glCreateShader(GLenum type)
 void __stdcall glCullFace(GLenum mode)
 {
     EVENT("(GLenum mode = 0x%X)", mode);
+    CAPTURE(glCullFace, mode);
 
     try
     {
@@ -1171,6 +1203,7 @@ void __stdcall glCullFace(GLenum mode)
 void __stdcall glDeleteBuffers(GLsizei n, const GLuint* buffers)
 {
     EVENT("(GLsizei n = %d, const GLuint* buffers = 0x%0.8p)", n, buffers);
+    CAPTURE(glDeleteBuffers, n, gl::CaptureArray(buffers, n));
 
     try
     {
@@ -1198,6 +1231,7 @@ void __stdcall glDeleteBuffers(GLsizei n, const GLuint* buffers)
 void __stdcall glDeleteFencesNV(GLsizei n, const GLuint* fences)
 {
     EVENT("(GLsizei n = %d, const GLuint* fences = 0x%0.8p)", n, fences);
+    CAPTURE(glDeleteFencesNV, n, gl::CaptureArray(fences, n));
 
     try
     {
@@ -1225,6 +1259,7 @@ void __stdcall glDeleteFencesNV(GLsizei n, const GLuint* fences)
 void __stdcall glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
 {
     EVENT("(GLsizei n = %d, const GLuint* framebuffers = 0x%0.8p)", n, framebuffers);
+    CAPTURE(glDeleteFramebuffers, n, gl::CaptureArray(framebuffers, n));
 
     try
     {
@@ -1255,6 +1290,7 @@ void __stdcall glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
 void __stdcall glDeleteProgram(GLuint program)
 {
     EVENT("(GLuint program = %d)", program);
+    CAPTURE(glDeleteProgram, program);
 
     try
     {
@@ -1291,6 +1327,7 @@ void __stdcall glDeleteProgram(GLuint program)
 void __stdcall glDeleteQueriesEXT(GLsizei n, const GLuint *ids)
 {
     EVENT("(GLsizei n = %d, const GLuint *ids = 0x%0.8p)", n, ids);
+    CAPTURE(glDeleteQueriesEXT, n, gl::CaptureArray(ids, n));
 
     try
     {
@@ -1318,6 +1355,7 @@ void __stdcall glDeleteQueriesEXT(GLsizei n, const GLuint *ids)
 void __stdcall glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
 {
     EVENT("(GLsizei n = %d, const GLuint* renderbuffers = 0x%0.8p)", n, renderbuffers);
+    CAPTURE(glDeleteRenderbuffers, n, gl::CaptureArray(renderbuffers, n));
 
     try
     {
@@ -1345,6 +1383,7 @@ void __stdcall glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
 void __stdcall glDeleteShader(GLuint shader)
 {
     EVENT("(GLuint shader = %d)", shader);
+    CAPTURE(glDeleteShader, shader);
 
     try
     {
@@ -1381,6 +1420,7 @@ void __stdcall glDeleteShader(GLuint shader)
 void __stdcall glDeleteTextures(GLsizei n, const GLuint* textures)
 {
     EVENT("(GLsizei n = %d, const GLuint* textures = 0x%0.8p)", n, textures);
+    CAPTURE(glDeleteTextures, n, gl::CaptureArray(textures, n));
 
     try
     {
@@ -1411,6 +1451,7 @@ void __stdcall glDeleteTextures(GLsizei n, const GLuint* textures)
 void __stdcall glDepthFunc(GLenum func)
 {
     EVENT("(GLenum func = 0x%X)", func);
+    CAPTURE(glDepthFunc, func);
 
     try
     {
@@ -1445,6 +1486,7 @@ void __stdcall glDepthFunc(GLenum func)
 void __stdcall glDepthMask(GLboolean flag)
 {
     EVENT("(GLboolean flag = %u)", flag);
+    CAPTURE(glDepthMask, flag);
 
     try
     {
@@ -1464,6 +1506,7 @@ void __stdcall glDepthMask(GLboolean flag)
 void __stdcall glDepthRangef(GLclampf zNear, GLclampf zFar)
 {
     EVENT("(GLclampf zNear = %f, GLclampf zFar = %f)", zNear, zFar);
+    CAPTURE(glDepthRangef, zNear, zFar);
 
     try
     {
@@ -1483,6 +1526,7 @@ void __stdcall glDepthRangef(GLclampf zNear, GLclampf zFar)
 void __stdcall glDetachShader(GLuint program, GLuint shader)
 {
     EVENT("(GLuint program = %d, GLuint shader = %d)", program, shader);
+    CAPTURE(glDetachShader, program, shader);
 
     try
     {
@@ -1536,6 +1580,7 @@ void __stdcall glDetachShader(GLuint program, GLuint shader)
 void __stdcall glDisable(GLenum cap)
 {
     EVENT("(GLenum cap = 0x%X)", cap);
+    CAPTURE(glDisable, cap);
 
     try
     {
@@ -1560,6 +1605,7 @@ void __stdcall glDisable(GLenum cap)
 void __stdcall glDisableVertexAttribArray(GLuint index)
 {
     EVENT("(GLuint index = %d)", index);
+    CAPTURE(glDisableVertexAttribArray, index);
 
     try
     {
@@ -1584,24 +1630,19 @@ void __stdcall glDisableVertexAttribArray(GLuint index)
 void __stdcall glDrawArrays(GLenum mode, GLint first, GLsizei count)
 {
     EVENT("(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d)", mode, first, count);
+    CAPTURE_DRAW_ARRAYS(glDrawArrays, first, count, 0, mode, first, count);
 
     try
     {
-        if (count < 0 || first < 0)
-        {
-            return gl::error(GL_INVALID_VALUE);
-        }
-
         gl::Context *context = gl::getNonLostContext();
 
-        // Check for mapped buffers
-        if (context->hasMappedBuffer(GL_ARRAY_BUFFER))
-        {
-            return gl::error(GL_INVALID_OPERATION);
-        }
-
         if (context)
         {
+            if (!ValidateDrawArrays(context, first, count, 0))
+            {
+                return;
+            }
+
             context->drawArrays(mode, first, count, 0);
         }
     }
@@ -1614,25 +1655,20 @@ void __stdcall glDrawArrays(GLenum mode, GLint first, GLsizei count)
 void __stdcall glDrawArraysInstancedANGLE(GLenum mode, GLint first, GLsizei count, GLsizei primcount)
 {
     EVENT("(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d, GLsizei primcount = %d)", mode, first, count, primcount);
+    CAPTURE_DRAW_ARRAYS(glDrawArraysInstancedANGLE, first, count, primcount, mode, first, count, primcount);
 
     try
     {
-        if (count < 0 || first < 0 || primcount < 0)
-        {
-            return gl::error(GL_INVALID_VALUE);
-        }
+        gl::Context *context = gl::getNonLostContext();
 
-        if (primcount > 0)
+        if (context)
         {
-            gl::Context *context = gl::getNonLostContext();
-
-            // Check for mapped buffers
-            if (context->hasMappedBuffer(GL_ARRAY_BUFFER))
+            if (!ValidateDrawArrays(context, first, count, primcount))
             {
-                return gl::error(GL_INVALID_OPERATION);
+                return;
             }
 
-            if (context)
+            if (primcount > 0)
             {
                 context->drawArrays(mode, first, count, primcount);
             }
@@ -1648,37 +1684,17 @@ void __stdcall glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLv
 {
     EVENT("(GLenum mode = 0x%X, GLsizei count = %d, GLenum type = 0x%X, const GLvoid* indices = 0x%0.8p)",
           mode, count, type, indices);
+    CAPTURE_DRAW_ELEMENTS(glDrawElements, count, type, indices, 0, mode, count, type, gl::CaptureIndices(count, type, indices));
 
     try
     {
-        if (count < 0)
-        {
-            return gl::error(GL_INVALID_VALUE);
-        }
-
         gl::Context *context = gl::getNonLostContext();
 
         if (context)
         {
-            switch (type)
+            if (!ValidateDrawElements(context, count, type, 0))
             {
-              case GL_UNSIGNED_BYTE:
-              case GL_UNSIGNED_SHORT:
-                break;
-              case GL_UNSIGNED_INT:
-                if (!context->supports32bitIndices())
-                {
-                    return gl::error(GL_INVALID_ENUM);    
-                }
-                break;
-              default:
-                return gl::error(GL_INVALID_ENUM);
-            }
-        
-            // Check for mapped buffers
-            if (context->hasMappedBuffer(GL_ARRAY_BUFFER) || context->hasMappedBuffer(GL_ELEMENT_ARRAY_BUFFER))
-            {
-                return gl::error(GL_INVALID_OPERATION);
+                return;
             }
 
             context->drawElements(mode, count, type, indices, 0);
@@ -1694,41 +1710,21 @@ void __stdcall glDrawElementsInstancedANGLE(GLenum mode, GLsizei count, GLenum t
 {
     EVENT("(GLenum mode = 0x%X, GLsizei count = %d, GLenum type = 0x%X, const GLvoid* indices = 0x%0.8p, GLsizei primcount = %d)",
           mode, count, type, indices, primcount);
+    CAPTURE_DRAW_ELEMENTS(glDrawElementsInstancedANGLE, count, type, indices, primcount, mode, count, type, gl::CaptureIndices(count, type, indices), primcount);
 
     try
     {
-        if (count < 0 || primcount < 0)
-        {
-            return gl::error(GL_INVALID_VALUE);
-        }
+        gl::Context *context = gl::getNonLostContext();
 
-        if (primcount > 0)
+        if (context)
         {
-            gl::Context *context = gl::getNonLostContext();
-
-            if (context)
+            if (!ValidateDrawElements(context, count, type, primcount))
             {
-                switch (type)
-                {
-                  case GL_UNSIGNED_BYTE:
-                  case GL_UNSIGNED_SHORT:
-                    break;
-                  case GL_UNSIGNED_INT:
-                    if (!context->supports32bitIndices())
-                    {
-                        return gl::error(GL_INVALID_ENUM);    
-                    }
-                    break;
-                  default:
-                    return gl::error(GL_INVALID_ENUM);
-                }
-            
-                // Check for mapped buffers
-                if (context->hasMappedBuffer(GL_ARRAY_BUFFER) || context->hasMappedBuffer(GL_ELEMENT_ARRAY_BUFFER))
-                {
-                    return gl::error(GL_INVALID_OPERATION);
-                }
+                return;
+            }
 
+            if (primcount > 0)
+            {
                 context->drawElements(mode, count, type, indices, primcount);
             }
         }
@@ -1742,6 +1738,7 @@ void __stdcall glDrawElementsInstancedANGLE(GLenum mode, GLsizei count, GLenum t
 void __stdcall glEnable(GLenum cap)
 {
     EVENT("(GLenum cap = 0x%X)", cap);
+    CAPTURE(glEnable, cap);
 
     try
     {
@@ -1766,6 +1763,7 @@ void __stdcall glEnable(GLenum cap)
 void __stdcall glEnableVertexAttribArray(GLuint index)
 {
     EVENT("(GLuint index = %d)", index);
+    CAPTURE(glEnableVertexAttribArray, index);
 
     try
     {
@@ -1790,6 +1788,7 @@ void __stdcall glEnableVertexAttribArray(GLuint index)
 void __stdcall glEndQueryEXT(GLenum target)
 {
     EVENT("GLenum target = 0x%X)", target);
+    CAPTURE(glEndQueryEXT, target);
 
     try
     {
@@ -1814,6 +1813,7 @@ void __stdcall glEndQueryEXT(GLenum target)
 void __stdcall glFinishFenceNV(GLuint fence)
 {
     EVENT("(GLuint fence = %d)", fence);
+    CAPTURE(glFinishFenceNV, fence);
 
     try
     {
@@ -1845,6 +1845,7 @@ void __stdcall glFinishFenceNV(GLuint fence)
 void __stdcall glFinish(void)
 {
     EVENT("()");
+    CAPTURE(glFinish);
 
     try
     {
@@ -1864,6 +1865,7 @@ void __stdcall glFinish(void)
 void __stdcall glFlush(void)
 {
     EVENT("()");
+    CAPTURE(glFlush);
 
     try
     {
@@ -1884,6 +1886,7 @@ void __stdcall glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenu
 {
     EVENT("(GLenum target = 0x%X, GLenum attachment = 0x%X, GLenum renderbuffertarget = 0x%X, "
           "GLuint renderbuffer = %d)", target, attachment, renderbuffertarget, renderbuffer);
+    CAPTURE(glFramebufferRenderbuffer, target, attachment, renderbuffertarget, renderbuffer);
 
     try
     {
@@ -1939,6 +1942,7 @@ void __stdcall glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum t
 {
     EVENT("(GLenum target = 0x%X, GLenum attachment = 0x%X, GLenum textarget = 0x%X, "
           "GLuint texture = %d, GLint level = %d)", target, attachment, textarget, texture, level);
+    CAPTURE(glFramebufferTexture2D, target, attachment, textarget, texture, level);
 
     try
     {
@@ -1989,6 +1993,7 @@ void __stdcall glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum t
 void __stdcall glFrontFace(GLenum mode)
 {
     EVENT("(GLenum mode = 0x%X)", mode);
+    CAPTURE(glFrontFace, mode);
 
     try
     {
@@ -2018,6 +2023,7 @@ void __stdcall glFrontFace(GLenum mode)
 void __stdcall glGenBuffers(GLsizei n, GLuint* buffers)
 {
     EVENT("(GLsizei n = %d, GLuint* buffers = 0x%0.8p)", n, buffers);
+    CAPTURE(glGenBuffers, n, gl::CaptureOutput(buffers, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2045,6 +2051,7 @@ void __stdcall glGenBuffers(GLsizei n, GLuint* buffers)
 void __stdcall glGenerateMipmap(GLenum target)
 {
     EVENT("(GLenum target = 0x%X)", target);
+    CAPTURE(glGenerateMipmap, target);
 
     try
     {
@@ -2109,6 +2116,7 @@ void __stdcall glGenerateMipmap(GLenum target)
 void __stdcall glGenFencesNV(GLsizei n, GLuint* fences)
 {
     EVENT("(GLsizei n = %d, GLuint* fences = 0x%0.8p)", n, fences);
+    CAPTURE(glGenFencesNV, n, gl::CaptureOutput(fences, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2136,6 +2144,7 @@ void __stdcall glGenFencesNV(GLsizei n, GLuint* fences)
 void __stdcall glGenFramebuffers(GLsizei n, GLuint* framebuffers)
 {
     EVENT("(GLsizei n = %d, GLuint* framebuffers = 0x%0.8p)", n, framebuffers);
+    CAPTURE(glGenFramebuffers, n, gl::CaptureOutput(framebuffers, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2163,6 +2172,7 @@ void __stdcall glGenFramebuffers(GLsizei n, GLuint* framebuffers)
 void __stdcall glGenQueriesEXT(GLsizei n, GLuint* ids)
 {
     EVENT("(GLsizei n = %d, GLuint* ids = 0x%0.8p)", n, ids);
+    CAPTURE(glGenQueriesEXT, n, gl::CaptureOutput(ids, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2190,6 +2200,7 @@ void __stdcall glGenQueriesEXT(GLsizei n, GLuint* ids)
 void __stdcall glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
 {
     EVENT("(GLsizei n = %d, GLuint* renderbuffers = 0x%0.8p)", n, renderbuffers);
+    CAPTURE(glGenRenderbuffers, n, gl::CaptureOutput(renderbuffers, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2217,6 +2228,7 @@ void __stdcall glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
 void __stdcall glGenTextures(GLsizei n, GLuint* textures)
 {
     EVENT("(GLsizei n = %d, GLuint* textures = 0x%0.8p)", n, textures);
+    CAPTURE(glGenTextures, n, gl::CaptureOutput(textures, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2246,6 +2258,7 @@ void __stdcall glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufsize,
     EVENT("(GLuint program = %d, GLuint index = %d, GLsizei bufsize = %d, GLsizei *length = 0x%0.8p, "
           "GLint *size = 0x%0.8p, GLenum *type = %0.8p, GLchar *name = %0.8p)",
           program, index, bufsize, length, size, type, name);
+    CAPTURE(glGetActiveAttrib, program, index, bufsize, length, size, type, gl::CaptureOutput(name, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -2291,6 +2304,7 @@ void __stdcall glGetActiveUniform(GLuint program, GLuint index, GLsizei bufsize,
     EVENT("(GLuint program = %d, GLuint index = %d, GLsizei bufsize = %d, "
           "GLsizei* length = 0x%0.8p, GLint* size = 0x%0.8p, GLenum* type = 0x%0.8p, GLchar* name = 0x%0.8p)",
           program, index, bufsize, length, size, type, name);
+    CAPTURE(glGetActiveUniform, program, index, bufsize, length, size, type, gl::CaptureOutput(name, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -2335,6 +2349,7 @@ void __stdcall glGetAttachedShaders(GLuint program, GLsizei maxcount, GLsizei* c
 {
     EVENT("(GLuint program = %d, GLsizei maxcount = %d, GLsizei* count = 0x%0.8p, GLuint* shaders = 0x%0.8p)",
           program, maxcount, count, shaders);
+    CAPTURE(glGetAttachedShaders, program, maxcount, count, gl::CaptureOutput(shaders, (maxcount > 0 ? maxcount : 0) * sizeof(GLuint)));
 
     try
     {
@@ -2373,6 +2388,7 @@ void __stdcall glGetAttachedShaders(GLuint program, GLsizei maxcount, GLsizei* c
 int __stdcall glGetAttribLocation(GLuint program, const GLchar* name)
 {
     EVENT("(GLuint program = %d, const GLchar* name = %s)", program, name);
+    CAPTURE(glGetAttribLocation, program, gl::CaptureString(name));
 
     try
     {
@@ -2415,6 +2431,7 @@ int __stdcall glGetAttribLocation(GLuint program, const GLchar* name)
 void __stdcall glGetBooleanv(GLenum pname, GLboolean* params)
 {
     EVENT("(GLenum pname = 0x%X, GLboolean* params = 0x%0.8p)",  pname, params);
+    CAPTURE(glGetBooleanv, pname, params);
 
     try
     {
@@ -2450,6 +2467,7 @@ void __stdcall glGetBooleanv(GLenum pname, GLboolean* params)
 void __stdcall glGetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetBufferParameteriv, target, pname, params);
 
     try
     {
@@ -2508,6 +2526,7 @@ void __stdcall glGetBufferParameteriv(GLenum target, GLenum pname, GLint* params
 GLenum __stdcall glGetError(void)
 {
     EVENT("()");
+    CAPTURE(glGetError);
 
     gl::Context *context = gl::getContext();
 
@@ -2522,6 +2541,7 @@ GLenum __stdcall glGetError(void)
 void __stdcall glGetFenceivNV(GLuint fence, GLenum pname, GLint *params)
 {
     EVENT("(GLuint fence = %d, GLenum pname = 0x%X, GLint *params = 0x%0.8p)", fence, pname, params);
+    CAPTURE(glGetFenceivNV, fence, pname, params);
 
     try
     {
@@ -2563,6 +2583,7 @@ void __stdcall glGetFenceivNV(GLuint fence, GLenum pname, GLint *params)
 void __stdcall glGetFloatv(GLenum pname, GLfloat* params)
 {
     EVENT("(GLenum pname = 0x%X, GLfloat* params = 0x%0.8p)", pname, params);
+    CAPTURE(glGetFloatv, pname, params);
 
     try
     {
@@ -2599,6 +2620,7 @@ void __stdcall glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attac
 {
     EVENT("(GLenum target = 0x%X, GLenum attachment = 0x%X, GLenum pname = 0x%X, GLint* params = 0x%0.8p)",
           target, attachment, pname, params);
+    CAPTURE(glGetFramebufferAttachmentParameteriv, target, attachment, pname, params);
 
     try
     {
@@ -2901,6 +2923,7 @@ void __stdcall glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attac
 GLenum __stdcall glGetGraphicsResetStatusEXT(void)
 {
     EVENT("()");
+    CAPTURE(glGetGraphicsResetStatusEXT);
 
     try
     {
@@ -2922,6 +2945,7 @@ GLenum __stdcall glGetGraphicsResetStatusEXT(void)
 void __stdcall glGetIntegerv(GLenum pname, GLint* params)
 {
     EVENT("(GLenum pname = 0x%X, GLint* params = 0x%0.8p)", pname, params);
+    CAPTURE(glGetIntegerv, pname, params);
 
     try
     {
@@ -2957,6 +2981,7 @@ void __stdcall glGetIntegerv(GLenum pname, GLint* params)
 void __stdcall glGetProgramiv(GLuint program, GLenum pname, GLint* params)
 {
     EVENT("(GLuint program = %d, GLenum pname = %d, GLint* params = 0x%0.8p)", program, pname, params);
+    CAPTURE(glGetProgramiv, program, pname, params);
 
     try
     {
@@ -3034,6 +3059,7 @@ void __stdcall glGetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* len
 {
     EVENT("(GLuint program = %d, GLsizei bufsize = %d, GLsizei* length = 0x%0.8p, GLchar* infolog = 0x%0.8p)",
           program, bufsize, length, infolog);
+    CAPTURE(glGetProgramInfoLog, program, bufsize, length, gl::CaptureOutput(infolog, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -3065,6 +3091,7 @@ void __stdcall glGetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* len
 void __stdcall glGetQueryivEXT(GLenum target, GLenum pname, GLint *params)
 {
     EVENT("GLenum target = 0x%X, GLenum pname = 0x%X, GLint *params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetQueryivEXT, target, pname, params);
 
     try
     {
@@ -3097,6 +3124,7 @@ void __stdcall glGetQueryivEXT(GLenum target, GLenum pname, GLint *params)
 void __stdcall glGetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint *params)
 {
     EVENT("(GLuint id = %d, GLenum pname = 0x%X, GLuint *params = 0x%0.8p)", id, pname, params);
+    CAPTURE(glGetQueryObjectuivEXT, id, pname, params);
 
     try
     {
@@ -3138,6 +3166,7 @@ void __stdcall glGetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint *params)
 void __stdcall glGetRenderbufferParameteriv(GLenum target, GLenum pname, GLint* params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetRenderbufferParameteriv, target, pname, params);
 
     try
     {
@@ -3192,6 +3221,7 @@ void __stdcall glGetRenderbufferParameteriv(GLenum target, GLenum pname, GLint*
 void __stdcall glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
 {
     EVENT("(GLuint shader = %d, GLenum pname = %d, GLint* params = 0x%0.8p)", shader, pname, params);
+    CAPTURE(glGetShaderiv, shader, pname, params);
 
     try
     {
@@ -3241,6 +3271,7 @@ void __stdcall glGetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* lengt
 {
     EVENT("(GLuint shader = %d, GLsizei bufsize = %d, GLsizei* length = 0x%0.8p, GLchar* infolog = 0x%0.8p)",
           shader, bufsize, length, infolog);
+    CAPTURE(glGetShaderInfoLog, shader, bufsize, length, gl::CaptureOutput(infolog, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -3273,6 +3304,7 @@ void __stdcall glGetShaderPrecisionFormat(GLenum shadertype, GLenum precisiontyp
 {
     EVENT("(GLenum shadertype = 0x%X, GLenum precisiontype = 0x%X, GLint* range = 0x%0.8p, GLint* precision = 0x%0.8p)",
           shadertype, precisiontype, range, precision);
+    CAPTURE(glGetShaderPrecisionFormat, shadertype, precisiontype, range, precision);
 
     try
     {
@@ -3318,6 +3350,7 @@ void __stdcall glGetShaderSource(GLuint shader, GLsizei bufsize, GLsizei* length
 {
     EVENT("(GLuint shader = %d, GLsizei bufsize = %d, GLsizei* length = 0x%0.8p, GLchar* source = 0x%0.8p)",
           shader, bufsize, length, source);
+    CAPTURE(glGetShaderSource, shader, bufsize, length, gl::CaptureOutput(source, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -3350,6 +3383,7 @@ void __stdcall glGetTranslatedShaderSourceANGLE(GLuint shader, GLsizei bufsize,
 {
     EVENT("(GLuint shader = %d, GLsizei bufsize = %d, GLsizei* length = 0x%0.8p, GLchar* source = 0x%0.8p)",
           shader, bufsize, length, source);
+    CAPTURE(glGetTranslatedShaderSourceANGLE, shader, bufsize, length, gl::CaptureOutput(source, bufsize > 0 ? bufsize : 0));
 
     try
     {
@@ -3381,6 +3415,7 @@ void __stdcall glGetTranslatedShaderSourceANGLE(GLuint shader, GLsizei bufsize,
 const GLubyte* __stdcall glGetString(GLenum name)
 {
     EVENT("(GLenum name = 0x%X)", name);
+    CAPTURE(glGetString, name);
 
     try
     {
@@ -3425,6 +3460,7 @@ const GLubyte* __stdcall glGetString(GLenum name)
 void __stdcall glGetTexParameterfv(GLenum target, GLenum pname, GLfloat* params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLfloat* params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetTexParameterfv, target, pname, params);
 
     try
     {
@@ -3523,6 +3559,7 @@ void __stdcall glGetTexParameterfv(GLenum target, GLenum pname, GLfloat* params)
 void __stdcall glGetTexParameteriv(GLenum target, GLenum pname, GLint* params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetTexParameteriv, target, pname, params);
 
     try
     {
@@ -3623,6 +3660,7 @@ void __stdcall glGetnUniformfvEXT(GLuint program, GLint location, GLsizei bufSiz
 {
     EVENT("(GLuint program = %d, GLint location = %d, GLsizei bufSize = %d, GLfloat* params = 0x%0.8p)",
           program, location, bufSize, params);
+    CAPTURE(glGetnUniformfvEXT, program, location, bufSize, gl::CaptureOutput(params, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -3668,6 +3706,7 @@ void __stdcall glGetnUniformfvEXT(GLuint program, GLint location, GLsizei bufSiz
 void __stdcall glGetUniformfv(GLuint program, GLint location, GLfloat* params)
 {
     EVENT("(GLuint program = %d, GLint location = %d, GLfloat* params = 0x%0.8p)", program, location, params);
+    CAPTURE(glGetUniformfv, program, location, params);
 
     try
     {
@@ -3709,6 +3748,7 @@ void __stdcall glGetnUniformivEXT(GLuint program, GLint location, GLsizei bufSiz
 {
     EVENT("(GLuint program = %d, GLint location = %d, GLsizei bufSize = %d, GLint* params = 0x%0.8p)", 
           program, location, bufSize, params);
+    CAPTURE(glGetnUniformivEXT, program, location, bufSize, gl::CaptureOutput(params, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -3754,6 +3794,7 @@ void __stdcall glGetnUniformivEXT(GLuint program, GLint location, GLsizei bufSiz
 void __stdcall glGetUniformiv(GLuint program, GLint location, GLint* params)
 {
     EVENT("(GLuint program = %d, GLint location = %d, GLint* params = 0x%0.8p)", program, location, params);
+    CAPTURE(glGetUniformiv, program, location, params);
 
     try
     {
@@ -3794,6 +3835,7 @@ void __stdcall glGetUniformiv(GLuint program, GLint location, GLint* params)
 int __stdcall glGetUniformLocation(GLuint program, const GLchar* name)
 {
     EVENT("(GLuint program = %d, const GLchar* name = 0x%0.8p)", program, name);
+    CAPTURE(glGetUniformLocation, program, gl::CaptureString(name));
 
     try
     {
@@ -3840,6 +3882,7 @@ int __stdcall glGetUniformLocation(GLuint program, const GLchar* name)
 void __stdcall glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params)
 {
     EVENT("(GLuint index = %d, GLenum pname = 0x%X, GLfloat* params = 0x%0.8p)", index, pname, params);
+    CAPTURE(glGetVertexAttribfv, index, pname, params);
 
     try
     {
@@ -3882,6 +3925,7 @@ void __stdcall glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params)
 void __stdcall glGetVertexAttribiv(GLuint index, GLenum pname, GLint* params)
 {
     EVENT("(GLuint index = %d, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", index, pname, params);
+    CAPTURE(glGetVertexAttribiv, index, pname, params);
 
     try
     {
@@ -3925,6 +3969,7 @@ void __stdcall glGetVertexAttribiv(GLuint index, GLenum pname, GLint* params)
 void __stdcall glGetVertexAttribPointerv(GLuint index, GLenum pname, GLvoid** pointer)
 {
     EVENT("(GLuint index = %d, GLenum pname = 0x%X, GLvoid** pointer = 0x%0.8p)", index, pname, pointer);
+    CAPTURE(glGetVertexAttribPointerv, index, pname, pointer);
 
     try
     {
@@ -3954,6 +3999,7 @@ void __stdcall glGetVertexAttribPointerv(GLuint index, GLenum pname, GLvoid** po
 void __stdcall glHint(GLenum target, GLenum mode)
 {
     EVENT("(GLenum target = 0x%X, GLenum mode = 0x%X)", target, mode);
+    CAPTURE(glHint, target, mode);
 
     try
     {
@@ -3989,6 +4035,7 @@ void __stdcall glHint(GLenum target, GLenum mode)
 GLboolean __stdcall glIsBuffer(GLuint buffer)
 {
     EVENT("(GLuint buffer = %d)", buffer);
+    CAPTURE(glIsBuffer, buffer);
 
     try
     {
@@ -4015,6 +4062,7 @@ GLboolean __stdcall glIsBuffer(GLuint buffer)
 GLboolean __stdcall glIsEnabled(GLenum cap)
 {
     EVENT("(GLenum cap = 0x%X)", cap);
+    CAPTURE(glIsEnabled, cap);
 
     try
     {
@@ -4041,6 +4089,7 @@ GLboolean __stdcall glIsEnabled(GLenum cap)
 GLboolean __stdcall glIsFenceNV(GLuint fence)
 {
     EVENT("(GLuint fence = %d)", fence);
+    CAPTURE(glIsFenceNV, fence);
 
     try
     {
@@ -4069,6 +4118,7 @@ GLboolean __stdcall glIsFenceNV(GLuint fence)
 GLboolean __stdcall glIsFramebuffer(GLuint framebuffer)
 {
     EVENT("(GLuint framebuffer = %d)", framebuffer);
+    CAPTURE(glIsFramebuffer, framebuffer);
 
     try
     {
@@ -4095,6 +4145,7 @@ GLboolean __stdcall glIsFramebuffer(GLuint framebuffer)
 GLboolean __stdcall glIsProgram(GLuint program)
 {
     EVENT("(GLuint program = %d)", program);
+    CAPTURE(glIsProgram, program);
 
     try
     {
@@ -4121,6 +4172,7 @@ GLboolean __stdcall glIsProgram(GLuint program)
 GLboolean __stdcall glIsQueryEXT(GLuint id)
 {
     EVENT("(GLuint id = %d)", id);
+    CAPTURE(glIsQueryEXT, id);
 
     try
     {
@@ -4142,6 +4194,7 @@ GLboolean __stdcall glIsQueryEXT(GLuint id)
 GLboolean __stdcall glIsRenderbuffer(GLuint renderbuffer)
 {
     EVENT("(GLuint renderbuffer = %d)", renderbuffer);
+    CAPTURE(glIsRenderbuffer, renderbuffer);
 
     try
     {
@@ -4168,6 +4221,7 @@ GLboolean __stdcall glIsRenderbuffer(GLuint renderbuffer)
 GLboolean __stdcall glIsShader(GLuint shader)
 {
     EVENT("(GLuint shader = %d)", shader);
+    CAPTURE(glIsShader, shader);
 
     try
     {
@@ -4194,6 +4248,7 @@ GLboolean __stdcall glIsShader(GLuint shader)
 GLboolean __stdcall glIsTexture(GLuint texture)
 {
     EVENT("(GLuint texture = %d)", texture);
+    CAPTURE(glIsTexture, texture);
 
     try
     {
@@ -4220,6 +4275,7 @@ GLboolean __stdcall glIsTexture(GLuint texture)
 void __stdcall glLineWidth(GLfloat width)
 {
     EVENT("(GLfloat width = %f)", width);
+    CAPTURE(glLineWidth, width);
 
     try
     {
@@ -4244,6 +4300,7 @@ void __stdcall glLineWidth(GLfloat width)
 void __stdcall glLinkProgram(GLuint program)
 {
     EVENT("(GLuint program = %d)", program);
+    CAPTURE(glLinkProgram, program);
 
     try
     {
@@ -4277,6 +4334,7 @@ void __stdcall glLinkProgram(GLuint program)
 void __stdcall glPixelStorei(GLenum pname, GLint param)
 {
     EVENT("(GLenum pname = 0x%X, GLint param = %d)", pname, param);
+    CAPTURE(glPixelStorei, pname, param);
 
     try
     {
@@ -4337,6 +4395,7 @@ void __stdcall glPixelStorei(GLenum pname, GLint param)
 void __stdcall glPolygonOffset(GLfloat factor, GLfloat units)
 {
     EVENT("(GLfloat factor = %f, GLfloat units = %f)", factor, units);
+    CAPTURE(glPolygonOffset, factor, units);
 
     try
     {
@@ -4360,6 +4419,7 @@ void __stdcall glReadnPixelsEXT(GLint x, GLint y, GLsizei width, GLsizei height,
     EVENT("(GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d, "
           "GLenum format = 0x%X, GLenum type = 0x%X, GLsizei bufSize = 0x%d, GLvoid *data = 0x%0.8p)",
           x, y, width, height, format, type, bufSize, data);
+    CAPTURE(glReadnPixelsEXT, x, y, width, height, format, type, bufSize, gl::CaptureOutput(data, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -4393,6 +4453,7 @@ void __stdcall glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height,
     EVENT("(GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d, "
           "GLenum format = 0x%X, GLenum type = 0x%X, GLvoid* pixels = 0x%0.8p)",
           x, y, width, height, format, type,  pixels);
+    CAPTURE(glReadPixels, x, y, width, height, format, type, gl::CapturePackPixels(width, height, format, type, pixels));
 
     try
     {
@@ -4423,6 +4484,7 @@ void __stdcall glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height,
 void __stdcall glReleaseShaderCompiler(void)
 {
     EVENT("()");
+    CAPTURE(glReleaseShaderCompiler);
 
     try
     {
@@ -4438,6 +4500,7 @@ void __stdcall glRenderbufferStorageMultisampleANGLE(GLenum target, GLsizei samp
 {
     EVENT("(GLenum target = 0x%X, GLsizei samples = %d, GLenum internalformat = 0x%X, GLsizei width = %d, GLsizei height = %d)",
           target, samples, internalformat, width, height);
+    CAPTURE(glRenderbufferStorageMultisampleANGLE, target, samples, internalformat, width, height);
 
     try
     {
@@ -4462,12 +4525,15 @@ void __stdcall glRenderbufferStorageMultisampleANGLE(GLenum target, GLsizei samp
 
 void __stdcall glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    CAPTURE(glRenderbufferStorage, target, internalformat, width, height);
+
     glRenderbufferStorageMultisampleANGLE(target, 0, internalformat, width, height);
 }
 
 void __stdcall glSampleCoverage(GLclampf value, GLboolean invert)
 {
     EVENT("(GLclampf value = %f, GLboolean invert = %u)", value, invert);
+    CAPTURE(glSampleCoverage, value, invert);
 
     try
     {
@@ -4487,6 +4553,7 @@ void __stdcall glSampleCoverage(GLclampf value, GLboolean invert)
 void __stdcall glSetFenceNV(GLuint fence, GLenum condition)
 {
     EVENT("(GLuint fence = %d, GLenum condition = 0x%X)", fence, condition);
+    CAPTURE(glSetFenceNV, fence, condition);
 
     try
     {
@@ -4518,6 +4585,7 @@ void __stdcall glSetFenceNV(GLuint fence, GLenum condition)
 void __stdcall glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
 {
     EVENT("(GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d)", x, y, width, height);
+    CAPTURE(glScissor, x, y, width, height);
 
     try
     {
@@ -4544,6 +4612,7 @@ void __stdcall glShaderBinary(GLsizei n, const GLuint* shaders, GLenum binaryfor
     EVENT("(GLsizei n = %d, const GLuint* shaders = 0x%0.8p, GLenum binaryformat = 0x%X, "
           "const GLvoid* binary = 0x%0.8p, GLsizei length = %d)",
           n, shaders, binaryformat, binary, length);
+    CAPTURE(glShaderBinary, n, gl::CaptureArray(shaders, n), binaryformat, gl::CaptureMemory(binary, length > 0 ? length : 0), length);
 
     try
     {
@@ -4560,6 +4629,7 @@ void __stdcall glShaderSource(GLuint shader, GLsizei count, const GLchar* const*
 {
     EVENT("(GLuint shader = %d, GLsizei count = %d, const GLchar** string = 0x%0.8p, const GLint* length = 0x%0.8p)",
           shader, count, string, length);
+    CAPTURE(glShaderSource, shader, count, gl::CaptureStrings(count, string, length), gl::CaptureMemory(NULL, 0));
 
     try
     {
@@ -4597,12 +4667,15 @@ void __stdcall glShaderSource(GLuint shader, GLsizei count, const GLchar* const*
 
 void __stdcall glStencilFunc(GLenum func, GLint ref, GLuint mask)
 {
+    CAPTURE(glStencilFunc, func, ref, mask);
+
     glStencilFuncSeparate(GL_FRONT_AND_BACK, func, ref, mask);
 }
 
 void __stdcall glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
 {
     EVENT("(GLenum face = 0x%X, GLenum func = 0x%X, GLint ref = %d, GLuint mask = %d)", face, func, ref, mask);
+    CAPTURE(glStencilFuncSeparate, face, func, ref, mask);
 
     try
     {
@@ -4654,12 +4727,15 @@ void __stdcall glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint
 
 void __stdcall glStencilMask(GLuint mask)
 {
+    CAPTURE(glStencilMask, mask);
+
     glStencilMaskSeparate(GL_FRONT_AND_BACK, mask);
 }
 
 void __stdcall glStencilMaskSeparate(GLenum face, GLuint mask)
 {
     EVENT("(GLenum face = 0x%X, GLuint mask = %d)", face, mask);
+    CAPTURE(glStencilMaskSeparate, face, mask);
 
     try
     {
@@ -4696,6 +4772,8 @@ void __stdcall glStencilMaskSeparate(GLenum face, GLuint mask)
 
 void __stdcall glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
 {
+    CAPTURE(glStencilOp, fail, zfail, zpass);
+
     glStencilOpSeparate(GL_FRONT_AND_BACK, fail, zfail, zpass);
 }
 
@@ -4703,6 +4781,7 @@ void __stdcall glStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenu
 {
     EVENT("(GLenum face = 0x%X, GLenum fail = 0x%X, GLenum zfail = 0x%X, GLenum zpas = 0x%Xs)",
           face, fail, zfail, zpass);
+    CAPTURE(glStencilOpSeparate, face, fail, zfail, zpass);
 
     try
     {
@@ -4785,6 +4864,7 @@ void __stdcall glStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenu
 GLboolean __stdcall glTestFenceNV(GLuint fence)
 {
     EVENT("(GLuint fence = %d)", fence);
+    CAPTURE(glTestFenceNV, fence);
 
     try
     {
@@ -4821,6 +4901,7 @@ void __stdcall glTexImage2D(GLenum target, GLint level, GLint internalformat, GL
     EVENT("(GLenum target = 0x%X, GLint level = %d, GLint internalformat = %d, GLsizei width = %d, GLsizei height = %d, "
           "GLint border = %d, GLenum format = 0x%X, GLenum type = 0x%X, const GLvoid* pixels = 0x%0.8p)",
           target, level, internalformat, width, height, border, format, type, pixels);
+    CAPTURE(glTexImage2D, target, level, internalformat, width, height, border, format, type, gl::CaptureUnpackPixels(width, height, 1, format, type, pixels));
 
     try
     {
@@ -4899,6 +4980,7 @@ void __stdcall glTexImage2D(GLenum target, GLint level, GLint internalformat, GL
 void __stdcall glTexParameterf(GLenum target, GLenum pname, GLfloat param)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint param = %f)", target, pname, param);
+    CAPTURE(glTexParameterf, target, pname, param);
 
     try
     {
@@ -4953,12 +5035,15 @@ void __stdcall glTexParameterf(GLenum target, GLenum pname, GLfloat param)
 
 void __stdcall glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params)
 {
+    CAPTURE(glTexParameterfv, target, pname, gl::CaptureArray(params, 1));
+
     glTexParameterf(target, pname, (GLfloat)*params);
 }
 
 void __stdcall glTexParameteri(GLenum target, GLenum pname, GLint param)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint param = %d)", target, pname, param);
+    CAPTURE(glTexParameteri, target, pname, param);
 
     try
     {
@@ -5013,6 +5098,8 @@ void __stdcall glTexParameteri(GLenum target, GLenum pname, GLint param)
 
 void __stdcall glTexParameteriv(GLenum target, GLenum pname, const GLint* params)
 {
+    CAPTURE(glTexParameteriv, target, pname, gl::CaptureArray(params, 1));
+
     glTexParameteri(target, pname, *params);
 }
 
@@ -5020,6 +5107,7 @@ void __stdcall glTexStorage2DEXT(GLenum target, GLsizei levels, GLenum internalf
 {
     EVENT("(GLenum target = 0x%X, GLsizei levels = %d, GLenum internalformat = 0x%X, GLsizei width = %d, GLsizei height = %d)",
            target, levels, internalformat, width, height);
+    CAPTURE(glTexStorage2DEXT, target, levels, internalformat, width, height);
 
     try
     {
@@ -5073,6 +5161,7 @@ void __stdcall glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint
           "GLsizei width = %d, GLsizei height = %d, GLenum format = 0x%X, GLenum type = 0x%X, "
           "const GLvoid* pixels = 0x%0.8p)",
            target, level, xoffset, yoffset, width, height, format, type, pixels);
+    CAPTURE(glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, gl::CaptureUnpackPixels(width, height, 1, format, type, pixels));
 
     try
     {
@@ -5128,12 +5217,15 @@ void __stdcall glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint
 
 void __stdcall glUniform1f(GLint location, GLfloat x)
 {
+    CAPTURE(glUniform1f, location, x);
+
     glUniform1fv(location, 1, &x);
 }
 
 void __stdcall glUniform1fv(GLint location, GLsizei count, const GLfloat* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLfloat* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform1fv, location, count, gl::CaptureArray(v, count * 1));
 
     try
     {
@@ -5171,12 +5263,15 @@ void __stdcall glUniform1fv(GLint location, GLsizei count, const GLfloat* v)
 
 void __stdcall glUniform1i(GLint location, GLint x)
 {
+    CAPTURE(glUniform1i, location, x);
+
     glUniform1iv(location, 1, &x);
 }
 
 void __stdcall glUniform1iv(GLint location, GLsizei count, const GLint* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLint* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform1iv, location, count, gl::CaptureArray(v, count * 1));
 
     try
     {
@@ -5214,6 +5309,8 @@ void __stdcall glUniform1iv(GLint location, GLsizei count, const GLint* v)
 
 void __stdcall glUniform2f(GLint location, GLfloat x, GLfloat y)
 {
+    CAPTURE(glUniform2f, location, x, y);
+
     GLfloat xy[2] = {x, y};
 
     glUniform2fv(location, 1, (GLfloat*)&xy);
@@ -5222,6 +5319,7 @@ void __stdcall glUniform2f(GLint location, GLfloat x, GLfloat y)
 void __stdcall glUniform2fv(GLint location, GLsizei count, const GLfloat* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLfloat* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform2fv, location, count, gl::CaptureArray(v, count * 2));
 
     try
     {
@@ -5259,6 +5357,8 @@ void __stdcall glUniform2fv(GLint location, GLsizei count, const GLfloat* v)
 
 void __stdcall glUniform2i(GLint location, GLint x, GLint y)
 {
+    CAPTURE(glUniform2i, location, x, y);
+
     GLint xy[4] = {x, y};
 
     glUniform2iv(location, 1, (GLint*)&xy);
@@ -5267,6 +5367,7 @@ void __stdcall glUniform2i(GLint location, GLint x, GLint y)
 void __stdcall glUniform2iv(GLint location, GLsizei count, const GLint* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLint* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform2iv, location, count, gl::CaptureArray(v, count * 2));
 
     try
     {
@@ -5304,6 +5405,8 @@ void __stdcall glUniform2iv(GLint location, GLsizei count, const GLint* v)
 
 void __stdcall glUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
 {
+    CAPTURE(glUniform3f, location, x, y, z);
+
     GLfloat xyz[3] = {x, y, z};
 
     glUniform3fv(location, 1, (GLfloat*)&xyz);
@@ -5312,6 +5415,7 @@ void __stdcall glUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
 void __stdcall glUniform3fv(GLint location, GLsizei count, const GLfloat* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLfloat* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform3fv, location, count, gl::CaptureArray(v, count * 3));
 
     try
     {
@@ -5349,6 +5453,8 @@ void __stdcall glUniform3fv(GLint location, GLsizei count, const GLfloat* v)
 
 void __stdcall glUniform3i(GLint location, GLint x, GLint y, GLint z)
 {
+    CAPTURE(glUniform3i, location, x, y, z);
+
     GLint xyz[3] = {x, y, z};
 
     glUniform3iv(location, 1, (GLint*)&xyz);
@@ -5357,6 +5463,7 @@ void __stdcall glUniform3i(GLint location, GLint x, GLint y, GLint z)
 void __stdcall glUniform3iv(GLint location, GLsizei count, const GLint* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLint* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform3iv, location, count, gl::CaptureArray(v, count * 3));
 
     try
     {
@@ -5394,6 +5501,8 @@ void __stdcall glUniform3iv(GLint location, GLsizei count, const GLint* v)
 
 void __stdcall glUniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
+    CAPTURE(glUniform4f, location, x, y, z, w);
+
     GLfloat xyzw[4] = {x, y, z, w};
 
     glUniform4fv(location, 1, (GLfloat*)&xyzw);
@@ -5402,6 +5511,7 @@ void __stdcall glUniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfl
 void __stdcall glUniform4fv(GLint location, GLsizei count, const GLfloat* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLfloat* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform4fv, location, count, gl::CaptureArray(v, count * 4));
 
     try
     {
@@ -5439,6 +5549,8 @@ void __stdcall glUniform4fv(GLint location, GLsizei count, const GLfloat* v)
 
 void __stdcall glUniform4i(GLint location, GLint x, GLint y, GLint z, GLint w)
 {
+    CAPTURE(glUniform4i, location, x, y, z, w);
+
     GLint xyzw[4] = {x, y, z, w};
 
     glUniform4iv(location, 1, (GLint*)&xyzw);
@@ -5447,6 +5559,7 @@ void __stdcall glUniform4i(GLint location, GLint x, GLint y, GLint z, GLint w)
 void __stdcall glUniform4iv(GLint location, GLsizei count, const GLint* v)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLint* v = 0x%0.8p)", location, count, v);
+    CAPTURE(glUniform4iv, location, count, gl::CaptureArray(v, count * 4));
 
     try
     {
@@ -5486,6 +5599,7 @@ void __stdcall glUniformMatrix2fv(GLint location, GLsizei count, GLboolean trans
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix2fv, location, count, transpose, gl::CaptureArray(value, count * 4));
 
     try
     {
@@ -5530,6 +5644,7 @@ void __stdcall glUniformMatrix3fv(GLint location, GLsizei count, GLboolean trans
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix3fv, location, count, transpose, gl::CaptureArray(value, count * 9));
 
     try
     {
@@ -5574,6 +5689,7 @@ void __stdcall glUniformMatrix4fv(GLint location, GLsizei count, GLboolean trans
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix4fv, location, count, transpose, gl::CaptureArray(value, count * 16));
 
     try
     {
@@ -5617,6 +5733,7 @@ void __stdcall glUniformMatrix4fv(GLint location, GLsizei count, GLboolean trans
 void __stdcall glUseProgram(GLuint program)
 {
     EVENT("(GLuint program = %d)", program);
+    CAPTURE(glUseProgram, program);
 
     try
     {
@@ -5655,6 +5772,7 @@ void __stdcall glUseProgram(GLuint program)
 void __stdcall glValidateProgram(GLuint program)
 {
     EVENT("(GLuint program = %d)", program);
+    CAPTURE(glValidateProgram, program);
 
     try
     {
@@ -5688,6 +5806,7 @@ void __stdcall glValidateProgram(GLuint program)
 void __stdcall glVertexAttrib1f(GLuint index, GLfloat x)
 {
     EVENT("(GLuint index = %d, GLfloat x = %f)", index, x);
+    CAPTURE(glVertexAttrib1f, index, x);
 
     try
     {
@@ -5713,6 +5832,7 @@ void __stdcall glVertexAttrib1f(GLuint index, GLfloat x)
 void __stdcall glVertexAttrib1fv(GLuint index, const GLfloat* values)
 {
     EVENT("(GLuint index = %d, const GLfloat* values = 0x%0.8p)", index, values);
+    CAPTURE(glVertexAttrib1fv, index, gl::CaptureArray(values, 1));
 
     try
     {
@@ -5738,6 +5858,7 @@ void __stdcall glVertexAttrib1fv(GLuint index, const GLfloat* values)
 void __stdcall glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
 {
     EVENT("(GLuint index = %d, GLfloat x = %f, GLfloat y = %f)", index, x, y);
+    CAPTURE(glVertexAttrib2f, index, x, y);
 
     try
     {
@@ -5763,6 +5884,7 @@ void __stdcall glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
 void __stdcall glVertexAttrib2fv(GLuint index, const GLfloat* values)
 {
     EVENT("(GLuint index = %d, const GLfloat* values = 0x%0.8p)", index, values);
+    CAPTURE(glVertexAttrib2fv, index, gl::CaptureArray(values, 2));
 
     try
     {
@@ -5788,6 +5910,7 @@ void __stdcall glVertexAttrib2fv(GLuint index, const GLfloat* values)
 void __stdcall glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
 {
     EVENT("(GLuint index = %d, GLfloat x = %f, GLfloat y = %f, GLfloat z = %f)", index, x, y, z);
+    CAPTURE(glVertexAttrib3f, index, x, y, z);
 
     try
     {
@@ -5813,6 +5936,7 @@ void __stdcall glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
 void __stdcall glVertexAttrib3fv(GLuint index, const GLfloat* values)
 {
     EVENT("(GLuint index = %d, const GLfloat* values = 0x%0.8p)", index, values);
+    CAPTURE(glVertexAttrib3fv, index, gl::CaptureArray(values, 3));
 
     try
     {
@@ -5838,6 +5962,7 @@ void __stdcall glVertexAttrib3fv(GLuint index, const GLfloat* values)
 void __stdcall glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
     EVENT("(GLuint index = %d, GLfloat x = %f, GLfloat y = %f, GLfloat z = %f, GLfloat w = %f)", index, x, y, z, w);
+    CAPTURE(glVertexAttrib4f, index, x, y, z, w);
 
     try
     {
@@ -5863,6 +5988,7 @@ void __stdcall glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, G
 void __stdcall glVertexAttrib4fv(GLuint index, const GLfloat* values)
 {
     EVENT("(GLuint index = %d, const GLfloat* values = 0x%0.8p)", index, values);
+    CAPTURE(glVertexAttrib4fv, index, gl::CaptureArray(values, 4));
 
     try
     {
@@ -5887,6 +6013,7 @@ void __stdcall glVertexAttrib4fv(GLuint index, const GLfloat* values)
 void __stdcall glVertexAttribDivisorANGLE(GLuint index, GLuint divisor)
 {
     EVENT("(GLuint index = %d, GLuint divisor = %d)", index, divisor);
+    CAPTURE(glVertexAttribDivisorANGLE, index, divisor);
 
     try
     {
@@ -5913,6 +6040,7 @@ void __stdcall glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLbo
     EVENT("(GLuint index = %d, GLint size = %d, GLenum type = 0x%X, "
           "GLboolean normalized = %u, GLsizei stride = %d, const GLvoid* ptr = 0x%0.8p)",
           index, size, type, normalized, stride, ptr);
+    CAPTURE(glVertexAttribPointer, index, size, type, normalized, stride, ptr);
 
     try
     {
@@ -5988,6 +6116,7 @@ void __stdcall glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLbo
 void __stdcall glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
 {
     EVENT("(GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d)", x, y, width, height);
+    CAPTURE(glViewport, x, y, width, height);
 
     try
     {
@@ -6014,6 +6143,7 @@ void __stdcall glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
 void __stdcall glReadBuffer(GLenum mode)
 {
     EVENT("(GLenum mode = 0x%X)", mode);
+    CAPTURE(glReadBuffer, mode);
 
     try
     {
@@ -6040,6 +6170,7 @@ void __stdcall glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsize
 {
     EVENT("(GLenum mode = 0x%X, GLuint start = %u, GLuint end = %u, GLsizei count = %d, GLenum type = 0x%X, "
           "const GLvoid* indices = 0x%0.8p)", mode, start, end, count, type, indices);
+    CAPTURE_DRAW_ELEMENTS(glDrawRangeElements, count, type, indices, 0, mode, start, end, count, type, gl::CaptureIndices(count, type, indices));
 
     try
     {
@@ -6068,6 +6199,7 @@ void __stdcall glTexImage3D(GLenum target, GLint level, GLint internalformat, GL
           "GLsizei height = %d, GLsizei depth = %d, GLint border = %d, GLenum format = 0x%X, "
           "GLenum type = 0x%X, const GLvoid* pixels = 0x%0.8p)",
           target, level, internalformat, width, height, depth, border, format, type, pixels);
+    CAPTURE(glTexImage3D, target, level, internalformat, width, height, depth, border, format, type, gl::CaptureUnpackPixels(width, height, depth, format, type, pixels));
 
     try
     {
@@ -6120,6 +6252,7 @@ void __stdcall glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint
           "GLint zoffset = %d, GLsizei width = %d, GLsizei height = %d, GLsizei depth = %d, "
           "GLenum format = 0x%X, GLenum type = 0x%X, const GLvoid* pixels = 0x%0.8p)",
           target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+    CAPTURE(glTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, gl::CaptureUnpackPixels(width, height, depth, format, type, pixels));
 
     try
     {
@@ -6172,6 +6305,7 @@ void __stdcall glCopyTexSubImage3D(GLenum target, GLint level, GLint xoffset, GL
     EVENT("(GLenum target = 0x%X, GLint level = %d, GLint xoffset = %d, GLint yoffset = %d, "
           "GLint zoffset = %d, GLint x = %d, GLint y = %d, GLsizei width = %d, GLsizei height = %d)",
           target, level, xoffset, yoffset, zoffset, x, y, width, height);
+    CAPTURE(glCopyTexSubImage3D, target, level, xoffset, yoffset, zoffset, x, y, width, height);
 
     try
     {
@@ -6221,6 +6355,7 @@ void __stdcall glCompressedTexImage3D(GLenum target, GLint level, GLenum interna
           "GLsizei height = %d, GLsizei depth = %d, GLint border = %d, GLsizei imageSize = %d, "
           "const GLvoid* data = 0x%0.8p)",
           target, level, internalformat, width, height, depth, border, imageSize, data);
+    CAPTURE(glCompressedTexImage3D, target, level, internalformat, width, height, depth, border, imageSize, gl::CaptureCompressedPixels(imageSize, data));
 
     try
     {
@@ -6278,6 +6413,7 @@ void __stdcall glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffs
         "GLint zoffset = %d, GLsizei width = %d, GLsizei height = %d, GLsizei depth = %d, "
         "GLenum format = 0x%X, GLsizei imageSize = %d, const GLvoid* data = 0x%0.8p)",
         target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+    CAPTURE(glCompressedTexSubImage3D, target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, gl::CaptureCompressedPixels(imageSize, data));
 
     try
     {
@@ -6339,6 +6475,7 @@ void __stdcall glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffs
 void __stdcall glGenQueries(GLsizei n, GLuint* ids)
 {
     EVENT("(GLsizei n = %d, GLuint* ids = 0x%0.8p)", n, ids);
+    CAPTURE(glGenQueries, n, gl::CaptureOutput(ids, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -6371,6 +6508,7 @@ void __stdcall glGenQueries(GLsizei n, GLuint* ids)
 void __stdcall glDeleteQueries(GLsizei n, const GLuint* ids)
 {
     EVENT("(GLsizei n = %d, GLuint* ids = 0x%0.8p)", n, ids);
+    CAPTURE(glDeleteQueries, n, gl::CaptureArray(ids, n));
 
     try
     {
@@ -6403,6 +6541,7 @@ void __stdcall glDeleteQueries(GLsizei n, const GLuint* ids)
 GLboolean __stdcall glIsQuery(GLuint id)
 {
     EVENT("(GLuint id = %u)", id);
+    CAPTURE(glIsQuery, id);
 
     try
     {
@@ -6429,6 +6568,7 @@ GLboolean __stdcall glIsQuery(GLuint id)
 void __stdcall glBeginQuery(GLenum target, GLuint id)
 {
     EVENT("(GLenum target = 0x%X, GLuint id = %u)", target, id);
+    CAPTURE(glBeginQuery, target, id);
 
     try
     {
@@ -6463,6 +6603,7 @@ void __stdcall glBeginQuery(GLenum target, GLuint id)
 void __stdcall glEndQuery(GLenum target)
 {
     EVENT("(GLenum target = 0x%X)", target);
+    CAPTURE(glEndQuery, target);
 
     try
     {
@@ -6492,6 +6633,7 @@ void __stdcall glEndQuery(GLenum target)
 void __stdcall glGetQueryiv(GLenum target, GLenum pname, GLint* params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetQueryiv, target, pname, params);
 
     try
     {
@@ -6529,6 +6671,7 @@ void __stdcall glGetQueryiv(GLenum target, GLenum pname, GLint* params)
 void __stdcall glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params)
 {
     EVENT("(GLuint id = %u, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", id, pname, params);
+    CAPTURE(glGetQueryObjectuiv, id, pname, params);
 
     try
     {
@@ -6575,6 +6718,7 @@ void __stdcall glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params)
 GLboolean __stdcall glUnmapBuffer(GLenum target)
 {
     EVENT("(GLenum target = 0x%X)", target);
+    CAPTURE(glUnmapBuffer, target);
 
     try
     {
@@ -6612,6 +6756,7 @@ GLboolean __stdcall glUnmapBuffer(GLenum target)
 void __stdcall glGetBufferPointerv(GLenum target, GLenum pname, GLvoid** params)
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLvoid** params = 0x%0.8p)", target, pname, params);
+    CAPTURE(glGetBufferPointerv, target, pname, params);
 
     try
     {
@@ -6647,6 +6792,8 @@ void __stdcall glGetBufferPointerv(GLenum target, GLenum pname, GLvoid** params)
 
 void __stdcall glDrawBuffers(GLsizei n, const GLenum* bufs)
 {
+    CAPTURE(glDrawBuffers, n, gl::CaptureArray(bufs, n));
+
     try
     {
         gl::Context *context = gl::getNonLostContext();
@@ -6671,6 +6818,7 @@ void __stdcall glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix2x3fv, location, count, transpose, gl::CaptureArray(value, count * 6));
 
     try
     {
@@ -6715,6 +6863,7 @@ void __stdcall glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix3x2fv, location, count, transpose, gl::CaptureArray(value, count * 6));
 
     try
     {
@@ -6759,6 +6908,7 @@ void __stdcall glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix2x4fv, location, count, transpose, gl::CaptureArray(value, count * 8));
 
     try
     {
@@ -6803,6 +6953,7 @@ void __stdcall glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix4x2fv, location, count, transpose, gl::CaptureArray(value, count * 8));
 
     try
     {
@@ -6847,6 +6998,7 @@ void __stdcall glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix3x4fv, location, count, transpose, gl::CaptureArray(value, count * 12));
 
     try
     {
@@ -6891,6 +7043,7 @@ void __stdcall glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean tra
 {
     EVENT("(GLint location = %d, GLsizei count = %d, GLboolean transpose = %u, const GLfloat* value = 0x%0.8p)",
           location, count, transpose, value);
+    CAPTURE(glUniformMatrix4x3fv, location, count, transpose, gl::CaptureArray(value, count * 12));
 
     try
     {
@@ -6936,6 +7089,7 @@ void __stdcall glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint sr
     EVENT("(GLint srcX0 = %d, GLint srcY0 = %d, GLint srcX1 = %d, GLint srcY1 = %d, GLint dstX0 = %d, "
           "GLint dstY0 = %d, GLint dstX1 = %d, GLint dstY1 = %d, GLbitfield mask = 0x%X, GLenum filter = 0x%X)",
           srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    CAPTURE(glBlitFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
 
     try
     {
@@ -6968,6 +7122,7 @@ void __stdcall glRenderbufferStorageMultisample(GLenum target, GLsizei samples,
 {
     EVENT("(GLenum target = 0x%X, GLsizei samples = %d, GLenum internalformat = 0x%X, GLsizei width = %d, GLsizei height = %d)",
         target, samples, internalformat, width, height);
+    CAPTURE(glRenderbufferStorageMultisample, target, samples, internalformat, width, height);
 
     try
     {
@@ -6999,6 +7154,7 @@ void __stdcall glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuin
 {
     EVENT("(GLenum target = 0x%X, GLenum attachment = 0x%X, GLuint texture = %u, GLint level = %d, GLint layer = %d)",
         target, attachment, texture, level, layer);
+    CAPTURE(glFramebufferTextureLayer, target, attachment, texture, level, layer);
 
     try
     {
@@ -7048,6 +7204,7 @@ GLvoid* __stdcall glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr le
 {
     EVENT("(GLenum target = 0x%X, GLintptr offset = %d, GLsizeiptr length = %d, GLbitfield access = 0x%X)",
           target, offset, length, access);
+    CAPTURE(glMapBufferRange, target, offset, length, access);
 
     try
     {
@@ -7134,6 +7291,7 @@ GLvoid* __stdcall glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr le
 void __stdcall glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
 {
     EVENT("(GLenum target = 0x%X, GLintptr offset = %d, GLsizeiptr length = %d)", target, offset, length);
+    CAPTURE(glFlushMappedBufferRange, target, offset, length);
 
     try
     {
@@ -7180,6 +7338,7 @@ void __stdcall glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeip
 void __stdcall glBindVertexArray(GLuint array)
 {
     EVENT("(GLuint array = %u)", array);
+    CAPTURE(glBindVertexArray, array);
 
     try
     {
@@ -7213,6 +7372,7 @@ void __stdcall glBindVertexArray(GLuint array)
 void __stdcall glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
 {
     EVENT("(GLsizei n = %d, const GLuint* arrays = 0x%0.8p)", n, arrays);
+    CAPTURE(glDeleteVertexArrays, n, gl::CaptureArray(arrays, n));
 
     try
     {
@@ -7248,6 +7408,7 @@ void __stdcall glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
 void __stdcall glGenVertexArrays(GLsizei n, GLuint* arrays)
 {
     EVENT("(GLsizei n = %d, GLuint* arrays = 0x%0.8p)", n, arrays);
+    CAPTURE(glGenVertexArrays, n, gl::CaptureOutput(arrays, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -7280,6 +7441,7 @@ void __stdcall glGenVertexArrays(GLsizei n, GLuint* arrays)
 GLboolean __stdcall glIsVertexArray(GLuint array)
 {
     EVENT("(GLuint array = %u)", array);
+    CAPTURE(glIsVertexArray, array);
 
     try
     {
@@ -7314,6 +7476,7 @@ void __stdcall glGetIntegeri_v(GLenum target, GLuint index, GLint* data)
 {
     EVENT("(GLenum target = 0x%X, GLuint index = %u, GLint* data = 0x%0.8p)",
           target, index, data);
+    CAPTURE(glGetIntegeri_v, target, index, data);
 
     try
     {
@@ -7386,6 +7549,7 @@ void __stdcall glGetIntegeri_v(GLenum target, GLuint index, GLint* data)
 void __stdcall glBeginTransformFeedback(GLenum primitiveMode)
 {
     EVENT("(GLenum primitiveMode = 0x%X)", primitiveMode);
+    CAPTURE(glBeginTransformFeedback, primitiveMode);
 
     try
     {
@@ -7411,6 +7575,7 @@ void __stdcall glBeginTransformFeedback(GLenum primitiveMode)
 void __stdcall glEndTransformFeedback(void)
 {
     EVENT("(void)");
+    CAPTURE(glEndTransformFeedback);
 
     try
     {
@@ -7437,6 +7602,7 @@ void __stdcall glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLi
 {
     EVENT("(GLenum target = 0x%X, GLuint index = %u, GLuint buffer = %u, GLintptr offset = %d, GLsizeiptr size = %d)",
           target, index, buffer, offset, size);
+    CAPTURE(glBindBufferRange, target, index, buffer, offset, size);
 
     try
     {
@@ -7515,6 +7681,7 @@ void __stdcall glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
 {
     EVENT("(GLenum target = 0x%X, GLuint index = %u, GLuint buffer = %u)",
           target, index, buffer);
+    CAPTURE(glBindBufferBase, target, index, buffer);
 
     try
     {
@@ -7574,6 +7741,7 @@ void __stdcall glTransformFeedbackVaryings(GLuint program, GLsizei count, const
 {
     EVENT("(GLuint program = %u, GLsizei count = %d, const GLchar* const* varyings = 0x%0.8p, GLenum bufferMode = 0x%X)",
           program, count, varyings, bufferMode);
+    CAPTURE(glTransformFeedbackVaryings, program, count, gl::CaptureStrings(count, varyings, NULL), bufferMode);
 
     try
     {
@@ -7601,6 +7769,7 @@ void __stdcall glGetTransformFeedbackVarying(GLuint program, GLuint index, GLsiz
     EVENT("(GLuint program = %u, GLuint index = %u, GLsizei bufSize = %d, GLsizei* length = 0x%0.8p, "
           "GLsizei* size = 0x%0.8p, GLenum* type = 0x%0.8p, GLchar* name = 0x%0.8p)",
           program, index, bufSize, length, size, type, name);
+    CAPTURE(glGetTransformFeedbackVarying, program, index, bufSize, length, size, type, gl::CaptureOutput(name, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -7627,6 +7796,7 @@ void __stdcall glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLs
 {
     EVENT("(GLuint index = %u, GLint size = %d, GLenum type = 0x%X, GLsizei stride = %d, const GLvoid* pointer = 0x%0.8p)",
           index, size, type, stride, pointer);
+    CAPTURE(glVertexAttribIPointer, index, size, type, stride, pointer);
 
     try
     {
@@ -7700,6 +7870,7 @@ void __stdcall glGetVertexAttribIiv(GLuint index, GLenum pname, GLint* params)
 {
     EVENT("(GLuint index = %u, GLenum pname = 0x%X, GLint* params = 0x%0.8p)",
           index, pname, params);
+    CAPTURE(glGetVertexAttribIiv, index, pname, params);
 
     try
     {
@@ -7748,6 +7919,7 @@ void __stdcall glGetVertexAttribIuiv(GLuint index, GLenum pname, GLuint* params)
 {
     EVENT("(GLuint index = %u, GLenum pname = 0x%X, GLuint* params = 0x%0.8p)",
           index, pname, params);
+    CAPTURE(glGetVertexAttribIuiv, index, pname, params);
 
     try
     {
@@ -7796,6 +7968,7 @@ void __stdcall glVertexAttribI4i(GLuint index, GLint x, GLint y, GLint z, GLint
 {
     EVENT("(GLuint index = %u, GLint x = %d, GLint y = %d, GLint z = %d, GLint w = %d)",
           index, x, y, z, w);
+    CAPTURE(glVertexAttribI4i, index, x, y, z, w);
 
     try
     {
@@ -7827,6 +8000,7 @@ void __stdcall glVertexAttribI4ui(GLuint index, GLuint x, GLuint y, GLuint z, GL
 {
     EVENT("(GLuint index = %u, GLuint x = %u, GLuint y = %u, GLuint z = %u, GLuint w = %u)",
           index, x, y, z, w);
+    CAPTURE(glVertexAttribI4ui, index, x, y, z, w);
 
     try
     {
@@ -7857,6 +8031,7 @@ void __stdcall glVertexAttribI4ui(GLuint index, GLuint x, GLuint y, GLuint z, GL
 void __stdcall glVertexAttribI4iv(GLuint index, const GLint* v)
 {
     EVENT("(GLuint index = %u, const GLint* v = 0x%0.8p)", index, v);
+    CAPTURE(glVertexAttribI4iv, index, gl::CaptureArray(v, 4));
 
     try
     {
@@ -7886,6 +8061,7 @@ void __stdcall glVertexAttribI4iv(GLuint index, const GLint* v)
 void __stdcall glVertexAttribI4uiv(GLuint index, const GLuint* v)
 {
     EVENT("(GLuint index = %u, const GLuint* v = 0x%0.8p)", index, v);
+    CAPTURE(glVertexAttribI4uiv, index, gl::CaptureArray(v, 4));
 
     try
     {
@@ -7916,6 +8092,7 @@ void __stdcall glGetUniformuiv(GLuint program, GLint location, GLuint* params)
 {
     EVENT("(GLuint program = %u, GLint location = %d, GLuint* params = 0x%0.8p)",
           program, location, params);
+    CAPTURE(glGetUniformuiv, program, location, params);
 
     try
     {
@@ -7962,6 +8139,7 @@ GLint __stdcall glGetFragDataLocation(GLuint program, const GLchar *name)
 {
     EVENT("(GLuint program = %u, const GLchar *name = 0x%0.8p)",
           program, name);
+    CAPTURE(glGetFragDataLocation, program, gl::CaptureString(name));
 
     try
     {
@@ -8005,23 +8183,31 @@ GLint __stdcall glGetFragDataLocation(GLuint program, const GLchar *name)
 
 void __stdcall glUniform1ui(GLint location, GLuint v0)
 {
+    CAPTURE(glUniform1ui, location, v0);
+
     glUniform1uiv(location, 1, &v0);
 }
 
 void __stdcall glUniform2ui(GLint location, GLuint v0, GLuint v1)
 {
+    CAPTURE(glUniform2ui, location, v0, v1);
+
     const GLuint xy[] = { v0, v1 };
     glUniform2uiv(location, 1, xy);
 }
 
 void __stdcall glUniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2)
 {
+    CAPTURE(glUniform3ui, location, v0, v1, v2);
+
     const GLuint xyz[] = { v0, v1, v2 };
     glUniform3uiv(location, 1, xyz);
 }
 
 void __stdcall glUniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)
 {
+    CAPTURE(glUniform4ui, location, v0, v1, v2, v3);
+
     const GLuint xyzw[] = { v0, v1, v2, v3 };
     glUniform4uiv(location, 1, xyzw);
 }
@@ -8030,6 +8216,7 @@ void __stdcall glUniform1uiv(GLint location, GLsizei count, const GLuint* value)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLuint* value = 0x%0.8p)",
           location, count, value);
+    CAPTURE(glUniform1uiv, location, count, gl::CaptureArray(value, count * 1));
 
     try
     {
@@ -8064,6 +8251,7 @@ void __stdcall glUniform2uiv(GLint location, GLsizei count, const GLuint* value)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLuint* value = 0x%0.8p)",
           location, count, value);
+    CAPTURE(glUniform2uiv, location, count, gl::CaptureArray(value, count * 2));
 
     try
     {
@@ -8098,6 +8286,7 @@ void __stdcall glUniform3uiv(GLint location, GLsizei count, const GLuint* value)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLuint* value)",
           location, count, value);
+    CAPTURE(glUniform3uiv, location, count, gl::CaptureArray(value, count * 3));
 
     try
     {
@@ -8132,6 +8321,7 @@ void __stdcall glUniform4uiv(GLint location, GLsizei count, const GLuint* value)
 {
     EVENT("(GLint location = %d, GLsizei count = %d, const GLuint* value = 0x%0.8p)",
           location, count, value);
+    CAPTURE(glUniform4uiv, location, count, gl::CaptureArray(value, count * 4));
 
     try
     {
@@ -8166,6 +8356,7 @@ void __stdcall glClearBufferiv(GLenum buffer, GLint drawbuffer, const GLint* val
 {
     EVENT("(GLenum buffer = 0x%X, GLint drawbuffer = %d, const GLint* value = 0x%0.8p)",
           buffer, drawbuffer, value);
+    CAPTURE(glClearBufferiv, buffer, drawbuffer, gl::CaptureArray(value, buffer == GL_COLOR ? 4 : 1));
 
     try
     {
@@ -8209,6 +8400,7 @@ void __stdcall glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint* v
 {
     EVENT("(GLenum buffer = 0x%X, GLint drawbuffer = %d, const GLuint* value = 0x%0.8p)",
           buffer, drawbuffer, value);
+    CAPTURE(glClearBufferuiv, buffer, drawbuffer, gl::CaptureArray(value, buffer == GL_COLOR ? 4 : 1));
 
     try
     {
@@ -8246,6 +8438,7 @@ void __stdcall glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* v
 {
     EVENT("(GLenum buffer = 0x%X, GLint drawbuffer = %d, const GLfloat* value = 0x%0.8p)",
           buffer, drawbuffer, value);
+    CAPTURE(glClearBufferfv, buffer, drawbuffer, gl::CaptureArray(value, buffer == GL_COLOR ? 4 : 1));
 
     try
     {
@@ -8289,6 +8482,7 @@ void __stdcall glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, G
 {
     EVENT("(GLenum buffer = 0x%X, GLint drawbuffer = %d, GLfloat depth, GLint stencil = %d)",
           buffer, drawbuffer, depth, stencil);
+    CAPTURE(glClearBufferfi, buffer, drawbuffer, depth, stencil);
 
     try
     {
@@ -8325,6 +8519,7 @@ void __stdcall glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, G
 const GLubyte* __stdcall glGetStringi(GLenum name, GLuint index)
 {
     EVENT("(GLenum name = 0x%X, GLuint index = %u)", name, index);
+    CAPTURE(glGetStringi, name, index);
 
     try
     {
@@ -8362,6 +8557,7 @@ void __stdcall glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintp
 {
     EVENT("(GLenum readTarget = 0x%X, GLenum writeTarget = 0x%X, GLintptr readOffset = %d, GLintptr writeOffset = %d, GLsizeiptr size = %d)",
           readTarget, writeTarget, readOffset, writeOffset, size);
+    CAPTURE(glCopyBufferSubData, readTarget, writeTarget, readOffset, writeOffset, size);
 
     try
     {
@@ -8423,6 +8619,7 @@ void __stdcall glGetUniformIndices(GLuint program, GLsizei uniformCount, const G
 {
     EVENT("(GLuint program = %u, GLsizei uniformCount = %d, const GLchar* const* uniformNames = 0x%0.8p, GLuint* uniformIndices = 0x%0.8p)",
           program, uniformCount, uniformNames, uniformIndices);
+    CAPTURE(glGetUniformIndices, program, uniformCount, gl::CaptureStrings(uniformCount, uniformNames, NULL), gl::CaptureOutput(uniformIndices, (uniformCount > 0 ? uniformCount : 0) * sizeof(GLuint)));
 
     try
     {
@@ -8481,6 +8678,7 @@ void __stdcall glGetActiveUniformsiv(GLuint program, GLsizei uniformCount, const
 {
     EVENT("(GLuint program = %u, GLsizei uniformCount = %d, const GLuint* uniformIndices = 0x%0.8p, GLenum pname = 0x%X, GLint* params = 0x%0.8p)",
           program, uniformCount, uniformIndices, pname, params);
+    CAPTURE(glGetActiveUniformsiv, program, uniformCount, gl::CaptureArray(uniformIndices, uniformCount), pname, gl::CaptureOutput(params, (uniformCount > 0 ? uniformCount : 0) * sizeof(GLint)));
 
     try
     {
@@ -8560,6 +8758,7 @@ void __stdcall glGetActiveUniformsiv(GLuint program, GLsizei uniformCount, const
 GLuint __stdcall glGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName)
 {
     EVENT("(GLuint program = %u, const GLchar* uniformBlockName = 0x%0.8p)", program, uniformBlockName);
+    CAPTURE(glGetUniformBlockIndex, program, gl::CaptureString(uniformBlockName));
 
     try
     {
@@ -8607,6 +8806,7 @@ void __stdcall glGetActiveUniformBlockiv(GLuint program, GLuint uniformBlockInde
 {
     EVENT("(GLuint program = %u, GLuint uniformBlockIndex = %u, GLenum pname = 0x%X, GLint* params = 0x%0.8p)",
           program, uniformBlockIndex, pname, params);
+    CAPTURE(glGetActiveUniformBlockiv, program, uniformBlockIndex, pname, params);
 
     try
     {
@@ -8669,6 +8869,7 @@ void __stdcall glGetActiveUniformBlockName(GLuint program, GLuint uniformBlockIn
 {
     EVENT("(GLuint program = %u, GLuint uniformBlockIndex = %u, GLsizei bufSize = %d, GLsizei* length = 0x%0.8p, GLchar* uniformBlockName = 0x%0.8p)",
           program, uniformBlockIndex, bufSize, length, uniformBlockName);
+    CAPTURE(glGetActiveUniformBlockName, program, uniformBlockIndex, bufSize, length, gl::CaptureOutput(uniformBlockName, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -8715,6 +8916,7 @@ void __stdcall glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, G
 {
     EVENT("(GLuint program = %u, GLuint uniformBlockIndex = %u, GLuint uniformBlockBinding = %u)",
           program, uniformBlockIndex, uniformBlockBinding);
+    CAPTURE(glUniformBlockBinding, program, uniformBlockIndex, uniformBlockBinding);
 
     try
     {
@@ -8767,6 +8969,7 @@ void __stdcall glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GL
 {
     EVENT("(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d, GLsizei instanceCount = %d)",
           mode, first, count, instanceCount);
+    CAPTURE_DRAW_ARRAYS(glDrawArraysInstanced, first, count, instanceCount, mode, first, count, instanceCount);
 
     try
     {
@@ -8793,6 +8996,7 @@ void __stdcall glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type,
 {
     EVENT("(GLenum mode = 0x%X, GLsizei count = %d, GLenum type = 0x%X, const GLvoid* indices = 0x%0.8p, GLsizei instanceCount = %d)",
           mode, count, type, indices, instanceCount);
+    CAPTURE_DRAW_ELEMENTS(glDrawElementsInstanced, count, type, indices, instanceCount, mode, count, type, gl::CaptureIndices(count, type, indices), instanceCount);
 
     try
     {
@@ -8818,6 +9022,7 @@ void __stdcall glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type,
 GLsync __stdcall glFenceSync(GLenum condition, GLbitfield flags)
 {
     EVENT("(GLenum condition = 0x%X, GLbitfield flags = 0x%X)", condition, flags);
+    CAPTURE(glFenceSync, condition, flags);
 
     try
     {
@@ -8854,6 +9059,7 @@ GLsync __stdcall glFenceSync(GLenum condition, GLbitfield flags)
 GLboolean __stdcall glIsSync(GLsync sync)
 {
     EVENT("(GLsync sync = 0x%0.8p)", sync);
+    CAPTURE(glIsSync, sync);
 
     try
     {
@@ -8880,6 +9086,7 @@ GLboolean __stdcall glIsSync(GLsync sync)
 void __stdcall glDeleteSync(GLsync sync)
 {
     EVENT("(GLsync sync = 0x%0.8p)", sync);
+    CAPTURE(glDeleteSync, sync);
 
     try
     {
@@ -8910,6 +9117,7 @@ GLenum __stdcall glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeou
 {
     EVENT("(GLsync sync = 0x%0.8p, GLbitfield flags = 0x%X, GLuint64 timeout = %llu)",
           sync, flags, timeout);
+    CAPTURE(glClientWaitSync, sync, flags, timeout);
 
     try
     {
@@ -8949,6 +9157,7 @@ void __stdcall glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
 {
     EVENT("(GLsync sync = 0x%0.8p, GLbitfield flags = 0x%X, GLuint64 timeout = %llu)",
           sync, flags, timeout);
+    CAPTURE(glWaitSync, sync, flags, timeout);
 
     try
     {
@@ -8991,6 +9200,7 @@ void __stdcall glGetInteger64v(GLenum pname, GLint64* params)
 {
     EVENT("(GLenum pname = 0x%X, GLint64* params = 0x%0.8p)",
           pname, params);
+    CAPTURE(glGetInteger64v, pname, params);
 
     try
     {
@@ -9032,6 +9242,7 @@ void __stdcall glGetSynciv(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei*
 {
     EVENT("(GLsync sync = 0x%0.8p, GLenum pname = 0x%X, GLsizei bufSize = %d, GLsizei* length = 0x%0.8p, GLint* values = 0x%0.8p)",
           sync, pname, bufSize, length, values);
+    CAPTURE(glGetSynciv, sync, pname, bufSize, length, gl::CaptureOutput(values, (bufSize > 0 ? bufSize : 0) * sizeof(GLint)));
 
     try
     {
@@ -9078,6 +9289,7 @@ void __stdcall glGetInteger64i_v(GLenum target, GLuint index, GLint64* data)
 {
     EVENT("(GLenum target = 0x%X, GLuint index = %u, GLint64* data = 0x%0.8p)",
           target, index, data);
+    CAPTURE(glGetInteger64i_v, target, index, data);
 
     try
     {
@@ -9148,6 +9360,7 @@ void __stdcall glGetBufferParameteri64v(GLenum target, GLenum pname, GLint64* pa
 {
     EVENT("(GLenum target = 0x%X, GLenum pname = 0x%X, GLint64* params = 0x%0.8p)",
           target, pname, params);
+    CAPTURE(glGetBufferParameteri64v, target, pname, params);
 
     try
     {
@@ -9211,6 +9424,7 @@ void __stdcall glGetBufferParameteri64v(GLenum target, GLenum pname, GLint64* pa
 void __stdcall glGenSamplers(GLsizei count, GLuint* samplers)
 {
     EVENT("(GLsizei count = %d, GLuint* samplers = 0x%0.8p)", count, samplers);
+    CAPTURE(glGenSamplers, count, gl::CaptureOutput(samplers, (count > 0 ? count : 0) * sizeof(GLuint)));
 
     try
     {
@@ -9243,6 +9457,7 @@ void __stdcall glGenSamplers(GLsizei count, GLuint* samplers)
 void __stdcall glDeleteSamplers(GLsizei count, const GLuint* samplers)
 {
     EVENT("(GLsizei count = %d, const GLuint* samplers = 0x%0.8p)", count, samplers);
+    CAPTURE(glDeleteSamplers, count, gl::CaptureArray(samplers, count));
 
     try
     {
@@ -9275,6 +9490,7 @@ void __stdcall glDeleteSamplers(GLsizei count, const GLuint* samplers)
 GLboolean __stdcall glIsSampler(GLuint sampler)
 {
     EVENT("(GLuint sampler = %u)", sampler);
+    CAPTURE(glIsSampler, sampler);
 
     try
     {
@@ -9301,6 +9517,7 @@ GLboolean __stdcall glIsSampler(GLuint sampler)
 void __stdcall glBindSampler(GLuint unit, GLuint sampler)
 {
     EVENT("(GLuint unit = %u, GLuint sampler = %u)", unit, sampler);
+    CAPTURE(glBindSampler, unit, sampler);
 
     try
     {
@@ -9335,6 +9552,7 @@ void __stdcall glBindSampler(GLuint unit, GLuint sampler)
 void __stdcall glSamplerParameteri(GLuint sampler, GLenum pname, GLint param)
 {
     EVENT("(GLuint sampler = %u, GLenum pname = 0x%X, GLint param = %d)", sampler, pname, param);
+    CAPTURE(glSamplerParameteri, sampler, pname, param);
 
     try
     {
@@ -9373,12 +9591,15 @@ void __stdcall glSamplerParameteri(GLuint sampler, GLenum pname, GLint param)
 
 void __stdcall glSamplerParameteriv(GLuint sampler, GLenum pname, const GLint* param)
 {
+    CAPTURE(glSamplerParameteriv, sampler, pname, gl::CaptureArray(param, 1));
+
     glSamplerParameteri(sampler, pname, *param);
 }
 
 void __stdcall glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param)
 {
     EVENT("(GLuint sampler = %u, GLenum pname = 0x%X, GLfloat param = %g)", sampler, pname, param);
+    CAPTURE(glSamplerParameterf, sampler, pname, param);
 
     try
     {
@@ -9417,12 +9638,15 @@ void __stdcall glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param)
 
 void __stdcall glSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat* param)
 {
+    CAPTURE(glSamplerParameterfv, sampler, pname, gl::CaptureArray(param, 1));
+
     glSamplerParameterf(sampler, pname, *param);
 }
 
 void __stdcall glGetSamplerParameteriv(GLuint sampler, GLenum pname, GLint* params)
 {
     EVENT("(GLuint sampler = %u, GLenum pname = 0x%X, GLint* params = 0x%0.8p)", sampler, pname, params);
+    CAPTURE(glGetSamplerParameteriv, sampler, pname, params);
 
     try
     {
@@ -9457,6 +9681,7 @@ void __stdcall glGetSamplerParameteriv(GLuint sampler, GLenum pname, GLint* para
 void __stdcall glGetSamplerParameterfv(GLuint sampler, GLenum pname, GLfloat* params)
 {
     EVENT("(GLuint sample = %ur, GLenum pname = 0x%X, GLfloat* params = 0x%0.8p)", sampler, pname, params);
+    CAPTURE(glGetSamplerParameterfv, sampler, pname, params);
 
     try
     {
@@ -9491,6 +9716,7 @@ void __stdcall glGetSamplerParameterfv(GLuint sampler, GLenum pname, GLfloat* pa
 void __stdcall glVertexAttribDivisor(GLuint index, GLuint divisor)
 {
     EVENT("(GLuint index = %u, GLuint divisor = %u)", index, divisor);
+    CAPTURE(glVertexAttribDivisor, index, divisor);
 
     try
     {
@@ -9520,6 +9746,7 @@ void __stdcall glVertexAttribDivisor(GLuint index, GLuint divisor)
 void __stdcall glBindTransformFeedback(GLenum target, GLuint id)
 {
     EVENT("(GLenum target = 0x%X, GLuint id = %u)", target, id);
+    CAPTURE(glBindTransformFeedback, target, id);
 
     try
     {
@@ -9545,6 +9772,7 @@ void __stdcall glBindTransformFeedback(GLenum target, GLuint id)
 void __stdcall glDeleteTransformFeedbacks(GLsizei n, const GLuint* ids)
 {
     EVENT("(GLsizei n = %d, const GLuint* ids = 0x%0.8p)", n, ids);
+    CAPTURE(glDeleteTransformFeedbacks, n, gl::CaptureArray(ids, n));
 
     try
     {
@@ -9570,6 +9798,7 @@ void __stdcall glDeleteTransformFeedbacks(GLsizei n, const GLuint* ids)
 void __stdcall glGenTransformFeedbacks(GLsizei n, GLuint* ids)
 {
     EVENT("(GLsizei n = %d, GLuint* ids = 0x%0.8p)", n, ids);
+    CAPTURE(glGenTransformFeedbacks, n, gl::CaptureOutput(ids, (n > 0 ? n : 0) * sizeof(GLuint)));
 
     try
     {
@@ -9595,6 +9824,7 @@ void __stdcall glGenTransformFeedbacks(GLsizei n, GLuint* ids)
 GLboolean __stdcall glIsTransformFeedback(GLuint id)
 {
     EVENT("(GLuint id = %u)", id);
+    CAPTURE(glIsTransformFeedback, id);
 
     try
     {
@@ -9622,6 +9852,7 @@ GLboolean __stdcall glIsTransformFeedback(GLuint id)
 void __stdcall glPauseTransformFeedback(void)
 {
     EVENT("(void)");
+    CAPTURE(glPauseTransformFeedback);
 
     try
     {
@@ -9647,6 +9878,7 @@ void __stdcall glPauseTransformFeedback(void)
 void __stdcall glResumeTransformFeedback(void)
 {
     EVENT("(void)");
+    CAPTURE(glResumeTransformFeedback);
 
     try
     {
@@ -9673,6 +9905,7 @@ void __stdcall glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* leng
 {
     EVENT("(GLuint program = %u, GLsizei bufSize = %d, GLsizei* length = 0x%0.8p, GLenum* binaryFormat = 0x%0.8p, GLvoid* binary = 0x%0.8p)",
           program, bufSize, length, binaryFormat, binary);
+    CAPTURE(glGetProgramBinary, program, bufSize, length, binaryFormat, gl::CaptureOutput(binary, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -9699,6 +9932,7 @@ void __stdcall glProgramBinary(GLuint program, GLenum binaryFormat, const GLvoid
 {
     EVENT("(GLuint program = %u, GLenum binaryFormat = 0x%X, const GLvoid* binary = 0x%0.8p, GLsizei length = %d)",
           program, binaryFormat, binary, length);
+    CAPTURE(glProgramBinary, program, binaryFormat, gl::CaptureMemory(binary, length > 0 ? length : 0), length);
 
     try
     {
@@ -9725,6 +9959,7 @@ void __stdcall glProgramParameteri(GLuint program, GLenum pname, GLint value)
 {
     EVENT("(GLuint program = %u, GLenum pname = 0x%X, GLint value = %d)",
           program, pname, value);
+    CAPTURE(glProgramParameteri, program, pname, value);
 
     try
     {
@@ -9751,6 +9986,7 @@ void __stdcall glInvalidateFramebuffer(GLenum target, GLsizei numAttachments, co
 {
     EVENT("(GLenum target = 0x%X, GLsizei numAttachments = %d, const GLenum* attachments = 0x%0.8p)",
           target, numAttachments, attachments);
+    CAPTURE(glInvalidateFramebuffer, target, numAttachments, gl::CaptureArray(attachments, numAttachments));
 
     try
     {
@@ -9783,6 +10019,7 @@ void __stdcall glInvalidateSubFramebuffer(GLenum target, GLsizei numAttachments,
     EVENT("(GLenum target = 0x%X, GLsizei numAttachments = %d, const GLenum* attachments = 0x%0.8p, GLint x = %d, "
           "GLint y = %d, GLsizei width = %d, GLsizei height = %d)",
           target, numAttachments, attachments, x, y, width, height);
+    CAPTURE(glInvalidateSubFramebuffer, target, numAttachments, gl::CaptureArray(attachments, numAttachments), x, y, width, height);
 
     try
     {
@@ -9813,6 +10050,7 @@ void __stdcall glTexStorage2D(GLenum target, GLsizei levels, GLenum internalform
 {
     EVENT("(GLenum target = 0x%X, GLsizei levels = %d, GLenum internalformat = 0x%X, GLsizei width = %d, GLsizei height = %d)",
           target, levels, internalformat, width, height);
+    CAPTURE(glTexStorage2D, target, levels, internalformat, width, height);
 
     try
     {
@@ -9862,6 +10100,7 @@ void __stdcall glTexStorage3D(GLenum target, GLsizei levels, GLenum internalform
     EVENT("(GLenum target = 0x%X, GLsizei levels = %d, GLenum internalformat = 0x%X, GLsizei width = %d, "
           "GLsizei height = %d, GLsizei depth = %d)",
           target, levels, internalformat, width, height, depth);
+    CAPTURE(glTexStorage3D, target, levels, internalformat, width, height, depth);
 
     try
     {
@@ -9911,6 +10150,7 @@ void __stdcall glGetInternalformativ(GLenum target, GLenum internalformat, GLenu
     EVENT("(GLenum target = 0x%X, GLenum internalformat = 0x%X, GLenum pname = 0x%X, GLsizei bufSize = %d, "
           "GLint* params = 0x%0.8p)",
           target, internalformat, pname, bufSize, params);
+    CAPTURE(glGetInternalformativ, target, internalformat, pname, bufSize, gl::CaptureOutput(params, (bufSize > 0 ? bufSize : 0) * sizeof(GLint)));
 
     try
     {
@@ -9969,6 +10209,7 @@ void __stdcall glBlitFramebufferANGLE(GLint srcX0, GLint srcY0, GLint srcX1, GLi
           "GLint dstX0 = %d, GLint dstY0 = %d, GLint dstX1 = %d, GLint dstY1 = %d, "
           "GLbitfield mask = 0x%X, GLenum filter = 0x%X)",
           srcX0, srcY0, srcX1, srcX1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    CAPTURE(glBlitFramebufferANGLE, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
 
     try
     {
@@ -10000,6 +10241,7 @@ void __stdcall glTexImage3DOES(GLenum target, GLint level, GLenum internalformat
           "GLsizei width = %d, GLsizei height = %d, GLsizei depth = %d, GLint border = %d, "
           "GLenum format = 0x%X, GLenum type = 0x%x, const GLvoid* pixels = 0x%0.8p)",
           target, level, internalformat, width, height, depth, border, format, type, pixels);
+    CAPTURE(glTexImage3DOES, target, level, internalformat, width, height, depth, border, format, type, gl::CaptureUnpackPixels(width, height, depth, format, type, pixels));
 
     try
     {
@@ -10016,6 +10258,7 @@ void __stdcall glGetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *l
 {
     EVENT("(GLenum program = 0x%X, bufSize = %d, length = 0x%0.8p, binaryFormat = 0x%0.8p, binary = 0x%0.8p)",
           program, bufSize, length, binaryFormat, binary);
+    CAPTURE(glGetProgramBinaryOES, program, bufSize, length, binaryFormat, gl::CaptureOutput(binary, bufSize > 0 ? bufSize : 0));
 
     try
     {
@@ -10056,6 +10299,7 @@ void __stdcall glProgramBinaryOES(GLuint program, GLenum binaryFormat,
 {
     EVENT("(GLenum program = 0x%X, binaryFormat = 0x%x, binary = 0x%0.8p, length = %d)",
           program, binaryFormat, binary, length);
+    CAPTURE(glProgramBinaryOES, program, binaryFormat, gl::CaptureMemory(binary, length > 0 ? length : 0), length);
 
     try
     {
@@ -10087,6 +10331,7 @@ void __stdcall glProgramBinaryOES(GLuint program, GLenum binaryFormat,
 void __stdcall glDrawBuffersEXT(GLsizei n, const GLenum *bufs)
 {
     EVENT("(GLenum n = %d, bufs = 0x%0.8p)", n, bufs);
+    CAPTURE(glDrawBuffersEXT, n, gl::CaptureArray(bufs, n));
 
     try
     {
@@ -10142,6 +10387,57 @@ void __stdcall glDrawBuffersEXT(GLsizei n, const GLenum *bufs)
     }
 }
 
+void __stdcall glGetProfileCountersANGLE(GLenum stage, GLuint64 *counters)
+{
+    EVENT("(GLenum stage = 0x%X, GLuint64 *counters = 0x%0.8p)", stage, counters);
+    CAPTURE(glGetProfileCountersANGLE, stage, gl::CaptureOutput(counters, 3 * sizeof(GLuint64)));
+
+    try
+    {
+        gl::Context *context = gl::getNonLostContext();
+
+        if (context)
+        {
+            gl::ProfileStage profileStage;
+            if (!gl::GetProfileStage(stage, &profileStage))
+            {
+                return gl::error(GL_INVALID_ENUM);
+            }
+
+            // The counters are those of the calling thread, whichever context is current
+            const gl::ProfileCounter &counter = gl::getProfileCounters()->stages[profileStage];
+            counters[0] = counter.calls;
+            counters[1] = gl::ProfileTicksToNanoseconds(counter.ticks);
+            counters[2] = counter.bytes;
+        }
+    }
+    catch(std::bad_alloc&)
+    {
+        return gl::error(GL_OUT_OF_MEMORY);
+    }
+}
+
+void __stdcall glResetProfileCountersANGLE(void)
+{
+    EVENT("()");
+    CAPTURE(glResetProfileCountersANGLE);
+
+    try
+    {
+        gl::Context *context = gl::getNonLostContext();
+
+        if (context)
+        {
+            gl::EnableProfileCounters();
+            gl::ResetProfileCounters(gl::getProfileCounters());
+        }
+    }
+    catch(std::bad_alloc&)
+    {
+        return gl::error(GL_OUT_OF_MEMORY);
+    }
+}
+
 __eglMustCastToProperFunctionPointerType __stdcall glGetProcAddress(const char *procname)
 {
     struct Extension
@@ -10180,7 +10476,9 @@ __eglMustCastToProperFunctionPointerType __stdcall glGetProcAddress(const char *
         {"glDrawArraysInstancedANGLE", (__eglMustCastToProperFunctionPointerType)glDrawArraysInstancedANGLE},
         {"glDrawElementsInstancedANGLE", (__eglMustCastToProperFunctionPointerType)glDrawElementsInstancedANGLE},
         {"glGetProgramBinaryOES", (__eglMustCastToProperFunctionPointerType)glGetProgramBinaryOES},
-        {"glProgramBinaryOES", (__eglMustCastToProperFunctionPointerType)glProgramBinaryOES},    };
+        {"glProgramBinaryOES", (__eglMustCastToProperFunctionPointerType)glProgramBinaryOES},
+        {"glGetProfileCountersANGLE", (__eglMustCastToProperFunctionPointerType)glGetProfileCountersANGLE},
+        {"glResetProfileCountersANGLE", (__eglMustCastToProperFunctionPointerType)glResetProfileCountersANGLE},    };
 
     for (unsigned int ext = 0; ext < ArraySize(glExtensions); ext++)
     {
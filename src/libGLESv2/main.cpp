@@ -9,7 +9,13 @@
 
 #include "libGLESv2/main.h"
 
+#include "libGLESv2/Capture.h"
 #include "libGLESv2/Context.h"
+#include "libGLESv2/DeferredContext.h"
+#include "libGLESv2/DiskCache.h"
+#if defined(ANGLE_ENABLE_TRACE)
+#include "common/RingBufferTracer.h"
+#endif
 
 static DWORD currentTLS = TLS_OUT_OF_INDEXES;
 
@@ -31,6 +37,8 @@ Current *AllocateCurrent()
 
     current->context = NULL;
     current->display = NULL;
+    current->deferredContext = NULL;
+    current->errorCount = 0;
 
     return current;
 }
@@ -53,6 +61,14 @@ extern "C" BOOL WINAPI DllMain(HINSTANCE instance, DWORD reason, LPVOID reserved
     {
       case DLL_PROCESS_ATTACH:
         {
+#if defined(ANGLE_ENABLE_TRACE)
+            gl::RingBufferTracer::initializeInstance("libGLESv2.angletrace");
+#endif
+            gl::InitializeProfileCounters();
+            gl::DeferredContext::initialize();
+            gl::DiskCache::initialize();
+            gl::Capture::initializeInstance();
+
             currentTLS = TlsAlloc();
 
             if (currentTLS == TLS_OUT_OF_INDEXES)
@@ -69,12 +85,25 @@ extern "C" BOOL WINAPI DllMain(HINSTANCE instance, DWORD reason, LPVOID reserved
       case DLL_THREAD_DETACH:
         {
             gl::DeallocateCurrent();
+#if defined(ANGLE_ENABLE_TRACE)
+            gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+            if (tracer)
+            {
+                tracer->releaseThreadBuffer();
+            }
+#endif
         }
         break;
       case DLL_PROCESS_DETACH:
         {
             gl::DeallocateCurrent();
+            gl::DiskCache::releaseInstance();
+            gl::Capture::releaseInstance();
+            gl::DeferredContext::terminate();
             TlsFree(currentTLS);
+#if defined(ANGLE_ENABLE_TRACE)
+            gl::RingBufferTracer::releaseInstance();
+#endif
         }
         break;
       default:
@@ -142,9 +171,46 @@ egl::Display *getDisplay()
     return current->display;
 }
 
+ProfileCounters *getProfileCounters()
+{
+    Current *current = GetCurrentData();
+
+    return current ? &current->profileCounters : NULL;
+}
+
+DeferredContext *getDeferredContext()
+{
+    Current *current = GetCurrentData();
+
+    return current ? current->deferredContext : NULL;
+}
+
+void setDeferredContext(DeferredContext *deferredContext)
+{
+    Current *current = GetCurrentData();
+
+    if (current)
+    {
+        current->deferredContext = deferredContext;
+    }
+}
+
+unsigned int getErrorCount()
+{
+    Current *current = GetCurrentData();
+
+    return current ? current->errorCount : 0;
+}
+
 // Records an error code
 void error(GLenum errorCode)
 {
+    Current *current = GetCurrentData();
+    if (current)
+    {
+        current->errorCount++;
+    }
+
     gl::Context *context = glGetCurrentContext();
 
     if (context)
@@ -178,3 +244,23 @@ void error(GLenum errorCode)
 
 }
 
+extern "C"
+{
+
+void glLockDeferredContexts()
+{
+    gl::DeferredContext *deferredContext = gl::getDeferredContext();
+    if (deferredContext)
+    {
+        deferredContext->synchronize();
+    }
+
+    gl::DeferredContext::lockExecution();
+}
+
+void glUnlockDeferredContexts()
+{
+    gl::DeferredContext::unlockExecution();
+}
+
+}
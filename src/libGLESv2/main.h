@@ -10,6 +10,7 @@
 #define LIBGLESV2_MAIN_H_
 
 #include "common/debug.h"
+#include "libGLESv2/ProfileCounters.h"
 
 namespace egl
 {
@@ -20,11 +21,15 @@ class Surface;
 namespace gl
 {
 class Context;
+class DeferredContext;
     
 struct Current
 {
     Context *context;
     egl::Display *display;
+    ProfileCounters profileCounters;
+    DeferredContext *deferredContext;
+    unsigned int errorCount;
 };
 
 void makeCurrent(Context *context, egl::Display *display, egl::Surface *surface);
@@ -32,9 +37,16 @@ void makeCurrent(Context *context, egl::Display *display, egl::Surface *surface)
 Context *getContext();
 Context *getNonLostContext();
 egl::Display *getDisplay();
+ProfileCounters *getProfileCounters();
+
+DeferredContext *getDeferredContext();
+void setDeferredContext(DeferredContext *deferredContext);
 
 void error(GLenum errorCode);
 
+// The number of errors raised by calls on this thread, which tells whether a call failed
+unsigned int getErrorCount();
+
 template<class T>
 const T &error(GLenum errorCode, const T &returnValue)
 {
@@ -62,6 +74,26 @@ void glDestroyRenderer(rx::Renderer *renderer);
 
 __eglMustCastToProperFunctionPointerType __stdcall glGetProcAddress(const char *procname);
 bool __stdcall glBindTexImage(egl::Surface *surface);
+
+// Executes the calls queued to the current deferred context and keeps the submission threads
+// of the other contexts from using the renderer until unlocked
+void glLockDeferredContexts();
+void glUnlockDeferredContexts();
+}
+
+namespace gl
+{
+
+class DeferredContextLock
+{
+  public:
+    DeferredContextLock() { glLockDeferredContexts(); }
+    ~DeferredContextLock() { glUnlockDeferredContexts(); }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(DeferredContextLock);
+};
+
 }
 
 #endif   // LIBGLESV2_MAIN_H_
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// DirtyRegion.h: Defines rx::DirtyRegion, a small set of boxes covering the texels of an image
+// which were modified since they were last copied to texture storage. Overlapping and
+// adjacent boxes are merged whenever the merged box covers no more texels than the pair.
+
+#ifndef LIBGLESV2_RENDERER_DIRTYREGION_H_
+#define LIBGLESV2_RENDERER_DIRTYREGION_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "libGLESv2/angletypes.h"
+
+namespace rx
+{
+
+class DirtyRegion
+{
+  public:
+    DirtyRegion() {}
+
+    static unsigned long long volume(const gl::Box &box)
+    {
+        return static_cast<unsigned long long>(box.width) * box.height * box.depth;
+    }
+
+    void add(const gl::Box &box)
+    {
+        if (box.width <= 0 || box.height <= 0 || box.depth <= 0)
+        {
+            return;
+        }
+
+        gl::Box merged = box;
+        size_t index = 0;
+        while (index < mBoxes.size())
+        {
+            gl::Box combined = bound(merged, mBoxes[index]);
+            if (volume(combined) <= volume(merged) + volume(mBoxes[index]))
+            {
+                merged = combined;
+                mBoxes.erase(mBoxes.begin() + index);
+
+                // The larger box may now absorb boxes which were already passed over
+                index = 0;
+            }
+            else
+            {
+                index++;
+            }
+
+            if (index == mBoxes.size() && mBoxes.size() >= kMaxBoxes)
+            {
+                // Keep the set small by merging with the box which grows the least
+                size_t closest = 0;
+                for (size_t candidate = 1; candidate < mBoxes.size(); candidate++)
+                {
+                    if (growth(merged, mBoxes[candidate]) < growth(merged, mBoxes[closest]))
+                    {
+                        closest = candidate;
+                    }
+                }
+
+                merged = bound(merged, mBoxes[closest]);
+                mBoxes.erase(mBoxes.begin() + closest);
+                index = 0;
+            }
+        }
+
+        mBoxes.push_back(merged);
+    }
+
+    // Removes the boxes which lie entirely within an area copied to storage. Boxes which only
+    // partially overlap it stay dirty as a whole.
+    void remove(const gl::Box &area)
+    {
+        size_t index = 0;
+        while (index < mBoxes.size())
+        {
+            if (contains(area, mBoxes[index]))
+            {
+                mBoxes.erase(mBoxes.begin() + index);
+            }
+            else
+            {
+                index++;
+            }
+        }
+    }
+
+    void clear() { mBoxes.clear(); }
+    bool empty() const { return mBoxes.empty(); }
+    const std::vector<gl::Box> &getBoxes() const { return mBoxes; }
+
+  private:
+    static const size_t kMaxBoxes = 8;
+
+    static gl::Box bound(const gl::Box &a, const gl::Box &b)
+    {
+        int x = std::min(a.x, b.x);
+        int y = std::min(a.y, b.y);
+        int z = std::min(a.z, b.z);
+
+        return gl::Box(x, y, z,
+                       std::max(a.x + a.width, b.x + b.width) - x,
+                       std::max(a.y + a.height, b.y + b.height) - y,
+                       std::max(a.z + a.depth, b.z + b.depth) - z);
+    }
+
+    static unsigned long long growth(const gl::Box &a, const gl::Box &b)
+    {
+        return volume(bound(a, b)) - std::max(volume(a), volume(b));
+    }
+
+    static bool contains(const gl::Box &outer, const gl::Box &inner)
+    {
+        return inner.x >= outer.x && inner.x + inner.width <= outer.x + outer.width &&
+               inner.y >= outer.y && inner.y + inner.height <= outer.y + outer.height &&
+               inner.z >= outer.z && inner.z + inner.depth <= outer.z + outer.depth;
+    }
+
+    std::vector<gl::Box> mBoxes;
+};
+
+}
+
+#endif // LIBGLESV2_RENDERER_DIRTYREGION_H_
@@ -10,6 +10,7 @@
 // surfaces or resources.
 
 #include "libGLESv2/renderer/Image.h"
+#include "libGLESv2/renderer/UploadWorkerPool.h"
 
 namespace rx
 {
@@ -23,7 +24,68 @@ Image::Image()
     mActualFormat = GL_NONE;
     mTarget = GL_NONE;
     mRenderable = false;
-    mDirty = false;
+    mPendingUpload = NULL;
+}
+
+Image::~Image()
+{
+    // Derived classes wait before releasing the memory the conversion writes to
+    ASSERT(mPendingUpload == NULL);
+}
+
+void Image::markDirty()
+{
+    mDirtyRegion.clear();
+    markDirty(gl::Box(0, 0, 0, mWidth, mHeight, mDepth));
+}
+
+void Image::markDirty(const gl::Box &area)
+{
+    if (area.width > 0 && area.height > 0 && area.depth > 0)
+    {
+        mDirtyRegion.add(area);
+    }
+}
+
+void Image::markClean()
+{
+    mDirtyRegion.clear();
+}
+
+void Image::markClean(const gl::Box &copiedArea)
+{
+    mDirtyRegion.remove(copiedArea);
+}
+
+bool Image::queueUpload(UploadWorkerPool *pool, LoadImageFunction loadFunction, GLsizei width, GLsizei height, GLsizei depth,
+                        const void *input, GLsizei inputRowPitch, GLsizei inputDepthPitch, GLsizei inputRowBytes,
+                        void *output, GLsizei outputRowPitch, GLsizei outputDepthPitch)
+{
+    ASSERT(mPendingUpload == NULL);
+
+    // The unpack alignment padding after the last row is not part of the client data
+    size_t inputBytes = (depth - 1) * inputDepthPitch + (height - 1) * inputRowPitch + inputRowBytes;
+
+    if (!pool || !UploadWorkerPool::isWorthQueueing(inputBytes))
+    {
+        return false;
+    }
+
+    mPendingUpload = pool->queue(loadFunction, width, height, depth, input, inputBytes, inputRowPitch, inputDepthPitch,
+                                 output, outputRowPitch, outputDepthPitch);
+    return true;
+}
+
+bool Image::waitForPendingUpload()
+{
+    if (!mPendingUpload)
+    {
+        return false;
+    }
+
+    mPendingUpload->wait();
+    SafeDelete(mPendingUpload);
+    return true;
 }
 
 }
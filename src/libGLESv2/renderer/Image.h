@@ -12,6 +12,8 @@
 #define LIBGLESV2_RENDERER_IMAGE_H_
 
 #include "common/debug.h"
+#include "libGLESv2/formatutils.h"
+#include "libGLESv2/renderer/DirtyRegion.h"
 
 namespace gl
 {
@@ -25,12 +27,14 @@ class TextureStorageInterface2D;
 class TextureStorageInterfaceCube;
 class TextureStorageInterface3D;
 class TextureStorageInterface2DArray;
+class PendingUpload;
+class UploadWorkerPool;
 
 class Image
 {
   public:
     Image();
-    virtual ~Image() {};
+    virtual ~Image();
 
     GLsizei getWidth() const { return mWidth; }
     GLsizei getHeight() const { return mHeight; }
@@ -40,9 +44,16 @@ class Image
     GLenum getTarget() const { return mTarget; }
     bool isRenderableFormat() const { return mRenderable; }
 
-    void markDirty() {mDirty = true;}
-    void markClean() {mDirty = false;}
+    // The whole image or an area of it must be copied to storage
+    void markDirty();
+    void markDirty(const gl::Box &area);
+    void markClean();
+    // The area was copied to storage
+    void markClean(const gl::Box &copiedArea);
     virtual bool isDirty() const = 0;
+    const std::vector<gl::Box> &getDirtyBoxes() const { return mDirtyRegion.getBoxes(); }
+    // A worker thread may still be converting the last loadData, copying to storage waits for it
+    bool hasPendingUpload() const { return mPendingUpload != NULL; }
 
     virtual void setManagedSurface(TextureStorageInterface2D *storage, int level) {};
     virtual void setManagedSurface(TextureStorageInterfaceCube *storage, int face, int level) {};
@@ -63,6 +74,14 @@ class Image
     virtual void copy(GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, gl::Framebuffer *source) = 0;
 
   protected:
+    // Hands a large conversion over to the upload worker pool, if there is one. The output must
+    // then stay mapped until waitForPendingUpload returns true, which callers check before any
+    // other access to the image memory.
+    bool queueUpload(UploadWorkerPool *pool, LoadImageFunction loadFunction, GLsizei width, GLsizei height, GLsizei depth,
+                     const void *input, GLsizei inputRowPitch, GLsizei inputDepthPitch, GLsizei inputRowBytes,
+                     void *output, GLsizei outputRowPitch, GLsizei outputDepthPitch);
+    bool waitForPendingUpload();
+
     GLsizei mWidth;
     GLsizei mHeight;
     GLsizei mDepth;
@@ -71,9 +90,11 @@ class Image
     bool mRenderable;
     GLenum mTarget;
 
-    bool mDirty;
+    DirtyRegion mDirtyRegion;
 
   private:
+    PendingUpload *mPendingUpload;
+
     DISALLOW_COPY_AND_ASSIGN(Image);
 };
 
@@ -109,6 +109,8 @@ static void computeRange(GLenum type, const GLvoid *indices, GLsizei count, GLui
 
 GLenum IndexDataManager::prepareIndexData(GLenum type, GLsizei count, gl::Buffer *buffer, const GLvoid *indices, TranslatedIndexData *translated)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_INDEX_DATA);
+
     if (!mStreamingBufferShort)
     {
         return GL_OUT_OF_MEMORY;
@@ -235,6 +237,7 @@ GLenum IndexDataManager::prepareIndexData(GLenum type, GLsizei count, gl::Buffer
         }
 
         convertIndices(type, staticBuffer ? storage->getData() : indices, convertCount, output);
+        profile.addBytes(bufferSizeRequired);
 
         if (!indexBuffer->unmapBuffer())
         {
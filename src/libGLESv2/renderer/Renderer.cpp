@@ -11,9 +11,11 @@
 #include "libGLESv2/main.h"
 #include "libGLESv2/Program.h"
 #include "libGLESv2/renderer/Renderer.h"
+#include "libGLESv2/renderer/UploadWorkerPool.h"
 #include "libGLESv2/renderer/d3d9/Renderer9.h"
 #include "libGLESv2/renderer/d3d11/Renderer11.h"
 #include "common/utilities.h"
+#include "common/RingBufferTracer.h"
 #include "third_party/trace_event/trace_event.h"
 
 #if !defined(ANGLE_ENABLE_D3D11)
@@ -27,6 +29,27 @@ namespace rx
 Renderer::Renderer(egl::Display *display) : mDisplay(display)
 {
     mCurrentClientVersion = 2;
+    mUploadWorkerPool = UploadWorkerPool::create();
+    mFixedFunctionStateSerial = 0;
+
+    // Trace records are written out in the background while a renderer exists, which keeps the
+    // flusher from having to be stopped in DllMain
+    gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        tracer->startFlusher();
+    }
+}
+
+Renderer::~Renderer()
+{
+    SafeDelete(mUploadWorkerPool);
+
+    gl::RingBufferTracer *tracer = gl::RingBufferTracer::getInstance();
+    if (tracer)
+    {
+        tracer->stopFlusher();
+    }
 }
 
 }
@@ -64,6 +64,7 @@ class RenderTarget;
 class Image;
 class TextureStorage;
 class UniformStorage;
+class UploadWorkerPool;
 
 struct ConfigDesc
 {
@@ -98,6 +99,7 @@ class Renderer
 {
   public:
     explicit Renderer(egl::Display *display);
+    virtual ~Renderer();
 
     virtual EGLint initialize() = 0;
     virtual bool resetDevice() = 0;
@@ -263,6 +265,14 @@ class Renderer
     void setCurrentClientVersion(int clientVersion) { mCurrentClientVersion = clientVersion; }
     int getCurrentClientVersion() const { return mCurrentClientVersion; }
 
+    // Threads converting large texture uploads, NULL unless enabled through ANGLE_ASYNC_TEXTURE_UPLOAD
+    UploadWorkerPool *getUploadWorkerPool() const { return mUploadWorkerPool; }
+
+    // Changes whenever a context sets the rasterizer, blend and depth stencil state, or the
+    // renderer has to set them again. A context which last set them only sets those it changed.
+    unsigned int getFixedFunctionStateSerial() const { return mFixedFunctionStateSerial; }
+    unsigned int claimFixedFunctionState() { return ++mFixedFunctionStateSerial; }
+
     // Buffer-to-texture and Texture-to-buffer copies
     virtual bool supportsFastCopyBufferToTexture(GLenum internalFormat) const = 0;
     virtual bool fastCopyBufferToTexture(const gl::PixelUnpackState &unpack, unsigned int offset, RenderTarget *destRenderTarget,
@@ -274,12 +284,16 @@ class Renderer
     virtual GLenum getVertexComponentType(const gl::VertexFormat &vertexFormat) const = 0;
 
   protected:
+    void invalidateFixedFunctionState() { mFixedFunctionStateSerial++; }
+
     egl::Display *mDisplay;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Renderer);
 
     int mCurrentClientVersion;
+    UploadWorkerPool *mUploadWorkerPool;
+    unsigned int mFixedFunctionStateSerial;
 };
 
 }
@@ -0,0 +1,330 @@
+#include "precompiled.h"
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// UploadWorkerPool.cpp: Implements rx::UploadWorkerPool, an opt-in pool of threads which
+// convert client pixels into mapped image memory.
+
+#include "libGLESv2/renderer/UploadWorkerPool.h"
+
+#include "common/debug.h"
+#include "third_party/trace_event/trace_event.h"
+
+namespace rx
+{
+
+namespace
+{
+
+// Uploads below this size are converted on the GL thread
+const size_t MinQueuedBytes = 256 * 1024;
+
+// Bands are kept large enough for the hand-over cost to be negligible
+const size_t MinBandBytes = 64 * 1024;
+
+const unsigned int MaxThreads = 16;
+
+}
+
+UploadWorkerPoolStatistics::UploadWorkerPoolStatistics()
+    : uploads(0),
+      bands(0),
+      bytesConverted(0),
+      stalls(0),
+      stallMilliseconds(0.0),
+      latencyMilliseconds(0.0)
+{
+}
+
+PendingUpload::PendingUpload(UploadWorkerPool *pool, LoadImageFunction loadFunction, int bandCount)
+    : mPool(pool),
+      mLoadFunction(loadFunction),
+      mWidth(0),
+      mHeight(0),
+      mDepth(0),
+      mInputRowPitch(0),
+      mInputDepthPitch(0),
+      mOutput(NULL),
+      mOutputRowPitch(0),
+      mOutputDepthPitch(0),
+      mBandCount(bandCount),
+      mUnitsPerBand(0),
+      mRemainingBands(bandCount)
+{
+    mCompleteEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    QueryPerformanceCounter(&mQueueTime);
+}
+
+PendingUpload::~PendingUpload()
+{
+    wait();
+    CloseHandle(mCompleteEvent);
+}
+
+void PendingUpload::wait()
+{
+    if (WaitForSingleObject(mCompleteEvent, 0) == WAIT_OBJECT_0)
+    {
+        return;
+    }
+
+    TRACE_EVENT0("gpu", "AsyncTextureUploadStall");
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    // Convert the bands no worker has picked up yet instead of waiting for them
+    int band = 0;
+    while (mPool->takeBand(this, &band))
+    {
+        convertBand(band);
+    }
+
+    WaitForSingleObject(mCompleteEvent, INFINITE);
+
+    mPool->recordStall(mPool->elapsedMilliseconds(start));
+}
+
+void PendingUpload::convertBand(int band)
+{
+    int units = (mDepth > 1) ? mDepth : mHeight;
+    int first = band * mUnitsPerBand;
+    int count = std::min(units - first, mUnitsPerBand);
+
+    const unsigned char *input = &mInput[0];
+    unsigned char *output = static_cast<unsigned char*>(mOutput);
+
+    if (mDepth > 1)
+    {
+        mLoadFunction(mWidth, mHeight, count, input + first * mInputDepthPitch, mInputRowPitch, mInputDepthPitch,
+                      output + first * mOutputDepthPitch, mOutputRowPitch, mOutputDepthPitch);
+    }
+    else
+    {
+        mLoadFunction(mWidth, count, 1, input + first * mInputRowPitch, mInputRowPitch, mInputDepthPitch,
+                      output + first * mOutputRowPitch, mOutputRowPitch, mOutputDepthPitch);
+    }
+
+    // The waiting thread may delete the upload as soon as the event is set
+    if (InterlockedDecrement(&mRemainingBands) == 0)
+    {
+        mPool->recordCompletion(mQueueTime);
+        TRACE_EVENT_ASYNC_END0("gpu", "AsyncTextureUpload", this);
+        SetEvent(mCompleteEvent);
+    }
+}
+
+UploadWorkerPool::UploadWorkerPool(unsigned int threadCount)
+    : mExiting(false)
+{
+    InitializeCriticalSection(&mLock);
+    QueryPerformanceFrequency(&mFrequency);
+
+    threadCount = std::min(std::max(threadCount, 1U), MaxThreads);
+    mWorkAvailable = CreateSemaphore(NULL, 0, std::numeric_limits<LONG>::max(), NULL);
+
+    for (unsigned int index = 0; index < threadCount && mWorkAvailable; index++)
+    {
+        HANDLE thread = CreateThread(NULL, 0, workerMain, this, 0, NULL);
+        if (thread)
+        {
+            mThreads.push_back(thread);
+        }
+    }
+}
+
+UploadWorkerPool::~UploadWorkerPool()
+{
+    EnterCriticalSection(&mLock);
+    mExiting = true;
+    LeaveCriticalSection(&mLock);
+
+    if (!mThreads.empty())
+    {
+        ReleaseSemaphore(mWorkAvailable, static_cast<LONG>(mThreads.size()), NULL);
+    }
+
+    for (size_t index = 0; index < mThreads.size(); index++)
+    {
+        WaitForSingleObject(mThreads[index], INFINITE);
+        CloseHandle(mThreads[index]);
+    }
+
+    ASSERT(mBands.empty());
+
+    if (mWorkAvailable)
+    {
+        CloseHandle(mWorkAvailable);
+    }
+    DeleteCriticalSection(&mLock);
+
+    TRACE("Upload worker pool: %u uploads in %u bands, %u stalls for %.2f ms, %.2f ms average latency",
+          mStatistics.uploads, mStatistics.bands, mStatistics.stalls, mStatistics.stallMilliseconds,
+          mStatistics.uploads ? mStatistics.latencyMilliseconds / mStatistics.uploads : 0.0);
+}
+
+UploadWorkerPool *UploadWorkerPool::create()
+{
+    char value[16];
+    DWORD length = GetEnvironmentVariableA("ANGLE_ASYNC_TEXTURE_UPLOAD", value, ArraySize(value));
+    if (length == 0 || length >= ArraySize(value))
+    {
+        return NULL;
+    }
+
+    unsigned int threadCount = strtoul(value, NULL, 10);
+    if (threadCount == 0)
+    {
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        threadCount = std::max<DWORD>(systemInfo.dwNumberOfProcessors, 2) - 1;
+    }
+
+    UploadWorkerPool *pool = new UploadWorkerPool(threadCount);
+    if (pool->mThreads.empty())
+    {
+        ERR("Could not start the texture upload worker threads.");
+        SafeDelete(pool);
+    }
+
+    return pool;
+}
+
+bool UploadWorkerPool::isWorthQueueing(size_t inputBytes)
+{
+    return inputBytes >= MinQueuedBytes;
+}
+
+PendingUpload *UploadWorkerPool::queue(LoadImageFunction loadFunction, int width, int height, int depth,
+                                       const void *input, size_t inputBytes, unsigned int inputRowPitch, unsigned int inputDepthPitch,
+                                       void *output, unsigned int outputRowPitch, unsigned int outputDepthPitch)
+{
+    ASSERT(width > 0 && height > 0 && depth > 0);
+
+    int units = (depth > 1) ? depth : height;
+    size_t maxBands = std::max<size_t>(inputBytes / MinBandBytes, 1);
+    int bandCount = static_cast<int>(std::min<size_t>(std::min<size_t>(units, mThreads.size() * 2), maxBands));
+    int unitsPerBand = (units + bandCount - 1) / bandCount;
+    bandCount = (units + unitsPerBand - 1) / unitsPerBand;
+
+    PendingUpload *upload = new PendingUpload(this, loadFunction, bandCount);
+    upload->mInput.assign(static_cast<const unsigned char*>(input), static_cast<const unsigned char*>(input) + inputBytes);
+    upload->mWidth = width;
+    upload->mHeight = height;
+    upload->mDepth = depth;
+    upload->mInputRowPitch = inputRowPitch;
+    upload->mInputDepthPitch = inputDepthPitch;
+    upload->mOutput = output;
+    upload->mOutputRowPitch = outputRowPitch;
+    upload->mOutputDepthPitch = outputDepthPitch;
+    upload->mUnitsPerBand = unitsPerBand;
+
+    TRACE_EVENT_ASYNC_BEGIN1("gpu", "AsyncTextureUpload", upload, "bytes", static_cast<unsigned long long>(inputBytes));
+
+    EnterCriticalSection(&mLock);
+    for (int index = 0; index < bandCount; index++)
+    {
+        Band band = { upload, index };
+        mBands.push_back(band);
+    }
+    mStatistics.uploads++;
+    mStatistics.bands += bandCount;
+    mStatistics.bytesConverted += inputBytes;
+    LeaveCriticalSection(&mLock);
+
+    ReleaseSemaphore(mWorkAvailable, bandCount, NULL);
+
+    return upload;
+}
+
+UploadWorkerPoolStatistics UploadWorkerPool::getStatistics()
+{
+    EnterCriticalSection(&mLock);
+    UploadWorkerPoolStatistics statistics = mStatistics;
+    LeaveCriticalSection(&mLock);
+
+    return statistics;
+}
+
+DWORD WINAPI UploadWorkerPool::workerMain(LPVOID parameter)
+{
+    static_cast<UploadWorkerPool*>(parameter)->runWorker();
+    return 0;
+}
+
+void UploadWorkerPool::runWorker()
+{
+    while (true)
+    {
+        WaitForSingleObject(mWorkAvailable, INFINITE);
+
+        EnterCriticalSection(&mLock);
+        if (mBands.empty())
+        {
+            // Bands may have been taken over by a waiting GL thread
+            bool exiting = mExiting;
+            LeaveCriticalSection(&mLock);
+
+            if (exiting)
+            {
+                return;
+            }
+            continue;
+        }
+
+        Band band = mBands.front();
+        mBands.pop_front();
+        LeaveCriticalSection(&mLock);
+
+        band.upload->convertBand(band.index);
+    }
+}
+
+bool UploadWorkerPool::takeBand(PendingUpload *upload, int *index)
+{
+    bool taken = false;
+
+    EnterCriticalSection(&mLock);
+    for (std::deque<Band>::iterator band = mBands.begin(); band != mBands.end(); band++)
+    {
+        if (band->upload == upload)
+        {
+            *index = band->index;
+            mBands.erase(band);
+            taken = true;
+            break;
+        }
+    }
+    LeaveCriticalSection(&mLock);
+
+    return taken;
+}
+
+void UploadWorkerPool::recordCompletion(const LARGE_INTEGER &queueTime)
+{
+    double latency = elapsedMilliseconds(queueTime);
+
+    EnterCriticalSection(&mLock);
+    mStatistics.latencyMilliseconds += latency;
+    LeaveCriticalSection(&mLock);
+}
+
+void UploadWorkerPool::recordStall(double milliseconds)
+{
+    EnterCriticalSection(&mLock);
+    mStatistics.stalls++;
+    mStatistics.stallMilliseconds += milliseconds;
+    LeaveCriticalSection(&mLock);
+}
+
+double UploadWorkerPool::elapsedMilliseconds(const LARGE_INTEGER &start) const
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return 1000.0 * static_cast<double>(now.QuadPart - start.QuadPart) / static_cast<double>(mFrequency.QuadPart);
+}
+
+}
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// UploadWorkerPool.h: Defines rx::UploadWorkerPool, an opt-in pool of threads which convert
+// client pixels into mapped image memory in row bands, so large texture uploads do not stall
+// the GL thread until the texture is next used.
+
+#ifndef LIBGLESV2_RENDERER_UPLOADWORKERPOOL_H_
+#define LIBGLESV2_RENDERER_UPLOADWORKERPOOL_H_
+
+#include <deque>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "libGLESv2/formatutils.h"
+
+namespace rx
+{
+class UploadWorkerPool;
+
+struct UploadWorkerPoolStatistics
+{
+    UploadWorkerPoolStatistics();
+
+    unsigned int uploads;
+    unsigned int bands;
+    unsigned long long bytesConverted;
+
+    // Waits on the GL thread for conversions which had not finished yet
+    unsigned int stalls;
+    double stallMilliseconds;
+
+    // Time from queueing an upload to its last band being converted, summed over all uploads
+    double latencyMilliseconds;
+};
+
+class PendingUpload
+{
+  public:
+    ~PendingUpload();
+
+    // Blocks the calling thread until every band has been converted
+    void wait();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(PendingUpload);
+
+    friend class UploadWorkerPool;
+    PendingUpload(UploadWorkerPool *pool, LoadImageFunction loadFunction, int bandCount);
+
+    void convertBand(int band);
+
+    UploadWorkerPool *mPool;
+    LoadImageFunction mLoadFunction;
+
+    // The client pixels are copied, the application may reuse its memory once the call returns
+    std::vector<unsigned char> mInput;
+    int mWidth;
+    int mHeight;
+    int mDepth;
+    unsigned int mInputRowPitch;
+    unsigned int mInputDepthPitch;
+
+    void *mOutput;
+    unsigned int mOutputRowPitch;
+    unsigned int mOutputDepthPitch;
+
+    // 2D areas are split into bands of rows, 3D areas into bands of slices
+    int mBandCount;
+    int mUnitsPerBand;
+
+    volatile LONG mRemainingBands;
+    HANDLE mCompleteEvent;
+    LARGE_INTEGER mQueueTime;
+};
+
+class UploadWorkerPool
+{
+  public:
+    explicit UploadWorkerPool(unsigned int threadCount);
+    ~UploadWorkerPool();
+
+    // Returns a new pool if enabled by setting the ANGLE_ASYNC_TEXTURE_UPLOAD environment
+    // variable to the number of worker threads, or to 0 for one less than the processor count.
+    // Returns NULL otherwise.
+    static UploadWorkerPool *create();
+
+    // Smaller uploads are cheaper to convert than to hand over to the workers
+    static bool isWorthQueueing(size_t inputBytes);
+
+    // Copies the input and queues its conversion. The output must stay mapped, and the image
+    // memory must not be accessed otherwise, until the returned upload has been waited on.
+    // The input size excludes the unpack alignment padding after the last row.
+    PendingUpload *queue(LoadImageFunction loadFunction, int width, int height, int depth,
+                         const void *input, size_t inputBytes, unsigned int inputRowPitch, unsigned int inputDepthPitch,
+                         void *output, unsigned int outputRowPitch, unsigned int outputDepthPitch);
+
+    UploadWorkerPoolStatistics getStatistics();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(UploadWorkerPool);
+
+    friend class PendingUpload;
+
+    struct Band
+    {
+        PendingUpload *upload;
+        int index;
+    };
+
+    static DWORD WINAPI workerMain(LPVOID parameter);
+    void runWorker();
+
+    // Removes a band of the upload which no worker has started on yet
+    bool takeBand(PendingUpload *upload, int *index);
+
+    void recordCompletion(const LARGE_INTEGER &queueTime);
+    void recordStall(double milliseconds);
+    double elapsedMilliseconds(const LARGE_INTEGER &start) const;
+
+    std::vector<HANDLE> mThreads;
+    HANDLE mWorkAvailable;
+    bool mExiting;
+
+    CRITICAL_SECTION mLock;
+    std::deque<Band> mBands;
+    UploadWorkerPoolStatistics mStatistics;
+
+    LARGE_INTEGER mFrequency;
+};
+
+}
+
+#endif   // LIBGLESV2_RENDERER_UPLOADWORKERPOOL_H_
@@ -12,6 +12,7 @@
 #include "libGLESv2/renderer/BufferStorage.h"
 
 #include "libGLESv2/Buffer.h"
+#include "libGLESv2/ProfileCounters.h"
 #include "libGLESv2/ProgramBinary.h"
 #include "libGLESv2/VertexAttribute.h"
 #include "libGLESv2/renderer/VertexBuffer.h"
@@ -87,6 +88,8 @@ VertexDataManager::~VertexDataManager()
 GLenum VertexDataManager::prepareVertexData(const gl::VertexAttribute attribs[], const gl::VertexAttribCurrentValueData currentValues[],
                                             gl::ProgramBinary *programBinary, GLint start, GLsizei count, TranslatedAttribute *translated, GLsizei instances)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_VERTEX_DATA);
+
     if (!mStreamingBuffer)
     {
         return GL_OUT_OF_MEMORY;
@@ -203,6 +206,8 @@ GLenum VertexDataManager::prepareVertexData(const gl::VertexAttribute attribs[],
                         {
                             return GL_OUT_OF_MEMORY;
                         }
+
+                        profile.addBytes(totalCount * outputElementSize);
                     }
 
                     unsigned int firstElementOffset = (attribs[i].mOffset / attribs[i].stride()) * outputElementSize;
@@ -223,6 +228,8 @@ GLenum VertexDataManager::prepareVertexData(const gl::VertexAttribute attribs[],
                     {
                         return GL_OUT_OF_MEMORY;
                     }
+
+                    profile.addBytes(totalCount * outputElementSize);
                 }
 
                 translated[i].storage = directStorage ? storage : NULL;
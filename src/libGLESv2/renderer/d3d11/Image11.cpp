@@ -31,6 +31,7 @@ Image11::Image11()
 
 Image11::~Image11()
 {
+    finishPendingUpload();
     SafeRelease(mStagingTexture);
 }
 
@@ -83,7 +84,7 @@ bool Image11::isDirty() const
 {
     // Make sure that this image is marked as dirty even if the staging texture hasn't been created yet
     // if initialization is required before use.
-    return (mDirty && (mStagingTexture || gl_d3d11::RequiresTextureDataInitialization(mInternalFormat)));
+    return (!mDirtyRegion.empty() && (mStagingTexture || gl_d3d11::RequiresTextureDataInitialization(mInternalFormat)));
 }
 
 bool Image11::copyToStorage(TextureStorageInterface2D *storage, int level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height)
@@ -131,8 +132,16 @@ bool Image11::redefine(Renderer *renderer, GLenum target, GLenum internalformat,
         mActualFormat = d3d11_gl::GetInternalFormat(mDXGIFormat, clientVersion);
         mRenderable = gl_d3d11::GetRTVFormat(internalformat, clientVersion) != DXGI_FORMAT_UNKNOWN;
 
+        finishPendingUpload();
         SafeRelease(mStagingTexture);
-        mDirty = gl_d3d11::RequiresTextureDataInitialization(mInternalFormat);
+        if (gl_d3d11::RequiresTextureDataInitialization(mInternalFormat))
+        {
+            markDirty();
+        }
+        else
+        {
+            markClean();
+        }
 
         return true;
     }
@@ -154,6 +163,8 @@ DXGI_FORMAT Image11::getDXGIFormat() const
 void Image11::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
                        GLint unpackAlignment, GLenum type, const void *input)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_TEXTURE_LOAD);
+
     GLuint clientVersion = mRenderer->getCurrentClientVersion();
     GLsizei inputRowPitch = gl::GetRowPitch(mInternalFormat, type, clientVersion, width, unpackAlignment);
     GLsizei inputDepthPitch = gl::GetDepthPitch(mInternalFormat, type, clientVersion, width, height, unpackAlignment);
@@ -171,17 +182,30 @@ void Image11::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei widt
     }
 
     void* offsetMappedData = (void*)((BYTE *)mappedImage.pData + (yoffset * mappedImage.RowPitch + xoffset * outputPixelSize + zoffset * mappedImage.DepthPitch));
-    loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch, offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
-    unmap();
+    // A queued conversion keeps the staging texture mapped until the image is next accessed
+    GLsizei inputRowBytes = gl::GetRowPitch(mInternalFormat, type, clientVersion, width, 1);
+    profile.addBytes(inputRowBytes * height * depth);
+
+    if (!queueUpload(mRenderer->getUploadWorkerPool(), loadFunction, width, height, depth, input, inputRowPitch, inputDepthPitch,
+                     inputRowBytes, offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch))
+    {
+        loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch, offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
+        unmap();
+    }
+
+    markDirty(gl::Box(xoffset, yoffset, zoffset, width, height, depth));
 }
 
 void Image11::loadCompressedData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
                                  const void *input)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_TEXTURE_LOAD);
+
     GLuint clientVersion = mRenderer->getCurrentClientVersion();
     GLsizei inputRowPitch = gl::GetRowPitch(mInternalFormat, GL_UNSIGNED_BYTE, clientVersion, width, 1);
     GLsizei inputDepthPitch = gl::GetDepthPitch(mInternalFormat, GL_UNSIGNED_BYTE, clientVersion, width, height, 1);
+    profile.addBytes(inputDepthPitch * depth);
 
     GLuint outputPixelSize = d3d11::GetFormatPixelBytes(mDXGIFormat);
     GLuint outputBlockWidth = d3d11::GetBlockWidth(mDXGIFormat);
@@ -209,10 +233,14 @@ void Image11::loadCompressedData(GLint xoffset, GLint yoffset, GLint zoffset, GL
                  offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
     unmap();
+
+    markDirty(gl::Box(xoffset, yoffset, zoffset, width, height, depth));
 }
 
 void Image11::copy(GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height, gl::Framebuffer *source)
 {
+    finishPendingUpload();
+
     gl::Renderbuffer *colorbuffer = source->getReadColorbuffer();
 
     if (colorbuffer && colorbuffer->getActualFormat() == (GLuint)mActualFormat)
@@ -293,10 +321,13 @@ void Image11::copy(GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y
 
         unmap();
     }
+
+    markDirty(gl::Box(xoffset, yoffset, zoffset, width, height, 1));
 }
 
 ID3D11Resource *Image11::getStagingTexture()
 {
+    finishPendingUpload();
     createStagingTexture();
 
     return mStagingTexture;
@@ -416,11 +447,21 @@ void Image11::createStagingTexture()
         }
     }
 
-    mDirty = false;
+    // The initialized contents of the new staging texture must reach the storage, the storage
+    // itself is not initialized
+    if (gl_d3d11::RequiresTextureDataInitialization(mInternalFormat))
+    {
+        markDirty();
+    }
+    else
+    {
+        markClean();
+    }
 }
 
 HRESULT Image11::map(D3D11_MAP mapType, D3D11_MAPPED_SUBRESOURCE *map)
 {
+    finishPendingUpload();
     createStagingTexture();
 
     HRESULT result = E_FAIL;
@@ -435,10 +476,6 @@ HRESULT Image11::map(D3D11_MAP mapType, D3D11_MAPPED_SUBRESOURCE *map)
         {
             mRenderer->notifyDeviceLost();
         }
-        else if (SUCCEEDED(result))
-        {
-            mDirty = true;
-        }
     }
 
     return result;
@@ -453,4 +490,12 @@ void Image11::unmap()
     }
 }
 
+void Image11::finishPendingUpload()
+{
+    if (waitForPendingUpload())
+    {
+        unmap();
+    }
+}
+
 }
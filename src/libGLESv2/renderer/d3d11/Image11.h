@@ -57,6 +57,7 @@ class Image11 : public Image
   protected:
     HRESULT map(D3D11_MAP mapType, D3D11_MAPPED_SUBRESOURCE *map);
     void unmap();
+    void finishPendingUpload();
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Image11);
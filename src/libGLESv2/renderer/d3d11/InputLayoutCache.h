@@ -12,6 +12,7 @@
 
 #include "libGLESv2/Constants.h"
 #include "common/angleutils.h"
+#include "common/LRUCache.h"
 
 namespace gl
 {
@@ -60,12 +61,6 @@ class InputLayoutCache
         }
     };
 
-    struct InputLayoutCounterPair
-    {
-        ID3D11InputLayout *inputLayout;
-        unsigned long long lastUsedTime;
-    };
-
     ID3D11InputLayout *mCurrentIL;
     unsigned int mCurrentBuffers[gl::MAX_VERTEX_ATTRIBS];
     UINT mCurrentVertexStrides[gl::MAX_VERTEX_ATTRIBS];
@@ -76,16 +71,14 @@ class InputLayoutCache
 
     typedef std::size_t (*InputLayoutHashFunction)(const InputLayoutKey &);
     typedef bool (*InputLayoutEqualityFunction)(const InputLayoutKey &, const InputLayoutKey &);
-    typedef std::unordered_map<InputLayoutKey,
-                               InputLayoutCounterPair,
-                               InputLayoutHashFunction,
-                               InputLayoutEqualityFunction> InputLayoutMap;
+    typedef gl::LRUCache<InputLayoutKey,
+                         ID3D11InputLayout*,
+                         InputLayoutHashFunction,
+                         InputLayoutEqualityFunction> InputLayoutMap;
     InputLayoutMap mInputLayoutMap;
 
     static const unsigned int kMaxInputLayouts;
 
-    unsigned long long mCounter;
-
     ID3D11Device *mDevice;
     ID3D11DeviceContext *mDeviceContext;
 };
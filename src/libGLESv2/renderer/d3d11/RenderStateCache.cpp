@@ -20,16 +20,6 @@
 namespace rx
 {
 
-template <typename mapType>
-static void ClearStateMap(mapType &map)
-{
-    for (mapType::iterator i = map.begin(); i != map.end(); i++)
-    {
-        SafeRelease(i->second.first);
-    }
-    map.clear();
-}
-
 // MSDN's documentation of ID3D11Device::CreateBlendState, ID3D11Device::CreateRasterizerState,
 // ID3D11Device::CreateDepthStencilState and ID3D11Device::CreateSamplerState claims the maximum
 // number of unique states of each type an application can create is 4096
@@ -38,16 +28,22 @@ const unsigned int RenderStateCache::kMaxRasterizerStates = 4096;
 const unsigned int RenderStateCache::kMaxDepthStencilStates = 4096;
 const unsigned int RenderStateCache::kMaxSamplerStates = 4096;
 
-RenderStateCache::RenderStateCache() : mDevice(NULL), mCounter(0),
-                                       mBlendStateCache(kMaxBlendStates, hashBlendState, compareBlendStates),
-                                       mRasterizerStateCache(kMaxRasterizerStates, hashRasterizerState, compareRasterizerStates),
-                                       mDepthStencilStateCache(kMaxDepthStencilStates, hashDepthStencilState, compareDepthStencilStates),
-                                       mSamplerStateCache(kMaxSamplerStates, hashSamplerState, compareSamplerStates)
+RenderStateCache::RenderStateCache() : mDevice(NULL),
+                                       mBlendStateCache(kMaxBlendStates, SafeRelease, hashBlendState, compareBlendStates),
+                                       mRasterizerStateCache(kMaxRasterizerStates, SafeRelease, hashRasterizerState, compareRasterizerStates),
+                                       mDepthStencilStateCache(kMaxDepthStencilStates, SafeRelease, hashDepthStencilState, compareDepthStencilStates),
+                                       mSamplerStateCache(kMaxSamplerStates, SafeRelease, hashSamplerState, compareSamplerStates)
 {
 }
 
 RenderStateCache::~RenderStateCache()
 {
+    TRACE("Render state cache: %u blend, %u rasterizer, %u depth stencil and %u sampler state evictions",
+          static_cast<unsigned int>(mBlendStateCache.getStatistics().evictions),
+          static_cast<unsigned int>(mRasterizerStateCache.getStatistics().evictions),
+          static_cast<unsigned int>(mDepthStencilStateCache.getStatistics().evictions),
+          static_cast<unsigned int>(mSamplerStateCache.getStatistics().evictions));
+
     clear();
 }
 
@@ -59,10 +55,10 @@ void RenderStateCache::initialize(ID3D11Device *device)
 
 void RenderStateCache::clear()
 {
-    ClearStateMap(mBlendStateCache);
-    ClearStateMap(mRasterizerStateCache);
-    ClearStateMap(mDepthStencilStateCache);
-    ClearStateMap(mSamplerStateCache);
+    mBlendStateCache.clear();
+    mRasterizerStateCache.clear();
+    mDepthStencilStateCache.clear();
+    mSamplerStateCache.clear();
 }
 
 std::size_t RenderStateCache::hashBlendState(const BlendStateKey &blendState)
@@ -115,31 +111,15 @@ ID3D11BlendState *RenderStateCache::getBlendState(const gl::Framebuffer *framebu
         }
     }
 
-    BlendStateMap::iterator i = mBlendStateCache.find(key);
-    if (i != mBlendStateCache.end())
+    ID3D11BlendState **cachedState = mBlendStateCache.get(key);
+    if (cachedState)
     {
-        BlendStateCounterPair &state = i->second;
-        state.second = mCounter++;
-        return state.first;
+        return *cachedState;
     }
     else
     {
-        if (mBlendStateCache.size() >= kMaxBlendStates)
-        {
-            TRACE("Overflowed the limit of %u blend states, removing the least recently used "
-                  "to make room.", kMaxBlendStates);
-
-            BlendStateMap::iterator leastRecentlyUsed = mBlendStateCache.begin();
-            for (BlendStateMap::iterator i = mBlendStateCache.begin(); i != mBlendStateCache.end(); i++)
-            {
-                if (i->second.second < leastRecentlyUsed->second.second)
-                {
-                    leastRecentlyUsed = i;
-                }
-            }
-            SafeRelease(leastRecentlyUsed->second.first);
-            mBlendStateCache.erase(leastRecentlyUsed);
-        }
+        // Direct3D limits the number of unique state objects, release one before creating another
+        mBlendStateCache.evictIfFull();
 
         // Create a new blend state and insert it into the cache
         D3D11_BLEND_DESC blendDesc = { 0 };
@@ -176,7 +156,7 @@ ID3D11BlendState *RenderStateCache::getBlendState(const gl::Framebuffer *framebu
             return NULL;
         }
 
-        mBlendStateCache.insert(std::make_pair(key, std::make_pair(dx11BlendState, mCounter++)));
+        mBlendStateCache.put(key, dx11BlendState);
 
         return dx11BlendState;
     }
@@ -210,31 +190,15 @@ ID3D11RasterizerState *RenderStateCache::getRasterizerState(const gl::Rasterizer
     key.scissorEnabled = scissorEnabled;
     key.depthSize = depthSize;
 
-    RasterizerStateMap::iterator i = mRasterizerStateCache.find(key);
-    if (i != mRasterizerStateCache.end())
+    ID3D11RasterizerState **cachedState = mRasterizerStateCache.get(key);
+    if (cachedState)
     {
-        RasterizerStateCounterPair &state = i->second;
-        state.second = mCounter++;
-        return state.first;
+        return *cachedState;
     }
     else
     {
-        if (mRasterizerStateCache.size() >= kMaxRasterizerStates)
-        {
-            TRACE("Overflowed the limit of %u rasterizer states, removing the least recently used "
-                  "to make room.", kMaxRasterizerStates);
-
-            RasterizerStateMap::iterator leastRecentlyUsed = mRasterizerStateCache.begin();
-            for (RasterizerStateMap::iterator i = mRasterizerStateCache.begin(); i != mRasterizerStateCache.end(); i++)
-            {
-                if (i->second.second < leastRecentlyUsed->second.second)
-                {
-                    leastRecentlyUsed = i;
-                }
-            }
-            SafeRelease(leastRecentlyUsed->second.first);
-            mRasterizerStateCache.erase(leastRecentlyUsed);
-        }
+        // Direct3D limits the number of unique state objects, release one before creating another
+        mRasterizerStateCache.evictIfFull();
 
         D3D11_CULL_MODE cullMode = gl_d3d11::ConvertCullMode(rasterState.cullFace, rasterState.cullMode);
 
@@ -264,7 +228,7 @@ ID3D11RasterizerState *RenderStateCache::getRasterizerState(const gl::Rasterizer
             return NULL;
         }
 
-        mRasterizerStateCache.insert(std::make_pair(key, std::make_pair(dx11RasterizerState, mCounter++)));
+        mRasterizerStateCache.put(key, dx11RasterizerState);
 
         return dx11RasterizerState;
     }
@@ -292,31 +256,15 @@ ID3D11DepthStencilState *RenderStateCache::getDepthStencilState(const gl::DepthS
         return NULL;
     }
 
-    DepthStencilStateMap::iterator i = mDepthStencilStateCache.find(dsState);
-    if (i != mDepthStencilStateCache.end())
+    ID3D11DepthStencilState **cachedState = mDepthStencilStateCache.get(dsState);
+    if (cachedState)
     {
-        DepthStencilStateCounterPair &state = i->second;
-        state.second = mCounter++;
-        return state.first;
+        return *cachedState;
     }
     else
     {
-        if (mDepthStencilStateCache.size() >= kMaxDepthStencilStates)
-        {
-            TRACE("Overflowed the limit of %u depth stencil states, removing the least recently used "
-                  "to make room.", kMaxDepthStencilStates);
-
-            DepthStencilStateMap::iterator leastRecentlyUsed = mDepthStencilStateCache.begin();
-            for (DepthStencilStateMap::iterator i = mDepthStencilStateCache.begin(); i != mDepthStencilStateCache.end(); i++)
-            {
-                if (i->second.second < leastRecentlyUsed->second.second)
-                {
-                    leastRecentlyUsed = i;
-                }
-            }
-            SafeRelease(leastRecentlyUsed->second.first);
-            mDepthStencilStateCache.erase(leastRecentlyUsed);
-        }
+        // Direct3D limits the number of unique state objects, release one before creating another
+        mDepthStencilStateCache.evictIfFull();
 
         D3D11_DEPTH_STENCIL_DESC dsDesc = { 0 };
         dsDesc.DepthEnable = dsState.depthTest ? TRUE : FALSE;
@@ -342,7 +290,7 @@ ID3D11DepthStencilState *RenderStateCache::getDepthStencilState(const gl::DepthS
             return NULL;
         }
 
-        mDepthStencilStateCache.insert(std::make_pair(dsState, std::make_pair(dx11DepthStencilState, mCounter++)));
+        mDepthStencilStateCache.put(dsState, dx11DepthStencilState);
 
         return dx11DepthStencilState;
     }
@@ -370,31 +318,15 @@ ID3D11SamplerState *RenderStateCache::getSamplerState(const gl::SamplerState &sa
         return NULL;
     }
 
-    SamplerStateMap::iterator i = mSamplerStateCache.find(samplerState);
-    if (i != mSamplerStateCache.end())
+    ID3D11SamplerState **cachedState = mSamplerStateCache.get(samplerState);
+    if (cachedState)
     {
-        SamplerStateCounterPair &state = i->second;
-        state.second = mCounter++;
-        return state.first;
+        return *cachedState;
     }
     else
     {
-        if (mSamplerStateCache.size() >= kMaxSamplerStates)
-        {
-            TRACE("Overflowed the limit of %u sampler states, removing the least recently used "
-                  "to make room.", kMaxSamplerStates);
-
-            SamplerStateMap::iterator leastRecentlyUsed = mSamplerStateCache.begin();
-            for (SamplerStateMap::iterator i = mSamplerStateCache.begin(); i != mSamplerStateCache.end(); i++)
-            {
-                if (i->second.second < leastRecentlyUsed->second.second)
-                {
-                    leastRecentlyUsed = i;
-                }
-            }
-            SafeRelease(leastRecentlyUsed->second.first);
-            mSamplerStateCache.erase(leastRecentlyUsed);
-        }
+        // Direct3D limits the number of unique state objects, release one before creating another
+        mSamplerStateCache.evictIfFull();
 
         D3D11_SAMPLER_DESC samplerDesc;
         samplerDesc.Filter = gl_d3d11::ConvertFilter(samplerState.minFilter, samplerState.magFilter,
@@ -420,7 +352,7 @@ ID3D11SamplerState *RenderStateCache::getSamplerState(const gl::SamplerState &sa
             return NULL;
         }
 
-        mSamplerStateCache.insert(std::make_pair(samplerState, std::make_pair(dx11SamplerState, mCounter++)));
+        mSamplerStateCache.put(samplerState, dx11SamplerState);
 
         return dx11SamplerState;
     }
@@ -12,6 +12,7 @@
 
 #include "libGLESv2/angletypes.h"
 #include "common/angleutils.h"
+#include "common/LRUCache.h"
 
 namespace gl
 {
@@ -39,8 +40,6 @@ class RenderStateCache
   private:
     DISALLOW_COPY_AND_ASSIGN(RenderStateCache);
 
-    unsigned long long mCounter;
-
     // Blend state cache
     struct BlendStateKey
     {
@@ -53,9 +52,8 @@ class RenderStateCache
 
     typedef std::size_t (*BlendStateHashFunction)(const BlendStateKey &);
     typedef bool (*BlendStateEqualityFunction)(const BlendStateKey &, const BlendStateKey &);
-    typedef std::pair<ID3D11BlendState*, unsigned long long> BlendStateCounterPair;
-    typedef std::unordered_map<BlendStateKey, BlendStateCounterPair, BlendStateHashFunction, BlendStateEqualityFunction> BlendStateMap;
-    BlendStateMap mBlendStateCache;
+    typedef gl::LRUCache<BlendStateKey, ID3D11BlendState*, BlendStateHashFunction, BlendStateEqualityFunction> BlendStateCache;
+    BlendStateCache mBlendStateCache;
 
     // Rasterizer state cache
     struct RasterizerStateKey
@@ -70,9 +68,8 @@ class RenderStateCache
 
     typedef std::size_t (*RasterizerStateHashFunction)(const RasterizerStateKey &);
     typedef bool (*RasterizerStateEqualityFunction)(const RasterizerStateKey &, const RasterizerStateKey &);
-    typedef std::pair<ID3D11RasterizerState*, unsigned long long> RasterizerStateCounterPair;
-    typedef std::unordered_map<RasterizerStateKey, RasterizerStateCounterPair, RasterizerStateHashFunction, RasterizerStateEqualityFunction> RasterizerStateMap;
-    RasterizerStateMap mRasterizerStateCache;
+    typedef gl::LRUCache<RasterizerStateKey, ID3D11RasterizerState*, RasterizerStateHashFunction, RasterizerStateEqualityFunction> RasterizerStateCache;
+    RasterizerStateCache mRasterizerStateCache;
 
     // Depth stencil state cache
     static std::size_t hashDepthStencilState(const gl::DepthStencilState &dsState);
@@ -81,12 +78,11 @@ class RenderStateCache
 
     typedef std::size_t (*DepthStencilStateHashFunction)(const gl::DepthStencilState &);
     typedef bool (*DepthStencilStateEqualityFunction)(const gl::DepthStencilState &, const gl::DepthStencilState &);
-    typedef std::pair<ID3D11DepthStencilState*, unsigned long long> DepthStencilStateCounterPair;
-    typedef std::unordered_map<gl::DepthStencilState,
-                               DepthStencilStateCounterPair,
-                               DepthStencilStateHashFunction,
-                               DepthStencilStateEqualityFunction> DepthStencilStateMap;
-    DepthStencilStateMap mDepthStencilStateCache;
+    typedef gl::LRUCache<gl::DepthStencilState,
+                         ID3D11DepthStencilState*,
+                         DepthStencilStateHashFunction,
+                         DepthStencilStateEqualityFunction> DepthStencilStateCache;
+    DepthStencilStateCache mDepthStencilStateCache;
 
     // Sample state cache
     static std::size_t hashSamplerState(const gl::SamplerState &samplerState);
@@ -95,12 +91,11 @@ class RenderStateCache
 
     typedef std::size_t (*SamplerStateHashFunction)(const gl::SamplerState &);
     typedef bool (*SamplerStateEqualityFunction)(const gl::SamplerState &, const gl::SamplerState &);
-    typedef std::pair<ID3D11SamplerState*, unsigned long long> SamplerStateCounterPair;
-    typedef std::unordered_map<gl::SamplerState,
-                               SamplerStateCounterPair,
-                               SamplerStateHashFunction,
-                               SamplerStateEqualityFunction> SamplerStateMap;
-    SamplerStateMap mSamplerStateCache;
+    typedef gl::LRUCache<gl::SamplerState,
+                         ID3D11SamplerState*,
+                         SamplerStateHashFunction,
+                         SamplerStateEqualityFunction> SamplerStateCache;
+    SamplerStateCache mSamplerStateCache;
 
     ID3D11Device *mDevice;
 };
@@ -823,6 +823,7 @@ void Renderer11::setScissorRectangle(const gl::Rectangle &scissor, bool enabled)
         if (enabled != mScissorEnabled)
         {
             mForceSetRasterState = true;
+            invalidateFixedFunctionState();
         }
 
         mCurScissor = scissor;
@@ -1072,6 +1073,7 @@ bool Renderer11::applyRenderTarget(gl::Framebuffer *framebuffer)
         mForceSetViewport = true;
         mForceSetScissor = true;
         mForceSetBlendState = true;
+        invalidateFixedFunctionState();
 
         if (!mDepthStencilInitialized || depthSize != mCurDepthSize)
         {
@@ -1637,6 +1639,7 @@ void Renderer11::markAllStateDirty()
     mForceSetBlendState = true;
     mForceSetRasterState = true;
     mForceSetDepthStencilState = true;
+    invalidateFixedFunctionState();
     mForceSetScissor = true;
     mForceSetViewport = true;
 
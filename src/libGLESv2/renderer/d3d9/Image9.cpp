@@ -34,6 +34,7 @@ Image9::Image9()
 
 Image9::~Image9()
 {
+    finishPendingUpload();
     SafeRelease(mSurface);
 }
 
@@ -150,8 +151,16 @@ bool Image9::redefine(rx::Renderer *renderer, GLenum target, GLenum internalform
         mActualFormat = d3d9_gl::GetInternalFormat(mD3DFormat);
         mRenderable = gl_d3d9::GetRenderFormat(internalformat, mRenderer) != D3DFMT_UNKNOWN;
 
+        finishPendingUpload();
         SafeRelease(mSurface);
-        mDirty = gl_d3d9::RequiresTextureDataInitialization(mInternalFormat);
+        if (gl_d3d9::RequiresTextureDataInitialization(mInternalFormat))
+        {
+            markDirty();
+        }
+        else
+        {
+            markClean();
+        }
 
         return true;
     }
@@ -215,12 +224,23 @@ void Image9::createSurface()
     }
 
     mSurface = newSurface;
-    mDirty = false;
     mD3DPool = poolToUse;
+
+    // The initialized contents of the new surface must reach the storage, the storage
+    // itself is not initialized
+    if (gl_d3d9::RequiresTextureDataInitialization(mInternalFormat))
+    {
+        markDirty();
+    }
+    else
+    {
+        markClean();
+    }
 }
 
 HRESULT Image9::lock(D3DLOCKED_RECT *lockedRect, const RECT *rect)
 {
+    finishPendingUpload();
     createSurface();
 
     HRESULT result = D3DERR_INVALIDCALL;
@@ -230,7 +250,14 @@ HRESULT Image9::lock(D3DLOCKED_RECT *lockedRect, const RECT *rect)
         result = mSurface->LockRect(lockedRect, rect, 0);
         ASSERT(SUCCEEDED(result));
 
-        mDirty = true;
+        if (rect)
+        {
+            markDirty(gl::Box(rect->left, rect->top, 0, rect->right - rect->left, rect->bottom - rect->top, 1));
+        }
+        else
+        {
+            markDirty();
+        }
     }
 
     return result;
@@ -258,11 +285,12 @@ bool Image9::isDirty() const
 {
     // Make sure to that this image is marked as dirty even if the staging texture hasn't been created yet
     // if initialization is required before use.
-    return (mSurface || gl_d3d9::RequiresTextureDataInitialization(mInternalFormat)) && mDirty;
+    return (mSurface || gl_d3d9::RequiresTextureDataInitialization(mInternalFormat)) && !mDirtyRegion.empty();
 }
 
 IDirect3DSurface9 *Image9::getSurface()
 {
+    finishPendingUpload();
     createSurface();
 
     return mSurface;
@@ -282,6 +310,8 @@ void Image9::setManagedSurface(TextureStorageInterfaceCube *storage, int face, i
 
 void Image9::setManagedSurface(IDirect3DSurface9 *surface)
 {
+    finishPendingUpload();
+
     D3DSURFACE_DESC desc;
     surface->GetDesc(&desc);
     ASSERT(desc.Pool == D3DPOOL_MANAGED);
@@ -379,6 +409,8 @@ bool Image9::copyToSurface(IDirect3DSurface9 *destSurface, GLint xoffset, GLint
 void Image9::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
                       GLint unpackAlignment, GLenum type, const void *input)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_TEXTURE_LOAD);
+
     // 3D textures are not supported by the D3D9 backend.
     ASSERT(zoffset == 0 && depth == 1);
 
@@ -401,20 +433,32 @@ void Image9::loadData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width
         return;
     }
 
-    loadFunction(width, height, depth, input, inputRowPitch, 0, locked.pBits, locked.Pitch, 0);
+    // Managed surfaces belong to the texture storage and can not stay locked, a queued conversion
+    // keeps a system memory surface locked until the image is next accessed
+    GLsizei inputRowBytes = gl::GetRowPitch(mInternalFormat, type, clientVersion, width, 1);
+    profile.addBytes(inputRowBytes * height);
 
-    unlock();
+    if (mD3DPool == D3DPOOL_MANAGED ||
+        !queueUpload(mRenderer->getUploadWorkerPool(), loadFunction, width, height, depth, input, inputRowPitch, 0,
+                     inputRowBytes, locked.pBits, locked.Pitch, 0))
+    {
+        loadFunction(width, height, depth, input, inputRowPitch, 0, locked.pBits, locked.Pitch, 0);
+        unlock();
+    }
 }
 
 void Image9::loadCompressedData(GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
                                 const void *input)
 {
+    gl::ProfileScope profile(gl::PROFILE_STAGE_TEXTURE_LOAD);
+
     // 3D textures are not supported by the D3D9 backend.
     ASSERT(zoffset == 0 && depth == 1);
 
     GLuint clientVersion = mRenderer->getCurrentClientVersion();
     GLsizei inputRowPitch = gl::GetRowPitch(mInternalFormat, GL_UNSIGNED_BYTE, clientVersion, width, 1);
     GLsizei inputDepthPitch = gl::GetDepthPitch(mInternalFormat, GL_UNSIGNED_BYTE, clientVersion, width, height, 1);
+    profile.addBytes(inputDepthPitch);
 
     GLuint outputPixelSize = d3d9::GetFormatPixelBytes(mD3DFormat);
     GLuint outputBlockWidth = d3d9::GetBlockWidth(mD3DFormat);
@@ -694,8 +738,14 @@ void Image9::copy(GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y,
 
     SafeRelease(renderTargetData);
     SafeRelease(surface);
+}
 
-    mDirty = true;
+void Image9::finishPendingUpload()
+{
+    if (waitForPendingUpload())
+    {
+        unlock();
+    }
 }
 
 }
@@ -67,6 +67,7 @@ class Image9 : public Image
 
     HRESULT lock(D3DLOCKED_RECT *lockedRect, const RECT *rect);
     void unlock();
+    void finishPendingUpload();
     
     Renderer9 *mRenderer;
 
@@ -1384,12 +1384,14 @@ bool Renderer9::applyRenderTarget(gl::Framebuffer *framebuffer)
         {
             mCurDepthSize = depthSize;
             mForceSetRasterState = true;
+            invalidateFixedFunctionState();
         }
 
         if (!mDepthStencilInitialized || stencilSize != mCurStencilSize)
         {
             mCurStencilSize = stencilSize;
             mForceSetDepthStencilState = true;
+            invalidateFixedFunctionState();
         }
 
         mAppliedDepthbufferSerial = depthbufferSerial;
@@ -1402,6 +1404,7 @@ bool Renderer9::applyRenderTarget(gl::Framebuffer *framebuffer)
         mForceSetScissor = true;
         mForceSetViewport = true;
         mForceSetBlendState = true;
+        invalidateFixedFunctionState();
 
         mRenderTargetDesc.width = renderbufferObject->getWidth();
         mRenderTargetDesc.height = renderbufferObject->getHeight();
@@ -2099,6 +2102,7 @@ void Renderer9::markAllStateDirty()
     mForceSetScissor = true;
     mForceSetViewport = true;
     mForceSetBlendState = true;
+    invalidateFixedFunctionState();
 
     for (unsigned int i = 0; i < gl::IMPLEMENTATION_MAX_VERTEX_TEXTURE_IMAGE_UNITS; i++)
     {
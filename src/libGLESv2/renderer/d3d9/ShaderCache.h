@@ -11,6 +11,7 @@
 #define LIBGLESV2_RENDERER_SHADER_CACHE_H_
 
 #include "common/debug.h"
+#include "common/LRUCache.h"
 
 namespace rx
 {
@@ -18,7 +19,7 @@ template <typename ShaderObject>
 class ShaderCache
 {
   public:
-    ShaderCache() : mDevice(NULL)
+    ShaderCache() : mDevice(NULL), mMap(kMaxMapSize, SafeRelease)
     {
     }
 
@@ -36,11 +37,11 @@ class ShaderCache
     ShaderObject *create(const DWORD *function, size_t length)
     {
         std::string key(reinterpret_cast<const char*>(function), length);
-        typename Map::iterator it = mMap.find(key);
-        if (it != mMap.end())
+        ShaderObject **cachedShader = mMap.get(key);
+        if (cachedShader)
         {
-            it->second->AddRef();
-            return it->second;
+            (*cachedShader)->AddRef();
+            return *cachedShader;
         }
 
         ShaderObject *shader;
@@ -50,26 +51,14 @@ class ShaderCache
             return NULL;
         }
 
-        // Random eviction policy.
-        if (mMap.size() >= kMaxMapSize)
-        {
-            SafeRelease(mMap.begin()->second);
-            mMap.erase(mMap.begin());
-        }
-
         shader->AddRef();
-        mMap[key] = shader;
+        mMap.put(key, shader);
 
         return shader;
     }
 
     void clear()
     {
-        for (typename Map::iterator it = mMap.begin(); it != mMap.end(); ++it)
-        {
-            SafeRelease(it->second);
-        }
-
         mMap.clear();
     }
 
@@ -88,10 +77,10 @@ class ShaderCache
         return mDevice->CreatePixelShader(function, shader);
     }
 
-    typedef std::unordered_map<std::string, ShaderObject*> Map;
-    Map mMap;
-
     IDirect3DDevice9 *mDevice;
+
+    typedef gl::LRUCache<std::string, ShaderObject*> Map;
+    Map mMap;
 };
 
 typedef ShaderCache<IDirect3DVertexShader9> VertexShaderCache;
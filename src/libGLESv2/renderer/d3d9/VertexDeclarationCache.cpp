@@ -13,17 +13,14 @@
 #include "libGLESv2/renderer/d3d9/VertexDeclarationCache.h"
 #include "libGLESv2/renderer/d3d9/formatutils9.h"
 
+#include "third_party/murmurhash/MurmurHash3.h"
+
 namespace rx
 {
 
-VertexDeclarationCache::VertexDeclarationCache() : mMaxLru(0)
+VertexDeclarationCache::VertexDeclarationCache()
+    : mVertexDeclCache(NUM_VERTEX_DECL_CACHE_ENTRIES, SafeRelease, hashVertexDeclaration, compareVertexDeclarations)
 {
-    for (int i = 0; i < NUM_VERTEX_DECL_CACHE_ENTRIES; i++)
-    {
-        mVertexDeclCache[i].vertexDeclaration = NULL;
-        mVertexDeclCache[i].lruCount = 0;
-    }
-
     for (int i = 0; i < gl::MAX_VERTEX_ATTRIBS; i++)
     {
         mAppliedVBs[i].serial = 0;
@@ -35,10 +32,6 @@ VertexDeclarationCache::VertexDeclarationCache() : mMaxLru(0)
 
 VertexDeclarationCache::~VertexDeclarationCache()
 {
-    for (int i = 0; i < NUM_VERTEX_DECL_CACHE_ENTRIES; i++)
-    {
-        SafeRelease(mVertexDeclCache[i].vertexDeclaration);
-    }
 }
 
 GLenum VertexDeclarationCache::applyDeclaration(IDirect3DDevice9 *device, TranslatedAttribute attributes[], gl::ProgramBinary *programBinary, GLsizei instances, GLsizei *repeatDraw)
@@ -74,8 +67,8 @@ GLenum VertexDeclarationCache::applyDeclaration(IDirect3DDevice9 *device, Transl
         }
     }
 
-    D3DVERTEXELEMENT9 elements[gl::MAX_VERTEX_ATTRIBS + 1];
-    D3DVERTEXELEMENT9 *element = &elements[0];
+    VertexDeclarationKey key = { 0 };
+    D3DVERTEXELEMENT9 *element = &key.elements[0];
 
     for (int i = 0; i < gl::MAX_VERTEX_ATTRIBS; i++)
     {
@@ -159,45 +152,36 @@ GLenum VertexDeclarationCache::applyDeclaration(IDirect3DDevice9 *device, Transl
 
     static const D3DVERTEXELEMENT9 end = D3DDECL_END();
     *(element++) = end;
+    key.elementCount = static_cast<unsigned int>(element - key.elements);
 
-    for (int i = 0; i < NUM_VERTEX_DECL_CACHE_ENTRIES; i++)
+    IDirect3DVertexDeclaration9 **cachedDeclaration = mVertexDeclCache.get(key);
+    if (cachedDeclaration)
     {
-        VertexDeclCacheEntry *entry = &mVertexDeclCache[i];
-        if (memcmp(entry->cachedElements, elements, (element - elements) * sizeof(D3DVERTEXELEMENT9)) == 0 && entry->vertexDeclaration)
+        if (*cachedDeclaration != mLastSetVDecl)
         {
-            entry->lruCount = ++mMaxLru;
-            if(entry->vertexDeclaration != mLastSetVDecl)
-            {
-                device->SetVertexDeclaration(entry->vertexDeclaration);
-                mLastSetVDecl = entry->vertexDeclaration;
-            }
-
-            return GL_NO_ERROR;
+            device->SetVertexDeclaration(*cachedDeclaration);
+            mLastSetVDecl = *cachedDeclaration;
         }
-    }
-
-    VertexDeclCacheEntry *lastCache = mVertexDeclCache;
 
-    for (int i = 0; i < NUM_VERTEX_DECL_CACHE_ENTRIES; i++)
-    {
-        if (mVertexDeclCache[i].lruCount < lastCache->lruCount)
-        {
-            lastCache = &mVertexDeclCache[i];
-        }
+        return GL_NO_ERROR;
     }
 
-    if (lastCache->vertexDeclaration != NULL)
+    // Release the least recently used declaration first. mLastSetVDecl is set to the
+    // replacement, so we don't have to worry about it.
+    mVertexDeclCache.evictIfFull();
+
+    IDirect3DVertexDeclaration9 *vertexDeclaration = NULL;
+    HRESULT result = device->CreateVertexDeclaration(key.elements, &vertexDeclaration);
+    if (FAILED(result))
     {
-        SafeRelease(lastCache->vertexDeclaration);
-        // mLastSetVDecl is set to the replacement, so we don't have to worry
-        // about it.
+        ERR("Failed to create a vertex declaration, HRESULT: 0x%08x", result);
+        mLastSetVDecl = NULL;
+        return GL_OUT_OF_MEMORY;
     }
 
-    memcpy(lastCache->cachedElements, elements, (element - elements) * sizeof(D3DVERTEXELEMENT9));
-    device->CreateVertexDeclaration(elements, &lastCache->vertexDeclaration);
-    device->SetVertexDeclaration(lastCache->vertexDeclaration);
-    mLastSetVDecl = lastCache->vertexDeclaration;
-    lastCache->lruCount = ++mMaxLru;
+    mVertexDeclCache.put(key, vertexDeclaration);
+    device->SetVertexDeclaration(vertexDeclaration);
+    mLastSetVDecl = vertexDeclaration;
 
     return GL_NO_ERROR;
 }
@@ -213,4 +197,19 @@ void VertexDeclarationCache::markStateDirty()
     mInstancingEnabled = true;   // Forces it to be disabled when not used
 }
 
+std::size_t VertexDeclarationCache::hashVertexDeclaration(const VertexDeclarationKey &key)
+{
+    static const unsigned int seed = 0xDEC1A4E9;
+
+    std::size_t hash = 0;
+    MurmurHash3_x86_32(key.elements, static_cast<int>(key.elementCount * sizeof(D3DVERTEXELEMENT9)), seed, &hash);
+    return hash;
+}
+
+bool VertexDeclarationCache::compareVertexDeclarations(const VertexDeclarationKey &a, const VertexDeclarationKey &b)
+{
+    return a.elementCount == b.elementCount &&
+           memcmp(a.elements, b.elements, a.elementCount * sizeof(D3DVERTEXELEMENT9)) == 0;
+}
+
 }
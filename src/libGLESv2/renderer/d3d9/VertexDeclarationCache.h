@@ -10,6 +10,7 @@
 #define LIBGLESV2_RENDERER_VERTEXDECLARATIONCACHE_H_
 
 #include "libGLESv2/renderer/VertexDataManager.h"
+#include "common/LRUCache.h"
 
 namespace gl
 {
@@ -30,7 +31,7 @@ class VertexDeclarationCache
     void markStateDirty();
 
   private:
-    UINT mMaxLru;
+    DISALLOW_COPY_AND_ASSIGN(VertexDeclarationCache);
 
     enum { NUM_VERTEX_DECL_CACHE_ENTRIES = 32 };
 
@@ -45,12 +46,23 @@ class VertexDeclarationCache
     IDirect3DVertexDeclaration9 *mLastSetVDecl;
     bool mInstancingEnabled;
 
-    struct VertexDeclCacheEntry
+    // The elements including the D3DDECL_END terminator
+    struct VertexDeclarationKey
     {
-        D3DVERTEXELEMENT9 cachedElements[gl::MAX_VERTEX_ATTRIBS + 1];
-        UINT lruCount;
-        IDirect3DVertexDeclaration9 *vertexDeclaration;
-    } mVertexDeclCache[NUM_VERTEX_DECL_CACHE_ENTRIES];
+        unsigned int elementCount;
+        D3DVERTEXELEMENT9 elements[gl::MAX_VERTEX_ATTRIBS + 1];
+    };
+
+    static std::size_t hashVertexDeclaration(const VertexDeclarationKey &key);
+    static bool compareVertexDeclarations(const VertexDeclarationKey &a, const VertexDeclarationKey &b);
+
+    typedef std::size_t (*VertexDeclarationHashFunction)(const VertexDeclarationKey &);
+    typedef bool (*VertexDeclarationEqualityFunction)(const VertexDeclarationKey &, const VertexDeclarationKey &);
+    typedef gl::LRUCache<VertexDeclarationKey,
+                         IDirect3DVertexDeclaration9*,
+                         VertexDeclarationHashFunction,
+                         VertexDeclarationEqualityFunction> VertexDeclarationMap;
+    VertexDeclarationMap mVertexDeclCache;
 };
 
 }
@@ -198,6 +198,8 @@ bool ValidateRenderbufferStorageParameters(const gl::Context *context, GLenum ta
                                            GLenum internalformat, GLsizei width, GLsizei height,
                                            bool angleExtension)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     switch (target)
     {
       case GL_RENDERBUFFER:
@@ -274,6 +276,8 @@ bool ValidateRenderbufferStorageParameters(const gl::Context *context, GLenum ta
 bool ValidateFramebufferRenderbufferParameters(gl::Context *context, GLenum target, GLenum attachment,
                                                GLenum renderbuffertarget, GLuint renderbuffer)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     gl::Framebuffer *framebuffer = context->getTargetFramebuffer(target);
     GLuint framebufferHandle = context->getTargetFramebufferHandle(target);
 
@@ -354,6 +358,8 @@ bool ValidateBlitFramebufferParameters(gl::Context *context, GLint srcX0, GLint
                                        GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask,
                                        GLenum filter, bool fromAngleExtension)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     switch (filter)
     {
       case GL_NEAREST:
@@ -603,6 +609,8 @@ bool ValidateGetVertexAttribParameters(GLenum pname, int clientVersion)
 
 bool ValidateTexParamParameters(gl::Context *context, GLenum pname, GLint param)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     switch (pname)
     {
       case GL_TEXTURE_WRAP_R:
@@ -776,6 +784,8 @@ bool ValidateSamplerObjectParameter(GLenum pname)
 bool ValidateReadPixelsParameters(gl::Context *context, GLint x, GLint y, GLsizei width, GLsizei height,
                                   GLenum format, GLenum type, GLsizei *bufSize, GLvoid *pixels)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     gl::Framebuffer *framebuffer = context->getReadFramebuffer();
 
     if (framebuffer->completeness() != GL_FRAMEBUFFER_COMPLETE)
@@ -836,4 +846,55 @@ bool ValidateReadPixelsParameters(gl::Context *context, GLint x, GLint y, GLsize
     return true;
 }
 
+bool ValidateDrawArrays(const gl::Context *context, GLint first, GLsizei count, GLsizei primcount)
+{
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
+    if (count < 0 || first < 0 || primcount < 0)
+    {
+        return gl::error(GL_INVALID_VALUE, false);
+    }
+
+    // Check for mapped buffers
+    if (context->hasMappedBuffer(GL_ARRAY_BUFFER))
+    {
+        return gl::error(GL_INVALID_OPERATION, false);
+    }
+
+    return true;
+}
+
+bool ValidateDrawElements(const gl::Context *context, GLsizei count, GLenum type, GLsizei primcount)
+{
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
+    if (count < 0 || primcount < 0)
+    {
+        return gl::error(GL_INVALID_VALUE, false);
+    }
+
+    switch (type)
+    {
+      case GL_UNSIGNED_BYTE:
+      case GL_UNSIGNED_SHORT:
+        break;
+      case GL_UNSIGNED_INT:
+        if (!context->supports32bitIndices())
+        {
+            return gl::error(GL_INVALID_ENUM, false);
+        }
+        break;
+      default:
+        return gl::error(GL_INVALID_ENUM, false);
+    }
+
+    // Check for mapped buffers
+    if (context->hasMappedBuffer(GL_ARRAY_BUFFER) || context->hasMappedBuffer(GL_ELEMENT_ARRAY_BUFFER))
+    {
+        return gl::error(GL_INVALID_OPERATION, false);
+    }
+
+    return true;
+}
+
 }
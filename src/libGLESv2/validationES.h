@@ -43,6 +43,9 @@ bool ValidateSamplerObjectParameter(GLenum pname);
 bool ValidateReadPixelsParameters(gl::Context *context, GLint x, GLint y, GLsizei width, GLsizei height,
                                   GLenum format, GLenum type, GLsizei *bufSize, GLvoid *pixels);
 
+bool ValidateDrawArrays(const gl::Context *context, GLint first, GLsizei count, GLsizei primcount);
+bool ValidateDrawElements(const gl::Context *context, GLsizei count, GLenum type, GLsizei primcount);
+
 }
 
 #endif // LIBGLESV2_VALIDATION_ES_H
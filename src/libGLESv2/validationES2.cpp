@@ -108,6 +108,8 @@ bool ValidateES2TexImageParameters(gl::Context *context, GLenum target, GLint le
                                    GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                                    GLint border, GLenum format, GLenum type, const GLvoid *pixels)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (!ValidImageSize(context, target, level, width, height, 1))
     {
         return gl::error(GL_INVALID_VALUE, false);
@@ -457,6 +459,8 @@ bool ValidateES2CopyTexImageParameters(gl::Context* context, GLenum target, GLin
                                        GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height,
                                        GLint border)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (!gl::IsInternalTextureTarget(target, context->getClientVersion()))
     {
         return gl::error(GL_INVALID_ENUM, false);
@@ -778,6 +782,8 @@ bool ValidateES2CopyTexImageParameters(gl::Context* context, GLenum target, GLin
 bool ValidateES2TexStorageParameters(gl::Context *context, GLenum target, GLsizei levels, GLenum internalformat,
                                      GLsizei width, GLsizei height)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (target != GL_TEXTURE_2D && target != GL_TEXTURE_CUBE_MAP)
     {
         return gl::error(GL_INVALID_ENUM, false);
@@ -936,6 +942,8 @@ bool ValidateES2TexStorageParameters(gl::Context *context, GLenum target, GLsize
 bool ValidateES2FramebufferTextureParameters(gl::Context *context, GLenum target, GLenum attachment,
                                              GLenum textarget, GLuint texture, GLint level)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     META_ASSERT(GL_DRAW_FRAMEBUFFER == GL_DRAW_FRAMEBUFFER_ANGLE && GL_READ_FRAMEBUFFER == GL_READ_FRAMEBUFFER_ANGLE);
 
     if (target != GL_FRAMEBUFFER && target != GL_DRAW_FRAMEBUFFER && target != GL_READ_FRAMEBUFFER)
@@ -25,6 +25,8 @@ bool ValidateES3TexImageParameters(gl::Context *context, GLenum target, GLint le
                                    GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
                                    GLint border, GLenum format, GLenum type, const GLvoid *pixels)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     // Validate image size
     if (!ValidImageSize(context, target, level, width, height, depth))
     {
@@ -286,6 +288,8 @@ bool ValidateES3CopyTexImageParameters(gl::Context *context, GLenum target, GLin
                                        bool isSubImage, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y,
                                        GLsizei width, GLsizei height, GLint border)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (level < 0 || xoffset < 0 || yoffset < 0 || zoffset < 0 || width < 0 || height < 0)
     {
         return gl::error(GL_INVALID_VALUE, false);
@@ -449,6 +453,8 @@ bool ValidateES3CopyTexImageParameters(gl::Context *context, GLenum target, GLin
 bool ValidateES3TexStorageParameters(gl::Context *context, GLenum target, GLsizei levels, GLenum internalformat,
                                      GLsizei width, GLsizei height, GLsizei depth)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (width < 1 || height < 1 || depth < 1 || levels < 1)
     {
         return gl::error(GL_INVALID_VALUE, false);
@@ -547,6 +553,8 @@ bool ValidateES3FramebufferTextureParameters(gl::Context *context, GLenum target
                                              GLenum textarget, GLuint texture, GLint level, GLint layer,
                                              bool layerCall)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     if (target != GL_FRAMEBUFFER && target != GL_DRAW_FRAMEBUFFER && target != GL_READ_FRAMEBUFFER)
     {
         return gl::error(GL_INVALID_ENUM, false);
@@ -778,6 +786,8 @@ bool ValidES3ReadFormatType(GLenum internalFormat, GLenum format, GLenum type)
 bool ValidateInvalidateFramebufferParameters(gl::Context *context, GLenum target, GLsizei numAttachments,
                                              const GLenum* attachments)
 {
+    ProfileScope profile(PROFILE_STAGE_VALIDATION);
+
     bool defaultFramebuffer = false;
 
     switch (target)
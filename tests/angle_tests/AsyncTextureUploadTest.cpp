@@ -0,0 +1,189 @@
+#include "ANGLETest.h"
+
+#include <algorithm>
+#include <vector>
+
+// These tests pass whether or not uploads are converted on worker threads. Run angle_tests with
+// --async-texture-upload to have their uploads, which are large enough to be queued, and those
+// of every other test go through the upload worker pool.
+class AsyncTextureUploadTest : public ANGLETest
+{
+protected:
+    AsyncTextureUploadTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        const std::string vertexShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            attribute vec4 position;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_Position = position;
+                texcoord = (position.xy * 0.5) + 0.5;
+            }
+        );
+
+        const std::string fragmentShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            uniform sampler2D tex;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_FragColor = texture2D(tex, texcoord);
+            }
+        );
+
+        mProgram = compileProgram(vertexShaderSource, fragmentShaderSource);
+        if (mProgram == 0)
+        {
+            FAIL() << "shader compilation failed.";
+        }
+
+        mTextureUniformLocation = glGetUniformLocation(mProgram, "tex");
+
+        glGenTextures(1, &mTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glUseProgram(mProgram);
+        glUniform1i(mTextureUniformLocation, 0);
+    }
+
+    virtual void TearDown()
+    {
+        glDeleteTextures(1, &mTexture);
+        glDeleteProgram(mProgram);
+
+        ANGLETest::TearDown();
+    }
+
+    // RGB data needs converting to the RGBA storage format. Each quadrant has its own color:
+    // red at the bottom left, green at the bottom right, blue at the top left and white at the top right.
+    static std::vector<GLubyte> makeQuadrantData(GLsizei size)
+    {
+        std::vector<GLubyte> buffer(size * size * 3);
+        for (GLsizei y = 0; y < size; y++)
+        {
+            for (GLsizei x = 0; x < size; x++)
+            {
+                bool right = (x >= size / 2);
+                bool top = (y >= size / 2);
+                GLubyte *texel = &buffer[(y * size + x) * 3];
+                texel[0] = (right == top) ? 255 : 0;
+                texel[1] = right ? 255 : 0;
+                texel[2] = top ? 255 : 0;
+            }
+        }
+        return buffer;
+    }
+
+    static std::vector<GLubyte> makeColorData(GLsizei size, GLubyte r, GLubyte g, GLubyte b)
+    {
+        std::vector<GLubyte> buffer(size * size * 3);
+        for (size_t i = 0; i < buffer.size() / 3; i++)
+        {
+            buffer[i * 3 + 0] = r;
+            buffer[i * 3 + 1] = g;
+            buffer[i * 3 + 2] = b;
+        }
+        return buffer;
+    }
+
+    static void expectQuadrants()
+    {
+        EXPECT_PIXEL_EQ(32, 32, 255, 0, 0, 255);
+        EXPECT_PIXEL_EQ(96, 32, 0, 255, 0, 255);
+        EXPECT_PIXEL_EQ(32, 96, 0, 0, 255, 255);
+        EXPECT_PIXEL_EQ(96, 96, 255, 255, 255, 255);
+    }
+
+    // 768KB of RGB data, over the size from which uploads are queued
+    static const GLsizei kTextureSize = 512;
+
+    GLuint mProgram;
+    GLint mTextureUniformLocation;
+    GLuint mTexture;
+};
+
+// The client memory may be reused as soon as glTexImage2D returns
+TEST_F(AsyncTextureUploadTest, large_tex_image_reads_back)
+{
+    std::vector<GLubyte> data = makeQuadrantData(kTextureSize);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, kTextureSize, kTextureSize, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+    std::fill(data.begin(), data.end(), 0);
+
+    drawQuad(mProgram, "position", 0.5f);
+    expectQuadrants();
+
+    EXPECT_GL_NO_ERROR();
+}
+
+// Reading the texture through a framebuffer waits for the conversion as sampling it does
+TEST_F(AsyncTextureUploadTest, large_tex_image_reads_back_from_framebuffer)
+{
+    std::vector<GLubyte> data = makeQuadrantData(kTextureSize);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, kTextureSize, kTextureSize, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+    std::fill(data.begin(), data.end(), 0);
+
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTexture, 0);
+    ASSERT_EQ(glCheckFramebufferStatus(GL_FRAMEBUFFER), GL_FRAMEBUFFER_COMPLETE);
+
+    EXPECT_PIXEL_EQ(0, 0, 255, 0, 0, 255);
+    EXPECT_PIXEL_EQ(kTextureSize - 1, 0, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(0, kTextureSize - 1, 0, 0, 255, 255);
+    EXPECT_PIXEL_EQ(kTextureSize - 1, kTextureSize - 1, 255, 255, 255, 255);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+
+    EXPECT_GL_NO_ERROR();
+}
+
+// Updates to a texture which already has storage are copied to it when the texture is next used
+TEST_F(AsyncTextureUploadTest, large_tex_sub_image_reads_back)
+{
+    std::vector<GLubyte> data = makeColorData(kTextureSize, 0, 0, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, kTextureSize, kTextureSize, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(64, 64, 0, 0, 0, 255);
+
+    data = makeQuadrantData(kTextureSize);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kTextureSize, kTextureSize, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+    std::fill(data.begin(), data.end(), 0);
+
+    drawQuad(mProgram, "position", 0.5f);
+    expectQuadrants();
+
+    // The mipmaps are generated from the updated base level
+    data = makeColorData(kTextureSize, 0, 255, 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kTextureSize, kTextureSize, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(32, 32, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(96, 96, 0, 255, 0, 255);
+
+    EXPECT_GL_NO_ERROR();
+}
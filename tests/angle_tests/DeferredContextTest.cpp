@@ -0,0 +1,214 @@
+#include "ANGLETest.h"
+
+#include <ctime>
+#include <iostream>
+
+// These tests pass whether or not calls are deferred. Run angle_tests with --deferred-context to
+// have them, and every other test, go through the submission thread.
+class DeferredContextTest : public ANGLETest
+{
+protected:
+    DeferredContextTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        const std::string vertexShaderSource = SHADER_SOURCE
+        (
+            attribute vec4 position;
+            uniform vec2 u_offset;
+            void main()
+            {
+                gl_Position = vec4(position.xy + u_offset, position.zw);
+            }
+        );
+
+        const std::string fragmentShaderSource = SHADER_SOURCE
+        (
+            precision mediump float;
+            uniform vec4 u_color;
+            void main()
+            {
+                gl_FragColor = u_color;
+            }
+        );
+
+        mProgram = compileProgram(vertexShaderSource, fragmentShaderSource);
+        if (mProgram == 0)
+        {
+            FAIL() << "shader compilation failed.";
+        }
+
+        mPositionLocation = glGetAttribLocation(mProgram, "position");
+        mOffsetLocation = glGetUniformLocation(mProgram, "u_offset");
+        mColorLocation = glGetUniformLocation(mProgram, "u_color");
+
+        // A quad covering the bottom left quarter of the window, drawn from a buffer object so
+        // draws can be queued rather than reading client memory
+        const GLfloat vertices[] =
+        {
+            -1.0f,  0.0f,
+            -1.0f, -1.0f,
+             0.0f, -1.0f,
+
+            -1.0f,  0.0f,
+             0.0f, -1.0f,
+             0.0f,  0.0f,
+        };
+
+        glGenBuffers(1, &mBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+        glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+        glEnableVertexAttribArray(mPositionLocation);
+
+        glUseProgram(mProgram);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    virtual void TearDown()
+    {
+        glDisableVertexAttribArray(mPositionLocation);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDeleteBuffers(1, &mBuffer);
+        glDeleteProgram(mProgram);
+
+        ANGLETest::TearDown();
+    }
+
+    // Draws the quad into the quarter of the window given by column and row
+    void drawQuarter(int column, int row, GLfloat red, GLfloat green, GLfloat blue)
+    {
+        glUniform2f(mOffsetLocation, static_cast<GLfloat>(column), static_cast<GLfloat>(row));
+        glUniform4f(mColorLocation, red, green, blue, 1.0f);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    GLuint mProgram;
+    GLint mPositionLocation;
+    GLint mOffsetLocation;
+    GLint mColorLocation;
+    GLuint mBuffer;
+};
+
+// Uniform changes between queued draws must apply to the draws in between
+TEST_F(DeferredContextTest, draw_results)
+{
+    drawQuarter(0, 0, 1.0f, 0.0f, 0.0f);
+    drawQuarter(1, 0, 0.0f, 1.0f, 0.0f);
+    drawQuarter(0, 1, 0.0f, 0.0f, 1.0f);
+    drawQuarter(1, 1, 1.0f, 1.0f, 0.0f);
+
+    EXPECT_PIXEL_EQ(32, 32, 255, 0, 0, 255);
+    EXPECT_PIXEL_EQ(96, 32, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(32, 96, 0, 0, 255, 255);
+    EXPECT_PIXEL_EQ(96, 96, 255, 255, 0, 255);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Queued and inline calls must execute in the order they were made
+TEST_F(DeferredContextTest, flush_and_finish_ordering)
+{
+    drawQuarter(0, 0, 1.0f, 0.0f, 0.0f);
+
+    // The buffer update must not overtake the draw above, so the second draw lands in the
+    // top right quarter only
+    const GLfloat vertices[] =
+    {
+        1.0f, 2.0f,
+        1.0f, 1.0f,
+        2.0f, 1.0f,
+
+        1.0f, 2.0f,
+        2.0f, 1.0f,
+        2.0f, 2.0f,
+    };
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    drawQuarter(-1, -1, 0.0f, 1.0f, 0.0f);
+    glFlush();
+
+    // Reading pixels executes inline, after everything queued before it
+    EXPECT_PIXEL_EQ(32, 32, 255, 0, 0, 255);
+    EXPECT_PIXEL_EQ(96, 96, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(96, 32, 0, 0, 0, 255);
+
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glFinish();
+
+    EXPECT_PIXEL_EQ(32, 32, 0, 0, 255, 255);
+    EXPECT_PIXEL_EQ(96, 96, 0, 0, 255, 255);
+
+    // A draw from client memory executes inline and must still follow the queued clear
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(mProgram);
+    glUniform2f(mOffsetLocation, 0.0f, 0.0f);
+    glUniform4f(mColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+    drawQuad(mProgram, "position", 0.5f);
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    glEnableVertexAttribArray(mPositionLocation);
+
+    EXPECT_PIXEL_EQ(64, 64, 255, 255, 255, 255);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Queued calls are validated when they execute, and their errors are reported by the next
+// glGetError without being lost or reported twice
+TEST_F(DeferredContextTest, deferred_errors)
+{
+    glEnable(GL_TEXTURE_2D);
+    drawQuarter(0, 0, 1.0f, 0.0f, 0.0f);
+
+    EXPECT_GL_ERROR(GL_INVALID_ENUM);
+    EXPECT_GL_NO_ERROR();
+
+    // The failed call must not have stopped the draw after it
+    EXPECT_PIXEL_EQ(32, 32, 255, 0, 0, 255);
+
+    glDrawArrays(GL_TRIANGLES, 0, -1);
+    drawQuarter(1, 1, 0.0f, 1.0f, 0.0f);
+    glFinish();
+
+    EXPECT_GL_ERROR(GL_INVALID_VALUE);
+    EXPECT_GL_NO_ERROR();
+    EXPECT_PIXEL_EQ(96, 96, 0, 255, 0, 255);
+}
+
+// Measures the frame time of many small draws, as queued by a UI. Compare a run with
+// --deferred-context against one without it. Disabled by default so regular runs stay fast;
+// run it with --gtest_also_run_disabled_tests.
+TEST_F(DeferredContextTest, DISABLED_frame_time)
+{
+    const int frameCount = 200;
+    const int drawsPerFrame = 200;
+
+    clock_t start = clock();
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (int draw = 0; draw < drawsPerFrame; draw++)
+        {
+            drawQuarter(draw % 2, (draw / 2) % 2, (draw % 7) / 7.0f, (frame % 5) / 5.0f, 1.0f);
+        }
+        swapBuffers();
+    }
+    glFinish();
+    clock_t end = clock();
+
+    EXPECT_GL_NO_ERROR();
+
+    double milliseconds = 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::cout << frameCount << " frames of " << drawsPerFrame << " draws: " << milliseconds / frameCount
+              << " ms per frame" << std::endl;
+}
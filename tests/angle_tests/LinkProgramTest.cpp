@@ -0,0 +1,92 @@
+#include "ANGLETest.h"
+
+#include <sstream>
+
+class LinkProgramTest : public ANGLETest
+{
+protected:
+    LinkProgramTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    // Every program shares the same varying layout, only the varying names and the arithmetic differ
+    std::string makeVertexShaderSource(const std::string &varyingName, int variant)
+    {
+        std::ostringstream stream;
+        stream << "attribute vec4 position;\n"
+                  "varying vec4 " << varyingName << ";\n"
+                  "void main()\n"
+                  "{\n"
+                  "    gl_Position = position;\n"
+                  "    " << varyingName << " = vec4(0.0, 1.0, 0.0, 1.0) * " << (variant + 1) << ".0 / " << (variant + 1) << ".0;\n"
+                  "}\n";
+        return stream.str();
+    }
+
+    std::string makeFragmentShaderSource(const std::string &varyingName)
+    {
+        return "precision mediump float;\n"
+               "varying vec4 " + varyingName + ";\n"
+               "void main()\n"
+               "{\n"
+               "    gl_FragColor = " + varyingName + ";\n"
+               "}\n";
+    }
+};
+
+TEST_F(LinkProgramTest, shared_interfaces_render_correctly)
+{
+    GLuint firstProgram = compileProgram(makeVertexShaderSource("v_color", 0), makeFragmentShaderSource("v_color"));
+    GLuint secondProgram = compileProgram(makeVertexShaderSource("v_other", 1), makeFragmentShaderSource("v_other"));
+    ASSERT_NE(firstProgram, 0u);
+    ASSERT_NE(secondProgram, 0u);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(firstProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(0, 0, 0, 255, 0, 255);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(secondProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(0, 0, 0, 255, 0, 255);
+
+    glDeleteProgram(firstProgram);
+    glDeleteProgram(secondProgram);
+}
+
+// Programs which share their varyings but differ in the built-ins they use must not share generated HLSL
+TEST_F(LinkProgramTest, shared_varyings_different_builtins)
+{
+    const std::string fragCoordSource =
+        "precision mediump float;\n"
+        "varying vec4 v_color;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = v_color * step(0.0, gl_FragCoord.x);\n"
+        "}\n";
+
+    GLuint plainProgram = compileProgram(makeVertexShaderSource("v_color", 0), makeFragmentShaderSource("v_color"));
+    GLuint fragCoordProgram = compileProgram(makeVertexShaderSource("v_color", 0), fragCoordSource);
+    ASSERT_NE(plainProgram, 0u);
+    ASSERT_NE(fragCoordProgram, 0u);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(fragCoordProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(0, 0, 0, 255, 0, 255);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(plainProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(0, 0, 0, 255, 0, 255);
+
+    glDeleteProgram(plainProgram);
+    glDeleteProgram(fragCoordProgram);
+}
@@ -0,0 +1,163 @@
+#include "ANGLETest.h"
+
+class ProfileCountersTest : public ANGLETest
+{
+protected:
+    ProfileCountersTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        const std::string vertexShaderSource = SHADER_SOURCE
+        (
+            attribute vec4 position;
+            void main()
+            {
+                gl_Position = position;
+            }
+        );
+
+        const std::string fragmentShaderSource = SHADER_SOURCE
+        (
+            precision mediump float;
+            uniform vec4 u_color;
+            void main()
+            {
+                gl_FragColor = u_color;
+            }
+        );
+
+        mProgram = compileProgram(vertexShaderSource, fragmentShaderSource);
+        if (mProgram == 0)
+        {
+            FAIL() << "shader compilation failed.";
+        }
+
+        mColorLocation = glGetUniformLocation(mProgram, "u_color");
+    }
+
+    virtual void TearDown()
+    {
+        glDeleteProgram(mProgram);
+
+        ANGLETest::TearDown();
+    }
+
+    void drawRed()
+    {
+        glUseProgram(mProgram);
+        glUniform4f(mColorLocation, 1.0f, 0.0f, 0.0f, 1.0f);
+        drawQuad(mProgram, "position", 0.5f);
+    }
+
+    GLuint mProgram;
+    GLint mColorLocation;
+};
+
+static const GLenum ProfileStages[] =
+{
+    GL_PROFILE_VALIDATION_ANGLE,
+    GL_PROFILE_APPLY_STATE_ANGLE,
+    GL_PROFILE_VERTEX_DATA_ANGLE,
+    GL_PROFILE_INDEX_DATA_ANGLE,
+    GL_PROFILE_APPLY_UNIFORMS_ANGLE,
+    GL_PROFILE_TEXTURE_LOAD_ANGLE,
+    GL_PROFILE_REDUNDANT_STATE_ANGLE,
+};
+
+TEST_F(ProfileCountersTest, draw_read_and_reset)
+{
+    if (!extensionEnabled("GL_ANGLE_profile_counters"))
+    {
+        return;
+    }
+
+    // Resetting also turns counting on
+    glResetProfileCountersANGLE();
+
+    drawRed();
+    EXPECT_PIXEL_EQ(64, 64, 255, 0, 0, 255);
+
+    GLuint64 counters[3] = { 0, 0, 0 };
+    glGetProfileCountersANGLE(GL_PROFILE_VALIDATION_ANGLE, counters);
+    EXPECT_GE(counters[0], 1u);
+
+    glGetProfileCountersANGLE(GL_PROFILE_APPLY_STATE_ANGLE, counters);
+    EXPECT_EQ(1u, counters[0]);
+
+    // The quad comes from a client side array, so its six positions are streamed
+    glGetProfileCountersANGLE(GL_PROFILE_VERTEX_DATA_ANGLE, counters);
+    EXPECT_EQ(1u, counters[0]);
+    EXPECT_GE(counters[2], 6 * 3 * sizeof(GLfloat));
+
+    glGetProfileCountersANGLE(GL_PROFILE_APPLY_UNIFORMS_ANGLE, counters);
+    EXPECT_EQ(1u, counters[0]);
+
+    // No indices or textures were used
+    glGetProfileCountersANGLE(GL_PROFILE_INDEX_DATA_ANGLE, counters);
+    EXPECT_EQ(0u, counters[0]);
+    glGetProfileCountersANGLE(GL_PROFILE_TEXTURE_LOAD_ANGLE, counters);
+    EXPECT_EQ(0u, counters[0]);
+
+    EXPECT_GL_NO_ERROR();
+
+    glResetProfileCountersANGLE();
+
+    for (size_t stage = 0; stage < sizeof(ProfileStages) / sizeof(ProfileStages[0]); stage++)
+    {
+        GLuint64 resetCounters[3] = { 1, 1, 1 };
+        glGetProfileCountersANGLE(ProfileStages[stage], resetCounters);
+        EXPECT_EQ(0u, resetCounters[0]);
+        EXPECT_EQ(0u, resetCounters[1]);
+        EXPECT_EQ(0u, resetCounters[2]);
+    }
+
+    EXPECT_GL_NO_ERROR();
+}
+
+TEST_F(ProfileCountersTest, counts_redundant_state)
+{
+    if (!extensionEnabled("GL_ANGLE_profile_counters"))
+    {
+        return;
+    }
+
+    glResetProfileCountersANGLE();
+
+    // Blending starts out disabled
+    glDisable(GL_BLEND);
+    glEnable(GL_BLEND);
+    glEnable(GL_BLEND);
+    glDisable(GL_BLEND);
+
+    GLuint64 counters[3] = { 0, 0, 0 };
+    glGetProfileCountersANGLE(GL_PROFILE_REDUNDANT_STATE_ANGLE, counters);
+    EXPECT_EQ(2u, counters[0]);
+    EXPECT_EQ(0u, counters[1]);
+
+    // The dropped changes must not affect rendering
+    drawRed();
+    EXPECT_PIXEL_EQ(64, 64, 255, 0, 0, 255);
+}
+
+TEST_F(ProfileCountersTest, unknown_stage)
+{
+    if (!extensionEnabled("GL_ANGLE_profile_counters"))
+    {
+        return;
+    }
+
+    GLuint64 counters[3] = { 7, 7, 7 };
+    glGetProfileCountersANGLE(GL_TEXTURE_2D, counters);
+    EXPECT_GL_ERROR(GL_INVALID_ENUM);
+    EXPECT_EQ(7u, counters[0]);
+}
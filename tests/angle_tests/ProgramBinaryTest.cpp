@@ -0,0 +1,176 @@
+#include "ANGLETest.h"
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+class ProgramBinaryTest : public ANGLETest
+{
+protected:
+    ProgramBinaryTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        mVertexShaderSource = SHADER_SOURCE
+        (
+            attribute vec4 position;
+            void main()
+            {
+                gl_Position = position;
+            }
+        );
+    }
+
+    // Builds a fragment shader with a distinct set of uniforms so every program has its own binary
+    std::string makeFragmentShaderSource(int uniformCount)
+    {
+        std::ostringstream stream;
+        stream << "precision mediump float;\n";
+        for (int uniformIndex = 0; uniformIndex < uniformCount; uniformIndex++)
+        {
+            stream << "uniform vec4 color" << uniformIndex << ";\n";
+        }
+        stream << "void main()\n{\n    gl_FragColor = vec4(0.0, 1.0, 0.0, 1.0)";
+        for (int uniformIndex = 0; uniformIndex < uniformCount; uniformIndex++)
+        {
+            stream << " + color" << uniformIndex;
+        }
+        stream << ";\n}\n";
+        return stream.str();
+    }
+
+    bool getBinary(GLuint program, GLenum *format, std::vector<GLubyte> *binary)
+    {
+        GLint binaryLength = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &binaryLength);
+        if (binaryLength <= 0)
+        {
+            return false;
+        }
+
+        binary->resize(binaryLength);
+        glGetProgramBinaryOES(program, binaryLength, NULL, format, binary->data());
+        return glGetError() == GL_NO_ERROR;
+    }
+
+    std::string mVertexShaderSource;
+};
+
+TEST_F(ProgramBinaryTest, save_and_reload)
+{
+    if (!extensionEnabled("GL_OES_get_program_binary"))
+    {
+        return;
+    }
+
+    GLuint program = compileProgram(mVertexShaderSource, makeFragmentShaderSource(2));
+    ASSERT_NE(program, 0u);
+
+    GLenum binaryFormat = GL_NONE;
+    std::vector<GLubyte> binary;
+    ASSERT_TRUE(getBinary(program, &binaryFormat, &binary));
+
+    GLuint reloadedProgram = glCreateProgram();
+    glProgramBinaryOES(reloadedProgram, binaryFormat, binary.data(), binary.size());
+    EXPECT_GL_NO_ERROR();
+
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(reloadedProgram, GL_LINK_STATUS, &linkStatus);
+    EXPECT_EQ(GL_TRUE, linkStatus);
+
+    EXPECT_EQ(glGetUniformLocation(program, "color1"), glGetUniformLocation(reloadedProgram, "color1"));
+
+    glUseProgram(reloadedProgram);
+    glUniform4f(glGetUniformLocation(reloadedProgram, "color0"), 1.0f, 0.0f, 0.0f, 0.0f);
+    glUniform4f(glGetUniformLocation(reloadedProgram, "color1"), 0.0f, 0.0f, 1.0f, 0.0f);
+    drawQuad(reloadedProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(0, 0, 255, 255, 255, 255);
+
+    glDeleteProgram(reloadedProgram);
+    glDeleteProgram(program);
+}
+
+TEST_F(ProgramBinaryTest, corrupted_binary_fails_to_load)
+{
+    if (!extensionEnabled("GL_OES_get_program_binary"))
+    {
+        return;
+    }
+
+    GLuint program = compileProgram(mVertexShaderSource, makeFragmentShaderSource(1));
+    ASSERT_NE(program, 0u);
+
+    GLenum binaryFormat = GL_NONE;
+    std::vector<GLubyte> binary;
+    ASSERT_TRUE(getBinary(program, &binaryFormat, &binary));
+
+    binary[binary.size() - 1] ^= 0xFF;
+
+    GLuint reloadedProgram = glCreateProgram();
+    glProgramBinaryOES(reloadedProgram, binaryFormat, binary.data(), binary.size());
+
+    GLint linkStatus = GL_TRUE;
+    glGetProgramiv(reloadedProgram, GL_LINK_STATUS, &linkStatus);
+    EXPECT_EQ(GL_FALSE, linkStatus);
+
+    glDeleteProgram(reloadedProgram);
+    glDeleteProgram(program);
+}
+
+// Measures the time spent reloading a large set of cached programs, as an application would at startup.
+// Disabled by default so regular runs stay fast; run it with --gtest_also_run_disabled_tests.
+TEST_F(ProgramBinaryTest, DISABLED_load_many_programs)
+{
+    if (!extensionEnabled("GL_OES_get_program_binary"))
+    {
+        return;
+    }
+
+    const int programCount = 256;
+
+    std::vector<GLenum> formats(programCount);
+    std::vector<std::vector<GLubyte> > binaries(programCount);
+    for (int programIndex = 0; programIndex < programCount; programIndex++)
+    {
+        GLuint program = compileProgram(mVertexShaderSource, makeFragmentShaderSource(1 + programIndex % 16));
+        ASSERT_NE(program, 0u);
+        ASSERT_TRUE(getBinary(program, &formats[programIndex], &binaries[programIndex]));
+        glDeleteProgram(program);
+    }
+
+    std::vector<GLuint> programs(programCount);
+    for (int programIndex = 0; programIndex < programCount; programIndex++)
+    {
+        programs[programIndex] = glCreateProgram();
+    }
+
+    clock_t start = clock();
+    for (int programIndex = 0; programIndex < programCount; programIndex++)
+    {
+        const std::vector<GLubyte> &binary = binaries[programIndex];
+        glProgramBinaryOES(programs[programIndex], formats[programIndex], binary.data(), binary.size());
+    }
+    clock_t end = clock();
+
+    for (int programIndex = 0; programIndex < programCount; programIndex++)
+    {
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(programs[programIndex], GL_LINK_STATUS, &linkStatus);
+        EXPECT_EQ(GL_TRUE, linkStatus);
+        glDeleteProgram(programs[programIndex]);
+    }
+
+    double milliseconds = 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::cout << "Loaded " << programCount << " program binaries in " << milliseconds << " ms" << std::endl;
+}
@@ -0,0 +1,181 @@
+#include "ANGLETest.h"
+
+#include <vector>
+
+// Textures cache whether they were complete for the state they were last sampled with, so these
+// tests change that state between draws and check that each draw samples accordingly
+class TextureCompletenessTest : public ANGLETest
+{
+protected:
+    TextureCompletenessTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        const std::string vertexShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            attribute vec4 position;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_Position = position;
+                texcoord = (position.xy * 0.5) + 0.5;
+            }
+        );
+
+        const std::string fragmentShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            uniform sampler2D tex;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_FragColor = texture2D(tex, texcoord);
+            }
+        );
+
+        mProgram = compileProgram(vertexShaderSource, fragmentShaderSource);
+        if (mProgram == 0)
+        {
+            FAIL() << "shader compilation failed.";
+        }
+
+        glUseProgram(mProgram);
+        glUniform1i(glGetUniformLocation(mProgram, "tex"), 0);
+
+        glGenTextures(1, &mTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    virtual void TearDown()
+    {
+        glDeleteTextures(1, &mTexture);
+        glDeleteProgram(mProgram);
+
+        ANGLETest::TearDown();
+    }
+
+    void defineRedLevel(GLint level, GLsizei width, GLsizei height)
+    {
+        std::vector<GLubyte> data(width * height * 4, 0);
+        for (size_t i = 0; i < data.size(); i += 4)
+        {
+            data[i + 0] = 255;
+            data[i + 3] = 255;
+        }
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
+    }
+
+    // The texture is magnified, so only the base level is sampled once it is complete.
+    // Incomplete textures sample as opaque black.
+    void expectSampled(bool complete)
+    {
+        drawQuad(mProgram, "position", 0.5f);
+        if (complete)
+        {
+            EXPECT_PIXEL_EQ(64, 64, 255, 0, 0, 255);
+        }
+        else
+        {
+            EXPECT_PIXEL_EQ(64, 64, 0, 0, 0, 255);
+        }
+    }
+
+    GLuint mProgram;
+    GLuint mTexture;
+};
+
+TEST_F(TextureCompletenessTest, filter_changes_between_draws)
+{
+    defineRedLevel(0, 16, 16);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    expectSampled(true);
+    expectSampled(true);
+
+    // Without the other levels, a mipmapped filter makes the texture incomplete
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    expectSampled(false);
+    expectSampled(false);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    expectSampled(true);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    expectSampled(false);
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+    expectSampled(true);
+
+    EXPECT_GL_NO_ERROR();
+}
+
+TEST_F(TextureCompletenessTest, wrap_changes_between_draws)
+{
+    // Without GL_OES_texture_npot, repeating a texture whose size is not a power of two makes it
+    // incomplete
+    const bool npotRepeat = extensionEnabled("GL_OES_texture_npot");
+
+    defineRedLevel(0, 12, 12);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    expectSampled(true);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    expectSampled(npotRepeat);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    expectSampled(true);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+    expectSampled(npotRepeat);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    expectSampled(true);
+
+    EXPECT_GL_NO_ERROR();
+}
+
+TEST_F(TextureCompletenessTest, level_changes_between_draws)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+
+    defineRedLevel(0, 4, 4);
+    defineRedLevel(1, 2, 2);
+    expectSampled(false);
+
+    defineRedLevel(2, 1, 1);
+    expectSampled(true);
+    expectSampled(true);
+
+    // A level of the wrong size breaks the chain, and the right size repairs it
+    defineRedLevel(1, 1, 1);
+    expectSampled(false);
+
+    defineRedLevel(1, 2, 2);
+    expectSampled(true);
+
+    // Redefining the base level with another size leaves the other levels mismatched
+    defineRedLevel(0, 8, 8);
+    expectSampled(false);
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+    expectSampled(true);
+
+    EXPECT_GL_NO_ERROR();
+}
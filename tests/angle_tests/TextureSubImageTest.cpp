@@ -0,0 +1,184 @@
+#include "ANGLETest.h"
+
+#include <vector>
+
+class TextureSubImageTest : public ANGLETest
+{
+protected:
+    TextureSubImageTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    virtual void SetUp()
+    {
+        ANGLETest::SetUp();
+
+        const std::string vertexShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            attribute vec4 position;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_Position = position;
+                texcoord = (position.xy * 0.5) + 0.5;
+            }
+        );
+
+        const std::string fragmentShaderSource = SHADER_SOURCE
+        (
+            precision highp float;
+            uniform sampler2D tex;
+            varying vec2 texcoord;
+
+            void main()
+            {
+                gl_FragColor = texture2D(tex, texcoord);
+            }
+        );
+
+        mProgram = compileProgram(vertexShaderSource, fragmentShaderSource);
+        if (mProgram == 0)
+        {
+            FAIL() << "shader compilation failed.";
+        }
+
+        mTextureUniformLocation = glGetUniformLocation(mProgram, "tex");
+    }
+
+    virtual void TearDown()
+    {
+        glDeleteProgram(mProgram);
+
+        ANGLETest::TearDown();
+    }
+
+    std::vector<GLubyte> makeTextureData(GLsizei width, GLsizei height, GLubyte r, GLubyte g, GLubyte b, GLubyte a)
+    {
+        std::vector<GLubyte> buffer(width * height * 4);
+        for (size_t i = 0; i < buffer.size() / 4; i++)
+        {
+            buffer[i * 4 + 0] = r;
+            buffer[i * 4 + 1] = g;
+            buffer[i * 4 + 2] = b;
+            buffer[i * 4 + 3] = a;
+        }
+        return buffer;
+    }
+
+    GLuint mProgram;
+    GLint mTextureUniformLocation;
+};
+
+// Several disjoint updates made while the texture is incomplete must all reach the storage
+TEST_F(TextureSubImageTest, disjoint_updates_before_sampling)
+{
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glUseProgram(mProgram);
+    glUniform1i(mTextureUniformLocation, 0);
+
+    const GLsizei textureSize = 128;
+    std::vector<GLubyte> redData = makeTextureData(textureSize, textureSize, 255, 0, 0, 255);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureSize, textureSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, redData.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(64, 64, 255, 0, 0, 255);
+
+    // Redefining a mip level with the wrong size makes the mipmapped texture incomplete,
+    // so the updates stay in the images
+    glTexImage2D(GL_TEXTURE_2D, 1, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, redData.data());
+
+    std::vector<GLubyte> greenData = makeTextureData(16, 16, 0, 255, 0, 255);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 16, 16, GL_RGBA, GL_UNSIGNED_BYTE, greenData.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 112, 112, 16, 16, GL_RGBA, GL_UNSIGNED_BYTE, greenData.data());
+
+    std::vector<GLubyte> blueData = makeTextureData(16, 16, 0, 0, 255, 255);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 112, 16, 16, GL_RGBA, GL_UNSIGNED_BYTE, blueData.data());
+
+    // Incomplete textures sample as opaque black
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(8, 8, 0, 0, 0, 255);
+    EXPECT_PIXEL_EQ(64, 64, 0, 0, 0, 255);
+
+    // Sampling only the base level makes the texture complete again
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    drawQuad(mProgram, "position", 0.5f);
+    EXPECT_PIXEL_EQ(8, 8, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(120, 120, 0, 255, 0, 255);
+    EXPECT_PIXEL_EQ(8, 120, 0, 0, 255, 255);
+    EXPECT_PIXEL_EQ(64, 64, 255, 0, 0, 255);
+    EXPECT_PIXEL_EQ(120, 8, 255, 0, 0, 255);
+
+    glDeleteTextures(1, &tex);
+}
+
+// Small updates to an atlas between draws, as made by video and UI rendering, must each be
+// visible in the next draw, including when a slot is overwritten
+TEST_F(TextureSubImageTest, atlas_updates)
+{
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glUseProgram(mProgram);
+    glUniform1i(mTextureUniformLocation, 0);
+
+    // The atlas matches the window, so each texel covers one pixel
+    const GLsizei atlasSize = 128;
+    const GLsizei glyphSize = 16;
+    const int slotsPerRow = atlasSize / glyphSize;
+    const int slotCount = slotsPerRow * slotsPerRow;
+    const int frameCount = 24;
+    const int updatesPerFrame = 8;
+
+    std::vector<GLubyte> atlasData = makeTextureData(atlasSize, atlasSize, 0, 0, 0, 255);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlasSize, atlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlasData.data());
+
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        // Frames after the first pass over the atlas overwrite slots drawn from before
+        for (int update = 0; update < updatesPerFrame; update++)
+        {
+            int slot = (frame * updatesPerFrame + update) % slotCount;
+            std::vector<GLubyte> glyphData = makeTextureData(glyphSize, glyphSize, frame * 10, update * 30, 255, 255);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, (slot % slotsPerRow) * glyphSize, (slot / slotsPerRow) * glyphSize,
+                            glyphSize, glyphSize, GL_RGBA, GL_UNSIGNED_BYTE, glyphData.data());
+        }
+
+        drawQuad(mProgram, "position", 0.5f);
+
+        for (int update = 0; update < updatesPerFrame; update++)
+        {
+            int slot = (frame * updatesPerFrame + update) % slotCount;
+            EXPECT_PIXEL_EQ((slot % slotsPerRow) * glyphSize + glyphSize / 2, (slot / slotsPerRow) * glyphSize + glyphSize / 2,
+                            frame * 10, update * 30, 255, 255);
+        }
+    }
+
+    // The first slot of the second to last frame was not overwritten by the last one
+    int slot = ((frameCount - 2) * updatesPerFrame) % slotCount;
+    EXPECT_PIXEL_EQ((slot % slotsPerRow) * glyphSize + glyphSize / 2, (slot / slotsPerRow) * glyphSize + glyphSize / 2,
+                    (frameCount - 2) * 10, 0, 255, 255);
+
+    EXPECT_GL_NO_ERROR();
+
+    glDeleteTextures(1, &tex);
+}
@@ -8,9 +8,26 @@
 #include "gtest/gtest.h"
 #include "ANGLETest.h"
 
+#include <string.h>
+#include <windows.h>
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleMock(&argc, argv);
+
+    // The libraries are delay loaded, so this takes effect before they first read the environment
+    for (int argument = 1; argument < argc; argument++)
+    {
+        if (strcmp(argv[argument], "--deferred-context") == 0)
+        {
+            SetEnvironmentVariableA("ANGLE_DEFERRED_CONTEXT", "1");
+        }
+        else if (strcmp(argv[argument], "--async-texture-upload") == 0)
+        {
+            SetEnvironmentVariableA("ANGLE_ASYNC_TEXTURE_UPLOAD", "0");
+        }
+    }
+
     testing::AddGlobalTestEnvironment(new ANGLETestEnvironment());
     int rt = RUN_ALL_TESTS();
     return rt;
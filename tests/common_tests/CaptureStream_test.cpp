@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CaptureStream_test.cpp:
+//   Tests that GL calls encoded by gl::CaptureEncoder replay with the same arguments.
+//
+
+#include <string>
+#include <vector>
+#include "libGLESv2/CaptureDecoder.h"
+#include "libGLESv2/CaptureEncoder.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+struct ReplayedCall
+{
+    GLint location;
+    GLfloat x;
+    std::vector<GLfloat> values;
+    std::vector<std::string> sources;
+    const GLvoid *offset;
+    bool lengthsNull;
+};
+
+ReplayedCall g_replayed;
+
+void GL_APIENTRY FakeUniform1f(GLint location, GLfloat x)
+{
+    g_replayed.location = location;
+    g_replayed.x = x;
+}
+
+void GL_APIENTRY FakeUniform4fv(GLint location, GLsizei count, const GLfloat *v)
+{
+    g_replayed.location = location;
+    g_replayed.values.assign(v, v + count * 4);
+}
+
+void GL_APIENTRY FakeShaderSource(GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length)
+{
+    g_replayed.sources.clear();
+    for (GLsizei index = 0; index < count; index++)
+    {
+        g_replayed.sources.push_back(string[index]);
+    }
+    g_replayed.lengthsNull = (length == NULL);
+}
+
+void GL_APIENTRY FakeDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
+{
+    g_replayed.offset = indices;
+}
+
+void GL_APIENTRY FakeGenBuffers(GLsizei n, GLuint *buffers)
+{
+    // Writes to the memory replay provides for outputs
+    for (GLsizei index = 0; index < n; index++)
+    {
+        buffers[index] = index + 1;
+    }
+}
+
+GLenum GL_APIENTRY FakeGetError()
+{
+    return GL_NO_ERROR;
+}
+
+class CaptureStreamTest : public testing::Test
+{
+  protected:
+    void openStream()
+    {
+        gl::CaptureFileHeader header = { gl::CaptureMagic, gl::CaptureVersion, 2, 0 };
+        mStream.assign(reinterpret_cast<const unsigned char*>(&header), reinterpret_cast<const unsigned char*>(&header + 1));
+        mStream.insert(mStream.end(), mEncoder.getData().begin(), mEncoder.getData().end());
+        ASSERT_TRUE(mDecoder.open(&mStream[0], mStream.size()));
+    }
+
+    gl::CaptureEncoder mEncoder;
+    gl::CaptureDecoder mDecoder;
+    std::vector<unsigned char> mStream;
+};
+
+}
+
+TEST_F(CaptureStreamTest, ScalarArguments)
+{
+    mEncoder.call(gl::CAPTURE_CALL_glUniform1f, GLint(-3), GLfloat(0.25f));
+    mEncoder.call(gl::CAPTURE_CALL_glGetError);
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    EXPECT_EQ(gl::CAPTURE_CALL_glUniform1f, mDecoder.getCallId());
+    ASSERT_TRUE(gl::ReplayCall(FakeUniform1f, &mDecoder));
+    EXPECT_EQ(-3, g_replayed.location);
+    EXPECT_EQ(0.25f, g_replayed.x);
+
+    ASSERT_TRUE(mDecoder.next());
+    EXPECT_EQ(gl::CAPTURE_CALL_glGetError, mDecoder.getCallId());
+    EXPECT_TRUE(gl::ReplayCall(FakeGetError, &mDecoder));
+
+    EXPECT_FALSE(mDecoder.next());
+    EXPECT_FALSE(mDecoder.isMalformed());
+}
+
+TEST_F(CaptureStreamTest, ClientMemoryIsCopied)
+{
+    GLfloat values[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    mEncoder.call(gl::CAPTURE_CALL_glUniform4fv, GLint(5), GLsizei(2), gl::CaptureArray(values, 8));
+
+    // The application may reuse its memory as soon as the call returns
+    values[0] = 100;
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeUniform4fv, &mDecoder));
+    ASSERT_EQ(8u, g_replayed.values.size());
+    EXPECT_EQ(1.0f, g_replayed.values[0]);
+    EXPECT_EQ(8.0f, g_replayed.values[7]);
+}
+
+TEST_F(CaptureStreamTest, Strings)
+{
+    const GLchar *sources[] = { "void main()", "{ gl_FragColor = vec4(1.0); }xyz" };
+    const GLint lengths[] = { -1, 29 };
+    mEncoder.call(gl::CAPTURE_CALL_glShaderSource, GLuint(1), GLsizei(2), gl::CaptureStrings(2, sources, lengths), gl::CaptureMemory(NULL, 0));
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeShaderSource, &mDecoder));
+    ASSERT_EQ(2u, g_replayed.sources.size());
+    EXPECT_EQ("void main()", g_replayed.sources[0]);
+    EXPECT_EQ("{ gl_FragColor = vec4(1.0); }", g_replayed.sources[1]);
+    EXPECT_TRUE(g_replayed.lengthsNull);
+}
+
+TEST_F(CaptureStreamTest, OffsetsAndOutputs)
+{
+    mEncoder.call(gl::CAPTURE_CALL_glDrawElements, GLenum(GL_TRIANGLES), GLsizei(6), GLenum(GL_UNSIGNED_SHORT), gl::CaptureOffset(reinterpret_cast<const GLvoid*>(12)));
+
+    GLuint buffers[3];
+    mEncoder.call(gl::CAPTURE_CALL_glGenBuffers, GLsizei(3), gl::CaptureOutput(buffers, sizeof(buffers)));
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeDrawElements, &mDecoder));
+    EXPECT_EQ(reinterpret_cast<const GLvoid*>(12), g_replayed.offset);
+
+    ASSERT_TRUE(mDecoder.next());
+    EXPECT_TRUE(gl::ReplayCall(FakeGenBuffers, &mDecoder));
+}
+
+TEST_F(CaptureStreamTest, ArgumentCountMismatch)
+{
+    mEncoder.call(gl::CAPTURE_CALL_glUniform1f, GLint(1));
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    EXPECT_FALSE(gl::ReplayCall(FakeUniform1f, &mDecoder));
+}
+
+TEST_F(CaptureStreamTest, TruncatedStream)
+{
+    GLfloat values[4] = { 1, 2, 3, 4 };
+    mEncoder.call(gl::CAPTURE_CALL_glUniform1f, GLint(1), GLfloat(1.0f));
+    mEncoder.call(gl::CAPTURE_CALL_glUniform4fv, GLint(5), GLsizei(1), gl::CaptureArray(values, 4));
+    openStream();
+
+    mStream.resize(mStream.size() - 8);
+    ASSERT_TRUE(mDecoder.open(&mStream[0], mStream.size()));
+
+    EXPECT_TRUE(mDecoder.next());
+    EXPECT_FALSE(mDecoder.next());
+    EXPECT_TRUE(mDecoder.isMalformed());
+}
+
+TEST_F(CaptureStreamTest, DeferredClientMemoryIsReadOnCommit)
+{
+    mEncoder.setDeferClientMemory(true);
+
+    GLfloat values[4] = { 1, 2, 3, 4 };
+    const GLchar *sources[] = { "void main() {}" };
+    mEncoder.call(gl::CAPTURE_CALL_glUniform4fv, GLint(5), GLsizei(1), gl::CaptureArray(values, 4));
+    mEncoder.call(gl::CAPTURE_CALL_glShaderSource, GLuint(1), GLsizei(1), gl::CaptureStrings(1, sources, NULL), gl::CaptureMemory(NULL, 0));
+    mEncoder.call(gl::CAPTURE_CALL_glUniform1f, GLint(-3), GLfloat(0.25f));
+
+    // Memory is only read once the calls are known to be valid
+    values[0] = 100;
+    mEncoder.commit();
+    values[1] = 200;
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeUniform4fv, &mDecoder));
+    ASSERT_EQ(4u, g_replayed.values.size());
+    EXPECT_EQ(100.0f, g_replayed.values[0]);
+    EXPECT_EQ(2.0f, g_replayed.values[1]);
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeShaderSource, &mDecoder));
+    ASSERT_EQ(1u, g_replayed.sources.size());
+    EXPECT_EQ("void main() {}", g_replayed.sources[0]);
+
+    ASSERT_TRUE(mDecoder.next());
+    ASSERT_TRUE(gl::ReplayCall(FakeUniform1f, &mDecoder));
+    EXPECT_EQ(-3, g_replayed.location);
+
+    EXPECT_FALSE(mDecoder.next());
+    EXPECT_FALSE(mDecoder.isMalformed());
+}
+
+TEST_F(CaptureStreamTest, RolledBackCallsAreDropped)
+{
+    mEncoder.setDeferClientMemory(true);
+    mEncoder.call(gl::CAPTURE_CALL_glUniform1f, GLint(1), GLfloat(1.0f));
+    mEncoder.commit();
+
+    // The pixels of an invalid upload are never read
+    size_t validSize = mEncoder.getData().size();
+    mEncoder.call(gl::CAPTURE_CALL_glUniform4fv, GLint(5), GLsizei(1), gl::CaptureMemory(reinterpret_cast<const void*>(16), 1 << 30));
+    mEncoder.rollback(validSize);
+    mEncoder.commit();
+    openStream();
+
+    ASSERT_TRUE(mDecoder.next());
+    EXPECT_EQ(gl::CAPTURE_CALL_glUniform1f, mDecoder.getCallId());
+    EXPECT_FALSE(mDecoder.next());
+    EXPECT_FALSE(mDecoder.isMalformed());
+}
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DirtyRegion_test.cpp:
+//   Tests the coalescing of the dirty boxes images use to limit copies to texture storage.
+//
+
+#include "libGLESv2/renderer/DirtyRegion.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+unsigned long long TotalVolume(const rx::DirtyRegion &region)
+{
+    unsigned long long total = 0;
+    for (size_t index = 0; index < region.getBoxes().size(); index++)
+    {
+        total += rx::DirtyRegion::volume(region.getBoxes()[index]);
+    }
+    return total;
+}
+
+}
+
+TEST(DirtyRegionTest, DisjointBoxesStaySeparate)
+{
+    rx::DirtyRegion region;
+    EXPECT_TRUE(region.empty());
+
+    region.add(gl::Box(0, 0, 0, 16, 16, 1));
+    region.add(gl::Box(100, 100, 0, 16, 16, 1));
+    ASSERT_EQ(2u, region.getBoxes().size());
+    EXPECT_EQ(512u, TotalVolume(region));
+
+    // Empty boxes are ignored
+    region.add(gl::Box(50, 50, 0, 0, 16, 1));
+    EXPECT_EQ(2u, region.getBoxes().size());
+}
+
+TEST(DirtyRegionTest, AdjacentAndContainedBoxesMerge)
+{
+    rx::DirtyRegion region;
+    region.add(gl::Box(0, 0, 0, 16, 16, 1));
+    region.add(gl::Box(16, 0, 0, 16, 16, 1));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(32, region.getBoxes()[0].width);
+    EXPECT_EQ(16, region.getBoxes()[0].height);
+
+    region.add(gl::Box(4, 4, 0, 8, 8, 1));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(512u, TotalVolume(region));
+
+    // A box covering everything replaces the smaller ones
+    region.add(gl::Box(100, 100, 0, 8, 8, 1));
+    region.add(gl::Box(0, 0, 0, 256, 256, 1));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(256, region.getBoxes()[0].width);
+}
+
+TEST(DirtyRegionTest, MergingCascades)
+{
+    // The third box bridges the first two, after which all three form one row
+    rx::DirtyRegion region;
+    region.add(gl::Box(0, 0, 0, 8, 8, 1));
+    region.add(gl::Box(16, 0, 0, 8, 8, 1));
+    EXPECT_EQ(2u, region.getBoxes().size());
+
+    region.add(gl::Box(8, 0, 0, 8, 8, 1));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(24, region.getBoxes()[0].width);
+}
+
+TEST(DirtyRegionTest, BoxCountIsBounded)
+{
+    rx::DirtyRegion region;
+    for (int index = 0; index < 64; index++)
+    {
+        region.add(gl::Box((index % 8) * 128, (index / 8) * 128, 0, 4, 4, 1));
+    }
+
+    EXPECT_LE(region.getBoxes().size(), 8u);
+
+    // Every added box is still covered
+    for (int index = 0; index < 64; index++)
+    {
+        int x = (index % 8) * 128;
+        int y = (index / 8) * 128;
+
+        bool covered = false;
+        for (size_t boxIndex = 0; boxIndex < region.getBoxes().size(); boxIndex++)
+        {
+            const gl::Box &box = region.getBoxes()[boxIndex];
+            covered = covered || (x >= box.x && x + 4 <= box.x + box.width && y >= box.y && y + 4 <= box.y + box.height);
+        }
+        EXPECT_TRUE(covered);
+    }
+}
+
+TEST(DirtyRegionTest, RemoveDropsCoveredBoxes)
+{
+    rx::DirtyRegion region;
+    region.add(gl::Box(0, 0, 0, 16, 16, 1));
+    region.add(gl::Box(64, 64, 0, 16, 16, 1));
+
+    // Partial overlap leaves the box dirty
+    region.remove(gl::Box(0, 0, 0, 8, 8, 1));
+    EXPECT_EQ(2u, region.getBoxes().size());
+
+    region.remove(gl::Box(0, 0, 0, 16, 16, 1));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(64, region.getBoxes()[0].x);
+
+    region.remove(gl::Box(0, 0, 0, 128, 128, 1));
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(DirtyRegionTest, VolumesAreThreeDimensional)
+{
+    rx::DirtyRegion region;
+    region.add(gl::Box(0, 0, 0, 8, 8, 4));
+    region.add(gl::Box(0, 0, 4, 8, 8, 4));
+    ASSERT_EQ(1u, region.getBoxes().size());
+    EXPECT_EQ(8, region.getBoxes()[0].depth);
+    EXPECT_EQ(512u, TotalVolume(region));
+}
+
+// Models a glyph atlas which receives a few small updates per frame and compares the texels
+// copied to storage with the whole level copies made before images tracked dirty boxes
+TEST(DirtyRegionTest, AtlasUpdateTraffic)
+{
+    const int atlasSize = 2048;
+    const int frames = 100;
+    const int updatesPerFrame = 6;
+
+    unsigned long long dirtiedTexels = 0;
+    unsigned long long copiedTexels = 0;
+    unsigned int seed = 1;
+
+    rx::DirtyRegion region;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int update = 0; update < updatesPerFrame; update++)
+        {
+            seed = seed * 1103515245 + 12345;
+            gl::Box glyph((seed >> 8) % (atlasSize - 32), (seed >> 18) % (atlasSize - 32), 0, 32, 32, 1);
+            region.add(glyph);
+            dirtiedTexels += rx::DirtyRegion::volume(glyph);
+        }
+
+        copiedTexels += TotalVolume(region);
+        region.clear();
+    }
+
+    unsigned long long wholeLevelTexels = static_cast<unsigned long long>(atlasSize) * atlasSize * frames;
+    EXPECT_LT(copiedTexels, wholeLevelTexels / 16);
+    EXPECT_GE(copiedTexels, dirtiedTexels / 2);
+}
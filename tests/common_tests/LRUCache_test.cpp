@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LRUCache_test.cpp:
+//   Tests the gl::LRUCache template shared by the renderer state and shader caches.
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common/LRUCache.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+std::vector<int> g_releasedValues;
+
+void RecordRelease(int &value)
+{
+    g_releasedValues.push_back(value);
+}
+
+struct StateKey
+{
+    int values[4];
+};
+
+std::size_t HashStateKey(const StateKey &key)
+{
+    return static_cast<std::size_t>(key.values[0] * 31 + key.values[1]);
+}
+
+bool CompareStateKeys(const StateKey &a, const StateKey &b)
+{
+    return memcmp(&a, &b, sizeof(StateKey)) == 0;
+}
+
+class LRUCacheTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        g_releasedValues.clear();
+    }
+};
+
+}
+
+TEST_F(LRUCacheTest, GetReturnsInsertedValues)
+{
+    gl::LRUCache<std::string, int> cache(4, RecordRelease);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_TRUE(cache.get("missing") == NULL);
+
+    cache.put("one", 1);
+    cache.put("two", 2);
+    ASSERT_TRUE(cache.get("one") != NULL);
+    EXPECT_EQ(1, *cache.get("one"));
+    EXPECT_EQ(2, *cache.get("two"));
+    EXPECT_EQ(2u, cache.size());
+
+    const gl::LRUCacheStatistics &statistics = cache.getStatistics();
+    EXPECT_EQ(3u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(2u, statistics.insertions);
+    EXPECT_EQ(0u, statistics.evictions);
+    EXPECT_TRUE(g_releasedValues.empty());
+}
+
+TEST_F(LRUCacheTest, EvictsLeastRecentlyUsed)
+{
+    gl::LRUCache<int, int> cache(3, RecordRelease);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+
+    // Touching the oldest entry makes 2 the least recently used
+    EXPECT_TRUE(cache.get(1) != NULL);
+    cache.put(4, 40);
+
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_TRUE(cache.get(2) == NULL);
+    EXPECT_TRUE(cache.get(1) != NULL);
+    EXPECT_TRUE(cache.get(3) != NULL);
+    EXPECT_TRUE(cache.get(4) != NULL);
+    ASSERT_EQ(1u, g_releasedValues.size());
+    EXPECT_EQ(20, g_releasedValues[0]);
+    EXPECT_EQ(1u, cache.getStatistics().evictions);
+
+    // Recency is now 4, 3, 1 from newest to oldest
+    cache.put(5, 50);
+    cache.put(6, 60);
+    ASSERT_EQ(3u, g_releasedValues.size());
+    EXPECT_EQ(10, g_releasedValues[1]);
+    EXPECT_EQ(30, g_releasedValues[2]);
+}
+
+TEST_F(LRUCacheTest, PutReplacesExistingValue)
+{
+    gl::LRUCache<int, int> cache(2, RecordRelease);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(1, 11);
+
+    EXPECT_EQ(2u, cache.size());
+    ASSERT_EQ(1u, g_releasedValues.size());
+    EXPECT_EQ(10, g_releasedValues[0]);
+
+    // Replacing refreshed 1, so 2 is evicted next
+    cache.put(3, 30);
+    EXPECT_TRUE(cache.get(2) == NULL);
+    ASSERT_TRUE(cache.get(1) != NULL);
+    EXPECT_EQ(11, *cache.get(1));
+}
+
+TEST_F(LRUCacheTest, EraseAndClearReleaseValues)
+{
+    gl::LRUCache<int, int> cache(8, RecordRelease);
+    for (int key = 0; key < 5; key++)
+    {
+        cache.put(key, key * 10);
+    }
+
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_EQ(4u, cache.size());
+    ASSERT_EQ(1u, g_releasedValues.size());
+    EXPECT_EQ(20, g_releasedValues[0]);
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(5u, g_releasedValues.size());
+
+    // The recency list must be usable again after clearing
+    cache.put(7, 70);
+    cache.put(8, 80);
+    EXPECT_EQ(70, *cache.get(7));
+    EXPECT_EQ(2u, cache.size());
+}
+
+TEST_F(LRUCacheTest, CustomHashAndEquality)
+{
+    typedef std::size_t (*StateHashFunction)(const StateKey &);
+    typedef bool (*StateEqualityFunction)(const StateKey &, const StateKey &);
+    gl::LRUCache<StateKey, int, StateHashFunction, StateEqualityFunction> cache(16, NULL, HashStateKey, CompareStateKeys);
+
+    StateKey key = { { 1, 2, 3, 4 } };
+    cache.put(key, 1234);
+
+    StateKey sameKey = { { 1, 2, 3, 4 } };
+    ASSERT_TRUE(cache.get(sameKey) != NULL);
+    EXPECT_EQ(1234, *cache.get(sameKey));
+
+    // Same hash, different contents
+    StateKey otherKey = { { 1, 2, 5, 6 } };
+    EXPECT_TRUE(cache.get(otherKey) == NULL);
+}
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ResourceMap_test.cpp:
+//   Tests the gl::ResourceMap template the resource manager and contexts map GL names with.
+//
+
+#include <algorithm>
+#include <vector>
+#include "libGLESv2/ResourceMap.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+struct Object
+{
+    explicit Object(GLuint id) : id(id) {}
+
+    GLuint id;
+};
+
+}
+
+TEST(ResourceMapTest, AssignAndQuery)
+{
+    gl::ResourceMap<Object> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(NULL, map.query(1));
+
+    Object first(1);
+    Object second(2);
+    map.assign(1, &first);
+    map.assign(2, &second);
+
+    EXPECT_FALSE(map.empty());
+    EXPECT_EQ(&first, map.query(1));
+    EXPECT_EQ(&second, map.query(2));
+    EXPECT_EQ(NULL, map.query(3));
+    EXPECT_FALSE(map.contains(3));
+}
+
+TEST(ResourceMapTest, ReservedNames)
+{
+    gl::ResourceMap<Object> map;
+
+    // Generated names are known before the object is created by the first bind
+    map.assign(5, NULL);
+    EXPECT_TRUE(map.contains(5));
+    EXPECT_EQ(NULL, map.query(5));
+
+    Object object(5);
+    map.assign(5, &object);
+    EXPECT_EQ(&object, map.query(5));
+
+    Object *erased = NULL;
+    EXPECT_TRUE(map.erase(5, &erased));
+    EXPECT_EQ(&object, erased);
+    EXPECT_FALSE(map.contains(5));
+    EXPECT_EQ(NULL, map.query(5));
+    EXPECT_FALSE(map.erase(5, &erased));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ResourceMapTest, LargeNames)
+{
+    gl::ResourceMap<Object> map;
+
+    // Names bound by the application may be arbitrarily large
+    const GLuint names[] = { 0, 7, 100000, 0xFFFFFFFFu, 70000 };
+    std::vector<Object> objects;
+    for (size_t i = 0; i < ArraySize(names); i++)
+    {
+        objects.push_back(Object(names[i]));
+    }
+    for (size_t i = 0; i < ArraySize(names); i++)
+    {
+        map.assign(names[i], &objects[i]);
+    }
+
+    for (size_t i = 0; i < ArraySize(names); i++)
+    {
+        EXPECT_TRUE(map.contains(names[i]));
+        EXPECT_EQ(names[i], map.query(names[i])->id);
+    }
+    EXPECT_FALSE(map.contains(100001));
+
+    std::vector<GLuint> handles;
+    map.getHandles(&handles);
+    std::sort(handles.begin(), handles.end());
+    std::vector<GLuint> expected(names, names + ArraySize(names));
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, handles);
+
+    for (size_t i = 0; i < ArraySize(names); i++)
+    {
+        Object *erased = NULL;
+        EXPECT_TRUE(map.erase(names[i], &erased));
+        EXPECT_EQ(&objects[i], erased);
+    }
+    EXPECT_TRUE(map.empty());
+}
@@ -0,0 +1,318 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RingBufferTracer_test.cpp:
+//   Tests that gl::RingBufferTracer records round trip through gl::BinaryTraceReader.
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "common/BinaryTraceReader.h"
+#include "common/RingBufferTracer.h"
+#include "gtest/gtest.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+void Begin(gl::RingBufferTracer *tracer, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    tracer->beginEvent(format, arguments);
+    va_end(arguments);
+}
+
+void Message(gl::RingBufferTracer *tracer, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    tracer->message(format, arguments);
+    va_end(arguments);
+}
+
+std::vector<char> ReadFile(const char *path)
+{
+    std::vector<char> data;
+    FILE *file = fopen(path, "rb");
+    if (file)
+    {
+        char block[4096];
+        size_t read = 0;
+        while ((read = fread(block, 1, sizeof(block), file)) > 0)
+        {
+            data.insert(data.end(), block, block + read);
+        }
+        fclose(file);
+    }
+    return data;
+}
+
+void SleepMilliseconds(unsigned int milliseconds)
+{
+#if defined(_WIN32)
+    Sleep(milliseconds);
+#else
+    usleep(milliseconds * 1000);
+#endif
+}
+
+void RecordDraws(gl::RingBufferTracer *tracer, int count)
+{
+    for (int draw = 0; draw < count; draw++)
+    {
+        Begin(tracer, "glDrawArrays(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d)", 4, draw, 3);
+        tracer->endEvent();
+    }
+}
+
+#if defined(_WIN32)
+DWORD WINAPI RecordDrawsOnThread(LPVOID parameter)
+{
+    RecordDraws(static_cast<gl::RingBufferTracer*>(parameter), 100);
+    return 0;
+}
+
+DWORD WINAPI RecordDrawsAndExitThread(LPVOID parameter)
+{
+    RecordDraws(static_cast<gl::RingBufferTracer*>(parameter), 100);
+    static_cast<gl::RingBufferTracer*>(parameter)->releaseThreadBuffer();
+    return 0;
+}
+#else
+void *RecordDrawsOnThread(void *parameter)
+{
+    RecordDraws(static_cast<gl::RingBufferTracer*>(parameter), 100);
+    return NULL;
+}
+
+void *RecordDrawsAndExitThread(void *parameter)
+{
+    RecordDraws(static_cast<gl::RingBufferTracer*>(parameter), 100);
+    static_cast<gl::RingBufferTracer*>(parameter)->releaseThreadBuffer();
+    return NULL;
+}
+#endif
+
+class RingBufferTracerTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+#if defined(_WIN32)
+        char directory[MAX_PATH];
+        DWORD length = GetTempPathA(MAX_PATH, directory);
+        mTracePath = std::string(directory, length);
+#else
+        const char *directory = getenv("TMPDIR");
+        mTracePath = std::string(directory ? directory : "/tmp") + "/";
+#endif
+        mTracePath += "RingBufferTracer_test.angletrace";
+    }
+
+    virtual void TearDown()
+    {
+        remove(mTracePath.c_str());
+    }
+
+    bool decode(gl::BinaryTraceReader *reader)
+    {
+        std::vector<char> data = ReadFile(mTracePath.c_str());
+        return !data.empty() && reader->read(&data[0], data.size());
+    }
+
+    std::string mTracePath;
+};
+
+}
+
+TEST_F(RingBufferTracerTest, FormatsArguments)
+{
+    {
+        gl::RingBufferTracer tracer(mTracePath.c_str(), 65536, 0);
+        ASSERT_TRUE(tracer.isOpen());
+
+        Begin(&tracer, "glUniform1f(GLint location = %d, GLfloat x = %f)", -2, 0.5);
+        tracer.endEvent();
+        Begin(&tracer, "glGetAttribLocation(GLuint program = %d, const GLchar* name = \"%s\")", 3, "a_position");
+        tracer.endEvent();
+        Begin(&tracer, "glBufferData(GLsizeiptr size = %lld, const GLvoid* data = 0x%0.8p)", 4294967296LL, (void*)0x1234);
+        tracer.endEvent();
+        Begin(&tracer, "eglGetDisplay(EGLNativeDisplayType display_id = %s)", (const char*)NULL);
+        tracer.endEvent();
+    }
+
+    gl::BinaryTraceReader reader;
+    ASSERT_TRUE(decode(&reader));
+
+    const std::vector<gl::BinaryTraceEvent> &events = reader.getEvents();
+    ASSERT_EQ(8u, events.size());
+
+    EXPECT_EQ(gl::BINARY_TRACE_BEGIN, events[0].type);
+    EXPECT_EQ("glUniform1f", events[0].name);
+    EXPECT_EQ("glUniform1f(GLint location = -2, GLfloat x = 0.500000)", events[0].text);
+    EXPECT_EQ(gl::BINARY_TRACE_END, events[1].type);
+    EXPECT_EQ("glGetAttribLocation(GLuint program = 3, const GLchar* name = \"a_position\")", events[2].text);
+    EXPECT_EQ("glBufferData(GLsizeiptr size = 4294967296, const GLvoid* data = 0x00001234)", events[4].text);
+    EXPECT_EQ("eglGetDisplay(EGLNativeDisplayType display_id = (null))", events[6].text);
+}
+
+TEST_F(RingBufferTracerTest, NestsEventsAndMessages)
+{
+    {
+        gl::RingBufferTracer tracer(mTracePath.c_str(), 65536, 0);
+        Begin(&tracer, "glClear(GLbitfield mask = 0x%X)", 0x4000);
+        Message(&tracer, "\t! Error generated: %s\n", "invalid value");
+        tracer.endEvent();
+    }
+
+    gl::BinaryTraceReader reader;
+    ASSERT_TRUE(decode(&reader));
+
+    std::string text = reader.toText();
+    EXPECT_NE(std::string::npos, text.find("glClear(GLbitfield mask = 0x4000)\n"));
+    EXPECT_NE(std::string::npos, text.find("  \t! Error generated: invalid value\n"));
+
+    std::string json = reader.toChromeJSON();
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"B\",\"name\":\"glClear\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"E\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"\\t! Error generated: invalid value\""));
+}
+
+TEST_F(RingBufferTracerTest, KeepsThreadsApart)
+{
+    {
+        gl::RingBufferTracer tracer(mTracePath.c_str(), 65536, 0);
+        RecordDraws(&tracer, 100);
+
+#if defined(_WIN32)
+        HANDLE thread = CreateThread(NULL, 0, RecordDrawsOnThread, &tracer, 0, NULL);
+        ASSERT_TRUE(thread != NULL);
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        ASSERT_EQ(0, pthread_create(&thread, NULL, RecordDrawsOnThread, &tracer));
+        pthread_join(thread, NULL);
+#endif
+
+        gl::RingBufferTracerStatistics statistics = tracer.getStatistics();
+        EXPECT_EQ(2u, statistics.threads);
+        EXPECT_EQ(2u, statistics.buffers);
+        // Each thread defines the format string once
+        EXPECT_EQ(402u, statistics.recordsWritten);
+        EXPECT_EQ(0u, statistics.recordsDropped);
+    }
+
+    gl::BinaryTraceReader reader;
+    ASSERT_TRUE(decode(&reader));
+
+    const std::vector<gl::BinaryTraceEvent> &events = reader.getEvents();
+    ASSERT_EQ(400u, events.size());
+
+    unsigned int perThread[2] = { 0, 0 };
+    for (size_t index = 0; index < events.size(); index++)
+    {
+        ASSERT_LT(events[index].threadIndex, 2u);
+        perThread[events[index].threadIndex]++;
+        if (index > 0)
+        {
+            EXPECT_LE(events[index - 1].microseconds, events[index].microseconds);
+        }
+    }
+    EXPECT_EQ(200u, perThread[0]);
+    EXPECT_EQ(200u, perThread[1]);
+}
+
+TEST_F(RingBufferTracerTest, DropsRecordsWhenFull)
+{
+    {
+        // The smallest buffer holds 256 words, far fewer than 10000 events
+        gl::RingBufferTracer tracer(mTracePath.c_str(), 0, 0);
+        RecordDraws(&tracer, 10000);
+        tracer.flush();
+        RecordDraws(&tracer, 1);
+
+        EXPECT_GT(tracer.getStatistics().recordsDropped, 0u);
+    }
+
+    gl::BinaryTraceReader reader;
+    ASSERT_TRUE(decode(&reader));
+
+    std::string text = reader.toText();
+    EXPECT_NE(std::string::npos, text.find("records dropped"));
+}
+
+TEST_F(RingBufferTracerTest, RecyclesBuffersOfExitedThreads)
+{
+    {
+        gl::RingBufferTracer tracer(mTracePath.c_str(), 65536, 0);
+
+        // The threads run one after the other, so the second one takes over the first one's buffer
+        for (int threadIndex = 0; threadIndex < 2; threadIndex++)
+        {
+#if defined(_WIN32)
+            HANDLE thread = CreateThread(NULL, 0, RecordDrawsAndExitThread, &tracer, 0, NULL);
+            ASSERT_TRUE(thread != NULL);
+            WaitForSingleObject(thread, INFINITE);
+            CloseHandle(thread);
+#else
+            pthread_t thread;
+            ASSERT_EQ(0, pthread_create(&thread, NULL, RecordDrawsAndExitThread, &tracer));
+            pthread_join(thread, NULL);
+#endif
+        }
+
+        gl::RingBufferTracerStatistics statistics = tracer.getStatistics();
+        EXPECT_EQ(2u, statistics.threads);
+        EXPECT_EQ(1u, statistics.buffers);
+        EXPECT_EQ(0u, statistics.recordsDropped);
+    }
+
+    gl::BinaryTraceReader reader;
+    ASSERT_TRUE(decode(&reader));
+
+    // The second thread defines the format string again, and its records keep their own index
+    const std::vector<gl::BinaryTraceEvent> &events = reader.getEvents();
+    ASSERT_EQ(400u, events.size());
+    EXPECT_EQ(0u, events[0].threadIndex);
+    EXPECT_EQ(0u, events[199].threadIndex);
+    EXPECT_EQ(1u, events[200].threadIndex);
+    EXPECT_EQ(1u, events[399].threadIndex);
+    EXPECT_EQ("glDrawArrays", events[200].name);
+}
+
+TEST_F(RingBufferTracerTest, FlushesInTheBackground)
+{
+    gl::RingBufferTracer tracer(mTracePath.c_str(), 65536, 10);
+    tracer.startFlusher();
+    RecordDraws(&tracer, 100);
+
+    // Nothing flushes on this thread, so the records can only reach the file through the flusher
+    for (int attempt = 0; attempt < 500 && tracer.getStatistics().bytesFlushed == 0; attempt++)
+    {
+        SleepMilliseconds(10);
+    }
+    EXPECT_GT(tracer.getStatistics().bytesFlushed, 0u);
+
+    // Stopping flushes what is left, and the flusher can be started again
+    RecordDraws(&tracer, 1);
+    tracer.stopFlusher();
+    unsigned long long bytesFlushed = tracer.getStatistics().bytesFlushed;
+    EXPECT_EQ(bytesFlushed, static_cast<unsigned long long>(ReadFile(mTracePath.c_str()).size()));
+
+    tracer.startFlusher();
+    tracer.startFlusher();
+    RecordDraws(&tracer, 1);
+    tracer.stopFlusher();
+    tracer.stopFlusher();
+    EXPECT_GT(tracer.getStatistics().bytesFlushed, bytesFlushed);
+}
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ASTMetadataHLSL_test.cpp:
+//   Tests the HLSL output which depends on the node properties sh::ASTMetadataHLSL
+//   computes.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+class ASTMetadataHLSLTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL9_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const std::string &source, std::string *objectCode)
+    {
+        const char *sourceStrings[] = { source.c_str() };
+        if (!ShCompile(mCompiler, sourceStrings, 1, SH_OBJECT_CODE))
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        ShGetInfo(mCompiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> buffer(length);
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        *objectCode = &buffer[0];
+        return true;
+    }
+
+    // Nests loopCount loops with statementCount statements each, and a texture lookup in the
+    // innermost one. If discontinuous is set the innermost loop has a break, otherwise only a
+    // loop following the nest has one.
+    std::string generateNestedLoops(int loopCount, int statementCount, bool discontinuous)
+    {
+        std::stringstream stream;
+        stream << "precision mediump float;\n"
+                  "uniform sampler2D u_texture;\n"
+                  "varying vec2 v_coord;\n"
+                  "void main()\n"
+                  "{\n"
+                  "    vec4 color = vec4(0.0);\n";
+        for (int loop = 0; loop < loopCount; loop++)
+        {
+            stream << "for (int i" << loop << " = 0; i" << loop << " < 2; i" << loop << "++) {\n";
+            for (int statement = 0; statement < statementCount; statement++)
+            {
+                stream << "    color.x += color.y * (float(i" << loop << ") + " << statement << ".0);\n";
+            }
+        }
+        stream << "color += texture2D(u_texture, v_coord);\n";
+        if (discontinuous)
+        {
+            stream << "if (color.x > 1.0) break;\n";
+        }
+        for (int loop = 0; loop < loopCount; loop++)
+        {
+            stream << "}\n";
+        }
+        stream << "    for (int j = 0; j < 2; j++) { if (color.y > 1.0) break; color.y += 0.5; }\n"
+                  "    gl_FragColor = color;\n"
+                  "}\n";
+        return stream.str();
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(ASTMetadataHLSLTest, DiscontinuousLoopsUseLod0)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile(generateNestedLoops(3, 1, true), &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("gl_texture2DLod0("));
+
+    // Only the lookups in the loops which break use the Lod0 variant
+    ASSERT_TRUE(compile(generateNestedLoops(3, 1, false), &objectCode));
+    EXPECT_EQ(std::string::npos, objectCode.find("gl_texture2DLod0(_u_texture"));
+    EXPECT_NE(std::string::npos, objectCode.find("gl_texture2D(_u_texture"));
+}
+
+TEST_F(ASTMetadataHLSLTest, ShortCircuitSideEffectsUnfold)
+{
+    const std::string source =
+        "precision mediump float;\n"
+        "uniform float u_value;\n"
+        "void main()\n"
+        "{\n"
+        "    float a = u_value;\n"
+        "    float b = 0.0;\n"
+        "    bool c = a > 0.0 && (b += 1.0) > 0.0;\n"
+        "    bool d = a > 0.0 && b > 0.0;\n"
+        "    gl_FragColor = vec4(float(c), float(d), b, 1.0);\n"
+        "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(source, &objectCode));
+
+    // Only the operator with a side effect on its right is unfolded into a temporary
+    EXPECT_NE(std::string::npos, objectCode.find("bool s0"));
+    EXPECT_EQ(std::string::npos, objectCode.find("bool s1"));
+    EXPECT_NE(std::string::npos, objectCode.find(" && "));
+}
@@ -0,0 +1,299 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactTree_test.cpp:
+//   Tests that traversing a TCompactTree visits the nodes as traversing the
+//   intermediate tree does, and that its types and names are interned.
+//
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include "compiler/translator/CompactTree.h"
+#include "compiler/translator/ShHandle.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class TreeCheck
+{
+  public:
+    virtual ~TreeCheck() {}
+    virtual void run(TIntermNode *root) = 0;
+};
+
+// Runs a check on the intermediate tree of the shader instead of translating it.
+class CheckingCompiler : public TCompiler
+{
+  public:
+    explicit CheckingCompiler(TreeCheck *check)
+        : TCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC),
+          mCheck(check)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root, int compileOptions)
+    {
+        mCheck->run(root);
+    }
+
+  private:
+    TreeCheck *mCheck;
+};
+
+void CheckTree(const std::string &source, TreeCheck *check)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+
+    CheckingCompiler compiler(check);
+    ASSERT_TRUE(compiler.Init(resources));
+
+    const char *sourceStrings[] = { source.c_str() };
+    ASSERT_TRUE(compiler.compile(sourceStrings, 1, SH_OBJECT_CODE)) << compiler.getInfoSink().info.c_str();
+}
+
+// Writes down every visit, optionally cancelling some of them.
+class RecordVisits : public TIntermTraverser
+{
+  public:
+    RecordVisits(bool rightToLeft, bool cancel)
+        : TIntermTraverser(true, true, true, rightToLeft),
+          mCancel(cancel)
+    {
+    }
+
+    virtual void visitSymbol(TIntermSymbol *node) { record("symbol", PreVisit, node); }
+    virtual void visitConstantUnion(TIntermConstantUnion *node) { record("constant", PreVisit, node); }
+
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        record("binary", visit, node);
+        return !mCancel || visit != InVisit || node->getOp() != EOpAssign;
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        record("unary", visit, node);
+        return true;
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        record("aggregate", visit, node);
+        return !mCancel || visit != InVisit || node->getOp() != EOpFunctionCall;
+    }
+
+    virtual bool visitSelection(Visit visit, TIntermSelection *node)
+    {
+        record("selection", visit, node);
+        return !mCancel || visit != PreVisit || node->usesTernaryOperator();
+    }
+
+    virtual bool visitLoop(Visit visit, TIntermLoop *node)
+    {
+        record("loop", visit, node);
+        return true;
+    }
+
+    virtual bool visitBranch(Visit visit, TIntermBranch *node)
+    {
+        record("branch", visit, node);
+        return true;
+    }
+
+    std::string str() const { return mVisits.str(); }
+
+  private:
+    void record(const char *kind, Visit visit, TIntermNode *node)
+    {
+        mVisits << kind << " " << visit << " " << node << " " << depth << " " << getParentNode() << "\n";
+    }
+
+    bool mCancel;
+    std::stringstream mVisits;
+};
+
+class CompareVisits : public TreeCheck
+{
+  public:
+    virtual void run(TIntermNode *root)
+    {
+        TCompactTree compactTree(root);
+        ASSERT_GT(compactTree.size(), 0u);
+
+        for (int i = 0; i < 4; i++)
+        {
+            bool rightToLeft = (i & 1) != 0;
+            bool cancel = (i & 2) != 0;
+
+            RecordVisits treeVisits(rightToLeft, cancel);
+            root->traverse(&treeVisits);
+            RecordVisits compactVisits(rightToLeft, cancel);
+            compactTree.traverse(&compactVisits);
+
+            EXPECT_FALSE(treeVisits.str().empty());
+            EXPECT_EQ(treeVisits.str(), compactVisits.str()) << "rightToLeft " << rightToLeft << ", cancel " << cancel;
+        }
+    }
+};
+
+class CompareTypes : public TreeCheck
+{
+  public:
+    CompareTypes() : typedNodeCount(0), typeCount(0) {}
+
+    virtual void run(TIntermNode *root)
+    {
+        TCompactTree compactTree(root);
+        typeCount = compactTree.getTypeCount();
+
+        for (size_t i = 0; i < compactTree.size(); i++)
+        {
+            TIntermTyped *typed = compactTree.getNode(i).node->getAsTyped();
+            ASSERT_EQ(typed != NULL, compactTree.hasType(i));
+            if (typed)
+            {
+                const TType &type = compactTree.getType(i);
+                EXPECT_TRUE(type == typed->getType());
+                EXPECT_EQ(typed->getPrecision(), type.getPrecision());
+                EXPECT_EQ(typed->getQualifier(), type.getQualifier());
+                typedNodeCount++;
+            }
+        }
+    }
+
+    size_t typedNodeCount;
+    size_t typeCount;
+};
+
+const char kShader[] =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "uniform sampler2D u_texture;\n"
+    "varying vec2 v_texCoord;\n"
+    "struct Light { vec3 direction; highp float intensity; };\n"
+    "float shade(Light light, vec3 normal)\n"
+    "{\n"
+    "    if (light.intensity <= 0.0)\n"
+    "        return 0.0;\n"
+    "    return max(dot(light.direction, normal), 0.0) * light.intensity;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    Light light = Light(vec3(0.0, 0.0, 1.0), 2.0);\n"
+    "    vec4 color = texture2D(u_texture, v_texCoord);\n"
+    "    float sum = 0.0, weights[3];\n"
+    "    for (int i = 0; i < 3; i++)\n"
+    "    {\n"
+    "        weights[i] = float(i) * 0.5;\n"
+    "        sum += i > 1 ? weights[i] : -weights[i];\n"
+    "        if (sum > 2.0) break; else continue;\n"
+    "    }\n"
+    "    if (color.a < 0.1)\n"
+    "        discard;\n"
+    "    gl_FragColor = u_color * color * shade(light, normalize(vec3(v_texCoord, sum)));\n"
+    "}\n";
+
+}
+
+TEST(CompactTreeTest, VisitsMatchTree)
+{
+    CompareVisits check;
+    CheckTree(kShader, &check);
+}
+
+TEST(CompactTreeTest, TypesAreInterned)
+{
+    CompareTypes check;
+    CheckTree(kShader, &check);
+
+    EXPECT_GT(check.typeCount, 0u);
+    EXPECT_LT(check.typeCount * 2, check.typedNodeCount);
+}
+
+class CompareNames : public TreeCheck
+{
+  public:
+    virtual void run(TIntermNode *root)
+    {
+        TCompactTree compactTree(root);
+        for (size_t i = 0; i < compactTree.size(); i++)
+        {
+            TIntermAggregate *aggregate = compactTree.getNode(i).node->getAsAggregate();
+            bool named = aggregate != NULL && !aggregate->getName().empty();
+            ASSERT_EQ(named, compactTree.hasName(i));
+            if (named)
+            {
+                EXPECT_EQ(aggregate->getName(), compactTree.getName(i));
+                nameIndices[aggregate->getOp()].insert(compactTree.getNode(i).name);
+            }
+        }
+    }
+
+    std::map<TOperator, std::set<unsigned int> > nameIndices;
+};
+
+TEST(CompactTreeTest, NamesAreInterned)
+{
+    CompareNames check;
+    CheckTree(kShader, &check);
+
+    // shade() and main() are defined, and shade() and texture2D() are called.
+    // The call to shade() shares the index of its definition.
+    const std::set<unsigned int> &definitions = check.nameIndices[EOpFunction];
+    const std::set<unsigned int> &calls = check.nameIndices[EOpFunctionCall];
+    ASSERT_EQ(2u, definitions.size());
+    ASSERT_EQ(2u, calls.size());
+    EXPECT_EQ(1u, definitions.count(*calls.begin()) + definitions.count(*calls.rbegin()));
+}
+
+class CompareMaxDepth : public TreeCheck
+{
+  public:
+    CompareMaxDepth() : treeMaxDepth(0), compactMaxDepth(0) {}
+
+    virtual void run(TIntermNode *root)
+    {
+        RecordVisits treeVisits(false, false);
+        root->traverse(&treeVisits);
+        treeMaxDepth = treeVisits.getMaxDepth();
+
+        TCompactTree compactTree(root);
+        RecordVisits compactVisits(false, false);
+        compactTree.traverse(&compactVisits);
+        compactMaxDepth = compactVisits.getMaxDepth();
+
+        EXPECT_EQ(treeVisits.str(), compactVisits.str());
+    }
+
+    int treeMaxDepth;
+    int compactMaxDepth;
+};
+
+TEST(CompactTreeTest, BranchesWithoutExpressionDontGoDeeper)
+{
+    // The branches are the deepest nodes, so they decide the maximum depth.
+    const char source[] =
+        "precision mediump float;\n"
+        "uniform bool u_flag;\n"
+        "void f() { if (u_flag) { if (u_flag) { return; } } }\n"
+        "void main()\n"
+        "{\n"
+        "    for (int i = 0; i < 2; i++) { if (u_flag) { if (u_flag) { break; } else { continue; } } }\n"
+        "    if (u_flag) { if (u_flag) { discard; } }\n"
+        "    f();\n"
+        "    gl_FragColor = vec4(0.0);\n"
+        "}\n";
+
+    CompareMaxDepth check;
+    CheckTree(source, &check);
+
+    EXPECT_GT(check.treeMaxDepth, 0);
+    EXPECT_EQ(check.treeMaxDepth, check.compactMaxDepth);
+}
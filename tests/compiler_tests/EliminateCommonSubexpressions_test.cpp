@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EliminateCommonSubexpressions_test.cpp:
+//   Tests which repeated expressions SH_ELIMINATE_COMMON_SUBEXPRESSIONS computes into
+//   temporaries, and measures how many operations the translated code does with it.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+class EliminateCommonSubexpressionsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const std::string &body, int compileOptions, std::string *objectCode)
+    {
+        return compileSource(
+            "precision mediump float;\n"
+            "uniform sampler2D u_texture;\n"
+            "uniform highp vec2 u_coord;\n"
+            "uniform vec3 u_normal;\n"
+            "float sideEffect();\n"
+            "void main()\n"
+            "{\n" + body + "}\n"
+            "float count = 0.0;\n"
+            "float sideEffect()\n"
+            "{\n"
+            "    count += 1.0;\n"
+            "    return count;\n"
+            "}\n",
+            compileOptions, objectCode);
+    }
+
+    bool compileSource(const std::string &source, int compileOptions, std::string *objectCode)
+    {
+        const char *sourceStrings[] = { source.c_str() };
+        if (!ShCompile(mCompiler, sourceStrings, 1, SH_OBJECT_CODE | compileOptions))
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        ShGetInfo(mCompiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> buffer(length);
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        *objectCode = &buffer[0];
+        return true;
+    }
+
+    static int countOccurrences(const std::string &objectCode, const std::string &text)
+    {
+        int count = 0;
+        for (size_t position = objectCode.find(text); position != std::string::npos; position = objectCode.find(text, position + 1))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(EliminateCommonSubexpressionsTest, RepeatedExpressionsAreShared)
+{
+    const std::string body =
+        "vec4 color = texture2D(u_texture, u_coord * 2.0);\n"
+        "float light = dot(normalize(u_normal), vec3(0.0, 0.0, 1.0));\n"
+        "gl_FragColor = texture2D(u_texture, u_coord * 2.0) * light + vec4(normalize(u_normal), 1.0) + color;\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(body, 0, &objectCode));
+    EXPECT_EQ(2, countOccurrences(objectCode, "texture2D("));
+    EXPECT_EQ(2, countOccurrences(objectCode, "normalize("));
+
+    ASSERT_TRUE(compile(body, SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_EQ(1, countOccurrences(objectCode, "texture2D("));
+    EXPECT_EQ(1, countOccurrences(objectCode, "normalize("));
+    EXPECT_NE(std::string::npos, objectCode.find("webgl_cse"));
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, WritesInBetweenAreRespected)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("vec3 n = u_normal;\n"
+                        "float a = length(n * 2.0);\n"
+                        "n.x += 1.0;\n"
+                        "float b = length(n * 2.0);\n"
+                        "gl_FragColor = vec4(a, b, 0.0, 1.0);\n",
+                        SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_EQ(2, countOccurrences(objectCode, "length("));
+
+    ASSERT_TRUE(compile("vec3 n = u_normal;\n"
+                        "float a = length(n * 2.0);\n"
+                        "if (a > 1.0) n = vec3(0.0);\n"
+                        "float b = length(n * 2.0);\n"
+                        "gl_FragColor = vec4(a, b, 0.0, 1.0);\n",
+                        SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_EQ(2, countOccurrences(objectCode, "length("));
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, TemporariesKeepPrecision)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("float a = u_coord.x * u_coord.y;\n"
+                        "float b = u_normal.x * u_normal.y;\n"
+                        "gl_FragColor = vec4(a, b, u_coord.x * u_coord.y, u_normal.x * u_normal.y);\n",
+                        SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("highp float webgl_cse"));
+    EXPECT_NE(std::string::npos, objectCode.find("mediump float webgl_cse"));
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, TemporariesHavePrecisionWithoutDefault)
+{
+    // There is no default float precision, so every temporary needs its own
+    const std::string source =
+        "uniform sampler2D u_texture;\n"
+        "uniform highp vec2 u_coord;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = texture2D(u_texture, u_coord) * (u_coord * 2.0).x +\n"
+        "                   texture2D(u_texture, u_coord) * (u_coord * 2.0).y;\n"
+        "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compileSource(source, SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_EQ(1, countOccurrences(objectCode, "texture2D("));
+    EXPECT_NE(std::string::npos, objectCode.find("lowp vec4 webgl_cse"));
+    EXPECT_NE(std::string::npos, objectCode.find("highp vec2 webgl_cse"));
+
+    std::string recompiled;
+    EXPECT_TRUE(compileSource(objectCode, 0, &recompiled)) << objectCode;
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, SideEffectsAreNotMerged)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("float a = sideEffect() * 2.0;\n"
+                        "float b = sideEffect() * 2.0;\n"
+                        "gl_FragColor = vec4(a, b, 0.0, 1.0);\n",
+                        SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &objectCode));
+    EXPECT_EQ(std::string::npos, objectCode.find("webgl_cse"));
+    EXPECT_EQ(4, countOccurrences(objectCode, "sideEffect("));
+}
+
+TEST_F(EliminateCommonSubexpressionsTest, OperationCount)
+{
+    // A blur which samples each texel from several taps, as generated shaders often do
+    const int tapCount = 16;
+    std::stringstream body;
+    body << "vec4 color = vec4(0.0);\n";
+    for (int tap = 0; tap < tapCount; tap++)
+    {
+        body << "color += texture2D(u_texture, u_coord + vec2(" << (tap % 4) << ".0, 0.0) * 0.01) * "
+             << "dot(normalize(u_normal), vec3(" << tap << ".0));\n";
+    }
+    body << "gl_FragColor = color;\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(body.str(), 0, &objectCode));
+    EXPECT_EQ(16, countOccurrences(objectCode, "texture2D("));
+    EXPECT_EQ(16, countOccurrences(objectCode, "normalize("));
+
+    // Four distinct taps and one normalization remain
+    std::string eliminated;
+    ASSERT_TRUE(compile(body.str(), SH_ELIMINATE_COMMON_SUBEXPRESSIONS, &eliminated));
+    EXPECT_EQ(4, countOccurrences(eliminated, "texture2D("));
+    EXPECT_EQ(1, countOccurrences(eliminated, "normalize("));
+    EXPECT_LT(eliminated.size(), objectCode.size());
+}
@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FoldConstants_test.cpp:
+//   Tests the folding of built-in function calls on constant arguments, and measures how
+//   much smaller it makes the translated code.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+class FoldConstantsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const std::string &body, std::string *objectCode)
+    {
+        const std::string source =
+            "precision mediump float;\n"
+            "uniform float u_value;\n"
+            "void main()\n"
+            "{\n" + body + "}\n";
+        const char *sourceStrings[] = { source.c_str() };
+        if (!ShCompile(mCompiler, sourceStrings, 1, SH_OBJECT_CODE))
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        ShGetInfo(mCompiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> buffer(length);
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        *objectCode = &buffer[0];
+        return true;
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(FoldConstantsTest, BuiltInCallsFold)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("gl_FragColor = vec4(pow(2.0, 3.0), sin(0.0), clamp(2.0, 0.0, 1.0), dot(vec2(1.0), vec2(2.0)));\n", &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("vec4(8.0, 0.0, 1.0, 4.0)"));
+    EXPECT_EQ(std::string::npos, objectCode.find("pow("));
+    EXPECT_EQ(std::string::npos, objectCode.find("clamp("));
+    EXPECT_EQ(std::string::npos, objectCode.find("dot("));
+
+    ASSERT_TRUE(compile("gl_FragColor = vec4(mix(vec2(0.0), vec2(4.0), 0.25), max(vec2(1.0, 5.0), 3.0));\n", &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("vec4(1.0, 1.0, 3.0, 5.0)"));
+}
+
+TEST_F(FoldConstantsTest, ConstVariablesInitializedFromBuiltIns)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("const float scale = pow(2.0, 2.0);\n"
+                        "const vec3 direction = normalize(vec3(0.0, 3.0, 4.0));\n"
+                        "gl_FragColor = vec4(direction * scale, length(direction));\n", &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("vec4(0.0, 2.4000001, 3.2, 1.0)"));
+}
+
+TEST_F(FoldConstantsTest, UndefinedResultsDoNotFold)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("gl_FragColor = vec4(sqrt(-1.0), pow(-2.0, 2.0), log(0.0), u_value);\n", &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("sqrt("));
+    EXPECT_NE(std::string::npos, objectCode.find("pow("));
+    EXPECT_NE(std::string::npos, objectCode.find("log("));
+}
+
+TEST_F(FoldConstantsTest, OperandsOtherThanConstantsDoNotFold)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile("gl_FragColor = vec4(pow(u_value, 2.0) * 2.0, sin(u_value), 1.0, 1.0);\n", &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("pow("));
+    EXPECT_NE(std::string::npos, objectCode.find("sin("));
+}
+
+TEST_F(FoldConstantsTest, OutputSize)
+{
+    // The same expressions on constants and on a uniform, which can't be folded
+    const int expressionCount = 64;
+    const char *operands[] = { "0.5", "u_value" };
+    size_t outputSizes[2];
+
+    for (size_t operand = 0; operand < 2; operand++)
+    {
+        std::stringstream body;
+        body << "vec4 color = vec4(0.0);\n";
+        for (int expression = 0; expression < expressionCount; expression++)
+        {
+            body << "color += vec4(pow(" << operands[operand] << ", " << expression << ".0), "
+                 << "smoothstep(0.0, 1.0, " << operands[operand] << "), "
+                 << "clamp(sin(" << operands[operand] << " * " << expression << ".0), 0.0, 1.0), "
+                 << "dot(vec2(" << operands[operand] << "), vec2(" << expression << ".0)));\n";
+        }
+        body << "gl_FragColor = color;\n";
+
+        std::string objectCode;
+        ASSERT_TRUE(compile(body.str(), &objectCode));
+        outputSizes[operand] = objectCode.size();
+    }
+
+    // Folded calls leave only their results, about a third of the unfolded output here
+    EXPECT_LT(outputSizes[0] * 2, outputSizes[1]);
+}
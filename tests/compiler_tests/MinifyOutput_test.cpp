@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput_test.cpp:
+//   Tests that SH_MINIFY_OUTPUT keeps the interface of a shader and produces output which
+//   compiles, and measures how much smaller the output gets.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+khronos_uint64_t HashName(const char *name, size_t length)
+{
+    khronos_uint64_t hash = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = hash * 31 + name[i];
+    }
+    return hash;
+}
+
+const char *kSource =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "uniform sampler2D u_texture;\n"
+    "varying vec2 v_texCoord;\n"
+    "struct LightParameters\n"
+    "{\n"
+    "    vec3 direction;\n"
+    "    float intensity;\n"
+    "};\n"
+    "float computeLighting(LightParameters light, vec3 surfaceNormal)\n"
+    "{\n"
+    "    float diffuseFactor = max(dot(surfaceNormal, light.direction), 0.0);\n"
+    "    return diffuseFactor * light.intensity;\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    LightParameters mainLight = LightParameters(vec3(0.0, 0.0, 1.0), 0.75);\n"
+    "    vec4 textureColor = texture2D(u_texture, v_texCoord);\n"
+    "    vec3 surfaceNormal = normalize(textureColor.xyz * 2.0 - 1.0);\n"
+    "    float lighting = computeLighting(mainLight, surfaceNormal);\n"
+    "    gl_FragColor = u_color * lighting - -1.0;\n"
+    "}\n";
+
+}
+
+class MinifyOutputTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mShaderType = SH_FRAGMENT_SHADER;
+    }
+
+    bool compile(const std::string &source, int compileOptions, std::string *objectCode)
+    {
+        ShHandle compiler = ShConstructCompiler(mShaderType, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &mResources);
+        const char *sourceStrings[] = { source.c_str() };
+        bool compiled = ShCompile(compiler, sourceStrings, 1, SH_OBJECT_CODE | compileOptions) != 0;
+        if (compiled)
+        {
+            size_t length = 0;
+            ShGetInfo(compiler, SH_OBJECT_CODE_LENGTH, &length);
+            std::vector<char> buffer(length);
+            ShGetObjectCode(compiler, &buffer[0]);
+            *objectCode = &buffer[0];
+
+            ShGetInfo(compiler, SH_HASHED_NAMES_COUNT, &mHashedNameCount);
+        }
+
+        ShDestruct(compiler);
+        return compiled;
+    }
+
+    ShBuiltInResources mResources;
+    ShShaderType mShaderType;
+    size_t mHashedNameCount;
+};
+
+TEST_F(MinifyOutputTest, InternalNamesAreShortened)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile(kSource, SH_MINIFY_OUTPUT, &objectCode));
+
+    EXPECT_EQ(std::string::npos, objectCode.find("LightParameters"));
+    EXPECT_EQ(std::string::npos, objectCode.find("computeLighting"));
+    EXPECT_EQ(std::string::npos, objectCode.find("diffuseFactor"));
+    EXPECT_EQ(std::string::npos, objectCode.find("surfaceNormal"));
+    EXPECT_EQ(std::string::npos, objectCode.find("\n"));
+
+    EXPECT_NE(std::string::npos, objectCode.find("u_color"));
+    EXPECT_NE(std::string::npos, objectCode.find("u_texture"));
+    EXPECT_NE(std::string::npos, objectCode.find("v_texCoord"));
+    EXPECT_NE(std::string::npos, objectCode.find("gl_FragColor"));
+    EXPECT_NE(std::string::npos, objectCode.find(".direction"));
+}
+
+TEST_F(MinifyOutputTest, MinifiedOutputCompiles)
+{
+    std::string objectCode;
+    ASSERT_TRUE(compile(kSource, SH_MINIFY_OUTPUT, &objectCode));
+
+    // The output has explicit precisions, apart from the default precision
+    std::string recompiled;
+    EXPECT_TRUE(compile("precision mediump float;\n" + objectCode, 0, &recompiled));
+}
+
+TEST_F(MinifyOutputTest, InterfaceNamesAreHashed)
+{
+    mResources.HashFunction = HashName;
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(kSource, 0, &objectCode));
+    size_t hashedNameCount = mHashedNameCount;
+
+    ASSERT_TRUE(compile(kSource, SH_MINIFY_OUTPUT, &objectCode));
+    EXPECT_EQ(std::string::npos, objectCode.find("u_color"));
+    EXPECT_NE(std::string::npos, objectCode.find("webgl_"));
+
+    // Only the uniforms, the varying and the structure fields remain in the name map
+    EXPECT_EQ(5u, mHashedNameCount);
+    EXPECT_LT(mHashedNameCount, hashedNameCount);
+}
+
+// Returns the name of the type the uniform is declared with.
+std::string UniformTypeName(const std::string &objectCode, const std::string &uniform)
+{
+    size_t end = objectCode.find(" " + uniform + ";");
+    if (end == std::string::npos)
+        return "";
+    size_t begin = objectCode.rfind(' ', end - 1);
+    return objectCode.substr(begin + 1, end - begin - 1);
+}
+
+TEST_F(MinifyOutputTest, SharedStructureKeepsItsName)
+{
+    // Each stage declares other structures first, which would get the first short names.
+    const std::string vertexSource =
+        "struct Offset { vec2 value; };\n"
+        "struct Light { vec3 direction; float intensity; Offset offset; };\n"
+        "uniform Light u_light;\n"
+        "attribute vec4 a_position;\n"
+        "void main()\n"
+        "{\n"
+        "    Offset offset = Offset(vec2(u_light.intensity));\n"
+        "    gl_Position = a_position + vec4(offset.value + u_light.offset.value, u_light.direction.x, 0.0);\n"
+        "}\n";
+    const std::string fragmentSource =
+        "precision mediump float;\n"
+        "struct Material { vec4 color; };\n"
+        "struct Surface { Material material; };\n"
+        "struct Offset { vec2 value; };\n"
+        "struct Light { vec3 direction; float intensity; Offset offset; };\n"
+        "uniform Light u_light;\n"
+        "void main()\n"
+        "{\n"
+        "    Surface surface = Surface(Material(vec4(u_light.direction, u_light.offset.value.x)));\n"
+        "    gl_FragColor = surface.material.color * u_light.intensity;\n"
+        "}\n";
+
+    std::string vertexCode;
+    mShaderType = SH_VERTEX_SHADER;
+    ASSERT_TRUE(compile(vertexSource, SH_MINIFY_OUTPUT, &vertexCode));
+    std::string fragmentCode;
+    mShaderType = SH_FRAGMENT_SHADER;
+    ASSERT_TRUE(compile(fragmentSource, SH_MINIFY_OUTPUT, &fragmentCode));
+
+    EXPECT_EQ("Light", UniformTypeName(vertexCode, "u_light"));
+    EXPECT_EQ("Light", UniformTypeName(fragmentCode, "u_light"));
+    EXPECT_NE(std::string::npos, vertexCode.find("struct Offset{"));
+    EXPECT_NE(std::string::npos, fragmentCode.find("struct Offset{"));
+
+    // The structures which only the fragment shader uses internally are still renamed
+    EXPECT_EQ(std::string::npos, fragmentCode.find("Material"));
+    EXPECT_EQ(std::string::npos, fragmentCode.find("Surface"));
+}
+
+TEST_F(MinifyOutputTest, OutputSize)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 u_color;\n"
+              "varying vec2 v_texCoord;\n";
+    const int functionCount = 32;
+    for (int function = 0; function < functionCount; function++)
+    {
+        source << "vec4 computeContribution" << function << "(vec2 textureCoordinate, vec4 baseColor)\n"
+                  "{\n"
+                  "    float distanceFromCenter = length(textureCoordinate - vec2(0.5));\n"
+                  "    float attenuationFactor = 1.0 / (1.0 + distanceFromCenter * " << function << ".0);\n"
+                  "    return baseColor * attenuationFactor;\n"
+                  "}\n";
+    }
+    source << "void main()\n"
+              "{\n"
+              "    vec4 accumulatedColor = vec4(0.0);\n";
+    for (int function = 0; function < functionCount; function++)
+    {
+        source << "    accumulatedColor += computeContribution" << function << "(v_texCoord, u_color);\n";
+    }
+    source << "    gl_FragColor = accumulatedColor;\n"
+              "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(source.str(), 0, &objectCode));
+    size_t size = objectCode.size();
+    ASSERT_TRUE(compile(source.str(), SH_MINIFY_OUTPUT, &objectCode));
+    EXPECT_LT(objectCode.size() * 2, size);
+}
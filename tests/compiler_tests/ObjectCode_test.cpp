@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ObjectCode_test.cpp:
+//   Tests retrieving the translator output through borrowed pointers or a
+//   streaming callback, and the chunked output sinks.
+//
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/InfoSink.h"
+#include "gtest/gtest.h"
+
+class ObjectCodeTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mHLSLCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL11_OUTPUT, &resources);
+        mGLSLCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mHLSLCompiler != NULL);
+        ASSERT_TRUE(mGLSLCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mHLSLCompiler);
+        ShDestruct(mGLSLCompiler);
+    }
+
+    // A shader with many constants, so number formatting dominates the output
+    std::string generateShader(int statementCount)
+    {
+        std::stringstream stream;
+        stream << "precision mediump float;\n"
+                  "uniform vec4 u_color;\n"
+                  "void main()\n"
+                  "{\n"
+                  "    vec4 color = u_color;\n";
+        for (int statement = 0; statement < statementCount; statement++)
+        {
+            stream << "    color = color * vec4(" << statement << ".25, " << statement << ".0, 0.125, 1.5) + vec4("
+                   << statement % 7 << ".0);\n";
+        }
+        stream << "    gl_FragColor = color;\n"
+                  "}\n";
+        return stream.str();
+    }
+
+    bool compile(ShHandle compiler, const std::string &source)
+    {
+        const char *sourceStrings[] = { source.c_str() };
+        return ShCompile(compiler, sourceStrings, 1, SH_OBJECT_CODE) != 0;
+    }
+
+    std::string copyObjectCode(ShHandle compiler)
+    {
+        size_t length = 0;
+        ShGetInfo(compiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> objectCode(length);
+        ShGetObjectCode(compiler, &objectCode[0]);
+        return &objectCode[0];
+    }
+
+    ShHandle mHLSLCompiler;
+    ShHandle mGLSLCompiler;
+};
+
+struct StreamedObjectCode
+{
+    StreamedObjectCode() : pieces(0), largestPiece(0) {}
+
+    std::string objectCode;
+    size_t pieces;
+    size_t largestPiece;
+};
+
+void AppendStreamedObjectCode(const char *objectCode, size_t length, void *userData)
+{
+    StreamedObjectCode *streamed = static_cast<StreamedObjectCode*>(userData);
+    streamed->objectCode.append(objectCode, length);
+    streamed->pieces++;
+    streamed->largestPiece = std::max(streamed->largestPiece, length);
+}
+
+TEST_F(ObjectCodeTest, PointerMatchesCopiedObjectCode)
+{
+    const std::string source = generateShader(16);
+    ShHandle compilers[] = { mHLSLCompiler, mGLSLCompiler };
+
+    for (size_t compilerIndex = 0; compilerIndex < 2; compilerIndex++)
+    {
+        ShHandle compiler = compilers[compilerIndex];
+        ASSERT_TRUE(compile(compiler, source));
+
+        void *pointer = NULL;
+        ShGetInfoPointer(compiler, SH_OBJECT_CODE_POINTER, &pointer);
+        const char *objectCode = static_cast<const char*>(pointer);
+        ASSERT_TRUE(objectCode != NULL);
+
+        size_t length = 0;
+        ShGetInfo(compiler, SH_OBJECT_CODE_LENGTH, &length);
+        EXPECT_EQ(length - 1, strlen(objectCode));
+        EXPECT_EQ(copyObjectCode(compiler), objectCode);
+    }
+}
+
+TEST_F(ObjectCodeTest, InfoLogPointer)
+{
+    ASSERT_FALSE(compile(mHLSLCompiler, "void main() { undeclared = 1.0; }"));
+
+    void *pointer = NULL;
+    ShGetInfoPointer(mHLSLCompiler, SH_INFO_LOG_POINTER, &pointer);
+    const char *infoLog = static_cast<const char*>(pointer);
+    ASSERT_TRUE(infoLog != NULL);
+    EXPECT_NE(std::string::npos, std::string(infoLog).find("undeclared"));
+
+    size_t length = 0;
+    ShGetInfo(mHLSLCompiler, SH_INFO_LOG_LENGTH, &length);
+    EXPECT_EQ(length - 1, strlen(infoLog));
+}
+
+TEST_F(ObjectCodeTest, StreamedObjectCodeMatchesRetained)
+{
+    // Large enough to span several sink chunks
+    const std::string source = generateShader(2000);
+    ShHandle compilers[] = { mHLSLCompiler, mGLSLCompiler };
+
+    for (size_t compilerIndex = 0; compilerIndex < 2; compilerIndex++)
+    {
+        ShHandle compiler = compilers[compilerIndex];
+        ASSERT_TRUE(compile(compiler, source));
+        const std::string retained = copyObjectCode(compiler);
+
+        StreamedObjectCode streamed;
+        ShSetObjectCodeCallback(compiler, AppendStreamedObjectCode, &streamed);
+        ASSERT_TRUE(compile(compiler, source));
+        EXPECT_EQ("", copyObjectCode(compiler));
+        ShSetObjectCodeCallback(compiler, NULL, NULL);
+
+        EXPECT_EQ(retained, streamed.objectCode);
+        EXPECT_GT(streamed.pieces, 1u);
+        EXPECT_LT(streamed.largestPiece, retained.length());
+
+        // Retaining the object code works again once the callback is removed
+        ASSERT_TRUE(compile(compiler, source));
+        EXPECT_EQ(retained, copyObjectCode(compiler));
+    }
+}
+
+TEST(InfoSinkTest, ChunksJoinAndSplice)
+{
+    std::string expected;
+    TInfoSinkBase sink;
+    for (int line = 0; line < 20000; line++)
+    {
+        sink << "line " << line << "\n";
+
+        std::ostringstream stream;
+        stream << "line " << line << "\n";
+        expected += stream.str();
+    }
+    EXPECT_EQ(static_cast<int>(expected.length()), sink.size());
+
+    TInfoSinkBase header;
+    header << "header\n";
+    header.splice(&sink);
+    EXPECT_EQ(0, sink.size());
+    EXPECT_EQ("header\n" + expected, header.str());
+
+    header << "footer";
+    EXPECT_EQ("header\n" + expected + "footer", header.str());
+}
+
+// The sink formats numbers without string streams; the text must not change
+TEST(InfoSinkTest, NumberFormattingMatchesStreams)
+{
+    const int ints[] = { 0, 1, -1, 42, 2147483647, -2147483647 - 1 };
+    for (size_t index = 0; index < sizeof(ints) / sizeof(ints[0]); index++)
+    {
+        TInfoSinkBase sink;
+        sink << ints[index];
+        std::ostringstream expected;
+        expected << ints[index];
+        EXPECT_EQ(expected.str(), sink.str());
+    }
+
+    const unsigned int uints[] = { 0u, 7u, 4294967295u };
+    for (size_t index = 0; index < sizeof(uints) / sizeof(uints[0]); index++)
+    {
+        TInfoSinkBase sink;
+        sink << uints[index];
+        std::ostringstream expected;
+        expected << uints[index];
+        EXPECT_EQ(expected.str(), sink.str());
+    }
+
+    const float floats[] = { 0.0f, -0.0f, 1.0f, -3.0f, 0.5f, 0.125f, 1.0f / 3.0f, 3.14159265f, 1.0e-7f, 1.5e10f, 3.0e38f, -2.75e-3f };
+    for (size_t index = 0; index < sizeof(floats) / sizeof(floats[0]); index++)
+    {
+        TInfoSinkBase sink;
+        sink << floats[index];
+
+        std::ostringstream expected;
+        if (fractionalPart(floats[index]) == 0.0f)
+        {
+            expected.precision(1);
+            expected << std::showpoint << std::fixed << floats[index];
+        }
+        else
+        {
+            expected.precision(8);
+            expected << floats[index];
+        }
+        EXPECT_EQ(expected.str(), sink.str());
+    }
+}
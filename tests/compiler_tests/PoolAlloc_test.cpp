@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAlloc_test.cpp:
+//   Tests the page growth, large allocations, page retention and statistics of
+//   TPoolAllocator, and the statistics ShGetInfo reports for a compile.
+//
+
+#include <sstream>
+#include <string>
+#include "compiler/translator/PoolAlloc.h"
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+TEST(PoolAllocTest, PagesGrow)
+{
+    TPoolAllocator allocator(8 * 1024);
+    allocator.push();
+
+    // 4 MB in 64 byte allocations would take 512 pages of 8 KB
+    for (int i = 0; i < 64 * 1024; i++)
+    {
+        ASSERT_TRUE(allocator.allocate(64) != NULL);
+    }
+
+    const TPoolAllocator::Statistics &statistics = allocator.getStatistics();
+    EXPECT_EQ(64u * 1024u, statistics.allocationCount);
+    EXPECT_EQ(4u * 1024u * 1024u, statistics.allocatedBytes);
+    EXPECT_LT(statistics.pageCount, 32u);
+    EXPECT_GE(statistics.peakBytes, 4u * 1024u * 1024u);
+
+    allocator.pop();
+}
+
+TEST(PoolAllocTest, LargeAllocationsKeepTheCurrentPage)
+{
+    TPoolAllocator allocator(8 * 1024, 16);
+    allocator.push();
+
+    char *first = static_cast<char*>(allocator.allocate(16));
+    char *large = static_cast<char*>(allocator.allocate(64 * 1024));
+    char *second = static_cast<char*>(allocator.allocate(16));
+    ASSERT_TRUE(first != NULL && large != NULL && second != NULL);
+
+    memset(large, 0, 64 * 1024);
+#ifndef GUARD_BLOCKS
+    EXPECT_EQ(first + 16, second);
+#endif
+    EXPECT_EQ(1u, allocator.getStatistics().largeAllocationCount);
+    EXPECT_EQ(1u, allocator.getStatistics().pageCount);
+
+    allocator.pop();
+}
+
+TEST(PoolAllocTest, PagesAreRetainedAcrossPop)
+{
+    TPoolAllocator allocator(8 * 1024);
+
+    for (int round = 0; round < 3; round++)
+    {
+        allocator.resetStatistics();
+        allocator.push();
+        for (int i = 0; i < 4096; i++)
+        {
+            allocator.allocate(100);
+        }
+        allocator.pop();
+
+        if (round == 0)
+        {
+            EXPECT_GT(allocator.getStatistics().pageCount, 0u);
+        }
+        else
+        {
+            EXPECT_EQ(0u, allocator.getStatistics().pageCount);
+        }
+    }
+
+    // Without retained pages, every round obtains its pages again
+    allocator.setRetainedBytesLimit(0);
+    allocator.resetStatistics();
+    allocator.push();
+    allocator.allocate(100);
+    allocator.pop();
+    EXPECT_EQ(1u, allocator.getStatistics().pageCount);
+}
+
+TEST(PoolAllocTest, NestedPushAndPop)
+{
+    TPoolAllocator allocator(8 * 1024, 16);
+    allocator.push();
+    char *outer = static_cast<char*>(allocator.allocate(16));
+
+    allocator.push();
+    for (int i = 0; i < 1024; i++)
+    {
+        allocator.allocate(100);
+    }
+    allocator.allocate(32 * 1024);
+    allocator.pop();
+
+    // Allocation continues on the page of the outer level
+    char *next = static_cast<char*>(allocator.allocate(16));
+#ifndef GUARD_BLOCKS
+    EXPECT_EQ(outer + 16, next);
+#endif
+    EXPECT_TRUE(next != NULL);
+    allocator.pop();
+}
+
+TEST(PoolAllocTest, CompileStatistics)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 u_color;\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 color = u_color;\n";
+    for (int i = 0; i < 2000; i++)
+    {
+        source << "    color = color * " << i << ".0 + vec4(u_color.x, " << i << ".0, color.yz);\n";
+    }
+    source << "    gl_FragColor = color;\n"
+              "}\n";
+    const std::string sourceString = source.str();
+    const char *sourceStrings[] = { sourceString.c_str() };
+
+    size_t firstAllocationCount = 0;
+    for (int compile = 0; compile < 2; compile++)
+    {
+        ASSERT_TRUE(ShCompile(compiler, sourceStrings, 1, SH_OBJECT_CODE) != 0);
+
+        size_t allocationCount = 0, allocatedBytes = 0, pageCount = 0, largeAllocationCount = 0, peakBytes = 0;
+        ShGetInfo(compiler, SH_POOL_ALLOCATION_COUNT, &allocationCount);
+        ShGetInfo(compiler, SH_POOL_ALLOCATED_BYTES, &allocatedBytes);
+        ShGetInfo(compiler, SH_POOL_PAGE_COUNT, &pageCount);
+        ShGetInfo(compiler, SH_POOL_LARGE_ALLOCATION_COUNT, &largeAllocationCount);
+        ShGetInfo(compiler, SH_POOL_PEAK_BYTES, &peakBytes);
+
+        EXPECT_GT(allocationCount, 0u);
+        EXPECT_GE(peakBytes, allocatedBytes);
+
+        // The statistics are those of the last compile, not a running total
+        if (compile == 0)
+        {
+            firstAllocationCount = allocationCount;
+        }
+        else
+        {
+            EXPECT_EQ(firstAllocationCount, allocationCount);
+        }
+    }
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PredefinedMacros_test.cpp:
+//   Tests that every compile of a compiler sees the same predefined macros
+//   when later compiles start from a snapshot of them.
+//
+
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class PredefinedMacrosTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.OES_standard_derivatives = 1;
+        mResources.FragmentPrecisionHigh = 1;
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &mResources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const char *source)
+    {
+        return ShCompile(mCompiler, &source, 1, SH_OBJECT_CODE) != 0;
+    }
+
+    ShBuiltInResources mResources;
+    ShHandle mCompiler;
+};
+
+const char kUsesPredefinedMacros[] =
+    "#if !defined(GL_OES_standard_derivatives) || !defined(GL_FRAGMENT_PRECISION_HIGH)\n"
+    "#error missing macro\n"
+    "#endif\n"
+    "#if GL_ES != 1 || __VERSION__ != 100 || __LINE__ != 4\n"
+    "#error wrong value\n"
+    "#endif\n"
+    "#ifdef FOO\n"
+    "#error FOO leaked from an earlier compile\n"
+    "#endif\n"
+    "precision mediump float;\n"
+    "void main() { gl_FragColor = vec4(GL_OES_standard_derivatives); }\n";
+
+}
+
+TEST_F(PredefinedMacrosTest, SameMacrosInEveryCompile)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_TRUE(compile(kUsesPredefinedMacros)) << i;
+
+        const char *definesFoo =
+            "#define FOO 1\n"
+            "#undef GL_ES\n"
+            "void main() {}\n";
+        EXPECT_FALSE(compile(definesFoo));
+    }
+}
+
+TEST_F(PredefinedMacrosTest, AbortedExpansionLeavesMacrosEnabled)
+{
+    EXPECT_TRUE(compile(kUsesPredefinedMacros));
+
+    // The parser gives up on the replacement of GL_ES, while expanding it.
+    const char *aborted = "void main() { float GL_ES; }\n";
+    EXPECT_FALSE(compile(aborted));
+
+    EXPECT_TRUE(compile(kUsesPredefinedMacros));
+}
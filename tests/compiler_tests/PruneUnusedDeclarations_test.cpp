@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PruneUnusedDeclarations_test.cpp:
+//   Tests that SH_PRUNE_UNUSED_DECLARATIONS removes what main() doesn't use, and measures
+//   how much smaller it makes shaders sharing a library of functions.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+class PruneUnusedDeclarationsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        mCompiler = constructCompiler(SH_GLES2_SPEC);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    ShHandle constructCompiler(ShShaderSpec spec)
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        return ShConstructCompiler(SH_FRAGMENT_SHADER, spec, SH_ESSL_OUTPUT, &resources);
+    }
+
+    bool compile(const std::string &source, int compileOptions, std::string *objectCode)
+    {
+        const char *sourceStrings[] = { source.c_str() };
+        if (!ShCompile(mCompiler, sourceStrings, 1, SH_OBJECT_CODE | SH_VARIABLES | compileOptions))
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        ShGetInfo(mCompiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> buffer(length);
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        *objectCode = &buffer[0];
+        return true;
+    }
+
+    int getActiveUniformCount()
+    {
+        size_t count = 0;
+        ShGetInfo(mCompiler, SH_ACTIVE_UNIFORMS, &count);
+        return static_cast<int>(count);
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(PruneUnusedDeclarationsTest, RemovesWhatMainDoesNotUse)
+{
+    const std::string source =
+        "precision mediump float;\n"
+        "struct UsedStruct { float value; };\n"
+        "struct UnusedStruct { float value; };\n"
+        "struct TypeOfUnusedGlobal { float value; } unusedStructGlobal;\n"
+        "uniform float u_unreferenced;\n"
+        "float usedGlobal = 1.0, unusedGlobal = 2.0;\n"
+        "float unusedFunction(float x);\n"
+        "float calledFunction(UsedStruct s);\n"
+        "float unusedFunction(float x) { return x + unusedGlobal + u_unreferenced; }\n"
+        "float calledFunction(UsedStruct s) { return s.value * usedGlobal; }\n"
+        "float unusedOverload(UsedStruct s) { return s.value; }\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(calledFunction(UsedStruct(0.5)));\n"
+        "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(source, 0, &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("unusedFunction"));
+    EXPECT_NE(std::string::npos, objectCode.find("unusedGlobal"));
+
+    ASSERT_TRUE(compile(source, SH_PRUNE_UNUSED_DECLARATIONS, &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("calledFunction"));
+    EXPECT_NE(std::string::npos, objectCode.find("usedGlobal"));
+    EXPECT_NE(std::string::npos, objectCode.find("UsedStruct"));
+    EXPECT_NE(std::string::npos, objectCode.find("u_unreferenced"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedFunction"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedOverload"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedGlobal"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedStructGlobal"));
+    EXPECT_EQ(std::string::npos, objectCode.find("UnusedStruct"));
+    EXPECT_EQ(std::string::npos, objectCode.find("TypeOfUnusedGlobal"));
+}
+
+TEST_F(PruneUnusedDeclarationsTest, KeepsCalleesAndInitializers)
+{
+    const std::string source =
+        "precision mediump float;\n"
+        "struct Inner { float value; };\n"
+        "struct Outer { Inner inner; };\n"
+        "uniform float u_scale;\n"
+        "float base = 1.0;\n"
+        "float scale = 2.0, scaled = scale;\n"
+        "float leaf(Outer o) { return o.inner.value * scaled; }\n"
+        "float middle(float x) { return leaf(Outer(Inner(x))) + base; }\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(middle(u_scale));\n"
+        "}\n";
+
+    std::string unpruned;
+    ASSERT_TRUE(compile(source, 0, &unpruned));
+
+    std::string pruned;
+    ASSERT_TRUE(compile(source, SH_PRUNE_UNUSED_DECLARATIONS, &pruned));
+    EXPECT_EQ(unpruned, pruned);
+}
+
+TEST_F(PruneUnusedDeclarationsTest, ReportsVariablesOfRemovedCode)
+{
+    const std::string source =
+        "precision mediump float;\n"
+        "uniform float u_used;\n"
+        "uniform float u_usedByUnusedFunction;\n"
+        "float unusedFunction() { return u_usedByUnusedFunction; }\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(u_used);\n"
+        "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(source, 0, &objectCode));
+    int unprunedUniformCount = getActiveUniformCount();
+
+    ASSERT_TRUE(compile(source, SH_PRUNE_UNUSED_DECLARATIONS, &objectCode));
+    EXPECT_EQ(unprunedUniformCount, getActiveUniformCount());
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedFunction"));
+}
+
+TEST_F(PruneUnusedDeclarationsTest, KeepsRenamedCSSShaderEntryPoint)
+{
+    ShDestruct(mCompiler);
+    mCompiler = constructCompiler(SH_CSS_SHADERS_SPEC);
+    ASSERT_TRUE(mCompiler != NULL);
+
+    const std::string source =
+        "precision mediump float;\n"
+        "float usedFunction() { return 0.5; }\n"
+        "float unusedFunction() { return 0.25; }\n"
+        "void main()\n"
+        "{\n"
+        "    css_MixColor = vec4(usedFunction());\n"
+        "}\n";
+
+    std::string objectCode;
+    ASSERT_TRUE(compile(source, SH_PRUNE_UNUSED_DECLARATIONS, &objectCode));
+    EXPECT_NE(std::string::npos, objectCode.find("void css_main("));
+    EXPECT_NE(std::string::npos, objectCode.find("usedFunction"));
+    EXPECT_EQ(std::string::npos, objectCode.find("unusedFunction"));
+}
+
+TEST_F(PruneUnusedDeclarationsTest, SharedLibraryOutputSize)
+{
+    // Every shader includes the same library of functions and uses a few of them
+    const int libraryFunctionCount = 64;
+
+    std::stringstream library;
+    library << "precision mediump float;\n"
+               "uniform vec4 u_parameters;\n"
+               "varying vec2 v_coord;\n";
+    for (int function = 0; function < libraryFunctionCount; function++)
+    {
+        library << "vec4 lib_constant" << function << " = vec4(" << function << ".0);\n"
+                << "vec4 lib_function" << function << "(vec2 coord)\n"
+                << "{\n"
+                << "    vec4 color = lib_constant" << function << " * u_parameters;\n"
+                << "    color.xy += coord * " << function << ".0;\n"
+                << "    return clamp(color, 0.0, 1.0);\n"
+                << "}\n";
+    }
+
+    const int usedFunctionCounts[] = { 1, 4, 16 };
+    for (size_t shader = 0; shader < sizeof(usedFunctionCounts) / sizeof(usedFunctionCounts[0]); shader++)
+    {
+        std::stringstream source;
+        source << library.str()
+               << "void main()\n"
+               << "{\n"
+               << "    vec4 color = vec4(0.0);\n";
+        for (int function = 0; function < usedFunctionCounts[shader]; function++)
+        {
+            source << "    color += lib_function" << (function * 3) << "(v_coord);\n";
+        }
+        source << "    gl_FragColor = color;\n"
+               << "}\n";
+
+        std::string unpruned;
+        ASSERT_TRUE(compile(source.str(), 0, &unpruned));
+
+        std::string pruned;
+        ASSERT_TRUE(compile(source.str(), SH_PRUNE_UNUSED_DECLARATIONS, &pruned));
+        EXPECT_LT(pruned.size(), unpruned.size());
+
+        // The unused functions and their constants are gone, the used ones are kept
+        EXPECT_NE(std::string::npos, pruned.find("lib_function0("));
+        EXPECT_EQ(std::string::npos, pruned.find("lib_function1("));
+        EXPECT_EQ(std::string::npos, pruned.find("lib_constant1 "));
+        EXPECT_NE(std::string::npos, unpruned.find("lib_constant1 "));
+    }
+}
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderPermutations_test.cpp:
+//   Tests that compiling the permutations of a shader body gives the same
+//   results as compiling each one with its macros defined in the source, that
+//   results are only reused when the body can't tell the permutations apart,
+//   and that macros which #define would reject are rejected.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const char kBody[] =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "varying vec2 v_texCoord;\n"
+    "#ifdef USE_TEXTURE\n"
+    "uniform sampler2D u_texture;\n"
+    "#ifdef USE_ALPHA_TEST\n"
+    "uniform float u_alphaRef;\n"
+    "#endif\n"
+    "#endif\n"
+    "#if LIGHT_COUNT > 1\n"
+    "uniform vec3 u_lights[LIGHT_COUNT];\n"
+    "#endif\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 color = u_color;\n"
+    "#ifdef USE_TEXTURE\n"
+    "    color *= texture2D(u_texture, v_texCoord);\n"
+    "#ifdef USE_ALPHA_TEST\n"
+    "    if (color.a < u_alphaRef) discard;\n"
+    "#endif\n"
+    "#endif\n"
+    "#if LIGHT_COUNT > 1\n"
+    "    for (int i = 0; i < LIGHT_COUNT; i++)\n"
+    "        color.rgb += u_lights[i] * SCALE;\n"
+    "#endif\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+class ShaderPermutationsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+
+        const char *body = kBody;
+        ASSERT_TRUE(ShSetPermutationBody(mCompiler, &body, 1) != 0);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    size_t getInfo(ShShaderInfo pname)
+    {
+        size_t value = 0;
+        ShGetInfo(mCompiler, pname, &value);
+        return value;
+    }
+
+    std::string getObjectCode()
+    {
+        std::vector<char> buffer(getInfo(SH_OBJECT_CODE_LENGTH));
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        return &buffer[0];
+    }
+
+    // Compiles the permutation both ways and checks they give the same results.
+    void compile(const ShMacroDefinition *definitions, size_t count)
+    {
+        std::stringstream prelude;
+        for (size_t i = 0; i < count; i++)
+            prelude << "#define " << definitions[i].name << " " << definitions[i].value << "\n";
+        std::string preludeString = prelude.str();
+        const char *shaderStrings[] = { preludeString.c_str(), kBody };
+
+        int compileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+        int naiveSuccess = ShCompile(mCompiler, shaderStrings, 2, compileOptions);
+        std::string naiveCode = getObjectCode();
+        size_t naiveUniforms = getInfo(SH_ACTIVE_UNIFORMS);
+
+        int success = ShCompilePermutation(mCompiler, definitions, count, compileOptions);
+        EXPECT_EQ(naiveSuccess, success) << preludeString;
+        EXPECT_EQ(naiveCode, getObjectCode()) << preludeString;
+        EXPECT_EQ(naiveUniforms, getInfo(SH_ACTIVE_UNIFORMS)) << preludeString;
+    }
+
+    ShHandle mCompiler;
+};
+
+}
+
+TEST_F(ShaderPermutationsTest, SameResultsAsDefinesInSource)
+{
+    const ShMacroDefinition none[] = { { "SCALE", "1.0" } };
+    const ShMacroDefinition texture[] = { { "USE_TEXTURE", "" }, { "SCALE", "1.0" } };
+    const ShMacroDefinition alphaTest[] = { { "USE_TEXTURE", "" }, { "USE_ALPHA_TEST", "1" }, { "SCALE", "1.0" } };
+    const ShMacroDefinition lights[] = { { "LIGHT_COUNT", "4" }, { "SCALE", "0.5" } };
+    const ShMacroDefinition undeclared[] = { { "LIGHT_COUNT", "2" } };
+
+    compile(none, 1);
+    compile(texture, 2);
+    compile(alphaTest, 3);
+    compile(lights, 2);
+    compile(undeclared, 1);
+    EXPECT_EQ(0u, getInfo(SH_REUSED_PERMUTATIONS));
+}
+
+TEST_F(ShaderPermutationsTest, ReusesWhenSkippedMacrosDiffer)
+{
+    const ShMacroDefinition base[] = { { "SCALE", "1.0" } };
+    compile(base, 1);
+
+    // SCALE and USE_ALPHA_TEST are only inside skipped groups.
+    const ShMacroDefinition otherScale[] = { { "SCALE", "2.0" } };
+    compile(otherScale, 1);
+    const ShMacroDefinition alphaTest[] = { { "USE_ALPHA_TEST", "" } };
+    compile(alphaTest, 1);
+    EXPECT_EQ(2u, getInfo(SH_REUSED_PERMUTATIONS));
+
+    // The first two macros are looked up, so these are compiled.
+    const ShMacroDefinition texture[] = { { "USE_TEXTURE", "" } };
+    compile(texture, 1);
+    const ShMacroDefinition oneLight[] = { { "LIGHT_COUNT", "1" } };
+    compile(oneLight, 1);
+    EXPECT_EQ(2u, getInfo(SH_REUSED_PERMUTATIONS));
+
+    // Once the group is compiled, SCALE is looked up too.
+    const ShMacroDefinition twoLights[] = { { "LIGHT_COUNT", "2" }, { "SCALE", "1.0" } };
+    compile(twoLights, 2);
+    const ShMacroDefinition twoDimLights[] = { { "LIGHT_COUNT", "2" }, { "SCALE", "0.5" } };
+    compile(twoDimLights, 2);
+    compile(twoLights, 2);
+    EXPECT_EQ(3u, getInfo(SH_REUSED_PERMUTATIONS));
+
+    // A new body forgets the earlier permutations.
+    const char *body = kBody;
+    ASSERT_TRUE(ShSetPermutationBody(mCompiler, &body, 1) != 0);
+    EXPECT_EQ(0u, getInfo(SH_REUSED_PERMUTATIONS));
+    compile(base, 1);
+    EXPECT_EQ(0u, getInfo(SH_REUSED_PERMUTATIONS));
+}
+
+TEST_F(ShaderPermutationsTest, RejectsPredefinedAndReservedNames)
+{
+    // Defining these in the source fails too, so compile() checks both ways.
+    const ShMacroDefinition predefined[] = { { "GL_ES", "0" }, { "SCALE", "1.0" } };
+    compile(predefined, 2);
+    EXPECT_EQ(0, ShCompilePermutation(mCompiler, predefined, 2, SH_OBJECT_CODE));
+    std::vector<char> infoLog(getInfo(SH_INFO_LOG_LENGTH));
+    ShGetInfoLog(mCompiler, &infoLog[0]);
+    EXPECT_NE(std::string::npos, std::string(&infoLog[0]).find("GL_ES"));
+
+    const ShMacroDefinition reserved[] = { { "GL_USE_TEXTURE", "" }, { "SCALE", "1.0" } };
+    compile(reserved, 2);
+    EXPECT_EQ(0, ShCompilePermutation(mCompiler, reserved, 2, SH_OBJECT_CODE));
+
+    const ShMacroDefinition doubleUnderscore[] = { { "USE__TEXTURE", "" }, { "SCALE", "1.0" } };
+    compile(doubleUnderscore, 2);
+    EXPECT_EQ(0, ShCompilePermutation(mCompiler, doubleUnderscore, 2, SH_OBJECT_CODE));
+}
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TypeDescriptors_test.cpp:
+//   Tests the shared type descriptors and resolving function calls by the
+//   hash of their mangled names.
+//
+
+#include <string>
+#include "compiler/translator/ShHandle.h"
+#include "compiler/translator/SymbolTable.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class TypeDescriptorsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        mPreviousAllocator = GetGlobalPoolAllocator();
+        SetGlobalPoolAllocator(&mAllocator);
+        mAllocator.push();
+    }
+
+    virtual void TearDown()
+    {
+        mAllocator.pop();
+        SetGlobalPoolAllocator(mPreviousAllocator);
+    }
+
+    TPoolAllocator mAllocator;
+    TPoolAllocator *mPreviousAllocator;
+};
+
+struct Call
+{
+    const char *name;
+    TType arguments[3];
+    size_t argumentCount;
+};
+
+TFunction *CreateCall(const Call &call)
+{
+    TType returnType(EbtVoid, EbpUndefined);
+    TFunction *function = new TFunction(NewPoolTString(call.name), returnType);
+    for (size_t i = 0; i < call.argumentCount; i++)
+    {
+        TParameter parameter = { NULL, new TType(call.arguments[i]) };
+        function->addParameter(parameter);
+    }
+    return function;
+}
+
+}
+
+TEST_F(TypeDescriptorsTest, IdenticalTypesShareDescriptors)
+{
+    TType vec4(EbtFloat, EbpHigh, EvqUniform, 4);
+    TType otherVec4(EbtFloat, EbpLow, EvqTemporary, 4);
+    TType mat2x3(EbtFloat, EbpMedium, EvqTemporary, 2, 3);
+    TType ivec4(EbtInt, EbpHigh, EvqTemporary, 4);
+    TType sampler(EbtSampler2D, EbpLow, EvqUniform);
+
+    ASSERT_TRUE(vec4.getDescriptor() != NULL);
+    EXPECT_EQ(vec4.getDescriptor(), otherVec4.getDescriptor());
+    EXPECT_NE(vec4.getDescriptor(), ivec4.getDescriptor());
+    EXPECT_TRUE(vec4.sameMangledName(otherVec4));
+    EXPECT_FALSE(vec4.sameMangledName(ivec4));
+
+    EXPECT_EQ("vf4;", std::string(vec4.getMangledName().c_str()));
+    EXPECT_EQ("mf2x3;", std::string(mat2x3.getMangledName().c_str()));
+    EXPECT_EQ("s21;", std::string(sampler.getMangledName().c_str()));
+    EXPECT_EQ(TType::HashMangledName("vf4;", 4), vec4.getMangledNameHash());
+}
+
+TEST_F(TypeDescriptorsTest, ArraysAndStructuresAreNotShared)
+{
+    TType array(EbtFloat, EbpHigh, EvqTemporary, 4);
+    array.setArraySize(3);
+    EXPECT_TRUE(array.getDescriptor() == NULL);
+    EXPECT_EQ("vf4[3];", std::string(array.getMangledName().c_str()));
+    EXPECT_EQ(TType::HashMangledName("vf4[3];", 7), array.getMangledNameHash());
+
+    TFieldList *fields = NewPoolTFieldList();
+    TSourceLoc line = {};
+    fields->push_back(new TField(new TType(EbtFloat, EbpHigh), NewPoolTString("x"), line));
+    TType structure(new TStructure(NewPoolTString("S"), fields));
+    EXPECT_TRUE(structure.getDescriptor() == NULL);
+    EXPECT_FALSE(structure.sameMangledName(TType(EbtFloat, EbpHigh)));
+    EXPECT_TRUE(structure.sameMangledName(TType(structure)));
+}
+
+TEST_F(TypeDescriptorsTest, OverloadedBuiltInResolution)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle handle = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+    ASSERT_TRUE(handle != NULL);
+    TSymbolTable &symbolTable = static_cast<TShHandleBase*>(handle)->getAsCompiler()->getSymbolTable();
+
+    TType vec2(EbtFloat, EbpHigh, EvqTemporary, 2);
+    TType vec3(EbtFloat, EbpHigh, EvqTemporary, 3);
+    TType vec4(EbtFloat, EbpHigh, EvqTemporary, 4);
+    TType scalar(EbtFloat, EbpHigh, EvqTemporary, 1);
+    TType sampler(EbtSampler2D, EbpLow, EvqUniform);
+    const Call calls[] =
+    {
+        { "max", { vec3, vec3 }, 2 },
+        { "max", { vec3, scalar }, 2 },
+        { "mix", { vec4, vec4, scalar }, 3 },
+        { "mix", { vec2, vec2, vec2 }, 3 },
+        { "clamp", { scalar, scalar, scalar }, 3 },
+        { "clamp", { vec4, scalar, scalar }, 3 },
+        { "texture2D", { sampler, vec2 }, 2 },
+        { "texture2D", { sampler, vec2, scalar }, 3 },
+        { "dot", { vec2, vec2 }, 2 },
+        { "normalize", { vec3 }, 1 },
+    };
+    const size_t callCount = sizeof(calls) / sizeof(calls[0]);
+
+    for (size_t i = 0; i < callCount; i++)
+    {
+        TFunction *call = CreateCall(calls[i]);
+        const TFunction *function = symbolTable.findFunction(*call, 100);
+        ASSERT_TRUE(function != NULL) << calls[i].name;
+        EXPECT_EQ(symbolTable.find(call->getMangledName(), 100), function);
+        delete call;
+    }
+
+    Call noMatch = { "max", { vec3, vec2 }, 2 };
+    TFunction *noMatchCall = CreateCall(noMatch);
+    EXPECT_TRUE(symbolTable.findFunction(*noMatchCall, 100) == NULL);
+    delete noMatchCall;
+
+    ShDestruct(handle);
+}
+
+TEST(TypeDescriptorsCompileTest, UserOverloads)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const char *valid =
+        "precision mediump float;\n"
+        "struct A { float x; };\n"
+        "struct B { float x; };\n"
+        "float f(A a) { return a.x; }\n"
+        "float f(B b) { return -b.x; }\n"
+        "float f(float x[2]) { return x[0] + x[1]; }\n"
+        "float f(vec2 v) { return v.y; }\n"
+        "void main()\n"
+        "{\n"
+        "    float x[2];\n"
+        "    x[0] = 1.0;\n"
+        "    x[1] = 2.0;\n"
+        "    gl_FragColor = vec4(f(A(1.0)), f(B(2.0)), f(x), f(vec2(3.0)));\n"
+        "}\n";
+    EXPECT_TRUE(ShCompile(compiler, &valid, 1, SH_OBJECT_CODE) != 0);
+
+    const char *noMatch =
+        "precision mediump float;\n"
+        "float f(vec2 v) { return v.y; }\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(f(vec3(1.0)));\n"
+        "}\n";
+    EXPECT_EQ(0, ShCompile(compiler, &noMatch, 1, SH_OBJECT_CODE));
+
+    ShDestruct(compiler);
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ASTMetadataHLSL_perftest.cpp:
+//   Measures how translation time grows with the size of deeply nested loops,
+//   which the HLSL metadata passes walk.
+//
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+class ASTMetadataHLSLPerfTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL9_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const std::string &source, std::string *objectCode)
+    {
+        const char *sourceStrings[] = { source.c_str() };
+        if (!ShCompile(mCompiler, sourceStrings, 1, SH_OBJECT_CODE))
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        ShGetInfo(mCompiler, SH_OBJECT_CODE_LENGTH, &length);
+        std::vector<char> buffer(length);
+        ShGetObjectCode(mCompiler, &buffer[0]);
+        *objectCode = &buffer[0];
+        return true;
+    }
+
+    // Nests loopCount loops with statementCount statements each, and a texture lookup in the
+    // innermost one. If discontinuous is set the innermost loop has a break, otherwise only a
+    // loop following the nest has one.
+    std::string generateNestedLoops(int loopCount, int statementCount, bool discontinuous)
+    {
+        std::stringstream stream;
+        stream << "precision mediump float;\n"
+                  "uniform sampler2D u_texture;\n"
+                  "varying vec2 v_coord;\n"
+                  "void main()\n"
+                  "{\n"
+                  "    vec4 color = vec4(0.0);\n";
+        for (int loop = 0; loop < loopCount; loop++)
+        {
+            stream << "for (int i" << loop << " = 0; i" << loop << " < 2; i" << loop << "++) {\n";
+            for (int statement = 0; statement < statementCount; statement++)
+            {
+                stream << "    color.x += color.y * (float(i" << loop << ") + " << statement << ".0);\n";
+            }
+        }
+        stream << "color += texture2D(u_texture, v_coord);\n";
+        if (discontinuous)
+        {
+            stream << "if (color.x > 1.0) break;\n";
+        }
+        for (int loop = 0; loop < loopCount; loop++)
+        {
+            stream << "}\n";
+        }
+        stream << "    for (int j = 0; j < 2; j++) { if (color.y > 1.0) break; color.y += 0.5; }\n"
+                  "    gl_FragColor = color;\n"
+                  "}\n";
+        return stream.str();
+    }
+
+    ShHandle mCompiler;
+};
+
+TEST_F(ASTMetadataHLSLPerfTest, NestedLoopThroughput)
+{
+    // The parser limits how deeply statements nest
+    const int loopCount = 16;
+    const int statementCounts[] = { 100, 200, 400 };
+
+    for (size_t countIndex = 0; countIndex < sizeof(statementCounts) / sizeof(statementCounts[0]); countIndex++)
+    {
+        const std::string source = generateNestedLoops(loopCount, statementCounts[countIndex], false);
+
+        std::string objectCode;
+        clock_t start = clock();
+        ASSERT_TRUE(compile(source, &objectCode));
+        clock_t end = clock();
+        double milliseconds = 1000.0 * static_cast<double>(end - start) / CLOCKS_PER_SEC;
+
+        EXPECT_NE(std::string::npos, objectCode.find("gl_texture2D(_u_texture"));
+        std::cout << loopCount << " nested loops of " << statementCounts[countIndex]
+                  << " statements translated in " << milliseconds << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactTree_perftest.cpp:
+//   Compares the size of a TCompactTree with the intermediate tree it is
+//   built from, and the speed of walking either of them.
+//
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "compiler/translator/CompactTree.h"
+#include "compiler/translator/DetectCallDepth.h"
+#include "compiler/translator/ShHandle.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class TreeCheck
+{
+  public:
+    virtual ~TreeCheck() {}
+    virtual void run(TIntermNode *root) = 0;
+};
+
+// Runs a check on the intermediate tree of the shader instead of translating it.
+class CheckingCompiler : public TCompiler
+{
+  public:
+    explicit CheckingCompiler(TreeCheck *check)
+        : TCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC),
+          mCheck(check)
+    {
+    }
+
+  protected:
+    virtual void translate(TIntermNode *root, int compileOptions)
+    {
+        mCheck->run(root);
+    }
+
+  private:
+    TreeCheck *mCheck;
+};
+
+void CheckTree(const std::string &source, TreeCheck *check)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+
+    CheckingCompiler compiler(check);
+    ASSERT_TRUE(compiler.Init(resources));
+
+    const char *sourceStrings[] = { source.c_str() };
+    ASSERT_TRUE(compiler.compile(sourceStrings, 1, SH_OBJECT_CODE)) << compiler.getInfoSink().info.c_str();
+}
+
+class CountNodes : public TIntermTraverser
+{
+  public:
+    CountNodes() : count(0) {}
+
+    virtual void visitSymbol(TIntermSymbol*) { count++; }
+    virtual void visitConstantUnion(TIntermConstantUnion*) { count++; }
+    virtual bool visitBinary(Visit, TIntermBinary*) { count++; return true; }
+    virtual bool visitUnary(Visit, TIntermUnary*) { count++; return true; }
+    virtual bool visitAggregate(Visit, TIntermAggregate*) { count++; return true; }
+    virtual bool visitSelection(Visit, TIntermSelection*) { count++; return true; }
+    virtual bool visitLoop(Visit, TIntermLoop*) { count++; return true; }
+    virtual bool visitBranch(Visit, TIntermBranch*) { count++; return true; }
+
+    size_t count;
+};
+
+size_t NodeSize(const TCompactNode &node)
+{
+    switch (node.kind)
+    {
+      case EcnSymbol: return sizeof(TIntermSymbol);
+      case EcnConstantUnion: return sizeof(TIntermConstantUnion);
+      case EcnBinary: return sizeof(TIntermBinary);
+      case EcnUnary: return sizeof(TIntermUnary);
+      case EcnAggregate: return sizeof(TIntermAggregate) + node.node->getAsAggregate()->getSequence().size() * sizeof(TIntermNode*);
+      case EcnSelection: return sizeof(TIntermSelection);
+      case EcnLoop: return sizeof(TIntermLoop);
+      default: return sizeof(TIntermBranch);
+    }
+}
+
+class Benchmark : public TreeCheck
+{
+  public:
+    virtual void run(TIntermNode *root)
+    {
+        const int kRepeats = 200;
+
+        clock_t start = clock();
+        TCompactTree compactTree(root);
+        double buildMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        size_t treeBytes = 0;
+        for (size_t i = 0; i < compactTree.size(); i++)
+            treeBytes += NodeSize(compactTree.getNode(i));
+        size_t compactBytes = compactTree.size() * sizeof(TCompactNode) + compactTree.getTypeCount() * sizeof(TType);
+
+        CountNodes treeCount;
+        start = clock();
+        for (int i = 0; i < kRepeats; i++)
+            root->traverse(&treeCount);
+        double treeMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        CountNodes compactCount;
+        start = clock();
+        for (int i = 0; i < kRepeats; i++)
+            compactTree.traverse(&compactCount);
+        double adapterMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        size_t iteratedCount = 0;
+        start = clock();
+        for (int i = 0; i < kRepeats; i++)
+        {
+            for (size_t index = 0; index < compactTree.size(); index++)
+            {
+                if (compactTree.hasType(index) && compactTree.getType(index).getBasicType() == EbtFloat)
+                    iteratedCount++;
+            }
+        }
+        double iterateMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        EXPECT_EQ(treeCount.count, compactCount.count);
+        EXPECT_GT(iteratedCount, 0u);
+        EXPECT_LT(compactBytes, treeBytes);
+
+        std::cout << compactTree.size() << " nodes, " << compactTree.getTypeCount() << " types, built in "
+                  << buildMilliseconds << " ms\n"
+                  << "Bytes per node: " << static_cast<double>(treeBytes) / compactTree.size() << " in the tree, "
+                  << static_cast<double>(compactBytes) / compactTree.size() << " compact\n"
+                  << kRepeats << " traversals: " << treeMilliseconds << " ms virtual, "
+                  << adapterMilliseconds << " ms through the adapter, "
+                  << iterateMilliseconds << " ms iterating" << std::endl;
+    }
+};
+
+// Compares the recursion check, which builds the call graph in one traversal,
+// with building a compact tree of the same shader. The check runs on every
+// compile, so building a compact tree for it alone would cost more than it saves.
+class CallGraphBenchmark : public TreeCheck
+{
+  public:
+    virtual void run(TIntermNode *root)
+    {
+        const int kRepeats = 200;
+
+        TInfoSink infoSink;
+        clock_t start = clock();
+        for (int i = 0; i < kRepeats; i++)
+        {
+            DetectCallDepth detect(infoSink, true, 64);
+            root->traverse(&detect);
+            ASSERT_EQ(DetectCallDepth::kErrorNone, detect.detectCallDepth());
+        }
+        double callGraphMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        size_t nodeCount = 0;
+        start = clock();
+        for (int i = 0; i < kRepeats; i++)
+        {
+            TCompactTree compactTree(root);
+            nodeCount += compactTree.size();
+        }
+        double buildMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        EXPECT_GT(nodeCount, 0u);
+
+        std::cout << kRepeats << " call graphs built in " << callGraphMilliseconds << " ms, "
+                  << kRepeats << " compact trees in " << buildMilliseconds << " ms" << std::endl;
+    }
+};
+
+std::string GenerateShader(int statementCount)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 u_color;\n"
+              "uniform sampler2D u_texture;\n"
+              "varying vec2 v_texCoord;\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 color = u_color;\n";
+    for (int i = 0; i < statementCount; i++)
+    {
+        source << "    color = color * " << i << ".0 + texture2D(u_texture, v_texCoord * float(" << i << "));\n"
+                  "    if (color.x > " << i << ".0) color.yz = normalize(color.zy);\n";
+    }
+    source << "    gl_FragColor = color;\n"
+              "}\n";
+    return source.str();
+}
+
+// Chains functionCount functions, each calling the previous one a few times.
+std::string GenerateFunctions(int functionCount)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "varying vec2 v_texCoord;\n"
+              "float f0(float x) { return x * 0.5; }\n";
+    for (int i = 1; i < functionCount; i++)
+    {
+        source << "float f" << i << "(float x) { return f" << (i - 1) << "(x) + f" << (i - 1)
+               << "(x * 2.0) + " << i << ".0; }\n";
+    }
+    source << "void main()\n"
+              "{\n"
+              "    gl_FragColor = vec4(f" << (functionCount - 1) << "(v_texCoord.x));\n"
+              "}\n";
+    return source.str();
+}
+
+}
+
+TEST(CompactTreePerfTest, LargeShader)
+{
+    Benchmark check;
+    CheckTree(GenerateShader(2000), &check);
+}
+
+TEST(CompactTreePerfTest, CallGraph)
+{
+    CallGraphBenchmark check;
+    CheckTree(GenerateFunctions(40), &check);
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// HLSLCache_perftest.cpp:
+//   Measures what linking many programs costs in the link-stage HLSL caches of DynamicHLSL.
+//   Generating the HLSL itself needs a Direct3D renderer, so each link here builds the
+//   signature of its varyings and finds or inserts text of a typical size.
+//
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "libGLESv2/HLSLCache.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const int kVaryingCount = 8;
+
+// Builds the key of a varying packing as DynamicHLSL::generateVaryingHLSL does
+std::string VaryingSignature(int interfaceIndex)
+{
+    gl::HLSLSignature signature;
+    signature.addInt(kVaryingCount);
+    for (int varying = 0; varying < kVaryingCount; varying++)
+    {
+        std::ostringstream name;
+        name << "v_varying" << varying << "_" << interfaceIndex;
+
+        signature.addInt(0x8B52);
+        signature.addInt(1);
+        signature.addInt(varying);
+        signature.addInt(0);
+        signature.addString(name.str());
+        signature.addString("");
+    }
+    return signature.key();
+}
+
+struct LinkResult
+{
+    LinkResult() : hits(0), misses(0), milliseconds(0.0) {}
+
+    int hits;
+    int misses;
+    double milliseconds;
+};
+
+// Links programCount programs cycling through interfaceCount varying packings
+LinkResult LinkPrograms(int programCount, int interfaceCount)
+{
+    gl::HLSLCache<std::string> cache;
+    const std::string generatedHLSL(2048, ' ');
+
+    LinkResult result;
+    clock_t start = clock();
+    for (int program = 0; program < programCount; program++)
+    {
+        std::string key = VaryingSignature(program % interfaceCount);
+
+        std::string hlsl;
+        if (cache.find(key, &hlsl))
+        {
+            result.hits++;
+        }
+        else
+        {
+            cache.insert(key, generatedHLSL);
+            result.misses++;
+        }
+    }
+    result.milliseconds = 1000.0 * static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+    return result;
+}
+
+}
+
+TEST(HLSLCachePerfTest, LinkManyPrograms)
+{
+    const int programCount = 20000;
+
+    // Few interfaces shared by every program, and more interfaces than the cache holds
+    LinkResult shared = LinkPrograms(programCount, 16);
+    LinkResult distinct = LinkPrograms(programCount, static_cast<int>(gl::HLSLCache<std::string>::kMaxEntries) * 2);
+
+    EXPECT_EQ(16, shared.misses);
+    EXPECT_EQ(programCount, distinct.misses);
+
+    std::cout << programCount << " links with 16 shared interfaces: " << shared.milliseconds << " ms, "
+              << shared.hits << " hits\n"
+              << programCount << " links with " << gl::HLSLCache<std::string>::kMaxEntries * 2
+              << " interfaces: " << distinct.milliseconds << " ms, " << distinct.misses << " misses" << std::endl;
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ObjectCode_perftest.cpp:
+//   Measures how fast the translator produces object code, and how much of it
+//   the compiler holds on to when it is retained versus streamed.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+// A shader with many constants, so number formatting dominates the output
+std::string GenerateShader(int statementCount)
+{
+    std::stringstream stream;
+    stream << "precision mediump float;\n"
+              "uniform vec4 u_color;\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 color = u_color;\n";
+    for (int statement = 0; statement < statementCount; statement++)
+    {
+        stream << "    color = color * vec4(" << statement << ".25, " << statement << ".0, 0.125, 1.5) + vec4("
+               << statement % 7 << ".0);\n";
+    }
+    stream << "    gl_FragColor = color;\n"
+              "}\n";
+    return stream.str();
+}
+
+bool Compile(ShHandle compiler, const std::string &source)
+{
+    const char *sourceStrings[] = { source.c_str() };
+    return ShCompile(compiler, sourceStrings, 1, SH_OBJECT_CODE) != 0;
+}
+
+struct StreamedObjectCode
+{
+    StreamedObjectCode() : largestPiece(0) {}
+
+    std::string objectCode;
+    size_t largestPiece;
+};
+
+void AppendStreamedObjectCode(const char *objectCode, size_t length, void *userData)
+{
+    StreamedObjectCode *streamed = static_cast<StreamedObjectCode*>(userData);
+    streamed->objectCode.append(objectCode, length);
+    streamed->largestPiece = std::max(streamed->largestPiece, length);
+}
+
+}
+
+TEST(ObjectCodePerfTest, OutputThroughput)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL11_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != NULL);
+
+    const std::string source = GenerateShader(2000);
+    const int iterations = 20;
+
+    size_t totalLength = 0;
+    clock_t start = clock();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        ASSERT_TRUE(Compile(compiler, source));
+
+        void *objectCode = NULL;
+        ShGetInfoPointer(compiler, SH_OBJECT_CODE_POINTER, &objectCode);
+        totalLength += strlen(static_cast<const char*>(objectCode));
+    }
+    clock_t end = clock();
+
+    double seconds = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::cout << "Generated " << totalLength / 1024 << " KB of HLSL in " << seconds * 1000.0 << " ms ("
+              << (seconds > 0.0 ? totalLength / (1024.0 * 1024.0) / seconds : 0.0) << " MB/s), retaining "
+              << totalLength / iterations / 1024 << " KB per compile" << std::endl;
+
+    StreamedObjectCode streamed;
+    ShSetObjectCodeCallback(compiler, AppendStreamedObjectCode, &streamed);
+    start = clock();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        streamed.objectCode.clear();
+        ASSERT_TRUE(Compile(compiler, source));
+    }
+    end = clock();
+    ShSetObjectCodeCallback(compiler, NULL, NULL);
+
+    seconds = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::cout << "Streamed the same HLSL in " << seconds * 1000.0 << " ms, retaining at most "
+              << streamed.largestPiece / 1024 << " KB per compile" << std::endl;
+
+    ShDestruct(compiler);
+}
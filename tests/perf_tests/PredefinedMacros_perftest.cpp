@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PredefinedMacros_perftest.cpp:
+//   Measures how much starting from a snapshot of the predefined macros saves
+//   per compile of a small shader.
+//
+
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Macro.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+#include "compiler/translator/Initialize.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class PredefinedMacrosPerfTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShInitBuiltInResources(&mResources);
+        mResources.OES_standard_derivatives = 1;
+        mResources.FragmentPrecisionHigh = 1;
+
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &mResources);
+        ASSERT_TRUE(mCompiler != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const char *source)
+    {
+        return ShCompile(mCompiler, &source, 1, SH_OBJECT_CODE) != 0;
+    }
+
+    ShBuiltInResources mResources;
+    ShHandle mCompiler;
+};
+
+class NullDiagnostics : public pp::Diagnostics
+{
+  protected:
+    virtual void print(ID id, const pp::SourceLocation &loc, const std::string &text) {}
+};
+
+class NullDirectiveHandler : public pp::DirectiveHandler
+{
+  public:
+    virtual void handleError(const pp::SourceLocation &loc, const std::string &msg) {}
+    virtual void handlePragma(const pp::SourceLocation &loc, const std::string &name, const std::string &value) {}
+    virtual void handleExtension(const pp::SourceLocation &loc, const std::string &name, const std::string &behavior) {}
+    virtual void handleVersion(const pp::SourceLocation &loc, int version) {}
+};
+
+// Predefines the macros as the first compile of a compiler does.
+void PredefineMacros(pp::Preprocessor *preprocessor, const TExtensionBehavior &extensionBehavior)
+{
+    for (TExtensionBehavior::const_iterator iter = extensionBehavior.begin(); iter != extensionBehavior.end(); ++iter)
+        preprocessor->predefineMacro(iter->first.c_str(), 1);
+    preprocessor->predefineMacro("GL_FRAGMENT_PRECISION_HIGH", 1);
+}
+
+size_t Preprocess(pp::Preprocessor *preprocessor)
+{
+    size_t count = 0;
+    pp::Token token;
+    for (preprocessor->lex(&token); token.type != pp::Token::LAST; preprocessor->lex(&token))
+        count++;
+    return count;
+}
+
+}
+
+TEST_F(PredefinedMacrosPerfTest, SmallShader)
+{
+    TExtensionBehavior extensionBehavior;
+    InitExtensionBehavior(mResources, extensionBehavior);
+    const char *shader =
+        "precision mediump float;\n"
+        "uniform vec4 u_color;\n"
+        "void main() { gl_FragColor = u_color; }\n";
+    const int kCompiles = 20000;
+
+    NullDiagnostics diagnostics;
+    NullDirectiveHandler directiveHandler;
+
+    std::auto_ptr<pp::MacroSnapshot> snapshot;
+    {
+        pp::Preprocessor preprocessor(&diagnostics, &directiveHandler);
+        ASSERT_TRUE(preprocessor.init(0, NULL, NULL));
+        PredefineMacros(&preprocessor, extensionBehavior);
+        snapshot.reset(preprocessor.snapshotMacros());
+    }
+
+    size_t predefinedTokens = 0;
+    clock_t start = clock();
+    for (int i = 0; i < kCompiles; i++)
+    {
+        pp::Preprocessor preprocessor(&diagnostics, &directiveHandler);
+        ASSERT_TRUE(preprocessor.init(1, &shader, NULL));
+        PredefineMacros(&preprocessor, extensionBehavior);
+        predefinedTokens += Preprocess(&preprocessor);
+    }
+    double predefinedMicroseconds = 1000000.0 * (clock() - start) / CLOCKS_PER_SEC / kCompiles;
+
+    size_t snapshotTokens = 0;
+    start = clock();
+    for (int i = 0; i < kCompiles; i++)
+    {
+        pp::Preprocessor preprocessor(&diagnostics, &directiveHandler);
+        preprocessor.startFromMacros(snapshot.get());
+        ASSERT_TRUE(preprocessor.init(1, &shader, NULL));
+        snapshotTokens += Preprocess(&preprocessor);
+    }
+    double snapshotMicroseconds = 1000000.0 * (clock() - start) / CLOCKS_PER_SEC / kCompiles;
+
+    EXPECT_EQ(predefinedTokens, snapshotTokens);
+
+    const int kShCompiles = 2000;
+    start = clock();
+    for (int i = 0; i < kShCompiles; i++)
+        ASSERT_TRUE(compile(shader));
+    double compileMicroseconds = 1000000.0 * (clock() - start) / CLOCKS_PER_SEC / kShCompiles;
+
+    std::cout << snapshot->size() << " predefined macros. Preprocessing a small shader takes "
+              << predefinedMicroseconds << " us predefining them, " << snapshotMicroseconds
+              << " us from the snapshot; the whole compile takes " << compileMicroseconds << " us" << std::endl;
+}
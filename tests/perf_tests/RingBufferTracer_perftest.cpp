@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RingBufferTracer_perftest.cpp:
+//   Compares recording entry points with gl::RingBufferTracer against appending
+//   them to a text file, as the TRACE path did before.
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include "common/RingBufferTracer.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+void Begin(gl::RingBufferTracer *tracer, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    tracer->beginEvent(format, arguments);
+    va_end(arguments);
+}
+
+std::string TempPath(const char *name)
+{
+#if defined(_WIN32)
+    char directory[MAX_PATH];
+    DWORD length = GetTempPathA(MAX_PATH, directory);
+    return std::string(directory, length) + name;
+#else
+    const char *directory = getenv("TMPDIR");
+    return std::string(directory ? directory : "/tmp") + "/" + name;
+#endif
+}
+
+}
+
+TEST(RingBufferTracerPerfTest, BinaryAgainstTextFile)
+{
+    const int drawCount = 20000;
+    const std::string tracePath = TempPath("RingBufferTracer_perftest.angletrace");
+    const std::string textPath = TempPath("RingBufferTracer_perftest.txt");
+
+    clock_t start = clock();
+    {
+        gl::RingBufferTracer tracer(tracePath.c_str(), 1 << 20, 10);
+        tracer.startFlusher();
+        for (int draw = 0; draw < drawCount; draw++)
+        {
+            Begin(&tracer, "glDrawArrays(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d)", 4, draw, 3);
+            tracer.endEvent();
+        }
+        tracer.stopFlusher();
+    }
+    clock_t binaryTicks = clock() - start;
+
+    start = clock();
+    for (int draw = 0; draw < drawCount; draw++)
+    {
+        // What the TRACE path did for every entry point
+        FILE *file = fopen(textPath.c_str(), "a");
+        ASSERT_TRUE(file != NULL);
+        fprintf(file, "glDrawArrays(GLenum mode = 0x%X, GLint first = %d, GLsizei count = %d)\n", 4, draw, 3);
+        fclose(file);
+    }
+    clock_t textTicks = clock() - start;
+
+    remove(textPath.c_str());
+    remove(tracePath.c_str());
+
+    std::cout << drawCount << " draws traced in " << 1000.0 * binaryTicks / CLOCKS_PER_SEC << " ms in binary, "
+              << 1000.0 * textTicks / CLOCKS_PER_SEC << " ms as text" << std::endl;
+}
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderPermutations_perftest.cpp:
+//   Compares compiling the permutations of a shader body with their macros
+//   defined in the source and with ShCompilePermutation, both when results
+//   can be reused and when every permutation changes a macro the body uses.
+//
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GLSLANG/ShaderLang.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const char kBody[] =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "varying vec2 v_texCoord;\n"
+    "#ifdef USE_TEXTURE\n"
+    "uniform sampler2D u_texture;\n"
+    "#ifdef USE_ALPHA_TEST\n"
+    "uniform float u_alphaRef;\n"
+    "#endif\n"
+    "#endif\n"
+    "#if LIGHT_COUNT > 1\n"
+    "uniform vec3 u_lights[LIGHT_COUNT];\n"
+    "#endif\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 color = u_color;\n"
+    "#ifdef USE_TEXTURE\n"
+    "    color *= texture2D(u_texture, v_texCoord);\n"
+    "#ifdef USE_ALPHA_TEST\n"
+    "    if (color.a < u_alphaRef) discard;\n"
+    "#endif\n"
+    "#endif\n"
+    "#if LIGHT_COUNT > 1\n"
+    "    for (int i = 0; i < LIGHT_COUNT; i++)\n"
+    "        color.rgb += u_lights[i] * SCALE;\n"
+    "#endif\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+typedef std::vector<std::vector<ShMacroDefinition> > Permutations;
+
+class ShaderPermutationsPerfTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(SH_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_OUTPUT, &resources);
+        ASSERT_TRUE(mCompiler != NULL);
+
+        const char *body = kBody;
+        ASSERT_TRUE(ShSetPermutationBody(mCompiler, &body, 1) != 0);
+    }
+
+    virtual void TearDown()
+    {
+        ShDestruct(mCompiler);
+    }
+
+    size_t getInfo(ShShaderInfo pname)
+    {
+        size_t value = 0;
+        ShGetInfo(mCompiler, pname, &value);
+        return value;
+    }
+
+    // Every combination of the light counts, the scales and the flags, where
+    // bit 0 defines USE_TEXTURE and bit 1 USE_ALPHA_TEST.
+    static Permutations GeneratePermutations(const char *const *lightCounts, size_t lightCountCount,
+                                             const char *const *scales, size_t scaleCount,
+                                             const int *flagSets, size_t flagSetCount)
+    {
+        Permutations permutations;
+        for (size_t flagSet = 0; flagSet < flagSetCount; flagSet++)
+        {
+            int flags = flagSets[flagSet];
+            for (size_t light = 0; light < lightCountCount; light++)
+            {
+                for (size_t scale = 0; scale < scaleCount; scale++)
+                {
+                    std::vector<ShMacroDefinition> definitions;
+                    ShMacroDefinition lightCount = { "LIGHT_COUNT", lightCounts[light] };
+                    ShMacroDefinition scaleValue = { "SCALE", scales[scale] };
+                    definitions.push_back(lightCount);
+                    definitions.push_back(scaleValue);
+                    if (flags & 1)
+                    {
+                        ShMacroDefinition useTexture = { "USE_TEXTURE", "" };
+                        definitions.push_back(useTexture);
+                    }
+                    if (flags & 2)
+                    {
+                        ShMacroDefinition useAlphaTest = { "USE_ALPHA_TEST", "" };
+                        definitions.push_back(useAlphaTest);
+                    }
+                    permutations.push_back(definitions);
+                }
+            }
+        }
+        return permutations;
+    }
+
+    // Compiles the permutations rounds times both ways, and returns how many
+    // permutation compiles weren't reused.
+    size_t compare(const Permutations &permutations, int rounds, const char *description)
+    {
+        int compileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+        clock_t start = clock();
+        for (int round = 0; round < rounds; round++)
+        {
+            for (size_t i = 0; i < permutations.size(); i++)
+            {
+                std::stringstream source;
+                for (size_t j = 0; j < permutations[i].size(); j++)
+                    source << "#define " << permutations[i][j].name << " " << permutations[i][j].value << "\n";
+                source << kBody;
+                std::string sourceString = source.str();
+                const char *sourceStrings[] = { sourceString.c_str() };
+                EXPECT_TRUE(ShCompile(mCompiler, sourceStrings, 1, compileOptions) != 0);
+            }
+        }
+        double naiveMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (int round = 0; round < rounds; round++)
+        {
+            for (size_t i = 0; i < permutations.size(); i++)
+            {
+                EXPECT_TRUE(ShCompilePermutation(mCompiler, &permutations[i][0], permutations[i].size(),
+                                                 compileOptions) != 0);
+            }
+        }
+        double permutationMilliseconds = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        size_t compiled = permutations.size() * rounds - getInfo(SH_REUSED_PERMUTATIONS);
+        std::cout << description << ", " << permutations.size() * rounds << " compiles: "
+                  << naiveMilliseconds << " ms with the macros in the source, "
+                  << permutationMilliseconds << " ms with " << compiled
+                  << " compiled and the rest reused" << std::endl;
+        return compiled;
+    }
+
+    ShHandle mCompiler;
+};
+
+}
+
+// Most permutations differ from an earlier one only in macros of skipped
+// groups, and each one is compiled several times.
+TEST_F(ShaderPermutationsPerfTest, RepeatedPermutations)
+{
+    const char *lightCounts[] = { "0", "1", "2", "3", "4", "5", "6", "7" };
+    const char *scales[] = { "0.25", "0.5", "1.0", "2.0" };
+    const int flagSets[] = { 0, 1, 2, 3 };
+    Permutations permutations = GeneratePermutations(lightCounts, 8, scales, 4, flagSets, 4);
+
+    size_t compiled = compare(permutations, 5, "Repeated permutations");
+    EXPECT_LT(compiled, permutations.size());
+}
+
+// Every permutation changes a macro the body uses, so results are reused as
+// a whole only when a permutation is compiled again. This is the cost of
+// recording and comparing the lookups when nothing can be reused.
+TEST_F(ShaderPermutationsPerfTest, PermutationsChangingUsedMacros)
+{
+    const char *lightCounts[] = { "2", "3", "4", "5", "6", "7", "8", "9" };
+    const char *scales[] = { "0.25", "0.5", "1.0", "2.0" };
+    // USE_ALPHA_TEST is only looked up when USE_TEXTURE is defined.
+    const int flagSets[] = { 0, 1, 3 };
+    Permutations permutations = GeneratePermutations(lightCounts, 8, scales, 4, flagSets, 3);
+
+    size_t compiled = compare(permutations, 1, "Permutations changing used macros");
+    EXPECT_EQ(permutations.size(), compiled);
+}
@@ -4,7 +4,11 @@
 // found in the LICENSE file.
 //
 
+#include <memory>
+#include <sstream>
+
 #include "PreprocessorTest.h"
+#include "Macro.h"
 #include "Token.h"
 
 class DefineTest : public PreprocessorTest
@@ -891,3 +895,132 @@ TEST_F(DefineTest, Predefined_FILE2)
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
     EXPECT_EQ("21", token.text);
 }
+
+TEST_F(DefineTest, DefineMacro)
+{
+    const char* input = "#version 100\n"
+                        "#ifdef FOO\n"
+                        "FOO BAR\n"
+                        "#endif\n"
+                        "#undef BAR\n"
+                        "BAR\n";
+    const char* expected = "\n"
+                           "\n"
+                           "1 + x y\n"
+                           "\n"
+                           "\n"
+                           "BAR\n";
+
+    mPreprocessor.defineMacro("FOO", "1 + x");
+    mPreprocessor.defineMacro("BAR", "y");
+    preprocess(input, expected);
+}
+
+TEST_F(DefineTest, DefineMacroRejectsPredefinedAndReservedNames)
+{
+    const char* input = "GL_ES __VERSION__ GL_EXT_foo GL_FOO foo__bar\n";
+    mPreprocessor.predefineMacro("GL_EXT_foo", 1);
+    ASSERT_TRUE(mPreprocessor.init(1, &input, NULL));
+
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_PREDEFINED_REDEFINED,
+                      pp::SourceLocation(),
+                      "GL_ES"));
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_PREDEFINED_REDEFINED,
+                      pp::SourceLocation(),
+                      "__VERSION__"));
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_PREDEFINED_REDEFINED,
+                      pp::SourceLocation(),
+                      "GL_EXT_foo"));
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_NAME_RESERVED,
+                      pp::SourceLocation(),
+                      "GL_FOO"));
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_NAME_RESERVED,
+                      pp::SourceLocation(),
+                      "foo__bar"));
+
+    EXPECT_FALSE(mPreprocessor.defineMacro("GL_ES", "0"));
+    EXPECT_FALSE(mPreprocessor.defineMacro("__VERSION__", "300"));
+    EXPECT_FALSE(mPreprocessor.defineMacro("GL_EXT_foo", "0"));
+    EXPECT_FALSE(mPreprocessor.defineMacro("GL_FOO", "1"));
+    EXPECT_FALSE(mPreprocessor.defineMacro("foo__bar", "1"));
+
+    // None of the definitions took effect.
+    const char* expected[] = { "1", "100", "1", "GL_FOO", "foo__bar" };
+    pp::Token token;
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i)
+    {
+        mPreprocessor.lex(&token);
+        EXPECT_EQ(expected[i], token.text);
+    }
+}
+
+TEST_F(DefineTest, RecordMacroLookups)
+{
+    const char* input = "#ifdef FOO\n"
+                        "BAR\n"
+                        "#else\n"
+                        "BAZ\n"
+                        "#endif\n"
+                        "#if defined(QUX) || 1\n"
+                        "#endif\n";
+    const char* expected = "\n"
+                           "BAR\n"
+                           "\n"
+                           "\n"
+                           "\n"
+                           "\n"
+                           "\n";
+
+    std::set<std::string> lookups;
+    mPreprocessor.defineMacro("FOO", "");
+    mPreprocessor.recordMacroLookups(&lookups);
+    preprocess(input, expected);
+
+    // The identifiers in skipped groups aren't looked up
+    EXPECT_EQ(1u, lookups.count("FOO"));
+    EXPECT_EQ(1u, lookups.count("BAR"));
+    EXPECT_EQ(0u, lookups.count("BAZ"));
+    EXPECT_EQ(1u, lookups.count("QUX"));
+}
+
+TEST_F(DefineTest, StartFromMacroSnapshot)
+{
+    mPreprocessor.predefineMacro("EXT", 1);
+    mPreprocessor.defineMacro("FOO", "x");
+    const char* empty = "";
+    ASSERT_TRUE(mPreprocessor.init(1, &empty, NULL));
+    std::auto_ptr<pp::MacroSnapshot> snapshot(mPreprocessor.snapshotMacros());
+    EXPECT_EQ(6u, snapshot->size());
+
+    const char* input = "#undef FOO\n"
+                        "#define BAR y\n"
+                        "__LINE__ GL_ES __VERSION__ EXT FOO BAR\n";
+    const char* expected = "\n"
+                           "\n"
+                           "3 1 100 1 FOO y";
+
+    // Undefining a macro of the snapshot or defining another one only
+    // changes the preprocessor which does it.
+    for (int i = 0; i < 2; ++i)
+    {
+        pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler);
+        preprocessor.startFromMacros(snapshot.get());
+        ASSERT_TRUE(preprocessor.init(1, &input, NULL));
+
+        std::stringstream stream;
+        pp::Token token;
+        int line = 1;
+        for (preprocessor.lex(&token); token.type != pp::Token::LAST; preprocessor.lex(&token))
+        {
+            for (; line < token.location.line; ++line)
+                stream << "\n";
+            stream << token;
+        }
+        EXPECT_EQ(expected, stream.str());
+    }
+}
@@ -102,6 +102,53 @@
                 '<!@(python <(angle_build_scripts_path)/enumerate_files.py compiler_tests -types *.cpp *.h)'
             ],
         },
+
+        {
+            # Tests for the code in src/common, which is built as part of the translator, and for the
+            # libGLESv2 helpers which don't need a renderer
+            'target_name': 'common_tests',
+            'type': 'executable',
+            'dependencies':
+            [
+                '../src/angle.gyp:translator_static',
+                'gtest',
+                'gmock',
+            ],
+            'include_dirs':
+            [
+                '../include',
+                '../src',
+                'third_party/googletest/include',
+                'third_party/googlemock/include',
+            ],
+            'sources':
+            [
+                '<!@(python <(angle_build_scripts_path)/enumerate_files.py common_tests -types *.cpp *.h)'
+            ],
+        },
+
+        {
+            # Benchmarks, kept out of the unit test targets so those stay fast and quiet
+            'target_name': 'perf_tests',
+            'type': 'executable',
+            'dependencies':
+            [
+                '../src/angle.gyp:translator_static',
+                'gtest',
+                'gmock',
+            ],
+            'include_dirs':
+            [
+                '../include',
+                '../src',
+                'third_party/googletest/include',
+                'third_party/googlemock/include',
+            ],
+            'sources':
+            [
+                '<!@(python <(angle_build_scripts_path)/enumerate_files.py perf_tests -types *.cpp *.h)'
+            ],
+        },
     ],
 
     'conditions':
@@ -131,6 +178,22 @@
                     [
                         '<!@(python <(angle_build_scripts_path)/enumerate_files.py angle_tests -types *.cpp *.h *.inl)'
                     ],
+                    'msvs_settings':
+                    {
+                        'VCLinkerTool':
+                        {
+                            # Lets --deferred-context set the environment before the libraries load
+                            'DelayLoadDLLs':
+                            [
+                                'libEGL.dll',
+                                'libGLESv2.dll',
+                            ],
+                            'AdditionalDependencies':
+                            [
+                                'delayimp.lib',
+                            ],
+                        },
+                    },
                 },
                 {
                     'target_name': 'standalone_tests',